@@ -1,24 +1,349 @@
 #include "chess.h"
+#include <cctype>
+#include <stdexcept>
+#include <thread>
 
+const char* const Chess::OPENING_BOOK_FILE = "openings.book";
 
-void Chess::generateBoard2Player() {
-    const int BOARD_SIZE = 8;
-    const std::string columnLabels = "ABCDEFGH";
 
+// Constructor for the Chess class
+Chess::Chess(ScreenBuffer* buffer) : ai(transpositionTable, static_cast<int>(std::thread::hardware_concurrency())), ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
+    generateBoard();
 
-    for (int row = 1; row <= BOARD_SIZE; ++row) {
-        SquareColour rowStartColour = (row % 2 == 0) ? WHITE_SQUARE : BLACK_SQUARE;
+    // The book is optional; without one the computer searches from the first move
+    try {
+        openingBook.reset(new OpeningBook(OPENING_BOOK_FILE));
+        ai.setOpeningBook(openingBook.get());
+    }
+    catch (const std::runtime_error&) {
+        openingBook.reset();
+    }
+}
+
+
+// Resets the board to the starting position
+void Chess::generateBoard() {
+    board.setStartPosition();
+}
+
+
+// Gets the board being played
+ChessBoard& Chess::getBoard() {
+    return board;
+}
+
+
+// Checks for valid move input
+bool Chess::isValidInput(const std::string& input) const {
+    // Two squares, optionally separated by a space, and an optional promotion piece
+    std::regex pattern(R"(^[a-hA-H][1-8] ?[a-hA-H][1-8]( ?[nbrqNBRQ])?$)");
+
+    return std::regex_match(input, pattern);
+}
+
+
+// Converts valid input to coordinate notation
+std::string Chess::normaliseInput(const std::string& input) const {
+    std::string move;
+
+    for (char c : input) {
+        if (c != ' ') {
+            move += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+
+    return move;
+}
+
+
+// Checks for valid four player move input
+bool Chess::isValidFourPlayerInput(const std::string& input) const {
+    // Two squares on the 14 by 14 board, optionally separated by a space
+    std::regex pattern(R"(^[a-nA-N](1[0-4]|[1-9]) ?[a-nA-N](1[0-4]|[1-9])$)");
+
+    return std::regex_match(input, pattern);
+}
+
+
+// Prints the current state of the board, white at the bottom
+void Chess::printBoard() {
+    const std::wstring pieceLetters = L"PNBRQKpnbrqk";
+
+    screenBuffer.clearScreen();
+
+    // Print column letters at the top
+    screenBuffer.writeToScreen(4, 0, L"    a   b   c   d   e   f   g   h");
+
+    for (int rank = 7; rank >= 0; rank--) {
+        int row = 7 - rank;
+
+        // Print horizontal line
+        screenBuffer.writeToScreen(4, row * 2 + 1, L"  +---+---+---+---+---+---+---+---+");
+
+        // Print rank label and the pieces
+        std::wstring rowText = L" " + std::to_wstring(rank + 1) + L" |";
+        for (int file = 0; file < 8; file++) {
+            int piece = board.getPiece(rank * 8 + file);
+            rowText += L" ";
+            rowText += (piece < 0) ? L' ' : pieceLetters[piece];
+            rowText += L" |";
+        }
+
+        screenBuffer.writeToScreen(4, row * 2 + 2, rowText);
+    }
+
+    // Print the final horizontal line at the bottom
+    screenBuffer.writeToScreen(4, 17, L"  +---+---+---+---+---+---+---+---+");
+}
+
+
+// Prints the four player board, Red at the bottom, with each piece in its player's colour
+void Chess::printFourPlayerBoard() {
+    const std::wstring pieceLetters = L"PNBRQK";
+    const WORD playerColours[FourPlayerChessBoard::PLAYERS] = { ScreenBuffer::RED, ScreenBuffer::BLUE, ScreenBuffer::YELLOW, ScreenBuffer::GREEN };
+    const int size = FourPlayerChessBoard::SIZE;
+
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 0, L"     a  b  c  d  e  f  g  h  i  j  k  l  m  n");
+
+    for (int row = size - 1; row >= 0; row--) {
+        int y = size - row;
+
+        // The rank label and the empty squares first
+        std::wstring rowText = (row + 1 < 10 ? L" " : L"") + std::to_wstring(row + 1) + L" ";
+        for (int column = 0; column < size; column++) {
+            rowText += FourPlayerChessBoard::isValidSquare(row, column) ? L" . " : L"   ";
+        }
+        screenBuffer.writeToScreen(4, y, rowText);
+
+        // Then the pieces over them, out of the game players' pieces in white
+        for (int column = 0; column < size; column++) {
+            if (!FourPlayerChessBoard::isValidSquare(row, column)) {
+                continue;
+            }
+
+            int piece = fourPlayerBoard.getPiece(row * size + column);
+            if (piece == FourPlayerChessBoard::EMPTY_SQUARE) {
+                continue;
+            }
+
+            int owner = piece >> 3;
+            WORD colour = fourPlayerBoard.isEliminated(owner) ? ScreenBuffer::WHITE : playerColours[owner];
+            screenBuffer.writeToScreen(4 + 4 + column * 3, y, std::wstring(1, pieceLetters[piece & 7]), colour, ScreenBuffer::BACKGROUND_NORMAL);
+        }
+    }
+}
+
+
+// Asks whether to return to the menu or exit
+int Chess::endGame() {
+    screenBuffer.writeToScreen(4, 22, L"Type 'return' to return to the main menu, or 'exit' to exit MiniGame-Madness.");
+
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "return") {
+            return 0;
+        }
+        else if (input == "exit") {
+            return 1;
+        }
+        else {
+            screenBuffer.writeToScreen(4, 22, L"Invalid input. Please type 'return' or 'exit':                                 ");
+        }
+    }
+}
 
-        for (int col = 1; col <= BOARD_SIZE; ++col) {
-            SquareColour colour = (col % 2 == 0) ? rowStartColour : (rowStartColour == WHITE_SQUARE ? BLACK_SQUARE : WHITE_SQUARE);
 
-            std::unique_ptr<ChessSquare> square = std::make_unique<ChessSquare>(colour);
+// The game loop, two players taking turns at the same keyboard or one against the computer
+void Chess::runTwoPlayer() {
+    ChessMoveList moves;
 
-            // Generate the position key (e.g., "A1", "B1", etc.)
-            std::string position = columnLabels[col - 1] + std::to_string(row);
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Play against the computer? (y/n) ");
 
-			// Have to use std::move to transfer ownership of the unique_ptr
-            boardMap[position] = std::move(square); 
+    bool computerOpponent = false;
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "y" || input == "n") {
+            computerOpponent = (input == "y");
+            break;
         }
+        screenBuffer.writeToScreen(4, 2, L"Please enter 'y' or 'n':          ");
     }
+
+    generateBoard();
+    transpositionTable.clear();
+    ai.clearHistory();
+    printBoard();
+
+    while (true) {
+        board.generateLegalMoves(moves);
+        std::wstring side = (board.getSideToMove() == ChessBoard::WHITE) ? L"White" : L"Black";
+
+        // Checkmate, stalemate or the fifty move rule end the game
+        if (moves.size() == 0) {
+            if (board.isInCheck()) {
+                std::wstring winner = (board.getSideToMove() == ChessBoard::WHITE) ? L"Black" : L"White";
+                screenBuffer.writeToScreen(4, 20, L"Checkmate. " + winner + L" wins!");
+            }
+            else {
+                screenBuffer.writeToScreen(4, 20, L"Stalemate. The game is a draw.");
+            }
+            break;
+        }
+
+        if (board.getHalfmoveClock() >= 100) {
+            screenBuffer.writeToScreen(4, 20, L"Fifty moves without a capture or pawn move. The game is a draw.");
+            break;
+        }
+
+        // The computer plays black
+        if (computerOpponent && board.getSideToMove() == ChessBoard::BLACK) {
+            screenBuffer.writeToScreen(4, 20, L"The computer is thinking...");
+
+            SearchLimits limits;
+            limits.moveTimeMs = COMPUTER_MOVE_TIME_MS;
+            SearchResult result = ai.search(board, limits);
+            std::string san = board.moveToSan(result.bestMove);
+
+            board.makeMove(result.bestMove);
+            printBoard();
+            screenBuffer.writeToScreen(4, 18, L"The computer played " + std::wstring(san.begin(), san.end()) +
+                (result.bookMove ? L" from its opening book." : L"."));
+            continue;
+        }
+
+        if (board.isInCheck()) {
+            screenBuffer.writeToScreen(4, 19, side + L" is in check.");
+        }
+
+        screenBuffer.writeToScreen(4, 20, side + L" to move (e.g., e2 e4), or 'resign': ");
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "resign") {
+            std::wstring winner = (board.getSideToMove() == ChessBoard::WHITE) ? L"Black" : L"White";
+            screenBuffer.writeToScreen(4, 21, side + L" resigns. " + winner + L" wins!");
+            break;
+        }
+
+        ChessMove move;
+        if (isValidInput(input)) {
+            move = board.parseMove(normaliseInput(input));
+        }
+
+        if (move.isNull()) {
+            screenBuffer.writeToScreen(4, 21, L"That is not a legal move. Please enter a move in the format 'e2 e4':");
+            continue;
+        }
+
+        board.makeMove(move);
+        printBoard();
+    }
+}
+
+
+// The game loop for four players, people taking the first seats and the computer the rest
+void Chess::runFourPlayer() {
+    const std::wstring playerNames[FourPlayerChessBoard::PLAYERS] = { L"Red", L"Blue", L"Yellow", L"Green" };
+    const int searchDepth = 4;
+    FourPlayerMoveList moves;
+
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"How many of the four players are people (1-4)? ");
+
+    int humans = 0;
+    while (humans == 0) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input.size() == 1 && input[0] >= '1' && input[0] <= '4') {
+            humans = input[0] - '0';
+        }
+        else {
+            screenBuffer.writeToScreen(4, 2, L"Please enter a number from 1 to 4:                ");
+        }
+    }
+
+    fourPlayerBoard.setStartPosition();
+    printFourPlayerBoard();
+
+    while (fourPlayerBoard.getActivePlayerCount() > 1) {
+        int player = fourPlayerBoard.getCurrentPlayer();
+        fourPlayerBoard.generateLegalMoves(moves);
+
+        // A player with no legal moves, checkmated or stalemated, is out
+        if (moves.size() == 0) {
+            std::wstring reason = fourPlayerBoard.isInCheck(player) ? L" is checkmated" : L" is stalemated";
+            fourPlayerBoard.eliminatePlayer(player);
+            printFourPlayerBoard();
+            screenBuffer.writeToScreen(4, 17, playerNames[player] + reason + L" and is out of the game.");
+            continue;
+        }
+
+        FourPlayerMove move;
+
+        if (player < humans) {
+            if (fourPlayerBoard.isInCheck(player)) {
+                screenBuffer.writeToScreen(4, 18, playerNames[player] + L" is in check.");
+            }
+
+            screenBuffer.writeToScreen(4, 19, playerNames[player] + L" to move (e.g., e2 e4), or 'resign': ");
+            std::string input = screenBuffer.getBlockingInput();
+
+            if (input == "resign") {
+                fourPlayerBoard.eliminatePlayer(player);
+                printFourPlayerBoard();
+                screenBuffer.writeToScreen(4, 17, playerNames[player] + L" resigns.");
+                continue;
+            }
+
+            if (isValidFourPlayerInput(input)) {
+                move = fourPlayerBoard.parseMove(normaliseInput(input));
+            }
+
+            if (move.isNull()) {
+                screenBuffer.writeToScreen(4, 20, L"That is not a legal move. Please enter a move in the format 'e2 e4':");
+                continue;
+            }
+        }
+        else {
+            move = fourPlayerBoard.findBestMove(searchDepth, FourPlayerChessBoard::PARANOID);
+        }
+
+        fourPlayerBoard.makeMove(move);
+        printFourPlayerBoard();
+
+        std::string played = FourPlayerChessBoard::moveToString(move);
+        screenBuffer.writeToScreen(4, 17, playerNames[player] + L" played " + std::wstring(played.begin(), played.end()) + L".");
+    }
+
+    int winner = fourPlayerBoard.getCurrentPlayer();
+    screenBuffer.writeToScreen(4, 20, playerNames[winner] + L" is the last player standing and wins!");
+}
+
+
+// Asks for two or four players and runs the game
+int Chess::run() {
+    screenBuffer.setActive();
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Play with 2 or 4 players? ");
+
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "2") {
+            runTwoPlayer();
+            break;
+        }
+        else if (input == "4") {
+            runFourPlayer();
+            break;
+        }
+        else {
+            screenBuffer.writeToScreen(4, 2, L"Please enter 2 or 4:             ");
+        }
+    }
+
+    return endGame();
 }
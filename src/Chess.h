@@ -7,206 +7,104 @@
 */
 
 #include "ScreenBuffer.h"
-#include <string>
-#include <map>
-#include <stdexcept>
+#include "chessAI.h"
+#include "chessBoard.h"
+#include "fourPlayerChess.h"
+#include "openingBook.h"
 #include <memory>
+#include <string>
+#include <regex>
 
 /*!
- * @enum PieceType
- * @brief An enumeration of the different types of chess pieces.
-*/
-enum PieceType {
-	EMPTY, /*!< An empty square. */
-	PAWN, /*!< The pawn piece type. */
-	ROOK, /*!< The rook piece type. */
-	KNIGHT, /*!< The knight piece type. */
-	BISHOP, /*!< The bishop piece type. */
-	QUEEN, /*!< The queen piece type. */
-	KING /*!< The king piece type. */
-};
-
-/*!
- * @enum PlayerColour
- * @brief An enumeration of the different player colors.
-*/
-enum PlayerColour {
-	BLANK_PLAYER, /*!< A blank player color, for empty squares. */
-	WHITE_PLAYER, /*!< The white player color. */
-	BLACK_PLAYER, /*!< The black player color. */
-	RED_PLAYER, /*!< The red player color. */
-	GREEN_PLAYER, /*!< The green player color. */
-	BLUE_PLAYER, /*!< The blue player color. */
-	YELLOW_PLAYER /*!< The yellow player color. */
-};
-
-/*!
- * @enum SquareColour
- * @brief An enumeration of the different square colors.
+* @class Chess
+* @brief A class that represents the game of Chess.
+* @details The rules live in ChessBoard; this class draws the board and runs the game loop.
 */
-enum SquareColour {
-	WHITE_SQUARE, /*!< A white square. */
-	BLACK_SQUARE /*!< A black square. */
-};
+class Chess{
+ private:
 
-/*!
- * @enum Direction
- * @brief An enumeration of possible directions of neighboring squares.
- */
-enum Direction {
-	NORTH, /*!< Direction going to the top of the board. */
-	SOUTH, /*!< Direction going to the bottom of the board */
-	EAST, /*!< Direction going to the right of the board. */
-	WEST, /*!< Direction going to the left of the board. */
-	NORTHEAST, /*!< Direction going to the top right of the board. */
-	NORTHWEST, /*!< Direction going to the top left of the board. */
-	SOUTHEAST, /*!< Direction going to the bottom right of the board. */
-	SOUTHWEST /*!< Direction going to the bottom left of the board. */
-};
+	static const int COMPUTER_MOVE_TIME_MS = 2000; /*!< How long the computer thinks about each move. */
+	static const char* const OPENING_BOOK_FILE; /*!< The book file the computer plays its openings from, if it exists. */
 
-/*!
-* @struct ChessSquare
-* @brief A struct that represents a chess square.
-* @details This struct contains the type of the piece and the color of the player that owns the piece as well as colour of the square.
-* @details The default type is EMPTY and the default player color is BLANK reprasenting an emptry square.
-*/
-struct ChessSquare {
-	PieceType type; /*!< The type of the piece. */
-	PlayerColour playerColour; /*!< The color of the player that owns the piece. */
-	SquareColour squareColour; /*!< The color of the square. */
-	std::map<Direction, ChessSquare*> neighbors; /*!< A map of directions to neighboring squares. */
+	ChessBoard board; /*!< The position being played. */
+	TranspositionTable transpositionTable; /*!< The computer's transposition table, kept between moves. */
+	LazySmpSearch ai; /*!< The computer opponent, searching on every hardware thread. */
+	std::unique_ptr<OpeningBook> openingBook; /*!< The computer's opening book, or null if there is no book file. */
+	FourPlayerChessBoard fourPlayerBoard; /*!< The position being played in a four player game. */
+	std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
 
 	/*!
-	 * @brief Default constructor for ChessSquare.
-	 * @details Initializes the ChessSquare with an EMPTY type, a BLANK player color.
-	 * @param squareColour The Colour of the square.
-	 */
-	ChessSquare(SquareColour squareColour) : type(PieceType::EMPTY), playerColour(PlayerColour::BLANK_PLAYER), squareColour(squareColour){}
-	
-	/*!
-	 * @brief Constructor for ChessSquare.
-	 * @details Initializes the ChessSquare with the given type, player color, and square colour.
-	 * @param type The type of the piece.
-	 * @param playerColour The color of the player that owns the piece.
-	 * @param squareColour The color of the square.
-	 */
-	ChessSquare(PieceType type, PlayerColour playerColour, SquareColour squareColour) : type(type), playerColour(playerColour), squareColour(squareColour) {}
+	* @brief Prints the current state of the board.
+	*/
+	void printBoard();
 
 	/*!
-	* @brief Add a neighboring square with a direction.
-	* @param square - The square to add as a neighbor.
-	* @param direction - The direction of the neighboring square.
+	* @brief Prints the current state of the four player board, each piece in its player's colour.
 	*/
-	void addNeighbor(ChessSquare* square, Direction direction) {
-		if (neighbors.find(direction) != neighbors.end()) {
-			throw std::runtime_error("Neighbor already exists in the given direction.");
-		}
-
-		neighbors[direction] = square;
-	}
+	void printFourPlayerBoard();
 
 	/*!
-	* @brief Remove a neighboring square with a direction.
-	* @param direction - The direction of the neighboring square.
+	* @brief Run a two player game at the same keyboard, or against the computer playing black.
 	*/
-	bool removeNeighbor(Direction direction) {
-		if (neighbors.find(direction) == neighbors.end()) {
-			throw std::runtime_error("Neighbor not found in the given direction.");
-		}
-
-		neighbors.erase(direction);
-	}
+	void runTwoPlayer();
 
 	/*!
-	* @brief Get the neighboring square in a given direction.
-	* @param direction - The direction of the neighboring square.
-	* @return The neighboring square in the given direction.
+	* @brief Run a four player game, with the computer playing any seats not taken by people.
 	*/
-	ChessSquare* getNeighbor(Direction direction) const {
-		auto neighbor = neighbors.find(direction);
-		return (neighbor != neighbors.end()) ? neighbor->second : nullptr;
-	}
+	void runFourPlayer();
 
 	/*!
-	* @brief Get all neighboring squares.
-	* @return A map of directions to neighboring squares.
+	* @brief Asks whether to return to the menu or exit once the game is over.
+	* @return Whether should return to the main menu (0) or exit the program (1)
 	*/
-	std::map<Direction, ChessSquare*> getNeighbors() const {
-		return neighbors;
-	}
-
+	int endGame();
 
+ public:
 	/*!
-	* @brief Get the piece type of the square.
-	* @return The piece type of the square.
+	* @brief Constructor for the Chess class, sets up the starting position.
+	* @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
 	*/
-	PieceType getPieceType() const {
-		return type;
-	}
+	explicit Chess(ScreenBuffer* buffer = nullptr);
 
 	/*!
-	* @brief Set the piece type of the square.
-	* @param type - The piece type to set.
-	* @return True if the piece type was set successfully, false otherwise.
-	*/
-	bool setPieceType(PieceType type) {
-		this->type = type;
-		return true;
-	}
+	 * @brief Generate the game board.
+	 * @details Resets the board to the standard starting position.
+	 */
+	 void generateBoard();
 
 	/*!
-	* @brief Get the player color of the square.
-	* @return The player color of the square.
+	* @brief Get the board being played.
+	* @return The board.
 	*/
-	PlayerColour getPlayerColour() const {
-		return playerColour;
-	}
+	ChessBoard& getBoard();
 
 	/*!
-	* @brief Set the player color of the square.
-	* @param playerColour - The player color to set.
-	* @return True if the player color was set successfully, false otherwise.
+	* @brief Check for valid move input such as "e2 e4", "e2e4" or "e7 e8 q".
+	* @param input The input from the user
+	* @return true if the input is valid, false otherwise.
 	*/
-	bool setPlayerColour(PlayerColour playerColour) {
-		this->playerColour = playerColour;
-		return true;
-	}
+	bool isValidInput(const std::string& input) const;
 
 	/*!
-	* @brief Get the square colour of the square.
-	* @return The square colour of the square.
+	* @brief Convert valid move input to coordinate notation, such as "e2e4".
+	* @param input The input from the user, which must pass isValidInput.
+	* @return The move in coordinate notation.
 	*/
-	SquareColour getSquareColour() const {
-		return squareColour;
-	}
-};
-
-
-/*!
-* @class Chess
-* @brief A class that represents the game of Chess.
-*/
-class Chess{
- private:
-
-	std::map<std::string, std::unique_ptr<ChessSquare>> boardMap; /*!< A map of string positions to ChessSquare pointers. */
+	std::string normaliseInput(const std::string& input) const;
 
 	/*!
-	* @brief Generate 2 player board.
-	* @details The board is represented as a 2D graph of ChessSquare structs in a 8x8 square shape.
+	* @brief Check for valid four player move input such as "d2 d4" or "b11d11".
+	* @param input The input from the user
+	* @return true if the input is valid, false otherwise.
 	*/
-	 void generateBoard2Player();
+	bool isValidFourPlayerInput(const std::string& input) const;
 
- public:
-	 /*!
-	  * @brief Generate the game board.
-	  * @details The board is represented as a 2D graph of ChessSquare structs.
-	  * @details Each square contains the type of the piece, the color of the player that owns the piece, and the color of the square.
-	  * @details The boards shape and size will change based on the number of players.
-	  */
-	 void generateBoard();
-	 
+	/*!
+	* @brief Run the game
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int run();
 };
 
 #endif // !CHESS
-
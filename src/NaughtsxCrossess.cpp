@@ -3,7 +3,8 @@
 // Global variable to track if the game has ended
 
 // Copy Constructor
-NaughtsxCrossess::NaughtsxCrossess(const NaughtsxCrossess& other) {
+template <int N, int K>
+NaughtsxCrossessGame<N, K>::NaughtsxCrossessGame(const NaughtsxCrossessGame& other) : gameEnded(false), search(TABLE_BITS) {
     if (other.screenBuffer) {
         // Deep copy the ScreenBuffer
         screenBuffer = new ScreenBuffer(*other.screenBuffer);
@@ -23,7 +24,8 @@ NaughtsxCrossess::NaughtsxCrossess(const NaughtsxCrossess& other) {
 }
 
 // Copy Assignment Operator
-NaughtsxCrossess& NaughtsxCrossess::operator=(const NaughtsxCrossess& other) {
+template <int N, int K>
+NaughtsxCrossessGame<N, K>& NaughtsxCrossessGame<N, K>::operator=(const NaughtsxCrossessGame& other) {
     if (this != &other) {  // Protect against self-assignment
         // Clean up existing resources
         if (ownsScreenBuffer && screenBuffer) {
@@ -52,19 +54,22 @@ NaughtsxCrossess& NaughtsxCrossess::operator=(const NaughtsxCrossess& other) {
 }
 
 // Default constructor
-NaughtsxCrossess::NaughtsxCrossess() : screenBuffer(nullptr), ownsScreenBuffer(true), gameEnded(false) {
+template <int N, int K>
+NaughtsxCrossessGame<N, K>::NaughtsxCrossessGame() : screenBuffer(nullptr), ownsScreenBuffer(true), gameEnded(false), search(TABLE_BITS) {
     screenBuffer = new ScreenBuffer();
     resetBoard();
 }
 
 // Constructor with external ScreenBuffer
-NaughtsxCrossess::NaughtsxCrossess(ScreenBuffer* buffer) : screenBuffer(buffer), ownsScreenBuffer(false), gameEnded(false) {
+template <int N, int K>
+NaughtsxCrossessGame<N, K>::NaughtsxCrossessGame(ScreenBuffer* buffer) : screenBuffer(buffer), ownsScreenBuffer(false), gameEnded(false), search(TABLE_BITS) {
     resetBoard();
 }
 
 
 // Destructor to clean up internal ScreenBuffer if we own it
-NaughtsxCrossess::~NaughtsxCrossess() {
+template <int N, int K>
+NaughtsxCrossessGame<N, K>::~NaughtsxCrossessGame() {
     if (ownsScreenBuffer && screenBuffer) {
         delete screenBuffer;
         screenBuffer = nullptr;
@@ -72,7 +77,8 @@ NaughtsxCrossess::~NaughtsxCrossess() {
 }
 
 // Method to set external ScreenBuffer
-void NaughtsxCrossess::setScreenBuffer(ScreenBuffer* buffer) {
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::setScreenBuffer(ScreenBuffer* buffer) {
     if (ownsScreenBuffer && screenBuffer) {
         delete screenBuffer;  // Clean up internal buffer if we are replacing it
     }
@@ -80,8 +86,10 @@ void NaughtsxCrossess::setScreenBuffer(ScreenBuffer* buffer) {
     ownsScreenBuffer = false;  // External buffer means we don't own it
 }
 
-void NaughtsxCrossess::printBoard() const {
-    screenBuffer->writeToScreen(0, 0, L"-------------");
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::printBoard() const {
+    const std::wstring separator(4 * BOARD_SIZE + 1, L'-');
+    screenBuffer->writeToScreen(0, 0, separator);
     int rowOffset = 1;
     for (int i = 0; i < BOARD_SIZE; ++i) {
         std::wstring row = L"| ";
@@ -89,30 +97,32 @@ void NaughtsxCrossess::printBoard() const {
             row += std::wstring(1, board[i][j]) + L" | ";
         }
         screenBuffer->writeToScreen(0, rowOffset++, row);
-        screenBuffer->writeToScreen(0, rowOffset++, L"-------------");
+        screenBuffer->writeToScreen(0, rowOffset++, separator);
     }
 }
 
-void NaughtsxCrossess::printBoardWithNumbers() const {
-    screenBuffer->writeToScreen(20, 0, L"-------------");
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::printBoardWithNumbers() const {
+    // Two digit numbers on the larger boards need wider cells, and the board beside it leaves a gap of 7
+    const int width = (CELLS >= 10) ? 2 : 1;
+    const std::wstring separator((width + 3) * BOARD_SIZE + 1, L'-');
+    const int x = 4 * BOARD_SIZE + 8;
+    screenBuffer->writeToScreen(x, 0, separator);
     int rowOffset = 1;
-    int numpadNumbers[BOARD_SIZE][BOARD_SIZE] = {
-        {7, 8, 9},
-        {4, 5, 6},
-        {1, 2, 3}
-    };
     for (int i = 0; i < BOARD_SIZE; ++i) {
         std::wstring row = L"| ";
         for (int j = 0; j < BOARD_SIZE; ++j) {
-            int cellNumber = numpadNumbers[i][j];
-            row += std::to_wstring(cellNumber) + L" | ";
+            int cellNumber = (BOARD_SIZE - 1 - i) * BOARD_SIZE + j + 1;
+            std::wstring number = std::to_wstring(cellNumber);
+            row += std::wstring(width - number.size(), L' ') + number + L" | ";
         }
-        screenBuffer->writeToScreen(20, rowOffset++, row);
-        screenBuffer->writeToScreen(20, rowOffset++, L"-------------");
+        screenBuffer->writeToScreen(x, rowOffset++, row);
+        screenBuffer->writeToScreen(x, rowOffset++, separator);
     }
 }
 
-bool NaughtsxCrossess::isMovesLeft() const {
+template <int N, int K>
+bool NaughtsxCrossessGame<N, K>::isMovesLeft() const {
     for (int i = 0; i < BOARD_SIZE; ++i)
         for (int j = 0; j < BOARD_SIZE; ++j)
             if (board[i][j] == ' ')
@@ -120,126 +130,88 @@ bool NaughtsxCrossess::isMovesLeft() const {
     return false;
 }
 
-int NaughtsxCrossess::evaluate() const {
-    // Check rows for a win
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        if (board[row][0] == board[row][1] && board[row][1] == board[row][2]) {
-            if (board[row][0] == 'x')
-                return +10;
-            else if (board[row][0] == 'o')
-                return -10;
-        }
+template <int N, int K>
+typename NaughtsxCrossessGame<N, K>::Board NaughtsxCrossessGame<N, K>::toSearchBoard(bool isMax) const {
+    Board position;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        char piece = board[cell / BOARD_SIZE][cell % BOARD_SIZE];
+        position.setCell(cell, piece == 'x' ? 1 : (piece == 'o' ? 2 : 0));
     }
+    position.setTurn(isMax ? 1 : 2);
+    return position;
+}
 
-    // Check columns for a win
-    for (int col = 0; col < BOARD_SIZE; ++col) {
-        if (board[0][col] == board[1][col] && board[1][col] == board[2][col]) {
-            if (board[0][col] == 'x')
+template <int N, int K>
+int NaughtsxCrossessGame<N, K>::evaluate() const {
+    Board position = toSearchBoard(true);
+
+    // A line of 'x' counts first, as it always has
+    int score = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (position.isWin(cell)) {
+            if (position.getCell(cell) == 1)
                 return +10;
-            else if (board[0][col] == 'o')
-                return -10;
+            score = -10;
         }
     }
-
-    // Check diagonals for a win
-    if (board[0][0] == board[1][1] && board[1][1] == board[2][2]) {
-        if (board[0][0] == 'x')
-            return +10;
-        else if (board[0][0] == 'o')
-            return -10;
-    }
-
-    if (board[0][2] == board[1][1] && board[1][1] == board[2][0]) {
-        if (board[0][2] == 'x')
-            return +10;
-        else if (board[0][2] == 'o')
-            return -10;
-    }
-
-    return 0;
+    return score;
 }
 
-int NaughtsxCrossess::minimax(int depth, bool isMax, int difficulty) {
-    int score = evaluate();
+template <int N, int K>
+int NaughtsxCrossessGame<N, K>::minimax(int depth, bool isMax, int difficulty) {
+    int result = evaluate();
+    if (result != 0 || !isMovesLeft())
+        return result;
 
-    if (score == 10 || score == -10)
-        return score;
-
-    if (!isMovesLeft())
+    // No deeper than the moves left, so the table's results for the whole game can be used
+    Board position = toSearchBoard(isMax);
+    int remaining = std::min(difficulty - depth, CELLS - position.getStoneCount());
+    if (remaining <= 0)
         return 0;
+    search.searchToDepth(position, remaining);
 
-    if (depth == difficulty)
+    // Only wins and losses count outside the search, as before
+    int score = isMax ? search.getScore() : -search.getScore();
+    if (!Search::isDecisive(score))
         return 0;
+    return (score > 0) ? 10 : -10;
+}
 
-    if (isMax) {
-        int best = std::numeric_limits<int>::min();
+template <int N, int K>
+std::pair<int, int> NaughtsxCrossessGame<N, K>::findBestMove(int difficulty) {
+    // The AI's move, then the difficulty's worth of moves after it
+    Board position = toSearchBoard(true);
+    int depth = std::min(difficulty + 1, CELLS - position.getStoneCount());
+    int move = search.searchToDepth(position, depth);
 
-        for (int i = 0; i < BOARD_SIZE; ++i) {
-            for (int j = 0; j < BOARD_SIZE; ++j) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = 'x';
-                    best = std::max(best, minimax(depth + 1, !isMax, difficulty));
-                    board[i][j] = ' ';
-                }
-            }
-        }
-        return best;
-    }
-    else {
-        int best = std::numeric_limits<int>::max();
-
-        for (int i = 0; i < BOARD_SIZE; ++i) {
-            for (int j = 0; j < BOARD_SIZE; ++j) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = 'o';
-                    best = std::min(best, minimax(depth + 1, !isMax, difficulty));
-                    board[i][j] = ' ';
-                }
-            }
-        }
-        return best;
-    }
+    if (move < 0)
+        return { -1, -1 };
+    return { move / BOARD_SIZE, move % BOARD_SIZE };
 }
 
-std::pair<int, int> NaughtsxCrossess::findBestMove(int difficulty) {
-    int bestVal = std::numeric_limits<int>::min();
-    std::pair<int, int> bestMove = { -1, -1 };
-
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int j = 0; j < BOARD_SIZE; ++j) {
-            if (board[i][j] == ' ') {
-                board[i][j] = 'x';
-                int moveVal = minimax(0, false, difficulty);
-                board[i][j] = ' ';
-
-                if (moveVal > bestVal) {
-                    bestMove = { i, j };
-                    bestVal = moveVal;
-                }
-            }
-        }
-    }
+template <int N, int K>
+long long NaughtsxCrossessGame<N, K>::getNodesSearched() const {
+    return static_cast<long long>(search.getNodes());
+}
 
-    return bestMove;
+template <int N, int K>
+int NaughtsxCrossessGame<N, K>::hardDepth() {
+    return (CELLS <= 16) ? CELLS : 10;
 }
 
-std::pair<int, int> NaughtsxCrossess::moveNumberToPosition(int moveNumber) const {
-    switch (moveNumber) {
-    case 7: return { 0, 0 };
-    case 8: return { 0, 1 };
-    case 9: return { 0, 2 };
-    case 4: return { 1, 0 };
-    case 5: return { 1, 1 };
-    case 6: return { 1, 2 };
-    case 1: return { 2, 0 };
-    case 2: return { 2, 1 };
-    case 3: return { 2, 2 };
-    default: return { -1, -1 }; // Invalid move
-    }
+template <int N, int K>
+std::pair<int, int> NaughtsxCrossessGame<N, K>::moveNumberToPosition(int moveNumber) const {
+    // Laid out like a numpad, 1 at the bottom left
+    if (moveNumber < 1 || moveNumber > CELLS)
+        return { -1, -1 }; // Invalid move
+    return { BOARD_SIZE - 1 - (moveNumber - 1) / BOARD_SIZE, (moveNumber - 1) % BOARD_SIZE };
 }
 
-bool NaughtsxCrossess::playerMove(char player, std::function<std::string()> inputProvider) {
-    screenBuffer->writeToScreen(0, 0, L"Enter your move (1-9) or type 'stop' to end the game: ");
+template <int N, int K>
+bool NaughtsxCrossessGame<N, K>::playerMove(char player, std::function<std::string()> inputProvider) {
+    const std::wstring range = L"1-" + std::to_wstring(CELLS);
+    const int messageRow = 2 * BOARD_SIZE + 4;
+    screenBuffer->writeToScreen(0, 0, L"Enter your move (" + range + L") or type 'stop' to end the game: ");
 
     // Use the input provider if it's passed; otherwise, use the default screenBuffer input
     std::string input = inputProvider ? inputProvider() : screenBuffer->getBlockingInput();
@@ -254,7 +226,7 @@ bool NaughtsxCrossess::playerMove(char player, std::function<std::string()> inpu
         move = std::stoi(input);
     }
     catch (...) {
-        screenBuffer->writeToScreen(0, 10, L"Invalid input. Please enter a number between 1 and 9. press 'enter' to try again...");
+        screenBuffer->writeToScreen(0, messageRow, L"Invalid input. Please enter a number between " + range + L". press 'enter' to try again...");
         screenBuffer->getBlockingInput();
         clearScreen();
         printBoardWithNumbers();
@@ -270,7 +242,7 @@ bool NaughtsxCrossess::playerMove(char player, std::function<std::string()> inpu
         board[row][col] = player;
     }
     else {
-        screenBuffer->writeToScreen(0, 10, L"Invalid input. Please enter a number between 1 and 9. press 'enter' to try again...");
+        screenBuffer->writeToScreen(0, messageRow, L"Invalid input. Please enter a number between " + range + L". press 'enter' to try again...");
         screenBuffer->getBlockingInput();
         clearScreen();
         printBoardWithNumbers();
@@ -281,7 +253,8 @@ bool NaughtsxCrossess::playerMove(char player, std::function<std::string()> inpu
     return true;
 }
 
-void NaughtsxCrossess::aiMove(int difficulty) {
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::aiMove(int difficulty) {
     if (difficulty == 1) {
         srand(static_cast<unsigned int>(time(0)));
         int row, col;
@@ -292,16 +265,103 @@ void NaughtsxCrossess::aiMove(int difficulty) {
         board[row][col] = 'x';
     }
     else {
-        std::pair<int, int> bestMove = findBestMove(difficulty == 2 ? 2 : 100);
+        std::pair<int, int> bestMove = findBestMove(difficulty == 2 ? 2 : hardDepth());
         board[bestMove.first][bestMove.second] = 'x';
     }
 }
 
-void NaughtsxCrossess::clearScreen() const {
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::clearScreen() const {
     screenBuffer->clearScreen();
 }
 
-void NaughtsxCrossess::run(std::function<std::string()> inputProvider) {
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::playGame(int difficulty, std::function<std::string()> inputProvider) {
+    // Messages go below the board, which takes two lines a row
+    const int messageRow = 2 * BOARD_SIZE + 2;
+    bool isPvP = (difficulty == 4);
+    bool gameOver = false;
+    resetBoard();
+    gameEnded = false;
+
+    // Main game loop
+    while (isMovesLeft() && !gameOver) {
+        clearScreen();
+        printBoardWithNumbers();  // Show numbered board
+        printBoard();  // Show current board with pieces
+
+        if (!playerMove(isPvP ? 'o' : 'o', inputProvider)) {  // Player 1 move
+            clearScreen();
+            screenBuffer->writeToScreen(0, 4, L"Game stopped by the player.");
+            gameOver = true;
+            break;
+        }
+
+        if (gameEnded) {
+            clearScreen();
+            screenBuffer->writeToScreen(0, 4, L"Game stopped by the player.");
+            gameOver = true;
+            break;
+        }
+
+        clearScreen();
+        printBoardWithNumbers();  // Show numbered board
+        printBoard();  // Show current board with pieces
+
+        if (evaluate() == -10) {
+            clearScreen();
+            printBoard();
+            screenBuffer->writeToScreen(0, messageRow, L"Player O wins!");
+            gameOver = true;
+            break;
+        }
+
+        if (!isMovesLeft()) {
+            clearScreen();
+            printBoard();
+            screenBuffer->writeToScreen(0, messageRow, L"It's a draw!");
+            gameOver = true;
+            break;
+        }
+
+        if (isPvP) {
+            if (!playerMove('x', inputProvider)) {  // Player 2 move
+                clearScreen();
+                screenBuffer->writeToScreen(0, messageRow - 1, L"Game stopped by the player.");
+                gameOver = true;
+                break;
+            }
+        }
+        else {
+            clearScreen();
+            screenBuffer->writeToScreen(0, messageRow, L"AI is making a move...");
+            aiMove(difficulty);
+        }
+
+        clearScreen();
+        printBoardWithNumbers();  // Show numbered board
+        printBoard();  // Show current board with pieces
+
+        if (evaluate() == 10) {
+            clearScreen();
+            printBoard();
+            screenBuffer->writeToScreen(0, messageRow + 1, isPvP ? L"Player X wins!" : L"AI wins!");
+            gameOver = true;
+            break;
+        }
+
+        if (!isMovesLeft()) {
+            clearScreen();
+            printBoard();
+            screenBuffer->writeToScreen(0, messageRow + 2, L"It's a draw!");
+            gameOver = true;
+            break;
+        }
+    }
+}
+
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::run(std::function<std::string()> inputProvider) {
     bool playAgain = true;
 
     while (playAgain) {
@@ -309,7 +369,8 @@ void NaughtsxCrossess::run(std::function<std::string()> inputProvider) {
         // Ask for difficulty or mode selection
         screenBuffer->setActive();
         clearScreen();
-        screenBuffer->writeToScreen(0, 0, L"Select mode (1 = Easy, 2 = Medium, 3 = Hard, 4 = Player vs Player): ");
+        screenBuffer->writeToScreen(0, 0, L"Select mode (1 = Easy, 2 = Medium, 3 = Hard, 4 = Player vs Player, 5 = Gomoku, "
+            L"6 = 4x4 vs AI, 7 = 5x5 vs AI): ");
 
         std::string input = inputProvider ? inputProvider() : screenBuffer->getBlockingInput();
         if (input == "stop") {
@@ -326,7 +387,7 @@ void NaughtsxCrossess::run(std::function<std::string()> inputProvider) {
             return;
         }
 
-        if (difficulty < 1 || difficulty > 4) {
+        if (difficulty < 1 || difficulty > 7) {
             screenBuffer->writeToScreen(0, 1, L"Invalid mode selected. Exiting.");
             screenBuffer->getBlockingInput();
             return;
@@ -336,97 +397,115 @@ void NaughtsxCrossess::run(std::function<std::string()> inputProvider) {
         screenBuffer->writeToScreen(0, 3, L"Here's the board with numbered cells:");
         printBoardWithNumbers();
 
-        bool isPvP = (difficulty == 4);
-        bool gameOver = false;
-
-        // Main game loop
-        while (isMovesLeft() && !gameOver) {
-            clearScreen();
-            printBoardWithNumbers();  // Show numbered board
-            printBoard();  // Show current board with pieces
-
-            if (!playerMove(isPvP ? 'o' : 'o', inputProvider)) {  // Player 1 move
-                clearScreen();
-                screenBuffer->writeToScreen(0, 4, L"Game stopped by the player.");
-                gameOver = true;
-                break;
-            }
+        // The larger boards are played against the Hard AI; the prompt goes below whichever board was played
+        int promptRow = 2 * BOARD_SIZE + 6;
+        if (difficulty == 5) {
+            playGomoku(inputProvider);
+            promptRow = 19;
+        }
+        else if (difficulty == 6) {
+            NaughtsxCrossess4x4 larger(screenBuffer);
+            larger.playGame(3, inputProvider);
+            promptRow = 2 * NaughtsxCrossess4x4::BOARD_SIZE + 6;
+        }
+        else if (difficulty == 7) {
+            NaughtsxCrossess5x5 larger(screenBuffer);
+            larger.playGame(3, inputProvider);
+            promptRow = 2 * NaughtsxCrossess5x5::BOARD_SIZE + 6;
+        }
+        else {
+            playGame(difficulty, inputProvider);
+        }
 
-            if (gameEnded) {
-                clearScreen();
-                screenBuffer->writeToScreen(0, 4, L"Game stopped by the player.");
-                gameOver = true;
-                break;
-            }
+        // Ask if player wants to play again
+        screenBuffer->writeToScreen(0, promptRow, L"Do you want to play again? (y/n): ");
+        std::string playAgainInput = inputProvider ? inputProvider() : screenBuffer->getBlockingInput();
 
-            clearScreen();
-            printBoardWithNumbers();  // Show numbered board
-            printBoard();  // Show current board with pieces
+        if (playAgainInput != "y" && playAgainInput != "Y") {
+            playAgain = false;
+        }
+    }
 
-            if (evaluate() == -10) {
-                clearScreen();
-                printBoard();
-                screenBuffer->writeToScreen(0, 8, L"Player O wins!");
-                gameOver = true;
-                break;
-            }
+    screenBuffer->writeToScreen(0, 2 * BOARD_SIZE + 7, L"Thanks for playing!");
+}
 
-            if (!isMovesLeft()) {
-                clearScreen();
-                printBoard();
-                screenBuffer->writeToScreen(0, 8, L"It's a draw!");
-                gameOver = true;
-                break;
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::printGomokuBoard(const GomokuBoard& gomoku) const {
+    std::wstring header = L"   ";
+    for (int x = 0; x < GomokuBoard::WIDTH; ++x) {
+        header += (x < 9 ? L"  " : L" ") + std::to_wstring(x + 1);
+    }
+    screenBuffer->writeToScreen(0, 0, header);
+
+    for (int y = 0; y < GomokuBoard::HEIGHT; ++y) {
+        screenBuffer->writeToScreen(0, y + 1, (y < 9 ? L" " : L"") + std::to_wstring(y + 1));
+        for (int x = 0; x < GomokuBoard::WIDTH; ++x) {
+            int cell = y * GomokuBoard::WIDTH + x;
+            int player = gomoku.get(x, y);
+            std::wstring symbol = player == 1 ? L"O" : (player == 2 ? L"X" : L".");
+            WORD colour = player == 1 ? ScreenBuffer::CYAN : (player == 2 ? ScreenBuffer::RED : ScreenBuffer::WHITE);
+            if (gomoku.getMoveCount() && cell == gomoku.getLastMove()) {
+                colour = ScreenBuffer::YELLOW;
             }
+            screenBuffer->writeToScreen(5 + x * 3, y + 1, symbol, colour, ScreenBuffer::BACKGROUND_NORMAL);
+        }
+    }
+}
 
-            if (isPvP) {
-                if (!playerMove('x', inputProvider)) {  // Player 2 move
-                    clearScreen();
-                    screenBuffer->writeToScreen(0, 7, L"Game stopped by the player.");
-                    gameOver = true;
-                    break;
-                }
-            }
-            else {
-                clearScreen();
-                screenBuffer->writeToScreen(0, 8, L"AI is making a move...");
-                aiMove(difficulty);
-            }
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::playGomoku(std::function<std::string()> inputProvider) {
+    GomokuBoard gomoku;
+    GomokuAI<GomokuBoard> ai;
 
-            clearScreen();
-            printBoardWithNumbers();  // Show numbered board
-            printBoard();  // Show current board with pieces
+    while (!gomoku.getWinner() && !gomoku.isFull()) {
+        clearScreen();
+        printGomokuBoard(gomoku);
+        screenBuffer->writeToScreen(0, 17, L"Enter your move as 'row column' (1-15) or type 'stop' to end the game: ");
 
-            if (evaluate() == 10) {
-                clearScreen();
-                printBoard();
-                screenBuffer->writeToScreen(0, 9, isPvP ? L"Player X wins!" : L"AI wins!");
-                gameOver = true;
-                break;
-            }
+        std::string input = inputProvider ? inputProvider() : screenBuffer->getBlockingInput();
+        if (input == "stop") {
+            screenBuffer->writeToScreen(0, 19, L"Game stopped by the player.");
+            return;
+        }
 
-            if (!isMovesLeft()) {
-                clearScreen();
-                printBoard();
-                screenBuffer->writeToScreen(0, 10, L"It's a draw!");
-                gameOver = true;
-                break;
+        std::istringstream stream(input);
+        int row = 0, col = 0;
+        if (!(stream >> row >> col) || row < 1 || row > GomokuBoard::HEIGHT || col < 1 || col > GomokuBoard::WIDTH ||
+            gomoku.get(col - 1, row - 1)) {
+            screenBuffer->writeToScreen(0, 19, L"Invalid move. press 'enter' to try again...");
+            if (!inputProvider) {
+                screenBuffer->getBlockingInput();
             }
+            continue;
         }
 
-        // Ask if player wants to play again
-        screenBuffer->writeToScreen(0, 12, L"Do you want to play again? (y/n): ");
-        std::string playAgainInput = inputProvider ? inputProvider() : screenBuffer->getBlockingInput();
-
-        if (playAgainInput != "y" && playAgainInput != "Y") {
-            playAgain = false;
+        gomoku.setTurn(1);
+        gomoku.makeMove((row - 1) * GomokuBoard::WIDTH + (col - 1));
+        if (gomoku.getWinner() || gomoku.isFull()) {
+            break;
         }
+
+        clearScreen();
+        printGomokuBoard(gomoku);
+        screenBuffer->writeToScreen(0, 17, L"AI is making a move...");
+        gomoku.makeMove(ai.chooseMove(gomoku, 1.0));
     }
 
-    screenBuffer->writeToScreen(0, 13, L"Thanks for playing!");
+    clearScreen();
+    printGomokuBoard(gomoku);
+    if (gomoku.getWinner() == 1) {
+        screenBuffer->writeToScreen(0, 17, L"Player O wins!");
+    }
+    else if (gomoku.getWinner() == 2) {
+        screenBuffer->writeToScreen(0, 17, L"AI wins!");
+    }
+    else {
+        screenBuffer->writeToScreen(0, 17, L"It's a draw!");
+    }
 }
 
-void NaughtsxCrossess::resetBoard() {
+template <int N, int K>
+void NaughtsxCrossessGame<N, K>::resetBoard() {
     for (int i = 0; i < BOARD_SIZE; ++i) {
         for (int j = 0; j < BOARD_SIZE; ++j) {
             board[i][j] = ' ';
@@ -434,6 +513,12 @@ void NaughtsxCrossess::resetBoard() {
     }
 }
 
-char& NaughtsxCrossess::getBoardValue(int row, int col) {
+template <int N, int K>
+char& NaughtsxCrossessGame<N, K>::getBoardValue(int row, int col) {
     return board[row][col];  // Return a reference to the board cell
 }
+
+// The board sizes the game is played on
+template class NaughtsxCrossessGame<3, 3>;
+template class NaughtsxCrossessGame<4, 4>;
+template class NaughtsxCrossessGame<5, 4>;
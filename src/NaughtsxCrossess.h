@@ -7,36 +7,63 @@
 #include <limits>
 #include <cstdlib>
 #include <ctime>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <algorithm>
 #include "ScreenBuffer.h"
+#include "gomokuAI.h"
+#include "mnkBoard.h"
+#include "mnkSearch.h"
+
+/// @brief Class template representing the Noughts and Crosses (Tic-Tac-Toe) game on an N x N board, needing K in a row.
+/// @details The board is kept as characters for display and input. The AI copies it onto an MnkBoard and plays it
+/// @details with MnkSearch, the same engine as Connect 4, keyed by a hash shared by every rotation and reflection.
+/// @tparam N The width and height of the board, 3 to 5.
+/// @tparam K The number in a row needed to win.
+template <int N, int K = N>
+class NaughtsxCrossessGame {
+    static_assert(N >= 3 && N <= 5, "Larger boards are Gomoku's");
+    static_assert(K >= 3 && K <= N, "The winning line must fit on the board");
 
-const int BOARD_SIZE = 3; ///< Updated constant name to avoid conflicts
+public:
+    static const int BOARD_SIZE = N;                 ///< The width and height of the board.
+    static const int WIN_LENGTH = K;                 ///< The number in a row needed to win.
+    static const int CELLS = N * N;                  ///< The number of cells.
+
+    typedef MnkBoard<N, N, K, false> Board;                    ///< The board the AI searches, 'x' as player 1.
+    typedef MnkSearch<Board, MnkSymmetricPolicy<Board>> Search; ///< The AI's search.
 
-/// @brief Class representing the Noughts and Crosses (Tic-Tac-Toe) game.
-class NaughtsxCrossess {
 private:
     char board[BOARD_SIZE][BOARD_SIZE]; ///< The game board.
     ScreenBuffer* screenBuffer;         ///< ScreenBuffer pointer for managing console output.
     bool ownsScreenBuffer;              ///< Track if the class owns the screen buffer.
     bool gameEnded;
 
+    static const int TABLE_BITS = (N * N <= 9) ? 12 : 18; ///< The size of the search's table, as a power of two.
+
+    Search search;                      ///< The AI's search, whose table is kept between moves and games.
+
+    /// @brief Copies the character board onto a board the search can play on.
+    /// @param isMax True if 'x' is to move.
+    /// @return The board, 'x' as player 1 and 'o' as player 2.
+    Board toSearchBoard(bool isMax) const;
+
 public:
     /// @brief Constructor to initialize the game board.
-    NaughtsxCrossess();
+    NaughtsxCrossessGame();
 
     /// @brief Copy Constructor
-    NaughtsxCrossess(const NaughtsxCrossess& other);
+    NaughtsxCrossessGame(const NaughtsxCrossessGame& other);
 
     /// @brief Copy Assignment Operator
-    NaughtsxCrossess& operator=(const NaughtsxCrossess& other);
+    NaughtsxCrossessGame& operator=(const NaughtsxCrossessGame& other);
 
     /// @brief Constructor that accepts an external ScreenBuffer.
-    explicit NaughtsxCrossess(ScreenBuffer* buffer);
+    explicit NaughtsxCrossessGame(ScreenBuffer* buffer);
 
     /// @brief Destructor to clean up internal ScreenBuffer if we own it.
-    ~NaughtsxCrossess();
+    ~NaughtsxCrossessGame();
 
     /// @brief Sets the ScreenBuffer to be used by the game.
     void setScreenBuffer(ScreenBuffer* buffer);
@@ -44,7 +71,7 @@ public:
     /// @brief Prints the current state of the board.
     void printBoard() const;
 
-    /// @brief Prints the board with numbers 1-9 to indicate cell positions.
+    /// @brief Prints the board with numbers to indicate cell positions, laid out like a numpad.
     void printBoardWithNumbers() const;
 
     /// @brief Checks if there are any moves left on the board.
@@ -56,6 +83,8 @@ public:
     int evaluate() const;
 
     /// @brief Minimax algorithm to calculate the best move for the AI.
+    /// @details Searched by MnkSearch with alpha-beta cutoffs and results kept under every symmetry of the board, so the
+    /// @details full game tree of 3x3 takes a few hundred positions rather than over half a million.
     /// @param depth The current depth of the recursion.
     /// @param isMax True if the AI is maximizing, false if minimizing.
     /// @param difficulty The depth limit for Medium difficulty.
@@ -63,10 +92,19 @@ public:
     int minimax(int depth, bool isMax, int difficulty);
 
     /// @brief Finds the best move for the AI based on the current board state.
+    /// @details Quicker wins are preferred, and when the depth limit is reached the lines still open to each player decide.
     /// @param difficulty The difficulty level of the AI.
     /// @return The best move as a pair of integers representing row and column.
     std::pair<int, int> findBestMove(int difficulty);
 
+    /// @brief Gets how many positions minimax visited for the last findBestMove.
+    /// @return The count.
+    long long getNodesSearched() const;
+
+    /// @brief Gets how deep the Hard AI searches on this board.
+    /// @return The whole game on 3x3 and 4x4, fewer moves on larger boards.
+    static int hardDepth();
+
     /// @brief Handles player input for a move with optional input simulation for testing.
     /// @param player The character representing the player ('x' or 'o').
     /// @param inputProvider A function or lambda that provides input for testing.
@@ -90,13 +128,30 @@ public:
     /// @return A reference to the value at the specified position.
     char& getBoardValue(int row, int col);
 
-    /// @brief Converts a move number (1-9) to board coordinates based on numpad layout.
+    /// @brief Converts a move number to board coordinates based on numpad layout, 1 at the bottom left.
     /// @param moveNumber The move number entered by the player.
-    /// @return A pair of integers representing the row and column.
+    /// @return A pair of integers representing the row and column, or -1, -1 if there is no such cell.
     std::pair<int, int> moveNumberToPosition(int moveNumber) const;
 
+    /// @brief Prints a Gomoku board, with the last move highlighted.
+    /// @param gomoku The board.
+    void printGomokuBoard(const GomokuBoard& gomoku) const;
+
+    /// @brief Plays a game of Gomoku, five in a row on a 15x15 board, against the threat-space search AI.
+    /// @param inputProvider A function or lambda that provides input for testing.
+    void playGomoku(std::function<std::string()> inputProvider = nullptr);
+
+    /// @brief Plays one game on this board, the player as 'o' moving first.
+    /// @param difficulty 1 = Easy, 2 = Medium, 3 = Hard, 4 = Player vs Player.
+    /// @param inputProvider A function or lambda that provides input for testing.
+    void playGame(int difficulty, std::function<std::string()> inputProvider = nullptr);
+
     /// @brief Runs and manages the game.
     void run(std::function<std::string()> inputProvider = nullptr);
 };
 
+typedef NaughtsxCrossessGame<3, 3> NaughtsxCrossess; ///< The classic 3x3 game.
+typedef NaughtsxCrossessGame<4, 4> NaughtsxCrossess4x4; ///< 4x4, four in a row.
+typedef NaughtsxCrossessGame<5, 4> NaughtsxCrossess5x5; ///< 5x5, four in a row.
+
 #endif // NAUGHTS_AND_CROSSES_H
@@ -7,22 +7,39 @@
 
 class RealScreenBuffer : public IScreenBuffer {
 private:
-    ScreenBuffer screenBuffer;
+    ScreenBuffer* screenBuffer;
+    bool ownsScreenBuffer;
 public:
+    // Default constructor, creates its own ScreenBuffer
+    RealScreenBuffer() : screenBuffer(new ScreenBuffer()), ownsScreenBuffer(true) {}
+
+    // Constructor that shares an existing ScreenBuffer, which must outlive this one
+    explicit RealScreenBuffer(ScreenBuffer* buffer) : screenBuffer(buffer), ownsScreenBuffer(false) {}
+
+    RealScreenBuffer(const RealScreenBuffer&) = delete;
+    RealScreenBuffer& operator=(const RealScreenBuffer&) = delete;
+
+    // Destructor to clean up the ScreenBuffer if owned
+    virtual ~RealScreenBuffer() {
+        if (ownsScreenBuffer) {
+            delete screenBuffer;
+        }
+    }
+
     virtual void writeToScreen(int x, int y, const std::wstring& text) override {
-        screenBuffer.writeToScreen(x, y, text);
+        screenBuffer->writeToScreen(x, y, text);
     }
 
     virtual std::string getBlockingInput() override {
-        return screenBuffer.getBlockingInput();
+        return screenBuffer->getBlockingInput();
     }
 
     virtual void clearScreen() override {
-        screenBuffer.clearScreen();
+        screenBuffer->clearScreen();
     }
 
     virtual void setActive() override {
-        screenBuffer.setActive();
+        screenBuffer->setActive();
     }
 
     // Implement other methods if needed
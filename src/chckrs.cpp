@@ -1,140 +1,225 @@
 #include "chckrs.h"
+#include <stdexcept>
 
-using namespace std;
-
-int checkersGrid[8][8];
-int player1 = 1, player2 = 2, currentplaying = 1;
-bool winnerquestionmark = false;
-
-void populateCheckersGrid()
-{
-    for (int i = 0; i < 7; i++)
-    {
-        for (int j = 0; i < 7; i++)
-        {
-            if (i < 3 && j % 2 == 1)
-            {
-                checkersGrid[i][j] = 1;
-            }
-            else if (i > 4 && j % 2 == 0)
-            {
-                checkersGrid[i][j] = 2;
-            }
-            else
-            {
-                checkersGrid[i][j] = 0;
-            }
-        }
+const char* const Checkers::ENDGAME_DATABASE_FILE = "checkers.endgame";
+
+
+// Constructor for the Checkers class
+Checkers::Checkers(ScreenBuffer* buffer) : ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
+    generateBoard();
+    loadEndgameDatabase();
+}
+
+
+// Opens the endgame database, if there is one
+bool Checkers::loadEndgameDatabase() {
+    // The database is optional; without one the computer searches endings like any other position
+    try {
+        endgameDatabase.reset(new CheckersEndgameDatabase(ENDGAME_DATABASE_FILE));
+        ai.setEndgameDatabase(endgameDatabase.get());
+        return true;
+    }
+    catch (const std::runtime_error&) {
+        ai.setEndgameDatabase(nullptr);
+        endgameDatabase.reset();
+        return false;
     }
 }
 
-void forcejump(int playerturn, string piece) // piece should be like x 1, y 0 as 10
-{
-    if (playerturn == 1)
-    {
-        if (/*piece is king && (checkersGrid[piecex - 1][piecey + 1] == 2 && checkersGrid[piecex - 2][piecey + 2] == 0) || (checkersGrid[piecex + 1][piecey + 1] == 2 && checkersGrid[piecex + 2][piecey + 2] == 0)*/true) // backward captures
-        {
 
-        }
+// Offers to build the endgame database, which is the only way the file is made
+void Checkers::offerEndgameDatabase() {
+    screenBuffer.writeToScreen(4, 4, L"There is no endgame database. Build one now? It takes a few minutes. (y/n) ");
 
-        if (/*(checkersGrid[piecex - 1][piecey - 1] == 2 && checkersGrid[piecex - 2][piecey - 2] == 0) || (checkersGrid[piecex + 1][piecey - 1] == 2 && checkersGrid[piecex + 2][piecey - 2] == 0)*/true) // forward captures
-        {
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
 
+        if (input == "n") {
+            return;
+        }
+        if (input == "y") {
+            break;
         }
+        screenBuffer.writeToScreen(4, 4, L"Please enter 'y' or 'n':                                                     ");
     }
-    else
-    {
-        if (/*(checkersGrid[piecex - 1][piecey - 1] == 2 && checkersGrid[piecex - 2][piecey - 2] == 0) || (checkersGrid[piecex + 1][piecey - 1] == 2 && checkersGrid[piecex + 2][piecey - 2] == 0)*/true) // backward captures
-        {
 
-        }
+    screenBuffer.writeToScreen(4, 6, L"Solving every ending with up to " + std::to_wstring(ENDGAME_DATABASE_PIECES) + L" pieces...");
+    try {
+        CheckersEndgameBuilder builder(ENDGAME_DATABASE_PIECES);
+        builder.build();
+        builder.write(ENDGAME_DATABASE_FILE);
+    }
+    catch (const std::runtime_error&) {
+        screenBuffer.writeToScreen(4, 7, L"The database could not be written. The computer will play without it.");
+        return;
+    }
+    loadEndgameDatabase();
+}
 
-        if (/*piece is king && (checkersGrid[piecex - 1][piecey + 1] == 2 && checkersGrid[piecex - 2][piecey + 2] == 0) || (checkersGrid[piecex + 1][piecey + 1] == 2 && checkersGrid[piecex + 2][piecey + 2] == 0)*/true) // forward captures
-        {
 
-        }
-    }
+// Resets the board to the starting position
+void Checkers::generateBoard() {
+    board.setStartPosition();
 }
 
-void checkwin()
-{
-    bool one = false, two = false;
-
-    for (int i = 0; i < 7; i++)
-    {
-        for (int j = 0; i < 7; i++)
-        {
-            if (checkersGrid[i][j] == 1)
-            {
-                one = true;
-            }
-            else if (checkersGrid[i][j] == 2)
-            {
 
+// Gets the board being played
+CheckersBoard& Checkers::getBoard() {
+    return board;
+}
+
+
+// Checks for valid move input
+bool Checkers::isValidInput(const std::string& input) const {
+    // Two or more square numbers separated by '-' for a step or 'x' for a jump
+    std::regex pattern(R"(^\d{1,2}( ?[-xX] ?\d{1,2})+$)");
+
+    return std::regex_match(input, pattern);
+}
+
+
+// Prints the current state of the board, black at the top as in checkers diagrams
+void Checkers::printBoard() {
+    const std::wstring pieceLetters = L"bBwW";
+
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 0, L"  Black (b, B) moves down, white (w, W) moves up");
+
+    for (int row = 0; row < 8; row++) {
+        // Print horizontal line
+        screenBuffer.writeToScreen(4, row * 2 + 1, L"  +---+---+---+---+---+---+---+---+");
+
+        // Print the dark squares, which are offset by one on the even rows
+        std::wstring rowText = L"  |";
+        for (int column = 0; column < 8; column++) {
+            bool dark = (column % 2) == ((row % 2 == 0) ? 1 : 0);
+            if (!dark) {
+                rowText += L"   |";
+                continue;
             }
 
-            cout << "\t " << (j + 1) << "shit";
+            int square = row * 4 + column / 2;
+            int piece = board.getPiece(square);
+            if (piece == CheckersBoard::EMPTY_SQUARE) {
+                std::wstring number = std::to_wstring(square + 1);
+                rowText += ((number.size() == 1) ? L" " : L"") + number + L" |";
+            }
+            else {
+                rowText += L" ";
+                rowText += pieceLetters[piece];
+                rowText += L" |";
+            }
         }
+
+        screenBuffer.writeToScreen(4, row * 2 + 2, rowText);
     }
+
+    // Print the final horizontal line at the bottom
+    screenBuffer.writeToScreen(4, 17, L"  +---+---+---+---+---+---+---+---+");
 }
 
-void playerturn(int curre)
-{
 
-}
+// Asks whether to return to the menu or exit
+int Checkers::endGame() {
+    screenBuffer.writeToScreen(4, 22, L"Type 'return' to return to the main menu, or 'exit' to exit MiniGame-Madness.");
 
-void move(int playerturn, string piece)
-{
-    if (playerturn == 1)
-    {
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
 
+        if (input == "return") {
+            return 0;
+        }
+        else if (input == "exit") {
+            return 1;
+        }
+        else {
+            screenBuffer.writeToScreen(4, 22, L"Invalid input. Please type 'return' or 'exit':                                 ");
+        }
     }
 }
 
-int randomstarter()
-{
-    return 1 + (rand() % 2);
-}
 
-void swapturn(int playert)
-{
-    if (playert == 1)
-    {
-        currentplaying = 2;
+// The game loop, two players taking turns at the same keyboard or one against the computer
+int Checkers::run() {
+    CheckersMoveList moves;
+
+    screenBuffer.setActive();
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Play against the computer? (y/n) ");
+
+    bool computerOpponent = false;
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "y" || input == "n") {
+            computerOpponent = (input == "y");
+            break;
+        }
+        screenBuffer.writeToScreen(4, 2, L"Please enter 'y' or 'n':          ");
     }
-    else {
-        currentplaying = 1;
+
+    if (computerOpponent && !endgameDatabase) {
+        offerEndgameDatabase();
     }
-}
 
-void display()
-{
-    cout << "\t 1 \t 2 \t 3 \t 4 \t 5 \t 6 \t 7 \t 8 \n";
+    generateBoard();
+    ai.clear();
+    printBoard();
+
+    while (true) {
+        board.generateMoves(moves);
+        std::wstring side = (board.getSideToMove() == CheckersBoard::BLACK) ? L"Black" : L"White";
+        std::wstring other = (board.getSideToMove() == CheckersBoard::BLACK) ? L"White" : L"Black";
 
-    for (int i = 0; i < 7; i++)
-    {
-        for (int j = 0; i < 7; i++)
-        {
-            cout << "\t " << (j + 1) << "shit";
+        // A side with no pieces left or no moves loses
+        if (moves.size() == 0) {
+            screenBuffer.writeToScreen(4, 20, side + L" cannot move. " + other + L" wins!");
+            break;
+        }
+
+        if (board.getQuietPlies() >= CheckersBoard::DRAW_PLIES) {
+            screenBuffer.writeToScreen(4, 20, L"Forty moves each without a capture or a man moving. The game is a draw.");
+            break;
+        }
+
+        // The computer plays white
+        if (computerOpponent && board.getSideToMove() == CheckersBoard::WHITE) {
+            screenBuffer.writeToScreen(4, 20, L"The computer is thinking...");
+
+            CheckersSearchResult result = ai.search(board, COMPUTER_MAX_DEPTH, COMPUTER_MOVE_TIME_MS);
+            std::string played = CheckersBoard::moveToString(result.bestMove);
+
+            board.makeMove(result.bestMove);
+            printBoard();
+            screenBuffer.writeToScreen(4, 18, L"The computer played " + std::wstring(played.begin(), played.end()) + L".");
+            continue;
         }
-    }
-}
 
-void checkers()
-{
-    populateCheckersGrid();
+        if (moves[0].isCapture()) {
+            screenBuffer.writeToScreen(4, 19, side + L" must jump.");
+        }
 
-    while (winnerquestionmark == false)
-    {
-        playerturn(currentplaying);
+        screenBuffer.writeToScreen(4, 20, side + L" to move (e.g., 11-15 or 22x15), or 'resign': ");
+        std::string input = screenBuffer.getBlockingInput();
 
-        checkwin();
+        if (input == "resign") {
+            screenBuffer.writeToScreen(4, 21, side + L" resigns. " + other + L" wins!");
+            break;
+        }
 
-        //checkdraw();
+        CheckersMove move;
+        if (isValidInput(input)) {
+            move = board.parseMove(input);
+        }
 
-        swapturn(currentplaying);
+        if (move.isNull()) {
+            screenBuffer.writeToScreen(4, 21, L"That is not a legal move. Please enter a move in the format '11-15':");
+            continue;
+        }
+
+        board.makeMove(move);
+        printBoard();
     }
 
-    string see = "seel";
-    cout << see;
-}
\ No newline at end of file
+    return endGame();
+}
@@ -1,24 +1,91 @@
-// chckrs.h
-
 #ifndef CHCKRS_H
 #define CHCKRS_H
 
+/*!
+* @file chckrs.h
+* @brief Contains the declaration of the Checkers class and its member functions for the checkers game.
+*/
+
+#include "ScreenBuffer.h"
+#include "checkersAI.h"
+#include "checkersBoard.h"
+#include "checkersEndgame.h"
+#include <memory>
 #include <string>
-#include <iostream>
-#include <sstream>
-
-extern int checkersGrid[8][8];
-extern int player1, player2, currentplaying;
-extern bool winnerquestionmark;
-
-void populateCheckersGrid();
-void forcejump(int playerturn, std::string piece);
-void checkwin();
-void playerturn(int curre);
-void move(int playerturn, std::string piece);
-int randomstarter();
-void swapturn(int playert);
-void display();
-void checkers();
-
-#endif // CHCKRS_H
\ No newline at end of file
+#include <regex>
+
+/*!
+* @class Checkers
+* @brief A class that represents the game of Checkers.
+* @details The rules live in CheckersBoard; this class draws the board and runs the game loop.
+*/
+class Checkers {
+ private:
+
+	static const int COMPUTER_MOVE_TIME_MS = 1000; /*!< How long the computer thinks about each move. */
+	static const int COMPUTER_MAX_DEPTH = 40; /*!< The deepest the computer searches, if it has the time. */
+	static const char* const ENDGAME_DATABASE_FILE; /*!< The endgame database the computer plays endings from, if it exists. */
+	static const int ENDGAME_DATABASE_PIECES = CheckersEndgame::MAX_PIECES; /*!< The most pieces in a database built here. */
+
+	CheckersBoard board; /*!< The position being played. */
+	CheckersAI ai; /*!< The computer opponent. */
+	std::unique_ptr<CheckersEndgameDatabase> endgameDatabase; /*!< The computer's endgame database, or null if there is no database file. */
+	std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
+
+	/*!
+	* @brief Prints the current state of the board, numbering the empty dark squares.
+	*/
+	void printBoard();
+
+	/*!
+	* @brief Opens the endgame database file and has the computer play endings from it, if the file exists.
+	* @return true if the database was opened.
+	*/
+	bool loadEndgameDatabase();
+
+	/*!
+	* @brief Offers to build the endgame database when there is none, then builds, writes and opens it if asked to.
+	*/
+	void offerEndgameDatabase();
+
+	/*!
+	* @brief Asks whether to return to the menu or exit once the game is over.
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int endGame();
+
+ public:
+	/*!
+	* @brief Constructor for the Checkers class, sets up the starting position.
+	* @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
+	*/
+	explicit Checkers(ScreenBuffer* buffer = nullptr);
+
+	/*!
+	* @brief Generate the game board.
+	* @details Resets the board to the standard starting position.
+	*/
+	void generateBoard();
+
+	/*!
+	* @brief Get the board being played.
+	* @return The board.
+	*/
+	CheckersBoard& getBoard();
+
+	/*!
+	* @brief Check for valid move input such as "11-15", "22x15" or "22x15x6".
+	* @param input The input from the user
+	* @return true if the input is valid, false otherwise.
+	*/
+	bool isValidInput(const std::string& input) const;
+
+	/*!
+	* @brief Run the game
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int run();
+};
+
+#endif // CHCKRS_H
@@ -0,0 +1,365 @@
+#include "checkersAI.h"
+#include "checkersEndgame.h"
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Piece values
+static const int MAN_VALUE = 100;
+static const int KING_VALUE = 135;
+
+// Bonus for a man by how many rows it has advanced from its own back row
+static const int ADVANCEMENT[8] = { 0, 1, 2, 4, 6, 9, 12, 0 };
+
+// Bonus for each man still guarding its own back row, which keeps the other side's men from being crowned
+static const int BACK_ROW_BONUS = 6;
+static const uint32_t BACK_ROW[2] = { 0x0000000F, 0xF0000000 };
+
+// Bonus for a king on the central squares, where it reaches the most of the board
+static const int CENTRAL_KING_BONUS = 8;
+static const uint32_t CENTRE = 0x00666600;
+
+// Move ordering scores, highest first
+static const int TABLE_MOVE_SCORE = 1 << 30;
+static const int CAPTURE_SCORE = 1 << 24;
+
+// How much each step between the winner's kings and the loser's pieces costs a won database position
+static const int CLOSING_IN_WEIGHT = 2;
+
+// Check the clock this often, in nodes
+static const uint64_t TIME_CHECK_INTERVAL = 1024;
+
+
+// Number of set bits
+static inline int countBits(uint32_t bitboard) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(bitboard));
+#elif defined(__GNUC__)
+    return __builtin_popcount(bitboard);
+#else
+    int count = 0;
+    while (bitboard) {
+        bitboard &= bitboard - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+// Win scores are stored relative to the position, so they stay right wherever it is found in the tree
+static int scoreToTable(int score, int ply) {
+    if (score >= CheckersAI::WIN_BOUND) {
+        return score + ply;
+    }
+    if (score <= -CheckersAI::WIN_BOUND) {
+        return score - ply;
+    }
+    return score;
+}
+
+static int scoreFromTable(int score, int ply) {
+    if (score >= CheckersAI::WIN_BOUND) {
+        return score - ply;
+    }
+    if (score <= -CheckersAI::WIN_BOUND) {
+        return score + ply;
+    }
+    return score;
+}
+
+
+// Constructor for the CheckersAI class
+CheckersAI::CheckersAI(size_t megabytes) : nodes(0), timeLimited(false), stopped(false), endgameDatabase(nullptr), databaseHits(0) {
+    size_t entries = 1;
+    while (entries * 2 * sizeof(TableEntry) <= megabytes * 1024 * 1024) {
+        entries *= 2;
+    }
+    table.resize(entries);
+    clear();
+}
+
+
+// Forgets the transposition table and history
+void CheckersAI::clear() {
+    std::fill(table.begin(), table.end(), TableEntry());
+    for (int from = 0; from < CheckersBoard::SQUARES; from++) {
+        for (int to = 0; to < CheckersBoard::SQUARES; to++) {
+            history[from][to] = 0;
+        }
+    }
+}
+
+
+// Sets the endgame database to score positions from
+void CheckersAI::setEndgameDatabase(CheckersEndgameDatabase* database) {
+    endgameDatabase = database;
+}
+
+
+// Evaluates a quiet position
+int CheckersAI::evaluate(const CheckersBoard& board) {
+    int scores[2] = { 0, 0 };
+    int material[2] = { 0, 0 };
+    uint32_t kings = board.getKings();
+
+    for (int side = CheckersBoard::BLACK; side <= CheckersBoard::WHITE; side++) {
+        uint32_t men = board.getPieces(side) & ~kings;
+        uint32_t sideKings = board.getPieces(side) & kings;
+
+        material[side] = countBits(men) * MAN_VALUE + countBits(sideKings) * KING_VALUE;
+        scores[side] = material[side];
+        scores[side] += countBits(men & BACK_ROW[side]) * BACK_ROW_BONUS;
+        scores[side] += countBits(sideKings & CENTRE) * CENTRAL_KING_BONUS;
+
+        while (men) {
+            int square = 0;
+            while (!(men >> square & 1)) {
+                square++;
+            }
+            men &= men - 1;
+
+            int row = square / 4;
+            scores[side] += ADVANCEMENT[(side == CheckersBoard::BLACK) ? row : 7 - row];
+        }
+    }
+
+    int score = scores[CheckersBoard::BLACK] - scores[CheckersBoard::WHITE];
+
+    // When ahead, trading pieces makes the lead count for more
+    int pieces = countBits(board.getPieces(CheckersBoard::BLACK) | board.getPieces(CheckersBoard::WHITE));
+    score += (material[CheckersBoard::BLACK] - material[CheckersBoard::WHITE]) * (24 - pieces) / 48;
+
+    return (board.getSideToMove() == CheckersBoard::BLACK) ? score : -score;
+}
+
+
+// Scores a position the endgame database knows
+int CheckersAI::scoreDatabaseValue(const CheckersBoard& board, int value) {
+    if (value == CheckersEndgame::DRAW) {
+        return 0;
+    }
+
+    int winner = (value == CheckersEndgame::WIN) ? board.getSideToMove() : board.getSideToMove() ^ 1;
+    int score = DATABASE_WIN_SCORE + ((value == CheckersEndgame::WIN) ? evaluate(board) : -evaluate(board));
+
+    // Kings have to hunt down the last pieces, so reward bringing them closer
+    uint32_t kings = board.getPieces(winner) & board.getKings();
+    while (kings) {
+        int king = 0;
+        while (!(kings >> king & 1)) {
+            king++;
+        }
+        kings &= kings - 1;
+
+        uint32_t targets = board.getPieces(winner ^ 1);
+        while (targets) {
+            int target = 0;
+            while (!(targets >> target & 1)) {
+                target++;
+            }
+            targets &= targets - 1;
+
+            // Dark squares on even rows are one column further right
+            int rowDistance = std::abs(king / 4 - target / 4);
+            int columnDistance = std::abs((2 * (king % 4) + (king / 4 + 1) % 2) - (2 * (target % 4) + (target / 4 + 1) % 2));
+            score -= CLOSING_IN_WEIGHT * std::max(rowDistance, columnDistance);
+        }
+    }
+
+    return (value == CheckersEndgame::WIN) ? score : -score;
+}
+
+
+// Swaps the best scoring remaining move into place, so moves are only sorted as far as they are searched
+void CheckersAI::pickNextMove(CheckersMoveList& list, int* scores, int index) {
+    int best = index;
+    for (int i = index + 1; i < list.size(); i++) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+
+    if (best != index) {
+        std::swap(list[index], list[best]);
+        std::swap(scores[index], scores[best]);
+    }
+}
+
+
+// The alpha-beta search, carrying on through jumps past the nominal depth
+int CheckersAI::searchNode(const CheckersBoard& board, int depth, int alpha, int beta, int ply) {
+    if (++nodes % TIME_CHECK_INTERVAL == 0 && timeLimited && std::chrono::steady_clock::now() >= deadline) {
+        stopped = true;
+    }
+    if (stopped) {
+        return 0;
+    }
+
+    if (ply > 0 && board.getQuietPlies() >= CheckersBoard::DRAW_PLIES) {
+        return 0;
+    }
+
+    if (endgameDatabase && ply > 0 &&
+        countBits(board.getPieces(CheckersBoard::BLACK) | board.getPieces(CheckersBoard::WHITE)) <= endgameDatabase->getMaxPieces()) {
+        int value = endgameDatabase->probe(board);
+        if (value != CheckersEndgame::UNKNOWN) {
+            databaseHits++;
+            return scoreDatabaseValue(board, value);
+        }
+    }
+
+    CheckersMoveList list;
+    board.generateMoves(list);
+
+    // A side with no moves, whether it has no pieces left or they are all blocked, has lost
+    if (list.size() == 0) {
+        return -WIN_SCORE + ply;
+    }
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(board);
+    }
+
+    bool forced = list[0].isCapture();
+    if (depth <= 0 && !forced) {
+        return evaluate(board);
+    }
+
+    uint64_t key = board.getHash();
+    TableEntry& entry = table[key & (table.size() - 1)];
+    CheckersMove tableMove;
+
+    if (entry.key == key) {
+        tableMove = entry.move;
+
+        if (ply > 0 && entry.depth >= depth) {
+            int score = scoreFromTable(entry.score, ply);
+            if (entry.bound == BOUND_EXACT || (entry.bound == BOUND_LOWER && score >= beta) ||
+                (entry.bound == BOUND_UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    int scores[CheckersMoveList::MAX_MOVES];
+    for (int i = 0; i < list.size(); i++) {
+        const CheckersMove& move = list[i];
+        if (move == tableMove) {
+            scores[i] = TABLE_MOVE_SCORE;
+        }
+        else if (move.isCapture()) {
+            scores[i] = CAPTURE_SCORE + countBits(move.captures);
+        }
+        else {
+            scores[i] = history[move.from][move.to];
+        }
+    }
+
+    // The only legal move costs no depth
+    int childDepth = (list.size() == 1) ? depth : depth - 1;
+
+    int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    CheckersMove bestMove;
+
+    for (int i = 0; i < list.size(); i++) {
+        pickNextMove(list, scores, i);
+        const CheckersMove& move = list[i];
+
+        CheckersBoard child = board;
+        child.makeMove(move);
+        int score = -searchNode(child, childDepth, -beta, -alpha, ply + 1);
+
+        if (stopped) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (ply == 0) {
+                rootBestMove = move;
+            }
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            if (!move.isCapture()) {
+                history[move.from][move.to] += depth * depth;
+            }
+            break;
+        }
+    }
+
+    entry.key = key;
+    entry.move = bestMove;
+    entry.score = static_cast<int16_t>(scoreToTable(bestScore, ply));
+    entry.depth = static_cast<int8_t>(depth > 0 ? depth : 0);
+    entry.bound = static_cast<uint8_t>(bestScore <= originalAlpha ? BOUND_UPPER : (bestScore >= beta ? BOUND_LOWER : BOUND_EXACT));
+
+    return bestScore;
+}
+
+
+// Searches with iterative deepening until the depth or time runs out
+CheckersSearchResult CheckersAI::search(const CheckersBoard& board, int maxDepth, int moveTimeMs) {
+    CheckersSearchResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    nodes = 0;
+    databaseHits = 0;
+    stopped = false;
+    timeLimited = (moveTimeMs > 0);
+    deadline = start + std::chrono::milliseconds(moveTimeMs);
+
+    CheckersMoveList rootMoves;
+    board.generateMoves(rootMoves);
+    if (rootMoves.size() == 0) {
+        return result;
+    }
+
+    // Something to play even if the first iteration is cut short
+    result.bestMove = rootMoves[0];
+
+    if (maxDepth > MAX_PLY - 1) {
+        maxDepth = MAX_PLY - 1;
+    }
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        rootBestMove = CheckersMove();
+        int score = searchNode(board, depth, -INFINITE_SCORE, INFINITE_SCORE, 0);
+
+        // A cut short iteration still searched the previous best move first, so any better move it found can be trusted
+        if (stopped) {
+            if (!rootBestMove.isNull()) {
+                result.bestMove = rootBestMove;
+            }
+            break;
+        }
+
+        result.bestMove = rootBestMove;
+        result.score = score;
+        result.depth = depth;
+
+        // A forced win or loss will not change with more depth
+        if ((score >= WIN_BOUND || score <= -WIN_BOUND) && WIN_SCORE - std::abs(score) <= depth) {
+            break;
+        }
+
+        // The next iteration takes longer than all those before it, so do not start one that cannot finish
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (timeLimited && elapsed.count() * 2 >= moveTimeMs) {
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    result.databaseHits = databaseHits;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
@@ -0,0 +1,137 @@
+#ifndef CHECKERS_AI_H
+#define CHECKERS_AI_H
+
+/*!
+* @file checkersAI.h
+* @brief Contains the declaration of the CheckersAI class, an alpha-beta search for the checkers game.
+*/
+
+#include "checkersBoard.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+class CheckersEndgameDatabase;
+
+/*!
+* @struct CheckersSearchResult
+* @brief The outcome of a checkers search.
+*/
+struct CheckersSearchResult {
+	CheckersMove bestMove; /*!< The best move, or the null move if there are no legal moves. */
+	int score = 0; /*!< The score from the side to move's point of view. */
+	int depth = 0; /*!< The deepest iteration completed. */
+	uint64_t nodes = 0; /*!< The number of positions searched. */
+	uint64_t databaseHits = 0; /*!< The number of positions scored from the endgame database. */
+	double seconds = 0.0; /*!< The time taken. */
+};
+
+/*!
+* @class CheckersAI
+* @brief An iterative deepening alpha-beta search with a transposition table.
+* @details Because captures are compulsory a position with a jump is never scored as it stands: the search carries on
+* @details through the jumps until the position is quiet, and a move that is the only legal one does not use up depth.
+* @details Moves are ordered by the table move, then by the number of pieces captured, then by the history heuristic.
+* @details With an endgame database, positions with few enough pieces are scored from it instead of being searched.
+*/
+class CheckersAI {
+public:
+	static const int MAX_PLY = 96; /*!< The deepest the search can go. */
+	static const int WIN_SCORE = 30000; /*!< The score for a win now. */
+	static const int WIN_BOUND = WIN_SCORE - MAX_PLY; /*!< Scores above this are wins. */
+	static const int INFINITE_SCORE = 30001; /*!< Larger than any score. */
+	static const int DATABASE_WIN_SCORE = 10000; /*!< The base score of a win known from the endgame database. */
+
+private:
+	static const int BOUND_UPPER = 1; /*!< The score is at most the stored score. */
+	static const int BOUND_LOWER = 2; /*!< The score is at least the stored score. */
+	static const int BOUND_EXACT = 3; /*!< The score is exact. */
+
+	/*!
+	* @struct TableEntry
+	* @brief A searched position in the transposition table.
+	*/
+	struct TableEntry {
+		uint64_t key = 0; /*!< The position's hash, 0 for an empty slot. */
+		CheckersMove move; /*!< The best move found. */
+		int16_t score = 0; /*!< The score, with win scores relative to this position. */
+		int8_t depth = 0; /*!< The depth searched to. */
+		uint8_t bound = 0; /*!< The type of bound the score is. */
+	};
+
+	std::vector<TableEntry> table; /*!< The transposition table, a power of two entries. */
+	int history[CheckersBoard::SQUARES][CheckersBoard::SQUARES]; /*!< How often each step caused a cutoff, by from and to. */
+
+	uint64_t nodes; /*!< Positions searched so far. */
+	bool timeLimited; /*!< Whether the search has a deadline. */
+	bool stopped; /*!< Set when the time runs out, unwinding the search. */
+	std::chrono::steady_clock::time_point deadline; /*!< When the search must stop. */
+	CheckersMove rootBestMove; /*!< The best root move found in the current iteration. */
+	CheckersEndgameDatabase* endgameDatabase; /*!< The endgame database, or null if there is none. */
+	uint64_t databaseHits; /*!< Positions scored from the endgame database so far. */
+
+	/*!
+	* @brief Score a position the endgame database knows.
+	* @details A won position scores DATABASE_WIN_SCORE plus the evaluation, and a bonus for the winner's kings closing
+	* @details in on the loser's pieces, so the search still makes progress towards converting the win.
+	* @param board The position.
+	* @param value The database's value for the side to move.
+	* @return The score from the side to move's point of view.
+	*/
+	static int scoreDatabaseValue(const CheckersBoard& board, int value);
+
+	/*!
+	* @brief The alpha-beta search.
+	* @param board The position.
+	* @param depth The depth left to search.
+	* @param alpha The lower bound of the window.
+	* @param beta The upper bound of the window.
+	* @param ply The distance from the root.
+	* @return The score from the side to move's point of view.
+	*/
+	int searchNode(const CheckersBoard& board, int depth, int alpha, int beta, int ply);
+
+	/*!
+	* @brief Move the best scoring of the remaining moves to the front.
+	* @param list The moves.
+	* @param scores The ordering score of each move, swapped along with them.
+	* @param index The first move not yet searched.
+	*/
+	static void pickNextMove(CheckersMoveList& list, int* scores, int index);
+
+public:
+	/*!
+	* @brief Constructor for CheckersAI.
+	* @param megabytes The size of the transposition table.
+	*/
+	explicit CheckersAI(size_t megabytes = 8);
+
+	/*!
+	* @brief Forget the transposition table and history, for example before a new game.
+	*/
+	void clear();
+
+	/*!
+	* @brief Set the endgame database to score positions from.
+	* @param database The database, which must outlive the search, or null for none.
+	*/
+	void setEndgameDatabase(CheckersEndgameDatabase* database);
+
+	/*!
+	* @brief Search for the best move.
+	* @param board The position.
+	* @param maxDepth The deepest iteration to search.
+	* @param moveTimeMs The time allowed in milliseconds, or 0 for no limit.
+	* @return The best move and what the search found.
+	*/
+	CheckersSearchResult search(const CheckersBoard& board, int maxDepth, int moveTimeMs = 0);
+
+	/*!
+	* @brief Evaluate a quiet position: material, men's advancement, a guarded back row and central kings.
+	* @param board The position.
+	* @return The score from the side to move's point of view.
+	*/
+	static int evaluate(const CheckersBoard& board);
+};
+
+#endif // CHECKERS_AI_H
@@ -0,0 +1,450 @@
+#include "checkersBoard.h"
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+const std::string CheckersBoard::START_FEN = "B:W21-32:B1-12";
+
+// Squares of the even rows (0, 2, 4, 6), whose dark squares are one column to the right of the odd rows'
+static const uint32_t EVEN_ROWS = 0x0F0F0F0F;
+static const uint32_t ODD_ROWS = 0xF0F0F0F0;
+
+// The first and last square of each row
+static const uint32_t LEFT_EDGE = 0x11111111;
+static const uint32_t RIGHT_EDGE = 0x88888888;
+
+// The row a man is crowned on, for each side
+static const uint32_t CROWNING_ROW[2] = { 0xF0000000, 0x0000000F };
+
+
+// Index of the least significant set bit
+static inline int lowestBit(uint32_t bitboard) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bitboard);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctz(bitboard);
+#else
+    int index = 0;
+    while (!(bitboard & 1)) {
+        bitboard >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Removes and returns the least significant set bit
+static inline int popLowestBit(uint32_t& bitboard) {
+    int index = lowestBit(bitboard);
+    bitboard &= bitboard - 1;
+    return index;
+}
+
+// Whether a man of the given side moves in a direction
+static inline bool isForward(int side, int direction) {
+    return (direction >= CheckersBoard::DOWN_LEFT) == (side == CheckersBoard::BLACK);
+}
+
+// Mixes the bits of a number, for hashing
+static inline uint64_t mixBits(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+
+// Constructor for the CheckersBoard class
+CheckersBoard::CheckersBoard() {
+    setStartPosition();
+}
+
+
+// Sets up the starting position
+void CheckersBoard::setStartPosition() {
+    pieces[BLACK] = 0x00000FFF;
+    pieces[WHITE] = 0xFFF00000;
+    kings = 0;
+    sideToMove = BLACK;
+    quietPlies = 0;
+}
+
+
+// Removes every piece
+void CheckersBoard::clear() {
+    pieces[BLACK] = 0;
+    pieces[WHITE] = 0;
+    kings = 0;
+    sideToMove = BLACK;
+    quietPlies = 0;
+}
+
+
+// Reads a square number from 1 to 32, throwing if it is not one
+static int parseSquareNumber(const std::string& text, const std::string& fen) {
+    if (text.empty() || text.size() > 2 || !std::isdigit(static_cast<unsigned char>(text[0])) ||
+        !std::isdigit(static_cast<unsigned char>(text.back()))) {
+        throw std::runtime_error("Invalid checkers FEN: " + fen);
+    }
+
+    int number = std::stoi(text);
+    if (number < 1 || number > CheckersBoard::SQUARES) {
+        throw std::runtime_error("Invalid checkers FEN: " + fen);
+    }
+    return number;
+}
+
+
+// Sets up a position from PDN FEN
+void CheckersBoard::setFen(const std::string& fen) {
+    std::string text;
+    for (char c : fen) {
+        if (!std::isspace(static_cast<unsigned char>(c)) && c != '.' && c != '"') {
+            text += c;
+        }
+    }
+
+    if (text.empty() || (text[0] != 'B' && text[0] != 'W')) {
+        throw std::runtime_error("Invalid checkers FEN: " + fen);
+    }
+
+    clear();
+    sideToMove = (text[0] == 'B') ? BLACK : WHITE;
+
+    std::istringstream fields(text.substr(1));
+    std::string field;
+    while (std::getline(fields, field, ':')) {
+        if (field.empty()) {
+            continue;
+        }
+        if (field[0] != 'B' && field[0] != 'W') {
+            throw std::runtime_error("Invalid checkers FEN: " + fen);
+        }
+        int side = (field[0] == 'B') ? BLACK : WHITE;
+
+        std::istringstream squares(field.substr(1));
+        std::string item;
+        while (std::getline(squares, item, ',')) {
+            if (item.empty()) {
+                continue;
+            }
+
+            bool king = (item[0] == 'K');
+            if (king) {
+                item.erase(0, 1);
+            }
+
+            size_t dash = item.find('-');
+            int first = parseSquareNumber(item.substr(0, dash), fen);
+            int last = (dash == std::string::npos) ? first : parseSquareNumber(item.substr(dash + 1), fen);
+
+            for (int number = first; number <= last; number++) {
+                if (getPiece(number - 1) != EMPTY_SQUARE) {
+                    throw std::runtime_error("Invalid checkers FEN, square used twice: " + fen);
+                }
+                putPiece(side, number - 1, king);
+            }
+        }
+    }
+}
+
+
+// Gets the position as PDN FEN
+std::string CheckersBoard::getFen() const {
+    std::string fen = (sideToMove == BLACK) ? "B" : "W";
+    const char sideLetters[2] = { 'B', 'W' };
+    const int order[2] = { WHITE, BLACK };
+
+    for (int side : order) {
+        fen += ':';
+        fen += sideLetters[side];
+
+        bool first = true;
+        for (int square = 0; square < SQUARES; square++) {
+            if (!(pieces[side] >> square & 1)) {
+                continue;
+            }
+            if (!first) {
+                fen += ',';
+            }
+            if (kings >> square & 1) {
+                fen += 'K';
+            }
+            fen += std::to_string(square + 1);
+            first = false;
+        }
+    }
+
+    return fen;
+}
+
+
+// Puts a piece on an empty square
+void CheckersBoard::putPiece(int side, int square, bool king) {
+    uint32_t bit = uint32_t(1) << square;
+
+    pieces[side] |= bit;
+    if (king) {
+        kings |= bit;
+    }
+}
+
+
+// Gets the piece on a square
+int CheckersBoard::getPiece(int square) const {
+    uint32_t bit = uint32_t(1) << square;
+
+    for (int side = BLACK; side <= WHITE; side++) {
+        if (pieces[side] & bit) {
+            return side * 2 + ((kings & bit) ? 1 : 0);
+        }
+    }
+    return EMPTY_SQUARE;
+}
+
+
+// Gets a hash of the position
+uint64_t CheckersBoard::getHash() const {
+    uint64_t men = pieces[BLACK] | (uint64_t(pieces[WHITE]) << 32);
+    return mixBits(men) ^ mixBits(kings + (sideToMove + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+
+// Shifts squares one step diagonally. Moving down a row is +4 for one diagonal and +3 or +5 for the other,
+// depending on whether the row is odd or even; squares that would go off the side are masked out first
+uint32_t CheckersBoard::shift(uint32_t bitboard, int direction) {
+    switch (direction) {
+    case UP_LEFT:
+        return ((bitboard & EVEN_ROWS) >> 4) | ((bitboard & ODD_ROWS & ~LEFT_EDGE) >> 5);
+    case UP_RIGHT:
+        return ((bitboard & EVEN_ROWS & ~RIGHT_EDGE) >> 3) | ((bitboard & ODD_ROWS) >> 4);
+    case DOWN_LEFT:
+        return ((bitboard & EVEN_ROWS) << 4) | ((bitboard & ODD_ROWS & ~LEFT_EDGE) << 3);
+    default:
+        return ((bitboard & EVEN_ROWS & ~RIGHT_EDGE) << 5) | ((bitboard & ODD_ROWS) << 4);
+    }
+}
+
+
+// Finds the pieces with a step to an empty square
+uint32_t CheckersBoard::getMovers() const {
+    uint32_t ours = pieces[sideToMove];
+    uint32_t empty = ~(pieces[BLACK] | pieces[WHITE]);
+    uint32_t movers = 0;
+
+    for (int direction = 0; direction < 4; direction++) {
+        uint32_t candidates = isForward(sideToMove, direction) ? ours : (ours & kings);
+        movers |= shift(shift(candidates, direction) & empty, 3 - direction);
+    }
+    return movers;
+}
+
+
+// Finds the pieces that can jump: an opposing piece one step away with an empty square beyond it
+uint32_t CheckersBoard::getJumpers() const {
+    uint32_t ours = pieces[sideToMove];
+    uint32_t theirs = pieces[sideToMove ^ 1];
+    uint32_t empty = ~(ours | theirs);
+    uint32_t jumpers = 0;
+
+    for (int direction = 0; direction < 4; direction++) {
+        uint32_t candidates = isForward(sideToMove, direction) ? ours : (ours & kings);
+        uint32_t landings = shift(shift(candidates, direction) & theirs, direction) & empty;
+        jumpers |= shift(shift(landings, 3 - direction), 3 - direction);
+    }
+    return jumpers;
+}
+
+
+// Adds every jump sequence from a square. Jumped pieces stay on the board until the move ends, so they block
+// landing squares but cannot be jumped again
+void CheckersBoard::addJumps(CheckersMoveList& list, int from, int square, uint32_t captured, uint32_t path, uint32_t empty, bool king) const {
+    uint32_t theirs = pieces[sideToMove ^ 1] & ~captured;
+    uint32_t bit = uint32_t(1) << square;
+    bool jumped = false;
+
+    for (int direction = 0; direction < 4; direction++) {
+        if (!king && !isForward(sideToMove, direction)) {
+            continue;
+        }
+
+        uint32_t over = shift(bit, direction) & theirs;
+        uint32_t landing = shift(over, direction) & empty;
+        if (!landing) {
+            continue;
+        }
+        jumped = true;
+
+        // A man that reaches the far row is crowned, which ends the move
+        if (!king && (landing & CROWNING_ROW[sideToMove])) {
+            list.add(CheckersMove(from, lowestBit(landing), captured | over, path));
+            continue;
+        }
+
+        addJumps(list, from, lowestBit(landing), captured | over, path | landing, empty, king);
+    }
+
+    if (!jumped) {
+        list.add(CheckersMove(from, square, captured, path & ~bit));
+    }
+}
+
+
+// Generates the jumps, or the steps if there are no jumps
+void CheckersBoard::generateMoves(CheckersMoveList& list) const {
+    list.count = 0;
+
+    uint32_t ours = pieces[sideToMove];
+    uint32_t empty = ~(pieces[BLACK] | pieces[WHITE]);
+    uint32_t jumpers = getJumpers();
+
+    if (jumpers) {
+        while (jumpers) {
+            int from = popLowestBit(jumpers);
+            addJumps(list, from, from, 0, 0, empty | (uint32_t(1) << from), (kings >> from & 1) != 0);
+        }
+        return;
+    }
+
+    for (int direction = 0; direction < 4; direction++) {
+        uint32_t candidates = isForward(sideToMove, direction) ? ours : (ours & kings);
+        uint32_t targets = shift(candidates, direction) & empty;
+
+        while (targets) {
+            int to = popLowestBit(targets);
+            list.add(CheckersMove(lowestBit(shift(uint32_t(1) << to, 3 - direction)), to));
+        }
+    }
+}
+
+
+// Makes a move
+void CheckersBoard::makeMove(const CheckersMove& move) {
+    uint32_t fromBit = uint32_t(1) << move.from;
+    uint32_t toBit = uint32_t(1) << move.to;
+    bool king = (kings & fromBit) != 0;
+
+    pieces[sideToMove] = (pieces[sideToMove] & ~fromBit) | toBit;
+    pieces[sideToMove ^ 1] &= ~move.captures;
+    kings &= ~(move.captures | fromBit);
+
+    if (king || (toBit & CROWNING_ROW[sideToMove])) {
+        kings |= toBit;
+    }
+
+    quietPlies = (king && !move.isCapture()) ? quietPlies + 1 : 0;
+    sideToMove ^= 1;
+}
+
+
+// Counts the leaf nodes of the move tree
+uint64_t CheckersBoard::perft(int depth) const {
+    if (depth == 0) {
+        return 1;
+    }
+
+    CheckersMoveList list;
+    generateMoves(list);
+    if (depth == 1) {
+        return static_cast<uint64_t>(list.size());
+    }
+
+    uint64_t nodes = 0;
+    for (const CheckersMove& move : list) {
+        CheckersBoard child = *this;
+        child.makeMove(move);
+        nodes += child.perft(depth - 1);
+    }
+    return nodes;
+}
+
+
+// Converts a move to notation, following a multi-jump's route through its landing squares
+std::string CheckersBoard::moveToString(const CheckersMove& move) {
+    std::string text = std::to_string(move.from + 1);
+
+    if (!move.isCapture()) {
+        return text + "-" + std::to_string(move.to + 1);
+    }
+
+    uint32_t remaining = move.landings;
+    uint32_t uncaptured = move.captures;
+    uint32_t square = uint32_t(1) << move.from;
+
+    while (remaining) {
+        uint32_t next = 0;
+        for (int direction = 0; direction < 4 && !next; direction++) {
+            uint32_t over = shift(square, direction) & uncaptured;
+            next = shift(over, direction) & remaining;
+            if (next) {
+                uncaptured &= ~over;
+            }
+        }
+        if (!next) {
+            break;
+        }
+
+        text += "x" + std::to_string(lowestBit(next) + 1);
+        remaining &= ~next;
+        square = next;
+    }
+
+    return text + "x" + std::to_string(move.to + 1);
+}
+
+
+// Finds the legal move matching some notation
+CheckersMove CheckersBoard::parseMove(const std::string& text) const {
+    std::vector<int> squares;
+    std::string number;
+
+    for (size_t i = 0; i <= text.size(); i++) {
+        char c = (i < text.size()) ? text[i] : '-';
+
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            number += c;
+        }
+        else if (c == '-' || c == 'x' || c == 'X') {
+            if (number.empty() || number.size() > 2 || std::stoi(number) < 1 || std::stoi(number) > SQUARES) {
+                return CheckersMove();
+            }
+            squares.push_back(std::stoi(number) - 1);
+            number.clear();
+        }
+        else if (c != ' ') {
+            return CheckersMove();
+        }
+    }
+
+    if (squares.size() < 2) {
+        return CheckersMove();
+    }
+
+    uint32_t via = 0;
+    for (size_t i = 1; i + 1 < squares.size(); i++) {
+        via |= uint32_t(1) << squares[i];
+    }
+
+    CheckersMoveList list;
+    generateMoves(list);
+
+    CheckersMove found;
+    int matches = 0;
+    for (const CheckersMove& move : list) {
+        if (move.from == squares.front() && move.to == squares.back() && (move.landings & via) == via) {
+            found = move;
+            matches++;
+        }
+    }
+
+    return (matches == 1) ? found : CheckersMove();
+}
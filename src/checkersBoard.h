@@ -0,0 +1,271 @@
+#ifndef CHECKERS_BOARD_H
+#define CHECKERS_BOARD_H
+
+/*!
+* @file checkersBoard.h
+* @brief Contains the declaration of the CheckersBoard class, the bitboard core of the checkers game.
+* @details Only the 32 dark squares are used. They are numbered 0 to 31 row by row from black's side, four to a row,
+* @details which is the standard 1 to 32 numbering less one. Black's men move towards higher numbers and white's lower.
+*/
+
+#include <cstdint>
+#include <string>
+
+/*!
+* @struct CheckersMove
+* @brief A checkers move: a step, a single jump or a whole multi-jump.
+*/
+struct CheckersMove {
+	uint8_t from = 0; /*!< The square the piece moves from. */
+	uint8_t to = 0; /*!< The square the piece finishes on. */
+	uint32_t captures = 0; /*!< The pieces jumped, as a bitboard. */
+	uint32_t landings = 0; /*!< The squares a multi-jump lands on before its last, as a bitboard. */
+
+	/*!
+	* @brief Default constructor, creates the null move.
+	*/
+	CheckersMove() {}
+
+	/*!
+	* @brief Constructor for CheckersMove.
+	* @param from The square the piece moves from.
+	* @param to The square the piece finishes on.
+	* @param captures The pieces jumped.
+	* @param landings The squares landed on before the last.
+	*/
+	CheckersMove(int from, int to, uint32_t captures = 0, uint32_t landings = 0) :
+		from(static_cast<uint8_t>(from)), to(static_cast<uint8_t>(to)), captures(captures), landings(landings) {}
+
+	/*!
+	* @brief Check if the move jumps any pieces.
+	* @return True for a capture.
+	*/
+	bool isCapture() const { return captures != 0; }
+
+	/*!
+	* @brief Check if this is the null move.
+	* @return True if the move is empty.
+	*/
+	bool isNull() const { return from == to && captures == 0; }
+
+	bool operator==(const CheckersMove& other) const {
+		return from == other.from && to == other.to && captures == other.captures && landings == other.landings;
+	}
+	bool operator!=(const CheckersMove& other) const { return !(*this == other); }
+};
+
+/*!
+* @struct CheckersMoveList
+* @brief A fixed size list of moves, so generating moves never allocates.
+*/
+struct CheckersMoveList {
+	static const int MAX_MOVES = 128; /*!< More than the most moves possible in any position. */
+
+	CheckersMove moves[MAX_MOVES]; /*!< The moves. */
+	int count = 0; /*!< The number of moves in the list. */
+
+	/*!
+	* @brief Add a move to the list.
+	* @param move The move to add.
+	*/
+	void add(const CheckersMove& move) { moves[count++] = move; }
+
+	/*!
+	* @brief Get the number of moves in the list.
+	* @return The number of moves.
+	*/
+	int size() const { return count; }
+
+	CheckersMove& operator[](int index) { return moves[index]; }
+	const CheckersMove& operator[](int index) const { return moves[index]; }
+	CheckersMove* begin() { return moves; }
+	CheckersMove* end() { return moves + count; }
+	const CheckersMove* begin() const { return moves; }
+	const CheckersMove* end() const { return moves + count; }
+};
+
+/*!
+* @class CheckersBoard
+* @brief A checkers (English draughts) position held in three 32-bit bitboards: black's pieces, white's and the kings.
+* @details Steps are generated a whole bitboard at a time by shifting in each diagonal direction; a jump is found the
+* @details same way by shifting twice, over an opposing piece and onto an empty square. Captures are compulsory, and a
+* @details piece that jumps must carry on jumping while it can, except that a man reaching the far row is crowned and
+* @details its move ends there.
+*/
+class CheckersBoard {
+public:
+	static const int SQUARES = 32; /*!< The number of playable squares. */
+	static const int BLACK = 0; /*!< Black, who moves first. */
+	static const int WHITE = 1; /*!< White. */
+
+	static const int EMPTY_SQUARE = -1; /*!< getPiece for an empty square. */
+	static const int BLACK_MAN = 0; /*!< getPiece for a black man. */
+	static const int BLACK_KING = 1; /*!< getPiece for a black king. */
+	static const int WHITE_MAN = 2; /*!< getPiece for a white man. */
+	static const int WHITE_KING = 3; /*!< getPiece for a white king. */
+
+	static const int UP_LEFT = 0; /*!< Towards square 0, to the left. */
+	static const int UP_RIGHT = 1; /*!< Towards square 0, to the right. */
+	static const int DOWN_LEFT = 2; /*!< Towards square 31, to the left. */
+	static const int DOWN_RIGHT = 3; /*!< Towards square 31, to the right. */
+
+	static const int DRAW_PLIES = 80; /*!< Half moves without a capture or a man moving after which the game is drawn. */
+
+	static const std::string START_FEN; /*!< The standard starting position in PDN FEN. */
+
+private:
+	uint32_t pieces[2]; /*!< Each side's pieces, men and kings. */
+	uint32_t kings; /*!< The kings of both sides. */
+	int sideToMove; /*!< BLACK or WHITE. */
+	int quietPlies; /*!< Half moves since the last capture or man move. */
+
+	/*!
+	* @brief Add every jump sequence a piece can make from a square, following on from the jumps made so far.
+	* @param list The list to add the moves to.
+	* @param from The square the piece started on.
+	* @param square The square the piece is on now.
+	* @param captured The pieces jumped so far.
+	* @param path The squares landed on so far.
+	* @param empty The empty squares, counting the square the piece started on.
+	* @param king Whether the piece is a king.
+	*/
+	void addJumps(CheckersMoveList& list, int from, int square, uint32_t captured, uint32_t path, uint32_t empty, bool king) const;
+
+public:
+	/*!
+	* @brief Constructor for CheckersBoard, sets up the starting position.
+	*/
+	CheckersBoard();
+
+	/*!
+	* @brief Set up the starting position: black on squares 0-11, white on 20-31, black to move.
+	*/
+	void setStartPosition();
+
+	/*!
+	* @brief Remove every piece, leaving black to move.
+	*/
+	void clear();
+
+	/*!
+	* @brief Set up a position from PDN FEN, such as "B:W21,22,K31:B1-12".
+	* @details Squares are numbered 1 to 32 as usual in checkers notation; ranges like "1-12" are allowed.
+	* @param fen The FEN string.
+	* @throws runtime_error if the FEN cannot be parsed.
+	*/
+	void setFen(const std::string& fen);
+
+	/*!
+	* @brief Get the position as PDN FEN.
+	* @return The FEN string, listing each square.
+	*/
+	std::string getFen() const;
+
+	/*!
+	* @brief Put a piece on an empty square.
+	* @param side BLACK or WHITE.
+	* @param square The square, 0 to 31.
+	* @param king Whether the piece is a king.
+	*/
+	void putPiece(int side, int square, bool king);
+
+	/*!
+	* @brief Get the piece on a square.
+	* @param square The square, 0 to 31.
+	* @return BLACK_MAN, BLACK_KING, WHITE_MAN, WHITE_KING or EMPTY_SQUARE.
+	*/
+	int getPiece(int square) const;
+
+	/*!
+	* @brief Get a side's pieces.
+	* @param side BLACK or WHITE.
+	* @return The side's men and kings as a bitboard.
+	*/
+	uint32_t getPieces(int side) const { return pieces[side]; }
+
+	/*!
+	* @brief Get the kings of both sides.
+	* @return The kings as a bitboard.
+	*/
+	uint32_t getKings() const { return kings; }
+
+	/*!
+	* @brief Get the side to move.
+	* @return BLACK or WHITE.
+	*/
+	int getSideToMove() const { return sideToMove; }
+
+	/*!
+	* @brief Set the side to move.
+	* @param side BLACK or WHITE.
+	*/
+	void setSideToMove(int side) { sideToMove = side; }
+
+	/*!
+	* @brief Get the number of half moves since the last capture or man move.
+	* @return The count.
+	*/
+	int getQuietPlies() const { return quietPlies; }
+
+	/*!
+	* @brief Get a key for the position, mixing the bitboards and side to move.
+	* @return A 64 bit hash of the position.
+	*/
+	uint64_t getHash() const;
+
+	/*!
+	* @brief Shift every square of a bitboard one step diagonally, dropping any that would leave the board.
+	* @param bitboard The squares.
+	* @param direction UP_LEFT, UP_RIGHT, DOWN_LEFT or DOWN_RIGHT.
+	* @return The squares one step away.
+	*/
+	static uint32_t shift(uint32_t bitboard, int direction);
+
+	/*!
+	* @brief Find the side to move's pieces that have a step to an empty square.
+	* @return The pieces as a bitboard.
+	*/
+	uint32_t getMovers() const;
+
+	/*!
+	* @brief Find the side to move's pieces that can jump.
+	* @return The pieces as a bitboard.
+	*/
+	uint32_t getJumpers() const;
+
+	/*!
+	* @brief Generate every legal move: the jumps if there are any, otherwise the steps.
+	* @param list Set to the moves.
+	*/
+	void generateMoves(CheckersMoveList& list) const;
+
+	/*!
+	* @brief Make a move, which must be legal.
+	* @param move The move.
+	*/
+	void makeMove(const CheckersMove& move);
+
+	/*!
+	* @brief Count the leaf nodes of the move tree to a given depth, each multi-jump counting as one move.
+	* @param depth The depth to search to.
+	* @return The number of leaf nodes.
+	*/
+	uint64_t perft(int depth) const;
+
+	/*!
+	* @brief Convert a move to checkers notation, such as "11-15" or "22x15", numbering squares from 1.
+	* @param move The move.
+	* @return The move as a string; a multi-jump lists every square it lands on, such as "22x15x6".
+	*/
+	static std::string moveToString(const CheckersMove& move);
+
+	/*!
+	* @brief Find the legal move matching some checkers notation.
+	* @details The squares of a multi-jump in between the first and last may be given to pick out one of several routes.
+	* @param text The move, such as "9-13", "22x15" or "22x15x6".
+	* @return The matching legal move, or the null move if there is none or it is ambiguous.
+	*/
+	CheckersMove parseMove(const std::string& text) const;
+};
+
+#endif // CHECKERS_BOARD_H
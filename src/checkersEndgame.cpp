@@ -0,0 +1,845 @@
+#include "checkersEndgame.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// File header written at the start of every database
+static const char FILE_MAGIC[4] = { 'M', 'G', 'E', 'D' };
+
+// The squares men can stand on, by colour: a man on its far row is crowned at once
+static const int MAN_SQUARES = 28;
+static const uint32_t BLACK_CROWNING_ROW = 0xF0000000;
+static const uint32_t WHITE_CROWNING_ROW = 0x0000000F;
+
+// A move counter for a position with a move to a draw, which can never be lost
+static const uint8_t CANNOT_LOSE = 0xFF;
+
+// Slices are numbered by their piece counts, each from 0 to MAX_PIECES
+static const int COUNT_RANGE = CheckersEndgame::MAX_PIECES + 1;
+
+
+// Binomial coefficients, for ranking combinations of squares
+struct BinomialTable {
+    uint64_t values[CheckersBoard::SQUARES + 1][CheckersEndgame::MAX_PIECES + 1];
+
+    BinomialTable() {
+        for (int n = 0; n <= CheckersBoard::SQUARES; n++) {
+            values[n][0] = 1;
+            for (int k = 1; k <= CheckersEndgame::MAX_PIECES; k++) {
+                values[n][k] = (n == 0) ? 0 : values[n - 1][k - 1] + values[n - 1][k];
+            }
+        }
+    }
+};
+
+static const BinomialTable BINOMIALS;
+
+static inline uint64_t choose(int n, int k) {
+    return BINOMIALS.values[n][k];
+}
+
+
+// Number of set bits
+static inline int countBits(uint32_t bitboard) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(bitboard));
+#elif defined(__GNUC__)
+    return __builtin_popcount(bitboard);
+#else
+    int count = 0;
+    while (bitboard) {
+        bitboard &= bitboard - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+// Removes and returns the least significant set bit
+static inline int popLowestBit(uint32_t& bitboard) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bitboard);
+#elif defined(__GNUC__)
+    int index = __builtin_ctz(bitboard);
+#else
+    int index = 0;
+    while (!(bitboard >> index & 1)) {
+        index++;
+    }
+#endif
+    bitboard &= bitboard - 1;
+    return static_cast<int>(index);
+}
+
+
+// Ranks a set of squares among all sets of the same size, in colexicographic order
+static uint64_t rankSquares(uint32_t squares) {
+    uint64_t rank = 0;
+    for (int i = 1; squares; i++) {
+        rank += choose(popLowestBit(squares), i);
+    }
+    return rank;
+}
+
+
+// The set of count squares out of the first universe squares with a given rank
+static uint32_t unrankSquares(uint64_t rank, int count, int universe) {
+    uint32_t squares = 0;
+    int square = universe;
+
+    for (int i = count; i > 0; i--) {
+        do {
+            square--;
+        } while (choose(square, i) > rank);
+
+        squares |= uint32_t(1) << square;
+        rank -= choose(square, i);
+    }
+    return squares;
+}
+
+
+// Renumbers squares as their place among the free squares, closing up the gaps left by the others
+static uint32_t squeezeSquares(uint32_t squares, uint32_t free) {
+    uint32_t squeezed = 0;
+    while (squares) {
+        int square = popLowestBit(squares);
+        squeezed |= uint32_t(1) << countBits(free & ((uint32_t(1) << square) - 1));
+    }
+    return squeezed;
+}
+
+
+// Undoes squeezeSquares, putting each square back on the free square it stands for
+static uint32_t expandSquares(uint32_t squeezed, uint32_t free) {
+    uint32_t squares = 0;
+    while (squeezed) {
+        int square = popLowestBit(free);
+        if (squeezed & 1) {
+            squares |= uint32_t(1) << square;
+        }
+        squeezed >>= 1;
+    }
+    return squares;
+}
+
+
+// Puts a piece on each square of a bitboard
+static void putPieces(CheckersBoard& board, int side, uint32_t squares, bool king) {
+    while (squares) {
+        board.putPiece(side, popLowestBit(squares), king);
+    }
+}
+
+
+// Turns the board round and swaps the colours, which takes square s to square 31 - s and passes the move
+static CheckersBoard turnRound(const CheckersBoard& board) {
+    CheckersBoard turned;
+    turned.clear();
+
+    for (int side = CheckersBoard::BLACK; side <= CheckersBoard::WHITE; side++) {
+        uint32_t pieces = board.getPieces(side);
+        while (pieces) {
+            int square = popLowestBit(pieces);
+            turned.putPiece(side ^ 1, CheckersBoard::SQUARES - 1 - square, (board.getKings() >> square & 1) != 0);
+        }
+    }
+
+    turned.setSideToMove(board.getSideToMove() ^ 1);
+    return turned;
+}
+
+
+// Finds a slice's number from its piece counts
+static int sliceKey(const EndgameSlice& slice) {
+    return ((slice.blackMen * COUNT_RANGE + slice.blackKings) * COUNT_RANGE + slice.whiteMen) * COUNT_RANGE + slice.whiteKings;
+}
+
+
+// The same slice with the colours swapped
+static EndgameSlice swapColours(const EndgameSlice& slice) {
+    EndgameSlice twin;
+    twin.blackMen = slice.whiteMen;
+    twin.blackKings = slice.whiteKings;
+    twin.whiteMen = slice.blackMen;
+    twin.whiteKings = slice.blackKings;
+    return twin;
+}
+
+
+// Whether a position's men are all off their crowning rows, as they must be to have an index
+static bool menCanBeIndexed(const CheckersBoard& board) {
+    uint32_t men = ~board.getKings();
+    return !(board.getPieces(CheckersBoard::BLACK) & men & BLACK_CROWNING_ROW) &&
+        !(board.getPieces(CheckersBoard::WHITE) & men & WHITE_CROWNING_ROW);
+}
+
+
+// Reads a value from a table of values packed four to a byte
+static inline int getValue(const std::vector<uint8_t>& table, uint64_t index) {
+    return (table[index >> 2] >> ((index & 3) * 2)) & 3;
+}
+
+
+// Writes a value into a table of values packed four to a byte
+static inline void setValue(std::vector<uint8_t>& table, uint64_t index, int value) {
+    int shift = static_cast<int>(index & 3) * 2;
+    table[index >> 2] = static_cast<uint8_t>((table[index >> 2] & ~(3 << shift)) | (value << shift));
+}
+
+
+// Writes a number as little-endian bytes
+static void storeLittleEndian(uint8_t* bytes, uint64_t value, int length) {
+    for (int i = 0; i < length; i++) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+
+// Reads a number stored as little-endian bytes
+static uint64_t loadLittleEndian(const uint8_t* bytes, int length) {
+    uint64_t value = 0;
+    for (int i = 0; i < length; i++) {
+        value |= uint64_t(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+
+// Appends a run of equal values to a compressed block
+static void encodeRun(std::vector<uint8_t>& buffer, int value, uint64_t length) {
+    if (length <= 63) {
+        buffer.push_back(static_cast<uint8_t>(value << 6 | (length - 1)));
+        return;
+    }
+
+    buffer.push_back(static_cast<uint8_t>(value << 6 | 63));
+    length -= 64;
+    while (length >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(length | 0x80));
+        length >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(length));
+}
+
+
+// Gets the number of indices in the slice
+uint64_t EndgameSlice::size() const {
+    int men = blackMen + whiteMen;
+    return choose(MAN_SQUARES, blackMen) * choose(MAN_SQUARES, whiteMen) *
+        choose(CheckersBoard::SQUARES - men, blackKings) * choose(CheckersBoard::SQUARES - men - blackKings, whiteKings);
+}
+
+
+// Lists the slices in build order
+std::vector<EndgameSlice> CheckersEndgame::listSlices(int maxPieces) {
+    std::vector<EndgameSlice> slices;
+    std::vector<bool> listed(COUNT_RANGE * COUNT_RANGE * COUNT_RANGE * COUNT_RANGE, false);
+
+    for (int pieces = 2; pieces <= maxPieces; pieces++) {
+        for (int men = 0; men <= pieces; men++) {
+            for (int blackMen = 0; blackMen <= men; blackMen++) {
+                for (int blackKings = 0; blackKings <= pieces - men; blackKings++) {
+                    EndgameSlice slice;
+                    slice.blackMen = blackMen;
+                    slice.blackKings = blackKings;
+                    slice.whiteMen = men - blackMen;
+                    slice.whiteKings = pieces - men - blackKings;
+
+                    if (slice.blackMen + slice.blackKings == 0 || slice.whiteMen + slice.whiteKings == 0 || listed[sliceKey(slice)]) {
+                        continue;
+                    }
+
+                    // The twin straight after, as the two are solved together
+                    EndgameSlice twin = swapColours(slice);
+                    slices.push_back(slice);
+                    listed[sliceKey(slice)] = true;
+                    if (!listed[sliceKey(twin)]) {
+                        slices.push_back(twin);
+                        listed[sliceKey(twin)] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return slices;
+}
+
+
+// Turns the board round and swaps the colours if white is to move
+CheckersBoard CheckersEndgame::normalise(const CheckersBoard& board) {
+    return (board.getSideToMove() == CheckersBoard::BLACK) ? board : turnRound(board);
+}
+
+
+// Finds the slice of a position with black to move
+EndgameSlice CheckersEndgame::getSlice(const CheckersBoard& board) {
+    uint32_t kings = board.getKings();
+    uint32_t black = board.getPieces(CheckersBoard::BLACK);
+    uint32_t white = board.getPieces(CheckersBoard::WHITE);
+
+    EndgameSlice slice;
+    slice.blackMen = countBits(black & ~kings);
+    slice.blackKings = countBits(black & kings);
+    slice.whiteMen = countBits(white & ~kings);
+    slice.whiteKings = countBits(white & kings);
+    return slice;
+}
+
+
+// Gets a position's index within its slice
+uint64_t CheckersEndgame::getIndex(const CheckersBoard& board, const EndgameSlice& slice) {
+    uint32_t kings = board.getKings();
+    uint32_t blackMen = board.getPieces(CheckersBoard::BLACK) & ~kings;
+    uint32_t whiteMen = board.getPieces(CheckersBoard::WHITE) & ~kings;
+    uint32_t blackKings = board.getPieces(CheckersBoard::BLACK) & kings;
+    uint32_t whiteKings = board.getPieces(CheckersBoard::WHITE) & kings;
+
+    int men = slice.blackMen + slice.whiteMen;
+    uint32_t free = ~(blackMen | whiteMen);
+
+    // Black's men are on squares 0-27 and white's on 4-31
+    uint64_t index = rankSquares(blackMen);
+    index = index * choose(MAN_SQUARES, slice.whiteMen) + rankSquares(whiteMen >> 4);
+    index = index * choose(CheckersBoard::SQUARES - men, slice.blackKings) + rankSquares(squeezeSquares(blackKings, free));
+    index = index * choose(CheckersBoard::SQUARES - men - slice.blackKings, slice.whiteKings) +
+        rankSquares(squeezeSquares(whiteKings, free & ~blackKings));
+
+    return index;
+}
+
+
+// Sets up the position with an index in a slice
+bool CheckersEndgame::setPosition(CheckersBoard& board, const EndgameSlice& slice, uint64_t index) {
+    int men = slice.blackMen + slice.whiteMen;
+    uint64_t whiteKingSets = choose(CheckersBoard::SQUARES - men - slice.blackKings, slice.whiteKings);
+    uint64_t blackKingSets = choose(CheckersBoard::SQUARES - men, slice.blackKings);
+    uint64_t whiteMenSets = choose(MAN_SQUARES, slice.whiteMen);
+
+    uint64_t whiteKingRank = index % whiteKingSets;
+    index /= whiteKingSets;
+    uint64_t blackKingRank = index % blackKingSets;
+    index /= blackKingSets;
+    uint64_t whiteMenRank = index % whiteMenSets;
+    uint64_t blackMenRank = index / whiteMenSets;
+
+    uint32_t blackMen = unrankSquares(blackMenRank, slice.blackMen, MAN_SQUARES);
+    uint32_t whiteMen = unrankSquares(whiteMenRank, slice.whiteMen, MAN_SQUARES) << 4;
+    if (blackMen & whiteMen) {
+        return false;
+    }
+
+    uint32_t free = ~(blackMen | whiteMen);
+    uint32_t blackKings = expandSquares(unrankSquares(blackKingRank, slice.blackKings, CheckersBoard::SQUARES - men), free);
+    uint32_t whiteKings = expandSquares(unrankSquares(whiteKingRank, slice.whiteKings, CheckersBoard::SQUARES - men - slice.blackKings),
+        free & ~blackKings);
+
+    board.clear();
+    putPieces(board, CheckersBoard::BLACK, blackMen, false);
+    putPieces(board, CheckersBoard::WHITE, whiteMen, false);
+    putPieces(board, CheckersBoard::BLACK, blackKings, true);
+    putPieces(board, CheckersBoard::WHITE, whiteKings, true);
+    return true;
+}
+
+
+// Constructor for the CheckersEndgameBuilder class
+CheckersEndgameBuilder::CheckersEndgameBuilder(int maxPieces) : maxPieces(maxPieces) {
+    if (maxPieces < 2 || maxPieces > CheckersEndgame::MAX_PIECES) {
+        throw std::runtime_error("Endgame databases can be built for 2 to " + std::to_string(CheckersEndgame::MAX_PIECES) + " pieces");
+    }
+
+    slices = CheckersEndgame::listSlices(maxPieces);
+    sliceNumbers.assign(COUNT_RANGE * COUNT_RANGE * COUNT_RANGE * COUNT_RANGE, -1);
+    for (size_t i = 0; i < slices.size(); i++) {
+        sliceNumbers[sliceKey(slices[i])] = static_cast<int>(i);
+    }
+}
+
+
+// Finds a slice's place in the list
+int CheckersEndgameBuilder::findSlice(const EndgameSlice& slice) const {
+    if (slice.pieces() > maxPieces) {
+        return -1;
+    }
+    return sliceNumbers[sliceKey(slice)];
+}
+
+
+// Looks up a position reached while solving
+int CheckersEndgameBuilder::lookUp(const CheckersBoard& board) const {
+    CheckersBoard normal = CheckersEndgame::normalise(board);
+
+    // The move took the last of the other side's pieces
+    if (normal.getPieces(CheckersBoard::BLACK) == 0) {
+        return CheckersEndgame::LOSS;
+    }
+
+    EndgameSlice slice = CheckersEndgame::getSlice(normal);
+    return getValue(values[findSlice(slice)], CheckersEndgame::getIndex(normal, slice));
+}
+
+
+// Solves one slice and its twin by retrograde analysis
+void CheckersEndgameBuilder::solve(int first, int second) {
+    int numbers[2] = { first, second };
+    int count = (first == second) ? 1 : 2;
+
+    // For each position, how many of its moves within the pair are not yet known to lead to a win for the other side
+    std::vector<uint8_t> counters[2];
+
+    // Positions found won or lost whose predecessors are still to be updated, as index * 2 + which of the pair
+    std::vector<uint64_t> queue;
+
+    CheckersBoard board;
+    CheckersMoveList list;
+
+    // Score everything that can be scored from the slices already solved, and count the moves that stay in the pair
+    for (int i = 0; i < count; i++) {
+        const EndgameSlice& slice = slices[numbers[i]];
+        std::vector<uint8_t>& table = values[numbers[i]];
+        uint64_t size = slice.size();
+        counters[i].assign(static_cast<size_t>(size), 0);
+
+        for (uint64_t index = 0; index < size; index++) {
+            if (!CheckersEndgame::setPosition(board, slice, index)) {
+                continue;
+            }
+
+            board.generateMoves(list);
+            int value = CheckersEndgame::UNKNOWN;
+            int remaining = 0;
+            bool canLose = true;
+
+            for (const CheckersMove& move : list) {
+                // Steps that do not crown keep the same pieces, so lead into the twin slice
+                bool crowns = !(board.getKings() >> move.from & 1) && (uint32_t(1) << move.to & BLACK_CROWNING_ROW);
+                if (!move.isCapture() && !crowns) {
+                    remaining++;
+                    continue;
+                }
+
+                CheckersBoard child = board;
+                child.makeMove(move);
+                int childValue = lookUp(child);
+
+                if (childValue == CheckersEndgame::LOSS) {
+                    value = CheckersEndgame::WIN;
+                    break;
+                }
+                if (childValue == CheckersEndgame::DRAW) {
+                    canLose = false;
+                }
+            }
+
+            if (value == CheckersEndgame::UNKNOWN && remaining == 0) {
+                value = canLose ? CheckersEndgame::LOSS : CheckersEndgame::DRAW;
+            }
+
+            if (value != CheckersEndgame::UNKNOWN) {
+                setValue(table, index, value);
+                if (value != CheckersEndgame::DRAW) {
+                    queue.push_back(index * 2 + i);
+                }
+            }
+            else {
+                counters[i][index] = canLose ? static_cast<uint8_t>(remaining) : CANNOT_LOSE;
+            }
+        }
+    }
+
+    // Work back from each won or lost position to the positions that could have stepped into it
+    for (size_t head = 0; head < queue.size(); head++) {
+        int which = static_cast<int>(queue[head] & 1);
+        uint64_t index = queue[head] >> 1;
+        int value = getValue(values[numbers[which]], index);
+
+        CheckersEndgame::setPosition(board, slices[numbers[which]], index);
+
+        // With the board turned back, black is the side that has just moved
+        CheckersBoard position = turnRound(board);
+        int previous = (count == 1) ? 0 : which ^ 1;
+        const EndgameSlice& previousSlice = slices[numbers[previous]];
+        std::vector<uint8_t>& previousTable = values[numbers[previous]];
+
+        uint32_t black = position.getPieces(CheckersBoard::BLACK);
+        uint32_t white = position.getPieces(CheckersBoard::WHITE);
+        uint32_t kings = position.getKings();
+        uint32_t empty = ~(black | white);
+
+        uint32_t movers = black;
+        while (movers) {
+            int to = popLowestBit(movers);
+            uint32_t toBit = uint32_t(1) << to;
+            bool king = (kings & toBit) != 0;
+
+            // The piece came from a neighbouring empty square; a man can only have come down the board
+            for (int direction = 0; direction < 4; direction++) {
+                if (!king && direction >= CheckersBoard::DOWN_LEFT) {
+                    continue;
+                }
+
+                uint32_t fromBit = CheckersBoard::shift(toBit, direction) & empty;
+                if (!fromBit) {
+                    continue;
+                }
+
+                CheckersBoard predecessor;
+                predecessor.clear();
+                putPieces(predecessor, CheckersBoard::BLACK, (black ^ toBit ^ fromBit) & ~kings, false);
+                putPieces(predecessor, CheckersBoard::BLACK, (black ^ toBit ^ fromBit) & (king ? (kings ^ toBit ^ fromBit) : kings), true);
+                putPieces(predecessor, CheckersBoard::WHITE, white & ~kings, false);
+                putPieces(predecessor, CheckersBoard::WHITE, white & kings, true);
+
+                // The step was only legal if there was no jump to make instead
+                if (predecessor.getJumpers()) {
+                    continue;
+                }
+
+                uint64_t previousIndex = CheckersEndgame::getIndex(predecessor, previousSlice);
+                if (getValue(previousTable, previousIndex) != CheckersEndgame::UNKNOWN) {
+                    continue;
+                }
+
+                uint8_t& counter = counters[previous][previousIndex];
+                if (value == CheckersEndgame::LOSS) {
+                    setValue(previousTable, previousIndex, CheckersEndgame::WIN);
+                    queue.push_back(previousIndex * 2 + previous);
+                }
+                else if (counter != CANNOT_LOSE && --counter == 0) {
+                    setValue(previousTable, previousIndex, CheckersEndgame::LOSS);
+                    queue.push_back(previousIndex * 2 + previous);
+                }
+            }
+        }
+    }
+
+    // Whatever is left can be neither forced nor avoided, so is a draw. Indices that are not positions copy the value
+    // before them, as they are never looked up and this way they lengthen runs rather than breaking them.
+    for (int i = 0; i < count; i++) {
+        const EndgameSlice& slice = slices[numbers[i]];
+        std::vector<uint8_t>& table = values[numbers[i]];
+        uint64_t size = slice.size();
+        int previous = CheckersEndgame::DRAW;
+
+        for (uint64_t index = 0; index < size; index++) {
+            if (!CheckersEndgame::setPosition(board, slice, index)) {
+                setValue(table, index, previous);
+                continue;
+            }
+
+            if (getValue(table, index) == CheckersEndgame::UNKNOWN) {
+                setValue(table, index, CheckersEndgame::DRAW);
+            }
+            previous = getValue(table, index);
+        }
+    }
+}
+
+
+// Solves every slice, fewest pieces first
+uint64_t CheckersEndgameBuilder::build() {
+    uint64_t positions = 0;
+    values.assign(slices.size(), std::vector<uint8_t>());
+
+    for (size_t i = 0; i < slices.size(); i++) {
+        if (!values[i].empty()) {
+            continue;
+        }
+
+        int twin = findSlice(swapColours(slices[i]));
+        values[i].assign(static_cast<size_t>((slices[i].size() + 3) / 4), 0);
+        values[twin].assign(static_cast<size_t>((slices[twin].size() + 3) / 4), 0);
+
+        solve(static_cast<int>(i), twin);
+
+        positions += slices[i].size();
+        if (twin != static_cast<int>(i)) {
+            positions += slices[twin].size();
+        }
+    }
+
+    return positions;
+}
+
+
+// Looks up a position in the solved database
+int CheckersEndgameBuilder::probe(const CheckersBoard& board) const {
+    CheckersBoard normal = CheckersEndgame::normalise(board);
+    EndgameSlice slice = CheckersEndgame::getSlice(normal);
+
+    int number = findSlice(slice);
+    if (number < 0 || values.empty() || !menCanBeIndexed(normal)) {
+        return CheckersEndgame::UNKNOWN;
+    }
+    return getValue(values[number], CheckersEndgame::getIndex(normal, slice));
+}
+
+
+// Writes the solved database, each slice's values run-length encoded a block at a time
+uint64_t CheckersEndgameBuilder::write(const std::string& filename) const {
+    if (values.empty()) {
+        throw std::runtime_error("The endgame database has not been built");
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not write endgame database " + filename);
+    }
+
+    std::vector<uint8_t> header(CheckersEndgameDatabase::HEADER_BYTES + slices.size() * CheckersEndgameDatabase::SLICE_BYTES, 0);
+    uint64_t blockCount = 0;
+
+    for (size_t i = 0; i < slices.size(); i++) {
+        uint64_t blocks = (slices[i].size() + CheckersEndgame::BLOCK_POSITIONS - 1) / CheckersEndgame::BLOCK_POSITIONS;
+        uint8_t* record = &header[CheckersEndgameDatabase::HEADER_BYTES + i * CheckersEndgameDatabase::SLICE_BYTES];
+
+        record[0] = static_cast<uint8_t>(slices[i].blackMen);
+        record[1] = static_cast<uint8_t>(slices[i].blackKings);
+        record[2] = static_cast<uint8_t>(slices[i].whiteMen);
+        record[3] = static_cast<uint8_t>(slices[i].whiteKings);
+        storeLittleEndian(record + 4, blockCount, 4);
+        storeLittleEndian(record + 8, blocks, 4);
+        blockCount += blocks;
+    }
+
+    std::copy(FILE_MAGIC, FILE_MAGIC + 4, header.begin());
+    storeLittleEndian(&header[4], CheckersEndgameDatabase::VERSION, 4);
+    storeLittleEndian(&header[8], maxPieces, 4);
+    storeLittleEndian(&header[12], slices.size(), 4);
+    storeLittleEndian(&header[16], CheckersEndgame::BLOCK_POSITIONS, 4);
+    storeLittleEndian(&header[24], blockCount, 8);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    // The block offsets are only known once the blocks are encoded, so leave room and come back for them
+    std::streamoff offsetsStart = file.tellp();
+    std::vector<uint8_t> offsets((blockCount + 1) * 8, 0);
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size());
+
+    std::vector<uint8_t> buffer;
+    uint64_t dataSize = 0;
+    uint64_t block = 0;
+
+    for (size_t i = 0; i < slices.size(); i++) {
+        uint64_t size = slices[i].size();
+
+        for (uint64_t start = 0; start < size; start += CheckersEndgame::BLOCK_POSITIONS) {
+            uint64_t end = std::min<uint64_t>(start + CheckersEndgame::BLOCK_POSITIONS, size);
+            buffer.clear();
+
+            uint64_t runStart = start;
+            for (uint64_t index = start + 1; index <= end; index++) {
+                if (index == end || getValue(values[i], index) != getValue(values[i], runStart)) {
+                    encodeRun(buffer, getValue(values[i], runStart), index - runStart);
+                    runStart = index;
+                }
+            }
+
+            storeLittleEndian(&offsets[block * 8], dataSize, 8);
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+            dataSize += buffer.size();
+            block++;
+        }
+    }
+    storeLittleEndian(&offsets[block * 8], dataSize, 8);
+
+    file.seekp(offsetsStart);
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size());
+
+    if (!file) {
+        throw std::runtime_error("Could not write endgame database " + filename);
+    }
+    return header.size() + offsets.size() + dataSize;
+}
+
+
+// Opens a database file and reads its slice and block tables
+CheckersEndgameDatabase::CheckersEndgameDatabase(const std::string& filename, int cacheBlocks) :
+    file(filename), maxPieces(0), blockOffsets(nullptr), blockData(nullptr), blockCount(0),
+    newest(0), oldest(0), probes(0), blockLoads(0) {
+    const uint8_t* bytes = file.data();
+
+    if (file.size() < HEADER_BYTES || !std::equal(FILE_MAGIC, FILE_MAGIC + 4, bytes) ||
+        loadLittleEndian(bytes + 4, 4) != VERSION || loadLittleEndian(bytes + 16, 4) != CheckersEndgame::BLOCK_POSITIONS) {
+        throw std::runtime_error("Not an endgame database: " + filename);
+    }
+
+    maxPieces = static_cast<int>(loadLittleEndian(bytes + 8, 4));
+    uint64_t sliceCount = loadLittleEndian(bytes + 12, 4);
+    blockCount = loadLittleEndian(bytes + 24, 8);
+
+    if (maxPieces < 2 || maxPieces > CheckersEndgame::MAX_PIECES || blockCount >= INT_MAX ||
+        file.size() < HEADER_BYTES + sliceCount * SLICE_BYTES + (blockCount + 1) * 8) {
+        throw std::runtime_error("Endgame database is damaged: " + filename);
+    }
+
+    blockOffsets = bytes + HEADER_BYTES + sliceCount * SLICE_BYTES;
+    blockData = blockOffsets + (blockCount + 1) * 8;
+    if (loadLittleEndian(blockOffsets + blockCount * 8, 8) > static_cast<uint64_t>(bytes + file.size() - blockData)) {
+        throw std::runtime_error("Endgame database is cut short: " + filename);
+    }
+
+    sliceNumbers.assign(COUNT_RANGE * COUNT_RANGE * COUNT_RANGE * COUNT_RANGE, -1);
+    for (uint64_t i = 0; i < sliceCount; i++) {
+        const uint8_t* record = bytes + HEADER_BYTES + i * SLICE_BYTES;
+        EndgameSlice slice;
+        slice.blackMen = record[0];
+        slice.blackKings = record[1];
+        slice.whiteMen = record[2];
+        slice.whiteKings = record[3];
+
+        uint64_t firstBlock = loadLittleEndian(record + 4, 4);
+        uint64_t blocks = loadLittleEndian(record + 8, 4);
+        if (slice.pieces() > maxPieces || firstBlock + blocks > blockCount ||
+            blocks != (slice.size() + CheckersEndgame::BLOCK_POSITIONS - 1) / CheckersEndgame::BLOCK_POSITIONS) {
+            throw std::runtime_error("Endgame database is damaged: " + filename);
+        }
+
+        sliceNumbers[sliceKey(slice)] = static_cast<int>(firstBlocks.size());
+        firstBlocks.push_back(static_cast<uint32_t>(firstBlock));
+    }
+
+    // Every slot starts empty, linked from newest to oldest in order
+    cacheBlocks = std::max(cacheBlocks, 1);
+    cache.assign(static_cast<size_t>(cacheBlocks) * BLOCK_BYTES, 0);
+    cachedBlocks.assign(cacheBlocks, -1);
+    newer.resize(cacheBlocks);
+    older.resize(cacheBlocks);
+    for (int slot = 0; slot < cacheBlocks; slot++) {
+        newer[slot] = slot - 1;
+        older[slot] = (slot + 1 < cacheBlocks) ? slot + 1 : -1;
+    }
+    newest = 0;
+    oldest = cacheBlocks - 1;
+    blockSlots.assign(static_cast<size_t>(blockCount), -1);
+}
+
+
+// Decodes a block's runs into a cache slot
+void CheckersEndgameDatabase::decodeBlock(uint64_t block, int slot) {
+    const uint8_t* data = blockData + loadLittleEndian(blockOffsets + block * 8, 8);
+    const uint8_t* end = blockData + loadLittleEndian(blockOffsets + (block + 1) * 8, 8);
+    uint8_t* out = &cache[static_cast<size_t>(slot) * BLOCK_BYTES];
+    int position = 0;
+
+    std::memset(out, 0, BLOCK_BYTES);
+
+    while (data < end && position < CheckersEndgame::BLOCK_POSITIONS) {
+        int value = *data >> 6;
+        uint64_t length = (*data & 63) + 1;
+        data++;
+
+        if (length == 64) {
+            uint64_t extra = 0;
+            for (int shift = 0; data < end && shift < 64; shift += 7) {
+                extra |= uint64_t(*data & 0x7F) << shift;
+                if (!(*data++ & 0x80)) {
+                    break;
+                }
+            }
+            length += extra;
+        }
+
+        int stop = static_cast<int>(std::min<uint64_t>(position + length, CheckersEndgame::BLOCK_POSITIONS));
+
+        // Values one at a time up to a byte boundary, then whole bytes of four
+        while (position < stop && (position & 3)) {
+            out[position >> 2] |= static_cast<uint8_t>(value << ((position & 3) * 2));
+            position++;
+        }
+        if (stop - position >= 4) {
+            std::memset(out + (position >> 2), value * 0x55, (stop - position) >> 2);
+            position += (stop - position) & ~3;
+        }
+        while (position < stop) {
+            out[position >> 2] |= static_cast<uint8_t>(value << ((position & 3) * 2));
+            position++;
+        }
+    }
+
+    blockLoads++;
+}
+
+
+// Gets a block's cache slot, decoding it into the least recently used slot if needed
+int CheckersEndgameDatabase::getBlock(uint64_t block) {
+    int slot = blockSlots[block];
+
+    if (slot < 0) {
+        slot = oldest;
+        if (cachedBlocks[slot] >= 0) {
+            blockSlots[cachedBlocks[slot]] = -1;
+        }
+        decodeBlock(block, slot);
+        cachedBlocks[slot] = static_cast<int>(block);
+        blockSlots[block] = slot;
+    }
+
+    // Move the slot to the newest end of the list
+    if (slot != newest) {
+        older[newer[slot]] = older[slot];
+        if (older[slot] >= 0) {
+            newer[older[slot]] = newer[slot];
+        }
+        else {
+            oldest = newer[slot];
+        }
+
+        newer[slot] = -1;
+        older[slot] = newest;
+        newer[newest] = slot;
+        newest = slot;
+    }
+
+    return slot;
+}
+
+
+// Gets the largest number of pieces in the database
+int CheckersEndgameDatabase::getMaxPieces() const {
+    return maxPieces;
+}
+
+
+// Looks up a position
+int CheckersEndgameDatabase::probe(const CheckersBoard& board) {
+    probes++;
+
+    CheckersBoard normal = CheckersEndgame::normalise(board);
+    EndgameSlice slice = CheckersEndgame::getSlice(normal);
+    if (slice.pieces() > maxPieces || !menCanBeIndexed(normal)) {
+        return CheckersEndgame::UNKNOWN;
+    }
+
+    int number = sliceNumbers[sliceKey(slice)];
+    if (number < 0) {
+        return CheckersEndgame::UNKNOWN;
+    }
+
+    uint64_t index = CheckersEndgame::getIndex(normal, slice);
+    int slot = getBlock(firstBlocks[number] + index / CheckersEndgame::BLOCK_POSITIONS);
+    int position = static_cast<int>(index % CheckersEndgame::BLOCK_POSITIONS);
+
+    return (cache[static_cast<size_t>(slot) * BLOCK_BYTES + (position >> 2)] >> ((position & 3) * 2)) & 3;
+}
+
+
+// Gets the number of positions looked up so far
+uint64_t CheckersEndgameDatabase::getProbes() const {
+    return probes;
+}
+
+
+// Gets the number of blocks decoded so far
+uint64_t CheckersEndgameDatabase::getBlockLoads() const {
+    return blockLoads;
+}
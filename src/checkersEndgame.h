@@ -0,0 +1,256 @@
+#ifndef CHECKERS_ENDGAME_H
+#define CHECKERS_ENDGAME_H
+
+/*!
+* @file checkersEndgame.h
+* @brief Contains the declaration of the checkers endgame database: its indexing, the builder and the reader.
+* @details Positions are split into slices by how many men and kings each side has, and only positions with black to
+* @details move are stored; white to move is looked up by turning the board round and swapping the colours. Within a
+* @details slice a position is given a dense index by ranking each group of pieces as a combination: black's men over
+* @details the 28 squares they can stand on, white's men likewise, then black's kings over the squares the men leave
+* @details free and white's kings over the squares left after that.
+* @details
+* @details A database file is a 32 byte header ("MGED", then the little-endian 32-bit version, largest number of
+* @details pieces, slice count and positions per block, 32 reserved bits and the 64-bit block count), a 16 byte record
+* @details per slice (the four piece counts, the 32-bit first block and block count, 32 reserved bits), the 64-bit
+* @details offset of every block and of the end of the last, then the blocks. Each block holds BLOCK_POSITIONS
+* @details values run-length encoded: a byte with the value in its top two bits and the run length less one in the
+* @details other six, where 63 means a run of 64 or more with the rest of the length following as a varint.
+*/
+
+#include "checkersBoard.h"
+#include "mappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+* @struct EndgameSlice
+* @brief The set of positions with a given number of each kind of piece, black to move.
+*/
+struct EndgameSlice {
+	int blackMen = 0; /*!< The number of black men. */
+	int blackKings = 0; /*!< The number of black kings. */
+	int whiteMen = 0; /*!< The number of white men. */
+	int whiteKings = 0; /*!< The number of white kings. */
+
+	/*!
+	* @brief Get the number of indices in the slice, including a few that are not real positions.
+	* @return The number of indices.
+	*/
+	uint64_t size() const;
+
+	/*!
+	* @brief Get the total number of pieces.
+	* @return The number of pieces.
+	*/
+	int pieces() const { return blackMen + blackKings + whiteMen + whiteKings; }
+};
+
+/*!
+* @class CheckersEndgame
+* @brief The indexing shared by the endgame database builder and reader.
+*/
+class CheckersEndgame {
+public:
+	static const int MAX_PIECES = 5; /*!< The most pieces a database can be built for; six would need gigabytes held at once. */
+	static const int BLOCK_POSITIONS = 1024; /*!< The number of values in each compressed block. */
+
+	static const int UNKNOWN = 0; /*!< The position is not in the database. */
+	static const int WIN = 1; /*!< The side to move wins. */
+	static const int LOSS = 2; /*!< The side to move loses. */
+	static const int DRAW = 3; /*!< The game is drawn with best play. */
+
+	/*!
+	* @brief List every slice with at least one piece each side and at most a number of pieces in all.
+	* @details The slices are in the order they are built: fewer pieces first, then fewer men, so every capture and
+	* @details crowning leads to an earlier slice. A slice and its colour swapped twin are always next to each other.
+	* @param maxPieces The largest number of pieces.
+	* @return The slices.
+	*/
+	static std::vector<EndgameSlice> listSlices(int maxPieces);
+
+	/*!
+	* @brief Turn the board round and swap the colours if white is to move, so black is.
+	* @param board The position.
+	* @return The same position with black to move.
+	*/
+	static CheckersBoard normalise(const CheckersBoard& board);
+
+	/*!
+	* @brief Find the slice a position with black to move is in.
+	* @param board The position, with black to move.
+	* @return The slice.
+	*/
+	static EndgameSlice getSlice(const CheckersBoard& board);
+
+	/*!
+	* @brief Get a position's index within its slice.
+	* @param board The position, with black to move and no men on the row they would be crowned on.
+	* @param slice The position's slice.
+	* @return The index.
+	*/
+	static uint64_t getIndex(const CheckersBoard& board, const EndgameSlice& slice);
+
+	/*!
+	* @brief Set up the position with an index in a slice, black to move.
+	* @param board Set to the position.
+	* @param slice The slice.
+	* @param index The index.
+	* @return false if the index is not a real position, because a black and a white man share a square.
+	*/
+	static bool setPosition(CheckersBoard& board, const EndgameSlice& slice, uint64_t index);
+};
+
+/*!
+* @class CheckersEndgameBuilder
+* @brief Solves every position with up to some number of pieces by retrograde analysis, and writes the database.
+* @details Each slice and its colour swapped twin are solved together, after every slice their captures and crownings
+* @details lead to. One pass scores the positions settled by those slices alone and counts each position's steps into
+* @details the pair. Then, working back from each won or lost position by unmaking steps, its predecessors are marked
+* @details won if it was lost, or have their count reduced if it was won and are marked lost once it reaches zero.
+* @details Positions never reached are draws. Values are held two bits each.
+*/
+class CheckersEndgameBuilder {
+private:
+	int maxPieces; /*!< The largest number of pieces. */
+	std::vector<EndgameSlice> slices; /*!< Every slice, in build order. */
+	std::vector<std::vector<uint8_t>> values; /*!< Each slice's values, four to a byte. */
+	std::vector<int> sliceNumbers; /*!< Each slice's place in slices, by its piece counts, or -1. */
+
+	/*!
+	* @brief Find a slice's place in the list.
+	* @param slice The slice.
+	* @return Its place in slices, or -1 if it is not in the database.
+	*/
+	int findSlice(const EndgameSlice& slice) const;
+
+	/*!
+	* @brief Look up the value of a position reached while solving, with white to move.
+	* @param board The position.
+	* @return The value for white.
+	*/
+	int lookUp(const CheckersBoard& board) const;
+
+	/*!
+	* @brief Solve one slice and its twin.
+	* @param first The slice's place in the list.
+	* @param second The twin's place, the same as first if the slice is its own twin.
+	*/
+	void solve(int first, int second);
+
+public:
+	/*!
+	* @brief Constructor for CheckersEndgameBuilder.
+	* @param maxPieces The largest number of pieces, at most MAX_PIECES.
+	* @throws runtime_error if maxPieces is out of range.
+	*/
+	explicit CheckersEndgameBuilder(int maxPieces);
+
+	/*!
+	* @brief Solve every slice, fewest pieces first.
+	* @return The number of positions solved.
+	*/
+	uint64_t build();
+
+	/*!
+	* @brief Look up a position in the solved database.
+	* @param board The position.
+	* @return WIN, LOSS or DRAW for the side to move, or UNKNOWN if the position is not in the database.
+	*/
+	int probe(const CheckersBoard& board) const;
+
+	/*!
+	* @brief Write the solved database to a file.
+	* @param filename The name of the file.
+	* @return The size of the file in bytes.
+	* @throws runtime_error if the file cannot be written.
+	*/
+	uint64_t write(const std::string& filename) const;
+};
+
+/*!
+* @class CheckersEndgameDatabase
+* @brief Looks up positions in a database file written by CheckersEndgameBuilder.
+* @details The file is memory mapped. A block is decoded the first time it is probed and kept in a cache of recently
+* @details used blocks, so the probes a search makes, which mostly fall in a few blocks, rarely decode anything.
+*/
+class CheckersEndgameDatabase {
+public:
+	static const uint32_t VERSION = 1; /*!< The version of the file format. */
+	static const int HEADER_BYTES = 32; /*!< The size of the file header. */
+	static const int SLICE_BYTES = 16; /*!< The size of one slice record. */
+	static const int DEFAULT_CACHE_BLOCKS = 16384; /*!< By default, how many decoded blocks to keep. */
+
+private:
+	static const int BLOCK_BYTES = CheckersEndgame::BLOCK_POSITIONS / 4; /*!< The size of a decoded block. */
+
+	MappedFile file; /*!< The mapped database file. */
+	int maxPieces; /*!< The largest number of pieces in the database. */
+	std::vector<int> sliceNumbers; /*!< Each slice's place in the file, by its piece counts, or -1. */
+	std::vector<uint32_t> firstBlocks; /*!< Each slice's first block. */
+	const uint8_t* blockOffsets; /*!< The offset of each block's data. */
+	const uint8_t* blockData; /*!< The start of the blocks. */
+	uint64_t blockCount; /*!< The number of blocks. */
+
+	std::vector<uint8_t> cache; /*!< The decoded blocks, four values to a byte. */
+	std::vector<int> cachedBlocks; /*!< The block held in each cache slot, or -1. */
+	std::vector<int> newer; /*!< Each slot's neighbour towards the most recently used, or -1. */
+	std::vector<int> older; /*!< Each slot's neighbour towards the least recently used, or -1. */
+	std::vector<int> blockSlots; /*!< The cache slot holding each block, or -1. */
+	int newest; /*!< The most recently used slot. */
+	int oldest; /*!< The least recently used slot, the next to be reused. */
+
+	uint64_t probes; /*!< Positions looked up. */
+	uint64_t blockLoads; /*!< Blocks decoded into the cache. */
+
+	/*!
+	* @brief Decode a block into a cache slot.
+	* @param block The block.
+	* @param slot The cache slot.
+	*/
+	void decodeBlock(uint64_t block, int slot);
+
+	/*!
+	* @brief Get a block's cache slot, decoding it into the least recently used slot if it is not cached.
+	* @param block The block.
+	* @return The slot.
+	*/
+	int getBlock(uint64_t block);
+
+public:
+	/*!
+	* @brief Open a database file.
+	* @param filename The name of the file.
+	* @param cacheBlocks How many decoded blocks to keep.
+	* @throws runtime_error if the file cannot be opened or is not an endgame database.
+	*/
+	explicit CheckersEndgameDatabase(const std::string& filename, int cacheBlocks = DEFAULT_CACHE_BLOCKS);
+
+	/*!
+	* @brief Get the largest number of pieces in the database.
+	* @return The number of pieces.
+	*/
+	int getMaxPieces() const;
+
+	/*!
+	* @brief Look up a position.
+	* @param board The position.
+	* @return WIN, LOSS or DRAW for the side to move, or UNKNOWN if the position is not in the database.
+	*/
+	int probe(const CheckersBoard& board);
+
+	/*!
+	* @brief Get the number of positions looked up so far.
+	* @return The number of probes.
+	*/
+	uint64_t getProbes() const;
+
+	/*!
+	* @brief Get the number of blocks decoded so far; the rest of the probes were answered from the cache.
+	* @return The number of blocks decoded.
+	*/
+	uint64_t getBlockLoads() const;
+};
+
+#endif // CHECKERS_ENDGAME_H
@@ -0,0 +1,887 @@
+
+#include "chessAI.h"
+#include "openingBook.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// Piece values in centipawns
+static const int PIECE_VALUES[6] = { 100, 320, 330, 500, 900, 0 };
+
+// How much each piece counts towards the middlegame, 24 with all pieces on the board
+static const int PHASE_WEIGHTS[6] = { 0, 1, 1, 2, 4, 0 };
+static const int TOTAL_PHASE = 24;
+
+// Piece-square tables from white's point of view, written with rank 8 at the top
+static const int PAWN_TABLE[64] = {
+     0,  0,  0,  0,  0,  0,  0,  0,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    10, 10, 20, 30, 30, 20, 10, 10,
+     5,  5, 10, 25, 25, 10,  5,  5,
+     0,  0,  0, 20, 20,  0,  0,  0,
+     5, -5,-10,  0,  0,-10, -5,  5,
+     5, 10, 10,-20,-20, 10, 10,  5,
+     0,  0,  0,  0,  0,  0,  0,  0
+};
+
+static const int KNIGHT_TABLE[64] = {
+   -50,-40,-30,-30,-30,-30,-40,-50,
+   -40,-20,  0,  0,  0,  0,-20,-40,
+   -30,  0, 10, 15, 15, 10,  0,-30,
+   -30,  5, 15, 20, 20, 15,  5,-30,
+   -30,  0, 15, 20, 20, 15,  0,-30,
+   -30,  5, 10, 15, 15, 10,  5,-30,
+   -40,-20,  0,  5,  5,  0,-20,-40,
+   -50,-40,-30,-30,-30,-30,-40,-50
+};
+
+static const int BISHOP_TABLE[64] = {
+   -20,-10,-10,-10,-10,-10,-10,-20,
+   -10,  0,  0,  0,  0,  0,  0,-10,
+   -10,  0,  5, 10, 10,  5,  0,-10,
+   -10,  5,  5, 10, 10,  5,  5,-10,
+   -10,  0, 10, 10, 10, 10,  0,-10,
+   -10, 10, 10, 10, 10, 10, 10,-10,
+   -10,  5,  0,  0,  0,  0,  5,-10,
+   -20,-10,-10,-10,-10,-10,-10,-20
+};
+
+static const int ROOK_TABLE[64] = {
+     0,  0,  0,  0,  0,  0,  0,  0,
+     5, 10, 10, 10, 10, 10, 10,  5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+     0,  0,  0,  5,  5,  0,  0,  0
+};
+
+static const int QUEEN_TABLE[64] = {
+   -20,-10,-10, -5, -5,-10,-10,-20,
+   -10,  0,  0,  0,  0,  0,  0,-10,
+   -10,  0,  5,  5,  5,  5,  0,-10,
+    -5,  0,  5,  5,  5,  5,  0, -5,
+     0,  0,  5,  5,  5,  5,  0, -5,
+   -10,  5,  5,  5,  5,  5,  0,-10,
+   -10,  0,  5,  0,  0,  0,  0,-10,
+   -20,-10,-10, -5, -5,-10,-10,-20
+};
+
+static const int KING_MIDDLEGAME_TABLE[64] = {
+   -30,-40,-40,-50,-50,-40,-40,-30,
+   -30,-40,-40,-50,-50,-40,-40,-30,
+   -30,-40,-40,-50,-50,-40,-40,-30,
+   -30,-40,-40,-50,-50,-40,-40,-30,
+   -20,-30,-30,-40,-40,-30,-30,-20,
+   -10,-20,-20,-20,-20,-20,-20,-10,
+    20, 20,  0,  0,  0,  0, 20, 20,
+    20, 30, 10,  0,  0, 10, 30, 20
+};
+
+static const int KING_ENDGAME_TABLE[64] = {
+   -50,-40,-30,-20,-20,-30,-40,-50,
+   -30,-20,-10,  0,  0,-10,-20,-30,
+   -30,-10, 20, 30, 30, 20,-10,-30,
+   -30,-10, 30, 40, 40, 30,-10,-30,
+   -30,-10, 30, 40, 40, 30,-10,-30,
+   -30,-10, 20, 30, 30, 20,-10,-30,
+   -30,-30,  0,  0,  0,  0,-30,-30,
+   -50,-30,-30,-30,-30,-30,-30,-50
+};
+
+static const int* const PIECE_TABLES[5] = { PAWN_TABLE, KNIGHT_TABLE, BISHOP_TABLE, ROOK_TABLE, QUEEN_TABLE };
+
+// Move ordering scores, highest first
+static const int TT_MOVE_SCORE = 1000000;
+static const int CAPTURE_SCORE = 100000;
+static const int FIRST_KILLER_SCORE = 90000;
+static const int SECOND_KILLER_SCORE = 80000;
+static const int HISTORY_LIMIT = 60000;
+
+// Check the clock this often, in nodes
+static const uint64_t LIMIT_CHECK_INTERVAL = 1024;
+
+// Packing of a transposition table entry into 64 bits
+static const int SCORE_SHIFT = 16;
+static const int DEPTH_SHIFT = 32;
+static const int BOUND_SHIFT = 40;
+static const int GENERATION_SHIFT = 48;
+
+
+// Constructor for the TranspositionTable class
+TranspositionTable::TranspositionTable(size_t megabytes) : count(0), mask(0), generation(0) {
+    resize(megabytes);
+}
+
+
+// Resizes the table to the largest power of two slots that fits
+void TranspositionTable::resize(size_t megabytes) {
+    size_t newCount = 1;
+    size_t bytes = megabytes * 1024 * 1024;
+
+    while (newCount * 2 * sizeof(Slot) <= bytes) {
+        newCount *= 2;
+    }
+
+    slots.reset(new Slot[newCount]);
+    count = newCount;
+    mask = newCount - 1;
+    clear();
+}
+
+
+// Empties the table
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < count; i++) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+    generation.store(0, std::memory_order_relaxed);
+}
+
+
+// Starts a new search
+void TranspositionTable::newSearch() {
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+// Gets the number of slots
+size_t TranspositionTable::size() const {
+    return count;
+}
+
+
+// Looks up a position
+bool TranspositionTable::probe(uint64_t key, TranspositionEntry& entry) const {
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+    if (data == 0 || (check ^ data) != key) {
+        return false;
+    }
+
+    entry.move.data = static_cast<uint16_t>(data);
+    entry.score = static_cast<int16_t>(data >> SCORE_SHIFT);
+    entry.depth = static_cast<uint8_t>(data >> DEPTH_SHIFT);
+    entry.bound = static_cast<int>((data >> BOUND_SHIFT) & 3);
+
+    return true;
+}
+
+
+// Stores a position, unless the slot holds a deeper search of another position from this search
+void TranspositionTable::store(uint64_t key, ChessMove move, int score, int depth, int bound) {
+    Slot& slot = slots[key & mask];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    bool samePosition = (slot.check.load(std::memory_order_relaxed) ^ oldData) == key;
+
+    if (oldData != 0 && !samePosition) {
+        int oldDepth = static_cast<uint8_t>(oldData >> DEPTH_SHIFT);
+        uint8_t oldGeneration = static_cast<uint8_t>(oldData >> GENERATION_SHIFT);
+
+        if (oldGeneration == generation.load(std::memory_order_relaxed) && oldDepth > depth + 2) {
+            return;
+        }
+    }
+
+    // Keep the old move when the new search did not find one
+    if (move.isNull() && samePosition) {
+        move.data = static_cast<uint16_t>(oldData);
+    }
+
+    uint64_t data = uint64_t(move.data)
+        | (uint64_t(static_cast<uint16_t>(score)) << SCORE_SHIFT)
+        | (uint64_t(static_cast<uint8_t>(depth)) << DEPTH_SHIFT)
+        | (uint64_t(bound) << BOUND_SHIFT)
+        | (uint64_t(generation.load(std::memory_order_relaxed)) << GENERATION_SHIFT);
+
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+
+// Mate scores are stored relative to the position, so they stay right wherever it is found in the tree
+static int scoreToTable(int score, int ply) {
+    if (score >= ChessAI::MATE_BOUND) return score + ply;
+    if (score <= -ChessAI::MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int scoreFromTable(int score, int ply) {
+    if (score >= ChessAI::MATE_BOUND) return score - ply;
+    if (score <= -ChessAI::MATE_BOUND) return score + ply;
+    return score;
+}
+
+
+// Constructor for the ChessAI class
+ChessAI::ChessAI(TranspositionTable& table) : table(table), nodes(0), nodeLimit(0), timeLimited(false), stopped(false),
+    stopSignal(nullptr), helperIndex(0) {
+    clearHistory();
+}
+
+
+// Makes this search one thread of a parallel search
+void ChessAI::setParallel(const std::atomic<bool>* signal, int index) {
+    stopSignal = signal;
+    helperIndex = index;
+}
+
+
+// Helpers skip iterations in a pattern set by their index, so that at any moment they are spread over several depths
+bool ChessAI::skipIteration(int depth) const {
+    static const int SKIP_SIZE[20] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    static const int SKIP_PHASE[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    if (helperIndex == 0) {
+        return false;
+    }
+
+    int pattern = (helperIndex - 1) % 20;
+    return ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2 != 0;
+}
+
+
+// Forgets the killer moves and history
+void ChessAI::clearHistory() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = ChessMove();
+        killers[ply][1] = ChessMove();
+    }
+
+    for (int side = 0; side < 2; side++) {
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                history[side][from][to] = 0;
+            }
+        }
+    }
+}
+
+
+// Evaluates a position with material and piece-square tables
+int ChessAI::evaluate(const ChessBoard& board) {
+    int score = 0;
+    int phase = 0;
+    int kingMiddlegame = 0;
+    int kingEndgame = 0;
+
+    for (int square = 0; square < 64; square++) {
+        int piece = board.getPiece(square);
+        if (piece < 0) {
+            continue;
+        }
+
+        int side = piece / 6;
+        int type = piece % 6;
+
+        // The tables are written from white's side with rank 8 first, so white flips the rank
+        int index = (side == ChessBoard::WHITE) ? (7 - square / 8) * 8 + square % 8 : square;
+        int sign = (side == ChessBoard::WHITE) ? 1 : -1;
+
+        if (type == KING) {
+            kingMiddlegame += sign * KING_MIDDLEGAME_TABLE[index];
+            kingEndgame += sign * KING_ENDGAME_TABLE[index];
+        }
+        else {
+            score += sign * (PIECE_VALUES[type] + PIECE_TABLES[type][index]);
+            phase += PHASE_WEIGHTS[type];
+        }
+    }
+
+    if (phase > TOTAL_PHASE) {
+        phase = TOTAL_PHASE;
+    }
+    score += (kingMiddlegame * phase + kingEndgame * (TOTAL_PHASE - phase)) / TOTAL_PHASE;
+
+    return (board.getSideToMove() == ChessBoard::WHITE) ? score : -score;
+}
+
+
+// Stops the search when a limit is reached
+void ChessAI::checkLimits() {
+    if (nodeLimit != 0 && nodes >= nodeLimit) {
+        stopped = true;
+    }
+
+    if (timeLimited && std::chrono::steady_clock::now() >= deadline) {
+        stopped = true;
+    }
+
+    if (stopSignal != nullptr && stopSignal->load(std::memory_order_relaxed)) {
+        stopped = true;
+    }
+}
+
+
+// Scores moves for ordering: the table move, then captures by victim and attacker, then killers and history
+void ChessAI::scoreMoves(const ChessBoard& board, const ChessMoveList& list, int* scores, ChessMove ttMove, int ply) const {
+    int side = board.getSideToMove();
+
+    for (int i = 0; i < list.size(); i++) {
+        ChessMove move = list[i];
+
+        if (move == ttMove) {
+            scores[i] = TT_MOVE_SCORE;
+        }
+        else if (move.isCapture() || move.isPromotion()) {
+            int victim = move.isCapture() ? ((move.flags() == ChessMove::EN_PASSANT) ? PAWN : board.getPiece(move.to()) % 6) : PAWN;
+            int attacker = board.getPiece(move.from()) % 6;
+            scores[i] = CAPTURE_SCORE + PIECE_VALUES[victim] * 10 - attacker + (move.isPromotion() ? PIECE_VALUES[move.promotionPiece()] : 0);
+        }
+        else if (move == killers[ply][0]) {
+            scores[i] = FIRST_KILLER_SCORE;
+        }
+        else if (move == killers[ply][1]) {
+            scores[i] = SECOND_KILLER_SCORE;
+        }
+        else {
+            scores[i] = history[side][move.from()][move.to()];
+        }
+    }
+}
+
+
+// Swaps the best scoring remaining move into place, so moves are only sorted as far as they are searched
+static void pickNextMove(ChessMoveList& list, int* scores, int index) {
+    int best = index;
+
+    for (int i = index + 1; i < list.size(); i++) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+
+    if (best != index) {
+        ChessMove move = list[index];
+        list[index] = list[best];
+        list[best] = move;
+
+        int score = scores[index];
+        scores[index] = scores[best];
+        scores[best] = score;
+    }
+}
+
+
+// The principal variation search
+int ChessAI::searchNode(ChessBoard& board, int depth, int alpha, int beta, int ply, bool allowNull) {
+    pvLength[ply] = ply;
+
+    if (ply > 0 && (board.isRepetition() || board.getHalfmoveClock() >= 100)) {
+        return 0;
+    }
+
+    if (depth <= 0) {
+        return quiescence(board, alpha, beta, ply);
+    }
+
+    if (++nodes % LIMIT_CHECK_INTERVAL == 0) {
+        checkLimits();
+    }
+    if (stopped) {
+        return 0;
+    }
+
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(board);
+    }
+
+    bool pvNode = (beta - alpha > 1);
+    bool inCheck = board.isInCheck();
+    uint64_t key = board.getHash();
+
+    // Away from the principal variation a deep enough table entry can end the search here
+    TranspositionEntry entry;
+    ChessMove ttMove;
+    if (table.probe(key, entry)) {
+        ttMove = entry.move;
+
+        if (!pvNode && entry.depth >= depth) {
+            int score = scoreFromTable(entry.score, ply);
+
+            if (entry.bound == TranspositionTable::BOUND_EXACT ||
+                (entry.bound == TranspositionTable::BOUND_LOWER && score >= beta) ||
+                (entry.bound == TranspositionTable::BOUND_UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    // Look one ply deeper when in check
+    if (inCheck) {
+        depth++;
+    }
+
+    // Null move pruning: if passing still fails high, a real move surely would. Not used without pieces, where zugzwang is common.
+    if (!pvNode && !inCheck && allowNull && depth >= 3 && board.hasNonPawnMaterial() && evaluate(board) >= beta) {
+        int reduction = 2 + depth / 6;
+
+        board.makeNullMove();
+        int score = -searchNode(board, depth - 1 - reduction, -beta, -beta + 1, ply + 1, false);
+        board.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+        if (score >= beta) {
+            return (score >= MATE_BOUND) ? beta : score;
+        }
+    }
+
+    ChessMoveList list;
+    board.generateLegalMoves(list);
+
+    if (list.size() == 0) {
+        return inCheck ? -MATE_SCORE + ply : 0;
+    }
+
+    int scores[ChessMoveList::MAX_MOVES];
+    scoreMoves(board, list, scores, ttMove, ply);
+
+    int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    ChessMove bestMove;
+    int side = board.getSideToMove();
+
+    for (int i = 0; i < list.size(); i++) {
+        pickNextMove(list, scores, i);
+        ChessMove move = list[i];
+        int score;
+
+        // The first move gets the full window; the rest are proved worse with a null window, and re-searched if not
+        board.makeMove(move);
+        if (i == 0) {
+            score = -searchNode(board, depth - 1, -beta, -alpha, ply + 1, true);
+        }
+        else {
+            score = -searchNode(board, depth - 1, -alpha - 1, -alpha, ply + 1, true);
+            if (score > alpha && score < beta) {
+                score = -searchNode(board, depth - 1, -beta, -alpha, ply + 1, true);
+            }
+        }
+        board.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+
+            if (score > alpha) {
+                alpha = score;
+
+                pvTable[ply][ply] = move;
+                for (int next = ply + 1; next < pvLength[ply + 1]; next++) {
+                    pvTable[ply][next] = pvTable[ply + 1][next];
+                }
+                pvLength[ply] = pvLength[ply + 1];
+
+                if (ply == 0) {
+                    rootBestMove = move;
+                }
+
+                if (alpha >= beta) {
+                    if (!move.isCapture() && !move.isPromotion()) {
+                        if (killers[ply][0] != move) {
+                            killers[ply][1] = killers[ply][0];
+                            killers[ply][0] = move;
+                        }
+
+                        history[side][move.from()][move.to()] += depth * depth;
+                        if (history[side][move.from()][move.to()] > HISTORY_LIMIT) {
+                            for (int from = 0; from < 64; from++) {
+                                for (int to = 0; to < 64; to++) {
+                                    history[side][from][to] /= 2;
+                                }
+                            }
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    int bound = (bestScore >= beta) ? TranspositionTable::BOUND_LOWER :
+        (bestScore > originalAlpha) ? TranspositionTable::BOUND_EXACT : TranspositionTable::BOUND_UPPER;
+    table.store(key, bestMove, scoreToTable(bestScore, ply), depth, bound);
+
+    return bestScore;
+}
+
+
+// Searches captures and promotions until the position is quiet, or every move when in check
+int ChessAI::quiescence(ChessBoard& board, int alpha, int beta, int ply) {
+    pvLength[ply] = ply;
+
+    if (++nodes % LIMIT_CHECK_INTERVAL == 0) {
+        checkLimits();
+    }
+    if (stopped) {
+        return 0;
+    }
+
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(board);
+    }
+
+    bool inCheck = board.isInCheck();
+
+    // Standing pat: the side to move can usually do at least as well as the static score
+    if (!inCheck) {
+        int standPat = evaluate(board);
+        if (standPat >= beta) {
+            return standPat;
+        }
+        if (standPat > alpha) {
+            alpha = standPat;
+        }
+    }
+
+    ChessMoveList list;
+    board.generateLegalMoves(list);
+
+    if (inCheck && list.size() == 0) {
+        return -MATE_SCORE + ply;
+    }
+
+    if (!inCheck) {
+        int kept = 0;
+        for (int i = 0; i < list.size(); i++) {
+            if (list[i].isCapture() || list[i].isPromotion()) {
+                list[kept++] = list[i];
+            }
+        }
+        list.count = kept;
+    }
+
+    int scores[ChessMoveList::MAX_MOVES];
+    scoreMoves(board, list, scores, ChessMove(), ply);
+
+    for (int i = 0; i < list.size(); i++) {
+        pickNextMove(list, scores, i);
+
+        board.makeMove(list[i]);
+        int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+
+        if (score >= beta) {
+            return score;
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+    }
+
+    return alpha;
+}
+
+
+// Searches with iterative deepening until a limit is reached
+SearchResult ChessAI::search(ChessBoard& board, const SearchLimits& limits) {
+    SearchResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    nodes = 0;
+    nodeLimit = limits.maxNodes;
+    stopped = false;
+    timeLimited = (limits.moveTimeMs > 0);
+    deadline = start + std::chrono::milliseconds(limits.moveTimeMs);
+
+    if (helperIndex == 0) {
+        table.newSearch();
+    }
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = ChessMove();
+        killers[ply][1] = ChessMove();
+    }
+
+    ChessMoveList rootMoves;
+    board.generateLegalMoves(rootMoves);
+    if (rootMoves.size() == 0) {
+        return result;
+    }
+
+    // Something to play even if the first iteration is cut short
+    result.bestMove = rootMoves[0];
+
+    int maxDepth = (limits.maxDepth < MAX_PLY - 1) ? limits.maxDepth : MAX_PLY - 1;
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        if (skipIteration(depth) && depth < maxDepth) {
+            continue;
+        }
+
+        rootBestMove = ChessMove();
+        int score = searchNode(board, depth, -INFINITE_SCORE, INFINITE_SCORE, 0, false);
+
+        // A cut short iteration still searched the previous best move first, so any better move it found can be trusted
+        if (stopped) {
+            if (!rootBestMove.isNull()) {
+                result.bestMove = rootBestMove;
+            }
+            break;
+        }
+
+        result.bestMove = rootBestMove;
+        result.score = score;
+        result.depth = depth;
+        result.principalVariation.assign(pvTable[0], pvTable[0] + pvLength[0]);
+
+        // A forced mate will not get better with more depth
+        if (score >= MATE_BOUND || score <= -MATE_BOUND) {
+            if (MATE_SCORE - std::abs(score) <= depth) {
+                break;
+            }
+        }
+
+        // The next iteration takes longer than all those before it, so do not start one that cannot finish
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (timeLimited && elapsed.count() * 2 >= limits.moveTimeMs) {
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+
+// Strips check and annotation marks from a move in SAN
+static std::string stripSan(const std::string& san) {
+    std::string stripped = san;
+
+    while (!stripped.empty() && (stripped.back() == '+' || stripped.back() == '#' || stripped.back() == '!' || stripped.back() == '?')) {
+        stripped.pop_back();
+    }
+
+    return stripped;
+}
+
+
+// Runs an EPD test suite
+EpdResult ChessAI::runEpdSuite(std::istream& input, const SearchLimits& limits) {
+    EpdResult result;
+    std::string line;
+
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // The first four fields are the position, the rest are operations separated by semicolons
+        std::istringstream stream(line);
+        std::string placement, side, castling, enPassant;
+        if (!(stream >> placement >> side >> castling >> enPassant)) {
+            continue;
+        }
+
+        std::string operations;
+        std::getline(stream, operations);
+
+        std::vector<std::string> bestMoves, avoidMoves;
+        std::string id;
+        std::istringstream operationStream(operations);
+        std::string operation;
+
+        while (std::getline(operationStream, operation, ';')) {
+            std::istringstream operandStream(operation);
+            std::string opcode, operand;
+            operandStream >> opcode;
+
+            if (opcode == "bm" || opcode == "am") {
+                while (operandStream >> operand) {
+                    (opcode == "bm" ? bestMoves : avoidMoves).push_back(stripSan(operand));
+                }
+            }
+            else if (opcode == "id") {
+                size_t first = operation.find('"');
+                size_t last = operation.rfind('"');
+                if (first != std::string::npos && last > first) {
+                    id = operation.substr(first + 1, last - first - 1);
+                }
+            }
+        }
+
+        ChessBoard board;
+        std::string fen = placement + " " + side + " " + castling + " " + enPassant + " 0 1";
+        board.setFen(fen);
+
+        SearchResult search = this->search(board, limits);
+        result.positions++;
+        result.nodes += search.nodes;
+        result.seconds += search.seconds;
+
+        // Compare the moves themselves, so differences in how the SAN is written do not matter
+        bool solved = !search.bestMove.isNull();
+        if (solved && !bestMoves.empty()) {
+            solved = false;
+            for (const std::string& san : bestMoves) {
+                solved |= (board.parseSan(san) == search.bestMove);
+            }
+        }
+        for (const std::string& san : avoidMoves) {
+            solved &= (board.parseSan(san) != search.bestMove);
+        }
+
+        if (solved) {
+            result.solved++;
+        }
+        else {
+            result.failed.push_back(id.empty() ? fen : id);
+        }
+    }
+
+    return result;
+}
+
+
+// Runs an EPD test suite from a file
+EpdResult ChessAI::runEpdFile(const std::string& filename, const SearchLimits& limits) {
+    std::ifstream file(filename);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open EPD file " + filename);
+    }
+
+    return runEpdSuite(file, limits);
+}
+
+
+// Constructor for the LazySmpSearch class
+LazySmpSearch::LazySmpSearch(TranspositionTable& table, int threads) : table(table), stopSignal(false), book(nullptr) {
+    setThreadCount(threads);
+}
+
+
+// Changes the number of threads
+void LazySmpSearch::setThreadCount(int threads) {
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    searchers.clear();
+    for (int i = 0; i < threads; i++) {
+        searchers.emplace_back(new ChessAI(table));
+        searchers.back()->setParallel(&stopSignal, i);
+    }
+}
+
+
+// Gets the number of threads
+int LazySmpSearch::getThreadCount() const {
+    return static_cast<int>(searchers.size());
+}
+
+
+// Forgets every thread's history
+void LazySmpSearch::clearHistory() {
+    for (std::unique_ptr<ChessAI>& searcher : searchers) {
+        searcher->clearHistory();
+    }
+}
+
+
+// Sets the opening book
+void LazySmpSearch::setOpeningBook(const OpeningBook* openingBook) {
+    book = openingBook;
+}
+
+
+// Searches with the main thread here and the helpers on their own threads
+SearchResult LazySmpSearch::search(const ChessBoard& board, const SearchLimits& limits) {
+    if (book != nullptr && limits.useBook) {
+        ChessMove move = book->chooseMove(board);
+        if (!move.isNull()) {
+            SearchResult result;
+            result.bestMove = move;
+            result.principalVariation.push_back(move);
+            result.bookMove = true;
+            return result;
+        }
+    }
+
+    ChessBoard mainBoard = board;
+
+    if (searchers.size() == 1) {
+        return searchers[0]->search(mainBoard, limits);
+    }
+
+    // Helpers have no limits of their own; they run until the main thread stops them
+    SearchLimits helperLimits;
+    helperLimits.maxDepth = limits.maxDepth;
+
+    std::vector<ChessBoard> boards(searchers.size() - 1, board);
+    std::vector<SearchResult> results(searchers.size());
+    std::vector<std::thread> helpers;
+
+    stopSignal.store(false);
+    for (size_t i = 1; i < searchers.size(); i++) {
+        helpers.emplace_back([this, i, &boards, &results, &helperLimits]() {
+            results[i] = searchers[i]->search(boards[i - 1], helperLimits);
+        });
+    }
+
+    results[0] = searchers[0]->search(mainBoard, limits);
+
+    stopSignal.store(true);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    // Take the deepest completed iteration, preferring the main thread
+    SearchResult best = results[0];
+    uint64_t nodes = results[0].nodes;
+
+    for (size_t i = 1; i < results.size(); i++) {
+        nodes += results[i].nodes;
+
+        if (results[i].depth > best.depth && !results[i].bestMove.isNull()) {
+            best = results[i];
+        }
+    }
+
+    best.nodes = nodes;
+    best.seconds = results[0].seconds;
+
+    return best;
+}
+
+
+// Measures the time to reach a depth from an empty table
+SmpTiming LazySmpSearch::timeToDepth(const ChessBoard& board, int depth) {
+    table.clear();
+    clearHistory();
+
+    SearchLimits limits;
+    limits.maxDepth = depth;
+    limits.useBook = false;
+
+    auto start = std::chrono::steady_clock::now();
+    SearchResult result = search(board, limits);
+
+    SmpTiming timing;
+    timing.threads = getThreadCount();
+    timing.depth = result.depth;
+    timing.nodes = result.nodes;
+    timing.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return timing;
+}
@@ -0,0 +1,362 @@
+#ifndef CHESS_AI_H
+#define CHESS_AI_H
+
+/*!
+* @file chessAI.h
+* @brief Contains the declaration of the chess search: the transposition table, the ChessAI class and the EPD test runner.
+*/
+
+#include "chessBoard.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+class OpeningBook;
+
+/*!
+* @struct TranspositionEntry
+* @brief What the transposition table knows about a position.
+*/
+struct TranspositionEntry {
+	ChessMove move; /*!< The best move found, or the null move. */
+	int score; /*!< The score, with mate scores relative to the position stored. */
+	int depth; /*!< The depth the position was searched to. */
+	int bound; /*!< Whether the score is exact, a lower bound or an upper bound. */
+};
+
+/*!
+* @class TranspositionTable
+* @brief A hash table of searched positions, keyed by Zobrist key, that can be shared between searches and threads.
+* @details Each slot is two 64 bit words, the packed entry and the key xored with it. Threads read and write them
+* @details without locks; a slot torn by two writers no longer matches its key, so it reads as a miss.
+* @details A slot is replaced when the new entry is for the same position, was searched nearly as deep, or the old one
+* @details is from an earlier search.
+*/
+class TranspositionTable {
+public:
+	static const int BOUND_NONE = 0; /*!< No score is stored. */
+	static const int BOUND_UPPER = 1; /*!< The score is at most the stored score. */
+	static const int BOUND_LOWER = 2; /*!< The score is at least the stored score. */
+	static const int BOUND_EXACT = 3; /*!< The score is exact. */
+
+private:
+	/*!
+	* @struct Slot
+	* @brief One slot of the table.
+	*/
+	struct Slot {
+		std::atomic<uint64_t> check; /*!< The Zobrist key of the position xored with the data. */
+		std::atomic<uint64_t> data; /*!< The move, score, depth, bound and generation packed together. */
+	};
+
+	std::unique_ptr<Slot[]> slots; /*!< The slots, a power of two of them. */
+	size_t count; /*!< The number of slots. */
+	size_t mask; /*!< The number of slots less one, for indexing. */
+	std::atomic<uint8_t> generation; /*!< Counts searches, so entries from old searches are replaced first. */
+
+public:
+	/*!
+	* @brief Constructor for TranspositionTable.
+	* @param megabytes The size of the table, rounded down to a power of two slots.
+	*/
+	explicit TranspositionTable(size_t megabytes = 16);
+
+	/*!
+	* @brief Resize the table, which also clears it.
+	* @param megabytes The new size, rounded down to a power of two slots.
+	*/
+	void resize(size_t megabytes);
+
+	/*!
+	* @brief Empty the table. Must not be called while a search is using it.
+	*/
+	void clear();
+
+	/*!
+	* @brief Start a new search, making the current entries older than any stored from now on.
+	*/
+	void newSearch();
+
+	/*!
+	* @brief Get the number of slots in the table.
+	* @return The number of slots.
+	*/
+	size_t size() const;
+
+	/*!
+	* @brief Look up a position.
+	* @param key The Zobrist key of the position.
+	* @param entry Set to the stored entry if the position is found.
+	* @return True if the position is in the table.
+	*/
+	bool probe(uint64_t key, TranspositionEntry& entry) const;
+
+	/*!
+	* @brief Store a searched position.
+	* @param key The Zobrist key of the position.
+	* @param move The best move found.
+	* @param score The score, with mate scores relative to this position.
+	* @param depth The depth searched to.
+	* @param bound The type of bound the score is.
+	*/
+	void store(uint64_t key, ChessMove move, int score, int depth, int bound);
+};
+
+/*!
+* @struct SearchLimits
+* @brief When a search should stop.
+*/
+struct SearchLimits {
+	int maxDepth = 64; /*!< The deepest iteration to search. */
+	int moveTimeMs = 0; /*!< The time allowed for the move in milliseconds, or 0 for no limit. */
+	uint64_t maxNodes = 0; /*!< The most nodes to search, or 0 for no limit. */
+	bool useBook = true; /*!< Whether to play straight from the opening book when the position is in it. */
+};
+
+/*!
+* @struct SearchResult
+* @brief The outcome of a search.
+*/
+struct SearchResult {
+	ChessMove bestMove; /*!< The best move, or the null move if there are no legal moves. */
+	int score = 0; /*!< The score from the side to move's point of view, in centipawns. */
+	int depth = 0; /*!< The deepest iteration completed. */
+	uint64_t nodes = 0; /*!< The number of positions searched. */
+	double seconds = 0.0; /*!< The time taken. */
+	std::vector<ChessMove> principalVariation; /*!< The expected line of play. */
+	bool bookMove = false; /*!< Whether the move came from the opening book rather than a search. */
+};
+
+/*!
+* @struct EpdResult
+* @brief The outcome of running an EPD test suite.
+*/
+struct EpdResult {
+	int positions = 0; /*!< The number of positions tried. */
+	int solved = 0; /*!< The number of positions where the engine found a best move or avoided every avoid move. */
+	uint64_t nodes = 0; /*!< The total positions searched. */
+	double seconds = 0.0; /*!< The total time taken. */
+	std::vector<std::string> failed; /*!< The ids, or FENs when there is no id, of the positions not solved. */
+
+	/*!
+	* @brief Get the fraction of positions solved.
+	* @return The solve rate, from 0 to 1.
+	*/
+	double solveRate() const { return positions > 0 ? static_cast<double>(solved) / positions : 0.0; }
+
+	/*!
+	* @brief Get the search speed over the whole suite.
+	* @return The nodes searched per second.
+	*/
+	double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0.0; }
+};
+
+/*!
+* @class ChessAI
+* @brief An iterative deepening principal variation search with quiescence search.
+* @details Moves are ordered by the transposition table move, captures by most valuable victim, then two killer
+* @details moves per ply and the history heuristic. Null move pruning is used away from the principal variation.
+* @details The search stops as soon as the time or node limit is reached and plays the best move found so far.
+*/
+class ChessAI {
+public:
+	static const int MAX_PLY = 128; /*!< The deepest the search can go. */
+	static const int MATE_SCORE = 32000; /*!< The score for giving mate now. */
+	static const int MATE_BOUND = MATE_SCORE - MAX_PLY; /*!< Scores above this are mate scores. */
+	static const int INFINITE_SCORE = 32001; /*!< Larger than any score. */
+
+private:
+	TranspositionTable& table; /*!< The transposition table, which may be shared with other searches. */
+
+	ChessMove killers[MAX_PLY][2]; /*!< Quiet moves that caused a cutoff at each ply. */
+	int history[2][64][64]; /*!< How often each quiet move has caused a cutoff, by side, from and to. */
+	ChessMove pvTable[MAX_PLY][MAX_PLY]; /*!< The principal variation from each ply. */
+	int pvLength[MAX_PLY]; /*!< The length of the principal variation at each ply. */
+	ChessMove rootBestMove; /*!< The best root move found in the current iteration. */
+
+	uint64_t nodes; /*!< Positions searched so far. */
+	uint64_t nodeLimit; /*!< The most nodes to search, or 0 for no limit. */
+	bool timeLimited; /*!< Whether the search has a deadline. */
+	bool stopped; /*!< Set when a limit is reached, unwinding the search. */
+	std::chrono::steady_clock::time_point deadline; /*!< When the search must stop. */
+
+	const std::atomic<bool>* stopSignal; /*!< Set by another thread to stop the search, or null. */
+	int helperIndex; /*!< 0 for a search on its own or the main thread of a parallel search, 1 and up for helpers. */
+
+	/*!
+	* @brief Check if a helper thread should skip an iteration, so helpers spread over different depths.
+	* @param depth The depth of the iteration.
+	* @return True if the iteration should be skipped.
+	*/
+	bool skipIteration(int depth) const;
+
+	/*!
+	* @brief Stop the search if the time or node limit has been reached, or another thread has asked it to stop.
+	*/
+	void checkLimits();
+
+	/*!
+	* @brief Give each move a score for ordering.
+	* @param board The position.
+	* @param list The moves.
+	* @param scores Set to the score of each move.
+	* @param ttMove The move from the transposition table, tried first.
+	* @param ply The distance from the root, for the killer moves.
+	*/
+	void scoreMoves(const ChessBoard& board, const ChessMoveList& list, int* scores, ChessMove ttMove, int ply) const;
+
+	/*!
+	* @brief The principal variation search.
+	* @param board The position, which is left as it was found.
+	* @param depth The depth left to search.
+	* @param alpha The lower bound of the window.
+	* @param beta The upper bound of the window.
+	* @param ply The distance from the root.
+	* @param allowNull Whether a null move may be tried, so two are never made in a row.
+	* @return The score from the side to move's point of view.
+	*/
+	int searchNode(ChessBoard& board, int depth, int alpha, int beta, int ply, bool allowNull);
+
+	/*!
+	* @brief Search captures and promotions until the position is quiet.
+	* @param board The position, which is left as it was found.
+	* @param alpha The lower bound of the window.
+	* @param beta The upper bound of the window.
+	* @param ply The distance from the root.
+	* @return The score from the side to move's point of view.
+	*/
+	int quiescence(ChessBoard& board, int alpha, int beta, int ply);
+
+public:
+	/*!
+	* @brief Constructor for ChessAI.
+	* @param table The transposition table to use, which must outlive the AI.
+	*/
+	explicit ChessAI(TranspositionTable& table);
+
+	/*!
+	* @brief Forget the killer moves and history, for example before a new game.
+	*/
+	void clearHistory();
+
+	/*!
+	* @brief Make this search one thread of a parallel search.
+	* @param signal A flag another thread sets to stop the search, or null.
+	* @param index 0 for the main thread, which ages the transposition table, or 1 and up for helpers.
+	*/
+	void setParallel(const std::atomic<bool>* signal, int index);
+
+	/*!
+	* @brief Search for the best move.
+	* @param board The position, which is left as it was found.
+	* @param limits When to stop.
+	* @return The best move and what the search found.
+	*/
+	SearchResult search(ChessBoard& board, const SearchLimits& limits);
+
+	/*!
+	* @brief Evaluate a position with material and piece-square tables, tapering the king's table into the endgame.
+	* @param board The position.
+	* @return The score from the side to move's point of view, in centipawns.
+	*/
+	static int evaluate(const ChessBoard& board);
+
+	/*!
+	* @brief Run an EPD test suite, searching each position and checking the move against its bm and am operations.
+	* @details Lines are four FEN fields followed by operations such as: bm Nf3; am Qxb2; id "test 1";
+	* @details Blank lines and lines starting with '#' are skipped.
+	* @param input The EPD lines.
+	* @param limits The limits for each position.
+	* @return The solve rate, node count and time.
+	*/
+	EpdResult runEpdSuite(std::istream& input, const SearchLimits& limits);
+
+	/*!
+	* @brief Run an EPD test suite from a file.
+	* @param filename The file to read.
+	* @param limits The limits for each position.
+	* @return The solve rate, node count and time.
+	* @throws runtime_error if the file cannot be opened.
+	*/
+	EpdResult runEpdFile(const std::string& filename, const SearchLimits& limits);
+};
+
+/*!
+* @struct SmpTiming
+* @brief How long a parallel search took to reach a depth.
+*/
+struct SmpTiming {
+	int threads = 0; /*!< The number of threads searching. */
+	int depth = 0; /*!< The depth reached. */
+	uint64_t nodes = 0; /*!< The positions searched by all threads together. */
+	double seconds = 0.0; /*!< The time taken. */
+};
+
+/*!
+* @class LazySmpSearch
+* @brief Searches with several threads at once, all sharing one transposition table (Lazy SMP).
+* @details Every thread searches the whole tree from the root. The helpers skip iterations in staggered patterns so they
+* @details run ahead at different depths, and what they store in the shared table speeds up the main thread.
+* @details The main thread keeps the time and node limits and stops the helpers when it finishes.
+* @details With one thread no other threads are started, so the search is deterministic.
+*/
+class LazySmpSearch {
+private:
+	TranspositionTable& table; /*!< The table shared by every thread. */
+	std::vector<std::unique_ptr<ChessAI>> searchers; /*!< One search per thread; the first is the main thread. */
+	std::atomic<bool> stopSignal; /*!< Set when the main thread finishes, to stop the helpers. */
+	const OpeningBook* book; /*!< The opening book, or null to always search. */
+
+public:
+	/*!
+	* @brief Constructor for LazySmpSearch.
+	* @param table The transposition table to share, which must outlive the search.
+	* @param threads The number of threads to search with.
+	*/
+	LazySmpSearch(TranspositionTable& table, int threads = 1);
+
+	/*!
+	* @brief Change the number of threads, which also forgets every thread's history.
+	* @param threads The number of threads, at least 1.
+	*/
+	void setThreadCount(int threads);
+
+	/*!
+	* @brief Get the number of threads.
+	* @return The number of threads.
+	*/
+	int getThreadCount() const;
+
+	/*!
+	* @brief Forget the killer moves and history of every thread.
+	*/
+	void clearHistory();
+
+	/*!
+	* @brief Set the opening book to play from before searching.
+	* @param openingBook The book, which must outlive the search, or null for none.
+	*/
+	void setOpeningBook(const OpeningBook* openingBook);
+
+	/*!
+	* @brief Search for the best move with every thread, or play a book move if the position is in the opening book.
+	* @param board The position.
+	* @param limits When to stop, applied to the main thread.
+	* @return The result of the thread that completed the deepest iteration, with the nodes of all threads.
+	*/
+	SearchResult search(const ChessBoard& board, const SearchLimits& limits);
+
+	/*!
+	* @brief Measure the time and nodes taken to reach a depth, starting from an empty table.
+	* @param board The position.
+	* @param depth The depth to search to.
+	* @return The time to depth and total node count.
+	*/
+	SmpTiming timeToDepth(const ChessBoard& board, int depth);
+};
+
+#endif // CHESS_AI_H
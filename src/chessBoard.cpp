@@ -0,0 +1,1176 @@
+
+#include "chessBoard.h"
+#include <mutex>
+#include <charconv>
+#include <stdexcept>
+#include <cctype>
+
+#if defined(_MSC_VER) && defined(_WIN64)
+#include <intrin.h>
+#endif
+
+
+// Attack tables, built once by initialiseTables
+static uint64_t knightTable[64];
+static uint64_t kingTable[64];
+static uint64_t pawnTable[2][64];
+static uint64_t betweenTable[64][64];
+static uint64_t lineTable[64][64];
+
+// Magic bitboard tables for the sliding pieces
+static uint64_t rookMasks[64];
+static uint64_t bishopMasks[64];
+static uint64_t rookMagics[64];
+static uint64_t bishopMagics[64];
+static int rookShifts[64];
+static int bishopShifts[64];
+static uint64_t* rookAttackTable[64];
+static uint64_t* bishopAttackTable[64];
+static uint64_t rookAttackStore[102400];
+static uint64_t bishopAttackStore[5248];
+
+// Castling rights kept when a piece moves from or to each square
+static int castlingMask[64];
+
+// Zobrist keys for each piece on each square, the castling rights, the en passant file and black to move
+static uint64_t zobristPieces[12][64];
+static uint64_t zobristCastling[16];
+static uint64_t zobristEnPassant[8];
+static uint64_t zobristSide;
+
+static std::once_flag tablesBuilt;
+
+
+// Index of the least significant set bit
+static inline int lowestBit(uint64_t bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, bitboard);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(bitboard);
+#else
+    static const int debruijn[64] = {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    return debruijn[((bitboard & (0 - bitboard)) * 0x03f79d71b4cb0a89ULL) >> 58];
+#endif
+}
+
+// Removes and returns the least significant set bit
+static inline int popLowestBit(uint64_t& bitboard) {
+    int index = lowestBit(bitboard);
+    bitboard &= bitboard - 1;
+    return index;
+}
+
+// Number of set bits
+static inline int countBits(uint64_t bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+    return static_cast<int>(__popcnt64(bitboard));
+#elif defined(__GNUC__)
+    return __builtin_popcountll(bitboard);
+#else
+    int count = 0;
+    while (bitboard) {
+        bitboard &= bitboard - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Walks the given directions from a square, stopping at the first occupied square in each
+static uint64_t slidingAttacks(int square, uint64_t occupancy, const int directions[4][2]) {
+    uint64_t attacks = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int rank = square / 8 + directions[i][0];
+        int file = square % 8 + directions[i][1];
+
+        while (rank >= 0 && rank < 8 && file >= 0 && file < 8) {
+            uint64_t bit = uint64_t(1) << (rank * 8 + file);
+            attacks |= bit;
+
+            if (occupancy & bit) {
+                break;
+            }
+
+            rank += directions[i][0];
+            file += directions[i][1];
+        }
+    }
+
+    return attacks;
+}
+
+static const int ROOK_DIRECTIONS[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+static const int BISHOP_DIRECTIONS[4][2] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+// The squares whose occupancy matters to a slider: its empty board attacks without the board edges it runs into
+static uint64_t relevantMask(int square, const int directions[4][2]) {
+    uint64_t mask = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int rank = square / 8 + directions[i][0];
+        int file = square % 8 + directions[i][1];
+
+        while (rank + directions[i][0] >= 0 && rank + directions[i][0] < 8 &&
+            file + directions[i][1] >= 0 && file + directions[i][1] < 8) {
+            mask |= uint64_t(1) << (rank * 8 + file);
+            rank += directions[i][0];
+            file += directions[i][1];
+        }
+    }
+
+    return mask;
+}
+
+// xorshift64* random numbers, for the magic search and the Zobrist keys
+static uint64_t nextRandom(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+// Searches for a magic number that maps every occupancy of the mask to a distinct slot (or one with the same attacks)
+static void findMagic(int square, const int directions[4][2], uint64_t mask, uint64_t*& table, uint64_t* store, size_t& used,
+    uint64_t& magic, int& shift, uint64_t& randomState) {
+    uint64_t occupancies[4096];
+    uint64_t references[4096];
+    int epoch[4096] = {};
+    int size = 0;
+
+    // Enumerate every subset of the mask with the carry-rippler trick
+    uint64_t subset = 0;
+    do {
+        occupancies[size] = subset;
+        references[size] = slidingAttacks(square, subset, directions);
+        size++;
+        subset = (subset - mask) & mask;
+    } while (subset);
+
+    int bits = countBits(mask);
+    shift = 64 - bits;
+    table = store + used;
+    used += size_t(1) << bits;
+
+    // Random numbers with few bits set make good candidates
+    for (int attempt = 1; ; attempt++) {
+        do {
+            magic = nextRandom(randomState) & nextRandom(randomState) & nextRandom(randomState);
+        } while (countBits((mask * magic) >> 56) < 6);
+
+        bool failed = false;
+        for (int i = 0; i < size && !failed; i++) {
+            size_t index = static_cast<size_t>((occupancies[i] * magic) >> shift);
+
+            if (epoch[index] < attempt) {
+                epoch[index] = attempt;
+                table[index] = references[i];
+            }
+            else if (table[index] != references[i]) {
+                failed = true;
+            }
+        }
+
+        if (!failed) {
+            return;
+        }
+    }
+}
+
+// Builds the lookup tables the first time they are needed
+static void buildTables() {
+    const int knightSteps[8][2] = { {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2} };
+    const int kingSteps[8][2] = { {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1} };
+
+    for (int square = 0; square < 64; square++) {
+        int rank = square / 8;
+        int file = square % 8;
+
+        knightTable[square] = 0;
+        kingTable[square] = 0;
+        for (int i = 0; i < 8; i++) {
+            int r = rank + knightSteps[i][0], f = file + knightSteps[i][1];
+            if (r >= 0 && r < 8 && f >= 0 && f < 8) {
+                knightTable[square] |= uint64_t(1) << (r * 8 + f);
+            }
+
+            r = rank + kingSteps[i][0];
+            f = file + kingSteps[i][1];
+            if (r >= 0 && r < 8 && f >= 0 && f < 8) {
+                kingTable[square] |= uint64_t(1) << (r * 8 + f);
+            }
+        }
+
+        pawnTable[ChessBoard::WHITE][square] = 0;
+        pawnTable[ChessBoard::BLACK][square] = 0;
+        if (rank < 7) {
+            if (file > 0) pawnTable[ChessBoard::WHITE][square] |= uint64_t(1) << (square + 7);
+            if (file < 7) pawnTable[ChessBoard::WHITE][square] |= uint64_t(1) << (square + 9);
+        }
+        if (rank > 0) {
+            if (file > 0) pawnTable[ChessBoard::BLACK][square] |= uint64_t(1) << (square - 9);
+            if (file < 7) pawnTable[ChessBoard::BLACK][square] |= uint64_t(1) << (square - 7);
+        }
+
+        castlingMask[square] = 15;
+    }
+
+    castlingMask[0] &= ~ChessBoard::WHITE_QUEENSIDE;
+    castlingMask[7] &= ~ChessBoard::WHITE_KINGSIDE;
+    castlingMask[4] &= ~(ChessBoard::WHITE_KINGSIDE | ChessBoard::WHITE_QUEENSIDE);
+    castlingMask[56] &= ~ChessBoard::BLACK_QUEENSIDE;
+    castlingMask[63] &= ~ChessBoard::BLACK_KINGSIDE;
+    castlingMask[60] &= ~(ChessBoard::BLACK_KINGSIDE | ChessBoard::BLACK_QUEENSIDE);
+
+    // Fixed seed so the tables are the same on every run
+    uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+    size_t rookUsed = 0, bishopUsed = 0;
+
+    for (int square = 0; square < 64; square++) {
+        rookMasks[square] = relevantMask(square, ROOK_DIRECTIONS);
+        bishopMasks[square] = relevantMask(square, BISHOP_DIRECTIONS);
+        findMagic(square, ROOK_DIRECTIONS, rookMasks[square], rookAttackTable[square], rookAttackStore, rookUsed,
+            rookMagics[square], rookShifts[square], randomState);
+        findMagic(square, BISHOP_DIRECTIONS, bishopMasks[square], bishopAttackTable[square], bishopAttackStore, bishopUsed,
+            bishopMagics[square], bishopShifts[square], randomState);
+    }
+
+    // Zobrist keys, from their own fixed seed so they do not depend on the magic search
+    uint64_t zobristState = 0x2545F4914F6CDD1DULL;
+    for (int piece = 0; piece < 12; piece++) {
+        for (int square = 0; square < 64; square++) {
+            zobristPieces[piece][square] = nextRandom(zobristState);
+        }
+    }
+    for (int rights = 0; rights < 16; rights++) {
+        zobristCastling[rights] = nextRandom(zobristState);
+    }
+    for (int file = 0; file < 8; file++) {
+        zobristEnPassant[file] = nextRandom(zobristState);
+    }
+    zobristSide = nextRandom(zobristState);
+
+    // Squares between and lines through every aligned pair of squares
+    for (int a = 0; a < 64; a++) {
+        for (int b = 0; b < 64; b++) {
+            betweenTable[a][b] = 0;
+            lineTable[a][b] = 0;
+
+            if (a == b) {
+                continue;
+            }
+
+            uint64_t bitA = uint64_t(1) << a;
+            uint64_t bitB = uint64_t(1) << b;
+
+            if (ChessBoard::rookAttacks(a, 0) & bitB) {
+                betweenTable[a][b] = ChessBoard::rookAttacks(a, bitB) & ChessBoard::rookAttacks(b, bitA);
+                lineTable[a][b] = (ChessBoard::rookAttacks(a, 0) & ChessBoard::rookAttacks(b, 0)) | bitA | bitB;
+            }
+            else if (ChessBoard::bishopAttacks(a, 0) & bitB) {
+                betweenTable[a][b] = ChessBoard::bishopAttacks(a, bitB) & ChessBoard::bishopAttacks(b, bitA);
+                lineTable[a][b] = (ChessBoard::bishopAttacks(a, 0) & ChessBoard::bishopAttacks(b, 0)) | bitA | bitB;
+            }
+        }
+    }
+}
+
+
+// Builds the attack tables once, however many boards are created
+void ChessBoard::initialiseTables() {
+    std::call_once(tablesBuilt, buildTables);
+}
+
+
+// Rook attacks through the magic lookup
+uint64_t ChessBoard::rookAttacks(int square, uint64_t occupancy) {
+    return rookAttackTable[square][((occupancy & rookMasks[square]) * rookMagics[square]) >> rookShifts[square]];
+}
+
+
+// Bishop attacks through the magic lookup
+uint64_t ChessBoard::bishopAttacks(int square, uint64_t occupancy) {
+    return bishopAttackTable[square][((occupancy & bishopMasks[square]) * bishopMagics[square]) >> bishopShifts[square]];
+}
+
+
+// Knight attacks
+uint64_t ChessBoard::knightAttacks(int square) {
+    return knightTable[square];
+}
+
+
+// King attacks
+uint64_t ChessBoard::kingAttacks(int square) {
+    return kingTable[square];
+}
+
+
+// Pawn attacks
+uint64_t ChessBoard::pawnAttacks(int side, int square) {
+    return pawnTable[side][square];
+}
+
+
+// Constructor for the ChessBoard class
+ChessBoard::ChessBoard() {
+    initialiseTables();
+    history.reserve(256);
+    setStartPosition();
+}
+
+
+// Puts a piece on an empty square
+void ChessBoard::putPiece(int piece, int square) {
+    uint64_t bit = uint64_t(1) << square;
+    int side = piece / 6;
+
+    pieces[side][piece % 6] |= bit;
+    colours[side] |= bit;
+    occupied |= bit;
+    mailbox[square] = static_cast<int8_t>(piece);
+    hash ^= zobristPieces[piece][square];
+}
+
+
+// Removes the piece on a square
+void ChessBoard::removePiece(int square) {
+    uint64_t bit = uint64_t(1) << square;
+    int piece = mailbox[square];
+    int side = piece / 6;
+
+    pieces[side][piece % 6] ^= bit;
+    colours[side] ^= bit;
+    occupied ^= bit;
+    mailbox[square] = -1;
+    hash ^= zobristPieces[piece][square];
+}
+
+
+// Moves a piece to an empty square
+void ChessBoard::movePiece(int from, int to) {
+    uint64_t bits = (uint64_t(1) << from) | (uint64_t(1) << to);
+    int piece = mailbox[from];
+    int side = piece / 6;
+
+    pieces[side][piece % 6] ^= bits;
+    colours[side] ^= bits;
+    occupied ^= bits;
+    mailbox[to] = mailbox[from];
+    mailbox[from] = -1;
+    hash ^= zobristPieces[piece][from] ^ zobristPieces[piece][to];
+}
+
+
+// Sets up the standard starting position
+void ChessBoard::setStartPosition() {
+    setFen(START_FEN);
+}
+
+
+// Splits the next space separated field off the front of some text
+static std::string_view nextField(std::string_view& text) {
+    size_t start = text.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        text = std::string_view();
+        return text;
+    }
+
+    size_t end = text.find(' ', start);
+    if (end == std::string_view::npos) {
+        end = text.size();
+    }
+
+    std::string_view field = text.substr(start, end - start);
+    text.remove_prefix(end);
+    return field;
+}
+
+
+// Reads a move counter from a FEN field, or returns the default if there is none
+static int parseCounter(std::string_view field, int defaultValue) {
+    int value = 0;
+    if (field.empty() || std::from_chars(field.data(), field.data() + field.size(), value).ec != std::errc()) {
+        return defaultValue;
+    }
+    return value;
+}
+
+
+// Sets up a position from FEN
+void ChessBoard::setFen(std::string_view fen) {
+    std::string_view rest = fen;
+    std::string_view placement = nextField(rest);
+    std::string_view side = nextField(rest);
+    std::string_view castling = nextField(rest);
+    std::string_view enPassant = nextField(rest);
+    int halfmove = parseCounter(nextField(rest), 0);
+    int fullmove = parseCounter(nextField(rest), 1);
+
+    if (placement.empty() || side.empty()) {
+        throw std::runtime_error("Invalid FEN: " + std::string(fen));
+    }
+
+    for (int s = 0; s < 2; s++) {
+        for (int t = 0; t < 6; t++) {
+            pieces[s][t] = 0;
+        }
+        colours[s] = 0;
+    }
+    occupied = 0;
+    hash = 0;
+    for (int square = 0; square < 64; square++) {
+        mailbox[square] = -1;
+    }
+
+    const std::string pieceLetters = "PNBRQKpnbrqk";
+    int rank = 7, file = 0;
+
+    for (char c : placement) {
+        if (c == '/') {
+            rank--;
+            file = 0;
+        }
+        else if (c >= '1' && c <= '8') {
+            file += c - '0';
+        }
+        else {
+            size_t index = pieceLetters.find(c);
+            if (index == std::string::npos || rank < 0 || file > 7) {
+                throw std::runtime_error("Invalid FEN: " + std::string(fen));
+            }
+            putPiece(static_cast<int>(index), rank * 8 + file);
+            file++;
+        }
+    }
+
+    if (countBits(pieces[WHITE][KING]) != 1 || countBits(pieces[BLACK][KING]) != 1) {
+        throw std::runtime_error("Invalid FEN, each side needs one king: " + std::string(fen));
+    }
+
+    sideToMove = (side == "b") ? BLACK : WHITE;
+
+    castlingRights = 0;
+    for (char c : castling) {
+        if (c == 'K') castlingRights |= WHITE_KINGSIDE;
+        else if (c == 'Q') castlingRights |= WHITE_QUEENSIDE;
+        else if (c == 'k') castlingRights |= BLACK_KINGSIDE;
+        else if (c == 'q') castlingRights |= BLACK_QUEENSIDE;
+    }
+
+    enPassantSquare = NO_SQUARE;
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' && enPassant[1] >= '1' && enPassant[1] <= '8') {
+        enPassantSquare = (enPassant[1] - '1') * 8 + (enPassant[0] - 'a');
+    }
+
+    halfmoveClock = halfmove;
+    fullmoveNumber = fullmove;
+    history.clear();
+    hash = computeHash();
+}
+
+
+// Gets the position as FEN
+std::string ChessBoard::getFen() const {
+    const std::string pieceLetters = "PNBRQKpnbrqk";
+    std::string fen;
+
+    for (int rank = 7; rank >= 0; rank--) {
+        int empty = 0;
+        for (int file = 0; file < 8; file++) {
+            int piece = mailbox[rank * 8 + file];
+            if (piece < 0) {
+                empty++;
+                continue;
+            }
+            if (empty) {
+                fen += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            fen += pieceLetters[piece];
+        }
+        if (empty) {
+            fen += static_cast<char>('0' + empty);
+        }
+        if (rank > 0) {
+            fen += '/';
+        }
+    }
+
+    fen += (sideToMove == WHITE) ? " w " : " b ";
+
+    if (castlingRights == 0) {
+        fen += '-';
+    }
+    else {
+        if (castlingRights & WHITE_KINGSIDE) fen += 'K';
+        if (castlingRights & WHITE_QUEENSIDE) fen += 'Q';
+        if (castlingRights & BLACK_KINGSIDE) fen += 'k';
+        if (castlingRights & BLACK_QUEENSIDE) fen += 'q';
+    }
+
+    fen += ' ';
+    fen += (enPassantSquare == NO_SQUARE) ? "-" : squareToString(enPassantSquare);
+    fen += " " + std::to_string(halfmoveClock) + " " + std::to_string(fullmoveNumber);
+
+    return fen;
+}
+
+
+// Gets every piece attacking a square
+uint64_t ChessBoard::attackersTo(int square, uint64_t occupancy) const {
+    return (pawnTable[WHITE][square] & pieces[BLACK][PAWN]) |
+        (pawnTable[BLACK][square] & pieces[WHITE][PAWN]) |
+        (knightTable[square] & (pieces[WHITE][KNIGHT] | pieces[BLACK][KNIGHT])) |
+        (kingTable[square] & (pieces[WHITE][KING] | pieces[BLACK][KING])) |
+        (bishopAttacks(square, occupancy) & (pieces[WHITE][BISHOP] | pieces[BLACK][BISHOP] | pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN])) |
+        (rookAttacks(square, occupancy) & (pieces[WHITE][ROOK] | pieces[BLACK][ROOK] | pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN]));
+}
+
+
+// Gets all squares attacked by one side
+uint64_t ChessBoard::attackedSquares(int side, uint64_t occupancy) const {
+    uint64_t pawns = pieces[side][PAWN];
+    const uint64_t notFileA = 0xFEFEFEFEFEFEFEFEULL;
+    const uint64_t notFileH = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t attacks;
+
+    if (side == WHITE) {
+        attacks = ((pawns & notFileH) << 9) | ((pawns & notFileA) << 7);
+    }
+    else {
+        attacks = ((pawns & notFileA) >> 9) | ((pawns & notFileH) >> 7);
+    }
+
+    uint64_t bitboard = pieces[side][KNIGHT];
+    while (bitboard) {
+        attacks |= knightTable[popLowestBit(bitboard)];
+    }
+
+    bitboard = pieces[side][BISHOP] | pieces[side][QUEEN];
+    while (bitboard) {
+        attacks |= bishopAttacks(popLowestBit(bitboard), occupancy);
+    }
+
+    bitboard = pieces[side][ROOK] | pieces[side][QUEEN];
+    while (bitboard) {
+        attacks |= rookAttacks(popLowestBit(bitboard), occupancy);
+    }
+
+    attacks |= kingTable[lowestBit(pieces[side][KING])];
+
+    return attacks;
+}
+
+
+// Checks if the side to move is in check
+bool ChessBoard::isInCheck() const {
+    int king = lowestBit(pieces[sideToMove][KING]);
+    return (attackersTo(king, occupied) & colours[sideToMove ^ 1]) != 0;
+}
+
+
+// Checks an en passant capture does not expose the king, which the pin masks cannot see
+bool ChessBoard::isEnPassantLegal(int from, int to) const {
+    int us = sideToMove;
+    int them = us ^ 1;
+    int king = lowestBit(pieces[us][KING]);
+    int capturedSquare = to ^ 8;
+
+    uint64_t occupancy = (occupied ^ (uint64_t(1) << from) ^ (uint64_t(1) << capturedSquare)) | (uint64_t(1) << to);
+    uint64_t theirPawns = pieces[them][PAWN] & ~(uint64_t(1) << capturedSquare);
+
+    return !((bishopAttacks(king, occupancy) & (pieces[them][BISHOP] | pieces[them][QUEEN])) ||
+        (rookAttacks(king, occupancy) & (pieces[them][ROOK] | pieces[them][QUEEN])) ||
+        (knightTable[king] & pieces[them][KNIGHT]) ||
+        (pawnTable[us][king] & theirPawns));
+}
+
+
+// Adds a pawn move, or the four promotions when the pawn reaches the last rank
+void ChessBoard::addPawnMove(ChessMoveList& list, int from, int to, bool capture) {
+    if (to >= 56 || to < 8) {
+        int flags = capture ? ChessMove::PROMOTION_CAPTURE : ChessMove::PROMOTION;
+        list.add(ChessMove(from, to, flags + 3));
+        list.add(ChessMove(from, to, flags + 0));
+        list.add(ChessMove(from, to, flags + 2));
+        list.add(ChessMove(from, to, flags + 1));
+    }
+    else {
+        list.add(ChessMove(from, to, capture ? ChessMove::CAPTURE : ChessMove::QUIET));
+    }
+}
+
+
+// Generates every legal move
+void ChessBoard::generateLegalMoves(ChessMoveList& list) const {
+    list.count = 0;
+
+    int us = sideToMove;
+    int them = us ^ 1;
+    uint64_t ours = colours[us];
+    uint64_t theirs = colours[them];
+    int king = lowestBit(pieces[us][KING]);
+
+    // The king may not move onto an attacked square, looking through itself for sliders
+    uint64_t danger = attackedSquares(them, occupied ^ pieces[us][KING]);
+    uint64_t targets = kingTable[king] & ~ours & ~danger;
+    while (targets) {
+        int to = popLowestBit(targets);
+        list.add(ChessMove(king, to, (theirs >> to) & 1 ? ChessMove::CAPTURE : ChessMove::QUIET));
+    }
+
+    uint64_t checkers = attackersTo(king, occupied) & theirs;
+    int checkCount = countBits(checkers);
+
+    // In double check only the king can move
+    if (checkCount > 1) {
+        return;
+    }
+
+    // In check, other pieces must capture the checker or block it
+    uint64_t checkMask = ~uint64_t(0);
+    if (checkCount == 1) {
+        int checker = lowestBit(checkers);
+        checkMask = betweenTable[king][checker] | checkers;
+    }
+
+    // Find our pieces pinned against the king
+    uint64_t pinned = 0;
+    uint64_t snipers = (rookAttacks(king, theirs) & (pieces[them][ROOK] | pieces[them][QUEEN])) |
+        (bishopAttacks(king, theirs) & (pieces[them][BISHOP] | pieces[them][QUEEN]));
+    while (snipers) {
+        int sniper = popLowestBit(snipers);
+        uint64_t blockers = betweenTable[king][sniper] & occupied;
+        if (blockers && !(blockers & (blockers - 1)) && (blockers & ours)) {
+            pinned |= blockers;
+        }
+    }
+
+    uint64_t available = ~ours & checkMask;
+
+    // Knights cannot move at all when pinned
+    uint64_t bitboard = pieces[us][KNIGHT] & ~pinned;
+    while (bitboard) {
+        int from = popLowestBit(bitboard);
+        targets = knightTable[from] & available;
+        while (targets) {
+            int to = popLowestBit(targets);
+            list.add(ChessMove(from, to, (theirs >> to) & 1 ? ChessMove::CAPTURE : ChessMove::QUIET));
+        }
+    }
+
+    // Sliding pieces, kept on the pin line when pinned
+    bitboard = pieces[us][BISHOP] | pieces[us][QUEEN];
+    while (bitboard) {
+        int from = popLowestBit(bitboard);
+        targets = bishopAttacks(from, occupied) & available;
+        if ((pinned >> from) & 1) {
+            targets &= lineTable[king][from];
+        }
+        while (targets) {
+            int to = popLowestBit(targets);
+            list.add(ChessMove(from, to, (theirs >> to) & 1 ? ChessMove::CAPTURE : ChessMove::QUIET));
+        }
+    }
+
+    bitboard = pieces[us][ROOK] | pieces[us][QUEEN];
+    while (bitboard) {
+        int from = popLowestBit(bitboard);
+        targets = rookAttacks(from, occupied) & available;
+        if ((pinned >> from) & 1) {
+            targets &= lineTable[king][from];
+        }
+        while (targets) {
+            int to = popLowestBit(targets);
+            list.add(ChessMove(from, to, (theirs >> to) & 1 ? ChessMove::CAPTURE : ChessMove::QUIET));
+        }
+    }
+
+    // Pawns
+    int forward = (us == WHITE) ? 8 : -8;
+    int startRank = (us == WHITE) ? 1 : 6;
+    bitboard = pieces[us][PAWN];
+    while (bitboard) {
+        int from = popLowestBit(bitboard);
+        uint64_t allowed = checkMask;
+        if ((pinned >> from) & 1) {
+            allowed &= lineTable[king][from];
+        }
+
+        int to = from + forward;
+        if (!((occupied >> to) & 1)) {
+            if ((allowed >> to) & 1) {
+                addPawnMove(list, from, to, false);
+            }
+
+            int doubleTo = to + forward;
+            if (from / 8 == startRank && !((occupied >> doubleTo) & 1) && ((allowed >> doubleTo) & 1)) {
+                list.add(ChessMove(from, doubleTo, ChessMove::DOUBLE_PUSH));
+            }
+        }
+
+        targets = pawnTable[us][from] & theirs & allowed;
+        while (targets) {
+            addPawnMove(list, from, popLowestBit(targets), true);
+        }
+
+        if (enPassantSquare != NO_SQUARE && ((pawnTable[us][from] >> enPassantSquare) & 1) && isEnPassantLegal(from, enPassantSquare)) {
+            list.add(ChessMove(from, enPassantSquare, ChessMove::EN_PASSANT));
+        }
+    }
+
+    // Castling, only when not in check and the king does not pass through an attacked square
+    if (checkCount == 0) {
+        int kingsideRight = (us == WHITE) ? WHITE_KINGSIDE : BLACK_KINGSIDE;
+        int queensideRight = (us == WHITE) ? WHITE_QUEENSIDE : BLACK_QUEENSIDE;
+        int base = (us == WHITE) ? 0 : 56;
+
+        uint64_t kingsidePath = uint64_t(0x60) << base;
+        if ((castlingRights & kingsideRight) && !(occupied & kingsidePath) && !(danger & kingsidePath)) {
+            list.add(ChessMove(base + 4, base + 6, ChessMove::KING_CASTLE));
+        }
+
+        uint64_t queensideEmpty = uint64_t(0x0E) << base;
+        uint64_t queensideSafe = uint64_t(0x0C) << base;
+        if ((castlingRights & queensideRight) && !(occupied & queensideEmpty) && !(danger & queensideSafe)) {
+            list.add(ChessMove(base + 4, base + 2, ChessMove::QUEEN_CASTLE));
+        }
+    }
+}
+
+
+// Makes a move
+void ChessBoard::makeMove(ChessMove move) {
+    UndoState state;
+    state.move = move;
+    state.captured = -1;
+    state.castlingRights = static_cast<uint8_t>(castlingRights);
+    state.enPassantSquare = static_cast<int8_t>(enPassantSquare);
+    state.halfmoveClock = halfmoveClock;
+    state.hash = hash;
+
+    int from = move.from();
+    int to = move.to();
+    int flags = move.flags();
+    int piece = mailbox[from];
+
+    if (enPassantSquare != NO_SQUARE) {
+        hash ^= zobristEnPassant[enPassantSquare % 8];
+    }
+    enPassantSquare = NO_SQUARE;
+    halfmoveClock++;
+
+    if (flags == ChessMove::EN_PASSANT) {
+        int capturedSquare = to ^ 8;
+        state.captured = mailbox[capturedSquare];
+        removePiece(capturedSquare);
+    }
+    else if (move.isCapture()) {
+        state.captured = mailbox[to];
+        removePiece(to);
+    }
+
+    if (move.isPromotion()) {
+        removePiece(from);
+        putPiece(sideToMove * 6 + move.promotionPiece(), to);
+    }
+    else {
+        movePiece(from, to);
+    }
+
+    if (flags == ChessMove::KING_CASTLE) {
+        movePiece(to + 1, to - 1);
+    }
+    else if (flags == ChessMove::QUEEN_CASTLE) {
+        movePiece(to - 2, to + 1);
+    }
+    else if (flags == ChessMove::DOUBLE_PUSH) {
+        enPassantSquare = (from + to) / 2;
+        hash ^= zobristEnPassant[enPassantSquare % 8];
+    }
+
+    if (piece % 6 == PAWN || state.captured >= 0) {
+        halfmoveClock = 0;
+    }
+
+    hash ^= zobristCastling[castlingRights];
+    castlingRights &= castlingMask[from] & castlingMask[to];
+    hash ^= zobristCastling[castlingRights];
+
+    if (sideToMove == BLACK) {
+        fullmoveNumber++;
+    }
+    sideToMove ^= 1;
+    hash ^= zobristSide;
+
+    history.push_back(state);
+}
+
+
+// Passes the move, for null move pruning
+void ChessBoard::makeNullMove() {
+    UndoState state;
+    state.move = ChessMove();
+    state.captured = -1;
+    state.castlingRights = static_cast<uint8_t>(castlingRights);
+    state.enPassantSquare = static_cast<int8_t>(enPassantSquare);
+    state.halfmoveClock = halfmoveClock;
+    state.hash = hash;
+
+    if (enPassantSquare != NO_SQUARE) {
+        hash ^= zobristEnPassant[enPassantSquare % 8];
+        enPassantSquare = NO_SQUARE;
+    }
+
+    halfmoveClock++;
+    if (sideToMove == BLACK) {
+        fullmoveNumber++;
+    }
+    sideToMove ^= 1;
+    hash ^= zobristSide;
+
+    history.push_back(state);
+}
+
+
+// Takes back the last move
+void ChessBoard::unmakeMove() {
+    const UndoState& state = history.back();
+    ChessMove move = state.move;
+
+    int from = move.from();
+    int to = move.to();
+    int flags = move.flags();
+
+    sideToMove ^= 1;
+    if (sideToMove == BLACK) {
+        fullmoveNumber--;
+    }
+
+    // A null move only changed the side to move and the en passant square
+    if (move.isNull()) {
+        enPassantSquare = state.enPassantSquare;
+        halfmoveClock = state.halfmoveClock;
+        hash = state.hash;
+        history.pop_back();
+        return;
+    }
+
+    if (flags == ChessMove::KING_CASTLE) {
+        movePiece(to - 1, to + 1);
+    }
+    else if (flags == ChessMove::QUEEN_CASTLE) {
+        movePiece(to + 1, to - 2);
+    }
+
+    if (move.isPromotion()) {
+        removePiece(to);
+        putPiece(sideToMove * 6 + PAWN, from);
+    }
+    else {
+        movePiece(to, from);
+    }
+
+    if (flags == ChessMove::EN_PASSANT) {
+        putPiece(state.captured, to ^ 8);
+    }
+    else if (state.captured >= 0) {
+        putPiece(state.captured, to);
+    }
+
+    castlingRights = state.castlingRights;
+    enPassantSquare = state.enPassantSquare;
+    halfmoveClock = state.halfmoveClock;
+    hash = state.hash;
+
+    history.pop_back();
+}
+
+
+// Counts leaf nodes to a depth, counting the last ply straight from the move list
+uint64_t ChessBoard::perft(int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    ChessMoveList list;
+    generateLegalMoves(list);
+
+    if (depth == 1) {
+        return static_cast<uint64_t>(list.size());
+    }
+
+    uint64_t nodes = 0;
+    for (ChessMove move : list) {
+        makeMove(move);
+        nodes += perft(depth - 1);
+        unmakeMove();
+    }
+
+    return nodes;
+}
+
+
+// Converts a square to its name
+std::string ChessBoard::squareToString(int square) {
+    std::string name;
+    name += static_cast<char>('a' + square % 8);
+    name += static_cast<char>('1' + square / 8);
+    return name;
+}
+
+
+// Converts a move to coordinate notation
+std::string ChessBoard::moveToString(ChessMove move) {
+    if (move.isNull()) {
+        return "0000";
+    }
+
+    std::string text = squareToString(move.from()) + squareToString(move.to());
+    if (move.isPromotion()) {
+        text += "nbrq"[move.promotionPiece() - KNIGHT];
+    }
+    return text;
+}
+
+
+// Finds the legal move matching coordinate notation
+ChessMove ChessBoard::parseMove(const std::string& text) const {
+    std::string lower;
+    for (char c : text) {
+        lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    ChessMoveList list;
+    generateLegalMoves(list);
+
+    for (ChessMove move : list) {
+        if (moveToString(move) == lower) {
+            return move;
+        }
+    }
+
+    return ChessMove();
+}
+
+
+// Calculates the Zobrist key from scratch
+uint64_t ChessBoard::computeHash() const {
+    uint64_t key = 0;
+
+    for (int square = 0; square < 64; square++) {
+        if (mailbox[square] >= 0) {
+            key ^= zobristPieces[mailbox[square]][square];
+        }
+    }
+
+    key ^= zobristCastling[castlingRights];
+    if (enPassantSquare != NO_SQUARE) {
+        key ^= zobristEnPassant[enPassantSquare % 8];
+    }
+    if (sideToMove == BLACK) {
+        key ^= zobristSide;
+    }
+
+    return key;
+}
+
+
+// Checks for a repetition, looking back only as far as the last capture or pawn move
+bool ChessBoard::isRepetition() const {
+    int count = static_cast<int>(history.size());
+    int limit = count - halfmoveClock;
+    if (limit < 0) {
+        limit = 0;
+    }
+
+    // The same side must be to move, and it takes at least four plies to get back to a position
+    for (int i = count - 4; i >= limit; i -= 2) {
+        if (history[i].hash == hash) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Checks if the side to move has a piece other than pawns and the king
+bool ChessBoard::hasNonPawnMaterial() const {
+    return (colours[sideToMove] ^ pieces[sideToMove][PAWN] ^ pieces[sideToMove][KING]) != 0;
+}
+
+
+// Converts a legal move to standard algebraic notation
+std::string ChessBoard::moveToSan(ChessMove move) {
+    const std::string pieceLetters = "PNBRQK";
+    int from = move.from();
+    int to = move.to();
+    int type = mailbox[from] % 6;
+    std::string san;
+
+    if (move.flags() == ChessMove::KING_CASTLE) {
+        san = "O-O";
+    }
+    else if (move.flags() == ChessMove::QUEEN_CASTLE) {
+        san = "O-O-O";
+    }
+    else {
+        if (type == PAWN) {
+            if (move.isCapture()) {
+                san += static_cast<char>('a' + from % 8);
+            }
+        }
+        else {
+            san += pieceLetters[type];
+
+            // Name the file, rank or both when another piece of the same type can reach the square
+            ChessMoveList list;
+            generateLegalMoves(list);
+
+            bool ambiguous = false, sameFile = false, sameRank = false;
+            for (ChessMove other : list) {
+                if (other.to() == to && other.from() != from && mailbox[other.from()] == mailbox[from]) {
+                    ambiguous = true;
+                    sameFile |= (other.from() % 8 == from % 8);
+                    sameRank |= (other.from() / 8 == from / 8);
+                }
+            }
+
+            if (ambiguous) {
+                if (!sameFile) {
+                    san += static_cast<char>('a' + from % 8);
+                }
+                else if (!sameRank) {
+                    san += static_cast<char>('1' + from / 8);
+                }
+                else {
+                    san += squareToString(from);
+                }
+            }
+        }
+
+        if (move.isCapture()) {
+            san += 'x';
+        }
+        san += squareToString(to);
+
+        if (move.isPromotion()) {
+            san += '=';
+            san += pieceLetters[move.promotionPiece()];
+        }
+    }
+
+    makeMove(move);
+    if (isInCheck()) {
+        ChessMoveList replies;
+        generateLegalMoves(replies);
+        san += (replies.size() == 0) ? '#' : '+';
+    }
+    unmakeMove();
+
+    return san;
+}
+
+
+// Finds the legal move matching standard algebraic notation
+ChessMove ChessBoard::parseSan(std::string_view san) const {
+    const std::string_view pieceLetters = "PNBRQK";
+
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+        san.remove_suffix(1);
+    }
+
+    ChessMoveList list;
+    generateLegalMoves(list);
+
+    // Castling
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        int flags = (san.size() == 3) ? ChessMove::KING_CASTLE : ChessMove::QUEEN_CASTLE;
+        for (ChessMove move : list) {
+            if (move.flags() == flags) {
+                return move;
+            }
+        }
+        return ChessMove();
+    }
+
+    int type = PAWN;
+    if (!san.empty() && pieceLetters.find(san[0]) != std::string_view::npos) {
+        type = static_cast<int>(pieceLetters.find(san[0]));
+        san.remove_prefix(1);
+    }
+
+    // A promotion, with or without the '='
+    int promotion = -1;
+    if (type == PAWN && san.size() > 2 && std::string_view("NBRQ").find(san.back()) != std::string_view::npos) {
+        promotion = static_cast<int>(pieceLetters.find(san.back()));
+        san.remove_suffix(1);
+        if (!san.empty() && san.back() == '=') {
+            san.remove_suffix(1);
+        }
+    }
+
+    // What is left is an optional file and rank to tell pieces apart, an optional capture and the square
+    char squares[8];
+    size_t length = 0;
+    for (char c : san) {
+        if (c != 'x' && c != '-' && c != ':') {
+            if (length == sizeof(squares)) {
+                return ChessMove();
+            }
+            squares[length++] = c;
+        }
+    }
+
+    if (length < 2) {
+        return ChessMove();
+    }
+
+    char toFile = squares[length - 2];
+    char toRank = squares[length - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') {
+        return ChessMove();
+    }
+    int to = (toRank - '1') * 8 + (toFile - 'a');
+
+    int fromFile = -1, fromRank = -1;
+    for (size_t i = 0; i + 2 < length; i++) {
+        if (squares[i] >= 'a' && squares[i] <= 'h') {
+            fromFile = squares[i] - 'a';
+        }
+        else if (squares[i] >= '1' && squares[i] <= '8') {
+            fromRank = squares[i] - '1';
+        }
+        else {
+            return ChessMove();
+        }
+    }
+
+    ChessMove found;
+    int matches = 0;
+    for (ChessMove move : list) {
+        if (move.to() != to || mailbox[move.from()] % 6 != type) {
+            continue;
+        }
+        if ((fromFile >= 0 && move.from() % 8 != fromFile) || (fromRank >= 0 && move.from() / 8 != fromRank)) {
+            continue;
+        }
+        if (move.isPromotion() ? (promotion != move.promotionPiece()) : (promotion >= 0)) {
+            continue;
+        }
+
+        found = move;
+        matches++;
+    }
+
+    return (matches == 1) ? found : ChessMove();
+}
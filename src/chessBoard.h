@@ -0,0 +1,468 @@
+#ifndef CHESS_BOARD_H
+#define CHESS_BOARD_H
+
+/*!
+* @file chessBoard.h
+* @brief Contains the declaration of the ChessBoard class, the bitboard core of the chess game.
+* @details Squares are numbered 0 (a1) to 63 (h8), rank by rank, so square = rank * 8 + file.
+*/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+ * @enum PieceType
+ * @brief An enumeration of the different types of chess pieces.
+*/
+enum PieceType {
+	PAWN, /*!< The pawn piece type. */
+	KNIGHT, /*!< The knight piece type. */
+	BISHOP, /*!< The bishop piece type. */
+	ROOK, /*!< The rook piece type. */
+	QUEEN, /*!< The queen piece type. */
+	KING, /*!< The king piece type. */
+	NO_PIECE /*!< No piece, for empty squares. */
+};
+
+/*!
+ * @enum PlayerColour
+ * @brief An enumeration of the different player colors.
+*/
+enum PlayerColour {
+	BLANK_PLAYER, /*!< A blank player color, for empty squares. */
+	WHITE_PLAYER, /*!< The white player color. */
+	BLACK_PLAYER, /*!< The black player color. */
+	RED_PLAYER, /*!< The red player color. */
+	GREEN_PLAYER, /*!< The green player color. */
+	BLUE_PLAYER, /*!< The blue player color. */
+	YELLOW_PLAYER /*!< The yellow player color. */
+};
+
+/*!
+* @struct ChessMove
+* @brief A chess move packed into 16 bits: 6 bits from, 6 bits to and 4 bits of flags.
+* @details The flags follow the usual layout: bit 2 marks a capture and bit 3 a promotion,
+* @details with the low two bits of a promotion giving the piece (knight, bishop, rook, queen).
+*/
+struct ChessMove {
+	static const int QUIET = 0; /*!< A quiet move. */
+	static const int DOUBLE_PUSH = 1; /*!< A pawn moving two squares. */
+	static const int KING_CASTLE = 2; /*!< Castling on the king's side. */
+	static const int QUEEN_CASTLE = 3; /*!< Castling on the queen's side. */
+	static const int CAPTURE = 4; /*!< A capture. */
+	static const int EN_PASSANT = 5; /*!< An en passant capture. */
+	static const int PROMOTION = 8; /*!< A promotion, add 0-3 for the piece. */
+	static const int PROMOTION_CAPTURE = 12; /*!< A promotion with capture, add 0-3 for the piece. */
+
+	uint16_t data; /*!< The packed move, 0 for no move. */
+
+	/*!
+	* @brief Default constructor, creates the null move.
+	*/
+	ChessMove() : data(0) {}
+
+	/*!
+	* @brief Constructor for ChessMove.
+	* @param from The square the piece moves from.
+	* @param to The square the piece moves to.
+	* @param flags The move flags.
+	*/
+	ChessMove(int from, int to, int flags) : data(static_cast<uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+	/*!
+	* @brief Get the square the piece moves from.
+	* @return The from square.
+	*/
+	int from() const { return data & 63; }
+
+	/*!
+	* @brief Get the square the piece moves to.
+	* @return The to square.
+	*/
+	int to() const { return (data >> 6) & 63; }
+
+	/*!
+	* @brief Get the move flags.
+	* @return The flags.
+	*/
+	int flags() const { return data >> 12; }
+
+	/*!
+	* @brief Check if the move captures a piece.
+	* @return True if the move is a capture (including en passant).
+	*/
+	bool isCapture() const { return (flags() & CAPTURE) != 0; }
+
+	/*!
+	* @brief Check if the move promotes a pawn.
+	* @return True if the move is a promotion.
+	*/
+	bool isPromotion() const { return (flags() & PROMOTION) != 0; }
+
+	/*!
+	* @brief Get the piece a pawn is promoted to.
+	* @return The promotion piece type.
+	*/
+	PieceType promotionPiece() const { return static_cast<PieceType>(KNIGHT + (flags() & 3)); }
+
+	/*!
+	* @brief Check if this is the null move.
+	* @return True if the move is empty.
+	*/
+	bool isNull() const { return data == 0; }
+
+	bool operator==(const ChessMove& other) const { return data == other.data; }
+	bool operator!=(const ChessMove& other) const { return data != other.data; }
+};
+
+/*!
+* @struct ChessMoveList
+* @brief A fixed size list of moves, so generating moves never allocates.
+*/
+struct ChessMoveList {
+	static const int MAX_MOVES = 256; /*!< More than the most moves possible in any position. */
+
+	ChessMove moves[MAX_MOVES]; /*!< The moves. */
+	int count = 0; /*!< The number of moves in the list. */
+
+	/*!
+	* @brief Add a move to the list.
+	* @param move The move to add.
+	*/
+	void add(ChessMove move) { moves[count++] = move; }
+
+	/*!
+	* @brief Get the number of moves in the list.
+	* @return The number of moves.
+	*/
+	int size() const { return count; }
+
+	ChessMove* begin() { return moves; }
+	ChessMove* end() { return moves + count; }
+	const ChessMove* begin() const { return moves; }
+	const ChessMove* end() const { return moves + count; }
+	ChessMove& operator[](int index) { return moves[index]; }
+	const ChessMove& operator[](int index) const { return moves[index]; }
+};
+
+/*!
+* @class ChessBoard
+* @brief A chess position held as bitboards, with make/unmake and legal move generation.
+* @details Sliding piece attacks use magic bitboards, built once the first time a board is created.
+* @details The class holds no console resources, so it is cheap to copy for searching.
+*/
+class ChessBoard {
+public:
+	static const int WHITE = 0; /*!< Index of the white side. */
+	static const int BLACK = 1; /*!< Index of the black side. */
+	static const int NO_SQUARE = -1; /*!< Value of the en passant square when there is none. */
+
+	static const int WHITE_KINGSIDE = 1; /*!< Castling right for white on the king's side. */
+	static const int WHITE_QUEENSIDE = 2; /*!< Castling right for white on the queen's side. */
+	static const int BLACK_KINGSIDE = 4; /*!< Castling right for black on the king's side. */
+	static const int BLACK_QUEENSIDE = 8; /*!< Castling right for black on the queen's side. */
+
+	static constexpr std::string_view START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"; /*!< The FEN of the standard starting position, a constant so it is ready before any global board is built. */
+
+private:
+	/*!
+	* @struct UndoState
+	* @brief The state needed to take back one move.
+	*/
+	struct UndoState {
+		ChessMove move; /*!< The move that was made. */
+		int8_t captured; /*!< The piece that was captured, or -1. */
+		uint8_t castlingRights; /*!< The castling rights before the move. */
+		int8_t enPassantSquare; /*!< The en passant square before the move. */
+		int halfmoveClock; /*!< The halfmove clock before the move. */
+		uint64_t hash; /*!< The Zobrist key before the move. */
+	};
+
+	uint64_t pieces[2][6]; /*!< One bitboard per side and piece type. */
+	uint64_t colours[2]; /*!< All pieces of each side. */
+	uint64_t occupied; /*!< All pieces on the board. */
+	int8_t mailbox[64]; /*!< The piece on each square as side * 6 + type, or -1 when empty. */
+
+	int sideToMove; /*!< The side to move (WHITE or BLACK). */
+	int castlingRights; /*!< The castling rights still available. */
+	int enPassantSquare; /*!< The square a pawn can capture onto en passant, or NO_SQUARE. */
+	int halfmoveClock; /*!< Halfmoves since the last capture or pawn move. */
+	int fullmoveNumber; /*!< The move number, starting at 1. */
+	uint64_t hash; /*!< The Zobrist key of the position, kept up to date as pieces move. */
+
+	std::vector<UndoState> history; /*!< One entry per move made. */
+
+	/*!
+	* @brief Put a piece on an empty square.
+	* @param piece The piece as side * 6 + type.
+	* @param square The square.
+	*/
+	void putPiece(int piece, int square);
+
+	/*!
+	* @brief Remove the piece on a square.
+	* @param square The square.
+	*/
+	void removePiece(int square);
+
+	/*!
+	* @brief Move a piece to an empty square.
+	* @param from The square the piece is on.
+	* @param to The square to move it to.
+	*/
+	void movePiece(int from, int to);
+
+	/*!
+	* @brief Get all squares attacked by one side.
+	* @param side The attacking side.
+	* @param occupancy The occupancy to use for sliding pieces.
+	* @return A bitboard of the attacked squares.
+	*/
+	uint64_t attackedSquares(int side, uint64_t occupancy) const;
+
+	/*!
+	* @brief Check an en passant capture does not leave the king in check.
+	* @param from The square of the capturing pawn.
+	* @param to The en passant square.
+	* @return True if the capture is legal.
+	*/
+	bool isEnPassantLegal(int from, int to) const;
+
+	/*!
+	* @brief Add a pawn move, expanding it into the four promotions when it reaches the last rank.
+	* @param list The list to add to.
+	* @param from The square the pawn moves from.
+	* @param to The square the pawn moves to.
+	* @param capture Whether the move is a capture.
+	*/
+	static void addPawnMove(ChessMoveList& list, int from, int to, bool capture);
+
+public:
+	/*!
+	* @brief Constructor for ChessBoard, sets up the starting position.
+	*/
+	ChessBoard();
+
+	/*!
+	* @brief Build the attack tables and magic numbers if they have not been built yet.
+	*/
+	static void initialiseTables();
+
+	/*!
+	* @brief Get the squares a rook attacks.
+	* @param square The rook's square.
+	* @param occupancy The occupied squares.
+	* @return A bitboard of attacked squares.
+	*/
+	static uint64_t rookAttacks(int square, uint64_t occupancy);
+
+	/*!
+	* @brief Get the squares a bishop attacks.
+	* @param square The bishop's square.
+	* @param occupancy The occupied squares.
+	* @return A bitboard of attacked squares.
+	*/
+	static uint64_t bishopAttacks(int square, uint64_t occupancy);
+
+	/*!
+	* @brief Get the squares a knight attacks.
+	* @param square The knight's square.
+	* @return A bitboard of attacked squares.
+	*/
+	static uint64_t knightAttacks(int square);
+
+	/*!
+	* @brief Get the squares a king attacks.
+	* @param square The king's square.
+	* @return A bitboard of attacked squares.
+	*/
+	static uint64_t kingAttacks(int square);
+
+	/*!
+	* @brief Get the squares a pawn attacks.
+	* @param side The side of the pawn.
+	* @param square The pawn's square.
+	* @return A bitboard of attacked squares.
+	*/
+	static uint64_t pawnAttacks(int side, int square);
+
+	/*!
+	* @brief Set up the standard starting position.
+	*/
+	void setStartPosition();
+
+	/*!
+	* @brief Set up a position from Forsyth-Edwards Notation.
+	* @param fen The FEN string.
+	* @throws runtime_error if the FEN cannot be parsed.
+	*/
+	void setFen(std::string_view fen);
+
+	/*!
+	* @brief Get the position in Forsyth-Edwards Notation.
+	* @return The FEN string.
+	*/
+	std::string getFen() const;
+
+	/*!
+	* @brief Get the side to move.
+	* @return WHITE or BLACK.
+	*/
+	int getSideToMove() const { return sideToMove; }
+
+	/*!
+	* @brief Get the castling rights.
+	* @return The castling rights as a combination of the castling constants.
+	*/
+	int getCastlingRights() const { return castlingRights; }
+
+	/*!
+	* @brief Get the en passant square.
+	* @return The en passant square, or NO_SQUARE.
+	*/
+	int getEnPassantSquare() const { return enPassantSquare; }
+
+	/*!
+	* @brief Get the halfmove clock.
+	* @return Halfmoves since the last capture or pawn move.
+	*/
+	int getHalfmoveClock() const { return halfmoveClock; }
+
+	/*!
+	* @brief Get the piece on a square.
+	* @param square The square.
+	* @return The piece as side * 6 + type, or -1 for an empty square.
+	*/
+	int getPiece(int square) const { return mailbox[square]; }
+
+	/*!
+	* @brief Get the bitboard of one side's pieces of one type.
+	* @param side The side.
+	* @param type The piece type.
+	* @return The bitboard.
+	*/
+	uint64_t getPieces(int side, PieceType type) const { return pieces[side][type]; }
+
+	/*!
+	* @brief Get the bitboard of all of one side's pieces.
+	* @param side The side.
+	* @return The bitboard.
+	*/
+	uint64_t getColour(int side) const { return colours[side]; }
+
+	/*!
+	* @brief Get the bitboard of all pieces.
+	* @return The bitboard.
+	*/
+	uint64_t getOccupied() const { return occupied; }
+
+	/*!
+	* @brief Get the Zobrist key of the position.
+	* @details The key covers the pieces, side to move, castling rights and en passant square.
+	* @return The key, updated incrementally by make and unmake.
+	*/
+	uint64_t getHash() const { return hash; }
+
+	/*!
+	* @brief Calculate the Zobrist key from scratch, to check the incremental key.
+	* @return The key.
+	*/
+	uint64_t computeHash() const;
+
+	/*!
+	* @brief Check if the position has occurred before since the last capture or pawn move.
+	* @return True if the position is a repetition.
+	*/
+	bool isRepetition() const;
+
+	/*!
+	* @brief Check if the side to move has any pieces other than pawns and the king.
+	* @return True if the side to move has a knight, bishop, rook or queen.
+	*/
+	bool hasNonPawnMaterial() const;
+
+	/*!
+	* @brief Get every piece attacking a square.
+	* @param square The square.
+	* @param occupancy The occupancy to use for sliding pieces.
+	* @return A bitboard of the attackers of both sides.
+	*/
+	uint64_t attackersTo(int square, uint64_t occupancy) const;
+
+	/*!
+	* @brief Check if the side to move is in check.
+	* @return True if the king of the side to move is attacked.
+	*/
+	bool isInCheck() const;
+
+	/*!
+	* @brief Generate every legal move in the position.
+	* @details Pins and checks are resolved while generating, so no move needs to be tried and taken back.
+	* @param list The list to fill; it is cleared first.
+	*/
+	void generateLegalMoves(ChessMoveList& list) const;
+
+	/*!
+	* @brief Make a move, which must be legal in the current position.
+	* @param move The move.
+	*/
+	void makeMove(ChessMove move);
+
+	/*!
+	* @brief Take back the last move made, including a null move.
+	*/
+	void unmakeMove();
+
+	/*!
+	* @brief Pass the move to the other side, for null move pruning. Must not be used in check.
+	*/
+	void makeNullMove();
+
+	/*!
+	* @brief Count the leaf nodes of the legal move tree to a given depth.
+	* @param depth The depth to search to.
+	* @return The number of leaf nodes.
+	*/
+	uint64_t perft(int depth);
+
+	/*!
+	* @brief Convert a move to coordinate notation, such as "e2e4" or "e7e8q".
+	* @param move The move.
+	* @return The move as a string.
+	*/
+	static std::string moveToString(ChessMove move);
+
+	/*!
+	* @brief Find the legal move matching a move in coordinate notation.
+	* @param text The move, such as "e2e4" or "e7e8q".
+	* @return The matching legal move, or the null move if there is none.
+	*/
+	ChessMove parseMove(const std::string& text) const;
+
+	/*!
+	* @brief Convert a legal move to standard algebraic notation, such as "Nf3", "exd5", "O-O" or "e8=Q+".
+	* @param move The move, which must be legal in the current position.
+	* @return The move in SAN.
+	*/
+	std::string moveToSan(ChessMove move);
+
+	/*!
+	* @brief Find the legal move matching a move in standard algebraic notation.
+	* @details Check, mate and annotation marks are ignored, and castling may be written with zeros.
+	* @details The text is read in place, so parsing a move never allocates.
+	* @param san The move, such as "Nbd7", "exd6", "O-O-O" or "b8=Q".
+	* @return The matching legal move, or the null move if there is none or it is ambiguous.
+	*/
+	ChessMove parseSan(std::string_view san) const;
+
+	/*!
+	* @brief Convert a square to its name, such as "e4".
+	* @param square The square.
+	* @return The name of the square.
+	*/
+	static std::string squareToString(int square);
+};
+
+#endif // CHESS_BOARD_H
@@ -11,7 +11,7 @@ const wstring win = L"w";
 const wstring surrender = L"s";
 const wstring draw = L"d";
 
-Con4::Con4()
+Con4::Con4(ScreenBuffer* buffer) : ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer)
 {
 	populategrid();
 }
@@ -42,109 +42,111 @@ void Con4::endgame(wstring letter) // end game
 
 void Con4::playerturn(int player)
 {
-    string diff = "0";
+    string diff;
+    int column = 0;
 
-    do
+    // Read until the player surrenders or picks a column with room in it
+    while (true)
     {
         screenBuffer.writeToScreen(0, 14, L"player " + to_wstring(player) + L"'s turn. Select a column to drop a coin.  ");
 
         diff = screenBuffer.getBlockingInput();
 
-        if (grid[0][stoi(diff) - 1] != 0)
+        try
         {
-            screenBuffer.writeToScreen(0, 18, L"Column is full. choose another.");
+            column = stoi(diff);
         }
-    } while (grid[0][stoi(diff) - 1] != 0);
-
-    bool repeat = true;
-
-    while(repeat)
-    {
-        if (stoi(diff) == 9)
+        catch (const std::exception&)
         {
-            repeat = false;
+            column = 0;
+        }
 
+        if (column == 9)
+        {
             endgame(surrender);
+
+            return;
         }
-        else if (stoi(diff) >= 1 && stoi(diff) <= 7)
-        {
-            repeat = false;
 
-            dropcoin(stoi(diff), player);
+        if (column < 1 || column > 7)
+        {
+            screenBuffer.writeToScreen(0, 18, L"Invalid input. Choose between 1 and 7.");
+        }
+        else if (board.dropCell(column - 1) < 0)
+        {
+            screenBuffer.writeToScreen(0, 18, L"Column is full. choose another.       ");
         }
         else
         {
-            screenBuffer.writeToScreen(0, 16, L"Invalid input. Choose between 1 and 7.");
+            dropcoin(column, player);
 
-            screenBuffer.getBlockingInput();
+            return;
         }
     }
 }
 
 void Con4::dropcoin(int column, int playercoin)
 {
-    for (int i = 5; i >= 0; i--)
+    int cell = board.dropCell(column - 1);
+
+    if (cell >= 0)
     {
-        if (grid[i][column - 1] == 0)
-        {
-            grid[i][column - 1] = playercoin;
+        board.setTurn(playercoin);
 
-            break;
-        }
+        board.makeMove(cell);
     }
 }
 
+int Con4::aiturn(int player)
+{
+    screenBuffer.writeToScreen(0, 14, L"The computer is thinking...                            ");
+
+    board.setTurn(player);
+
+    int column = ai.findBestMove(board, Connect4Board::CELLS, 1.0) % Connect4Board::WIDTH + 1;
+
+    dropcoin(column, player);
+
+    return column;
+}
+
 void Con4::populategrid()
 {
-    for(int i = 0; i < 6; i++)
-    {
-        for(int j = 0; j < 7; j++)
-        {
-            grid[i][j] = 0;
-        }
-    }
+    board.clear();
 }
 
-void Con4::checkdraw()
+bool Con4::checkdraw() const
 {
-    if(grid[0][0] != 0 && grid[0][1] != 0 &&grid[0][2] != 0 && grid[0][3] != 0 && grid[0][4] != 0 && grid[0][5] != 0 && grid[0][6] != 0)
+    for (int column = 0; column < Connect4Board::WIDTH; column++)
     {
-        endgame(draw);
+        if (board.dropCell(column) >= 0)
+        {
+            return false;
+        }
     }
+
+    return true;
 }
 
 void Con4::setnum(int player, int xval, int yval)
 {
-    grid[yval][xval] = player;
+    board.setCell(yval * Connect4Board::WIDTH + xval, player);
 }
 
-void Con4::checkwin()
+int Con4::getnum(int xval, int yval) const
 {
-    for(int i = 0; i < 6; i++)
-    {
-        for(int j = 0; j < 7; j++)
-        {
-            if (j < 4 && grid[i][j] == grid[i][j + 1] && grid[i][j] == grid[i][j + 2] && grid[i][j] == grid[i][j + 3] && grid[i][j] != 0) // horizontal
-            {
-                endgame(win);
-            }
-            
-            if (i < 3 && grid[i][j] == grid[i + 1][j] && grid[i][j] == grid[i + 2][j] && grid[i][j] == grid[i + 3][j] && grid[i][j] != 0) // vertical
-            {
-                endgame(win);
-            }
+    return board.get(xval, yval);
+}
 
-            if (i < 3 && j < 4 && grid[i][j] == grid[i + 1][j + 1] && grid[i][j] == grid[i + 2][j + 2] && grid[i][j] == grid[i + 3][j + 3] && grid[i][j] != 0) // diagonal down right
-            {
-                endgame(win);
-            }
+bool Con4::isover() const
+{
+    return winquestionmark;
+}
 
-            if (i > 3 && j < 4 && grid[i][j] == grid[i - 1][j + 1] && grid[i][j] == grid[i - 2][j + 2] && grid[i][j] == grid[i - 3][j + 3] && grid[i][j] != 0) // diagonal down left
-            {
-                endgame(win);
-            }
-        }
-    }
+bool Con4::checkwin() const
+{
+    // Only the last coin can have made four in a row, so the board checks the four lines through it as it lands
+    return board.getWinner() != 0;
 }
 
 int Con4::randomstarter()
@@ -177,15 +179,13 @@ void Con4::display()
 
         for (int o = 0; o < 7; o++)
         {
-            wstring value = to_wstring(grid[i][o]);
-
-            if (value == L"0")
+            if (board.get(o, i) == 0)
             {
                 row += L"   |";
             }
             else
             {
-                row += L" " + to_wstring(grid[i][o]) + L" |";
+                row += L" " + to_wstring(board.get(o, i)) + L" |";
             }
         }
         
@@ -203,6 +203,14 @@ int Con4::connect4()
 
     populategrid();
 
+    screenBuffer.clearScreen();
+
+    screenBuffer.writeToScreen(0, 0, L"Play against the computer? (y/n): ");
+
+    computeropponent = screenBuffer.getBlockingInput() == "y";
+
+    screenBuffer.clearScreen();
+
     currentplayer = randomstarter();
 
     display();
@@ -211,15 +219,28 @@ int Con4::connect4()
     {
         currentplayer = swapturn(currentplayer);
 
-        playerturn(currentplayer);
+        if (computeropponent && currentplayer == player2)
+        {
+            aiturn(currentplayer);
+        }
+        else
+        {
+            playerturn(currentplayer);
+        }
         
         screenBuffer.clearScreen();
 
         display();
 
-        checkdraw();
-        
-        checkwin();
+        // A last coin that makes four in a row wins, even though it fills the grid
+        if (checkwin())
+        {
+            endgame(win);
+        }
+        else if (checkdraw())
+        {
+            endgame(draw);
+        }
 
     } while (winquestionmark == false);
 
@@ -2,6 +2,9 @@
 #define CON4_H
 
 #include "screenBuffer.h"
+#include "mnkBoard.h"
+#include "mnkSearch.h"
+#include <memory>
 
 using namespace std;
 
@@ -16,12 +19,15 @@ using namespace std;
  */
 class Con4 {
 private:
-    int grid[6][7];
-	int player1 = 1, player2 = 2; //1 for player 1, 2 for 2, 0 for empty space.
+    Connect4Board board; // The grid, row 0 at the top. 1 for player 1, 2 for 2, 0 for empty space.
+    MnkSearch<Connect4Board> ai; // Plays player 2 against a single player.
+	int player1 = 1, player2 = 2;
     int currentplayer;
+    bool computeropponent = false;
     bool winquestionmark = false;
 
-    ScreenBuffer screenBuffer;
+    std::unique_ptr<ScreenBuffer> ownScreenBuffer; // The game's own screen buffer, or null if it draws on one it was given.
+    ScreenBuffer& screenBuffer;
 
     /*!
      * @brief Ends game when called with specific values.
@@ -32,8 +38,9 @@ private:
 public:
     /*!
      * @brief Constructor for the Connect4 class.
+     * @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
      */
-    Con4();
+    explicit Con4(ScreenBuffer* buffer = nullptr);
 
     /*!
      * @brief Populates the game grid with initial values.
@@ -48,9 +55,10 @@ public:
     void dropcoin(int column, int playercoin);
 
     /*!
-     * @brief Checks if the game is a draw.
+     * @brief Checks if the game is a draw, with no column left to drop a coin into.
+     * @return true if every column is full.
      */
-    void checkdraw();
+    bool checkdraw() const;
 
     /*!
     * @brief Manually sets a position as a value given.
@@ -61,9 +69,10 @@ public:
     void setnum(int player, int xval, int yval);
 
     /*!
-     * @brief Checks if there is a winning condition on the board.
+     * @brief Checks if the last coin dropped made four in a row, looking only at the lines through it.
+     * @return true if it did.
      */
-    void checkwin();
+    bool checkwin() const;
 
     /*!
      * @brief Randomly selects the starting player.
@@ -83,6 +92,27 @@ public:
      */
     void playerturn(int player);
 
+    /*!
+     * @brief Handles the computer's turn, searching for the best column for up to a second.
+     * @param player The computer's player.
+     * @return The column the coin was dropped into, from 1 to 7.
+     */
+    int aiturn(int player);
+
+    /*!
+     * @brief Gets the player in a position of the grid.
+     * @param xval The x coordinate, the column
+     * @param yval The y coordinate, the row from the top
+     * @return 1 or 2, or 0 for an empty space.
+     */
+    int getnum(int xval, int yval) const;
+
+    /*!
+     * @brief Checks if the game has been won, drawn or surrendered.
+     * @return true once the game is over.
+     */
+    bool isover() const;
+
     /*!
      * @brief Handles the display of the grid.
      */
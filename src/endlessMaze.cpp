@@ -0,0 +1,162 @@
+#include "endlessMaze.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+// Constructor for the EndlessMaze class
+EndlessMaze::EndlessMaze(int width, uint32_t seed)
+    : width(width), rows(width, seed), firstChunk(0), playerX(0), playerY(0), deepestRow(0) {
+    cells.assign(static_cast<size_t>(WINDOW_CHUNKS) * CHUNK_ROWS * width, 0);
+    reached.assign(cells.size(), 0);
+    queue.reserve(cells.size());
+
+    for (long long chunk = 0; chunk < WINDOW_CHUNKS; chunk++) {
+        generateChunk(chunk);
+    }
+}
+
+
+// Makes the rows of the next chunk
+void EndlessMaze::generateChunk(long long chunk) {
+    uint8_t* data = chunkData(chunk);
+    for (int row = 0; row < CHUNK_ROWS; row++) {
+        rows.nextRow(data + static_cast<size_t>(row) * width, false);
+    }
+}
+
+
+// Drops the top chunk and makes a new one at the bottom
+void EndlessMaze::advance() {
+    // The new chunk goes in the slot of the one dropped
+    generateChunk(firstChunk + WINDOW_CHUNKS);
+    firstChunk++;
+
+    // Nothing above the window is kept any more, so wall it off
+    for (int x = 0; x < width; x++) {
+        cells[slot(x, getFirstRow())] &= static_cast<uint8_t>(~MazeGrid::OPEN_NORTH);
+    }
+
+    connectToBottom();
+}
+
+
+// Joins any cells that cannot reach the bottom row to a neighbour that can
+void EndlessMaze::connectToBottom() {
+    const long long top = getFirstRow();
+    const long long bottom = getEndRow() - 1;
+    std::fill(reached.begin(), reached.end(), 0);
+    queue.clear();
+
+    // Moves in the order of the passage bits: north, south, east, west
+    const int dx[4] = { 0, 0, 1, -1 };
+    const int dy[4] = { -1, 1, 0, 0 };
+
+    auto flood = [&]() {
+        while (!queue.empty()) {
+            int index = queue.back();
+            queue.pop_back();
+            int x = index % width;
+            long long y = top + index / width;
+            uint8_t passages = cells[slot(x, y)];
+
+            for (int direction = 0; direction < 4; direction++) {
+                long long nextY = y + dy[direction];
+                if (((passages >> direction) & 1) && nextY >= top && nextY <= bottom) {
+                    int next = static_cast<int>((nextY - top) * width + x + dx[direction]);
+                    if (!reached[next]) {
+                        reached[next] = 1;
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+    };
+
+    // Indexed by row from the top of the window here, rather than by slot in the ring
+    for (int x = 0; x < width; x++) {
+        int index = static_cast<int>((bottom - top) * width + x);
+        reached[index] = 1;
+        queue.push_back(index);
+    }
+    flood();
+
+    // Going up from the bottom, a stranded cell nearly always has a reached neighbour by the time it is looked at
+    bool stranded = true;
+    while (stranded) {
+        stranded = false;
+        for (long long y = bottom; y >= top; y--) {
+            for (int x = 0; x < width; x++) {
+                int index = static_cast<int>((y - top) * width + x);
+                if (reached[index]) {
+                    continue;
+                }
+
+                int direction = 0;
+                for (; direction < 4; direction++) {
+                    long long nextY = y + dy[direction];
+                    int nextX = x + dx[direction];
+                    if (nextY >= top && nextY <= bottom && nextX >= 0 && nextX < width && reached[(nextY - top) * width + nextX]) {
+                        break;
+                    }
+                }
+                if (direction == 4) {
+                    stranded = true;
+                    continue;
+                }
+
+                cells[slot(x, y)] |= static_cast<uint8_t>(1 << direction);
+                cells[slot(x + dx[direction], y + dy[direction])] |= static_cast<uint8_t>(1 << MazeGrid::opposite(direction));
+                reached[index] = 1;
+                queue.push_back(index);
+                flood();
+            }
+        }
+    }
+}
+
+
+// Gets the passages out of a cell in the window
+uint8_t EndlessMaze::getPassages(int x, long long y) const {
+    if (x < 0 || x >= width || !isLoaded(y)) {
+        throw std::runtime_error("Cell " + std::to_string(x) + ", " + std::to_string(y) + " is not in the window of the maze");
+    }
+    return cells[slot(x, y)];
+}
+
+
+// Moves the player
+bool EndlessMaze::movePlayer(int direction) {
+    if (direction < 0 || direction > 3 || !((cells[slot(playerX, playerY)] >> direction) & 1)) {
+        return false;
+    }
+
+    switch (direction) {
+    case MazeGrid::NORTH:
+        playerY--;
+        break;
+    case MazeGrid::SOUTH:
+        playerY++;
+        break;
+    case MazeGrid::EAST:
+        playerX++;
+        break;
+    default:
+        playerX--;
+        break;
+    }
+
+    if (playerY > deepestRow) {
+        deepestRow = playerY;
+    }
+    while (playerY / CHUNK_ROWS > firstChunk + CHUNKS_BEHIND) {
+        advance();
+    }
+    return true;
+}
+
+
+// Gets the memory the maze takes
+size_t EndlessMaze::getMemory() const {
+    return sizeof(*this) + cells.capacity() + reached.capacity() + queue.capacity() * sizeof(int) + rows.getMemory();
+}
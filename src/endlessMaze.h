@@ -0,0 +1,151 @@
+#ifndef ENDLESS_MAZE_H
+#define ENDLESS_MAZE_H
+
+/*!
+* @file endlessMaze.h
+* @brief Contains the declaration of the EndlessMaze class, a maze with no bottom that is made as the player goes down it.
+*/
+
+#include "mazeGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+* @class EndlessMaze
+* @brief A maze of fixed width going down forever, of which only a window of rows around the player is kept.
+* @details Rows are made with Eller's algorithm, which needs only the last row to make the next, in chunks of
+* @details CHUNK_ROWS. The window holds WINDOW_CHUNKS chunks in one ring of cells: CHUNKS_BEHIND chunks above the
+* @details player's chunk and the rest below it. When the player goes down into a new chunk, the chunk at the top of
+* @details the window is dropped and its cells reused for a new one at the bottom, so memory stays the same however
+* @details deep the player goes.
+* @details Dropping rows seals the top of the window, and in a maze with no loops that could strand a pocket of cells
+* @details whose only way on went up through them. After each drop any such pocket is joined to a neighbour that can
+* @details still reach the bottom row, so the way down is never lost.
+*/
+class EndlessMaze {
+public:
+	static constexpr int CHUNK_ROWS = 32; /*!< The rows made at a time. */
+	static constexpr int WINDOW_CHUNKS = 4; /*!< The chunks kept. */
+	static constexpr int CHUNKS_BEHIND = 1; /*!< The chunks kept above the player's chunk. */
+
+private:
+	int width; /*!< The number of columns. */
+	EllerRows rows; /*!< Makes each row from the last. */
+	std::vector<uint8_t> cells; /*!< The passages of the window's rows, one chunk per slot of the ring. */
+	long long firstChunk; /*!< The chunk at the top of the window. */
+	int playerX; /*!< The player's column. */
+	long long playerY; /*!< The player's row, counting from the top of the maze. */
+	long long deepestRow; /*!< The furthest row down the player has been. */
+	std::vector<uint8_t> reached; /*!< Cells known to reach the bottom row, while checking after a drop. */
+	std::vector<int> queue; /*!< The flood fill's queue while checking after a drop. */
+
+	/*!
+	* @brief Get the passages of a chunk's first row.
+	* @param chunk The chunk.
+	* @return The first cell of the chunk's slot in the ring.
+	*/
+	uint8_t* chunkData(long long chunk) { return cells.data() + static_cast<size_t>(chunk % WINDOW_CHUNKS) * CHUNK_ROWS * width; }
+
+	/*!
+	* @brief Get the place in the window of a cell.
+	* @param x The column.
+	* @param y The row.
+	* @return The index into cells.
+	*/
+	size_t slot(int x, long long y) const {
+		return static_cast<size_t>(y % (static_cast<long long>(WINDOW_CHUNKS) * CHUNK_ROWS)) * width + x;
+	}
+
+	/*!
+	* @brief Make the rows of a chunk, the one after the last chunk made.
+	* @param chunk The chunk.
+	*/
+	void generateChunk(long long chunk);
+
+	/*!
+	* @brief Drop the chunk at the top of the window and make a new one at the bottom.
+	*/
+	void advance();
+
+	/*!
+	* @brief Join any cells of the window that cannot reach its bottom row to a neighbour that can.
+	*/
+	void connectToBottom();
+
+public:
+	/*!
+	* @brief Constructor for EndlessMaze, making the first window with the player at the top left.
+	* @param width The number of columns.
+	* @param seed The random seed.
+	* @throws runtime_error if the width is less than one.
+	*/
+	EndlessMaze(int width, uint32_t seed);
+
+	/*!
+	* @brief Get the number of columns.
+	* @return The width.
+	*/
+	int getWidth() const { return width; }
+
+	/*!
+	* @brief Get the first row still kept.
+	* @return The row.
+	*/
+	long long getFirstRow() const { return firstChunk * CHUNK_ROWS; }
+
+	/*!
+	* @brief Get the row after the last one kept.
+	* @return The row.
+	*/
+	long long getEndRow() const { return (firstChunk + WINDOW_CHUNKS) * CHUNK_ROWS; }
+
+	/*!
+	* @brief Check if a row is in the window.
+	* @param y The row.
+	* @return true if it is.
+	*/
+	bool isLoaded(long long y) const { return y >= getFirstRow() && y < getEndRow(); }
+
+	/*!
+	* @brief Get the passages out of a cell in the window.
+	* @param x The column.
+	* @param y The row.
+	* @return The MazeGrid OPEN_ bits.
+	* @throws runtime_error if the cell is not in the window.
+	*/
+	uint8_t getPassages(int x, long long y) const;
+
+	/*!
+	* @brief Get the player's column.
+	* @return The column.
+	*/
+	int getPlayerX() const { return playerX; }
+
+	/*!
+	* @brief Get the player's row.
+	* @return The row.
+	*/
+	long long getPlayerY() const { return playerY; }
+
+	/*!
+	* @brief Get the furthest row down the player has been.
+	* @return The row.
+	*/
+	long long getDeepestRow() const { return deepestRow; }
+
+	/*!
+	* @brief Move the player, sliding the window down if they have gone into a new chunk.
+	* @param direction MazeGrid::NORTH, SOUTH, EAST or WEST.
+	* @return false if there is a wall that way.
+	*/
+	bool movePlayer(int direction);
+
+	/*!
+	* @brief Get the memory the maze takes, which does not grow as the player goes down.
+	* @return The bytes.
+	*/
+	size_t getMemory() const;
+};
+
+#endif // ENDLESS_MAZE_H
@@ -0,0 +1,790 @@
+
+#include "fourPlayerChess.h"
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+
+// Directions for sliding and king moves, the orthogonal ones first
+static const int DIRECTIONS[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+static const int KNIGHT_JUMPS[8][2] = { {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2} };
+
+// The way each player's pawns move, in row and column, and the row or column they start on
+static const int PAWN_FORWARD[4][2] = { {1, 0}, {0, 1}, {-1, 0}, {0, -1} };
+static const int PAWN_START[4] = { 1, 1, 12, 12 };
+static const int PROMOTION_LINE[4] = { 7, 7, 6, 6 };
+
+// Back rank pieces of each player, from row or column 3 to 10
+static const PieceType RED_GREEN_BACK_RANK[8] = { ROOK, KNIGHT, BISHOP, QUEEN, KING, BISHOP, KNIGHT, ROOK };
+static const PieceType BLUE_YELLOW_BACK_RANK[8] = { ROOK, KNIGHT, BISHOP, KING, QUEEN, BISHOP, KNIGHT, ROOK };
+
+// Piece values in centipawns, the king counting for nothing
+static const int PIECE_VALUES[6] = { 100, 300, 350, 500, 900, 0 };
+
+static const int MAX_RAY = FourPlayerChessBoard::SIZE - 1;
+static const int INFINITE_SCORE = FourPlayerChessBoard::MATE_SCORE * 2;
+
+// Move tables, built once by initialiseTables. Squares off the board have no entries and are never reached.
+static bool validTable[FourPlayerChessBoard::SQUARES];
+static uint8_t rayTable[FourPlayerChessBoard::SQUARES][8][MAX_RAY];
+static uint8_t rayLength[FourPlayerChessBoard::SQUARES][8];
+static uint8_t knightTable[FourPlayerChessBoard::SQUARES][8];
+static uint8_t knightCount[FourPlayerChessBoard::SQUARES];
+static uint8_t kingTable[FourPlayerChessBoard::SQUARES][8];
+static uint8_t kingCount[FourPlayerChessBoard::SQUARES];
+
+// Pawn tables per player: the square ahead, the squares captured onto, and the squares a pawn attacks a square from
+static int16_t pawnPushTable[4][FourPlayerChessBoard::SQUARES];
+static uint8_t pawnCaptureTable[4][FourPlayerChessBoard::SQUARES][2];
+static uint8_t pawnCaptureCount[4][FourPlayerChessBoard::SQUARES];
+static uint8_t pawnAttackerTable[4][FourPlayerChessBoard::SQUARES][2];
+static uint8_t pawnAttackerCount[4][FourPlayerChessBoard::SQUARES];
+
+// Bonus for pieces near the middle of the board
+static int8_t centreTable[FourPlayerChessBoard::SQUARES];
+
+static std::once_flag tablesBuilt;
+
+
+// Builds the lookup tables the first time they are needed
+static void buildTables() {
+    const int size = FourPlayerChessBoard::SIZE;
+
+    for (int row = 0; row < size; row++) {
+        for (int column = 0; column < size; column++) {
+            validTable[row * size + column] = FourPlayerChessBoard::isValidSquare(row, column);
+        }
+    }
+
+    for (int row = 0; row < size; row++) {
+        for (int column = 0; column < size; column++) {
+            int square = row * size + column;
+            if (!validTable[square]) {
+                continue;
+            }
+
+            // Rays stop at the edge of the board or the first cut corner square
+            for (int direction = 0; direction < 8; direction++) {
+                int length = 0;
+                int r = row + DIRECTIONS[direction][0];
+                int c = column + DIRECTIONS[direction][1];
+
+                while (FourPlayerChessBoard::isValidSquare(r, c)) {
+                    rayTable[square][direction][length++] = static_cast<uint8_t>(r * size + c);
+                    r += DIRECTIONS[direction][0];
+                    c += DIRECTIONS[direction][1];
+                }
+
+                rayLength[square][direction] = static_cast<uint8_t>(length);
+
+                r = row + DIRECTIONS[direction][0];
+                c = column + DIRECTIONS[direction][1];
+                if (FourPlayerChessBoard::isValidSquare(r, c)) {
+                    kingTable[square][kingCount[square]++] = static_cast<uint8_t>(r * size + c);
+                }
+            }
+
+            for (int jump = 0; jump < 8; jump++) {
+                int r = row + KNIGHT_JUMPS[jump][0];
+                int c = column + KNIGHT_JUMPS[jump][1];
+                if (FourPlayerChessBoard::isValidSquare(r, c)) {
+                    knightTable[square][knightCount[square]++] = static_cast<uint8_t>(r * size + c);
+                }
+            }
+
+            for (int player = 0; player < FourPlayerChessBoard::PLAYERS; player++) {
+                int forwardRow = PAWN_FORWARD[player][0];
+                int forwardColumn = PAWN_FORWARD[player][1];
+
+                int r = row + forwardRow;
+                int c = column + forwardColumn;
+                pawnPushTable[player][square] = FourPlayerChessBoard::isValidSquare(r, c) ? static_cast<int16_t>(r * size + c) : -1;
+
+                // Captures are one square forward and one to either side
+                for (int side = -1; side <= 1; side += 2) {
+                    r = row + forwardRow + side * forwardColumn;
+                    c = column + forwardColumn + side * forwardRow;
+                    if (FourPlayerChessBoard::isValidSquare(r, c)) {
+                        pawnCaptureTable[player][square][pawnCaptureCount[player][square]++] = static_cast<uint8_t>(r * size + c);
+                    }
+
+                    r = row - forwardRow + side * forwardColumn;
+                    c = column - forwardColumn + side * forwardRow;
+                    if (FourPlayerChessBoard::isValidSquare(r, c)) {
+                        pawnAttackerTable[player][square][pawnAttackerCount[player][square]++] = static_cast<uint8_t>(r * size + c);
+                    }
+                }
+            }
+
+            int rowDistance = std::abs(2 * row - (size - 1)) / 2;
+            int columnDistance = std::abs(2 * column - (size - 1)) / 2;
+            centreTable[square] = static_cast<int8_t>(2 * (size / 2 - (rowDistance > columnDistance ? rowDistance : columnDistance)));
+        }
+    }
+}
+
+
+// Builds the move tables once, however many boards are created
+void FourPlayerChessBoard::initialiseTables() {
+    std::call_once(tablesBuilt, buildTables);
+}
+
+
+// Checks a square is on the board and not in a cut corner
+bool FourPlayerChessBoard::isValidSquare(int row, int column) {
+    if (row < 0 || row >= SIZE || column < 0 || column >= SIZE) {
+        return false;
+    }
+
+    bool rowInCorner = row < CORNER || row >= SIZE - CORNER;
+    bool columnInCorner = column < CORNER || column >= SIZE - CORNER;
+
+    return !(rowInCorner && columnInCorner);
+}
+
+
+// Constructor for the FourPlayerChessBoard class
+FourPlayerChessBoard::FourPlayerChessBoard() : nodes(0) {
+    initialiseTables();
+    setStartPosition();
+}
+
+
+// Empties the board
+void FourPlayerChessBoard::clear() {
+    for (int square = 0; square < SQUARES; square++) {
+        squares[square] = EMPTY_SQUARE;
+    }
+
+    for (int player = 0; player < PLAYERS; player++) {
+        kingSquare[player] = -1;
+        material[player] = 0;
+        eliminated[player] = false;
+    }
+
+    currentPlayer = RED;
+    history.clear();
+}
+
+
+// Sets up the starting position
+void FourPlayerChessBoard::setStartPosition() {
+    clear();
+
+    for (int i = 0; i < 8; i++) {
+        int line = CORNER + i;
+
+        putPiece(RED, RED_GREEN_BACK_RANK[i], line);
+        putPiece(RED, PAWN, SIZE + line);
+
+        putPiece(YELLOW, BLUE_YELLOW_BACK_RANK[i], (SIZE - 1) * SIZE + line);
+        putPiece(YELLOW, PAWN, (SIZE - 2) * SIZE + line);
+
+        putPiece(BLUE, BLUE_YELLOW_BACK_RANK[i], line * SIZE);
+        putPiece(BLUE, PAWN, line * SIZE + 1);
+
+        putPiece(GREEN, RED_GREEN_BACK_RANK[i], line * SIZE + SIZE - 1);
+        putPiece(GREEN, PAWN, line * SIZE + SIZE - 2);
+    }
+}
+
+
+// Puts a piece on a square
+void FourPlayerChessBoard::putPiece(int player, PieceType type, int square) {
+    int old = squares[square];
+    if (old != EMPTY_SQUARE) {
+        material[old >> 3] -= PIECE_VALUES[old & 7];
+    }
+
+    squares[square] = static_cast<int8_t>(player * 8 + type);
+    material[player] += PIECE_VALUES[type];
+
+    if (type == KING) {
+        kingSquare[player] = square;
+    }
+}
+
+
+// Gets the piece on a square
+int FourPlayerChessBoard::getPiece(int square) const {
+    return squares[square];
+}
+
+
+// Gets the player to move
+int FourPlayerChessBoard::getCurrentPlayer() const {
+    return currentPlayer;
+}
+
+
+// Sets the player to move
+void FourPlayerChessBoard::setCurrentPlayer(int player) {
+    currentPlayer = player;
+}
+
+
+// Checks if a player is out of the game
+bool FourPlayerChessBoard::isEliminated(int player) const {
+    return eliminated[player];
+}
+
+
+// Takes a player out of the game
+void FourPlayerChessBoard::eliminatePlayer(int player) {
+    eliminated[player] = true;
+
+    if (currentPlayer == player) {
+        currentPlayer = nextActivePlayer(player);
+    }
+}
+
+
+// Counts the players still in the game
+int FourPlayerChessBoard::getActivePlayerCount() const {
+    int count = 0;
+
+    for (int player = 0; player < PLAYERS; player++) {
+        if (!eliminated[player]) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+// Gets a player's material
+int FourPlayerChessBoard::getMaterial(int player) const {
+    return material[player];
+}
+
+
+// Gets the next player still in the game
+int FourPlayerChessBoard::nextActivePlayer(int player) const {
+    for (int i = 1; i <= PLAYERS; i++) {
+        int next = (player + i) % PLAYERS;
+        if (!eliminated[next]) {
+            return next;
+        }
+    }
+
+    return player;
+}
+
+
+// Checks if any other player still in the game attacks a square
+bool FourPlayerChessBoard::isSquareAttacked(int square, int defender) const {
+    // Sliders and kings, looking out from the square to the first piece in each direction
+    for (int direction = 0; direction < 8; direction++) {
+        const uint8_t* ray = rayTable[square][direction];
+        int length = rayLength[square][direction];
+
+        for (int i = 0; i < length; i++) {
+            int piece = squares[ray[i]];
+            if (piece == EMPTY_SQUARE) {
+                continue;
+            }
+
+            int owner = piece >> 3;
+            int type = piece & 7;
+            if (owner != defender && !eliminated[owner]) {
+                if (type == QUEEN || type == (direction < 4 ? ROOK : BISHOP) || (i == 0 && type == KING)) {
+                    return true;
+                }
+            }
+            break;
+        }
+    }
+
+    for (int i = 0; i < knightCount[square]; i++) {
+        int piece = squares[knightTable[square][i]];
+        if (piece != EMPTY_SQUARE && (piece & 7) == KNIGHT && (piece >> 3) != defender && !eliminated[piece >> 3]) {
+            return true;
+        }
+    }
+
+    // Each player's pawns attack in their own direction
+    for (int player = 0; player < PLAYERS; player++) {
+        if (player == defender || eliminated[player]) {
+            continue;
+        }
+
+        for (int i = 0; i < pawnAttackerCount[player][square]; i++) {
+            if (squares[pawnAttackerTable[player][square][i]] == player * 8 + PAWN) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+// Checks if a player's king is attacked
+bool FourPlayerChessBoard::isInCheck(int player) const {
+    return kingSquare[player] >= 0 && isSquareAttacked(kingSquare[player], player);
+}
+
+
+// Generates every move for a player, without checking their king is safe. Kings are never captured.
+void FourPlayerChessBoard::generatePseudoLegalMoves(int player, FourPlayerMoveList& list) const {
+    list.count = 0;
+
+    for (int square = 0; square < SQUARES; square++) {
+        int piece = squares[square];
+        if (piece == EMPTY_SQUARE || (piece >> 3) != player) {
+            continue;
+        }
+
+        int type = piece & 7;
+
+        if (type == PAWN) {
+            int ahead = pawnPushTable[player][square];
+            if (ahead >= 0 && squares[ahead] == EMPTY_SQUARE) {
+                bool promotes = (player == RED || player == YELLOW ? ahead / SIZE : ahead % SIZE) == PROMOTION_LINE[player];
+                list.add(FourPlayerMove(square, ahead, promotes ? FourPlayerMove::PROMOTION : FourPlayerMove::QUIET));
+
+                // Two squares from the starting line
+                int line = (player == RED || player == YELLOW) ? square / SIZE : square % SIZE;
+                int twoAhead = pawnPushTable[player][ahead];
+                if (line == PAWN_START[player] && twoAhead >= 0 && squares[twoAhead] == EMPTY_SQUARE) {
+                    list.add(FourPlayerMove(square, twoAhead, FourPlayerMove::QUIET));
+                }
+            }
+
+            for (int i = 0; i < pawnCaptureCount[player][square]; i++) {
+                int target = pawnCaptureTable[player][square][i];
+                int captured = squares[target];
+                if (captured != EMPTY_SQUARE && (captured >> 3) != player && (captured & 7) != KING) {
+                    bool promotes = (player == RED || player == YELLOW ? target / SIZE : target % SIZE) == PROMOTION_LINE[player];
+                    list.add(FourPlayerMove(square, target, FourPlayerMove::CAPTURE | (promotes ? FourPlayerMove::PROMOTION : 0)));
+                }
+            }
+        }
+        else if (type == KNIGHT || type == KING) {
+            const uint8_t* targets = (type == KNIGHT) ? knightTable[square] : kingTable[square];
+            int count = (type == KNIGHT) ? knightCount[square] : kingCount[square];
+
+            for (int i = 0; i < count; i++) {
+                int target = targets[i];
+                int captured = squares[target];
+                if (captured == EMPTY_SQUARE) {
+                    list.add(FourPlayerMove(square, target, FourPlayerMove::QUIET));
+                }
+                else if ((captured >> 3) != player && (captured & 7) != KING) {
+                    list.add(FourPlayerMove(square, target, FourPlayerMove::CAPTURE));
+                }
+            }
+        }
+        else {
+            int firstDirection = (type == BISHOP) ? 4 : 0;
+            int lastDirection = (type == ROOK) ? 4 : 8;
+
+            for (int direction = firstDirection; direction < lastDirection; direction++) {
+                const uint8_t* ray = rayTable[square][direction];
+                int length = rayLength[square][direction];
+
+                for (int i = 0; i < length; i++) {
+                    int target = ray[i];
+                    int captured = squares[target];
+                    if (captured == EMPTY_SQUARE) {
+                        list.add(FourPlayerMove(square, target, FourPlayerMove::QUIET));
+                        continue;
+                    }
+
+                    if ((captured >> 3) != player && (captured & 7) != KING) {
+                        list.add(FourPlayerMove(square, target, FourPlayerMove::CAPTURE));
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
+// Generates every legal move, trying each pseudo-legal move on the board and keeping those that leave the king safe
+void FourPlayerChessBoard::generateLegalMoves(FourPlayerMoveList& list) {
+    FourPlayerMoveList pseudoLegal;
+    generatePseudoLegalMoves(currentPlayer, pseudoLegal);
+
+    list.count = 0;
+    for (const FourPlayerMove& move : pseudoLegal) {
+        int8_t moved = squares[move.from];
+        int8_t captured = squares[move.to];
+
+        squares[move.to] = moved;
+        squares[move.from] = EMPTY_SQUARE;
+
+        int king = ((moved & 7) == KING) ? move.to : kingSquare[currentPlayer];
+        if (!isSquareAttacked(king, currentPlayer)) {
+            list.add(move);
+        }
+
+        squares[move.from] = moved;
+        squares[move.to] = captured;
+    }
+}
+
+
+// Makes a move and passes the turn on
+void FourPlayerChessBoard::makeMove(FourPlayerMove move) {
+    UndoState undo;
+    undo.move = move;
+    undo.moved = EMPTY_SQUARE;
+    undo.captured = EMPTY_SQUARE;
+    undo.player = static_cast<uint8_t>(currentPlayer);
+
+    if (!move.isNull()) {
+        undo.moved = squares[move.from];
+        undo.captured = squares[move.to];
+
+        if (undo.captured != EMPTY_SQUARE) {
+            material[undo.captured >> 3] -= PIECE_VALUES[undo.captured & 7];
+        }
+
+        if (move.isPromotion()) {
+            squares[move.to] = static_cast<int8_t>(currentPlayer * 8 + QUEEN);
+            material[currentPlayer] += PIECE_VALUES[QUEEN] - PIECE_VALUES[PAWN];
+        }
+        else {
+            squares[move.to] = undo.moved;
+        }
+        squares[move.from] = EMPTY_SQUARE;
+
+        if ((undo.moved & 7) == KING) {
+            kingSquare[currentPlayer] = move.to;
+        }
+    }
+
+    history.push_back(undo);
+    currentPlayer = nextActivePlayer(currentPlayer);
+}
+
+
+// Takes back the last move
+void FourPlayerChessBoard::unmakeMove() {
+    if (history.empty()) {
+        return;
+    }
+
+    UndoState undo = history.back();
+    history.pop_back();
+
+    currentPlayer = undo.player;
+    FourPlayerMove move = undo.move;
+
+    if (move.isNull()) {
+        return;
+    }
+
+    if (move.isPromotion()) {
+        material[currentPlayer] -= PIECE_VALUES[QUEEN] - PIECE_VALUES[PAWN];
+    }
+
+    squares[move.from] = undo.moved;
+    squares[move.to] = undo.captured;
+
+    if (undo.captured != EMPTY_SQUARE) {
+        material[undo.captured >> 3] += PIECE_VALUES[undo.captured & 7];
+    }
+
+    if ((undo.moved & 7) == KING) {
+        kingSquare[currentPlayer] = move.from;
+    }
+}
+
+
+// Counts leaf nodes to a depth, counting the last ply straight from the move list
+uint64_t FourPlayerChessBoard::perft(int depth) {
+    FourPlayerMoveList list;
+    generateLegalMoves(list);
+
+    if (depth <= 1) {
+        return depth == 1 ? list.size() : 1;
+    }
+
+    uint64_t count = 0;
+    for (const FourPlayerMove& move : list) {
+        makeMove(move);
+        count += perft(depth - 1);
+        unmakeMove();
+    }
+
+    return count;
+}
+
+
+// Scores the position for one player: material and centralisation, less the average of their opponents
+int FourPlayerChessBoard::evaluate(int player) const {
+    if (eliminated[player]) {
+        return -MATE_SCORE;
+    }
+
+    int scores[PLAYERS] = { material[0], material[1], material[2], material[3] };
+    for (int square = 0; square < SQUARES; square++) {
+        int piece = squares[square];
+        if (piece != EMPTY_SQUARE && (piece & 7) != KING) {
+            scores[piece >> 3] += centreTable[square];
+        }
+    }
+
+    int opponents = 0;
+    int opponentTotal = 0;
+    for (int other = 0; other < PLAYERS; other++) {
+        if (other != player && !eliminated[other]) {
+            opponents++;
+            opponentTotal += scores[other];
+        }
+    }
+
+    if (opponents == 0) {
+        return MATE_SCORE;
+    }
+
+    return scores[player] - opponentTotal / opponents;
+}
+
+
+// Orders captures first, most valuable victim first, so alpha-beta cuts off sooner
+static void orderMoves(FourPlayerMoveList& list, const int8_t* squares) {
+    int keys[FourPlayerMoveList::MAX_MOVES];
+
+    for (int i = 0; i < list.size(); i++) {
+        int captured = squares[list[i].to];
+        keys[i] = (captured == FourPlayerChessBoard::EMPTY_SQUARE ? 0 : PIECE_VALUES[captured & 7]) + (list[i].isPromotion() ? PIECE_VALUES[QUEEN] : 0);
+    }
+
+    for (int i = 1; i < list.size(); i++) {
+        FourPlayerMove move = list[i];
+        int key = keys[i];
+        int j = i - 1;
+
+        while (j >= 0 && keys[j] < key) {
+            list[j + 1] = list[j];
+            keys[j + 1] = keys[j];
+            j--;
+        }
+
+        list[j + 1] = move;
+        keys[j + 1] = key;
+    }
+}
+
+
+// Paranoid search: the root player maximises and the others all minimise the root player's score
+int FourPlayerChessBoard::paranoid(int depth, int alpha, int beta, int rootPlayer) {
+    nodes++;
+
+    if (depth == 0 || getActivePlayerCount() == 1) {
+        return evaluate(rootPlayer);
+    }
+
+    FourPlayerMoveList list;
+    generateLegalMoves(list);
+
+    // A player with no moves is out. For an opponent the search carries on without them.
+    if (list.size() == 0) {
+        int player = currentPlayer;
+        if (player == rootPlayer) {
+            return -MATE_SCORE;
+        }
+
+        eliminated[player] = true;
+        currentPlayer = nextActivePlayer(player);
+        int score = paranoid(depth - 1, alpha, beta, rootPlayer);
+        eliminated[player] = false;
+        currentPlayer = player;
+
+        return score;
+    }
+
+    orderMoves(list, squares);
+    bool maximising = (currentPlayer == rootPlayer);
+
+    for (const FourPlayerMove& move : list) {
+        makeMove(move);
+        int score = paranoid(depth - 1, alpha, beta, rootPlayer);
+        unmakeMove();
+
+        if (maximising) {
+            if (score > alpha) {
+                alpha = score;
+            }
+        }
+        else if (score < beta) {
+            beta = score;
+        }
+
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    return maximising ? alpha : beta;
+}
+
+
+// Max-n search: every player picks the move best for their own score
+void FourPlayerChessBoard::maxN(int depth, int scores[PLAYERS]) {
+    nodes++;
+
+    if (depth == 0 || getActivePlayerCount() == 1) {
+        for (int player = 0; player < PLAYERS; player++) {
+            scores[player] = evaluate(player);
+        }
+        return;
+    }
+
+    FourPlayerMoveList list;
+    generateLegalMoves(list);
+
+    int player = currentPlayer;
+
+    if (list.size() == 0) {
+        eliminated[player] = true;
+        currentPlayer = nextActivePlayer(player);
+        maxN(depth - 1, scores);
+        eliminated[player] = false;
+        currentPlayer = player;
+        return;
+    }
+
+    orderMoves(list, squares);
+    int childScores[PLAYERS];
+    scores[player] = -INFINITE_SCORE;
+
+    for (const FourPlayerMove& move : list) {
+        makeMove(move);
+        maxN(depth - 1, childScores);
+        unmakeMove();
+
+        if (childScores[player] > scores[player]) {
+            for (int i = 0; i < PLAYERS; i++) {
+                scores[i] = childScores[i];
+            }
+        }
+    }
+}
+
+
+// Finds the best move for the player to move
+FourPlayerMove FourPlayerChessBoard::findBestMove(int depth, SearchMode mode) {
+    FourPlayerMoveList list;
+    generateLegalMoves(list);
+    orderMoves(list, squares);
+
+    nodes = 0;
+    int rootPlayer = currentPlayer;
+    FourPlayerMove best;
+    int bestScore = -INFINITE_SCORE;
+
+    for (const FourPlayerMove& move : list) {
+        int score;
+
+        makeMove(move);
+        if (mode == PARANOID) {
+            score = paranoid(depth - 1, bestScore, INFINITE_SCORE, rootPlayer);
+        }
+        else {
+            int scores[PLAYERS];
+            maxN(depth - 1, scores);
+            score = scores[rootPlayer];
+        }
+        unmakeMove();
+
+        if (best.isNull() || score > bestScore) {
+            best = move;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+
+// Gets the number of positions visited by the last search
+uint64_t FourPlayerChessBoard::getNodeCount() const {
+    return nodes;
+}
+
+
+// Measures legal move generation speed over every player still in the game
+double FourPlayerChessBoard::benchmarkMoveGeneration(int iterations) {
+    FourPlayerMoveList list;
+    int savedPlayer = currentPlayer;
+    uint64_t generated = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++) {
+        for (int player = 0; player < PLAYERS; player++) {
+            if (eliminated[player]) {
+                continue;
+            }
+
+            currentPlayer = player;
+            generateLegalMoves(list);
+            generated += list.size();
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    currentPlayer = savedPlayer;
+
+    return elapsed.count() > 0 ? generated / elapsed.count() : 0.0;
+}
+
+
+// Converts a square to its name
+std::string FourPlayerChessBoard::squareToString(int square) {
+    return std::string(1, static_cast<char>('a' + square % SIZE)) + std::to_string(square / SIZE + 1);
+}
+
+
+// Converts a square name to a square
+int FourPlayerChessBoard::parseSquare(const std::string& text) {
+    if (text.size() < 2 || text.size() > 3 || text[0] < 'a' || text[0] >= 'a' + SIZE) {
+        return -1;
+    }
+
+    int rank = 0;
+    for (size_t i = 1; i < text.size(); i++) {
+        if (text[i] < '0' || text[i] > '9') {
+            return -1;
+        }
+        rank = rank * 10 + (text[i] - '0');
+    }
+
+    int row = rank - 1;
+    int column = text[0] - 'a';
+    if (!isValidSquare(row, column)) {
+        return -1;
+    }
+
+    return row * SIZE + column;
+}
+
+
+// Converts a move to coordinate notation
+std::string FourPlayerChessBoard::moveToString(FourPlayerMove move) {
+    if (move.isNull()) {
+        return "0000";
+    }
+
+    return squareToString(move.from) + squareToString(move.to);
+}
+
+
+// Finds the legal move matching a move in coordinate notation
+FourPlayerMove FourPlayerChessBoard::parseMove(const std::string& text) {
+    FourPlayerMoveList list;
+    generateLegalMoves(list);
+
+    for (const FourPlayerMove& move : list) {
+        if (moveToString(move) == text) {
+            return move;
+        }
+    }
+
+    return FourPlayerMove();
+}
@@ -0,0 +1,357 @@
+#ifndef FOUR_PLAYER_CHESS_H
+#define FOUR_PLAYER_CHESS_H
+
+/*!
+* @file fourPlayerChess.h
+* @brief Contains the declaration of the FourPlayerChessBoard class, the rules and AI of four player chess.
+* @details The board is 14 by 14 with a 3 by 3 block cut from each corner, leaving 160 playable squares.
+* @details Squares are numbered row * 14 + column, with row 0 at Red's back rank and column 0 on Blue's side.
+*/
+
+#include "chessBoard.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+* @struct FourPlayerMove
+* @brief A four player chess move, one byte each for the from and to squares and the flags.
+*/
+struct FourPlayerMove {
+	static const int QUIET = 0; /*!< A quiet move. */
+	static const int CAPTURE = 1; /*!< A capture. */
+	static const int PROMOTION = 2; /*!< A pawn promoting to a queen. */
+
+	uint8_t from; /*!< The square the piece moves from. */
+	uint8_t to; /*!< The square the piece moves to. */
+	uint8_t flags; /*!< The move flags. */
+
+	/*!
+	* @brief Default constructor, creates the null move, which passes the turn.
+	*/
+	FourPlayerMove() : from(0), to(0), flags(0) {}
+
+	/*!
+	* @brief Constructor for FourPlayerMove.
+	* @param from The square the piece moves from.
+	* @param to The square the piece moves to.
+	* @param flags The move flags.
+	*/
+	FourPlayerMove(int from, int to, int flags) : from(static_cast<uint8_t>(from)), to(static_cast<uint8_t>(to)), flags(static_cast<uint8_t>(flags)) {}
+
+	/*!
+	* @brief Check if the move captures a piece.
+	* @return True if the move is a capture.
+	*/
+	bool isCapture() const { return (flags & CAPTURE) != 0; }
+
+	/*!
+	* @brief Check if the move promotes a pawn.
+	* @return True if the move is a promotion.
+	*/
+	bool isPromotion() const { return (flags & PROMOTION) != 0; }
+
+	/*!
+	* @brief Check if this is the null move.
+	* @return True if the move is empty.
+	*/
+	bool isNull() const { return from == to; }
+
+	bool operator==(const FourPlayerMove& other) const { return from == other.from && to == other.to && flags == other.flags; }
+	bool operator!=(const FourPlayerMove& other) const { return !(*this == other); }
+};
+
+/*!
+* @struct FourPlayerMoveList
+* @brief A fixed size list of moves, so generating moves never allocates.
+*/
+struct FourPlayerMoveList {
+	static const int MAX_MOVES = 512; /*!< More than the most moves possible for one player. */
+
+	FourPlayerMove moves[MAX_MOVES]; /*!< The moves. */
+	int count = 0; /*!< The number of moves in the list. */
+
+	/*!
+	* @brief Add a move to the list.
+	* @param move The move to add.
+	*/
+	void add(FourPlayerMove move) { moves[count++] = move; }
+
+	/*!
+	* @brief Get the number of moves in the list.
+	* @return The number of moves.
+	*/
+	int size() const { return count; }
+
+	FourPlayerMove* begin() { return moves; }
+	FourPlayerMove* end() { return moves + count; }
+	const FourPlayerMove* begin() const { return moves; }
+	const FourPlayerMove* end() const { return moves + count; }
+	FourPlayerMove& operator[](int index) { return moves[index]; }
+	const FourPlayerMove& operator[](int index) const { return moves[index]; }
+};
+
+/*!
+* @class FourPlayerChessBoard
+* @brief A four player chess position held in a dense 196 square array, with make/unmake, legal move generation and search.
+* @details Red, Blue, Yellow and Green move in turn, starting at the bottom and going clockwise.
+* @details Sliding, knight, king and pawn moves come from tables built once, which already leave out the cut corners.
+* @details Pawns promote to a queen on reaching the middle of the board (their eighth rank). There is no castling or en passant.
+* @details A player with no legal moves is out of the game; their pieces stay on the board but no longer move or give check.
+*/
+class FourPlayerChessBoard {
+public:
+	static const int SIZE = 14; /*!< The width and height of the board. */
+	static const int SQUARES = SIZE * SIZE; /*!< The number of squares in the array, including the cut corners. */
+	static const int CORNER = 3; /*!< The width of the block cut from each corner. */
+	static const int PLAYERS = 4; /*!< The number of players. */
+
+	static const int RED = 0; /*!< Index of the red player, at the bottom. */
+	static const int BLUE = 1; /*!< Index of the blue player, on the left. */
+	static const int YELLOW = 2; /*!< Index of the yellow player, at the top. */
+	static const int GREEN = 3; /*!< Index of the green player, on the right. */
+
+	static const int EMPTY_SQUARE = -1; /*!< The value of an empty square. */
+	static const int MATE_SCORE = 1000000; /*!< The score of a player with no legal moves. */
+
+	/*!
+	* @enum SearchMode
+	* @brief The ways the AI can search.
+	*/
+	enum SearchMode {
+		PARANOID, /*!< Assume every opponent plays against the searching player, which allows alpha-beta pruning. */
+		MAX_N /*!< Assume every player plays for their own score. */
+	};
+
+private:
+	/*!
+	* @struct UndoState
+	* @brief The state needed to take back one move.
+	*/
+	struct UndoState {
+		FourPlayerMove move; /*!< The move that was made. */
+		int8_t moved; /*!< The piece that moved. */
+		int8_t captured; /*!< The piece that was captured, or EMPTY_SQUARE. */
+		uint8_t player; /*!< The player who made the move. */
+	};
+
+	int8_t squares[SQUARES]; /*!< The piece on each square as player * 8 + type, or EMPTY_SQUARE. */
+	int kingSquare[PLAYERS]; /*!< The square of each player's king. */
+	int material[PLAYERS]; /*!< The material of each player, kept up to date by make and unmake. */
+	bool eliminated[PLAYERS]; /*!< Whether each player is out of the game. */
+	int currentPlayer; /*!< The player to move. */
+
+	std::vector<UndoState> history; /*!< One entry per move made. */
+	uint64_t nodes; /*!< The number of positions visited by the last search. */
+
+	/*!
+	* @brief Get the next player still in the game after a player.
+	* @param player The player.
+	* @return The next player in turn order that is not eliminated.
+	*/
+	int nextActivePlayer(int player) const;
+
+	/*!
+	* @brief Generate every move for a player without checking whether it leaves their king attacked.
+	* @param player The player.
+	* @param list The list to add the moves to.
+	*/
+	void generatePseudoLegalMoves(int player, FourPlayerMoveList& list) const;
+
+	/*!
+	* @brief Score the position for one player: their material less the average of their opponents.
+	* @param player The player.
+	* @return The score, in centipawns.
+	*/
+	int evaluate(int player) const;
+
+	/*!
+	* @brief The paranoid search, with the root player maximising and every other player minimising.
+	* @param depth The plies left to search.
+	* @param alpha The lower bound of the window.
+	* @param beta The upper bound of the window.
+	* @param rootPlayer The player the search is for.
+	* @return The score of the position for the root player.
+	*/
+	int paranoid(int depth, int alpha, int beta, int rootPlayer);
+
+	/*!
+	* @brief The max-n search, with each player maximising their own score.
+	* @param depth The plies left to search.
+	* @param scores Set to the score of each player at the end of the best line.
+	*/
+	void maxN(int depth, int scores[PLAYERS]);
+
+public:
+	/*!
+	* @brief Constructor for the FourPlayerChessBoard class, sets up the starting position.
+	*/
+	FourPlayerChessBoard();
+
+	/*!
+	* @brief Build the move tables. Called by the constructor, and safe to call from any thread.
+	*/
+	static void initialiseTables();
+
+	/*!
+	* @brief Check if a square is on the board, that is not in one of the cut corners.
+	* @param row The row.
+	* @param column The column.
+	* @return True if the square is playable.
+	*/
+	static bool isValidSquare(int row, int column);
+
+	/*!
+	* @brief Set up the starting position.
+	*/
+	void setStartPosition();
+
+	/*!
+	* @brief Empty the board, with every player in the game and Red to move.
+	* @details Each player needs a king put on the board before moves are generated.
+	*/
+	void clear();
+
+	/*!
+	* @brief Put a piece on a square, replacing what is there.
+	* @param player The player who owns the piece.
+	* @param type The type of piece.
+	* @param square The square.
+	*/
+	void putPiece(int player, PieceType type, int square);
+
+	/*!
+	* @brief Get the piece on a square.
+	* @param square The square.
+	* @return The piece as player * 8 + type, or EMPTY_SQUARE.
+	*/
+	int getPiece(int square) const;
+
+	/*!
+	* @brief Get the player to move.
+	* @return The player index.
+	*/
+	int getCurrentPlayer() const;
+
+	/*!
+	* @brief Set the player to move.
+	* @param player The player index.
+	*/
+	void setCurrentPlayer(int player);
+
+	/*!
+	* @brief Check if a player is out of the game.
+	* @param player The player index.
+	* @return True if the player has been eliminated.
+	*/
+	bool isEliminated(int player) const;
+
+	/*!
+	* @brief Take a player out of the game, passing the turn on if it was theirs.
+	* @param player The player index.
+	*/
+	void eliminatePlayer(int player);
+
+	/*!
+	* @brief Count the players still in the game.
+	* @return The number of players not eliminated.
+	*/
+	int getActivePlayerCount() const;
+
+	/*!
+	* @brief Get a player's material.
+	* @param player The player index.
+	* @return The value of the player's pieces, in centipawns, not counting the king.
+	*/
+	int getMaterial(int player) const;
+
+	/*!
+	* @brief Check if any player still in the game, other than the defender, attacks a square.
+	* @param square The square.
+	* @param defender The player defending the square.
+	* @return True if the square is attacked.
+	*/
+	bool isSquareAttacked(int square, int defender) const;
+
+	/*!
+	* @brief Check if a player's king is attacked.
+	* @param player The player index.
+	* @return True if the player is in check.
+	*/
+	bool isInCheck(int player) const;
+
+	/*!
+	* @brief Generate every legal move for the player to move.
+	* @param list The list to fill.
+	*/
+	void generateLegalMoves(FourPlayerMoveList& list);
+
+	/*!
+	* @brief Make a move and pass the turn to the next player still in the game.
+	* @param move The move, which must be legal, or the null move to pass.
+	*/
+	void makeMove(FourPlayerMove move);
+
+	/*!
+	* @brief Take back the last move.
+	*/
+	void unmakeMove();
+
+	/*!
+	* @brief Count the leaf nodes of the legal move tree to a given depth.
+	* @param depth The depth to search to, in plies.
+	* @return The number of leaf nodes.
+	*/
+	uint64_t perft(int depth);
+
+	/*!
+	* @brief Find the best move for the player to move.
+	* @param depth The depth to search to, in plies. Four plies is one move by each player.
+	* @param mode Whether to search with the paranoid or max-n assumption.
+	* @return The best move, or the null move if the player has no legal moves.
+	*/
+	FourPlayerMove findBestMove(int depth, SearchMode mode);
+
+	/*!
+	* @brief Get the number of positions visited by the last search.
+	* @return The node count.
+	*/
+	uint64_t getNodeCount() const;
+
+	/*!
+	* @brief Measure move generation speed by generating legal moves for every player repeatedly.
+	* @param iterations The number of times to generate each player's moves.
+	* @return The number of legal moves generated per second.
+	*/
+	double benchmarkMoveGeneration(int iterations);
+
+	/*!
+	* @brief Convert a move to coordinate notation, such as "d2d4".
+	* @param move The move.
+	* @return The move as a string.
+	*/
+	static std::string moveToString(FourPlayerMove move);
+
+	/*!
+	* @brief Find the legal move matching a move in coordinate notation.
+	* @param text The move, such as "d2d4" or "a7b7".
+	* @return The matching legal move, or the null move if there is none.
+	*/
+	FourPlayerMove parseMove(const std::string& text);
+
+	/*!
+	* @brief Convert a square to its name, such as "h14".
+	* @param square The square.
+	* @return The name of the square.
+	*/
+	static std::string squareToString(int square);
+
+	/*!
+	* @brief Convert a square name, such as "h14", to a square.
+	* @param text The name of the square.
+	* @return The square, or -1 if the name is not a playable square.
+	*/
+	static int parseSquare(const std::string& text);
+};
+
+#endif // !FOUR_PLAYER_CHESS_H
@@ -0,0 +1,77 @@
+#include "gameRegistry.h"
+#include <stdexcept>
+#include <string>
+
+
+// Constructor for the GameRegistry class
+GameRegistry::GameRegistry() : builtCount(0) {
+}
+
+
+// Adds a slot, unless the number is taken
+void GameRegistry::insert(int id, std::unique_ptr<Slot> slot) {
+    if (!slots.emplace(id, std::move(slot)).second) {
+        throw std::runtime_error("A game is already offered as number " + std::to_string(id));
+    }
+}
+
+
+// Plays a game, building it on first use and tearing it down after if it is to be
+int GameRegistry::run(int id) {
+    auto found = slots.find(id);
+    if (found == slots.end()) {
+        throw std::runtime_error("No game is offered as number " + std::to_string(id));
+    }
+
+    Slot& slot = *found->second;
+    int output;
+    try {
+        output = slot.play();
+    }
+    catch (...) {
+        // A game that failed part way through is in no state to be played again
+        slot.release();
+        throw;
+    }
+
+    if (slot.releaseOnExit) {
+        slot.release();
+    }
+    return output;
+}
+
+
+// Checks if a game has been built
+bool GameRegistry::isLoaded(int id) const {
+    auto found = slots.find(id);
+    return found != slots.end() && found->second->isLoaded();
+}
+
+
+// Counts the games that have been built
+int GameRegistry::getLoadedCount() const {
+    int count = 0;
+    for (const auto& slot : slots) {
+        if (slot.second->isLoaded()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+
+// Tears a game down
+void GameRegistry::release(int id) {
+    auto found = slots.find(id);
+    if (found != slots.end()) {
+        found->second->release();
+    }
+}
+
+
+// Tears every game down
+void GameRegistry::releaseAll() {
+    for (auto& slot : slots) {
+        slot.second->release();
+    }
+}
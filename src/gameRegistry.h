@@ -0,0 +1,171 @@
+#ifndef GAME_REGISTRY_H
+#define GAME_REGISTRY_H
+
+/*!
+* @file gameRegistry.h
+* @brief Contains the declaration of the GameRegistry class, which builds each game the first time it is chosen.
+*/
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+
+/*!
+* @class GameRegistry
+* @brief The games on offer, each kept as a way to build it and a way to play it until it is first chosen.
+* @details Building every game up front costs the time and memory of all of them, and a console screen buffer for
+* @details each that holds one of its own, before the player has picked any. Here nothing is built until a game is
+* @details chosen, and a game can be torn down again once it is over, so only the game being played is ever held.
+*/
+class GameRegistry {
+	/*!
+	* @class Slot
+	* @brief A game that may or may not have been built yet.
+	*/
+	class Slot {
+	public:
+		bool releaseOnExit; /*!< Whether to tear the game down once each play is over. */
+
+		/*!
+		* @brief Constructor for Slot.
+		* @param releaseOnExit Whether to tear the game down once each play is over.
+		*/
+		explicit Slot(bool releaseOnExit) : releaseOnExit(releaseOnExit) {}
+
+		virtual ~Slot() = default;
+
+		/*!
+		* @brief Play the game, building it first if it has not been.
+		* @return What the game returned.
+		*/
+		virtual int play() = 0;
+
+		/*!
+		* @brief Tear the game down, if it has been built.
+		*/
+		virtual void release() = 0;
+
+		/*!
+		* @brief Check if the game has been built.
+		* @return true if it has.
+		*/
+		virtual bool isLoaded() const = 0;
+	};
+
+	/*!
+	* @class GameSlot
+	* @brief A Slot for one type of game.
+	*
+	* @tparam Game The game.
+	*/
+	template <class Game>
+	class GameSlot : public Slot {
+		std::function<std::unique_ptr<Game>()> create; /*!< Builds the game. */
+		std::function<int(Game&)> start; /*!< Plays the game. */
+		std::unique_ptr<Game> game; /*!< The game, or null until it is built. */
+
+	public:
+		/*!
+		* @brief Constructor for GameSlot.
+		* @param create Builds the game.
+		* @param start Plays the game.
+		* @param releaseOnExit Whether to tear the game down once each play is over.
+		*/
+		GameSlot(std::function<std::unique_ptr<Game>()> create, std::function<int(Game&)> start, bool releaseOnExit)
+			: Slot(releaseOnExit), create(std::move(create)), start(std::move(start)) {}
+
+		int play() override {
+			if (!game) {
+				game = create();
+			}
+			return start(*game);
+		}
+
+		void release() override { game.reset(); }
+
+		bool isLoaded() const override { return game != nullptr; }
+	};
+
+	std::map<int, std::unique_ptr<Slot>> slots; /*!< The games by the number they are chosen by. */
+	int builtCount; /*!< The number of times a game has been built. */
+
+public:
+	/*!
+	* @brief Constructor for GameRegistry.
+	*/
+	GameRegistry();
+
+	/*!
+	* @brief Offer a game, without building it.
+	* @param id The number the game is chosen by.
+	* @param create Builds the game.
+	* @param start Plays the game, returning what the menu should do next.
+	* @param releaseOnExit Whether to tear the game down once each play is over, rather than keep it for the next.
+	* @throws std::runtime_error if a game is already offered by that number.
+	*/
+	template <class Game>
+	void add(int id, std::function<std::unique_ptr<Game>()> create, std::function<int(Game&)> start, bool releaseOnExit) {
+		auto counted = [this, create]() {
+			builtCount++;
+			return create();
+		};
+		insert(id, std::unique_ptr<Slot>(new GameSlot<Game>(counted, std::move(start), releaseOnExit)));
+	}
+
+	/*!
+	* @brief Play a game, building it first if it has not been and tearing it down after if it is to be.
+	* @param id The number the game is chosen by.
+	* @return What the game returned.
+	* @throws std::runtime_error if no game is offered by that number.
+	*/
+	int run(int id);
+
+	/*!
+	* @brief Check if a game is offered by a number.
+	* @param id The number.
+	* @return true if one is.
+	*/
+	bool contains(int id) const { return slots.count(id) != 0; }
+
+	/*!
+	* @brief Check if a game has been built and not torn down since.
+	* @param id The number the game is chosen by.
+	* @return true if it is built, false if not or no game is offered by that number.
+	*/
+	bool isLoaded(int id) const;
+
+	/*!
+	* @brief Get the number of games built and not torn down.
+	* @return The count.
+	*/
+	int getLoadedCount() const;
+
+	/*!
+	* @brief Get the number of times a game has been built, counting a game again each time it is built anew.
+	* @return The count.
+	*/
+	int getBuiltCount() const { return builtCount; }
+
+	/*!
+	* @brief Tear a game down, if it has been built.
+	* @param id The number the game is chosen by.
+	*/
+	void release(int id);
+
+	/*!
+	* @brief Tear every game down.
+	*/
+	void releaseAll();
+
+private:
+	/*!
+	* @brief Add a slot.
+	* @param id The number the game is chosen by.
+	* @param slot The slot.
+	* @throws std::runtime_error if a game is already offered by that number.
+	*/
+	void insert(int id, std::unique_ptr<Slot> slot);
+};
+
+#endif // GAME_REGISTRY_H
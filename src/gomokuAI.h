@@ -0,0 +1,427 @@
+#ifndef GOMOKU_AI_H
+#define GOMOKU_AI_H
+
+/*!
+* @file gomokuAI.h
+* @brief Contains the GomokuAI class template, which plays five in a row on large boards by threat-space search,
+* @brief falling back to a pruned alpha-beta search.
+*/
+
+#include "gomokuPatterns.h"
+#include "mnkBoard.h"
+#include "mnkSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+/*!
+* @class GomokuAI
+* @brief Chooses moves for Gomoku on boards too big to search every empty cell.
+* @details Threats are read from GomokuPatterns, one lookup per line through a cell. A move is chosen by trying, in
+* @details order: making five; blocking the opponent's five; a win by continuous fours (VCF), where every move is a
+* @details four so each reply is forced; a win by continuous threats (VCT), which also allows open threes and
+* @details answers them with the few cells that stop them or with a counter-four; and last, an alpha-beta search
+* @details over only the most threatening cells near the stones, ranked by their patterns for both players.
+*
+* @tparam Board An MnkBoard with K of 5 and no gravity.
+*/
+template <class Board>
+class GomokuAI {
+	static_assert(Board::WIN_LENGTH == 5 && !Board::GRAVITY, "GomokuAI plays five in a row without gravity");
+
+public:
+	static const int MAX_CANDIDATES = 12; /*!< The most moves tried at each position of the alpha-beta search. */
+	static const int VCF_DEPTH = 16; /*!< The most fours in a row tried for a VCF. */
+	static const int VCT_DEPTH = 4; /*!< The most threats in a row tried for a VCT. */
+
+	static const int FIVE = 0; /*!< chooseMove made five. */
+	static const int BLOCK = 1; /*!< chooseMove blocked the opponent's five. */
+	static const int VCF = 2; /*!< chooseMove found a win by continuous fours. */
+	static const int VCT = 3; /*!< chooseMove found a win by continuous threats. */
+	static const int SEARCH = 4; /*!< chooseMove fell back to alpha-beta. */
+
+	/*!
+	* @struct Policy
+	* @brief The moves and evaluation for MnkSearch: the cells with the strongest patterns, and the sum of them.
+	*/
+	struct Policy : MnkBoardPolicy<Board> {
+		/*!
+		* @brief Get the moves worth searching, strongest first.
+		* @details A five to make or block is the only move that matters; otherwise the best MAX_CANDIDATES cells.
+		* @param board The board.
+		* @param moves Set to the moves.
+		* @return The number of moves.
+		*/
+		static int generateMoves(const Board& board, int* moves) {
+			int count = board.generateMoves(moves);
+			if (count <= 1) {
+				return count;
+			}
+
+			int me = board.getTurn();
+			int scores[Board::CELLS];
+			int order[Board::CELLS];
+			for (int i = 0; i < count; i++) {
+				scores[i] = cellScore(board, moves[i], me) + cellScore(board, moves[i], 3 - me) / 2;
+				order[i] = i;
+			}
+
+			int kept = std::min(count, static_cast<int>(MAX_CANDIDATES));
+			std::partial_sort(order, order + kept, order + count, [&](int a, int b) { return scores[a] > scores[b]; });
+
+			int sorted[Board::CELLS];
+			for (int i = 0; i < kept; i++) {
+				sorted[i] = moves[order[i]];
+			}
+
+			// A five is taken, and the opponent's five must be blocked
+			if (bestThreat(board, sorted[0], me) == GomokuPatterns::FIVE || bestThreat(board, sorted[0], 3 - me) == GomokuPatterns::FIVE) {
+				kept = 1;
+			}
+			std::copy(sorted, sorted + kept, moves);
+			return kept;
+		}
+
+		/*!
+		* @brief Score a position by the patterns each player could make in the cells near the stones.
+		* @param board The board.
+		* @return The score for the player to move, who counts for a little more as they move first.
+		*/
+		static int evaluate(const Board& board) {
+			int moves[Board::CELLS];
+			int count = board.generateMoves(moves);
+			int me = board.getTurn();
+			int score = 0;
+
+			for (int i = 0; i < count; i++) {
+				score += (cellScore(board, moves[i], me) * 5) / 4 - cellScore(board, moves[i], 3 - me);
+			}
+			return score;
+		}
+	};
+
+private:
+	MnkSearch<Board, Policy> search; /*!< The alpha-beta search for quiet positions. */
+	uint64_t threatNodes; /*!< The positions looked at by the threat-space searches of the last move. */
+	uint64_t threatNodeLimit; /*!< Stop a threat-space search after this many positions. */
+	int reason; /*!< Why the last move was chosen, FIVE to SEARCH. */
+
+	/*!
+	* @brief Get the weight of a threat, for ranking cells.
+	* @param threat The threat.
+	* @return The weight.
+	*/
+	static int weight(int threat) {
+		static const int weights[7] = { 0, 10, 40, 400, 500, 10000, 100000 };
+		return weights[threat];
+	}
+
+	/*!
+	* @brief Collect the empty cells near the lines through a cell where a player would make five.
+	* @param board The board.
+	* @param cell The cell whose lines to look along.
+	* @param player The player.
+	* @param points Set to up to two of the cells.
+	* @return The number found, at most two.
+	*/
+	static int fivePointsAround(const Board& board, int cell, int player, int points[2]) {
+		static const int steps[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+		int count = 0;
+		int x = cell % Board::WIDTH, y = cell / Board::WIDTH;
+
+		for (int direction = 0; direction < 4; direction++) {
+			for (int offset = -GomokuPatterns::RADIUS; offset <= GomokuPatterns::RADIUS; offset++) {
+				int cx = x + steps[direction][0] * offset, cy = y + steps[direction][1] * offset;
+				if (cx < 0 || cx >= Board::WIDTH || cy < 0 || cy >= Board::HEIGHT || board.get(cx, cy)) {
+					continue;
+				}
+
+				int other = cy * Board::WIDTH + cx;
+				if (threat(board, other, player, direction) == GomokuPatterns::FIVE && (count == 0 || points[0] != other)) {
+					points[count++] = other;
+					if (count == 2) {
+						return count;
+					}
+				}
+			}
+		}
+		return count;
+	}
+
+	/*!
+	* @brief Collect the cells anywhere near the stones where a player would make five.
+	* @param board The board.
+	* @param player The player.
+	* @param points Set to up to two of the cells.
+	* @return The number found, at most two.
+	*/
+	static int fivePoints(const Board& board, int player, int points[2]) {
+		int moves[Board::CELLS];
+		int count = board.generateMoves(moves);
+		int found = 0;
+
+		for (int i = 0; i < count && found < 2; i++) {
+			if (bestThreat(board, moves[i], player) == GomokuPatterns::FIVE) {
+				points[found++] = moves[i];
+			}
+		}
+		return found;
+	}
+
+	/*!
+	* @brief Search for a win by continuous fours for a player.
+	* @param board The board, which is played on and put back.
+	* @param attacker The player attacking.
+	* @param depth The most fours left to try.
+	* @param first Set to the first move of the win.
+	* @return true if the attacker wins.
+	*/
+	bool findVcf(Board& board, int attacker, int depth, int& first) {
+		int defender = 3 - attacker;
+		int points[2];
+		threatNodes++;
+
+		if (fivePoints(board, attacker, points)) {
+			first = points[0];
+			return true;
+		}
+
+		// A five threatened by the defender must be blocked, and the block must itself be a four to keep going
+		int defenderFives = fivePoints(board, defender, points);
+		if (defenderFives >= 2 || depth == 0 || threatNodes > threatNodeLimit) {
+			return false;
+		}
+
+		int moves[Board::CELLS];
+		int count = defenderFives ? 1 : board.generateMoves(moves);
+		if (defenderFives) {
+			moves[0] = points[0];
+		}
+
+		for (int i = 0; i < count; i++) {
+			if (bestThreat(board, moves[i], attacker) < GomokuPatterns::FOUR) {
+				continue;
+			}
+
+			board.setTurn(attacker);
+			board.makeMove(moves[i]);
+
+			int replies[2];
+			int forced = fivePointsAround(board, moves[i], attacker, replies);
+			bool won = forced >= 2;
+			if (forced == 1) {
+				board.makeMove(replies[0]);
+				int next;
+				won = findVcf(board, attacker, depth - 1, next);
+				board.undoMove();
+			}
+
+			board.undoMove();
+			if (won) {
+				first = moves[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	* @brief Search for a win by continuous threats, fours and open threes, for a player.
+	* @param board The board, which is played on and put back.
+	* @param attacker The player attacking.
+	* @param depth The most threats left to try.
+	* @param first Set to the first move of the win.
+	* @return true if the attacker wins whatever the defender does.
+	*/
+	bool findVct(Board& board, int attacker, int depth, int& first) {
+		static const int steps[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+		int defender = 3 - attacker;
+		int points[2];
+
+		if (findVcf(board, attacker, VCF_DEPTH, first)) {
+			return true;
+		}
+		if (depth == 0 || fivePoints(board, defender, points) || threatNodes > threatNodeLimit) {
+			return false;
+		}
+
+		int moves[Board::CELLS];
+		int count = board.generateMoves(moves);
+
+		for (int i = 0; i < count; i++) {
+			if (bestThreat(board, moves[i], attacker) != GomokuPatterns::OPEN_THREE) {
+				continue;
+			}
+
+			board.setTurn(attacker);
+			board.makeMove(moves[i]);
+
+			// The defender can stop the three in any cell where the attacker would make a four, or answer with a four
+			int replies[Board::CELLS];
+			int replyCount = 0;
+			int x = moves[i] % Board::WIDTH, y = moves[i] / Board::WIDTH;
+			for (int direction = 0; direction < 4; direction++) {
+				for (int offset = -GomokuPatterns::RADIUS; offset <= GomokuPatterns::RADIUS; offset++) {
+					int cx = x + steps[direction][0] * offset, cy = y + steps[direction][1] * offset;
+					if (cx < 0 || cx >= Board::WIDTH || cy < 0 || cy >= Board::HEIGHT || board.get(cx, cy)) {
+						continue;
+					}
+					int other = cy * Board::WIDTH + cx;
+					if (threat(board, other, attacker, direction) >= GomokuPatterns::FOUR &&
+						std::find(replies, replies + replyCount, other) == replies + replyCount) {
+						replies[replyCount++] = other;
+					}
+				}
+			}
+
+			int defences[Board::CELLS];
+			int defenceCount = board.generateMoves(defences);
+			for (int j = 0; j < defenceCount; j++) {
+				if (bestThreat(board, defences[j], defender) >= GomokuPatterns::FOUR &&
+					std::find(replies, replies + replyCount, defences[j]) == replies + replyCount) {
+					replies[replyCount++] = defences[j];
+				}
+			}
+
+			bool won = replyCount > 0;
+			for (int j = 0; j < replyCount && won; j++) {
+				board.setTurn(defender);
+				board.makeMove(replies[j]);
+				int next;
+				won = !board.getWinner() && findVct(board, attacker, depth - 1, next);
+				board.undoMove();
+			}
+
+			board.undoMove();
+			if (won) {
+				first = moves[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+public:
+	/*!
+	* @brief Constructor for GomokuAI.
+	* @param tableBits The alpha-beta search's transposition table holds 2 to the power of this many positions.
+	*/
+	explicit GomokuAI(int tableBits = 20) : search(tableBits), threatNodes(0), threatNodeLimit(0), reason(SEARCH) {
+	}
+
+	/*!
+	* @brief Get what a stone would make along one line.
+	* @param board The board.
+	* @param cell The cell, which may be empty.
+	* @param player The player whose stone it would be.
+	* @param direction 0 to 3, as for MnkBoard::lineWindow.
+	* @return The threat, GomokuPatterns::NONE to FIVE.
+	*/
+	static int threat(const Board& board, int cell, int player, int direction) {
+		uint32_t own, blocked;
+		board.lineWindow(cell, direction, player, GomokuPatterns::RADIUS, own, blocked);
+		return GomokuPatterns::threat(own, blocked);
+	}
+
+	/*!
+	* @brief Get the strongest threat a stone would make along any line.
+	* @param board The board.
+	* @param cell The cell.
+	* @param player The player.
+	* @return The threat.
+	*/
+	static int bestThreat(const Board& board, int cell, int player) {
+		int best = GomokuPatterns::NONE;
+		for (int direction = 0; direction < 4; direction++) {
+			best = std::max(best, threat(board, cell, player, direction));
+		}
+		return best;
+	}
+
+	/*!
+	* @brief Score a cell by the threats a player's stone would make there.
+	* @details Two lines that each need answering, such as a four and an open three, win, so score as an open four.
+	* @param board The board.
+	* @param cell The cell.
+	* @param player The player.
+	* @return The score.
+	*/
+	static int cellScore(const Board& board, int cell, int player) {
+		int score = 0, forcing = 0;
+		for (int direction = 0; direction < 4; direction++) {
+			int found = threat(board, cell, player, direction);
+			score += weight(found);
+			forcing += (found >= GomokuPatterns::OPEN_THREE) ? 1 : 0;
+		}
+		return (forcing >= 2) ? score + weight(GomokuPatterns::OPEN_FOUR) : score;
+	}
+
+	/*!
+	* @brief Choose a move for the player to move.
+	* @param board The board, which is played on and put back.
+	* @param seconds Roughly how long to think for.
+	* @return The cell to play, or -1 if the game is over.
+	*/
+	int chooseMove(Board& board, double seconds) {
+		int me = board.getTurn();
+		int points[2];
+		threatNodes = 0;
+		threatNodeLimit = 20000 + static_cast<uint64_t>(seconds * 200000);
+
+		if (board.getWinner() || board.isFull()) {
+			return -1;
+		}
+		if (fivePoints(board, me, points)) {
+			reason = FIVE;
+			return points[0];
+		}
+		if (fivePoints(board, 3 - me, points)) {
+			reason = BLOCK;
+			return points[0];
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		int move = -1;
+		if (findVcf(board, me, VCF_DEPTH, move)) {
+			board.setTurn(me);
+			reason = VCF;
+			return move;
+		}
+		if (findVct(board, me, VCT_DEPTH, move)) {
+			board.setTurn(me);
+			reason = VCT;
+			return move;
+		}
+		board.setTurn(me);
+
+		double used = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		reason = SEARCH;
+		return search.findBestMove(board, Board::CELLS, std::max(seconds - used, seconds / 4));
+	}
+
+	/*!
+	* @brief Get why the last move was chosen.
+	* @return FIVE, BLOCK, VCF, VCT or SEARCH.
+	*/
+	int getReason() const { return reason; }
+
+	/*!
+	* @brief Get the positions looked at by the threat-space searches of the last move.
+	* @return The count.
+	*/
+	uint64_t getThreatNodes() const { return threatNodes; }
+
+	/*!
+	* @brief Get the positions looked at by the alpha-beta search of the last move.
+	* @return The count, 0 if it was not needed.
+	*/
+	uint64_t getSearchNodes() const { return reason == SEARCH ? search.getNodes() : 0; }
+
+	/*!
+	* @brief Get the depth the alpha-beta search of the last move finished.
+	* @return The depth in moves, 0 if it was not needed.
+	*/
+	int getSearchDepth() const { return reason == SEARCH ? search.getDepth() : 0; }
+};
+
+#endif // GOMOKU_AI_H
@@ -0,0 +1,119 @@
+#include "gomokuPatterns.h"
+
+
+// Constructor for the GomokuPatterns class, classifying every arrangement of the eight neighbours
+GomokuPatterns::GomokuPatterns() {
+    for (int index = 0; index < (1 << 16); index++) {
+        table[index] = NONE;
+    }
+
+    int cells[9];
+    for (int pattern = 0; pattern < 6561; pattern++) {
+        int own = 0, blocked = 0;
+        int rest = pattern;
+
+        for (int i = 0, bit = 0; i < 9; i++) {
+            if (i == 4) {
+                cells[i] = 1;
+                continue;
+            }
+            cells[i] = rest % 3;
+            rest /= 3;
+            own |= (cells[i] == 1) << bit;
+            blocked |= (cells[i] == 2) << bit;
+            bit++;
+        }
+
+        table[own | (blocked << 8)] = classify(cells);
+    }
+}
+
+
+// Counts the empty cells that would complete five in a row through the middle
+int GomokuPatterns::countFives(int cells[9]) {
+    int count = 0;
+
+    for (int i = 0; i < 9; i++) {
+        if (cells[i] != 0) {
+            continue;
+        }
+
+        cells[i] = 1;
+        for (int start = 0; start + 5 <= 9; start++) {
+            bool five = true;
+            for (int j = start; j < start + 5 && five; j++) {
+                five = cells[j] == 1;
+            }
+            if (five) {
+                count++;
+                break;
+            }
+        }
+        cells[i] = 0;
+    }
+
+    return count;
+}
+
+
+// Classifies a pattern by what it is, or what one more stone would make it
+uint8_t GomokuPatterns::classify(int cells[9]) {
+    // Every stretch of five through the middle is a candidate for five in a row
+    for (int start = 0; start + 5 <= 9; start++) {
+        bool five = true;
+        for (int j = start; j < start + 5 && five; j++) {
+            five = cells[j] == 1;
+        }
+        if (five) {
+            return FIVE;
+        }
+    }
+
+    int fives = countFives(cells);
+    if (fives >= 2) {
+        return OPEN_FOUR;
+    }
+    if (fives == 1) {
+        return FOUR;
+    }
+
+    // A three is one move from a four, and an open three one move from an open four
+    uint8_t best = NONE;
+    for (int i = 0; i < 9 && best < OPEN_THREE; i++) {
+        if (cells[i] != 0) {
+            continue;
+        }
+
+        cells[i] = 1;
+        int after = countFives(cells);
+        if (after >= 2) {
+            best = OPEN_THREE;
+        }
+        else if (after == 1) {
+            best = THREE;
+        }
+        cells[i] = 0;
+    }
+    if (best != NONE) {
+        return best;
+    }
+
+    // A two is one move from an open three, so two moves from an open four
+    for (int i = 0; i < 9 && best == NONE; i++) {
+        if (cells[i] != 0) {
+            continue;
+        }
+
+        cells[i] = 1;
+        for (int j = i + 1; j < 9 && best == NONE; j++) {
+            if (cells[j] == 0) {
+                cells[j] = 1;
+                best = (countFives(cells) >= 2) ? TWO : NONE;
+                cells[j] = 0;
+            }
+        }
+        cells[i] = 0;
+    }
+
+    return best;
+}
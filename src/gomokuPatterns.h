@@ -0,0 +1,68 @@
+#ifndef GOMOKU_PATTERNS_H
+#define GOMOKU_PATTERNS_H
+
+/*!
+* @file gomokuPatterns.h
+* @brief Contains the declaration of the GomokuPatterns class, which recognises the threats a stone makes along a line.
+*/
+
+#include <cstdint>
+
+/*!
+* @class GomokuPatterns
+* @brief Looks up what a stone makes along one line from the four cells either side of it.
+* @details Each neighbour is empty, the player's own, or blocked by the other player or the edge of the board, so
+* @details there are 3 to the power 8 patterns. Every one is worked out once, by trying the moves that would finish
+* @details it, and kept in a table indexed by the own and blocked bits, so recognising a threat during a search is
+* @details a single lookup.
+*/
+class GomokuPatterns {
+public:
+	static const int RADIUS = 4; /*!< How many cells either side of the stone matter for five in a row. */
+
+	static const uint8_t NONE = 0; /*!< Nothing. */
+	static const uint8_t TWO = 1; /*!< One move from an open three. */
+	static const uint8_t THREE = 2; /*!< One move from a four. */
+	static const uint8_t OPEN_THREE = 3; /*!< One move from an open four, so it must be answered. */
+	static const uint8_t FOUR = 4; /*!< One move from five. */
+	static const uint8_t OPEN_FOUR = 5; /*!< Two ways to make five, so it cannot be stopped. */
+	static const uint8_t FIVE = 6; /*!< Five or more in a row. */
+
+private:
+	uint8_t table[1 << 16]; /*!< The threat for each pattern, indexed by the own bits then the blocked bits. */
+
+	/*!
+	* @brief Constructor for GomokuPatterns, working out the threat of every pattern.
+	*/
+	GomokuPatterns();
+
+	/*!
+	* @brief Work out the threat a pattern makes by trying the moves that would finish it.
+	* @param cells The nine cells, 0 empty, 1 own and 2 blocked, with the stone in the middle.
+	* @return The threat.
+	*/
+	static uint8_t classify(int cells[9]);
+
+	/*!
+	* @brief Count the empty cells that would make five with the middle stone.
+	* @param cells The nine cells.
+	* @return The count.
+	*/
+	static int countFives(int cells[9]);
+
+public:
+	/*!
+	* @brief Get what a stone makes along a line.
+	* @param own The player's stones along the line as nine bits with the stone as bit 4, from MnkBoard::lineWindow.
+	* @param blocked The cells blocked to the player as nine bits.
+	* @return The threat, NONE to FIVE.
+	*/
+	static uint8_t threat(uint32_t own, uint32_t blocked) {
+		static const GomokuPatterns patterns;
+		uint32_t ownAround = (own & 0x0F) | ((own >> 5) << 4);
+		uint32_t blockedAround = (blocked & 0x0F) | ((blocked >> 5) << 4);
+		return patterns.table[ownAround | (blockedAround << 8)];
+	}
+};
+
+#endif // GOMOKU_PATTERNS_H
@@ -29,7 +29,19 @@ public:
     }
 
 
-    Hangman(IScreenBuffer* sb) : screenBuffer(sb) {}
+    /// @brief Constructor that shares an external screen buffer, which must outlive the game.
+    /// @param sb The screen buffer.
+    Hangman(IScreenBuffer* sb) : screenBuffer(sb), ownsScreenBuffer(false) {}
+
+    Hangman(const Hangman&) = delete;
+    Hangman& operator=(const Hangman&) = delete;
+
+    /// @brief Destructor, deleting the screen buffer if the game created it.
+    ~Hangman() {
+        if (ownsScreenBuffer) {
+            delete screenBuffer;
+        }
+    }
 
 
     /// @brief Clears the screen using the ScreenBuffer class.
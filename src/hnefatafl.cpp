@@ -1,10 +1,11 @@
 #include "hnefatafl.h"
 
+// Row and column offsets for up, down, left and right
+const int Hnefatafl::DIRECTIONS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
 
 // Constructor for the Hnefatafl class
-Hnefatafl::Hnefatafl(){
+Hnefatafl::Hnefatafl(ScreenBuffer* buffer) : ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
     populateBoard();
-	currentPlayer = BLACK;
 };
 
 
@@ -23,6 +24,12 @@ void Hnefatafl::populateBoard() {
 
     // Set the king's position
     board[5][5] = KING;
+    kingPosition = std::make_pair(5, 5);
+
+    // A fresh board has no moves to take back, and black to move
+    undoStack.clear();
+    capturedStack.clear();
+    currentPlayer = BLACK;
 
     // Set the king's squares
     board[0][0] = KING_SQUARE;
@@ -112,10 +119,18 @@ std::pair<int, int> Hnefatafl::move(std::pair<int, int> source, std::pair<int, i
     board[currentRow][currentCol] = currentPlayer;
     board[sourceRow][sourceCol] = EMPTY;
 
-	if (board[currentRow][currentCol] == KING && board[targetRow][targetCol] == KING_SQUARE) {
+	// The king may step onto a king's square it has slid up against
+	if (currentPlayer == KING && board[targetRow][targetCol] == KING_SQUARE &&
+        abs(currentRow - targetRow) + abs(currentCol - targetCol) == 1) {
 		board[targetRow][targetCol] = KING;
         board[currentRow][currentCol] = EMPTY;
+        currentRow = targetRow;
+        currentCol = targetCol;
 	}
+
+    if (currentPlayer == KING) {
+        kingPosition = std::make_pair(currentRow, currentCol);
+    }
 	
     return std::make_pair(currentRow, currentCol);
 };
@@ -150,44 +165,183 @@ bool Hnefatafl::isCaptured(std::pair<int, int> source) {
 
 // Helper function to handle the capture of neighboring pieces
 void Hnefatafl::handleNeighboursCaptured(int row, int col) {
+    resolveCaptures(row, col, false);
+};
+
+
+// Removes the pieces sandwiched between the moved piece and another of its side (or a king's square)
+int Hnefatafl::resolveCaptures(int row, int col, bool record) {
+    int mover = board[row][col];
+
+    // The king does not take part in capturing soldiers
+    if (mover != WHITE && mover != BLACK) {
+        return 0;
+    }
+
+    int opponent = (mover == WHITE) ? BLACK : WHITE;
+    int captured = 0;
+
+    for (const auto& direction : DIRECTIONS) {
+        int farRow = row + 2 * direction[0];
+        int farCol = col + 2 * direction[1];
+
+        // If the square beyond the neighbour is on the board, so is the neighbour
+        if (farRow < 0 || farRow >= BOARD_SIZE || farCol < 0 || farCol >= BOARD_SIZE) {
+            continue;
+        }
+
+        int neighbourRow = row + direction[0];
+        int neighbourCol = col + direction[1];
 
-    std::pair<int, int> neighbores[] = {
-        {row - 1, col},  // up
-        {row + 1, col},  // down
-        {row, col - 1},  // left
-        {row, col + 1}   // right
-    };
-
-	// Loop through the four neighboring positions
-    for (const auto& pos : neighbores) {
-        int newRow = pos.first;
-        int newCol = pos.second;
-
-        // Boundary check to ensure the position is within the board limits (0 to 10)
-        if (newRow > -1 && newRow < BOARD_SIZE && newCol > -1 && newCol < BOARD_SIZE) {
-            // Check if the neighboring piece is captured
-            if (isCaptured(pos)) {
-                board[newRow][newCol] = EMPTY;  
+        if (board[neighbourRow][neighbourCol] != opponent) {
+            continue;
+        }
+
+        int anvil = board[farRow][farCol];
+        if (anvil == mover || anvil == KING_SQUARE) {
+            if (record) {
+                capturedStack.push_back(std::make_pair(std::make_pair(neighbourRow, neighbourCol), opponent));
             }
+
+            board[neighbourRow][neighbourCol] = EMPTY;
+            captured++;
         }
     }
+
+    return captured;
 };
 
 
-// Checks if the king is captured (surrounded on four sides by black pieces)
-bool Hnefatafl::isKingCaptured() {
-    int kingRow = -1, kingCol = -1;
+// Makes a move, resolving its captures and recording how to take it back
+int Hnefatafl::makeMove(std::pair<int, int> source, std::pair<int, int> target) {
+    UndoRecord record;
+    record.source = source;
+    record.target = target;
+    record.piece = board[source.first][source.second];
+    record.targetPiece = board[target.first][target.second];
+    record.previousPlayer = currentPlayer;
 
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            if (board[row][col] == KING) {
-                kingRow = row;
-                kingCol = col;
-                break;
+    board[source.first][source.second] = EMPTY;
+    board[target.first][target.second] = record.piece;
+
+    if (record.piece == KING) {
+        kingPosition = target;
+    }
+
+    record.capturedCount = resolveCaptures(target.first, target.second, true);
+    undoStack.push_back(record);
+
+    currentPlayer = (record.piece == BLACK) ? WHITE : BLACK;
+
+    return record.capturedCount;
+};
+
+
+// Takes back the last move made with makeMove
+bool Hnefatafl::unmakeMove() {
+    if (undoStack.empty()) {
+        return false;
+    }
+
+    const UndoRecord& record = undoStack.back();
+
+    // Put back the captured pieces, most recent first
+    for (int i = 0; i < record.capturedCount; i++) {
+        const std::pair<std::pair<int, int>, int>& captured = capturedStack.back();
+        board[captured.first.first][captured.first.second] = captured.second;
+        capturedStack.pop_back();
+    }
+
+    board[record.target.first][record.target.second] = record.targetPiece;
+    board[record.source.first][record.source.second] = record.piece;
+
+    if (record.piece == KING) {
+        kingPosition = record.source;
+    }
+
+    currentPlayer = record.previousPlayer;
+    undoStack.pop_back();
+
+    return true;
+};
+
+
+// Gets the player whose turn it is
+int Hnefatafl::getCurrentPlayer() const {
+    return currentPlayer;
+};
+
+
+// Takes a compact snapshot of the position
+HnefataflPosition Hnefatafl::getPosition() const {
+    HnefataflPosition position = {};
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int square = row * BOARD_SIZE + col;
+            uint64_t bit = uint64_t(1) << (square & 63);
+
+            if (board[row][col] == WHITE) {
+                position.white[square >> 6] |= bit;
+            }
+            else if (board[row][col] == BLACK) {
+                position.black[square >> 6] |= bit;
             }
         }
     }
 
+    position.kingSquare = static_cast<uint8_t>(kingPosition.first * BOARD_SIZE + kingPosition.second);
+    position.sideToMove = static_cast<uint8_t>(currentPlayer);
+
+    return position;
+};
+
+
+// Sets up the board from a snapshot
+void Hnefatafl::setPosition(const HnefataflPosition& position) {
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int square = row * BOARD_SIZE + col;
+            uint64_t bit = uint64_t(1) << (square & 63);
+
+            if (position.white[square >> 6] & bit) {
+                board[row][col] = WHITE;
+            }
+            else if (position.black[square >> 6] & bit) {
+                board[row][col] = BLACK;
+            }
+            else {
+                board[row][col] = EMPTY;
+            }
+        }
+    }
+
+    // The king's squares are fixed, the king may be standing on one
+    board[0][0] = KING_SQUARE;
+    board[10][10] = KING_SQUARE;
+    board[0][10] = KING_SQUARE;
+    board[10][0] = KING_SQUARE;
+
+    kingPosition = std::make_pair(position.kingSquare / BOARD_SIZE, position.kingSquare % BOARD_SIZE);
+    board[kingPosition.first][kingPosition.second] = KING;
+
+    currentPlayer = position.sideToMove;
+    undoStack.clear();
+    capturedStack.clear();
+};
+
+
+// Gets the square the king is on
+std::pair<int, int> Hnefatafl::getKingPosition() const {
+    return kingPosition;
+};
+
+
+// Checks if the king is captured (surrounded on four sides by black pieces)
+bool Hnefatafl::isKingCaptured() {
+    int kingRow = kingPosition.first;
+    int kingCol = kingPosition.second;
+
 	int up = getPiece(kingRow - 1, kingCol);
 	int down = getPiece(kingRow + 1, kingCol);
 	int left = getPiece(kingRow, kingCol - 1);
@@ -222,78 +376,60 @@ std::pair<int, int> Hnefatafl::convertMove(const std::string& move) {
 };
 
 
-// Bot to play against the player (randomly selects a piece and a move)
-std::pair<int, int> Hnefatafl::bot(int player) {
-    srand(static_cast<unsigned int>(time(0)));
-	// Find if bot is white or black
-	int botPlayer = (player == WHITE) ? BLACK : WHITE;
-
-    // All bots pieces on the board
-    std::map<std::pair<int, int>, std::vector<std::pair<int, int>>> botPiecesMap;
-
-	// Find all the bot's pieces on the board and possible moves
+// Generates every move available to the given player
+void Hnefatafl::generateMoves(int player, std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>>& moves) const {
     for (int row = 0; row < BOARD_SIZE; row++) {
         for (int col = 0; col < BOARD_SIZE; col++) {
+            int piece = board[row][col];
 
-			// Check if the piece is a bot piece or if the bot is white, the king
-            if (board[row][col] == botPlayer || (botPlayer == WHITE && board[row][col] == KING)) {
-                std::pair<int, int> position = std::make_pair(row, col);
-                std::vector<std::pair<int, int>> possibleMoves;
-
-				// Check possible moves up
-				for (int i = row - 1; i >= 0; i--) {
-					if (board[i][col] == EMPTY) {
-						possibleMoves.push_back(std::make_pair(i, col));
-					}
-					else {
-						break;
-					}
-				}
-                
-				// Check possible moves down
-				for (int i = row + 1; i < BOARD_SIZE; i++) {
-					if (board[i][col] == EMPTY) {
-						possibleMoves.push_back(std::make_pair(i, col));
-					}
-					else {
-						break;
-					}
-				}
-
-				// Check possible moves left
-				for (int j = col - 1; j >= 0; j--) {
-					if (board[row][j] == EMPTY) {
-						possibleMoves.push_back(std::make_pair(row, j));
-					}
-					else {
-						break;
-					}
-				}
-
-				// Check possible moves right
-				for (int j = col + 1; j < BOARD_SIZE; j++) {
-					if (board[row][j] == EMPTY) {
-						possibleMoves.push_back(std::make_pair(row, j));
-					}
-					else {
-						break;
-					}
-				}
-
-				botPiecesMap[position] = possibleMoves;
+            // White moves both its soldiers and the king
+            if (piece != player && !(player == WHITE && piece == KING)) {
+                continue;
+            }
+
+            for (const auto& direction : DIRECTIONS) {
+                int newRow = row + direction[0];
+                int newCol = col + direction[1];
+
+                // Slide until the edge of the board or an occupied square
+                while (newRow >= 0 && newRow < BOARD_SIZE && newCol >= 0 && newCol < BOARD_SIZE) {
+                    int occupant = board[newRow][newCol];
+
+                    if (occupant == EMPTY || (occupant == KING_SQUARE && piece == KING)) {
+                        moves.push_back(std::make_pair(std::make_pair(row, col), std::make_pair(newRow, newCol)));
+                    }
+
+                    if (occupant != EMPTY) {
+                        break;
+                    }
+
+                    newRow += direction[0];
+                    newCol += direction[1];
+                }
             }
         }
     }
-	
+};
+
+
+// Bot to play against the player (randomly selects one of its available moves)
+std::pair<int, int> Hnefatafl::bot(int player) {
+    srand(static_cast<unsigned int>(time(0)));
+	// Find if bot is white or black
+	int botPlayer = (player == WHITE) ? BLACK : WHITE;
+
+	// Find all the moves the bot can make
+    std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> possibleMoves;
+    generateMoves(botPlayer, possibleMoves);
 
-	// Randomly select a piece to move
-	std::map<std::pair<int, int>, std::vector<std::pair<int, int>>>::iterator it = botPiecesMap.begin();
-	std::advance(it, rand() % botPiecesMap.size());
-	std::pair<int, int> source = it->first;
+    if (possibleMoves.empty()) {
+        return kingPosition;
+    }
 
-	// Randomly select a move for the piece
-	std::vector<std::pair<int, int>> possibleMoves = it->second;
-	std::pair<int, int> target = possibleMoves[rand() % possibleMoves.size()];
+	// Randomly select a move
+	std::pair<std::pair<int, int>, std::pair<int, int>> chosen = possibleMoves[rand() % possibleMoves.size()];
+	std::pair<int, int> source = chosen.first;
+	std::pair<int, int> target = chosen.second;
 
 	// Perform the move
 	std::pair<int, int> finalPosition = move(source, target);
@@ -9,6 +9,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <utility>
 #include <conio.h>
@@ -16,6 +17,20 @@
 #include <time.h>
 #include <stdlib.h>
 #include <regex>
+#include <cstdint>
+
+/*!
+* @struct HnefataflPosition
+* @brief A compact, self-contained snapshot of a Hnefatafl position.
+* @details Squares are numbered row * 11 + col, so each side fits in a 121-bit bitboard split over two words.
+* @details The king's squares in the corners are fixed and so are not stored.
+*/
+struct HnefataflPosition {
+    uint64_t white[2]; /*!< Bitboard of the white soldiers, squares 0-63 in the first word and 64-120 in the second. */
+    uint64_t black[2]; /*!< Bitboard of the black soldiers, laid out the same way. */
+    uint8_t kingSquare; /*!< The square the king is on. */
+    uint8_t sideToMove; /*!< The player to move next (WHITE or BLACK). */
+};
 
 /*!
 * @class Hnefatafl
@@ -25,18 +40,38 @@
 * @details check game conditions, and implement a basic bot for playing against the player.
 */
 class Hnefatafl {
-private:
+public:
     static const int BOARD_SIZE = 11; /*!< The size of the game board. */
-    static const int WHITE = 1; /*!< The integer representation of a white piece. */
-    static const int BLACK = 2; /*!< The integer representation of a black piece. */
+    static const int WHITE = 1; /*!< The integer representation of a white piece, and of the defending player. */
+    static const int BLACK = 2; /*!< The integer representation of a black piece, and of the attacking player. */
+
+private:
     static const int KING = 3; /*!< The integer representation of the king piece. */
     static const int KING_SQUARE = 4; /*!< The integer representation of the king's square. */
     static const int EMPTY = 0; /*!< The integer representation of an empty square. */
     static const int OUT_OF_BOUNDS = -1; /*!< Constant to represent out of bounds. */
+    static const int DIRECTIONS[4][2]; /*!< Row and column offsets for up, down, left and right. */
+
+    /*!
+    * @struct UndoRecord
+    * @brief The state needed to take back one move made with makeMove.
+    */
+    struct UndoRecord {
+        std::pair<int, int> source; /*!< The square the piece moved from. */
+        std::pair<int, int> target; /*!< The square the piece moved to. */
+        int piece; /*!< The piece that was moved. */
+        int targetPiece; /*!< What was on the target square before the move (EMPTY or KING_SQUARE). */
+        int capturedCount; /*!< How many entries this move pushed onto the captured stack. */
+        int previousPlayer; /*!< The current player before the move. */
+    };
 
     int board[BOARD_SIZE][BOARD_SIZE]; /*!< The 2D array representing the game board. */
     int currentPlayer; /*!< The current player (WHITE or BLACK). */
-	ScreenBuffer screenBuffer; /*!< The screen buffer for displaying the game. */
+    std::pair<int, int> kingPosition; /*!< The square the king is on, kept up to date by every move. */
+    std::vector<UndoRecord> undoStack; /*!< One record per move made with makeMove. */
+    std::vector<std::pair<std::pair<int, int>, int>> capturedStack; /*!< The squares and pieces removed by captures, in the order they were taken. */
+	std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
 
     /*!
     * @brief Populates the board with black pieces in their initial positions.
@@ -48,6 +83,18 @@ private:
     */
     void populateWhiteSquares();
 
+    /*!
+    * @brief Removes the pieces captured by the piece that has just moved to the given square.
+    * @details Only the four lines running out from the moved piece are looked at, so the cost is constant.
+    * @details A neighbouring soldier is taken when the square beyond it holds a soldier of the mover or a king's square.
+    * @details The king neither captures nor is taken this way; isKingCaptured handles the king.
+    * @param row The row the moved piece landed on.
+    * @param col The column the moved piece landed on.
+    * @param record Whether to push the captured pieces onto the captured stack so they can be restored.
+    * @return The number of pieces captured.
+    */
+    int resolveCaptures(int row, int col, bool record);
+
 public:
     /*!
     * @brief Initializes the game board.
@@ -60,6 +107,7 @@ public:
     * @details The board is 11x11 with the center square initially occupied by the king.
     * @details The white pieces are placed in a star pattern around the king, with the black pieces in the middle of each side.
     * @details The king's squares are in the corners of the board and are the win condition for the king.
+    * @details Black moves first.
     */
     void populateBoard();
 
@@ -93,6 +141,55 @@ public:
     */
 	void handleNeighboursCaptured(int row, int col);
     
+    /*!
+    * @brief Gets the player whose turn it is.
+    * @return The current player (WHITE or BLACK).
+    */
+    int getCurrentPlayer() const;
+
+    /*!
+    * @brief Takes a compact snapshot of the board and the side to move.
+    * @return The current position.
+    */
+    HnefataflPosition getPosition() const;
+
+    /*!
+    * @brief Sets up the board from a snapshot, discarding any moves that could be taken back.
+    * @param position The position to set up.
+    */
+    void setPosition(const HnefataflPosition& position);
+
+    /*!
+    * @brief Generates every move available to a player.
+    * @details A move slides a piece any distance along a row or column over empty squares.
+    * @details Only the king may finish on a king's square.
+    * @param player The player to generate moves for (WHITE includes the king).
+    * @param moves The vector the moves are appended to, as pairs of (source, target).
+    */
+    void generateMoves(int player, std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>>& moves) const;
+
+    /*!
+    * @brief Makes a move and resolves its captures, recording what is needed to take it back.
+    * @details The source must hold a piece with a clear straight path to the target; no validation is done.
+    * @details The current player is switched to the other side.
+    * @param source The source position as a pair of (row, col).
+    * @param target The target position as a pair of (row, col).
+    * @return The number of pieces captured by the move.
+    */
+    int makeMove(std::pair<int, int> source, std::pair<int, int> target);
+
+    /*!
+    * @brief Takes back the last move made with makeMove, restoring any captured pieces.
+    * @return true if a move was taken back, false if there was nothing to undo.
+    */
+    bool unmakeMove();
+
+    /*!
+    * @brief Gets the square the king is currently on.
+    * @return The king's position as a pair of (row, col).
+    */
+    std::pair<int, int> getKingPosition() const;
+
     /*!
     * @brief Checks if the king is captured.
     * @return true if the king is captured, false otherwise.
@@ -133,8 +230,9 @@ public:
 
     /*!
     * @brief Constructs a new Hnefatafl game object.
+    * @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
     */
-    Hnefatafl();
+    explicit Hnefatafl(ScreenBuffer* buffer = nullptr);
 
 	/*!
 	* @brief Run the game
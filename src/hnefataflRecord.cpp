@@ -0,0 +1,236 @@
+#include "hnefataflRecord.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// File header written at the start of every game log
+static const char FILE_MAGIC[4] = { 'H', 'N', 'F', 'T' };
+static const uint8_t FILE_VERSION = 1;
+static const int HEADER_BYTES = 5;
+static const int GAME_HEADER_BYTES = 4;
+static const uint8_t FLAG_START_POSITION = 1;
+
+
+// Packs a move into 14 bits (source square in the high 7 bits, target in the low 7)
+uint16_t HnefataflRecord::packMove(std::pair<int, int> source, std::pair<int, int> target) {
+    int sourceSquare = source.first * Hnefatafl::BOARD_SIZE + source.second;
+    int targetSquare = target.first * Hnefatafl::BOARD_SIZE + target.second;
+
+    return static_cast<uint16_t>((sourceSquare << 7) | targetSquare);
+}
+
+
+// Unpacks a move packed by packMove
+std::pair<std::pair<int, int>, std::pair<int, int>> HnefataflRecord::unpackMove(uint16_t move) {
+    int sourceSquare = (move >> 7) & 0x7F;
+    int targetSquare = move & 0x7F;
+
+    return std::make_pair(std::make_pair(sourceSquare / Hnefatafl::BOARD_SIZE, sourceSquare % Hnefatafl::BOARD_SIZE),
+        std::make_pair(targetSquare / Hnefatafl::BOARD_SIZE, targetSquare % Hnefatafl::BOARD_SIZE));
+}
+
+
+// Encodes a position as two 16 byte bitboards, the king's square and the side to move
+void HnefataflRecord::encodePosition(const HnefataflPosition& position, uint8_t* bytes) {
+    for (int i = 0; i < 16; i++) {
+        bytes[i] = static_cast<uint8_t>(position.white[i >> 3] >> ((i & 7) * 8));
+        bytes[16 + i] = static_cast<uint8_t>(position.black[i >> 3] >> ((i & 7) * 8));
+    }
+
+    bytes[32] = position.kingSquare;
+    bytes[33] = position.sideToMove;
+}
+
+
+// Decodes a position encoded by encodePosition
+HnefataflPosition HnefataflRecord::decodePosition(const uint8_t* bytes) {
+    HnefataflPosition position = {};
+
+    for (int i = 0; i < 16; i++) {
+        position.white[i >> 3] |= uint64_t(bytes[i]) << ((i & 7) * 8);
+        position.black[i >> 3] |= uint64_t(bytes[16 + i]) << ((i & 7) * 8);
+    }
+
+    position.kingSquare = bytes[32];
+    position.sideToMove = bytes[33];
+
+    return position;
+}
+
+
+// Replays a recorded game through makeMove, which resolves captures and passes the turn as recording did
+void HnefataflRecord::replay(const HnefataflGameRecord& record, Hnefatafl& game) {
+    if (record.hasStartPosition) {
+        game.setPosition(record.startPosition);
+    }
+    else {
+        game.populateBoard();
+    }
+
+    for (uint16_t packed : record.moves) {
+        std::pair<std::pair<int, int>, std::pair<int, int>> move = unpackMove(packed);
+        game.makeMove(move.first, move.second);
+    }
+}
+
+
+// Plays and records a game between two random players
+HnefataflGameRecord HnefataflRecord::playRandomGame(Hnefatafl& game, unsigned int seed, int maxMoves) {
+    std::mt19937 random(seed);
+    std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> moves;
+    HnefataflGameRecord record;
+
+    game.populateBoard();
+
+    for (int ply = 0; ply < maxMoves && !game.isGameOver(); ply++) {
+        int player = game.getCurrentPlayer();
+
+        moves.clear();
+        game.generateMoves(player, moves);
+
+        // A side with no move to make loses
+        if (moves.empty()) {
+            record.result = (player == Hnefatafl::WHITE) ? RESULT_BLACK : RESULT_WHITE;
+            return record;
+        }
+
+        const std::pair<std::pair<int, int>, std::pair<int, int>>& chosen = moves[random() % moves.size()];
+        game.makeMove(chosen.first, chosen.second);
+        record.moves.push_back(packMove(chosen.first, chosen.second));
+    }
+
+    if (game.isGameOver()) {
+        record.result = game.isKingCaptured() ? RESULT_BLACK : RESULT_WHITE;
+    }
+
+    return record;
+}
+
+
+// Opens a game log for appending
+HnefataflRecordWriter::HnefataflRecordWriter(const std::string& filename) {
+    file.open(filename, std::ios::binary | std::ios::app);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open game log " + filename);
+    }
+
+    // A new log needs its header
+    file.seekp(0, std::ios::end);
+    if (file.tellp() == std::streampos(0)) {
+        file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        file.put(static_cast<char>(FILE_VERSION));
+    }
+}
+
+
+// Appends a game to the log
+void HnefataflRecordWriter::writeGame(const HnefataflGameRecord& record) {
+    size_t moveCount = record.moves.size();
+    if (moveCount > 0xFFFF) {
+        throw std::runtime_error("A game of " + std::to_string(moveCount) + " moves is too long for the game log");
+    }
+    size_t moveBytes = (moveCount * HnefataflRecord::MOVE_BITS + 7) / 8;
+
+    buffer.assign(GAME_HEADER_BYTES + (record.hasStartPosition ? HnefataflRecord::POSITION_BYTES : 0) + moveBytes, 0);
+
+    buffer[0] = record.hasStartPosition ? FLAG_START_POSITION : 0;
+    buffer[1] = record.result;
+    buffer[2] = static_cast<uint8_t>(moveCount);
+    buffer[3] = static_cast<uint8_t>(moveCount >> 8);
+
+    size_t offset = GAME_HEADER_BYTES;
+    if (record.hasStartPosition) {
+        HnefataflRecord::encodePosition(record.startPosition, &buffer[offset]);
+        offset += HnefataflRecord::POSITION_BYTES;
+    }
+
+    // Pack the moves least significant bit first
+    uint32_t accumulator = 0;
+    int pendingBits = 0;
+    for (uint16_t move : record.moves) {
+        accumulator |= uint32_t(move & 0x3FFF) << pendingBits;
+        pendingBits += HnefataflRecord::MOVE_BITS;
+
+        while (pendingBits >= 8) {
+            buffer[offset++] = static_cast<uint8_t>(accumulator);
+            accumulator >>= 8;
+            pendingBits -= 8;
+        }
+    }
+
+    if (pendingBits > 0) {
+        buffer[offset] = static_cast<uint8_t>(accumulator);
+    }
+
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+
+// Flushes buffered games to the file
+void HnefataflRecordWriter::flush() {
+    file.flush();
+}
+
+
+// Opens a game log and checks its header
+HnefataflRecordReader::HnefataflRecordReader(const std::string& filename) {
+    file.open(filename, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open game log " + filename);
+    }
+
+    char header[HEADER_BYTES];
+    if (!file.read(header, HEADER_BYTES) || !std::equal(FILE_MAGIC, FILE_MAGIC + 4, header) ||
+        static_cast<uint8_t>(header[4]) != FILE_VERSION) {
+        throw std::runtime_error("Not a Hnefatafl game log: " + filename);
+    }
+}
+
+
+// Reads the next game from the log
+bool HnefataflRecordReader::readGame(HnefataflGameRecord& record) {
+    uint8_t header[GAME_HEADER_BYTES];
+
+    if (!file.read(reinterpret_cast<char*>(header), GAME_HEADER_BYTES)) {
+        if (file.gcount() == 0) {
+            return false;
+        }
+        throw std::runtime_error("Game log ends part way through a game");
+    }
+
+    record.hasStartPosition = (header[0] & FLAG_START_POSITION) != 0;
+    record.result = header[1];
+    size_t moveCount = header[2] | (size_t(header[3]) << 8);
+    size_t moveBytes = (moveCount * HnefataflRecord::MOVE_BITS + 7) / 8;
+
+    buffer.resize((record.hasStartPosition ? HnefataflRecord::POSITION_BYTES : 0) + moveBytes);
+    if (!buffer.empty() && !file.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) {
+        throw std::runtime_error("Game log ends part way through a game");
+    }
+
+    size_t offset = 0;
+    if (record.hasStartPosition) {
+        record.startPosition = HnefataflRecord::decodePosition(buffer.data());
+        offset = HnefataflRecord::POSITION_BYTES;
+    }
+
+    // Unpack the moves least significant bit first
+    record.moves.resize(moveCount);
+    uint32_t accumulator = 0;
+    int pendingBits = 0;
+    for (size_t i = 0; i < moveCount; i++) {
+        while (pendingBits < HnefataflRecord::MOVE_BITS) {
+            accumulator |= uint32_t(buffer[offset++]) << pendingBits;
+            pendingBits += 8;
+        }
+
+        record.moves[i] = static_cast<uint16_t>(accumulator & 0x3FFF);
+        accumulator >>= HnefataflRecord::MOVE_BITS;
+        pendingBits -= HnefataflRecord::MOVE_BITS;
+    }
+
+    return true;
+}
@@ -0,0 +1,144 @@
+#ifndef HNEFATAFL_RECORD_H
+#define HNEFATAFL_RECORD_H
+
+/*!
+* @file hnefataflRecord.h
+* @brief Contains the declaration of the binary position and game-record format for Hnefatafl.
+* @details A log file starts with a five byte header ("HNFT" and a version byte) and is followed by any number of games.
+* @details Each game is a flags byte, a result byte, a little-endian 16-bit move count, an optional 34 byte
+* @details start position and the moves packed 14 bits each (7-bit source square, 7-bit target square).
+*/
+
+#include "hnefatafl.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+/*!
+* @struct HnefataflGameRecord
+* @brief One recorded game of Hnefatafl.
+*/
+struct HnefataflGameRecord {
+    bool hasStartPosition = false; /*!< Whether the game started from startPosition rather than the standard setup. */
+    HnefataflPosition startPosition = {}; /*!< The position the game started from, if hasStartPosition is set. */
+    uint8_t result = 0; /*!< The winner (RESULT_WHITE or RESULT_BLACK), or 0 if the game was not finished. */
+    std::vector<uint16_t> moves; /*!< The moves of the game, each packed into 14 bits. */
+};
+
+/*!
+* @class HnefataflRecord
+* @brief Encoding helpers and self-play for Hnefatafl game records.
+*/
+class HnefataflRecord {
+public:
+    static const int POSITION_BYTES = 34; /*!< The size of an encoded position. */
+    static const int MOVE_BITS = 14; /*!< The number of bits used for one packed move. */
+    static const uint8_t RESULT_WHITE = 1; /*!< Result value for a white win. */
+    static const uint8_t RESULT_BLACK = 2; /*!< Result value for a black win. */
+
+    /*!
+    * @brief Packs a move into 14 bits.
+    * @param source The source position as a pair of (row, col).
+    * @param target The target position as a pair of (row, col).
+    * @return The packed move.
+    */
+    static uint16_t packMove(std::pair<int, int> source, std::pair<int, int> target);
+
+    /*!
+    * @brief Unpacks a move packed by packMove.
+    * @param move The packed move.
+    * @return The move as a pair of (source, target) positions.
+    */
+    static std::pair<std::pair<int, int>, std::pair<int, int>> unpackMove(uint16_t move);
+
+    /*!
+    * @brief Encodes a position into POSITION_BYTES bytes.
+    * @param position The position to encode.
+    * @param bytes The buffer to write to, at least POSITION_BYTES long.
+    */
+    static void encodePosition(const HnefataflPosition& position, uint8_t* bytes);
+
+    /*!
+    * @brief Decodes a position encoded by encodePosition.
+    * @param bytes The buffer to read from, at least POSITION_BYTES long.
+    * @return The decoded position.
+    */
+    static HnefataflPosition decodePosition(const uint8_t* bytes);
+
+    /*!
+    * @brief Replays a recorded game through makeMove, as it was recorded, so captures and the side to move match.
+    * @param record The game to replay.
+    * @param game The game to replay it on; it is reset to the record's start position first.
+    */
+    static void replay(const HnefataflGameRecord& record, Hnefatafl& game);
+
+    /*!
+    * @brief Plays a game between two random players and records it.
+    * @details The game ends when it is over on the board, when the side to move has no move (and so loses) or after maxMoves.
+    * @param game The game to play on; it is reset to the standard setup first.
+    * @param seed The seed for the random move choices.
+    * @param maxMoves The number of moves after which the game is abandoned.
+    * @return The recorded game.
+    */
+    static HnefataflGameRecord playRandomGame(Hnefatafl& game, unsigned int seed, int maxMoves);
+};
+
+/*!
+* @class HnefataflRecordWriter
+* @brief Appends games to a Hnefatafl game log file.
+*/
+class HnefataflRecordWriter {
+private:
+    std::ofstream file; /*!< The log file, opened for appending. */
+    std::vector<uint8_t> buffer; /*!< Reused buffer a game is encoded into before being written. */
+
+public:
+    /*!
+    * @brief Opens a log file for appending, writing the header if the file is new or empty.
+    * @param filename The name of the log file.
+    * @throws runtime_error if the file cannot be opened.
+    */
+    explicit HnefataflRecordWriter(const std::string& filename);
+
+    /*!
+    * @brief Appends a game to the log.
+    * @param record The game to append.
+    * @throws runtime_error if the game has more moves than the 16-bit move count can hold.
+    */
+    void writeGame(const HnefataflGameRecord& record);
+
+    /*!
+    * @brief Flushes any buffered games to the file.
+    */
+    void flush();
+};
+
+/*!
+* @class HnefataflRecordReader
+* @brief Reads games from a Hnefatafl game log file one at a time.
+*/
+class HnefataflRecordReader {
+private:
+    std::ifstream file; /*!< The log file, opened for reading. */
+    std::vector<uint8_t> buffer; /*!< Reused buffer the packed moves are read into. */
+
+public:
+    /*!
+    * @brief Opens a log file and checks its header.
+    * @param filename The name of the log file.
+    * @throws runtime_error if the file cannot be opened or is not a game log.
+    */
+    explicit HnefataflRecordReader(const std::string& filename);
+
+    /*!
+    * @brief Reads the next game from the log.
+    * @param record The record to read the game into.
+    * @return true if a game was read, false at the end of the file.
+    * @throws runtime_error if the file ends part way through a game.
+    */
+    bool readGame(HnefataflGameRecord& record);
+};
+
+#endif // HNEFATAFL_RECORD_H
@@ -0,0 +1,60 @@
+#include "mappedFile.h"
+#include <windows.h>
+#include <stdexcept>
+
+
+// Maps a whole file read-only
+MappedFile::MappedFile(const std::string& filename) : file(INVALID_HANDLE_VALUE), mapping(nullptr), bytes(nullptr), length(0) {
+    file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        throw std::runtime_error("Could not get the size of file: " + filename);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    // An empty file cannot be mapped, and has nothing to map anyway
+    if (length == 0) {
+        return;
+    }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+
+    bytes = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (bytes == nullptr) {
+        close();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+}
+
+
+// Destructor for the MappedFile class
+MappedFile::~MappedFile() {
+    close();
+}
+
+
+// Unmaps the view and closes the handles
+void MappedFile::close() {
+    if (bytes != nullptr) {
+        UnmapViewOfFile(bytes);
+        bytes = nullptr;
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+    }
+    length = 0;
+}
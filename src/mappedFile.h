@@ -0,0 +1,66 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/*!
+* @file mappedFile.h
+* @brief Contains the declaration of the MappedFile class, a read-only view of a whole file mapped into memory.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*!
+* @class MappedFile
+* @brief Maps a file into memory read-only, so it can be read in place without copying it into a buffer.
+* @details The operating system pages the file in as it is touched, so even files larger than memory can be scanned.
+*/
+class MappedFile {
+private:
+	void* file; /*!< The open file's HANDLE, kept as void* so this header does not pull in windows.h. */
+	void* mapping; /*!< The file mapping's HANDLE, or null for an empty file. */
+	const uint8_t* bytes; /*!< The start of the mapped view, or null for an empty file. */
+	size_t length; /*!< The size of the file in bytes. */
+
+	/*!
+	* @brief Unmap the view and close the handles.
+	*/
+	void close();
+
+public:
+	/*!
+	* @brief Map a file into memory.
+	* @param filename The name of the file.
+	* @throws runtime_error if the file cannot be opened or mapped.
+	*/
+	explicit MappedFile(const std::string& filename);
+
+	/*!
+	* @brief Destructor for MappedFile, unmaps the file.
+	*/
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/*!
+	* @brief Get the contents of the file.
+	* @return The first byte of the file, or null if it is empty.
+	*/
+	const uint8_t* data() const { return bytes; }
+
+	/*!
+	* @brief Get the size of the file.
+	* @return The size in bytes.
+	*/
+	size_t size() const { return length; }
+
+	/*!
+	* @brief Get the contents of the file as text.
+	* @return A view of the whole file, valid for as long as the MappedFile lives.
+	*/
+	std::string_view view() const { return std::string_view(reinterpret_cast<const char*>(bytes), length); }
+};
+
+#endif // MAPPED_FILE_H
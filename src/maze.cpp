@@ -1,9 +1,16 @@
 #include "maze.h"  
 
 // Maze constructor with width and height
-Maze::Maze(int width, int height) {
-    srand(static_cast<unsigned int>(time(0)));
-    generateMaze(width, height);
+Maze::Maze(int width, int height, MazeAlgorithm algorithm, ScreenBuffer* buffer) : moves(0), seed(static_cast<uint32_t>(time(0))), fogOfWar(false),
+    ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
+    srand(seed);
+    generateMaze(width, height, algorithm);
+
+    std::pair<std::pair<int, int>, std::pair<int, int>> ends = chooseStartAndEnd();
+    start = ends.first;
+    end = ends.second;
+    playerPosition = start;
+    exitDistances = solver.distanceField(grid, toCell(end));
 }
 
 // Checks if position is vaild  
@@ -35,6 +42,12 @@ Direction Maze::getOppositeDirection(Direction direction) const {
     case Direction::WEST:
         opposite = Direction::EAST;
         break;
+    case Direction::UP:
+        opposite = Direction::DOWN;
+        break;
+    case Direction::DOWN:
+        opposite = Direction::UP;
+        break;
     default: 
         break;
     }
@@ -105,10 +118,12 @@ std::pair<int, int> Maze::nextStep(std::pair<int, int> current) {
                 next = std::make_pair(current.first - 1, current.second);
             }
             break;
+        default:
+            break;
         }
 
-        // If the next position is valid, return it
-        if (isValidPosition(next)) {
+        // If the step led somewhere valid, return it; a step off the edge leaves next where it was
+        if (next != current && isValidPosition(next)) {
             return next;
         }
 
@@ -128,7 +143,10 @@ std::vector<std::pair<int, int>> Maze::randomWalk(std::pair<int, int> start) {
 
     // Continue walking until a node in the maze is encountered
     while (inMaze.find(current) == inMaze.end()) {
-        path.push_back(current); 
+        // A loop that was just erased leaves the walk already ending here
+        if (path.empty() || path.back() != current) {
+            path.push_back(current);
+        }
 
         std::pair<int, int> next = nextStep(current);
 
@@ -141,6 +159,11 @@ std::vector<std::pair<int, int>> Maze::randomWalk(std::pair<int, int> start) {
         path = eraseLoop(path, current);
     }
 
+    // End on the cell in the maze the walk reached, so the walk is linked to it
+    if (inMaze.find(current) != inMaze.end()) {
+        path.push_back(current);
+    }
+
     return path;
 }
 
@@ -184,6 +207,7 @@ void Maze::generateMaze(int width, int height) {
             const std::pair<int, int>& position = path[i];
 
              inMaze.insert(position);
+             availablePositions.erase(position);
 
             // Link the current node with the next node in the path
             if (i < path.size() - 1) {
@@ -191,89 +215,663 @@ void Maze::generateMaze(int width, int height) {
             }
         }
     }
+
+    buildGrid();
+}
+
+
+// Generate maze with a chosen algorithm
+void Maze::generateMaze(int width, int height, MazeAlgorithm algorithm) {
+    if (algorithm == MazeAlgorithm::WILSON) {
+        generateMaze(width, height);
+        return;
+    }
+
+    WIDTH = width;
+    HEIGHT = height;
+    grid.reset(width, height);
+    MazeGenerator::create(algorithm)->generate(grid, static_cast<uint32_t>(rand()));
+    buildNodes();
+}
+
+
+// Links the nodes from the passages in the grid
+void Maze::buildNodes() {
+    mazeMap.clear();
+    inMaze.clear();
+
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            mazeMap[std::make_pair(x, y)] = std::make_unique<MazeNode>();
+            inMaze.insert(std::make_pair(x, y));
+        }
+    }
+
+    // Each passage is linked once, from the cell west of it or north of it
+    for (int cell = 0; cell < grid.getCellCount(); cell++) {
+        if (grid.isOpen(cell, MazeGrid::EAST)) {
+            linkNodes(toPosition(cell), toPosition(cell + 1));
+        }
+        if (grid.isOpen(cell, MazeGrid::SOUTH)) {
+            linkNodes(toPosition(cell), toPosition(cell + WIDTH));
+        }
+    }
+}
+
+
+// Copies the passages between linked nodes into the grid
+void Maze::buildGrid() {
+    grid.reset(WIDTH, HEIGHT);
+
+    std::map<const MazeNode*, std::pair<int, int>> positions;
+    for (const auto& entry : mazeMap) {
+        positions[entry.second.get()] = entry.first;
+    }
+
+    for (const auto& entry : mazeMap) {
+        for (const auto& neighbor : entry.second->getNeighbors()) {
+            auto found = positions.find(neighbor.second);
+            if (neighbor.second == nullptr || found == positions.end()) {
+                continue;
+            }
+
+            // The direction from where the nodes are: column first, with rows growing southwards
+            int dx = found->second.first - entry.first.first;
+            int dy = found->second.second - entry.first.second;
+            int direction = (dx == 1) ? MazeGrid::EAST : (dx == -1) ? MazeGrid::WEST : (dy == 1) ? MazeGrid::SOUTH : MazeGrid::NORTH;
+            if (std::abs(dx) + std::abs(dy) == 1) {
+                grid.openPassage(toCell(entry.first), direction);
+            }
+        }
+    }
+}
+
+
+// Chooses the start and end as far apart as they can be
+std::pair<std::pair<int, int>, std::pair<int, int>> Maze::chooseStartAndEnd() {
+    int first = solver.farthestCell(grid, rand() % grid.getCellCount());
+    int second = solver.farthestCell(grid, first);
+    return std::make_pair(toPosition(first), toPosition(second));
+}
+
+
+// Gets the fewest moves from the start to the end
+int Maze::getPar() const {
+    return exitDistances[toCell(start)];
+}
+
+
+// Gets the way to go towards the end
+Direction Maze::getHint() const {
+    int cell = toCell(playerPosition);
+
+    for (int direction = 0; direction < 4; direction++) {
+        int next = grid.neighbour(cell, direction);
+        if (grid.isOpen(cell, direction) && exitDistances[next] == exitDistances[cell] - 1) {
+            return static_cast<Direction>(direction);
+        }
+    }
+    return Direction::NORTH;
+}
+
+
+// Rates the maze by the junctions on the shortest path
+int Maze::getDifficulty() const {
+    int junctions = 0;
+
+    // Downhill from the start through the distances to the end is the shortest path
+    for (int cell = toCell(start); exitDistances[cell] > 0;) {
+        uint8_t passages = grid.getPassages(cell);
+        int count = 0;
+        int next = cell;
+        for (int direction = 0; direction < 4; direction++) {
+            if ((passages >> direction) & 1) {
+                count++;
+                int neighbour = grid.neighbour(cell, direction);
+                if (exitDistances[neighbour] == exitDistances[cell] - 1) {
+                    next = neighbour;
+                }
+            }
+        }
+        junctions += (count >= 3) ? 1 : 0;
+        cell = next;
+    }
+    return junctions;
+}
+
+
+// Saves the maze to a maze file
+void Maze::saveMaze(const std::string& filename) const {
+    MazeFile::save(filename, grid, seed, start, end);
+}
+
+
+// Loads the maze from a maze file
+void Maze::loadMaze(const std::string& filename) {
+    MazeFile file(filename);
+    file.load(grid);
+
+    WIDTH = file.getWidth();
+    HEIGHT = file.getHeight();
+    seed = file.getSeed();
+    start = file.getStart();
+    end = file.getEnd();
+    playerPosition = start;
+    moves = 0;
+
+    mazeMap.clear();
+    inMaze.clear();
+    exitDistances = solver.distanceField(grid, toCell(end));
 }
 
 
 // Print the maze to the console
 void Maze::printMaze() {
+    // The view is as much of the maze as fits on the screen above the status line
+    int columns = std::min(WIDTH, (screenBuffer.getScreenWidth() - 1) / 2);
+    int rows = std::min(HEIGHT, (screenBuffer.getScreenHeight() - 3) / 2);
+    if (view.getColumns() != columns || view.getRows() != rows) {
+        view.resize(columns, rows);
+    }
+
+    view.follow(grid, playerPosition.first, playerPosition.second);
+    drawView();
+    screenBuffer.clearScreen();
+    view.flush(screenBuffer, 0, 0);
+    printStatus(L"");
+}
+
+
+// Draw every cell in the view, with the start, end and player on top
+void Maze::drawView() {
+    if (fogOfWar) {
+        int left = view.getOriginX();
+        int top = view.getOriginY();
+        int right = left + std::min(view.getColumns(), WIDTH - left);
+        int bottom = top + std::min(view.getRows(), HEIGHT - top);
+
+        // The fog goes down first, so the walls of the cells seen are drawn over its edges
+        for (int y = top; y < bottom; y++) {
+            for (int x = left; x < right; x++) {
+                if (!fog.isSeen(toCell(std::make_pair(x, y)))) {
+                    view.drawHidden(grid, toCell(std::make_pair(x, y)));
+                }
+            }
+        }
+        for (int y = top; y < bottom; y++) {
+            for (int x = left; x < right; x++) {
+                int cell = toCell(std::make_pair(x, y));
+                if (fog.isSeen(cell)) {
+                    view.drawRevealed(grid, cell, cellSymbol(cell));
+                }
+            }
+        }
+        return;
+    }
+
+    view.drawAll(grid);
+    view.drawCell(grid, toCell(start), cellSymbol(toCell(start)));
+    view.drawCell(grid, toCell(end), cellSymbol(toCell(end)));
+    view.drawCell(grid, toCell(playerPosition), cellSymbol(toCell(playerPosition)));
+}
+
+
+// Get the character drawn in the middle of a cell
+wchar_t Maze::cellSymbol(int cell) const {
+    if (cell == toCell(playerPosition)) {
+        return L'@';
+    }
+    if (cell == toCell(end)) {
+        return L'X';
+    }
+    return (cell == toCell(start)) ? L'S' : L' ';
+}
+
+
+// Print the moves, par and keys below the view
+void Maze::printStatus(const std::wstring& message) {
+    std::wstring status = L"Moves: " + std::to_wstring(moves) + L"  Par: " + std::to_wstring(getPar());
+    if (fogOfWar) {
+        status += L"  Seen: " + std::to_wstring(100LL * fog.getSeenCount() / grid.getCellCount()) + L"%";
+    }
+    status += L"  (w/a/s/d to move, h for a hint, q to quit)  " + message;
+    status.resize(std::max(status.size(), static_cast<size_t>(screenBuffer.getScreenWidth() - 1)), L' ');
+    screenBuffer.writeToScreen(0, view.getRows() * 2 + 2, status);
+}
+
+
+// Update the maze printed to the console
+void Maze::updateMaze(std::pair<int, int> previousPosition) {
+    if (fogOfWar) {
+        fog.reveal(grid, toCell(playerPosition));
+    }
+
+    if (view.follow(grid, playerPosition.first, playerPosition.second)) {
+        drawView();
+    }
+    else {
+        // Only what came into sight is drawn, so a move costs the cells in sight, not the cells in the maze
+        if (fogOfWar) {
+            for (int cell : fog.getRevealed()) {
+                view.drawRevealed(grid, cell, cellSymbol(cell));
+            }
+        }
+        view.drawCell(grid, toCell(previousPosition), cellSymbol(toCell(previousPosition)));
+        view.drawCell(grid, toCell(playerPosition), cellSymbol(toCell(playerPosition)));
+    }
+
+    view.flush(screenBuffer, 0, 0);
+    printStatus(L"");
+}
+
+
+// Check if the player has reached the end
+bool Maze::checkWin() const {
+    return playerPosition == end;
+}
+
+
+// Move the player through a passage
+bool Maze::movePlayer(Direction direction) {
+    int cell = toCell(playerPosition);
+    if (!grid.isOpen(cell, direction)) {
+        return false;
+    }
+
+    playerPosition = toPosition(grid.neighbour(cell, direction));
+    moves++;
+    return true;
+}
+
+
+// Print the rows of the endless maze around the player
+void Maze::printEndless(const EndlessMaze& endless) {
     screenBuffer.clearScreen();
 
-    for (int row = 0; row < HEIGHT; row++) {
+    // Keep the player in the middle of the view where the window allows
+    long long top = std::max(endless.getFirstRow(), endless.getPlayerY() - ENDLESS_VIEW_ROWS / 2);
+    top = std::min(top, endless.getEndRow() - ENDLESS_VIEW_ROWS);
+
+    std::wstring topRow = L"+";
+    for (int col = 0; col < endless.getWidth(); col++) {
+        topRow += (endless.getPassages(col, top) & MazeGrid::OPEN_NORTH) ? L" +" : L"-+";
+    }
+    screenBuffer.writeToScreen(0, 0, topRow);
+
+    for (int row = 0; row < ENDLESS_VIEW_ROWS; row++) {
+        long long y = top + row;
         std::wstring midRow = L"|";
         std::wstring subRow = L"+";
 
-        for (int col = 0; col < WIDTH; col++) {
-            std::pair<int, int> position = std::make_pair(row, col);
+        for (int col = 0; col < endless.getWidth(); col++) {
+            uint8_t passages = endless.getPassages(col, y);
+            bool isPlayer = col == endless.getPlayerX() && y == endless.getPlayerY();
+            midRow += isPlayer ? L"@" : L" ";
+            midRow += (passages & MazeGrid::OPEN_EAST) ? L" " : L"|";
+            subRow += (passages & MazeGrid::OPEN_SOUTH) ? L" +" : L"-+";
+        }
+
+        screenBuffer.writeToScreen(0, row * 2 + 1, midRow);
+        screenBuffer.writeToScreen(0, row * 2 + 2, subRow);
+    }
+
+    screenBuffer.writeToScreen(0, ENDLESS_VIEW_ROWS * 2 + 2, L"Depth: " + std::to_wstring(endless.getPlayerY()) +
+        L"  Deepest: " + std::to_wstring(endless.getDeepestRow()) + L"  (w/a/s/d to move, q to quit)");
+}
+
+
+// Run the endless maze
+int Maze::runEndless() {
+    EndlessMaze endless(ENDLESS_WIDTH, static_cast<uint32_t>(rand()));
+    screenBuffer.setActive();
+    printEndless(endless);
 
-            // Vertical  wall (East connection)
-            if (mazeMap.at(position)->getNeighbor(Direction::EAST) == nullptr) {
-                midRow += L" |";  
+    while (true) {
+        char input = _getch();
+        int direction;
+
+        switch (input) {
+        case 'w':
+            direction = MazeGrid::NORTH;
+            break;
+        case 's':
+            direction = MazeGrid::SOUTH;
+            break;
+        case 'a':
+            direction = MazeGrid::WEST;
+            break;
+        case 'd':
+            direction = MazeGrid::EAST;
+            break;
+        case 'q':
+            return 0;
+        default:
+            continue;
+        }
+
+        if (endless.movePlayer(direction)) {
+            printEndless(endless);
+        }
+    }
+}
+
+
+// Get the character drawn in the middle of a cell of the 3D maze
+wchar_t Maze::layeredSymbol(const MazeGrid3D& layered, int cell, int player, int exit) const {
+    if (cell == player) {
+        return L'@';
+    }
+    if (cell == exit) {
+        return L'X';
+    }
+
+    uint8_t stairs = layered.getPassages(cell) & (MazeGrid3D::OPEN_UP | MazeGrid3D::OPEN_DOWN);
+    if (stairs == (MazeGrid3D::OPEN_UP | MazeGrid3D::OPEN_DOWN)) {
+        return L'*';
+    }
+    if (stairs == MazeGrid3D::OPEN_UP) {
+        return L'<';
+    }
+    return (stairs == MazeGrid3D::OPEN_DOWN) ? L'>' : L' ';
+}
+
+
+// Draw the player's level of the 3D maze, then everything in the middle of its cells on top
+void Maze::drawLevel(const MazeGrid3D& layered, const MazeGrid& layer, int player, int exit) {
+    view.drawAll(layer);
+
+    int level = layered.getLevel(player);
+    int columns = std::min(view.getColumns(), layer.getWidth() - view.getOriginX());
+    int rows = std::min(view.getRows(), layer.getHeight() - view.getOriginY());
+    for (int y = view.getOriginY(); y < view.getOriginY() + rows; y++) {
+        for (int x = view.getOriginX(); x < view.getOriginX() + columns; x++) {
+            wchar_t symbol = layeredSymbol(layered, layered.index(x, y, level), player, exit);
+            if (symbol != L' ') {
+                view.drawCell(layer, layer.index(x, y), symbol);
             }
-            else {
-                midRow += L"  ";  // No wall (open path)
+        }
+    }
+}
+
+
+// Print the level, moves and keys below the 3D maze
+void Maze::printLayeredStatus(const MazeGrid3D& layered, int player, int exit, const std::wstring& message) {
+    std::wstring status = L"Level: " + std::to_wstring(layered.getLevel(player) + 1) + L"/" + std::to_wstring(layered.getLevels()) +
+        L"  Exit on level " + std::to_wstring(layered.getLevel(exit) + 1) + L"  Moves: " + std::to_wstring(moves) +
+        L"  (w/a/s/d to move, r/f to go up/down stairs, h for a hint, q to quit)  " + message;
+    status.resize(std::max(status.size(), static_cast<size_t>(screenBuffer.getScreenWidth() - 1)), L' ');
+    screenBuffer.writeToScreen(0, view.getRows() * 2 + 2, status);
+}
+
+
+// Run the 3D maze
+int Maze::runLayered() {
+    MazeGrid3D layered(LAYERED_WIDTH, LAYERED_HEIGHT, LAYERED_LEVELS);
+    WilsonGenerator3D().generate(layered, static_cast<uint32_t>(rand()));
+
+    // The ends of a longest path, as in the flat maze
+    int player = solver.farthestCell(layered, layered.index(0, 0, 0));
+    int exit = solver.farthestCell(layered, player);
+    std::vector<int> distances = solver.distanceField(layered, exit);
+
+    // Only the player's level is drawn, from a copy of it as a flat grid
+    MazeGrid layer;
+    layered.copyLevel(layered.getLevel(player), layer);
+    moves = 0;
+
+    screenBuffer.setActive();
+    view.resize(std::min(LAYERED_WIDTH, (screenBuffer.getScreenWidth() - 1) / 2),
+        std::min(LAYERED_HEIGHT, (screenBuffer.getScreenHeight() - 3) / 2));
+    view.follow(layer, layered.getX(player), layered.getY(player));
+    drawLevel(layered, layer, player, exit);
+    screenBuffer.clearScreen();
+    view.flush(screenBuffer, 0, 0);
+    printLayeredStatus(layered, player, exit, L"");
+
+    while (player != exit) {
+        char input = _getch();
+        int direction;
+
+        switch (input) {
+        case 'w':
+            direction = MazeGrid3D::NORTH;
+            break;
+        case 's':
+            direction = MazeGrid3D::SOUTH;
+            break;
+        case 'a':
+            direction = MazeGrid3D::WEST;
+            break;
+        case 'd':
+            direction = MazeGrid3D::EAST;
+            break;
+        case 'r':
+            direction = MazeGrid3D::UP;
+            break;
+        case 'f':
+            direction = MazeGrid3D::DOWN;
+            break;
+        case 'h': {
+            const wchar_t* names[] = { L"north", L"south", L"east", L"west", L"up the stairs", L"down the stairs" };
+            for (direction = 0; direction < 6; direction++) {
+                if (layered.isOpen(player, direction) && distances[layered.step(player, direction)] == distances[player] - 1) {
+                    break;
+                }
+            }
+            printLayeredStatus(layered, player, exit, std::wstring(L"Try ") + names[direction] + L".");
+            continue;
+        }
+        case 'q':
+            return 0;
+        default:
+            continue;
+        }
+
+        if (!layered.isOpen(player, direction)) {
+            continue;
+        }
+        int previous = player;
+        player = layered.step(player, direction);
+        moves++;
+
+        // Taking the stairs or scrolling draws the whole view again; otherwise only the two cells changed
+        bool scrolled = view.follow(layer, layered.getX(player), layered.getY(player));
+        if (layered.getLevel(player) != layered.getLevel(previous)) {
+            layered.copyLevel(layered.getLevel(player), layer);
+            drawLevel(layered, layer, player, exit);
+        }
+        else if (scrolled) {
+            drawLevel(layered, layer, player, exit);
+        }
+        else {
+            view.drawCell(layer, layer.index(layered.getX(previous), layered.getY(previous)), layeredSymbol(layered, previous, player, exit));
+            view.drawCell(layer, layer.index(layered.getX(player), layered.getY(player)), L'@');
+        }
+        view.flush(screenBuffer, 0, 0);
+        printLayeredStatus(layered, player, exit, L"");
+    }
+
+    printLayeredStatus(layered, player, exit, L"You found the way out! Press any key.");
+    _getch();
+
+    return 0;
+}
+
+
+// Print the time, moves and keys below the maze in the race
+void Maze::printRaceStatus(const MazeRace& race, const std::wstring& message) {
+    long long tenths = race.getTicks() * 10 / MazeRace::TICKS_PER_SECOND;
+    std::wstring status = L"Time: " + std::to_wstring(tenths / 10) + L"." + std::to_wstring(tenths % 10) + L"s  Moves: " +
+        std::to_wstring(moves) + L"  Monsters: " + std::to_wstring(race.getMonsters().size()) +
+        L"  (w/a/s/d to move, q to quit)  " + message;
+    status.resize(std::max(status.size(), static_cast<size_t>(screenBuffer.getScreenWidth() - 1)), L' ');
+    screenBuffer.writeToScreen(0, view.getRows() * 2 + 2, status);
+}
+
+
+// Run the race against the monsters
+int Maze::runRace() {
+    const std::chrono::steady_clock::duration tickLength = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / MazeRace::TICKS_PER_SECOND));
+    MazeRace race(grid, toCell(start), toCell(end), RACE_MONSTERS, static_cast<uint32_t>(rand()));
+
+    playerPosition = start;
+    moves = 0;
+    fogOfWar = false;
+    printMaze();
+
+    std::vector<int> shown = race.getMonsters();
+    for (int cell : shown) {
+        view.drawCell(grid, cell, L'M');
+    }
+    view.flush(screenBuffer, 0, 0);
+    printRaceStatus(race, L"");
+
+    auto previousTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration lag(0);
+    int direction = -1;
+
+    while (!race.isOver()) {
+        auto now = std::chrono::steady_clock::now();
+        lag += now - previousTime;
+        previousTime = now;
+
+        // The last key pressed since the last tick is the way the player goes
+        for (char key : screenBuffer.getNonBlockingInput()) {
+            switch (key) {
+            case 'w':
+                direction = MazeGrid::NORTH;
+                break;
+            case 's':
+                direction = MazeGrid::SOUTH;
+                break;
+            case 'a':
+                direction = MazeGrid::WEST;
+                break;
+            case 'd':
+                direction = MazeGrid::EAST;
+                break;
+            case 'q':
+                return 0;
+            default:
+                break;
             }
+        }
 
-            // Horizontal wall (South connection)
-            if (mazeMap.at(position)->getNeighbor(Direction::SOUTH) == nullptr) {
-                subRow += L"-+";   
+        // Catch the race up with the clock a fixed tick at a time
+        int ticks = 0;
+        while (lag >= tickLength && !race.isOver()) {
+            if (race.tick(direction)) {
+                moves++;
+            }
+            direction = -1;
+            lag -= tickLength;
+            ticks++;
+        }
+
+        // Draw once for however many ticks there were, the monsters after the cells they left so none is rubbed out
+        if (ticks > 0) {
+            std::pair<int, int> previousPosition = playerPosition;
+            playerPosition = toPosition(race.getPlayer());
+
+            if (view.follow(grid, playerPosition.first, playerPosition.second)) {
+                drawView();
             }
             else {
-                subRow += L" +";   // No wall (open path)
+                for (int cell : shown) {
+                    view.drawCell(grid, cell, cellSymbol(cell));
+                }
+                view.drawCell(grid, toCell(previousPosition), cellSymbol(toCell(previousPosition)));
+                view.drawCell(grid, toCell(playerPosition), cellSymbol(toCell(playerPosition)));
+            }
+
+            shown = race.getMonsters();
+            for (int cell : shown) {
+                view.drawCell(grid, cell, L'M');
             }
+            view.flush(screenBuffer, 0, 0);
+            printRaceStatus(race, L"");
         }
 
-        // Write the rows to the screen
-        screenBuffer.writeToScreen(0, row * 2, midRow);      
-        screenBuffer.writeToScreen(0, row * 2 + 1, subRow);  
+        std::this_thread::sleep_for(tickLength - lag);
     }
+
+    printRaceStatus(race, race.isEscaped() ? L"You got away! Press any key." : L"A monster caught you! Press any key.");
+    _getch();
+
+    return 0;
 }
 
 
 // Run the maze game
 int Maze::run() {
+    screenBuffer.setActive();
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Play the (e)ndless maze, the (3)D maze, the maze in (f)og, a (r)ace against monsters, or press enter for a flat maze: ");
+    std::string choice = screenBuffer.getBlockingInput();
+    if (choice == "e") {
+        return runEndless();
+    }
+    if (choice == "3") {
+        return runLayered();
+    }
+    if (choice == "r") {
+        return runRace();
+    }
 	// Set the player position to the start of the maze
-	//playerPosition = start;
+	playerPosition = start;
+	moves = 0;
+
+	// In fog of war the player starts out seeing only what is in sight of the start
+	fogOfWar = choice == "f";
+	if (fogOfWar) {
+		fog.reset(grid.getCellCount());
+		fog.reveal(grid, toCell(playerPosition));
+	}
 
 	// Print the maze
-    screenBuffer.setActive();
 	printMaze();
 
-	Sleep(100000);
-
 	// Loop until the player reaches the end of the maze
-	while (playerPosition != end) {
+	while (!checkWin()) {
 		// Get the player input
 		char input = _getch();
+		std::pair<int, int> previousPosition = playerPosition;
+		bool moved = false;
 
 		// Move the player based on the input
 		switch (input) {
 		case 'w':
-			if (mazeMap.at(playerPosition)->getNeighbor(Direction::NORTH) != nullptr) {
-				playerPosition = std::make_pair(playerPosition.first, playerPosition.second - 1);
-			}
+			moved = movePlayer(Direction::NORTH);
 			break;
 		case 's':
-			if (mazeMap.at(playerPosition)->getNeighbor(Direction::SOUTH) != nullptr) {
-				playerPosition = std::make_pair(playerPosition.first, playerPosition.second + 1);
-			}
+			moved = movePlayer(Direction::SOUTH);
 			break;
 		case 'a':
-			if (mazeMap.at(playerPosition)->getNeighbor(Direction::WEST) != nullptr) {
-				playerPosition = std::make_pair(playerPosition.first - 1, playerPosition.second);
-			}
+			moved = movePlayer(Direction::WEST);
 			break;
 		case 'd':
-			if (mazeMap.at(playerPosition)->getNeighbor(Direction::EAST) != nullptr) {
-				playerPosition = std::make_pair(playerPosition.first + 1, playerPosition.second);
-			}
+			moved = movePlayer(Direction::EAST);
+			break;
+		case 'h': {
+			const wchar_t* names[] = { L"north", L"south", L"east", L"west" };
+			printStatus(std::wstring(L"Try ") + names[getHint()] + L".");
 			break;
+		}
+		case 'q':
+			return 0;
 		default:
 			break;
 		}
 
-		// Print the maze
-		printMaze();
+		// Redraw only the cells the player left and entered
+		if (moved) {
+			updateMaze(previousPosition);
+		}
 	}
 
+	printStatus(L"You found the way out! Press any key.");
+	_getch();
+
 	return 0;
 }
\ No newline at end of file
@@ -8,12 +8,23 @@
 */
 
 #include "screenBuffer.h"
+#include "mazeGrid.h"
+#include "mazeGenerator.h"
+#include "endlessMaze.h"
+#include "mazeView.h"
+#include "mazeFile.h"
+#include "mazeFog.h"
+#include "mazeRace.h"
+#include "mazeSolver.h"
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <vector>
 #include <set>
 #include <memory>
 #include <cstdlib>  
 #include <ctime>
+#include <thread>
 
  // Forward declaration of the test class
 namespace MazeTests {
@@ -29,6 +40,8 @@ enum Direction {
 	SOUTH, /*!< Direction going to the bottom of the board */
 	EAST, /*!< Direction going to the right of the board. */
 	WEST, /*!< Direction going to the left of the board. */
+	UP, /*!< Direction going up the stairs to the next level, in the 3D maze. */
+	DOWN, /*!< Direction going down the stairs to the level below, in the 3D maze. */
 };
 
 /*!
@@ -104,7 +117,14 @@ class Maze {
 	 friend class MazeTests::MazeTests;
 
 	 static const int OUT_OF_BOUNDS = -1; /*!< Constant to represent out of bounds. */
-	 ScreenBuffer screenBuffer; /*!< The screen buffer for displaying the game. */
+	 static const int ENDLESS_WIDTH = 30; /*!< The width of the endless maze. */
+	 static const int ENDLESS_VIEW_ROWS = 15; /*!< The rows of the endless maze shown around the player. */
+	 static const int LAYERED_WIDTH = 256; /*!< The width of the 3D maze. */
+	 static const int LAYERED_HEIGHT = 256; /*!< The height of the 3D maze. */
+	 static const int LAYERED_LEVELS = 16; /*!< The levels of the 3D maze. */
+	 static const int RACE_MONSTERS = 24; /*!< The monsters chasing the player in the race. */
+	 std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	 ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
 
 	 int WIDTH; /*!< Width of maze.*/
 	 int HEIGHT; /*!< Height of maze.*/
@@ -116,6 +136,15 @@ class Maze {
 	 std::map<std::pair<int, int>, std::unique_ptr<MazeNode>> mazeMap; /*!< A map of positions to nodes in the maze.*/
 	 std::set<std::pair<int, int>> inMaze; /*!< Set to track which nodes are already in the maze. */
 
+	 MazeGrid grid; /*!< The maze as a flat array of passage masks, for solving. */
+	 MazeSolver solver; /*!< Finds distances and paths through the grid. */
+	 std::vector<int> exitDistances; /*!< The distance of every cell from the end, for hints. */
+	 MazeView view; /*!< The part of the maze on the screen. */
+	 int moves; /*!< The moves the player has made. */
+	 uint32_t seed; /*!< The random seed the maze was generated from, kept in saved mazes. */
+	 bool fogOfWar; /*!< Whether only the cells the player has seen are drawn. */
+	 MazeFog fog; /*!< The cells the player has seen, in fog of war. */
+
 	 /*!
 	 * @brief Checks if postion is valid.
 	 * @param position - The position to check.
@@ -176,18 +205,115 @@ class Maze {
 	 void generateMaze(int width, int height);
 
 	 /*!
-	 * @brief Prints the maze to the console.
+	 * @brief Generate maze with a chosen algorithm.
+	 * @details Wilson's algorithm works on the nodes as generateMaze always has; the others carve the grid, which the nodes are then linked from.
+	 * @param width - The width of the maze.
+	 * @param height - The height of the maze.
+	 * @param algorithm - The algorithm to generate it with.
+	 */
+	 void generateMaze(int width, int height, MazeAlgorithm algorithm);
+
+	 /*!
+	 * @brief Link the nodes in mazeMap from the passages in the grid, so both hold the same maze.
+	 */
+	 void buildNodes();
+
+	 /*!
+	 * @brief Copy the passages between the nodes in mazeMap into the grid.
+	 * @details Each passage is found from where the two linked nodes are, not the direction it was linked in.
+	 */
+	 void buildGrid();
+
+	 /*!
+	 * @brief Get the grid cell of a position.
+	 * @param position - The position, column first.
+	 * @return The cell.
+	 */
+	 int toCell(std::pair<int, int> position) const { return grid.index(position.first, position.second); }
+
+	 /*!
+	 * @brief Get the position of a grid cell.
+	 * @param cell - The cell.
+	 * @return The position, column first.
+	 */
+	 std::pair<int, int> toPosition(int cell) const { return std::make_pair(cell % WIDTH, cell / WIDTH); }
+
+	 /*!
+	 * @brief Prints the part of the maze around the player to the console.
 	 */
 	 void printMaze();
 
 	 /*!
-	 * @brief Update the maze printed to the console.
-	 * @param playerPosition - The position of the player.
+	 * @brief Draw every cell in the view, with the start, end and player on top.
+	 * @details In fog of war, the cells not yet seen are drawn as fog.
 	 */
-	 void updateMaze(std::pair<int, int> playerPosition);
+	 void drawView();
 
 	 /*!
-	 * @brief Choose a random start and end point of the maze.
+	 * @brief Get the character drawn in the middle of a cell.
+	 * @param cell - The cell.
+	 * @return '@' for the player, 'X' for the end, 'S' for the start, or a space.
+	 */
+	 wchar_t cellSymbol(int cell) const;
+
+	 /*!
+	 * @brief Print the moves, par and keys below the maze.
+	 * @param message - A message to add after them.
+	 */
+	 void printStatus(const std::wstring& message);
+
+	 /*!
+	 * @brief Prints the rows of the endless maze around the player.
+	 * @param endless - The endless maze.
+	 */
+	 void printEndless(const EndlessMaze& endless);
+
+	 /*!
+	 * @brief Get the character drawn in the middle of a cell of the 3D maze.
+	 * @param layered - The 3D maze.
+	 * @param cell - The cell.
+	 * @param player - The player's cell.
+	 * @param exit - The cell to reach.
+	 * @return '@' for the player, 'X' for the end, '<' for stairs up, '>' for stairs down, '*' for both, or a space.
+	 */
+	 wchar_t layeredSymbol(const MazeGrid3D& layered, int cell, int player, int exit) const;
+
+	 /*!
+	 * @brief Draw every cell of the 3D maze's level in the view, with the stairs, the end and the player on top.
+	 * @param layered - The 3D maze.
+	 * @param layer - The player's level, copied out of the 3D maze.
+	 * @param player - The player's cell.
+	 * @param exit - The cell to reach.
+	 */
+	 void drawLevel(const MazeGrid3D& layered, const MazeGrid& layer, int player, int exit);
+
+	 /*!
+	 * @brief Print the level, moves and keys below the 3D maze.
+	 * @param layered - The 3D maze.
+	 * @param player - The player's cell.
+	 * @param exit - The cell to reach.
+	 * @param message - A message to add after them.
+	 */
+	 void printLayeredStatus(const MazeGrid3D& layered, int player, int exit, const std::wstring& message);
+
+	 /*!
+	 * @brief Print the time, moves and keys below the maze in the race.
+	 * @param race - The race.
+	 * @param message - A message to add after them.
+	 */
+	 void printRaceStatus(const MazeRace& race, const std::wstring& message);
+
+	 /*!
+	 * @brief Update the maze printed to the console after the player moves.
+	 * @details Only the cells the player left and entered are drawn again, and in fog of war those that came into sight,
+	 * @details unless the view had to scroll.
+	 * @param previousPosition - The position the player moved from.
+	 */
+	 void updateMaze(std::pair<int, int> previousPosition);
+
+	 /*!
+	 * @brief Choose the start and end of the maze as far apart as they can be.
+	 * @details The cell furthest from any cell is one end of a longest path, and the cell furthest from that the other.
 	 * @return A pair of start and end points.
 	 */
 	 std::pair<std::pair<int, int>, std::pair<int, int>> chooseStartAndEnd();
@@ -216,20 +342,77 @@ public :
 	* @brief Constructor for Maze class.
 	* @param width - The width of the maze.
 	* @param height - The height of the maze.
+	* @param algorithm - The algorithm to generate the maze with.
+	* @param buffer - The screen buffer to draw on, such as the menu's, or null for the game to make its own.
 	*/
-	Maze(int width, int height);
+	Maze(int width, int height, MazeAlgorithm algorithm = MazeAlgorithm::WILSON, ScreenBuffer* buffer = nullptr);
 	 
 	/*!
 	* @brief Destructor for Maze class.
 	*/
 	~Maze() = default; 
 
+	/*!
+	* @brief Get the fewest moves from the start to the end.
+	* @return The par for the maze.
+	*/
+	int getPar() const;
+
+	/*!
+	* @brief Get the way to go from the player's position towards the end.
+	* @return The direction of the next step on the shortest path; NORTH if the player is already there.
+	*/
+	Direction getHint() const;
+
+	/*!
+	* @brief Rate how hard the maze is by the junctions on the way from the start to the end.
+	* @details Every junction passed is a chance to take a wrong turn, where the length of the path alone is not.
+	* @return The number of cells on the shortest path with three or more passages.
+	*/
+	int getDifficulty() const;
+
+	/*!
+	* @brief Save the maze, its start and its end to a maze file.
+	* @param filename - The name of the file.
+	* @throws runtime_error if the file cannot be written.
+	*/
+	void saveMaze(const std::string& filename) const;
+
+	/*!
+	* @brief Replace the maze with one from a maze file, putting the player at its start.
+	* @details Only the grid is filled in, not the nodes, which would take far more memory than the grid for a large maze.
+	* @param filename - The name of the file.
+	* @throws runtime_error if the file cannot be opened or is not a maze file.
+	*/
+	void loadMaze(const std::string& filename);
+
 	/*!
 	* @brief Runs the game logic/loop.
 	* @details The game logic will handle player moves, check game conditions, and print the maze to the console.
 	* @return either RETURN_TO_MENU or EXIT_GAME based on the user input.
 	*/
 	int run();
+
+	/*!
+	* @brief Runs the endless maze, which goes down as far as the player does.
+	* @return RETURN_TO_MENU when the player quits.
+	*/
+	int runEndless();
+
+	/*!
+	* @brief Runs the 3D maze, levels of maze joined by stairs, drawn a level at a time.
+	* @return RETURN_TO_MENU when the player quits or escapes.
+	*/
+	int runLayered();
+
+	/*!
+	* @brief Runs the race, the maze against the clock with monsters in pursuit.
+	* @details The race is advanced a fixed tick at a time, as many ticks as the time since the last frame holds, and
+	* @details drawn once after them, so it runs at the same speed however long drawing takes. Keys are read without
+	* @details waiting, and the loop sleeps until the next tick is due rather than spinning.
+	* @return RETURN_TO_MENU when the player quits, escapes or is caught.
+	*/
+	int runRace();
 };
  
 #endif // MAZE_H
@@ -0,0 +1,222 @@
+#include "mazeFile.h"
+#include <algorithm>
+#include <stdexcept>
+
+// File header written at the start of every maze file
+static const char FILE_MAGIC[4] = { 'M', 'A', 'Z', 'E' };
+
+// Write the packed cells out once this many bytes are waiting
+static const size_t BUFFER_BYTES = 1 << 16;
+
+
+// Writes a number as little-endian bytes
+static void storeLittleEndian(uint8_t* bytes, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+
+// Reads a number stored as little-endian bytes
+static uint32_t loadLittleEndian(const uint8_t* bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= uint32_t(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+
+// Checks a size is one a MazeGrid can have and has at least one cell
+static bool isValidSize(int64_t width, int64_t height) {
+    return width > 0 && height > 0 && width * height <= INT32_MAX / 2;
+}
+
+
+// Checks a position is inside a maze
+static bool isInside(std::pair<int, int> position, int width, int height) {
+    return position.first >= 0 && position.first < width && position.second >= 0 && position.second < height;
+}
+
+
+// Creates a maze file and writes its header
+MazeFileWriter::MazeFileWriter(const std::string& filename, int width, int height, uint32_t seed,
+    std::pair<int, int> start, std::pair<int, int> end)
+    : filename(filename), width(width), height(height), rowsWritten(0), pending(0), pendingCells(0) {
+    if (!isValidSize(width, height)) {
+        throw std::runtime_error("A maze file cannot hold a maze " + std::to_string(width) + " by " + std::to_string(height));
+    }
+    if (!isInside(start, width, height) || !isInside(end, width, height)) {
+        throw std::runtime_error("The start and end must be inside the maze");
+    }
+
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not write maze file " + filename);
+    }
+
+    uint8_t header[MazeFile::HEADER_BYTES] = {};
+    std::copy(FILE_MAGIC, FILE_MAGIC + 4, header);
+    storeLittleEndian(header + 4, MazeFile::VERSION);
+    storeLittleEndian(header + 8, static_cast<uint32_t>(width));
+    storeLittleEndian(header + 12, static_cast<uint32_t>(height));
+    storeLittleEndian(header + 16, seed);
+    storeLittleEndian(header + 20, static_cast<uint32_t>(start.first));
+    storeLittleEndian(header + 24, static_cast<uint32_t>(start.second));
+    storeLittleEndian(header + 28, static_cast<uint32_t>(end.first));
+    storeLittleEndian(header + 32, static_cast<uint32_t>(end.second));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    buffer.reserve(BUFFER_BYTES);
+}
+
+
+// Writes the buffered bytes to the file
+void MazeFileWriter::flush() {
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    buffer.clear();
+    if (!file) {
+        throw std::runtime_error("Could not write maze file " + filename);
+    }
+}
+
+
+// Packs the south and east passages of a row, carrying a part-filled byte over to the next row
+void MazeFileWriter::writeRow(const uint8_t* passages) {
+    if (rowsWritten == height) {
+        throw std::runtime_error("Every row of maze file " + filename + " has been written");
+    }
+
+    bool lastRow = rowsWritten == height - 1;
+    for (int x = 0; x < width; x++) {
+        int bits = 0;
+        if ((passages[x] & MazeGrid::OPEN_SOUTH) && !lastRow) {
+            bits |= 1;
+        }
+        if ((passages[x] & MazeGrid::OPEN_EAST) && x < width - 1) {
+            bits |= 2;
+        }
+
+        pending |= static_cast<uint8_t>(bits << (pendingCells * 2));
+        if (++pendingCells == 4) {
+            buffer.push_back(pending);
+            pending = 0;
+            pendingCells = 0;
+        }
+    }
+    rowsWritten++;
+
+    if (buffer.size() >= BUFFER_BYTES) {
+        flush();
+    }
+}
+
+
+// Writes out the last byte and closes the file
+void MazeFileWriter::finish() {
+    if (rowsWritten != height) {
+        throw std::runtime_error("Maze file " + filename + " has " + std::to_string(rowsWritten) + " of its " +
+            std::to_string(height) + " rows");
+    }
+
+    if (pendingCells > 0) {
+        buffer.push_back(pending);
+        pending = 0;
+        pendingCells = 0;
+    }
+    flush();
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Could not write maze file " + filename);
+    }
+}
+
+
+// Opens a maze file and checks its header
+MazeFile::MazeFile(const std::string& filename) : file(filename), cells(nullptr), width(0), height(0), seed(0) {
+    const uint8_t* bytes = file.data();
+    if (file.size() < HEADER_BYTES || !std::equal(FILE_MAGIC, FILE_MAGIC + 4, bytes) || loadLittleEndian(bytes + 4) != VERSION) {
+        throw std::runtime_error("Not a maze file: " + filename);
+    }
+
+    // Read as unsigned and checked before narrowing, so a corrupt size cannot come out negative
+    uint32_t fileWidth = loadLittleEndian(bytes + 8);
+    uint32_t fileHeight = loadLittleEndian(bytes + 12);
+    if (!isValidSize(fileWidth, fileHeight)) {
+        throw std::runtime_error("Maze file " + filename + " has a size no maze can have");
+    }
+    width = static_cast<int>(fileWidth);
+    height = static_cast<int>(fileHeight);
+
+    size_t cellBytes = (static_cast<size_t>(width) * height + 3) / 4;
+    if (file.size() - HEADER_BYTES < cellBytes) {
+        throw std::runtime_error("Maze file is cut short: " + filename);
+    }
+
+    seed = loadLittleEndian(bytes + 16);
+    start = std::make_pair(static_cast<int>(loadLittleEndian(bytes + 20)), static_cast<int>(loadLittleEndian(bytes + 24)));
+    end = std::make_pair(static_cast<int>(loadLittleEndian(bytes + 28)), static_cast<int>(loadLittleEndian(bytes + 32)));
+    if (!isInside(start, width, height) || !isInside(end, width, height)) {
+        throw std::runtime_error("Maze file " + filename + " has its start or end outside the maze");
+    }
+
+    cells = bytes + HEADER_BYTES;
+}
+
+
+// Gets the passages out of a cell, taking north and west from the cells above and before it
+uint8_t MazeFile::getPassages(int cell) const {
+    int x = cell % width;
+    int y = cell / width;
+    uint8_t passages = 0;
+
+    // The writer never stores passages off the edge, but a file written some other way might
+    int bits = getBits(cell);
+    if ((bits & 1) && y < height - 1) {
+        passages |= MazeGrid::OPEN_SOUTH;
+    }
+    if ((bits & 2) && x < width - 1) {
+        passages |= MazeGrid::OPEN_EAST;
+    }
+    if (y > 0 && (getBits(cell - width) & 1)) {
+        passages |= MazeGrid::OPEN_NORTH;
+    }
+    if (x > 0 && (getBits(cell - 1) & 2)) {
+        passages |= MazeGrid::OPEN_WEST;
+    }
+    return passages;
+}
+
+
+// Decodes every cell into a grid, setting each passage on both the cells it joins
+void MazeFile::load(MazeGrid& grid) const {
+    grid.reset(width, height);
+    uint8_t* data = grid.data();
+
+    int cell = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, cell++) {
+            int bits = getBits(cell);
+            if ((bits & 1) && y < height - 1) {
+                data[cell] |= MazeGrid::OPEN_SOUTH;
+                data[cell + width] |= MazeGrid::OPEN_NORTH;
+            }
+            if ((bits & 2) && x < width - 1) {
+                data[cell] |= MazeGrid::OPEN_EAST;
+                data[cell + 1] |= MazeGrid::OPEN_WEST;
+            }
+        }
+    }
+}
+
+
+// Writes a grid to a maze file a row at a time
+void MazeFile::save(const std::string& filename, const MazeGrid& grid, uint32_t seed,
+    std::pair<int, int> start, std::pair<int, int> end) {
+    MazeFileWriter writer(filename, grid.getWidth(), grid.getHeight(), seed, start, end);
+    for (int y = 0; y < grid.getHeight(); y++) {
+        writer.writeRow(grid.data() + static_cast<size_t>(y) * grid.getWidth());
+    }
+    writer.finish();
+}
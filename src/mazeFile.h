@@ -0,0 +1,163 @@
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+/*!
+* @file mazeFile.h
+* @brief Contains the declaration of the binary maze file format, its streaming writer and its memory mapped reader.
+* @details A maze file starts with a 40 byte header: "MAZE", the version, the width, the height, the seed, the start
+* @details column and row, the end column and row and four reserved bytes, each a little-endian 32-bit number. After
+* @details it come two bits for every cell, row by row and four cells to a byte starting from the low bits: bit 0 set
+* @details if the cell has a passage south and bit 1 if it has one east. The passages north and west of a cell are the
+* @details ones south of the cell above it and east of the cell before it, so a maze takes a quarter of a byte a cell.
+*/
+
+#include "mappedFile.h"
+#include "mazeGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+* @class MazeFileWriter
+* @brief Writes a maze file a row at a time, so a maze never has to be held whole to be saved.
+*/
+class MazeFileWriter {
+	std::ofstream file; /*!< The maze file. */
+	std::string filename; /*!< The name of the file, for errors. */
+	int width; /*!< The number of columns. */
+	int height; /*!< The number of rows. */
+	int rowsWritten; /*!< The rows written so far. */
+	uint8_t pending; /*!< The cells of a byte not yet full, packed as they will be written. */
+	int pendingCells; /*!< The cells in pending. */
+	std::vector<uint8_t> buffer; /*!< Packed bytes waiting to be written to the file. */
+
+	/*!
+	* @brief Write the buffered bytes to the file.
+	* @throws runtime_error if the file cannot be written.
+	*/
+	void flush();
+
+public:
+	/*!
+	* @brief Create a maze file and write its header.
+	* @param filename The name of the file.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param seed The seed the maze was generated from.
+	* @param start The start of the maze, column first.
+	* @param end The end of the maze, column first.
+	* @throws runtime_error if the size is not one a MazeGrid can have, the start or end is outside the maze, or the
+	* @throws file cannot be written.
+	*/
+	MazeFileWriter(const std::string& filename, int width, int height, uint32_t seed,
+		std::pair<int, int> start, std::pair<int, int> end);
+
+	/*!
+	* @brief Write the next row of the maze.
+	* @param passages The passage masks of the row, width of them, as MazeGrid keeps them; only south and east are kept.
+	* @throws runtime_error if every row has been written already.
+	*/
+	void writeRow(const uint8_t* passages);
+
+	/*!
+	* @brief Write out what is left and close the file.
+	* @throws runtime_error if not every row was written or the file cannot be written.
+	*/
+	void finish();
+};
+
+/*!
+* @class MazeFile
+* @brief Reads a maze file in place from a memory mapping.
+* @details Opening a file only checks its header, so it costs the same whatever the size of the maze, and any cell
+* @details can be read straight from the mapping without decoding the rest.
+*/
+class MazeFile {
+public:
+	static constexpr uint32_t VERSION = 1; /*!< The version of the file format. */
+	static constexpr int HEADER_BYTES = 40; /*!< The size of the file header. */
+
+private:
+	MappedFile file; /*!< The mapped maze file. */
+	const uint8_t* cells; /*!< The packed cells, after the header. */
+	int width; /*!< The number of columns. */
+	int height; /*!< The number of rows. */
+	uint32_t seed; /*!< The seed the maze was generated from. */
+	std::pair<int, int> start; /*!< The start of the maze, column first. */
+	std::pair<int, int> end; /*!< The end of the maze, column first. */
+
+	/*!
+	* @brief Get the two bits stored for a cell.
+	* @param cell The cell.
+	* @return 1 for a passage south, 2 for a passage east.
+	*/
+	int getBits(int cell) const { return (cells[cell >> 2] >> ((cell & 3) * 2)) & 3; }
+
+public:
+	/*!
+	* @brief Open a maze file and check its header.
+	* @param filename The name of the file.
+	* @throws runtime_error if the file cannot be opened, is not a maze file or is cut short.
+	*/
+	explicit MazeFile(const std::string& filename);
+
+	/*!
+	* @brief Get the number of columns.
+	* @return The width.
+	*/
+	int getWidth() const { return width; }
+
+	/*!
+	* @brief Get the number of rows.
+	* @return The height.
+	*/
+	int getHeight() const { return height; }
+
+	/*!
+	* @brief Get the seed the maze was generated from.
+	* @return The seed.
+	*/
+	uint32_t getSeed() const { return seed; }
+
+	/*!
+	* @brief Get the start of the maze.
+	* @return The start, column first.
+	*/
+	std::pair<int, int> getStart() const { return start; }
+
+	/*!
+	* @brief Get the end of the maze.
+	* @return The end, column first.
+	*/
+	std::pair<int, int> getEnd() const { return end; }
+
+	/*!
+	* @brief Get the passages out of a cell, read from the mapping.
+	* @param cell The cell, numbered as MazeGrid numbers them.
+	* @return The OPEN_ bits, as MazeGrid::getPassages gives them.
+	*/
+	uint8_t getPassages(int cell) const;
+
+	/*!
+	* @brief Decode the whole maze into a grid.
+	* @param grid The grid, made the size of the maze.
+	*/
+	void load(MazeGrid& grid) const;
+
+	/*!
+	* @brief Write a grid to a maze file.
+	* @param filename The name of the file.
+	* @param grid The maze.
+	* @param seed The seed the maze was generated from.
+	* @param start The start of the maze, column first.
+	* @param end The end of the maze, column first.
+	* @throws runtime_error if the start or end is outside the maze or the file cannot be written.
+	*/
+	static void save(const std::string& filename, const MazeGrid& grid, uint32_t seed,
+		std::pair<int, int> start, std::pair<int, int> end);
+};
+
+#endif // MAZE_FILE_H
@@ -0,0 +1,42 @@
+#include "mazeFog.h"
+
+
+// Constructor for the MazeFog class
+MazeFog::MazeFog(int range) : range(range), seenCount(0), visibleCount(0) {
+}
+
+
+// Covers every cell in fog again
+void MazeFog::reset(int cellCount) {
+    seen.assign((static_cast<size_t>(cellCount) + 63) / 64, 0);
+    revealed.clear();
+    seenCount = 0;
+    visibleCount = 0;
+}
+
+
+// Follows each corridor out of a cell until it turns, glancing into the side passages on the way
+const std::vector<int>& MazeFog::reveal(const MazeGrid& grid, int cell) {
+    revealed.clear();
+    visibleCount = 0;
+    see(cell);
+
+    for (int direction = 0; direction < 4; direction++) {
+        // The directions across this one: east and west for north and south, north and south for east and west
+        int side = (direction < 2) ? MazeGrid::EAST : MazeGrid::NORTH;
+
+        int current = cell;
+        for (int distance = 1; grid.isOpen(current, direction) && (range == 0 || distance <= range); distance++) {
+            current = grid.neighbour(current, direction);
+            see(current);
+
+            if (grid.isOpen(current, side)) {
+                see(grid.neighbour(current, side));
+            }
+            if (grid.isOpen(current, side + 1)) {
+                see(grid.neighbour(current, side + 1));
+            }
+        }
+    }
+    return revealed;
+}
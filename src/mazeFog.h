@@ -0,0 +1,97 @@
+#ifndef MAZE_FOG_H
+#define MAZE_FOG_H
+
+/*!
+* @file mazeFog.h
+* @brief Contains the declaration of the MazeFog class, which tracks the cells of a maze the player has seen.
+*/
+
+#include "mazeGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+* @class MazeFog
+* @brief The fog of war over a maze: a bit for each cell the player has seen, and what comes into sight with each move.
+* @details In a maze of corridors one cell wide, the player can see along each corridor leading out of their cell until
+* @details it turns or ends, and a cell into each side passage opening off it, but never through a wall. Rather than
+* @details cast rays across the whole screen and test each against the walls, the sight lines follow the passages out
+* @details from the player and stop at the first wall, so working out what is in sight only ever looks at the cells
+* @details that are, however large the maze is.
+*/
+class MazeFog {
+	int range; /*!< How many cells along a corridor can be seen; 0 for as far as it goes. */
+	std::vector<uint64_t> seen; /*!< A bit for every cell, set once the player has seen it. */
+	std::vector<int> revealed; /*!< The cells the last reveal call saw for the first time. */
+	int seenCount; /*!< The cells seen so far. */
+	int visibleCount; /*!< The cells in sight at the last reveal call. */
+
+	/*!
+	* @brief Mark a cell seen, noting it if it was not already.
+	* @param cell The cell.
+	*/
+	void see(int cell) {
+		uint64_t bit = uint64_t(1) << (cell & 63);
+		visibleCount++;
+		if (!(seen[cell >> 6] & bit)) {
+			seen[cell >> 6] |= bit;
+			revealed.push_back(cell);
+			seenCount++;
+		}
+	}
+
+public:
+	/*!
+	* @brief Constructor for MazeFog.
+	* @param range How many cells along a corridor can be seen; 0 for as far as it goes.
+	*/
+	explicit MazeFog(int range = 0);
+
+	/*!
+	* @brief Cover every cell in fog again, changing the number of cells if asked.
+	* @param cellCount The cells in the maze.
+	*/
+	void reset(int cellCount);
+
+	/*!
+	* @brief Check if the player has seen a cell.
+	* @param cell The cell.
+	* @return true if they have.
+	*/
+	bool isSeen(int cell) const { return (seen[cell >> 6] >> (cell & 63)) & 1; }
+
+	/*!
+	* @brief See everything in sight of a cell.
+	* @param grid The maze.
+	* @param cell The player's cell.
+	* @return The cells seen for the first time, valid until the next call; only these need drawing.
+	*/
+	const std::vector<int>& reveal(const MazeGrid& grid, int cell);
+
+	/*!
+	* @brief Get the cells the last reveal call saw for the first time.
+	* @return The cells.
+	*/
+	const std::vector<int>& getRevealed() const { return revealed; }
+
+	/*!
+	* @brief Get the number of cells seen so far.
+	* @return The count.
+	*/
+	int getSeenCount() const { return seenCount; }
+
+	/*!
+	* @brief Get the number of cells in sight at the last reveal call, which is all it looked at.
+	* @return The count, counting a cell again each time a sight line reaches it.
+	*/
+	int getVisibleCount() const { return visibleCount; }
+
+	/*!
+	* @brief Get the memory the fog takes.
+	* @return The bytes, about one for every eight cells.
+	*/
+	size_t getMemory() const { return seen.capacity() * sizeof(uint64_t) + revealed.capacity() * sizeof(int); }
+};
+
+#endif // MAZE_FOG_H
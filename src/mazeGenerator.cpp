@@ -0,0 +1,540 @@
+#include "mazeGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+
+// Puts every item back in a set of its own
+void DisjointSets::reset(int count) {
+    parents.resize(static_cast<size_t>(count));
+    sizes.assign(static_cast<size_t>(count), 1);
+    for (int item = 0; item < count; item++) {
+        parents[item] = item;
+    }
+}
+
+
+// Joins the sets two items are in
+bool DisjointSets::unite(int first, int second) {
+    first = find(first);
+    second = find(second);
+    if (first == second) {
+        return false;
+    }
+
+    if (sizes[first] < sizes[second]) {
+        std::swap(first, second);
+    }
+    parents[second] = first;
+    sizes[first] += sizes[second];
+    return true;
+}
+
+
+// Makes a generator for an algorithm
+std::unique_ptr<MazeGenerator> MazeGenerator::create(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+    case MazeAlgorithm::WILSON:
+        return std::make_unique<WilsonGenerator>();
+    case MazeAlgorithm::BACKTRACKER:
+        return std::make_unique<BacktrackerGenerator>();
+    case MazeAlgorithm::KRUSKAL:
+        return std::make_unique<KruskalGenerator>();
+    case MazeAlgorithm::ELLER:
+        return std::make_unique<EllerGenerator>();
+    case MazeAlgorithm::PRIM:
+        return std::make_unique<PrimGenerator>();
+    case MazeAlgorithm::PARALLEL:
+        return std::make_unique<ParallelGenerator>();
+    default:
+        throw std::runtime_error("Unknown maze algorithm");
+    }
+}
+
+
+// Measures the dead ends, junctions and river factor of a maze
+MazeStatistics MazeGenerator::measure(const MazeGrid& grid) {
+    static const uint8_t PASSAGE_COUNTS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+    MazeStatistics statistics = { 0, 0, 0.0, 0.0 };
+    long long corridorCells = 0;
+
+    for (int cell = 0; cell < grid.getCellCount(); cell++) {
+        int passages = PASSAGE_COUNTS[grid.getPassages(cell) & 0x0F];
+        if (passages >= 3) {
+            statistics.junctions++;
+        }
+        if (passages != 1) {
+            continue;
+        }
+        statistics.deadEnds++;
+
+        // Follow the corridor from the dead end until it branches or ends
+        int previous = MazeGrid::NO_CELL;
+        int current = cell;
+        while (true) {
+            corridorCells++;
+            uint8_t open = grid.getPassages(current);
+            int next = MazeGrid::NO_CELL;
+            for (int direction = 0; direction < 4; direction++) {
+                int neighbour = ((open >> direction) & 1) ? grid.neighbour(current, direction) : MazeGrid::NO_CELL;
+                if (neighbour != MazeGrid::NO_CELL && neighbour != previous) {
+                    next = neighbour;
+                }
+            }
+            if (next == MazeGrid::NO_CELL || PASSAGE_COUNTS[grid.getPassages(next) & 0x0F] != 2) {
+                break;
+            }
+            previous = current;
+            current = next;
+        }
+    }
+
+    if (grid.getCellCount() > 0) {
+        statistics.deadEndRatio = static_cast<double>(statistics.deadEnds) / grid.getCellCount();
+    }
+    if (statistics.deadEnds > 0) {
+        statistics.riverFactor = static_cast<double>(corridorCells) / statistics.deadEnds;
+    }
+    return statistics;
+}
+
+
+// Carves a maze by loop-erased random walks
+void WilsonGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    std::mt19937 random(seed);
+    int cells = grid.getCellCount();
+    grid.reset(grid.getWidth(), grid.getHeight());
+    if (cells == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    std::vector<uint8_t> inMaze(static_cast<size_t>(cells), 0);
+    std::vector<uint8_t> exits(static_cast<size_t>(cells), 0);
+    inMaze[random() % cells] = 1;
+
+    for (int start = 0; start < cells; start++) {
+        // Walk until the maze is reached, each cell remembering only the way the walk last left it
+        int cell = start;
+        while (!inMaze[cell]) {
+            int direction;
+            int next;
+            do {
+                direction = static_cast<int>(random() & 3);
+                next = grid.neighbour(cell, direction);
+            } while (next == MazeGrid::NO_CELL);
+
+            exits[cell] = static_cast<uint8_t>(direction);
+            cell = next;
+        }
+
+        // Following the exits from the start again skips every loop the walk made
+        for (cell = start; !inMaze[cell]; cell = grid.neighbour(cell, exits[cell])) {
+            inMaze[cell] = 1;
+            grid.openPassage(cell, exits[cell]);
+        }
+    }
+
+    workingMemory = inMaze.capacity() + exits.capacity();
+}
+
+
+// Carves a maze by depth-first search on an explicit stack
+void BacktrackerGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    std::mt19937 random(seed);
+    int cells = grid.getCellCount();
+    grid.reset(grid.getWidth(), grid.getHeight());
+    if (cells == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    // A cell has been visited once it has a passage, all but the first, which is marked by being on the stack
+    int first = static_cast<int>(random() % cells);
+    std::vector<int> stack;
+    stack.push_back(first);
+
+    while (!stack.empty()) {
+        int cell = stack.back();
+        int unvisited[4];
+        int count = 0;
+
+        for (int direction = 0; direction < 4; direction++) {
+            int neighbour = grid.neighbour(cell, direction);
+            if (neighbour != MazeGrid::NO_CELL && neighbour != first && grid.getPassages(neighbour) == 0) {
+                unvisited[count++] = direction;
+            }
+        }
+
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int direction = unvisited[random() % count];
+        grid.openPassage(cell, direction);
+        stack.push_back(grid.neighbour(cell, direction));
+    }
+
+    workingMemory = stack.capacity() * sizeof(int);
+}
+
+
+// Carves a maze by knocking down walls in random order
+void KruskalGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    std::mt19937 random(seed);
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    int cells = grid.getCellCount();
+    grid.reset(width, height);
+
+    // Each wall inside the grid as its cell times two, plus one for the east wall rather than the south
+    std::vector<uint32_t> walls;
+    walls.reserve(static_cast<size_t>(cells) * 2);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint32_t cell = static_cast<uint32_t>(grid.index(x, y));
+            if (y + 1 < height) {
+                walls.push_back(cell * 2);
+            }
+            if (x + 1 < width) {
+                walls.push_back(cell * 2 + 1);
+            }
+        }
+    }
+
+    // A Fisher-Yates shuffle on the generator directly, so a seed gives the same maze with any standard library
+    for (size_t i = walls.size(); i > 1; i--) {
+        std::swap(walls[i - 1], walls[random() % i]);
+    }
+
+    DisjointSets sets(cells);
+    int passages = 0;
+    for (size_t i = 0; i < walls.size() && passages + 1 < cells; i++) {
+        int cell = static_cast<int>(walls[i] >> 1);
+        int direction = (walls[i] & 1) ? MazeGrid::EAST : MazeGrid::SOUTH;
+        if (sets.unite(cell, (direction == MazeGrid::EAST) ? cell + 1 : cell + width)) {
+            grid.openPassage(cell, direction);
+            passages++;
+        }
+    }
+
+    workingMemory = walls.capacity() * sizeof(uint32_t) + sets.getMemory();
+}
+
+
+// Carves a maze by growing it from one cell
+void PrimGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    static const uint8_t OUTSIDE = 0;
+    static const uint8_t FRONTIER = 1;
+    static const uint8_t INSIDE = 2;
+
+    std::mt19937 random(seed);
+    int cells = grid.getCellCount();
+    grid.reset(grid.getWidth(), grid.getHeight());
+    if (cells == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    std::vector<uint8_t> states(static_cast<size_t>(cells), OUTSIDE);
+    std::vector<int> frontier;
+    auto addToMaze = [&](int cell) {
+        states[cell] = INSIDE;
+        for (int direction = 0; direction < 4; direction++) {
+            int neighbour = grid.neighbour(cell, direction);
+            if (neighbour != MazeGrid::NO_CELL && states[neighbour] == OUTSIDE) {
+                states[neighbour] = FRONTIER;
+                frontier.push_back(neighbour);
+            }
+        }
+    };
+
+    addToMaze(static_cast<int>(random() % cells));
+    while (!frontier.empty()) {
+        // Take a random frontier cell out by moving the last one into its place
+        size_t pick = random() % frontier.size();
+        int cell = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        int inside[4];
+        int count = 0;
+        for (int direction = 0; direction < 4; direction++) {
+            int neighbour = grid.neighbour(cell, direction);
+            if (neighbour != MazeGrid::NO_CELL && states[neighbour] == INSIDE) {
+                inside[count++] = direction;
+            }
+        }
+
+        grid.openPassage(cell, inside[random() % count]);
+        addToMaze(cell);
+    }
+
+    workingMemory = states.capacity() + frontier.capacity() * sizeof(int);
+}
+
+
+// Constructor for the EllerRows class
+EllerRows::EllerRows(int width, uint32_t seed)
+    : width(width), random(seed), sets(static_cast<size_t>(width)), fromAbove(static_cast<size_t>(width), 0),
+    firstColumn(static_cast<size_t>(width) * 2, -1), members(static_cast<size_t>(width), 0),
+    chosen(static_cast<size_t>(width), 0), joined(width) {
+    if (width < 1) {
+        throw std::runtime_error("A maze needs at least one column");
+    }
+
+    // Every cell of the first row starts in a set of its own
+    for (int x = 0; x < width; x++) {
+        sets[x] = width + x;
+    }
+}
+
+
+// Makes the next row
+void EllerRows::nextRow(uint8_t* row, bool last) {
+    // Cells the rows above joined share a set number; put them in one set again
+    joined.reset(width);
+    for (int x = 0; x < width; x++) {
+        if (firstColumn[sets[x]] < 0) {
+            firstColumn[sets[x]] = x;
+        }
+        else {
+            joined.unite(firstColumn[sets[x]], x);
+        }
+        row[x] = fromAbove[x] ? MazeGrid::OPEN_NORTH : 0;
+    }
+    for (int x = 0; x < width; x++) {
+        firstColumn[sets[x]] = -1;
+    }
+
+    // Join neighbours in different sets at random, or all of them on the last row
+    for (int x = 0; x + 1 < width; x++) {
+        if ((last || (random() & 1)) && joined.find(x) != joined.find(x + 1)) {
+            joined.unite(x, x + 1);
+            row[x] |= MazeGrid::OPEN_EAST;
+            row[x + 1] |= MazeGrid::OPEN_WEST;
+        }
+    }
+    if (last) {
+        return;
+    }
+
+    // Choose one cell of each set at random to be sure of going down, by reservoir sampling along the row
+    for (int x = 0; x < width; x++) {
+        int set = joined.find(x);
+        if (random() % ++members[set] == 0) {
+            chosen[set] = x;
+        }
+    }
+
+    // The chosen cells and others at random go down, carrying their set; the rest leave new sets below them
+    for (int x = 0; x < width; x++) {
+        int set = joined.find(x);
+        members[set] = 0;
+        if (chosen[set] == x || (random() & 1)) {
+            row[x] |= MazeGrid::OPEN_SOUTH;
+            sets[x] = set;
+            fromAbove[x] = 1;
+        }
+        else {
+            sets[x] = width + x;
+            fromAbove[x] = 0;
+        }
+    }
+}
+
+
+// Gets the memory the rows need
+size_t EllerRows::getMemory() const {
+    return (sets.capacity() + firstColumn.capacity() + members.capacity() + chosen.capacity()) * sizeof(int) +
+        fromAbove.capacity() + joined.getMemory();
+}
+
+
+// Carves a maze a row at a time
+void EllerGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    grid.reset(width, height);
+    if (grid.getCellCount() == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    EllerRows rows(width, seed);
+    for (int y = 0; y < height; y++) {
+        rows.nextRow(grid.data() + static_cast<size_t>(y) * width, y + 1 == height);
+    }
+
+    workingMemory = rows.getMemory();
+}
+
+
+// Constructor for the ParallelGenerator class
+ParallelGenerator::ParallelGenerator(int threads, int tileSize, MazeAlgorithm tileAlgorithm)
+    : threads(threads), tileSize(tileSize), tileAlgorithm(tileAlgorithm) {
+    if (tileSize < 1) {
+        throw std::runtime_error("A tile needs at least one cell");
+    }
+    if (tileAlgorithm == MazeAlgorithm::PARALLEL) {
+        throw std::runtime_error("The tiles of a parallel maze need an algorithm of their own");
+    }
+    if (this->threads <= 0) {
+        this->threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+
+// Carves the tiles on a pool of threads and joins them
+void ParallelGenerator::generate(MazeGrid& grid, uint32_t seed) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    grid.reset(width, height);
+    if (grid.getCellCount() == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    int tilesAcross = (width + tileSize - 1) / tileSize;
+    int tilesDown = (height + tileSize - 1) / tileSize;
+    int tileCount = tilesAcross * tilesDown;
+    int workers = std::min(threads, tileCount);
+
+    // Each worker takes the next tile not yet taken until there are none left
+    std::atomic<int> nextTile(0);
+    std::vector<size_t> memory(static_cast<size_t>(workers), 0);
+    auto work = [&](int worker) {
+        std::unique_ptr<MazeGenerator> generator = MazeGenerator::create(tileAlgorithm);
+        MazeGrid tile;
+
+        for (int index = nextTile++; index < tileCount; index = nextTile++) {
+            int left = (index % tilesAcross) * tileSize;
+            int top = (index / tilesAcross) * tileSize;
+            int tileWidth = std::min(tileSize, width - left);
+            int tileHeight = std::min(tileSize, height - top);
+
+            // A seed per tile rather than per thread keeps the maze the same with any number of threads
+            tile.reset(tileWidth, tileHeight);
+            generator->generate(tile, seed * 2654435761u + static_cast<uint32_t>(index) + 1);
+
+            // The tile's passages stay inside it, so each thread writes only its own cells of the grid
+            for (int row = 0; row < tileHeight; row++) {
+                std::copy(tile.data() + static_cast<size_t>(row) * tileWidth, tile.data() + static_cast<size_t>(row + 1) * tileWidth,
+                    grid.data() + static_cast<size_t>(top + row) * width + left);
+            }
+            memory[worker] = std::max(memory[worker], static_cast<size_t>(tile.getCellCount()) + generator->getWorkingMemory());
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (int worker = 1; worker < workers; worker++) {
+        helpers.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    // Each border between neighbouring tiles, as the tile to the west or north times two, plus one for a west border
+    std::mt19937 random(seed);
+    std::vector<uint32_t> borders;
+    borders.reserve(static_cast<size_t>(tileCount) * 2);
+    for (int index = 0; index < tileCount; index++) {
+        if (index / tilesAcross + 1 < tilesDown) {
+            borders.push_back(static_cast<uint32_t>(index) * 2);
+        }
+        if (index % tilesAcross + 1 < tilesAcross) {
+            borders.push_back(static_cast<uint32_t>(index) * 2 + 1);
+        }
+    }
+    for (size_t i = borders.size(); i > 1; i--) {
+        std::swap(borders[i - 1], borders[random() % i]);
+    }
+
+    // Open one wall at random in each border on a spanning tree of the tiles
+    DisjointSets sets(tileCount);
+    for (uint32_t border : borders) {
+        int index = static_cast<int>(border >> 1);
+        bool east = (border & 1) != 0;
+        if (!sets.unite(index, east ? index + 1 : index + tilesAcross)) {
+            continue;
+        }
+
+        int left = (index % tilesAcross) * tileSize;
+        int top = (index / tilesAcross) * tileSize;
+        if (east) {
+            int row = top + static_cast<int>(random() % std::min(tileSize, height - top));
+            grid.openPassage(grid.index(left + tileSize - 1, row), MazeGrid::EAST);
+        }
+        else {
+            int column = left + static_cast<int>(random() % std::min(tileSize, width - left));
+            grid.openPassage(grid.index(column, top + tileSize - 1), MazeGrid::SOUTH);
+        }
+    }
+
+    workingMemory = borders.capacity() * sizeof(uint32_t) + sets.getMemory();
+    for (size_t worker : memory) {
+        workingMemory += worker;
+    }
+}
+
+
+// Constructor for the WilsonGenerator3D class
+WilsonGenerator3D::WilsonGenerator3D(int stairOdds) : stairOdds(stairOdds), workingMemory(0) {
+    if (stairOdds < 2) {
+        throw std::runtime_error("The walks must go across more often than up or down");
+    }
+}
+
+
+// Carves a layered maze by loop-erased random walks
+void WilsonGenerator3D::generate(MazeGrid3D& grid, uint32_t seed) {
+    std::mt19937 random(seed);
+    grid.reset(grid.getWidth(), grid.getHeight(), grid.getLevels());
+    if (grid.getCellCount() == 0) {
+        workingMemory = 0;
+        return;
+    }
+
+    // Indexed by where each cell is stored, so the padding cells take a little room too
+    int storage = grid.getStorageSize();
+    std::vector<uint8_t> inMaze(static_cast<size_t>(storage), 0);
+    std::vector<uint8_t> exits(static_cast<size_t>(storage), 0);
+    inMaze[grid.index(random() % grid.getWidth(), random() % grid.getHeight(), random() % grid.getLevels())] = 1;
+
+    for (int start = 0; start < storage; start++) {
+        if (!grid.isCell(start)) {
+            continue;
+        }
+
+        // Walk until the maze is reached, each cell remembering only the way the walk last left it
+        int cell = start;
+        while (!inMaze[cell]) {
+            int direction;
+            int next;
+            do {
+                uint32_t roll = random();
+                if (roll % stairOdds == 0) {
+                    direction = MazeGrid3D::UP + static_cast<int>((roll >> 16) & 1);
+                }
+                else {
+                    direction = static_cast<int>((roll >> 16) & 3);
+                }
+                next = grid.neighbour(cell, direction);
+            } while (next == MazeGrid3D::NO_CELL);
+
+            exits[cell] = static_cast<uint8_t>(direction);
+            cell = next;
+        }
+
+        // Following the exits from the start again skips every loop the walk made
+        for (cell = start; !inMaze[cell]; cell = grid.step(cell, exits[cell])) {
+            inMaze[cell] = 1;
+            grid.openPassage(cell, exits[cell]);
+        }
+    }
+
+    workingMemory = inMaze.capacity() + exits.capacity();
+}
@@ -0,0 +1,306 @@
+#ifndef MAZE_GENERATOR_H
+#define MAZE_GENERATOR_H
+
+/*!
+* @file mazeGenerator.h
+* @brief Contains the declaration of the MazeGenerator interface and the maze generation algorithms behind it.
+* @details Every generator carves a perfect maze, one with exactly one path between any two cells, into a MazeGrid.
+* @details They differ in speed, in the working memory they need besides the grid, and in the texture of the mazes
+* @details they make, which MazeStatistics measures.
+*/
+
+#include "mazeGrid.h"
+#include "mazeGrid3D.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*!
+* @enum MazeAlgorithm
+* @brief The maze generation algorithms there are to choose from.
+*/
+enum class MazeAlgorithm {
+	WILSON, /*!< Loop-erased random walks; every maze equally likely, slow to start. */
+	BACKTRACKER, /*!< Depth-first search; long winding corridors and few dead ends. */
+	KRUSKAL, /*!< Walls knocked down in random order, skipping any that would make a loop; many short dead ends. */
+	ELLER, /*!< A row at a time, remembering only which cells of the last row are joined. */
+	PRIM, /*!< Grown outwards from a cell, joining a random cell on its edge each step; many short dead ends. */
+	PARALLEL, /*!< Tiles made at once on several threads, then joined by a spanning tree over the tiles. */
+};
+
+/*!
+* @struct MazeStatistics
+* @brief Measures of the texture of a maze.
+*/
+struct MazeStatistics {
+	int deadEnds; /*!< The cells with one passage. */
+	int junctions; /*!< The cells with three or four passages. */
+	double deadEndRatio; /*!< The dead ends as a fraction of the cells. */
+	double riverFactor; /*!< The mean length of the corridors from each dead end back to a junction; a maze that "flows" has long ones. */
+};
+
+/*!
+* @class DisjointSets
+* @brief Union-find over numbered items, with path halving and union by size.
+*/
+class DisjointSets {
+	std::vector<int> parents; /*!< The parent of each item; a root is its own parent. */
+	std::vector<int> sizes; /*!< The number of items under each root. */
+
+public:
+	/*!
+	* @brief Constructor for DisjointSets, putting every item in a set of its own.
+	* @param count The number of items.
+	*/
+	explicit DisjointSets(int count = 0) { reset(count); }
+
+	/*!
+	* @brief Put every item back in a set of its own, changing the number of items if asked.
+	* @param count The number of items.
+	*/
+	void reset(int count);
+
+	/*!
+	* @brief Find the root of an item's set, pointing each item passed on the way at its grandparent.
+	* @param item The item.
+	* @return The root.
+	*/
+	int find(int item) {
+		while (parents[item] != item) {
+			parents[item] = parents[parents[item]];
+			item = parents[item];
+		}
+		return item;
+	}
+
+	/*!
+	* @brief Join the sets two items are in, hanging the smaller under the larger.
+	* @param first One item.
+	* @param second The other.
+	* @return false if they were in the same set already.
+	*/
+	bool unite(int first, int second);
+
+	/*!
+	* @brief Get the memory the sets take.
+	* @return The bytes.
+	*/
+	size_t getMemory() const { return (parents.capacity() + sizes.capacity()) * sizeof(int); }
+};
+
+/*!
+* @class MazeGenerator
+* @brief The interface every maze generation algorithm is used through.
+*/
+class MazeGenerator {
+protected:
+	size_t workingMemory; /*!< The most memory besides the grid the last generate call needed, in bytes. */
+
+public:
+	/*!
+	* @brief Constructor for MazeGenerator.
+	*/
+	MazeGenerator() : workingMemory(0) {}
+
+	/*!
+	* @brief Destructor for MazeGenerator.
+	*/
+	virtual ~MazeGenerator() {}
+
+	/*!
+	* @brief Carve a perfect maze into a grid, walling it up first.
+	* @param grid The grid, already the size the maze is to be.
+	* @param seed The random seed; the same seed and size always give the same maze.
+	*/
+	virtual void generate(MazeGrid& grid, uint32_t seed) = 0;
+
+	/*!
+	* @brief Get the name of the algorithm.
+	* @return The name.
+	*/
+	virtual const char* getName() const = 0;
+
+	/*!
+	* @brief Get the most memory besides the grid the last generate call needed.
+	* @return The bytes.
+	*/
+	size_t getWorkingMemory() const { return workingMemory; }
+
+	/*!
+	* @brief Make a generator for an algorithm.
+	* @param algorithm The algorithm.
+	* @return The generator.
+	*/
+	static std::unique_ptr<MazeGenerator> create(MazeAlgorithm algorithm);
+
+	/*!
+	* @brief Measure the texture of a maze.
+	* @param grid The maze.
+	* @return The dead ends, junctions and river factor.
+	*/
+	static MazeStatistics measure(const MazeGrid& grid);
+};
+
+/*!
+* @class WilsonGenerator
+* @brief Wilson's algorithm: a random walk from each cell not yet in the maze until it reaches the maze, adding the walk
+* @brief with its loops erased.
+* @details Rather than keep the walk as a list and cut loops out of it, each cell remembers the way the walk last left
+* @details it, so a loop is forgotten as soon as the walk leaves its first cell in a new direction.
+*/
+class WilsonGenerator : public MazeGenerator {
+public:
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Wilson"; }
+};
+
+/*!
+* @class BacktrackerGenerator
+* @brief The recursive backtracker, a randomised depth-first search run on an explicit stack, so a maze of millions
+* @brief of cells cannot overflow the call stack.
+*/
+class BacktrackerGenerator : public MazeGenerator {
+public:
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Backtracker"; }
+};
+
+/*!
+* @class KruskalGenerator
+* @brief Kruskal's algorithm: every wall in random order, knocked down when the cells either side are not yet joined.
+*/
+class KruskalGenerator : public MazeGenerator {
+public:
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Kruskal"; }
+};
+
+/*!
+* @class PrimGenerator
+* @brief Prim's algorithm: the maze grows from one cell, joining a random cell on its edge to it each step.
+*/
+class PrimGenerator : public MazeGenerator {
+public:
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Prim"; }
+};
+
+/*!
+* @class EllerRows
+* @brief Eller's algorithm one row at a time, for any number of rows, remembering only which cells of the last row
+* @brief are joined by the rows above.
+* @details Each row joins neighbouring cells in different sets at random, then sends at least one cell of every set
+* @details down to the next row. The last row joins every set, closing the maze off.
+*/
+class EllerRows {
+	int width; /*!< The number of columns. */
+	std::mt19937 random; /*!< The random numbers. */
+	std::vector<int> sets; /*!< The set each cell of the next row starts in, a column number or width plus one. */
+	std::vector<uint8_t> fromAbove; /*!< Whether each cell of the next row has a passage up to the last row. */
+	std::vector<int> firstColumn; /*!< For each set number, the first column of this row found in it. */
+	std::vector<int> members; /*!< The cells of each set seen so far in this row, for choosing one to go down. */
+	std::vector<int> chosen; /*!< The cell chosen to go down from each set in this row. */
+	DisjointSets joined; /*!< The sets of this row, by column. */
+
+public:
+	/*!
+	* @brief Constructor for EllerRows, ready to make the first row.
+	* @param width The number of columns.
+	* @param seed The random seed.
+	*/
+	EllerRows(int width, uint32_t seed);
+
+	/*!
+	* @brief Make the next row.
+	* @param row The passage masks to fill in, width of them; north and south passages join this row to the rows either side.
+	* @param last Whether this is the last row, which joins every set left.
+	*/
+	void nextRow(uint8_t* row, bool last);
+
+	/*!
+	* @brief Get the memory the rows need.
+	* @return The bytes, in proportion to the width.
+	*/
+	size_t getMemory() const;
+};
+
+/*!
+* @class EllerGenerator
+* @brief Eller's algorithm over the whole grid, using EllerRows.
+*/
+class EllerGenerator : public MazeGenerator {
+public:
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Eller"; }
+};
+
+/*!
+* @class ParallelGenerator
+* @brief Splits the grid into square tiles, carves each on its own with another algorithm on a pool of threads, then
+* @brief joins the tiles into one maze.
+* @details Each tile is a perfect maze of its own cells, so treating the tiles as the nodes of a graph, a random
+* @details spanning tree of it found with union-find over the borders between neighbouring tiles says which borders
+* @details to open: one wall knocked down in each border on the tree joins every cell with exactly one path. Each tile
+* @details has a seed of its own, so the maze is the same however many threads make it. Borders off the tree stay
+* @details solid, which leaves the lines between tiles visible in the maze as long straight walls.
+*/
+class ParallelGenerator : public MazeGenerator {
+	int threads; /*!< The threads to carve tiles on. */
+	int tileSize; /*!< The cells along each side of a tile. */
+	MazeAlgorithm tileAlgorithm; /*!< The algorithm each tile is carved with. */
+
+public:
+	/*!
+	* @brief Constructor for ParallelGenerator.
+	* @param threads The threads to carve tiles on; 0 for one per processor.
+	* @param tileSize The cells along each side of a tile.
+	* @param tileAlgorithm The algorithm each tile is carved with.
+	* @throws runtime_error if the tile size is less than one or the tile algorithm is PARALLEL.
+	*/
+	explicit ParallelGenerator(int threads = 0, int tileSize = 256, MazeAlgorithm tileAlgorithm = MazeAlgorithm::BACKTRACKER);
+
+	/*!
+	* @brief Get the threads tiles are carved on.
+	* @return The number of threads.
+	*/
+	int getThreadCount() const { return threads; }
+
+	void generate(MazeGrid& grid, uint32_t seed) override;
+	const char* getName() const override { return "Parallel"; }
+};
+
+/*!
+* @class WilsonGenerator3D
+* @brief Wilson's algorithm over a maze of several levels, each step of the walks going to one of up to six neighbours.
+* @details A walk that went up or down as often as across would make a maze that is mostly stairs, with little of any
+* @details one level worth drawing, so the walks only take the stairs one step in every stairOdds.
+*/
+class WilsonGenerator3D {
+	int stairOdds; /*!< The walks go up or down one step in this many. */
+	size_t workingMemory; /*!< The most memory besides the maze the last generate call needed, in bytes. */
+
+public:
+	/*!
+	* @brief Constructor for WilsonGenerator3D.
+	* @param stairOdds The walks go up or down one step in this many.
+	* @throws runtime_error if the odds are less than two, when a walk could never leave the column it started in.
+	*/
+	explicit WilsonGenerator3D(int stairOdds = 16);
+
+	/*!
+	* @brief Carve a perfect maze into a layered grid, walling it up first.
+	* @param grid The maze, already the size it is to be.
+	* @param seed The random seed; the same seed and size always give the same maze.
+	*/
+	void generate(MazeGrid3D& grid, uint32_t seed);
+
+	/*!
+	* @brief Get the most memory besides the maze the last generate call needed.
+	* @return The bytes.
+	*/
+	size_t getWorkingMemory() const { return workingMemory; }
+};
+
+#endif // MAZE_GENERATOR_H
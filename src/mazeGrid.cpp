@@ -0,0 +1,65 @@
+#include "mazeGrid.h"
+#include <stdexcept>
+#include <string>
+
+
+// Constructor for the MazeGrid class
+MazeGrid::MazeGrid(int width, int height) : width(0), height(0) {
+    reset(width, height);
+}
+
+
+// Walls up every cell
+void MazeGrid::reset(int width, int height) {
+    if (width < 0 || height < 0 || static_cast<int64_t>(width) * height > INT32_MAX / 2) {
+        throw std::runtime_error("A maze cannot be " + std::to_string(width) + " by " + std::to_string(height));
+    }
+
+    this->width = width;
+    this->height = height;
+    cells.assign(static_cast<size_t>(width) * height, 0);
+}
+
+
+// Gets the cell next to a cell
+int MazeGrid::neighbour(int cell, int direction) const {
+    int x = cell % width;
+    int y = cell / width;
+
+    switch (direction) {
+    case NORTH:
+        return (y > 0) ? cell - width : NO_CELL;
+    case SOUTH:
+        return (y + 1 < height) ? cell + width : NO_CELL;
+    case EAST:
+        return (x + 1 < width) ? cell + 1 : NO_CELL;
+    case WEST:
+        return (x > 0) ? cell - 1 : NO_CELL;
+    default:
+        return NO_CELL;
+    }
+}
+
+
+// Knocks down the wall between a cell and its neighbour
+void MazeGrid::openPassage(int cell, int direction) {
+    int other = neighbour(cell, direction);
+    if (other == NO_CELL) {
+        throw std::runtime_error("There is no cell beyond the edge of the maze to open a passage to");
+    }
+
+    cells[cell] |= static_cast<uint8_t>(1 << direction);
+    cells[other] |= static_cast<uint8_t>(1 << opposite(direction));
+}
+
+
+// Puts back the wall between a cell and its neighbour
+void MazeGrid::closePassage(int cell, int direction) {
+    int other = neighbour(cell, direction);
+    if (other == NO_CELL) {
+        throw std::runtime_error("There is no cell beyond the edge of the maze to close a passage to");
+    }
+
+    cells[cell] &= static_cast<uint8_t>(~(1 << direction));
+    cells[other] &= static_cast<uint8_t>(~(1 << opposite(direction)));
+}
@@ -0,0 +1,141 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+/*!
+* @file mazeGrid.h
+* @brief Contains the declaration of the MazeGrid class, a maze kept as one flat array of passage masks.
+* @details Cells are numbered row by row, so cell = y * width + x, with y growing southwards. Each cell is one byte
+* @details with a bit set for every side that has a passage rather than a wall, bit 1 << direction in the order of
+* @details the Direction enum: north, south, east, west.
+*/
+
+#include <cstdint>
+#include <vector>
+
+/*!
+* @class MazeGrid
+* @brief A rectangular maze of any size, with every passage recorded on both the cells it joins.
+*/
+class MazeGrid {
+public:
+	static constexpr int NORTH = 0; /*!< Towards y - 1, as Direction::NORTH. */
+	static constexpr int SOUTH = 1; /*!< Towards y + 1, as Direction::SOUTH. */
+	static constexpr int EAST = 2; /*!< Towards x + 1, as Direction::EAST. */
+	static constexpr int WEST = 3; /*!< Towards x - 1, as Direction::WEST. */
+
+	static constexpr uint8_t OPEN_NORTH = 1 << NORTH; /*!< The cell has a passage north. */
+	static constexpr uint8_t OPEN_SOUTH = 1 << SOUTH; /*!< The cell has a passage south. */
+	static constexpr uint8_t OPEN_EAST = 1 << EAST; /*!< The cell has a passage east. */
+	static constexpr uint8_t OPEN_WEST = 1 << WEST; /*!< The cell has a passage west. */
+
+	static constexpr int NO_CELL = -1; /*!< What neighbour returns off the edge of the grid. */
+
+private:
+	int width; /*!< The number of columns. */
+	int height; /*!< The number of rows. */
+	std::vector<uint8_t> cells; /*!< Every cell's passages, row by row. */
+
+public:
+	/*!
+	* @brief Constructor for MazeGrid, creates a grid with a wall on every side of every cell.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @throws runtime_error if the grid is too big to number its cells with an int.
+	*/
+	explicit MazeGrid(int width = 0, int height = 0);
+
+	/*!
+	* @brief Wall up every cell, changing the size if asked.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @throws runtime_error if the grid is too big to number its cells with an int.
+	*/
+	void reset(int width, int height);
+
+	/*!
+	* @brief Get the number of columns.
+	* @return The width.
+	*/
+	int getWidth() const { return width; }
+
+	/*!
+	* @brief Get the number of rows.
+	* @return The height.
+	*/
+	int getHeight() const { return height; }
+
+	/*!
+	* @brief Get the number of cells.
+	* @return The width times the height.
+	*/
+	int getCellCount() const { return width * height; }
+
+	/*!
+	* @brief Get the number of a cell.
+	* @param x The column.
+	* @param y The row.
+	* @return The cell.
+	*/
+	int index(int x, int y) const { return y * width + x; }
+
+	/*!
+	* @brief Get the passages out of a cell.
+	* @param cell The cell.
+	* @return The OPEN_ bits.
+	*/
+	uint8_t getPassages(int cell) const { return cells[cell]; }
+
+	/*!
+	* @brief Check if there is a passage out of a cell in a direction.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST or WEST.
+	* @return true if there is.
+	*/
+	bool isOpen(int cell, int direction) const { return (cells[cell] >> direction) & 1; }
+
+	/*!
+	* @brief Get the cell next to a cell, whether or not there is a wall between them.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST or WEST.
+	* @return The neighbouring cell, or NO_CELL off the edge of the grid.
+	*/
+	int neighbour(int cell, int direction) const;
+
+	/*!
+	* @brief Knock down the wall between a cell and its neighbour, on both sides.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST or WEST.
+	* @throws runtime_error if the neighbour is off the edge of the grid.
+	*/
+	void openPassage(int cell, int direction);
+
+	/*!
+	* @brief Put back the wall between a cell and its neighbour, on both sides.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST or WEST.
+	* @throws runtime_error if the neighbour is off the edge of the grid.
+	*/
+	void closePassage(int cell, int direction);
+
+	/*!
+	* @brief Get the direction back the way a direction came.
+	* @param direction NORTH, SOUTH, EAST or WEST.
+	* @return The opposite direction.
+	*/
+	static int opposite(int direction) { return direction ^ 1; }
+
+	/*!
+	* @brief Get the passage masks for writing many at once, as the generators do.
+	* @details Anything written must keep each passage on both of the cells it joins.
+	* @return The first cell's mask.
+	*/
+	uint8_t* data() { return cells.data(); }
+
+	/*!
+	* @brief Get the passage masks.
+	* @return The first cell's mask.
+	*/
+	const uint8_t* data() const { return cells.data(); }
+};
+
+#endif // MAZE_GRID_H
@@ -0,0 +1,89 @@
+#include "mazeGrid3D.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+// Constructor for the MazeGrid3D class
+MazeGrid3D::MazeGrid3D(int width, int height, int levels)
+    : width(0), height(0), levels(0), tilesAcross(0), tileRowCells(0), levelCells(0) {
+    reset(width, height, levels);
+}
+
+
+// Walls up every cell, padding each level out to whole tiles
+void MazeGrid3D::reset(int width, int height, int levels) {
+    int64_t across = (static_cast<int64_t>(width) + TILE_SIZE - 1) >> TILE_SHIFT;
+    int64_t down = (static_cast<int64_t>(height) + TILE_SIZE - 1) >> TILE_SHIFT;
+    if (width < 0 || height < 0 || levels < 0 || across * down * TILE_CELLS * levels > INT32_MAX / 2) {
+        throw std::runtime_error("A maze cannot be " + std::to_string(width) + " by " + std::to_string(height) + " by " +
+            std::to_string(levels));
+    }
+
+    this->width = width;
+    this->height = height;
+    this->levels = levels;
+    tilesAcross = static_cast<int>(across);
+    tileRowCells = tilesAcross * TILE_CELLS;
+    levelCells = static_cast<int>(across * down) * TILE_CELLS;
+
+    // Something to take the remainder by even when there are no cells
+    if (levelCells == 0) {
+        levelCells = tileRowCells = TILE_CELLS;
+    }
+    cells.assign(static_cast<size_t>(across * down) * TILE_CELLS * levels, 0);
+}
+
+
+// Gets the cell next to a cell
+int MazeGrid3D::neighbour(int cell, int direction) const {
+    switch (direction) {
+    case NORTH:
+        return getY(cell) > 0 ? step(cell, direction) : NO_CELL;
+    case SOUTH:
+        return getY(cell) < height - 1 ? step(cell, direction) : NO_CELL;
+    case EAST:
+        return getX(cell) < width - 1 ? step(cell, direction) : NO_CELL;
+    case WEST:
+        return getX(cell) > 0 ? step(cell, direction) : NO_CELL;
+    case UP:
+        return getLevel(cell) < levels - 1 ? step(cell, direction) : NO_CELL;
+    case DOWN:
+        return getLevel(cell) > 0 ? step(cell, direction) : NO_CELL;
+    default:
+        return NO_CELL;
+    }
+}
+
+
+// Opens the wall between a cell and its neighbour
+void MazeGrid3D::openPassage(int cell, int direction) {
+    int next = neighbour(cell, direction);
+    if (next == NO_CELL) {
+        throw std::runtime_error("Cell " + std::to_string(cell) + " has no neighbour in direction " + std::to_string(direction));
+    }
+
+    cells[cell] |= static_cast<uint8_t>(1 << direction);
+    cells[next] |= static_cast<uint8_t>(1 << opposite(direction));
+}
+
+
+// Copies a level's passages into a grid, a row of a tile at a time
+void MazeGrid3D::copyLevel(int level, MazeGrid& layer) const {
+    if (layer.getWidth() != width || layer.getHeight() != height) {
+        layer.reset(width, height);
+    }
+
+    const uint8_t stairs = OPEN_UP | OPEN_DOWN;
+    uint8_t* data = layer.data();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x += TILE_SIZE) {
+            const uint8_t* source = &cells[index(x, y, level)];
+            uint8_t* target = data + static_cast<size_t>(y) * width + x;
+            int count = std::min(TILE_SIZE, width - x);
+            for (int i = 0; i < count; i++) {
+                target[i] = static_cast<uint8_t>(source[i] & ~stairs);
+            }
+        }
+    }
+}
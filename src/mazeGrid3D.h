@@ -0,0 +1,219 @@
+#ifndef MAZE_GRID_3D_H
+#define MAZE_GRID_3D_H
+
+/*!
+* @file mazeGrid3D.h
+* @brief Contains the declaration of the MazeGrid3D class, a maze of several levels joined by stairs, kept as one flat
+* @brief array of passage masks.
+* @details Each cell is one byte with a bit set for every side that has a passage, bit 1 << direction, the first four
+* @details as in MazeGrid and then up and down. The levels are stored one after another, and each level in square
+* @details tiles of 8 by 8 cells, 64 bytes, so a cell's neighbours north and south are nearly always in the same cache
+* @details line as it, where in rows they would be a whole row away. A cell's number is where it is stored, so
+* @details walking the maze never has to convert to and from coordinates; the tiles at the right and bottom edges are
+* @details padded out to full size with cells that are walled in and never part of the maze.
+*/
+
+#include "mazeGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+* @class MazeGrid3D
+* @brief A maze of levels of the same width and height, with every passage recorded on both the cells it joins.
+*/
+class MazeGrid3D {
+public:
+	static constexpr int NORTH = MazeGrid::NORTH; /*!< Towards y - 1. */
+	static constexpr int SOUTH = MazeGrid::SOUTH; /*!< Towards y + 1. */
+	static constexpr int EAST = MazeGrid::EAST; /*!< Towards x + 1. */
+	static constexpr int WEST = MazeGrid::WEST; /*!< Towards x - 1. */
+	static constexpr int UP = 4; /*!< Towards level + 1, as Direction::UP. */
+	static constexpr int DOWN = 5; /*!< Towards level - 1, as Direction::DOWN. */
+
+	static constexpr uint8_t OPEN_UP = 1 << UP; /*!< The cell has stairs up. */
+	static constexpr uint8_t OPEN_DOWN = 1 << DOWN; /*!< The cell has stairs down. */
+
+	static constexpr int NO_CELL = -1; /*!< What neighbour returns off the edge of the maze. */
+	static constexpr int TILE_SHIFT = 3; /*!< A tile is 1 << TILE_SHIFT cells along each side. */
+	static constexpr int TILE_SIZE = 1 << TILE_SHIFT; /*!< The cells along each side of a tile. */
+	static constexpr int TILE_CELLS = TILE_SIZE * TILE_SIZE; /*!< The cells in a tile. */
+
+private:
+	int width; /*!< The number of columns. */
+	int height; /*!< The number of rows. */
+	int levels; /*!< The number of levels. */
+	int tilesAcross; /*!< The tiles across a level. */
+	int tileRowCells; /*!< The cells stored for a row of tiles. */
+	int levelCells; /*!< The cells stored for a level, padding included. */
+	std::vector<uint8_t> cells; /*!< Every cell's passages, level by level and tile by tile. */
+
+public:
+	/*!
+	* @brief Constructor for MazeGrid3D, creates a maze with a wall on every side of every cell.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param levels The number of levels.
+	* @throws runtime_error if the maze is too big to number its cells with an int.
+	*/
+	explicit MazeGrid3D(int width = 0, int height = 0, int levels = 0);
+
+	/*!
+	* @brief Wall up every cell, changing the size if asked.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param levels The number of levels.
+	* @throws runtime_error if the maze is too big to number its cells with an int.
+	*/
+	void reset(int width, int height, int levels);
+
+	/*!
+	* @brief Get the number of columns.
+	* @return The width.
+	*/
+	int getWidth() const { return width; }
+
+	/*!
+	* @brief Get the number of rows.
+	* @return The height.
+	*/
+	int getHeight() const { return height; }
+
+	/*!
+	* @brief Get the number of levels.
+	* @return The levels.
+	*/
+	int getLevels() const { return levels; }
+
+	/*!
+	* @brief Get the number of cells in the maze.
+	* @return The width times the height times the levels.
+	*/
+	int getCellCount() const { return width * height * levels; }
+
+	/*!
+	* @brief Get the number of cells stored, which the cells are numbered below.
+	* @return The cells in the maze and the padding of its tiles.
+	*/
+	int getStorageSize() const { return static_cast<int>(cells.size()); }
+
+	/*!
+	* @brief Get the number of a cell.
+	* @param x The column.
+	* @param y The row.
+	* @param level The level.
+	* @return The cell.
+	*/
+	int index(int x, int y, int level) const {
+		return level * levelCells + (y >> TILE_SHIFT) * tileRowCells + ((x >> TILE_SHIFT) << (2 * TILE_SHIFT)) +
+			((y & (TILE_SIZE - 1)) << TILE_SHIFT) + (x & (TILE_SIZE - 1));
+	}
+
+	/*!
+	* @brief Get the column of a cell.
+	* @param cell The cell.
+	* @return The column.
+	*/
+	int getX(int cell) const {
+		return (((cell % levelCells) % tileRowCells) >> (2 * TILE_SHIFT) << TILE_SHIFT) + (cell & (TILE_SIZE - 1));
+	}
+
+	/*!
+	* @brief Get the row of a cell.
+	* @param cell The cell.
+	* @return The row.
+	*/
+	int getY(int cell) const {
+		return ((cell % levelCells) / tileRowCells << TILE_SHIFT) + ((cell >> TILE_SHIFT) & (TILE_SIZE - 1));
+	}
+
+	/*!
+	* @brief Get the level of a cell.
+	* @param cell The cell.
+	* @return The level.
+	*/
+	int getLevel(int cell) const { return cell / levelCells; }
+
+	/*!
+	* @brief Check if a stored cell is part of the maze rather than padding.
+	* @param cell The cell.
+	* @return true if it is.
+	*/
+	bool isCell(int cell) const { return getX(cell) < width && getY(cell) < height; }
+
+	/*!
+	* @brief Get the passages out of a cell.
+	* @param cell The cell.
+	* @return The OPEN_ bits.
+	*/
+	uint8_t getPassages(int cell) const { return cells[cell]; }
+
+	/*!
+	* @brief Check if there is a passage out of a cell in a direction.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST, WEST, UP or DOWN.
+	* @return true if there is.
+	*/
+	bool isOpen(int cell, int direction) const { return (cells[cell] >> direction) & 1; }
+
+	/*!
+	* @brief Get the cell next to a cell without checking for the edge of the maze, as when following a passage.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST, WEST, UP or DOWN.
+	* @return The neighbouring cell.
+	*/
+	int step(int cell, int direction) const {
+		switch (direction) {
+		case NORTH:
+			return (cell & (TILE_CELLS - TILE_SIZE)) ? cell - TILE_SIZE : cell - tileRowCells + TILE_CELLS - TILE_SIZE;
+		case SOUTH:
+			return (~cell & (TILE_CELLS - TILE_SIZE)) ? cell + TILE_SIZE : cell + tileRowCells - TILE_CELLS + TILE_SIZE;
+		case EAST:
+			return (~cell & (TILE_SIZE - 1)) ? cell + 1 : cell + TILE_CELLS - TILE_SIZE + 1;
+		case WEST:
+			return (cell & (TILE_SIZE - 1)) ? cell - 1 : cell - TILE_CELLS + TILE_SIZE - 1;
+		case UP:
+			return cell + levelCells;
+		default:
+			return cell - levelCells;
+		}
+	}
+
+	/*!
+	* @brief Get the cell next to a cell, whether or not there is a wall between them.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST, WEST, UP or DOWN.
+	* @return The neighbouring cell, or NO_CELL off the edge of the maze.
+	*/
+	int neighbour(int cell, int direction) const;
+
+	/*!
+	* @brief Knock down the wall between a cell and its neighbour, on both sides.
+	* @param cell The cell.
+	* @param direction NORTH, SOUTH, EAST, WEST, UP or DOWN.
+	* @throws runtime_error if the neighbour is off the edge of the maze.
+	*/
+	void openPassage(int cell, int direction);
+
+	/*!
+	* @brief Get the direction back the way a direction came.
+	* @param direction NORTH, SOUTH, EAST, WEST, UP or DOWN.
+	* @return The opposite direction.
+	*/
+	static int opposite(int direction) { return direction ^ 1; }
+
+	/*!
+	* @brief Copy the passages within a level into a grid, for drawing it; the stairs are left out.
+	* @param level The level.
+	* @param layer The grid, made the width and height of the maze if it is not already.
+	*/
+	void copyLevel(int level, MazeGrid& layer) const;
+
+	/*!
+	* @brief Get the memory the maze takes.
+	* @return The bytes, one a cell stored.
+	*/
+	size_t getMemory() const { return cells.capacity(); }
+};
+
+#endif // MAZE_GRID_3D_H
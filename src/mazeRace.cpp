@@ -0,0 +1,165 @@
+#include "mazeRace.h"
+#include <algorithm>
+
+
+// Constructor for the FlowField class
+FlowField::FlowField(int radius) : radius(radius), source(MazeGrid::NO_CELL), searchNumber(0) {
+}
+
+
+// Searches out from the source to the radius, if the source has moved
+bool FlowField::update(const MazeGrid& grid, int source) {
+    size_t cells = static_cast<size_t>(grid.getCellCount());
+    if (source == this->source && stamps.size() == cells) {
+        return false;
+    }
+
+    if (stamps.size() != cells) {
+        distances.assign(cells, 0);
+        stamps.assign(cells, 0);
+        searchNumber = 0;
+    }
+
+    // After four billion searches the numbers come round again, so forget them all
+    if (++searchNumber == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        searchNumber = 1;
+    }
+
+    this->source = source;
+    queue.clear();
+    queue.push_back(source);
+    distances[source] = 0;
+    stamps[source] = searchNumber;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+        if (distances[cell] == radius) {
+            continue;
+        }
+
+        uint8_t passages = grid.getPassages(cell);
+        for (int direction = 0; direction < 4; direction++) {
+            if ((passages >> direction) & 1) {
+                int next = grid.neighbour(cell, direction);
+                if (stamps[next] != searchNumber) {
+                    stamps[next] = searchNumber;
+                    distances[next] = distances[cell] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+// Gets the neighbour one step closer to the source
+int FlowField::nextStep(const MazeGrid& grid, int cell) const {
+    int distance = getDistance(cell);
+    if (distance <= 0) {
+        return MazeGrid::NO_CELL;
+    }
+
+    uint8_t passages = grid.getPassages(cell);
+    for (int direction = 0; direction < 4; direction++) {
+        if ((passages >> direction) & 1) {
+            int next = grid.neighbour(cell, direction);
+            if (getDistance(next) == distance - 1) {
+                return next;
+            }
+        }
+    }
+    return MazeGrid::NO_CELL;
+}
+
+
+// Constructor for the MazeRace class
+MazeRace::MazeRace(const MazeGrid& grid, int start, int exit, int monsterCount, uint32_t seed)
+    : grid(grid), player(start), exit(exit), flow(CHASE_RADIUS), random(seed), ticks(0), caught(false) {
+    // Anything the field from the start does not reach is beyond the chase radius
+    flow.update(grid, start);
+
+    for (int monster = 0; monster < monsterCount; monster++) {
+        int cell = start;
+        for (int tries = 0; tries < 1000; tries++) {
+            cell = static_cast<int>(random() % static_cast<uint32_t>(grid.getCellCount()));
+            if (flow.getDistance(cell) == FlowField::UNREACHED) {
+                break;
+            }
+        }
+
+        // A maze too small to start the monsters out of reach starts them anywhere but on the player
+        if (cell == start && grid.getCellCount() > 1) {
+            cell = (start + 1) % grid.getCellCount();
+        }
+        monsters.push_back(cell);
+        cameFrom.push_back(cell);
+    }
+}
+
+
+// Checks if a monster is in the player's cell
+bool MazeRace::monsterOnPlayer() const {
+    return std::find(monsters.begin(), monsters.end(), player) != monsters.end();
+}
+
+
+// Moves a monster towards the player, or wanders without turning back
+void MazeRace::moveMonster(size_t monster) {
+    int cell = monsters[monster];
+    int next = flow.nextStep(grid, cell);
+
+    if (next == MazeGrid::NO_CELL) {
+        int choices[4];
+        int count = 0;
+        for (int direction = 0; direction < 4; direction++) {
+            int neighbour = grid.neighbour(cell, direction);
+            if (grid.isOpen(cell, direction) && neighbour != cameFrom[monster]) {
+                choices[count++] = neighbour;
+            }
+        }
+
+        // Only a dead end turns a wandering monster back
+        if (count == 0) {
+            next = (cameFrom[monster] != cell) ? cameFrom[monster] : cell;
+        }
+        else {
+            next = choices[random() % count];
+        }
+    }
+
+    cameFrom[monster] = cell;
+    monsters[monster] = next;
+}
+
+
+// Advances the race one tick
+bool MazeRace::tick(int direction) {
+    if (isOver()) {
+        return false;
+    }
+    ticks++;
+
+    bool moved = direction >= 0 && direction < 4 && grid.isOpen(player, direction);
+    if (moved) {
+        player = grid.neighbour(player, direction);
+    }
+    if (monsterOnPlayer()) {
+        caught = true;
+        return moved;
+    }
+
+    // Every monster chases by the one field, searched again only when the player has changed cell
+    flow.update(grid, player);
+
+    // The monsters' steps are spread over the ticks rather than all falling on the same one
+    for (size_t monster = 0; monster < monsters.size(); monster++) {
+        if ((ticks + static_cast<long long>(monster)) % MONSTER_TICKS == 0) {
+            moveMonster(monster);
+        }
+    }
+
+    caught = monsterOnPlayer();
+    return moved;
+}
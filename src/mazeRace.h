@@ -0,0 +1,176 @@
+#ifndef MAZE_RACE_H
+#define MAZE_RACE_H
+
+/*!
+* @file mazeRace.h
+* @brief Contains the declaration of the MazeRace class, a race to the end of a maze with monsters in pursuit, and the
+* @brief FlowField they find their way by.
+*/
+
+#include "mazeGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*!
+* @class FlowField
+* @brief The distance of every cell near a source from it, found by breadth-first search out to a radius.
+* @details Anything inside the radius finds its way to the source by stepping to whichever neighbour is one closer,
+* @details so one search serves every monster chasing the player, where a search each would cost as many times more.
+* @details The field is only searched again when the source moves, and each cell remembers the search that last
+* @details reached it, so neither the search nor moving the source ever touches the cells outside the radius.
+*/
+class FlowField {
+public:
+	static constexpr int UNREACHED = -1; /*!< The distance of a cell outside the radius. */
+
+private:
+	int radius; /*!< The furthest the search goes from the source. */
+	int source; /*!< The cell the field leads to, or MazeGrid::NO_CELL before the first update. */
+	std::vector<int> distances; /*!< The distance of each cell the last search reached. */
+	std::vector<uint32_t> stamps; /*!< The search each cell was last reached by, so only cells reached by this one count. */
+	std::vector<int> queue; /*!< The cells of the last search in the order it reached them. */
+	uint32_t searchNumber; /*!< The number of the last search. */
+
+public:
+	/*!
+	* @brief Constructor for FlowField.
+	* @param radius The furthest the search goes from the source.
+	*/
+	explicit FlowField(int radius);
+
+	/*!
+	* @brief Lead the field to a cell, searching again only if it is not the cell it leads to already.
+	* @param grid The maze.
+	* @param source The cell to lead to.
+	* @return true if the field was searched again.
+	*/
+	bool update(const MazeGrid& grid, int source);
+
+	/*!
+	* @brief Get the distance of a cell from the source.
+	* @param cell The cell.
+	* @return The distance in steps, or UNREACHED if it is outside the radius.
+	*/
+	int getDistance(int cell) const { return stamps[cell] == searchNumber ? distances[cell] : UNREACHED; }
+
+	/*!
+	* @brief Get the way from a cell towards the source.
+	* @param grid The maze.
+	* @param cell The cell.
+	* @return The neighbouring cell one step closer, or MazeGrid::NO_CELL if the cell is the source or outside the radius.
+	*/
+	int nextStep(const MazeGrid& grid, int cell) const;
+
+	/*!
+	* @brief Get the number of cells the last search reached.
+	* @return The count.
+	*/
+	int getReached() const { return static_cast<int>(queue.size()); }
+
+	/*!
+	* @brief Get the memory the field takes.
+	* @return The bytes.
+	*/
+	size_t getMemory() const { return (distances.capacity() + queue.capacity()) * sizeof(int) + stamps.capacity() * sizeof(uint32_t); }
+};
+
+/*!
+* @class MazeRace
+* @brief The rules of the race, advanced one fixed tick at a time so the game plays the same whatever the frame rate.
+* @details Monsters start well away from the player. Those within the chase radius close in along the flow field;
+* @details the rest wander, never turning back unless they reach a dead end. A monster that reaches the player's cell,
+* @details or whose cell the player steps into, catches them.
+*/
+class MazeRace {
+public:
+	static constexpr int TICKS_PER_SECOND = 60; /*!< The rate the race is advanced at. */
+	static constexpr int MONSTER_TICKS = 20; /*!< The ticks between each of a monster's steps, three steps a second. */
+	static constexpr int CHASE_RADIUS = 24; /*!< How far away monsters pick up the player's trail. */
+
+private:
+	const MazeGrid& grid; /*!< The maze, which must outlive the race. */
+	int player; /*!< The player's cell. */
+	int exit; /*!< The cell to reach. */
+	std::vector<int> monsters; /*!< Each monster's cell. */
+	std::vector<int> cameFrom; /*!< The cell each monster was in before, so wandering ones do not turn back. */
+	FlowField flow; /*!< The way to the player. */
+	std::mt19937 random; /*!< The random numbers for wandering. */
+	long long ticks; /*!< The ticks so far. */
+	bool caught; /*!< Whether a monster has caught the player. */
+
+	/*!
+	* @brief Move a monster a step, towards the player if it is near enough and at random if not.
+	* @param monster The number of the monster.
+	*/
+	void moveMonster(size_t monster);
+
+	/*!
+	* @brief Check if a monster is in the player's cell.
+	* @return true if one is.
+	*/
+	bool monsterOnPlayer() const;
+
+public:
+	/*!
+	* @brief Constructor for MazeRace, putting the monsters at random cells at least the chase radius from the start.
+	* @param grid The maze, which must outlive the race.
+	* @param start The player's first cell.
+	* @param exit The cell to reach.
+	* @param monsterCount The number of monsters.
+	* @param seed The random seed for where the monsters start and how they wander.
+	*/
+	MazeRace(const MazeGrid& grid, int start, int exit, int monsterCount, uint32_t seed);
+
+	/*!
+	* @brief Advance the race one tick: the player steps if they can, then the monsters due to step do.
+	* @param direction NORTH, SOUTH, EAST or WEST to move the player, or -1 to stand still.
+	* @return true if the player moved.
+	*/
+	bool tick(int direction);
+
+	/*!
+	* @brief Get the player's cell.
+	* @return The cell.
+	*/
+	int getPlayer() const { return player; }
+
+	/*!
+	* @brief Get every monster's cell.
+	* @return The cells, one a monster.
+	*/
+	const std::vector<int>& getMonsters() const { return monsters; }
+
+	/*!
+	* @brief Get the number of ticks so far.
+	* @return The ticks.
+	*/
+	long long getTicks() const { return ticks; }
+
+	/*!
+	* @brief Get the field the monsters chase the player by.
+	* @return The flow field.
+	*/
+	const FlowField& getFlowField() const { return flow; }
+
+	/*!
+	* @brief Check if a monster has caught the player.
+	* @return true if one has.
+	*/
+	bool isCaught() const { return caught; }
+
+	/*!
+	* @brief Check if the player has reached the end.
+	* @return true if they have.
+	*/
+	bool isEscaped() const { return player == exit; }
+
+	/*!
+	* @brief Check if the race is over either way.
+	* @return true if it is.
+	*/
+	bool isOver() const { return caught || player == exit; }
+};
+
+#endif // MAZE_RACE_H
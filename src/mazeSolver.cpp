@@ -0,0 +1,422 @@
+#include "mazeSolver.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+
+// Constructor for the RingQueue class
+MazeSolver::RingQueue::RingQueue(uint32_t capacity) : head(0), tail(0) {
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    ring.resize(size);
+}
+
+
+// Doubles the ring, putting the cells in it back in order from the start
+void MazeSolver::RingQueue::grow() {
+    std::vector<int> larger(ring.size() * 2);
+    uint32_t count = tail - head;
+
+    for (uint32_t i = 0; i < count; i++) {
+        larger[i] = ring[(head + i) & (ring.size() - 1)];
+    }
+
+    ring.swap(larger);
+    head = 0;
+    tail = count;
+}
+
+
+// Constructor for the MazeSolver class
+MazeSolver::MazeSolver() : searchNumber(0), expanded(0) {
+}
+
+
+// Makes the working memory big enough for a maze and starts a new search number
+void MazeSolver::prepare(const MazeGrid& grid) {
+    size_t cells = static_cast<size_t>(grid.getCellCount());
+    if (seen.size() < cells) {
+        searchDistances.resize(cells);
+        parents.resize(cells);
+        seen.resize(cells, 0);
+        sides.resize(cells);
+    }
+
+    // After four billion searches the numbers come round again, so forget them all
+    if (++searchNumber == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        searchNumber = 1;
+    }
+    expanded = 0;
+}
+
+
+// Adds an entry to the heap, moving it up past any parent with a larger estimate
+void MazeSolver::heapPush(HeapEntry entry) {
+    size_t position = heap.size();
+    heap.push_back(entry);
+
+    while (position > 0) {
+        size_t parent = (position - 1) / HEAP_ARITY;
+        if (heap[parent].estimate <= entry.estimate) {
+            break;
+        }
+        heap[position] = heap[parent];
+        position = parent;
+    }
+    heap[position] = entry;
+}
+
+
+// Takes the smallest entry from the heap, moving the last one down into its place
+MazeSolver::HeapEntry MazeSolver::heapPop() {
+    HeapEntry top = heap[0];
+    HeapEntry last = heap.back();
+    heap.pop_back();
+
+    size_t size = heap.size();
+    size_t position = 0;
+    while (size > 0) {
+        size_t first = position * HEAP_ARITY + 1;
+        if (first >= size) {
+            break;
+        }
+
+        size_t smallest = first;
+        size_t end = std::min(first + HEAP_ARITY, size);
+        for (size_t child = first + 1; child < end; child++) {
+            if (heap[child].estimate < heap[smallest].estimate) {
+                smallest = child;
+            }
+        }
+        if (heap[smallest].estimate >= last.estimate) {
+            break;
+        }
+
+        heap[position] = heap[smallest];
+        position = smallest;
+    }
+    if (size > 0) {
+        heap[position] = last;
+    }
+
+    return top;
+}
+
+
+// Follows the parents back from a cell to the start of the search
+std::vector<int> MazeSolver::tracePath(int cell) const {
+    std::vector<int> path;
+    for (int current = cell; current != MazeGrid::NO_CELL; current = parents[current]) {
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+
+// Finds the distance of every cell from a source
+const std::vector<int>& MazeSolver::distanceField(const MazeGrid& grid, int source) {
+    const int offsets[4] = { -grid.getWidth(), grid.getWidth(), 1, -1 };
+    distances.assign(static_cast<size_t>(grid.getCellCount()), UNREACHED);
+    queue.clear();
+    expanded = 0;
+
+    if (source < 0 || source >= grid.getCellCount()) {
+        return distances;
+    }
+
+    distances[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+        int cell = queue.pop();
+        int next = distances[cell] + 1;
+        uint8_t passages = grid.getPassages(cell);
+        expanded++;
+
+        for (int direction = 0; direction < 4; direction++) {
+            if ((passages >> direction) & 1) {
+                int neighbour = cell + offsets[direction];
+                if (distances[neighbour] == UNREACHED) {
+                    distances[neighbour] = next;
+                    queue.push(neighbour);
+                }
+            }
+        }
+    }
+
+    return distances;
+}
+
+
+// Finds the cell furthest from a source
+int MazeSolver::farthestCell(const MazeGrid& grid, int source) {
+    const std::vector<int>& field = distanceField(grid, source);
+    int farthest = source;
+
+    for (int cell = 0; cell < grid.getCellCount(); cell++) {
+        if (field[cell] > field[farthest]) {
+            farthest = cell;
+        }
+    }
+    return farthest;
+}
+
+
+// Finds a shortest path by breadth-first search
+std::vector<int> MazeSolver::breadthFirstPath(const MazeGrid& grid, int from, int to) {
+    const int offsets[4] = { -grid.getWidth(), grid.getWidth(), 1, -1 };
+    distances.assign(static_cast<size_t>(grid.getCellCount()), UNREACHED);
+    queue.clear();
+    expanded = 0;
+
+    distances[from] = 0;
+    queue.push(from);
+    while (!queue.empty() && distances[to] == UNREACHED) {
+        int cell = queue.pop();
+        uint8_t passages = grid.getPassages(cell);
+        expanded++;
+
+        for (int direction = 0; direction < 4; direction++) {
+            if ((passages >> direction) & 1) {
+                int neighbour = cell + offsets[direction];
+                if (distances[neighbour] == UNREACHED) {
+                    distances[neighbour] = distances[cell] + 1;
+                    queue.push(neighbour);
+                }
+            }
+        }
+    }
+
+    if (distances[to] == UNREACHED) {
+        return {};
+    }
+
+    // Walk back downhill through the distances, which needs no parent for each cell
+    std::vector<int> path(static_cast<size_t>(distances[to]) + 1);
+    int cell = to;
+    for (int step = distances[to]; step > 0; step--) {
+        path[step] = cell;
+        uint8_t passages = grid.getPassages(cell);
+        for (int direction = 0; direction < 4; direction++) {
+            if (((passages >> direction) & 1) && distances[cell + offsets[direction]] == step - 1) {
+                cell += offsets[direction];
+                break;
+            }
+        }
+    }
+    path[0] = cell;
+    return path;
+}
+
+
+// Finds a shortest path by A*
+std::vector<int> MazeSolver::aStarPath(const MazeGrid& grid, int from, int to) {
+    const int width = grid.getWidth();
+    const int offsets[4] = { -width, width, 1, -1 };
+    const int targetX = to % width;
+    const int targetY = to / width;
+    auto remaining = [&](int cell) { return std::abs(cell % width - targetX) + std::abs(cell / width - targetY); };
+
+    prepare(grid);
+    heap.clear();
+
+    seen[from] = searchNumber;
+    searchDistances[from] = 0;
+    parents[from] = MazeGrid::NO_CELL;
+    heapPush({ remaining(from), from });
+
+    while (!heap.empty()) {
+        HeapEntry entry = heapPop();
+        int cell = entry.cell;
+        int distance = searchDistances[cell];
+
+        // A cell is pushed again when a shorter way to it is found, leaving the old entry behind
+        if (entry.estimate > distance + remaining(cell)) {
+            continue;
+        }
+        expanded++;
+        if (cell == to) {
+            return tracePath(to);
+        }
+
+        uint8_t passages = grid.getPassages(cell);
+        for (int direction = 0; direction < 4; direction++) {
+            if ((passages >> direction) & 1) {
+                int neighbour = cell + offsets[direction];
+                if (seen[neighbour] != searchNumber || distance + 1 < searchDistances[neighbour]) {
+                    seen[neighbour] = searchNumber;
+                    searchDistances[neighbour] = distance + 1;
+                    parents[neighbour] = cell;
+                    heapPush({ distance + 1 + remaining(neighbour), neighbour });
+                }
+            }
+        }
+    }
+
+    return {};
+}
+
+
+// Finds a shortest path by breadth-first search from both ends
+std::vector<int> MazeSolver::bidirectionalPath(const MazeGrid& grid, int from, int to) {
+    const int offsets[4] = { -grid.getWidth(), grid.getWidth(), 1, -1 };
+    prepare(grid);
+    queue.clear();
+    otherQueue.clear();
+
+    if (from == to) {
+        return { from };
+    }
+
+    int ends[2] = { from, to };
+    for (int side = 0; side < 2; side++) {
+        seen[ends[side]] = searchNumber;
+        sides[ends[side]] = static_cast<uint8_t>(side);
+        searchDistances[ends[side]] = 0;
+        parents[ends[side]] = MazeGrid::NO_CELL;
+    }
+    queue.push(from);
+    otherQueue.push(to);
+
+    int best = INT_MAX;
+    int meetFrom = MazeGrid::NO_CELL;
+    int meetTo = MazeGrid::NO_CELL;
+
+    // Grow the smaller frontier a whole level at a time, so the first meeting level holds the shortest path
+    while (best == INT_MAX && !queue.empty() && !otherQueue.empty()) {
+        uint8_t side = (queue.size() <= otherQueue.size()) ? 0 : 1;
+        RingQueue& frontier = (side == 0) ? queue : otherQueue;
+
+        for (uint32_t level = frontier.size(); level > 0; level--) {
+            int cell = frontier.pop();
+            uint8_t passages = grid.getPassages(cell);
+            expanded++;
+
+            for (int direction = 0; direction < 4; direction++) {
+                if (!((passages >> direction) & 1)) {
+                    continue;
+                }
+
+                int neighbour = cell + offsets[direction];
+                if (seen[neighbour] != searchNumber) {
+                    seen[neighbour] = searchNumber;
+                    sides[neighbour] = side;
+                    searchDistances[neighbour] = searchDistances[cell] + 1;
+                    parents[neighbour] = cell;
+                    frontier.push(neighbour);
+                }
+                else if (sides[neighbour] != side && searchDistances[cell] + 1 + searchDistances[neighbour] < best) {
+                    best = searchDistances[cell] + 1 + searchDistances[neighbour];
+                    meetFrom = (side == 0) ? cell : neighbour;
+                    meetTo = (side == 0) ? neighbour : cell;
+                }
+            }
+        }
+    }
+
+    if (best == INT_MAX) {
+        return {};
+    }
+
+    // The start's half leads back to the start, and the target's half leads on to the target
+    std::vector<int> path = tracePath(meetFrom);
+    for (int cell = meetTo; cell != MazeGrid::NO_CELL; cell = parents[cell]) {
+        path.push_back(cell);
+    }
+    return path;
+}
+
+
+// Finds the distance of every cell of a layered maze by breadth-first search
+const std::vector<int>& MazeSolver::distanceField(const MazeGrid3D& grid, int source) {
+    distances.assign(static_cast<size_t>(grid.getStorageSize()), UNREACHED);
+    queue.clear();
+    expanded = 0;
+
+    if (source < 0 || source >= grid.getStorageSize()) {
+        return distances;
+    }
+
+    distances[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+        int cell = queue.pop();
+        int next = distances[cell] + 1;
+        uint8_t passages = grid.getPassages(cell);
+        expanded++;
+
+        for (int direction = 0; direction < 6; direction++) {
+            if ((passages >> direction) & 1) {
+                int neighbour = grid.step(cell, direction);
+                if (distances[neighbour] == UNREACHED) {
+                    distances[neighbour] = next;
+                    queue.push(neighbour);
+                }
+            }
+        }
+    }
+
+    return distances;
+}
+
+
+// Finds the cell of a layered maze furthest from a source
+int MazeSolver::farthestCell(const MazeGrid3D& grid, int source) {
+    const std::vector<int>& field = distanceField(grid, source);
+    int farthest = source;
+
+    for (int cell = 0; cell < grid.getStorageSize(); cell++) {
+        if (field[cell] > field[farthest]) {
+            farthest = cell;
+        }
+    }
+    return farthest;
+}
+
+
+// Finds a shortest path through a layered maze by breadth-first search
+std::vector<int> MazeSolver::breadthFirstPath(const MazeGrid3D& grid, int from, int to) {
+    distances.assign(static_cast<size_t>(grid.getStorageSize()), UNREACHED);
+    queue.clear();
+    expanded = 0;
+
+    distances[from] = 0;
+    queue.push(from);
+    while (!queue.empty() && distances[to] == UNREACHED) {
+        int cell = queue.pop();
+        uint8_t passages = grid.getPassages(cell);
+        expanded++;
+
+        for (int direction = 0; direction < 6; direction++) {
+            if ((passages >> direction) & 1) {
+                int neighbour = grid.step(cell, direction);
+                if (distances[neighbour] == UNREACHED) {
+                    distances[neighbour] = distances[cell] + 1;
+                    queue.push(neighbour);
+                }
+            }
+        }
+    }
+
+    if (distances[to] == UNREACHED) {
+        return {};
+    }
+
+    std::vector<int> path(static_cast<size_t>(distances[to]) + 1);
+    int cell = to;
+    for (int step = distances[to]; step > 0; step--) {
+        path[step] = cell;
+        uint8_t passages = grid.getPassages(cell);
+        for (int direction = 0; direction < 6; direction++) {
+            if (((passages >> direction) & 1) && distances[grid.step(cell, direction)] == step - 1) {
+                cell = grid.step(cell, direction);
+                break;
+            }
+        }
+    }
+    path[0] = cell;
+    return path;
+}
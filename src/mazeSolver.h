@@ -0,0 +1,227 @@
+#ifndef MAZE_SOLVER_H
+#define MAZE_SOLVER_H
+
+/*!
+* @file mazeSolver.h
+* @brief Contains the declaration of the MazeSolver class, which finds distances and shortest paths through a MazeGrid
+* @brief or a MazeGrid3D.
+*/
+
+#include "mazeGrid.h"
+#include "mazeGrid3D.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+* @class MazeSolver
+* @brief Finds distances and shortest paths through a maze, keeping its working memory between searches.
+* @details Three ways to find a path are offered, as each suits a different use: breadth-first search also gives the
+* @details distance to every cell, A* with the Manhattan distance as its guide looks at fewer cells when the way is
+* @details fairly direct, and bidirectional breadth-first search meets in the middle, looking at about half as many
+* @details cells as a one-sided search in a maze with no loops. A* and the bidirectional search mark the cells they
+* @details have seen with the number of the search, so neither has to clear anything the size of the maze first.
+*/
+class MazeSolver {
+public:
+	static constexpr int UNREACHED = -1; /*!< The distance of a cell no passage leads to. */
+
+private:
+	/*!
+	* @class RingQueue
+	* @brief A first in, first out queue of cells in a ring buffer that only grows, never shrinks.
+	* @details A breadth-first search only ever holds its frontier, which in a maze is far smaller than the maze.
+	*/
+	class RingQueue {
+		std::vector<int> ring; /*!< The cells, a power of two of them. */
+		uint32_t head; /*!< Where the next cell is taken from, before masking. */
+		uint32_t tail; /*!< Where the next cell is put, before masking. */
+
+	public:
+		/*!
+		* @brief Constructor for RingQueue.
+		* @param capacity The cells to make room for at first, rounded up to a power of two.
+		*/
+		explicit RingQueue(uint32_t capacity = 1024);
+
+		/*!
+		* @brief Empty the queue, keeping its memory.
+		*/
+		void clear() { head = tail = 0; }
+
+		/*!
+		* @brief Check if the queue is empty.
+		* @return true if it is.
+		*/
+		bool empty() const { return head == tail; }
+
+		/*!
+		* @brief Get the number of cells in the queue.
+		* @return The count.
+		*/
+		uint32_t size() const { return tail - head; }
+
+		/*!
+		* @brief Add a cell to the back, doubling the ring first if it is full.
+		* @param cell The cell.
+		*/
+		void push(int cell) {
+			if (tail - head == ring.size()) {
+				grow();
+			}
+			ring[tail++ & (ring.size() - 1)] = cell;
+		}
+
+		/*!
+		* @brief Take the cell from the front.
+		* @return The cell.
+		*/
+		int pop() { return ring[head++ & (ring.size() - 1)]; }
+
+		/*!
+		* @brief Double the ring, unwrapping the cells in it.
+		*/
+		void grow();
+
+		/*!
+		* @brief Get the number of cells there is room for.
+		* @return The capacity.
+		*/
+		size_t capacity() const { return ring.size(); }
+	};
+
+	/*!
+	* @struct HeapEntry
+	* @brief A cell waiting in A*'s open set.
+	*/
+	struct HeapEntry {
+		int estimate; /*!< The distance so far plus the Manhattan distance still to go. */
+		int cell; /*!< The cell. */
+	};
+
+	static constexpr int HEAP_ARITY = 4; /*!< The children of each heap node; four shortens the heap and fits a cache line. */
+
+	RingQueue queue; /*!< The breadth-first searches' frontier. */
+	RingQueue otherQueue; /*!< The bidirectional search's frontier from the far end. */
+	std::vector<int> distances; /*!< The distance field from the last distanceField call. */
+	std::vector<int> searchDistances; /*!< The distance from the start of each cell seen by A* or the bidirectional search. */
+	std::vector<int> parents; /*!< The cell each cell was reached from, in A* or the bidirectional search. */
+	std::vector<uint32_t> seen; /*!< The search each cell was last seen by, so only cells seen by this one count. */
+	std::vector<uint8_t> sides; /*!< Which end of the bidirectional search saw each cell. */
+	std::vector<HeapEntry> heap; /*!< A*'s open set, a four-way min-heap by estimate. */
+	uint32_t searchNumber; /*!< The number of the search under way. */
+	uint64_t expanded; /*!< The cells the last search took its next steps from. */
+
+	/*!
+	* @brief Make the working memory big enough for a maze and start a new search number.
+	* @param grid The maze.
+	*/
+	void prepare(const MazeGrid& grid);
+
+	/*!
+	* @brief Add an entry to A*'s heap.
+	* @param entry The entry.
+	*/
+	void heapPush(HeapEntry entry);
+
+	/*!
+	* @brief Take the entry with the smallest estimate from A*'s heap.
+	* @return The entry.
+	*/
+	HeapEntry heapPop();
+
+	/*!
+	* @brief Follow the parents back from a cell to where they started.
+	* @param cell The cell.
+	* @return The path, from the start to the cell.
+	*/
+	std::vector<int> tracePath(int cell) const;
+
+public:
+	/*!
+	* @brief Constructor for MazeSolver.
+	*/
+	MazeSolver();
+
+	/*!
+	* @brief Find the distance of every cell from a source by breadth-first search.
+	* @param grid The maze.
+	* @param source The cell to measure from.
+	* @return The distance of each cell in steps, or UNREACHED, valid until the next call.
+	*/
+	const std::vector<int>& distanceField(const MazeGrid& grid, int source);
+
+	/*!
+	* @brief Find the cell furthest from a source, for putting the exit as far as it can be from the start.
+	* @param grid The maze.
+	* @param source The cell to measure from.
+	* @return The furthest cell; the lowest numbered of them if several are equally far.
+	*/
+	int farthestCell(const MazeGrid& grid, int source);
+
+	/*!
+	* @brief Find a shortest path by breadth-first search, stopping once the target is reached.
+	* @param grid The maze.
+	* @param from The start.
+	* @param to The target.
+	* @return The cells of the path from start to target, or empty if there is none.
+	*/
+	std::vector<int> breadthFirstPath(const MazeGrid& grid, int from, int to);
+
+	/*!
+	* @brief Find a shortest path by A*, guided by the Manhattan distance to the target.
+	* @param grid The maze.
+	* @param from The start.
+	* @param to The target.
+	* @return The cells of the path from start to target, or empty if there is none.
+	*/
+	std::vector<int> aStarPath(const MazeGrid& grid, int from, int to);
+
+	/*!
+	* @brief Find a shortest path by breadth-first search from both ends at once, a level at a time from the smaller side.
+	* @param grid The maze.
+	* @param from The start.
+	* @param to The target.
+	* @return The cells of the path from start to target, or empty if there is none.
+	*/
+	std::vector<int> bidirectionalPath(const MazeGrid& grid, int from, int to);
+
+	/*!
+	* @brief Find the distance of every cell of a layered maze from a source by breadth-first search.
+	* @param grid The maze.
+	* @param source The cell to measure from.
+	* @return The distance of each cell stored in steps, or UNREACHED, valid until the next call.
+	*/
+	const std::vector<int>& distanceField(const MazeGrid3D& grid, int source);
+
+	/*!
+	* @brief Find the cell of a layered maze furthest from a source.
+	* @param grid The maze.
+	* @param source The cell to measure from.
+	* @return The furthest cell; the lowest numbered of them if several are equally far.
+	*/
+	int farthestCell(const MazeGrid3D& grid, int source);
+
+	/*!
+	* @brief Find a shortest path through a layered maze by breadth-first search, stopping once the target is reached.
+	* @param grid The maze.
+	* @param from The start.
+	* @param to The target.
+	* @return The cells of the path from start to target, or empty if there is none.
+	*/
+	std::vector<int> breadthFirstPath(const MazeGrid3D& grid, int from, int to);
+
+	/*!
+	* @brief Get the number of cells the last search took its next steps from, to compare the searches.
+	* @return The count.
+	*/
+	uint64_t getExpanded() const { return expanded; }
+
+	/*!
+	* @brief Get the most cells the breadth-first queue has had to hold.
+	* @return The capacity of its ring.
+	*/
+	size_t getQueueCapacity() const { return queue.capacity(); }
+};
+
+#endif // MAZE_SOLVER_H
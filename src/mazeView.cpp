@@ -0,0 +1,177 @@
+#include "mazeView.h"
+#include <algorithm>
+
+
+// Constructor for the MazeView class
+MazeView::MazeView(int columns, int rows) : columns(0), rows(0), originX(0), originY(0) {
+    resize(columns, rows);
+}
+
+
+// Changes the size of the view
+void MazeView::resize(int columns, int rows) {
+    this->columns = std::max(columns, 0);
+    this->rows = std::max(rows, 0);
+
+    int width = 2 * this->columns + 1;
+    int height = 2 * this->rows + 1;
+    lines.assign(static_cast<size_t>(height), std::wstring(static_cast<size_t>(width), L' '));
+    dirtyFrom.assign(static_cast<size_t>(height), 0);
+    dirtyTo.assign(static_cast<size_t>(height), width - 1);
+    span.reserve(static_cast<size_t>(width));
+}
+
+
+// Widens the changed span of a line
+void MazeView::markDirty(int line, int from, int to) {
+    if (dirtyTo[line] < dirtyFrom[line]) {
+        dirtyFrom[line] = from;
+        dirtyTo[line] = to;
+    }
+    else {
+        dirtyFrom[line] = std::min(dirtyFrom[line], from);
+        dirtyTo[line] = std::max(dirtyTo[line], to);
+    }
+}
+
+
+// Moves the camera to keep a cell away from the edge of the view
+bool MazeView::follow(const MazeGrid& grid, int x, int y) {
+    int marginX = columns / 4;
+    int marginY = rows / 4;
+    int newX = originX;
+    int newY = originY;
+
+    if (x < originX + marginX || x >= originX + columns - marginX) {
+        newX = x - columns / 2;
+    }
+    if (y < originY + marginY || y >= originY + rows - marginY) {
+        newY = y - rows / 2;
+    }
+    newX = std::max(0, std::min(newX, grid.getWidth() - columns));
+    newY = std::max(0, std::min(newY, grid.getHeight() - rows));
+
+    bool moved = newX != originX || newY != originY;
+    originX = newX;
+    originY = newY;
+    return moved;
+}
+
+
+// Checks if a cell is in the view
+bool MazeView::contains(const MazeGrid& grid, int cell) const {
+    int x = cell % grid.getWidth() - originX;
+    int y = cell / grid.getWidth() - originY;
+    return x >= 0 && x < columns && y >= 0 && y < rows;
+}
+
+
+// Draws every cell in the view
+void MazeView::drawAll(const MazeGrid& grid) {
+    int width = std::min(columns, grid.getWidth() - originX);
+    int height = std::min(rows, grid.getHeight() - originY);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            drawCell(grid, grid.index(originX + x, originY + y), L' ');
+        }
+    }
+}
+
+
+// Draws one cell
+void MazeView::drawCell(const MazeGrid& grid, int cell, wchar_t centre) {
+    if (!contains(grid, cell)) {
+        return;
+    }
+
+    uint8_t passages = grid.getPassages(cell);
+    int column = 2 * (cell % grid.getWidth() - originX) + 1;
+    int line = 2 * (cell / grid.getWidth() - originY) + 1;
+
+    lines[line][column] = centre;
+    lines[line][column + 1] = (passages & MazeGrid::OPEN_EAST) ? L' ' : L'|';
+    lines[line + 1][column] = (passages & MazeGrid::OPEN_SOUTH) ? L' ' : L'-';
+    lines[line + 1][column + 1] = L'+';
+
+    // Cells on the top and left of the view draw the border too
+    int from = column;
+    if (column == 1) {
+        lines[line][0] = (passages & MazeGrid::OPEN_WEST) ? L' ' : L'|';
+        lines[line + 1][0] = L'+';
+        from = 0;
+    }
+    if (line == 1) {
+        lines[0][column] = (passages & MazeGrid::OPEN_NORTH) ? L' ' : L'-';
+        lines[0][column + 1] = L'+';
+        lines[0][0] = L'+';
+        markDirty(0, from, column + 1);
+    }
+
+    markDirty(line, from, column + 1);
+    markDirty(line + 1, from, column + 1);
+}
+
+
+// Draws one cell along with the walls north and west of it
+void MazeView::drawRevealed(const MazeGrid& grid, int cell, wchar_t centre) {
+    if (!contains(grid, cell)) {
+        return;
+    }
+    drawCell(grid, cell, centre);
+
+    uint8_t passages = grid.getPassages(cell);
+    int column = 2 * (cell % grid.getWidth() - originX) + 1;
+    int line = 2 * (cell / grid.getWidth() - originY) + 1;
+
+    lines[line - 1][column - 1] = L'+';
+    lines[line - 1][column] = (passages & MazeGrid::OPEN_NORTH) ? L' ' : L'-';
+    lines[line - 1][column + 1] = L'+';
+    lines[line][column - 1] = (passages & MazeGrid::OPEN_WEST) ? L' ' : L'|';
+    lines[line + 1][column - 1] = L'+';
+
+    markDirty(line - 1, column - 1, column + 1);
+    markDirty(line, column - 1, column + 1);
+    markDirty(line + 1, column - 1, column + 1);
+}
+
+
+// Draws one cell as fog
+void MazeView::drawHidden(const MazeGrid& grid, int cell) {
+    if (!contains(grid, cell)) {
+        return;
+    }
+
+    int column = 2 * (cell % grid.getWidth() - originX) + 1;
+    int line = 2 * (cell / grid.getWidth() - originY) + 1;
+
+    // Cells on the top and left of the view cover the border too
+    int from = (column == 1) ? 0 : column;
+    int top = (line == 1) ? 0 : line;
+    for (int y = top; y <= line + 1; y++) {
+        for (int x = from; x <= column + 1; x++) {
+            lines[y][x] = FOG;
+        }
+        markDirty(y, from, column + 1);
+    }
+}
+
+
+// Writes out the changed parts of the lines
+int MazeView::flush(ScreenBuffer& screenBuffer, int left, int top) {
+    int written = 0;
+
+    for (size_t line = 0; line < lines.size(); line++) {
+        if (dirtyTo[line] < dirtyFrom[line]) {
+            continue;
+        }
+
+        span.assign(lines[line], static_cast<size_t>(dirtyFrom[line]), static_cast<size_t>(dirtyTo[line] - dirtyFrom[line] + 1));
+        screenBuffer.writeToScreen(left + dirtyFrom[line], top + static_cast<int>(line), span);
+        written += static_cast<int>(span.size());
+
+        dirtyFrom[line] = 1;
+        dirtyTo[line] = 0;
+    }
+    return written;
+}
@@ -0,0 +1,148 @@
+#ifndef MAZE_VIEW_H
+#define MAZE_VIEW_H
+
+/*!
+* @file mazeView.h
+* @brief Contains the declaration of the MazeView class, a camera over a maze that redraws only what changed.
+*/
+
+#include "mazeGrid.h"
+#include "screenBuffer.h"
+#include <string>
+#include <vector>
+
+/*!
+* @class MazeView
+* @brief The part of a maze that fits on the screen, drawn into lines of text kept from frame to frame.
+* @details Each cell takes two characters by two: its centre, the wall east of it, the wall south of it and a corner,
+* @details with a border line above and to the left of the view. The lines are made the size of the view once, and
+* @details drawing a cell overwrites its characters in place and widens the span of each line that needs writing out,
+* @details so moving the player costs the same however large the maze is. The camera only moves when the player
+* @details comes near the edge of the view, which is the only time the whole view is drawn again.
+*/
+class MazeView {
+public:
+	static constexpr wchar_t FOG = L'.'; /*!< What a cell the player has not seen is drawn with. */
+
+private:
+	int columns; /*!< The cells across the view. */
+	int rows; /*!< The cells down the view. */
+	int originX; /*!< The column of the maze at the left of the view. */
+	int originY; /*!< The row of the maze at the top of the view. */
+	std::vector<std::wstring> lines; /*!< The text of the view, 2 * rows + 1 lines of 2 * columns + 1 characters. */
+	std::vector<int> dirtyFrom; /*!< The first character of each line changed since the last flush. */
+	std::vector<int> dirtyTo; /*!< The last character of each line changed since the last flush; less than dirtyFrom if none. */
+	std::wstring span; /*!< The changed part of a line, copied here to write out without allocating. */
+
+	/*!
+	* @brief Widen the changed span of a line.
+	* @param line The line.
+	* @param from The first character changed.
+	* @param to The last character changed.
+	*/
+	void markDirty(int line, int from, int to);
+
+public:
+	/*!
+	* @brief Constructor for MazeView.
+	* @param columns The cells across the view.
+	* @param rows The cells down the view.
+	*/
+	explicit MazeView(int columns = 0, int rows = 0);
+
+	/*!
+	* @brief Change the size of the view, making its lines again.
+	* @param columns The cells across the view.
+	* @param rows The cells down the view.
+	*/
+	void resize(int columns, int rows);
+
+	/*!
+	* @brief Get the cells across the view.
+	* @return The columns.
+	*/
+	int getColumns() const { return columns; }
+
+	/*!
+	* @brief Get the cells down the view.
+	* @return The rows.
+	*/
+	int getRows() const { return rows; }
+
+	/*!
+	* @brief Get the column of the maze at the left of the view.
+	* @return The column.
+	*/
+	int getOriginX() const { return originX; }
+
+	/*!
+	* @brief Get the row of the maze at the top of the view.
+	* @return The row.
+	*/
+	int getOriginY() const { return originY; }
+
+	/*!
+	* @brief Move the camera to centre on a cell if it is near the edge of the view, keeping the view inside the maze.
+	* @param grid The maze.
+	* @param x The column to follow.
+	* @param y The row to follow.
+	* @return true if the camera moved, when the whole view must be drawn again.
+	*/
+	bool follow(const MazeGrid& grid, int x, int y);
+
+	/*!
+	* @brief Check if a cell is in the view.
+	* @param grid The maze.
+	* @param cell The cell.
+	* @return true if it is.
+	*/
+	bool contains(const MazeGrid& grid, int cell) const;
+
+	/*!
+	* @brief Draw every cell in the view with nothing in it.
+	* @param grid The maze.
+	*/
+	void drawAll(const MazeGrid& grid);
+
+	/*!
+	* @brief Draw one cell, if it is in the view.
+	* @param grid The maze.
+	* @param cell The cell.
+	* @param centre The character in the middle of the cell.
+	*/
+	void drawCell(const MazeGrid& grid, int cell, wchar_t centre);
+
+	/*!
+	* @brief Draw one cell with all four of its walls, if it is in the view, for a cell coming out of the fog.
+	* @details The walls north and west of a cell are drawn with the cells north and west of it, which may still be fog.
+	* @param grid The maze.
+	* @param cell The cell.
+	* @param centre The character in the middle of the cell.
+	*/
+	void drawRevealed(const MazeGrid& grid, int cell, wchar_t centre);
+
+	/*!
+	* @brief Draw one cell as fog, if it is in the view.
+	* @param grid The maze.
+	* @param cell The cell.
+	*/
+	void drawHidden(const MazeGrid& grid, int cell);
+
+	/*!
+	* @brief Get a line of the view's text.
+	* @param line The line, 0 being the border above the top row.
+	* @return The line.
+	*/
+	const std::wstring& getLine(int line) const { return lines[line]; }
+
+	/*!
+	* @brief Write out the parts of the lines that changed since the last flush.
+	* @param screenBuffer The screen.
+	* @param left The screen column of the left of the view.
+	* @param top The screen row of the top of the view.
+	* @return The number of characters written.
+	*/
+	int flush(ScreenBuffer& screenBuffer, int left, int top);
+};
+
+#endif // MAZE_VIEW_H
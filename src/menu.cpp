@@ -1,15 +1,34 @@
 #include "menu.h"
 
-// Initialize games
-Hnefatafl hnefataflGame;
-//Maze mazeGame(10,10);
-
-NaughtsxCrossess naughtsxCrossessGame;
-Hangman hangmanGame;
-WordScrambler wordScramblerGame;
-BattleshipGame battleshipGame;
-
-Con4 con4Game;
+// Constructor for the menu, offering the games without building them
+Menu::Menu() : row(1), padding(0), width(0), startY(2), sharedScreen(&screenBuffer)
+{
+    // Every game draws on the menu's screen buffer, and these small ones are kept between plays
+    games.add<Hangman>(1, [this]() { return std::unique_ptr<Hangman>(new Hangman(&sharedScreen)); },
+        [](Hangman& game) { game.hangman(); return RETURN_TO_MENU; }, false);
+    games.add<NaughtsxCrossess>(4, [this]() { return std::unique_ptr<NaughtsxCrossess>(new NaughtsxCrossess(&screenBuffer)); },
+        [](NaughtsxCrossess& game) { game.run(); return RETURN_TO_MENU; }, false);
+    games.add<WordScrambler>(8, [this]() { return std::unique_ptr<WordScrambler>(new WordScrambler(&sharedScreen)); },
+        [](WordScrambler& game) { game.run(); return RETURN_TO_MENU; }, false);
+    games.add<BattleshipGame>(9, [this]() { return std::unique_ptr<BattleshipGame>(new BattleshipGame(&screenBuffer)); },
+        [](BattleshipGame& game) { game.run(); return RETURN_TO_MENU; }, false);
+
+    // The rest draw on the menu's screen buffer too, but hold more, so are torn down once they are over
+    games.add<Con4>(2, [this]() { return std::unique_ptr<Con4>(new Con4(&screenBuffer)); },
+        [](Con4& game) { return game.connect4(); }, true);
+    games.add<Checkers>(5, [this]() { return std::unique_ptr<Checkers>(new Checkers(&screenBuffer)); },
+        [](Checkers& game) { return game.run(); }, true);
+    games.add<Hnefatafl>(6, [this]() { return std::unique_ptr<Hnefatafl>(new Hnefatafl(&screenBuffer)); },
+        [](Hnefatafl& game) { return game.run(); }, true);
+    games.add<Maze>(3, [this]() { return std::unique_ptr<Maze>(new Maze(MAZE_WIDTH, MAZE_HEIGHT, MazeAlgorithm::WILSON, &screenBuffer)); },
+        [](Maze& game) { return game.run(); }, true);
+    games.add<Sudoku>(7, [this]() { return std::unique_ptr<Sudoku>(new Sudoku(&screenBuffer)); },
+        [](Sudoku& game) { return game.run(); }, true);
+    games.add<Minesweeper>(10, [this]() { return std::unique_ptr<Minesweeper>(new Minesweeper(&screenBuffer)); },
+        [](Minesweeper& game) { return game.run(); }, true);
+    games.add<Chess>(11, [this]() { return std::unique_ptr<Chess>(new Chess(&screenBuffer)); },
+        [](Chess& game) { return game.run(); }, true);
+}
 
 
 // Input function to start each game
@@ -19,57 +38,16 @@ int Menu::startGame(int input)
 
     switch (input)
     {
-    case 1:
-        // Call function to start Hangman
-        hangmanGame.hangman();
-        break;
-    case 2:
-        // Call function to start Connect 4
-        output = con4Game.connect4();
-        break;
-    case 3:
-        // Call function to start Maze
-        screenBuffer.writeToScreen(75, startY + row, L"Coming Soon", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
-        //output = mazeGame.run();
-        break;
-    case 4:
-        // Call function to start Naughts and Crosses
-		naughtsxCrossessGame.run();
-        break;
-    case 5:
-        // Call function to start Checkers
-		//checkers();
-        screenBuffer.writeToScreen(75, startY + row, L"Coming Soon", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
-        break;
-    case 6:
-        // Call the class to start Hnefatafl
-        output = hnefataflGame.run();
-        break;
-    case 7:
-        // Call function to start Sudoku
-        screenBuffer.writeToScreen(75, startY + row, L"Coming Soon", ScreenBuffer::RED,ScreenBuffer::BACKGROUND_NORMAL);
-        break;
-    case 8:
-        // Call function to start Word Scramble
-        wordScramblerGame.run();
-        break;
-    case 9:
-        // Call function to start Battleship
-        battleshipGame.run();
-        break;
-    case 10:
-        // Call function to start Minesweeper
-        screenBuffer.writeToScreen(75, startY + row, L"Coming Soon", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
-        break;
-    case 11:
-        // Call function to start Multiplayer Chess
-        screenBuffer.writeToScreen(75, startY + row, L"Coming Soon", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
-        break;
     case 12:
         // Exit the program
 		output = EXIT_GAME;
         break;
-    default: break;
+    default:
+        // Build the game if this is the first time it has been chosen, then play it
+        if (games.contains(input)) {
+            output = games.run(input);
+        }
+        break;
     }
 
 	return output;
@@ -81,6 +59,9 @@ int Menu::displayMenu()
 {
     try
     {
+        // Clear whatever a game sharing the screen buffer left on it
+        screenBuffer.clearScreen();
+
         // Set cursor visibility
         screenBuffer.setCursorVisibility(false);
 
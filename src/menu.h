@@ -16,6 +16,11 @@
 #include "BattleshipGame.h"
 #include "NaughtsxCrossess.h"
 #include "chckrs.h"
+#include "Chess.h"
+#include "sudoku.h"
+#include "minesweeper.h"
+#include "RealScreenBuffer.h"
+#include "gameRegistry.h"
 #include <conio.h>
 
 /*!
@@ -29,7 +34,13 @@ private:
 	int width; /*!< The width of the menu */
 	int startY; /*!< The starting y cordinate of the menu */
 
+	static const int MAZE_WIDTH = 40; /*!< The width of the flat maze, which scrolls if it does not fit */
+	static const int MAZE_HEIGHT = 20; /*!< The height of the flat maze */
+
 	ScreenBuffer screenBuffer;
+	RealScreenBuffer sharedScreen; /*!< The menu's screen buffer, for the games that take an IScreenBuffer */
+	GameRegistry games; /*!< The games, each built the first time it is chosen */
+
     /*!
     * @brief function to start a game based on the user input
     * @param input - The input from the user
@@ -40,6 +51,11 @@ public:
     static const int RETURN_TO_MENU = 0;
     static const int EXIT_GAME = 1;
 
+    /*!
+    * @brief Constructor for the menu, offering every game without building any of them
+    */
+    Menu();
+
     /*!
     * @brief Function to display the menu
     */
@@ -0,0 +1,219 @@
+#include "minesweeper.h"
+
+// The colour of each number, as on the classic board
+static const WORD NUMBER_COLOURS[9] = {
+    ScreenBuffer::WHITE, ScreenBuffer::BLUE, ScreenBuffer::GREEN, ScreenBuffer::RED, ScreenBuffer::MAGENTA,
+    ScreenBuffer::YELLOW, ScreenBuffer::CYAN, ScreenBuffer::WHITE, ScreenBuffer::WHITE
+};
+
+
+// Constructor for the Minesweeper class
+Minesweeper::Minesweeper(ScreenBuffer* buffer) : board(9, 9, 10), noGuessing(false), ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
+}
+
+
+// Sets up a new board with its mines still to be laid
+void Minesweeper::generateBoard(int width, int height, int mines, bool noGuess) {
+    board = MinesweeperBoard(width, height, mines);
+    noGuessing = noGuess;
+}
+
+
+// Reveals a cell, generating the board around it on the first reveal
+int Minesweeper::reveal(int cell) {
+    if (!board.areMinesLaid()) {
+        board = generator.generate(board.getWidth(), board.getHeight(), board.getMineCount(), cell, noGuessing);
+    }
+
+    return board.reveal(cell);
+}
+
+
+// Gets the board being played
+const MinesweeperBoard& Minesweeper::getBoard() const {
+    return board;
+}
+
+
+// Checks for valid move input
+bool Minesweeper::isValidInput(const std::string& input) const {
+    // An optional 'f' to flag, then a row and a column of one or two digits
+    std::regex pattern(R"(^(f )?[0-9]{1,2} [0-9]{1,2}$)");
+
+    return std::regex_match(input, pattern);
+}
+
+
+// Prints the board, '#' for hidden cells, 'F' for flags and '*' for mines once the game is over
+void Minesweeper::printBoard() {
+    bool over = board.isWon() || board.isLost();
+
+    screenBuffer.clearScreen();
+
+    std::wstring header = L"    ";
+    for (int column = 0; column < board.getWidth(); column++) {
+        header += (column + 1 < 10) ? L"  " : L" ";
+        header += std::to_wstring(column + 1);
+    }
+    screenBuffer.writeToScreen(4, 1, header);
+
+    for (int row = 0; row < board.getHeight(); row++) {
+        int y = 2 + row;
+        screenBuffer.writeToScreen(4, y, (row + 1 < 10) ? L"   " + std::to_wstring(row + 1) : L"  " + std::to_wstring(row + 1));
+
+        for (int column = 0; column < board.getWidth(); column++) {
+            int cell = board.cellAt(column, row);
+            int x = 10 + column * 3;
+
+            if (board.isMine(cell) && (board.isRevealed(cell) || (over && !board.isFlagged(cell)))) {
+                screenBuffer.writeToScreen(x, y, L"*", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
+            }
+            else if (board.isFlagged(cell)) {
+                // A wrong flag is shown once the game is over
+                WORD colour = (over && !board.isMine(cell)) ? ScreenBuffer::MAGENTA : ScreenBuffer::RED;
+                screenBuffer.writeToScreen(x, y, L"F", colour, ScreenBuffer::BACKGROUND_NORMAL);
+            }
+            else if (!board.isRevealed(cell)) {
+                screenBuffer.writeToScreen(x, y, L"#");
+            }
+            else if (board.getAdjacentMines(cell) == 0) {
+                screenBuffer.writeToScreen(x, y, L".");
+            }
+            else {
+                int count = board.getAdjacentMines(cell);
+                screenBuffer.writeToScreen(x, y, std::to_wstring(count), NUMBER_COLOURS[count], ScreenBuffer::BACKGROUND_NORMAL);
+            }
+        }
+    }
+
+    screenBuffer.writeToScreen(4, 2 + board.getHeight(), L"Mines: " + std::to_wstring(board.getMineCount()) + L"   Flags: " +
+        std::to_wstring(board.getFlagCount()));
+}
+
+
+// Asks whether to return to the menu or exit
+int Minesweeper::endGame() {
+    screenBuffer.writeToScreen(4, 22, L"Type 'return' to return to the main menu, or 'exit' to exit MiniGame-Madness.");
+
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "return") {
+            return 0;
+        }
+        else if (input == "exit") {
+            return 1;
+        }
+        else {
+            screenBuffer.writeToScreen(4, 22, L"Invalid input. Please type 'return' or 'exit':                                 ");
+        }
+    }
+}
+
+
+// The game loop, revealing and flagging cells until every safe cell is revealed or a mine is hit
+int Minesweeper::run() {
+    screenBuffer.setActive();
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Choose a difficulty: 'beginner', 'intermediate' or 'expert': ");
+
+    int width = 9, height = 9, mines = 10;
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "beginner" || input == "intermediate" || input == "expert") {
+            width = (input == "beginner") ? 9 : ((input == "intermediate") ? 16 : 30);
+            height = (input == "beginner") ? 9 : 16;
+            mines = (input == "beginner") ? 10 : ((input == "intermediate") ? 40 : 99);
+            break;
+        }
+        screenBuffer.writeToScreen(4, 2, L"Please enter 'beginner', 'intermediate' or 'expert':          ");
+    }
+
+    screenBuffer.writeToScreen(4, 4, L"Should the board never need a guess? (y/n): ");
+    std::string answer = screenBuffer.getBlockingInput();
+    while (answer != "y" && answer != "n") {
+        screenBuffer.writeToScreen(4, 4, L"Please enter 'y' or 'n':                    ");
+        answer = screenBuffer.getBlockingInput();
+    }
+
+    generateBoard(width, height, mines, answer == "y");
+    printBoard();
+
+    while (!board.isWon() && !board.isLost()) {
+        screenBuffer.writeToScreen(4, 19, L"Enter row and column to reveal (e.g., 3 12), 'f' first to flag (f 3 12), 'hint' or 'quit': ");
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "quit") {
+            screenBuffer.writeToScreen(4, 20, L"Game abandoned.");
+            return endGame();
+        }
+
+        if (input == "hint") {
+            int cell = solver.findHint(board);
+            double chance = board.areMinesLaid() ? solver.analyse(board).mineProbability[cell] : 0.0;
+
+            printBoard();
+            std::wstring where = L"Row " + std::to_wstring(cell / board.getWidth() + 1) + L", column " + std::to_wstring(cell % board.getWidth() + 1);
+            if (chance == 0.0) {
+                screenBuffer.writeToScreen(4, 20, where + L" is safe.");
+            }
+            else {
+                screenBuffer.writeToScreen(4, 20, L"There is no safe cell. " + where + L" has the least chance of a mine, " +
+                    std::to_wstring(static_cast<int>(chance * 100 + 0.5)) + L"%.");
+            }
+            continue;
+        }
+
+        if (!isValidInput(input)) {
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"Invalid input. Please enter a row and a column, such as '3 12', or 'f 3 12' to flag.");
+            continue;
+        }
+
+        bool flag = input[0] == 'f';
+        size_t start = flag ? 2 : 0;
+        size_t space = input.find(' ', start);
+        int row = std::stoi(input.substr(start, space - start)) - 1;
+        int column = std::stoi(input.substr(space + 1)) - 1;
+
+        if (row < 0 || row >= board.getHeight() || column < 0 || column >= board.getWidth()) {
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"That cell is off the board.");
+            continue;
+        }
+
+        int cell = board.cellAt(column, row);
+        if (flag) {
+            // The board is only made on the first reveal, so there is nothing to flag before it
+            if (!board.areMinesLaid()) {
+                printBoard();
+                screenBuffer.writeToScreen(4, 20, L"Reveal a cell before flagging one.");
+                continue;
+            }
+            if (!board.toggleFlag(cell)) {
+                printBoard();
+                screenBuffer.writeToScreen(4, 20, L"Only a hidden cell can be flagged.");
+                continue;
+            }
+        }
+        else if (board.isFlagged(cell)) {
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"That cell is flagged. Unflag it first with 'f'.");
+            continue;
+        }
+        else {
+            reveal(cell);
+        }
+
+        printBoard();
+    }
+
+    if (board.isLost()) {
+        screenBuffer.writeToScreen(4, 20, L"Boom! You hit a mine.", ScreenBuffer::RED, ScreenBuffer::BACKGROUND_NORMAL);
+    }
+    else {
+        screenBuffer.writeToScreen(4, 20, L"Congratulations, the board is cleared!", ScreenBuffer::GREEN, ScreenBuffer::BACKGROUND_NORMAL);
+    }
+    return endGame();
+}
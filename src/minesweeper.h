@@ -0,0 +1,87 @@
+#ifndef MINESWEEPER_H
+#define MINESWEEPER_H
+
+/*!
+* @file minesweeper.h
+* @brief Contains the declaration of the Minesweeper class and its member functions for the Minesweeper game.
+*/
+
+#include "ScreenBuffer.h"
+#include "minesweeperBoard.h"
+#include "minesweeperSolver.h"
+#include <memory>
+#include <string>
+#include <regex>
+
+/*!
+* @class Minesweeper
+* @brief A class that represents the game of Minesweeper.
+* @details The rules live in MinesweeperBoard and the hints in MinesweeperSolver; this class draws the board and runs
+* @details the game loop. The mines are laid on the first reveal, by MinesweeperGenerator when the player asks for a
+* @details board that never needs a guess.
+*/
+class Minesweeper {
+ private:
+
+	MinesweeperGenerator generator; /*!< Makes the no-guess boards. */
+	MinesweeperSolver solver; /*!< Works out the hints. */
+	MinesweeperBoard board; /*!< The board being played. */
+	bool noGuessing; /*!< Whether the board should be clearable without guessing. */
+	std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
+
+	/*!
+	* @brief Prints the board, with the numbers in colour and every mine shown once the game is over.
+	*/
+	void printBoard();
+
+	/*!
+	* @brief Asks whether to return to the menu or exit once the game is over.
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int endGame();
+
+ public:
+	/*!
+	* @brief Constructor for the Minesweeper class.
+	* @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
+	*/
+	explicit Minesweeper(ScreenBuffer* buffer = nullptr);
+
+	/*!
+	* @brief Set up a new board with nothing revealed; its mines are laid on the first reveal.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param mines The number of mines.
+	* @param noGuess Whether the board should be clearable from the first reveal without guessing.
+	*/
+	void generateBoard(int width, int height, int mines, bool noGuess);
+
+	/*!
+	* @brief Reveal a cell, laying the mines first if it is the first reveal.
+	* @param cell The cell.
+	* @return The number of cells revealed, or MinesweeperBoard::REVEALED_MINE if it had a mine.
+	*/
+	int reveal(int cell);
+
+	/*!
+	* @brief Get the board being played.
+	* @return The board.
+	*/
+	const MinesweeperBoard& getBoard() const;
+
+	/*!
+	* @brief Check for valid move input: a row and a column, such as "3 12", with "f " in front to flag the cell.
+	* @param input The input from the user
+	* @return true if the input is valid, false otherwise.
+	*/
+	bool isValidInput(const std::string& input) const;
+
+	/*!
+	* @brief Run the game
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int run();
+};
+
+#endif // MINESWEEPER_H
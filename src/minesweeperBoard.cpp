@@ -0,0 +1,180 @@
+#include "minesweeperBoard.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+// Constructor for the MinesweeperBoard class
+MinesweeperBoard::MinesweeperBoard(int width, int height, int mines, uint32_t seed)
+    : width(width), height(height), mines(mines), minesLaid(false), lost(false), revealedCount(0), flagCount(0), random(seed) {
+    if (width < 1 || height < 1 || static_cast<int64_t>(width) * height > INT32_MAX / 2) {
+        throw std::runtime_error("A Minesweeper board cannot be " + std::to_string(width) + " by " + std::to_string(height));
+    }
+    if (mines < 0 || mines >= width * height) {
+        throw std::runtime_error("A " + std::to_string(width) + " by " + std::to_string(height) + " board cannot have " +
+            std::to_string(mines) + " mines");
+    }
+
+    cells.assign(static_cast<size_t>(width) * height, 0);
+}
+
+
+// Adds to the mine count of every neighbour of a cell
+void MinesweeperBoard::addToNeighbours(int cell, int change) {
+    int neighbours[8];
+    int count = getNeighbours(cell, neighbours);
+
+    for (int i = 0; i < count; i++) {
+        cells[neighbours[i]] = static_cast<uint8_t>(cells[neighbours[i]] + change);
+    }
+}
+
+
+// Gets the cells next to a cell, leaving out those off the edge of the board
+int MinesweeperBoard::getNeighbours(int cell, int neighbours[8]) const {
+    int x = cell % width;
+    int y = cell / width;
+    int count = 0;
+
+    for (int dy = -1; dy <= 1; dy++) {
+        if (y + dy < 0 || y + dy >= height) {
+            continue;
+        }
+        for (int dx = -1; dx <= 1; dx++) {
+            if ((dx == 0 && dy == 0) || x + dx < 0 || x + dx >= width) {
+                continue;
+            }
+            neighbours[count++] = cell + dy * width + dx;
+        }
+    }
+
+    return count;
+}
+
+
+// Lays the mines at random with a partial shuffle of the cells allowed to have one
+void MinesweeperBoard::layMines(int safeCell) {
+    int neighbours[8];
+    int neighbourCount = getNeighbours(safeCell, neighbours);
+
+    // Keep the neighbours clear too if there is room, so the first reveal opens a region
+    std::vector<uint8_t> keepClear(cells.size(), 0);
+    keepClear[safeCell] = 1;
+    if (getCellCount() - 1 - neighbourCount >= mines) {
+        for (int i = 0; i < neighbourCount; i++) {
+            keepClear[neighbours[i]] = 1;
+        }
+    }
+
+    std::vector<int> allowed;
+    allowed.reserve(cells.size());
+    for (int cell = 0; cell < getCellCount(); cell++) {
+        if (!keepClear[cell]) {
+            allowed.push_back(cell);
+        }
+    }
+
+    for (int i = 0; i < mines; i++) {
+        std::uniform_int_distribution<int> pick(i, static_cast<int>(allowed.size()) - 1);
+        std::swap(allowed[i], allowed[pick(random)]);
+    }
+
+    allowed.resize(mines);
+    setMines(allowed);
+}
+
+
+// Lays the mines in the given cells
+void MinesweeperBoard::setMines(const std::vector<int>& mineCells) {
+    if (static_cast<int>(mineCells.size()) != mines) {
+        throw std::runtime_error("Expected " + std::to_string(mines) + " mines but was given " + std::to_string(mineCells.size()));
+    }
+
+    for (uint8_t& cell : cells) {
+        cell &= static_cast<uint8_t>(REVEALED | FLAGGED);
+    }
+
+    for (int cell : mineCells) {
+        if (cell < 0 || cell >= getCellCount() || isMine(cell)) {
+            throw std::runtime_error("Cannot lay a mine in cell " + std::to_string(cell));
+        }
+        cells[cell] |= MINE;
+        addToNeighbours(cell, 1);
+    }
+
+    minesLaid = true;
+}
+
+
+// Moves a mine to a cell without one
+bool MinesweeperBoard::moveMine(int from, int to) {
+    if (!isMine(from) || isMine(to)) {
+        return false;
+    }
+
+    cells[from] &= static_cast<uint8_t>(~MINE);
+    addToNeighbours(from, -1);
+    cells[to] |= MINE;
+    addToNeighbours(to, 1);
+    return true;
+}
+
+
+// Reveals a cell, flood filling out from any cell with no mines next to it
+int MinesweeperBoard::reveal(int cell, std::vector<int>* revealed) {
+    if (!minesLaid) {
+        layMines(cell);
+    }
+    if (isRevealed(cell) || isFlagged(cell)) {
+        return 0;
+    }
+
+    if (isMine(cell)) {
+        cells[cell] |= REVEALED;
+        lost = true;
+        return REVEALED_MINE;
+    }
+
+    int neighbours[8];
+    int newlyRevealed = 0;
+
+    queue.clear();
+    queue.push_back(cell);
+    cells[cell] |= REVEALED;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        newlyRevealed++;
+        if (revealed) {
+            revealed->push_back(current);
+        }
+
+        if (getAdjacentMines(current) != 0) {
+            continue;
+        }
+
+        // No mines next to this cell, so all of its neighbours are safe
+        int count = getNeighbours(current, neighbours);
+        for (int i = 0; i < count; i++) {
+            if (!(cells[neighbours[i]] & (REVEALED | FLAGGED))) {
+                cells[neighbours[i]] |= REVEALED;
+                queue.push_back(neighbours[i]);
+            }
+        }
+    }
+
+    revealedCount += newlyRevealed;
+    return newlyRevealed;
+}
+
+
+// Flags or unflags a hidden cell
+bool MinesweeperBoard::toggleFlag(int cell) {
+    if (isRevealed(cell)) {
+        return false;
+    }
+
+    cells[cell] ^= FLAGGED;
+    flagCount += isFlagged(cell) ? 1 : -1;
+    return true;
+}
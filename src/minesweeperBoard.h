@@ -0,0 +1,198 @@
+#ifndef MINESWEEPER_BOARD_H
+#define MINESWEEPER_BOARD_H
+
+/*!
+* @file minesweeperBoard.h
+* @brief Contains the declaration of the MinesweeperBoard class, the rules of the Minesweeper game.
+* @details Cells are numbered row by row, so cell = y * width + x. Each cell is one byte: the number of mines next to
+* @details it in the low four bits, and flags for a mine, revealed and flagged above them.
+*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*!
+* @class MinesweeperBoard
+* @brief A Minesweeper board of any size, kept as one flat array of cells.
+* @details The mines are laid on the first reveal, keeping the cell clicked and, when there is room, its neighbours
+* @details clear. Revealing a cell with no mines next to it opens the whole region around it with a breadth-first
+* @details flood fill over an explicit queue, so even a board of a million cells cannot overflow the stack.
+*/
+class MinesweeperBoard {
+public:
+	static const uint8_t COUNT_MASK = 0x0F; /*!< The bits holding the number of mines next to a cell. */
+	static const uint8_t MINE = 0x10; /*!< The cell has a mine. */
+	static const uint8_t REVEALED = 0x20; /*!< The cell has been revealed. */
+	static const uint8_t FLAGGED = 0x40; /*!< The player has flagged the cell. */
+
+	static const int REVEALED_MINE = -1; /*!< What reveal returns when the cell had a mine. */
+
+private:
+	int width; /*!< The number of columns. */
+	int height; /*!< The number of rows. */
+	int mines; /*!< The number of mines. */
+	std::vector<uint8_t> cells; /*!< Every cell, row by row. */
+	bool minesLaid; /*!< Whether the mines have been laid yet. */
+	bool lost; /*!< Whether a mine has been revealed. */
+	int revealedCount; /*!< The number of revealed cells. */
+	int flagCount; /*!< The number of flagged cells. */
+	std::vector<int> queue; /*!< The flood fill's queue, kept to save allocating it on every reveal. */
+	std::mt19937 random; /*!< The random numbers for laying mines. */
+
+	/*!
+	* @brief Add to the mine count of a cell's neighbours.
+	* @param cell The cell.
+	* @param change +1 when a mine is added, -1 when one is taken away.
+	*/
+	void addToNeighbours(int cell, int change);
+
+public:
+	/*!
+	* @brief Constructor for MinesweeperBoard, creates a board with every cell hidden and no mines laid yet.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param mines The number of mines.
+	* @param seed The random seed for laying the mines.
+	* @throws runtime_error if the board is empty or there are too many mines to leave a cell clear.
+	*/
+	MinesweeperBoard(int width, int height, int mines, uint32_t seed = std::random_device()());
+
+	/*!
+	* @brief Lay the mines at random, keeping a cell and, when there is room, its neighbours clear.
+	* @param safeCell The cell to keep clear, usually the first one revealed.
+	*/
+	void layMines(int safeCell);
+
+	/*!
+	* @brief Lay the mines in given cells, replacing any laid already.
+	* @param mineCells The cells; there must be as many as the board has mines.
+	* @throws runtime_error if a cell is off the board, repeated, or the count is wrong.
+	*/
+	void setMines(const std::vector<int>& mineCells);
+
+	/*!
+	* @brief Move a mine to a cell without one, keeping every count right.
+	* @details Moving a mine to a revealed cell is only for rearranging a layout, as the game stops making sense.
+	* @param from The cell with the mine.
+	* @param to The cell to move it to.
+	* @return false if from has no mine or to already has one.
+	*/
+	bool moveMine(int from, int to);
+
+	/*!
+	* @brief Reveal a cell, laying the mines first if this is the first reveal.
+	* @details A cell with no mines next to it reveals its neighbours too, and so on across the whole region.
+	* @param cell The cell.
+	* @param revealed If not null, the cells newly revealed are added to it.
+	* @return The number of cells newly revealed, or REVEALED_MINE if the cell had a mine.
+	*/
+	int reveal(int cell, std::vector<int>* revealed = nullptr);
+
+	/*!
+	* @brief Flag a hidden cell, or unflag a flagged one.
+	* @param cell The cell.
+	* @return false if the cell is revealed.
+	*/
+	bool toggleFlag(int cell);
+
+	/*!
+	* @brief Get the cells next to a cell.
+	* @param cell The cell.
+	* @param neighbours Set to the neighbours.
+	* @return The number of neighbours, 3 in a corner up to 8 in the middle.
+	*/
+	int getNeighbours(int cell, int neighbours[8]) const;
+
+	/*!
+	* @brief Get the number of columns.
+	* @return The width.
+	*/
+	int getWidth() const { return width; }
+
+	/*!
+	* @brief Get the number of rows.
+	* @return The height.
+	*/
+	int getHeight() const { return height; }
+
+	/*!
+	* @brief Get the number of cells.
+	* @return width * height.
+	*/
+	int getCellCount() const { return width * height; }
+
+	/*!
+	* @brief Get the number of mines.
+	* @return The number of mines.
+	*/
+	int getMineCount() const { return mines; }
+
+	/*!
+	* @brief Get the cell at a column and row.
+	* @param x The column.
+	* @param y The row.
+	* @return The cell.
+	*/
+	int cellAt(int x, int y) const { return y * width + x; }
+
+	/*!
+	* @brief Check if a cell has a mine.
+	* @param cell The cell.
+	* @return true for a mine.
+	*/
+	bool isMine(int cell) const { return (cells[cell] & MINE) != 0; }
+
+	/*!
+	* @brief Check if a cell has been revealed.
+	* @param cell The cell.
+	* @return true if it is revealed.
+	*/
+	bool isRevealed(int cell) const { return (cells[cell] & REVEALED) != 0; }
+
+	/*!
+	* @brief Check if a cell is flagged.
+	* @param cell The cell.
+	* @return true if it is flagged.
+	*/
+	bool isFlagged(int cell) const { return (cells[cell] & FLAGGED) != 0; }
+
+	/*!
+	* @brief Get the number of mines next to a cell.
+	* @param cell The cell.
+	* @return 0 to 8.
+	*/
+	int getAdjacentMines(int cell) const { return cells[cell] & COUNT_MASK; }
+
+	/*!
+	* @brief Check if the mines have been laid.
+	* @return false until the first reveal or setMines.
+	*/
+	bool areMinesLaid() const { return minesLaid; }
+
+	/*!
+	* @brief Get the number of revealed cells.
+	* @return The count.
+	*/
+	int getRevealedCount() const { return revealedCount; }
+
+	/*!
+	* @brief Get the number of flagged cells.
+	* @return The count.
+	*/
+	int getFlagCount() const { return flagCount; }
+
+	/*!
+	* @brief Check if every cell without a mine has been revealed.
+	* @return true if the game is won.
+	*/
+	bool isWon() const { return !lost && revealedCount == getCellCount() - mines; }
+
+	/*!
+	* @brief Check if a mine has been revealed.
+	* @return true if the game is lost.
+	*/
+	bool isLost() const { return lost; }
+};
+
+#endif // MINESWEEPER_BOARD_H
@@ -0,0 +1,849 @@
+#include "minesweeperSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+
+// The log of the number of ways to choose k things from n
+static double logChoose(int n, int k) {
+    return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+}
+
+
+// Scales a vector so its largest value is 1, keeping long chains of products in range
+static void normalise(std::vector<double>& values) {
+    double largest = *std::max_element(values.begin(), values.end());
+    if (largest > 0) {
+        for (double& value : values) {
+            value /= largest;
+        }
+    }
+}
+
+
+// Enumerates the layouts of the component by backtracking, pruning as soon as a constraint cannot be met
+void MinesweeperSolver::enumerate(int position) {
+    if (++nodes > MAX_ENUMERATION_NODES) {
+        aborted = true;
+        return;
+    }
+
+    int size = static_cast<int>(componentCells.size());
+    if (position == size) {
+        int mines = static_cast<int>(mined.size());
+        counts[mines] += 1;
+        for (int minedPosition : mined) {
+            cellCounts[minedPosition * (size + 1) + mines] += 1;
+        }
+        return;
+    }
+
+    int cell = componentCells[position];
+    int first = cellConstraintStart[cell];
+    int last = cellConstraintStart[cell + 1];
+
+    for (int mine = 0; mine <= 1 && !aborted; mine++) {
+        bool possible = true;
+        for (int i = first; i < last; i++) {
+            int constraint = cellConstraints[i];
+            constraintRemaining[constraint] -= mine;
+            constraintLeft[constraint]--;
+            possible = possible && constraintRemaining[constraint] >= 0 && constraintRemaining[constraint] <= constraintLeft[constraint];
+        }
+
+        if (possible) {
+            if (mine) {
+                mined.push_back(position);
+            }
+            enumerate(position + 1);
+            if (mine) {
+                mined.pop_back();
+            }
+        }
+
+        for (int i = first; i < last; i++) {
+            constraintRemaining[cellConstraints[i]] += mine;
+            constraintLeft[cellConstraints[i]]++;
+        }
+    }
+}
+
+
+// Works out what the revealed numbers say about the hidden cells
+void MinesweeperSolver::analyse(const MinesweeperBoard& board, bool trustFlags, const std::vector<int>& numberCells, bool probabilities,
+    MinesweeperAnalysis& analysis) {
+    int cellCount = board.getCellCount();
+    int neighbours[8];
+
+    analysis = MinesweeperAnalysis();
+    if (probabilities) {
+        analysis.mineProbability.assign(cellCount, 0.0);
+    }
+    if (static_cast<int>(frontierIndex.size()) != cellCount) {
+        frontierIndex.assign(cellCount, -1);
+    }
+
+    frontier.clear();
+    constraints.clear();
+    members.clear();
+    undecided.clear();
+    undecidedComponent.clear();
+
+    // Each revealed number with hidden neighbours is a constraint on them
+    for (int cell : numberCells) {
+        if (!board.isRevealed(cell) || board.isMine(cell)) {
+            continue;
+        }
+
+        Constraint constraint = { board.getAdjacentMines(cell), static_cast<int>(members.size()), 0 };
+        int count = board.getNeighbours(cell, neighbours);
+        for (int i = 0; i < count; i++) {
+            int neighbour = neighbours[i];
+            if (board.isRevealed(neighbour)) {
+                continue;
+            }
+            if (trustFlags && board.isFlagged(neighbour)) {
+                constraint.remaining--;
+                continue;
+            }
+
+            if (frontierIndex[neighbour] < 0) {
+                frontierIndex[neighbour] = static_cast<int>(frontier.size());
+                frontier.push_back(neighbour);
+            }
+            members.push_back(frontierIndex[neighbour]);
+            constraint.count++;
+        }
+
+        if (constraint.count > 0) {
+            constraints.push_back(constraint);
+        }
+        else if (constraint.remaining != 0) {
+            analysis.consistent = false;
+        }
+    }
+
+    int frontierSize = static_cast<int>(frontier.size());
+    int constraintCount = static_cast<int>(constraints.size());
+
+    // List each frontier cell's constraints
+    cellConstraintStart.assign(frontierSize + 1, 0);
+    for (int member : members) {
+        cellConstraintStart[member + 1]++;
+    }
+    std::partial_sum(cellConstraintStart.begin(), cellConstraintStart.end(), cellConstraintStart.begin());
+
+    std::vector<int> fill(cellConstraintStart.begin(), cellConstraintStart.end() - 1);
+    cellConstraints.resize(members.size());
+    for (int constraint = 0; constraint < constraintCount; constraint++) {
+        for (int i = 0; i < constraints[constraint].count; i++) {
+            cellConstraints[fill[members[constraints[constraint].first + i]]++] = constraint;
+        }
+    }
+
+    // The simple rules: a number with all its mines found clears the rest, one needing every cell mines them all
+    value.assign(frontierSize, -1);
+    std::vector<int> work(constraintCount);
+    std::iota(work.begin(), work.end(), 0);
+    std::vector<char> inWork(constraintCount, 1);
+
+    while (!work.empty() && analysis.consistent) {
+        int constraint = work.back();
+        work.pop_back();
+        inWork[constraint] = 0;
+
+        const Constraint& current = constraints[constraint];
+        int open = 0, minesFound = 0;
+        for (int i = 0; i < current.count; i++) {
+            int cellValue = value[members[current.first + i]];
+            open += (cellValue < 0);
+            minesFound += (cellValue > 0);
+        }
+
+        int needed = current.remaining - minesFound;
+        if (needed < 0 || needed > open) {
+            analysis.consistent = false;
+            break;
+        }
+        if (open == 0 || (needed != 0 && needed != open)) {
+            continue;
+        }
+
+        for (int i = 0; i < current.count; i++) {
+            int member = members[current.first + i];
+            if (value[member] >= 0) {
+                continue;
+            }
+
+            value[member] = (needed == 0) ? 0 : 1;
+            for (int j = cellConstraintStart[member]; j < cellConstraintStart[member + 1]; j++) {
+                if (!inWork[cellConstraints[j]]) {
+                    inWork[cellConstraints[j]] = 1;
+                    work.push_back(cellConstraints[j]);
+                }
+            }
+        }
+    }
+
+    int decidedCells = 0, decidedMines = 0;
+    for (int index = 0; index < frontierSize && analysis.consistent; index++) {
+        if (value[index] < 0) {
+            continue;
+        }
+
+        decidedCells++;
+        decidedMines += value[index];
+        (value[index] ? analysis.mineCells : analysis.safeCells).push_back(frontier[index]);
+        if (probabilities) {
+            analysis.mineProbability[frontier[index]] = value[index];
+        }
+    }
+
+    // Split the undecided cells into components, each in breadth-first order so constraints close early
+    std::vector<int> order;
+    std::vector<int> componentStart;
+    std::vector<char> seen(frontierSize, 0);
+
+    for (int index = 0; index < frontierSize && analysis.consistent; index++) {
+        if (value[index] >= 0 || seen[index]) {
+            continue;
+        }
+
+        componentStart.push_back(static_cast<int>(order.size()));
+        seen[index] = 1;
+        order.push_back(index);
+        for (size_t head = componentStart.back(); head < order.size(); head++) {
+            int current = order[head];
+            for (int j = cellConstraintStart[current]; j < cellConstraintStart[current + 1]; j++) {
+                const Constraint& constraint = constraints[cellConstraints[j]];
+                for (int i = 0; i < constraint.count; i++) {
+                    int member = members[constraint.first + i];
+                    if (value[member] < 0 && !seen[member]) {
+                        seen[member] = 1;
+                        order.push_back(member);
+                    }
+                }
+            }
+        }
+    }
+    componentStart.push_back(static_cast<int>(order.size()));
+
+    analysis.frontierCells = static_cast<int>(order.size());
+    analysis.components = static_cast<int>(componentStart.size()) - 1;
+
+    // Enumerate each component's layouts, counting them by the number of mines
+    constraintRemaining.assign(constraintCount, 0);
+    constraintLeft.assign(constraintCount, 0);
+    for (int constraint = 0; constraint < constraintCount; constraint++) {
+        constraintRemaining[constraint] = constraints[constraint].remaining;
+        for (int i = 0; i < constraints[constraint].count; i++) {
+            int cellValue = value[members[constraints[constraint].first + i]];
+            constraintRemaining[constraint] -= (cellValue > 0);
+            constraintLeft[constraint] += (cellValue < 0);
+        }
+    }
+
+    std::vector<int> exactComponents;
+    std::vector<int> roughComponents;
+    std::vector<std::vector<double>> componentCounts(analysis.components);
+    std::vector<std::vector<double>> componentCellCounts(analysis.components);
+    int exactCells = 0;
+
+    for (int component = 0; component < analysis.components && analysis.consistent; component++) {
+        int size = componentStart[component + 1] - componentStart[component];
+        analysis.largestComponent = std::max(analysis.largestComponent, size);
+
+        if (size > MAX_COMPONENT_CELLS) {
+            roughComponents.push_back(component);
+            continue;
+        }
+
+        componentCells.assign(order.begin() + componentStart[component], order.begin() + componentStart[component + 1]);
+        counts.assign(size + 1, 0.0);
+        cellCounts.assign(static_cast<size_t>(size) * (size + 1), 0.0);
+        mined.clear();
+        nodes = 0;
+        aborted = false;
+
+        enumerate(0);
+
+        if (aborted) {
+            roughComponents.push_back(component);
+            continue;
+        }
+        if (std::all_of(counts.begin(), counts.end(), [](double count) { return count == 0; })) {
+            analysis.consistent = false;
+            break;
+        }
+
+        exactComponents.push_back(component);
+        componentCounts[component].swap(counts);
+        componentCellCounts[component].swap(cellCounts);
+        exactCells += size;
+    }
+
+    // The interior is every hidden cell whose chance comes only from the mine count
+    int knownMines = trustFlags ? board.getFlagCount() : 0;
+    int hiddenCells = cellCount - board.getRevealedCount() - knownMines;
+    int interior = hiddenCells - decidedCells - exactCells;
+    int remainingMines = board.getMineCount() - knownMines - decidedMines;
+
+    // A layout of the components using k mines leaves C(interior, remainingMines - k) ways to place the rest. Those
+    // weights fall by about the odds of a mine with each extra mine, so across thousands of frontier cells they would
+    // underflow; every layout is weighted by the odds to the power k as well, and the rest divided by the same, which
+    // leaves each product as it was but keeps the numbers near 1
+    int typicalMines = static_cast<int>(static_cast<int64_t>(exactCells) * remainingMines / std::max(1, interior + exactCells));
+    double logOdds = 0;
+    if (remainingMines - typicalMines >= 1 && interior - remainingMines + typicalMines + 1 >= 1) {
+        logOdds = std::log(static_cast<double>(remainingMines - typicalMines) / (interior - remainingMines + typicalMines + 1));
+    }
+
+    std::vector<double> tilt(MAX_COMPONENT_CELLS + 1);
+    for (int k = 0; k <= MAX_COMPONENT_CELLS; k++) {
+        tilt[k] = std::exp(k * logOdds);
+    }
+
+    std::vector<double> weights(exactCells + 1, 0.0);
+    std::vector<double> logWeights(exactCells + 1, -std::numeric_limits<double>::infinity());
+    double largestLog = -std::numeric_limits<double>::infinity();
+    for (int mines = 0; mines <= exactCells; mines++) {
+        int rest = remainingMines - mines;
+        if (rest >= 0 && rest <= interior) {
+            logWeights[mines] = logChoose(interior, rest) - mines * logOdds;
+            largestLog = std::max(largestLog, logWeights[mines]);
+        }
+    }
+    if (largestLog == -std::numeric_limits<double>::infinity()) {
+        analysis.consistent = false;
+    }
+    for (int mines = 0; mines <= exactCells && analysis.consistent; mines++) {
+        weights[mines] = std::exp(logWeights[mines] - largestLog);
+    }
+
+    if (!analysis.consistent) {
+        for (int cell : frontier) {
+            frontierIndex[cell] = -1;
+        }
+        analysis.safeCells.clear();
+        analysis.mineCells.clear();
+        return;
+    }
+
+    // suffix[j][t] is the weight of every layout of components j onwards, given t mines in the components before
+    int componentCount = static_cast<int>(exactComponents.size());
+    std::vector<std::vector<double>> suffix(componentCount + 1);
+    suffix[componentCount] = weights;
+    for (int j = componentCount - 1; j >= 0; j--) {
+        const std::vector<double>& layouts = componentCounts[exactComponents[j]];
+        int size = static_cast<int>(layouts.size()) - 1;
+
+        suffix[j].assign(exactCells + 1, 0.0);
+        for (int t = 0; t + size <= exactCells; t++) {
+            double sum = 0;
+            for (int k = 0; k <= size; k++) {
+                sum += layouts[k] * tilt[k] * suffix[j + 1][t + k];
+            }
+            suffix[j][t] = sum;
+        }
+        normalise(suffix[j]);
+    }
+
+    // Going forwards, prefix[a] is the weight of the components before using a mines
+    std::vector<double> prefix(exactCells + 1, 0.0);
+    std::vector<double> next(exactCells + 1, 0.0);
+    std::vector<double> external;
+    prefix[0] = 1.0;
+    int prefixSpan = 0;
+
+    for (int j = 0; j < componentCount; j++) {
+        int component = exactComponents[j];
+        const std::vector<double>& layoutCounts = componentCounts[component];
+        const std::vector<double>& layoutCellCounts = componentCellCounts[component];
+        int size = static_cast<int>(layoutCounts.size()) - 1;
+
+        // The weight of everything outside the component, for each number of mines inside it
+        external.assign(size + 1, 0.0);
+        for (int k = 0; k <= size; k++) {
+            for (int a = 0; a <= prefixSpan; a++) {
+                external[k] += prefix[a] * suffix[j + 1][a + k];
+            }
+        }
+
+        double total = 0;
+        for (int k = 0; k <= size; k++) {
+            total += layoutCounts[k] * tilt[k] * external[k];
+        }
+        if (total <= 0) {
+            analysis.consistent = false;
+            break;
+        }
+
+        for (int position = 0; position < size; position++) {
+            int cell = frontier[order[componentStart[component] + position]];
+            const double* mineLayouts = &layoutCellCounts[static_cast<size_t>(position) * (size + 1)];
+
+            double mineWeight = 0;
+            bool alwaysSafe = true, alwaysMine = true;
+            for (int k = 0; k <= size; k++) {
+                mineWeight += mineLayouts[k] * tilt[k] * external[k];
+                if (layoutCounts[k] > 0 && external[k] > 0) {
+                    alwaysSafe = alwaysSafe && mineLayouts[k] == 0;
+                    alwaysMine = alwaysMine && mineLayouts[k] == layoutCounts[k];
+                }
+            }
+
+            if (probabilities) {
+                analysis.mineProbability[cell] = mineWeight / total;
+            }
+            if (alwaysSafe) {
+                analysis.safeCells.push_back(cell);
+            }
+            else if (alwaysMine) {
+                analysis.mineCells.push_back(cell);
+            }
+            else {
+                undecided.push_back(cell);
+                undecidedComponent.push_back(component);
+            }
+        }
+
+        // Fold the component into the prefix
+        std::fill(next.begin(), next.end(), 0.0);
+        for (int a = 0; a <= prefixSpan; a++) {
+            for (int k = 0; k <= size; k++) {
+                next[a + k] += prefix[a] * layoutCounts[k] * tilt[k];
+            }
+        }
+        prefix.swap(next);
+        prefixSpan += size;
+        normalise(prefix);
+    }
+
+    // The interior shares whatever mines the components leave
+    double interiorWeight = 0, interiorMines = 0;
+    bool interiorSafe = true, interiorMined = true;
+    for (int mines = 0; mines <= exactCells && analysis.consistent; mines++) {
+        double weight = prefix[mines] * weights[mines];
+        if (weight > 0) {
+            interiorWeight += weight;
+            interiorMines += weight * (remainingMines - mines);
+            interiorSafe = interiorSafe && remainingMines - mines == 0;
+            interiorMined = interiorMined && remainingMines - mines == interior;
+        }
+    }
+    if (interiorWeight <= 0) {
+        analysis.consistent = false;
+    }
+
+    double interiorProbability = (interior > 0 && analysis.consistent) ? interiorMines / interiorWeight / interior : 0.0;
+    bool listInterior = analysis.consistent && interior > 0 && (probabilities || interiorSafe || interiorMined);
+
+    // Components too big to enumerate are given the interior's chance
+    for (int component : roughComponents) {
+        analysis.exact = false;
+        for (int i = componentStart[component]; i < componentStart[component + 1] && analysis.consistent; i++) {
+            frontierIndex[frontier[order[i]]] = -1;
+            if (!listInterior) {
+                undecided.push_back(frontier[order[i]]);
+                undecidedComponent.push_back(component);
+            }
+        }
+    }
+
+    if (listInterior) {
+        for (int cell = 0; cell < cellCount; cell++) {
+            if (board.isRevealed(cell) || (trustFlags && board.isFlagged(cell)) || frontierIndex[cell] >= 0) {
+                continue;
+            }
+
+            if (probabilities) {
+                analysis.mineProbability[cell] = interiorProbability;
+            }
+            if (interiorSafe) {
+                analysis.safeCells.push_back(cell);
+            }
+            else if (interiorMined) {
+                analysis.mineCells.push_back(cell);
+            }
+        }
+    }
+
+    if (probabilities && trustFlags) {
+        for (int cell = 0; cell < cellCount; cell++) {
+            if (board.isFlagged(cell)) {
+                analysis.mineProbability[cell] = 1.0;
+            }
+        }
+    }
+
+    for (int cell : frontier) {
+        frontierIndex[cell] = -1;
+    }
+    if (!analysis.consistent) {
+        analysis.safeCells.clear();
+        analysis.mineCells.clear();
+    }
+}
+
+
+// Works out every hidden cell's chance of a mine from what a player can see
+MinesweeperAnalysis MinesweeperSolver::analyse(const MinesweeperBoard& board) {
+    std::vector<int> numberCells;
+    for (int cell = 0; cell < board.getCellCount(); cell++) {
+        if (board.isRevealed(cell)) {
+            numberCells.push_back(cell);
+        }
+    }
+
+    MinesweeperAnalysis analysis;
+    analyse(board, false, numberCells, true, analysis);
+    return analysis;
+}
+
+
+// Picks a safe cell if there is one, otherwise the one least likely to have a mine
+int MinesweeperSolver::findHint(const MinesweeperBoard& board) {
+    // The first reveal is always safe, and in the middle it opens up the most
+    if (!board.areMinesLaid()) {
+        return board.cellAt(board.getWidth() / 2, board.getHeight() / 2);
+    }
+
+    MinesweeperAnalysis analysis = analyse(board);
+    if (!analysis.safeCells.empty()) {
+        return analysis.safeCells.front();
+    }
+
+    int best = -1;
+    for (int cell = 0; cell < board.getCellCount(); cell++) {
+        if (!board.isRevealed(cell) && (best < 0 || analysis.mineProbability[cell] < analysis.mineProbability[best])) {
+            best = cell;
+        }
+    }
+    return best;
+}
+
+
+// Plays on by deduction alone: the simple rules around each changed number, then the whole frontier when they stall
+int MinesweeperSolver::solveByDeduction(MinesweeperBoard& board, std::mt19937* random) {
+    int cellCount = board.getCellCount();
+    std::vector<int> numberCells;
+    std::vector<int> queue;
+    std::vector<char> queued(cellCount, 0);
+    std::vector<char> target(cellCount, 0);
+    std::vector<int> newlyRevealed;
+    MinesweeperAnalysis analysis;
+    int neighbours[8], around[8];
+    int moves = 0;
+
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (board.isRevealed(cell) && !board.isMine(cell)) {
+            numberCells.push_back(cell);
+            queue.push_back(cell);
+            queued[cell] = 1;
+        }
+    }
+
+    // Queues the revealed neighbours of a cell whose state has changed
+    auto queueAround = [&](int cell) {
+        int count = board.getNeighbours(cell, around);
+        for (int i = 0; i < count; i++) {
+            if (board.isRevealed(around[i]) && !queued[around[i]]) {
+                queued[around[i]] = 1;
+                queue.push_back(around[i]);
+            }
+        }
+    };
+
+    auto revealCell = [&](int cell) {
+        newlyRevealed.clear();
+        if (board.reveal(cell, &newlyRevealed) == MinesweeperBoard::REVEALED_MINE) {
+            return false;
+        }
+        for (int revealed : newlyRevealed) {
+            numberCells.push_back(revealed);
+            if (!queued[revealed]) {
+                queued[revealed] = 1;
+                queue.push_back(revealed);
+            }
+            queueAround(revealed);
+        }
+        return true;
+    };
+
+    auto flagCell = [&](int cell) {
+        if (!board.isFlagged(cell)) {
+            board.toggleFlag(cell);
+            queueAround(cell);
+        }
+    };
+
+    while (!board.isWon()) {
+        // The simple rules first, as they are cheap and settle most cells
+        while (!queue.empty()) {
+            int cell = queue.back();
+            queue.pop_back();
+            queued[cell] = 0;
+
+            int count = board.getNeighbours(cell, neighbours);
+            int hidden = 0, flags = 0;
+            for (int i = 0; i < count; i++) {
+                if (board.isFlagged(neighbours[i])) {
+                    flags++;
+                }
+                else if (!board.isRevealed(neighbours[i])) {
+                    neighbours[hidden++] = neighbours[i];
+                }
+            }
+
+            int needed = board.getAdjacentMines(cell) - flags;
+            if (hidden == 0 || (needed != 0 && needed != hidden)) {
+                continue;
+            }
+
+            for (int i = 0; i < hidden; i++) {
+                if (needed == 0) {
+                    if (!revealCell(neighbours[i])) {
+                        return -1;
+                    }
+                }
+                else {
+                    flagCell(neighbours[i]);
+                }
+            }
+        }
+
+        if (board.isWon()) {
+            break;
+        }
+
+        // Drop the numbers with nothing hidden next to them, then look at the rest together
+        numberCells.erase(std::remove_if(numberCells.begin(), numberCells.end(), [&](int cell) {
+            int count = board.getNeighbours(cell, around);
+            for (int i = 0; i < count; i++) {
+                if (!board.isRevealed(around[i]) && !board.isFlagged(around[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }), numberCells.end());
+
+        analyse(board, true, numberCells, false, analysis);
+        if (!analysis.consistent) {
+            return -1;
+        }
+
+        if (!analysis.safeCells.empty() || !analysis.mineCells.empty()) {
+            for (int cell : analysis.safeCells) {
+                if (!board.isRevealed(cell) && !revealCell(cell)) {
+                    return -1;
+                }
+            }
+            for (int cell : analysis.mineCells) {
+                flagCell(cell);
+            }
+            continue;
+        }
+
+        if (!random) {
+            return -1;
+        }
+
+        // Stuck: clear the mines out of every undecided cell, or out of one hidden cell if none is next to a number.
+        // Some cell is always cleared, as the game is not won yet so some hidden cell is safe
+        std::vector<int> targets = undecided;
+        std::vector<int> targetComponent = undecidedComponent;
+        if (targets.empty()) {
+            for (int cell = 0; cell < cellCount; cell++) {
+                if (!board.isRevealed(cell) && !board.isFlagged(cell)) {
+                    targets.push_back(cell);
+                }
+            }
+            std::uniform_int_distribution<size_t> pick(0, targets.size() - 1);
+            targets = { targets[pick(*random)] };
+            targetComponent = { 0 };
+        }
+
+        int components = *std::max_element(targetComponent.begin(), targetComponent.end()) + 1;
+        std::vector<std::vector<int>> safeTargets(components);
+        for (size_t i = 0; i < targets.size(); i++) {
+            target[targets[i]] = 1;
+            if (!board.isMine(targets[i])) {
+                safeTargets[targetComponent[i]].push_back(targets[i]);
+            }
+        }
+
+        // The mines go to hidden cells with no revealed neighbour when there are any, so no number already seen
+        // changes, or else to any other hidden cell; both are sound, as every deduction is made from the numbers as
+        // they are now
+        auto canTake = [&](int cell, bool awayFromNumbers) {
+            if (board.isRevealed(cell) || board.isFlagged(cell) || board.isMine(cell) || target[cell]) {
+                return false;
+            }
+            int count = awayFromNumbers ? board.getNeighbours(cell, around) : 0;
+            for (int i = 0; i < count; i++) {
+                if (board.isRevealed(around[i])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // With nowhere else left, a component's mines swap into the safe cells of another component, which keeps
+        // its own mines; swapping within a component would only mirror the guess
+        const int GIVING = 1, TAKING = 2;
+        std::vector<int> role(components, 0);
+        int taker = -1;
+
+        std::uniform_int_distribution<int> anyCell(0, cellCount - 1);
+        std::vector<int> destinations;
+        bool scanned = false;
+
+        for (size_t i = 0; i < targets.size(); i++) {
+            int cell = targets[i];
+            int component = targetComponent[i];
+            if (!board.isMine(cell) || role[component] == TAKING) {
+                target[cell] = board.isMine(cell) ? 2 : target[cell];
+                continue;
+            }
+            role[component] = GIVING;
+
+            int destination = -1;
+            for (int tries = 0; tries < 64 && destination < 0; tries++) {
+                int candidate = anyCell(*random);
+                destination = canTake(candidate, true) ? candidate : -1;
+            }
+
+            // Random picks failing means few cells are left, so list them all once, the ones away from numbers last
+            if (destination < 0 && !scanned) {
+                scanned = true;
+                for (int away = 0; away <= 1; away++) {
+                    for (int candidate = 0; candidate < cellCount; candidate++) {
+                        if (canTake(candidate, away != 0) && (away || !canTake(candidate, true))) {
+                            destinations.push_back(candidate);
+                        }
+                    }
+                }
+            }
+            while (destination < 0 && !destinations.empty()) {
+                destination = canTake(destinations.back(), false) ? destinations.back() : -1;
+                destinations.pop_back();
+            }
+
+            if (destination < 0 && (taker < 0 || safeTargets[taker].empty())) {
+                taker = -1;
+                for (int other = components - 1; other >= 0 && taker < 0; other--) {
+                    taker = (role[other] == 0 && !safeTargets[other].empty()) ? other : -1;
+                }
+                if (taker >= 0) {
+                    role[taker] = TAKING;
+                }
+            }
+            if (destination < 0 && taker >= 0) {
+                destination = safeTargets[taker].back();
+                safeTargets[taker].pop_back();
+                target[destination] = 2;
+            }
+
+            // With no hidden cell left to take it, the mine goes into the revealed area, away from any revealed zero
+            // so the first cell's neighbours stay clear. The game no longer makes sense, so this play ends here and
+            // the layout is replayed from the start
+            if (destination < 0) {
+                auto nextToZero = [&](int candidate) {
+                    int count = board.getNeighbours(candidate, around);
+                    for (int j = 0; j < count; j++) {
+                        if (board.isRevealed(around[j]) && !board.isMine(around[j]) && board.getAdjacentMines(around[j]) == 0) {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                for (int candidate = 0; candidate < cellCount; candidate++) {
+                    if (board.isRevealed(candidate) && !board.isMine(candidate) && board.getAdjacentMines(candidate) > 0 &&
+                        !nextToZero(candidate)) {
+                        destinations.push_back(candidate);
+                    }
+                }
+                if (destinations.empty()) {
+                    return -1;
+                }
+
+                std::uniform_int_distribution<size_t> pick(0, destinations.size() - 1);
+                board.moveMine(cell, destinations[pick(*random)]);
+                for (int other : targets) {
+                    target[other] = 0;
+                }
+                return moves + 1;
+            }
+
+            board.moveMine(cell, destination);
+        }
+
+        for (int cell : targets) {
+            bool clear = target[cell] == 1;
+            target[cell] = 0;
+            queueAround(cell);
+            if (clear && !board.isRevealed(cell) && !revealCell(cell)) {
+                return -1;
+            }
+        }
+        moves++;
+    }
+
+    return moves;
+}
+
+
+// Checks if deduction alone clears a board from its first cell
+bool MinesweeperSolver::isSolvableWithoutGuessing(const MinesweeperBoard& board, int firstCell) {
+    MinesweeperBoard play = board;
+
+    if (play.reveal(firstCell) == MinesweeperBoard::REVEALED_MINE) {
+        return false;
+    }
+    return solveByDeduction(play) == 0 && play.isWon();
+}
+
+
+// Constructor for the MinesweeperGenerator class
+MinesweeperGenerator::MinesweeperGenerator(uint32_t seed) : random(seed) {
+}
+
+
+// Generates a board, replaying and repairing the layout until it needs no guesses
+MinesweeperBoard MinesweeperGenerator::generate(int width, int height, int mines, int firstCell, bool noGuessing) {
+    MinesweeperBoard board(width, height, mines, random());
+
+    for (int attempt = 0; attempt < ATTEMPTS; attempt++) {
+        board = MinesweeperBoard(width, height, mines, random());
+        board.layMines(firstCell);
+        if (!noGuessing) {
+            return board;
+        }
+
+        for (int pass = 0; pass < MAX_PASSES; pass++) {
+            MinesweeperBoard play = board;
+            play.reveal(firstCell);
+
+            int moves = solver.solveByDeduction(play, &random);
+            if (moves == 0) {
+                return board;
+            }
+            if (moves < 0) {
+                break;
+            }
+
+            // Replay the repaired layout from the start
+            std::vector<int> mineCells;
+            for (int cell = 0; cell < play.getCellCount(); cell++) {
+                if (play.isMine(cell)) {
+                    mineCells.push_back(cell);
+                }
+            }
+            board.setMines(mineCells);
+        }
+    }
+
+    return board;
+}
@@ -0,0 +1,164 @@
+#ifndef MINESWEEPER_SOLVER_H
+#define MINESWEEPER_SOLVER_H
+
+/*!
+* @file minesweeperSolver.h
+* @brief Contains the declaration of the Minesweeper solver, which works out mine probabilities, and the generator
+* @brief of boards that can be cleared without guessing.
+*/
+
+#include "minesweeperBoard.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*!
+* @struct MinesweeperAnalysis
+* @brief What the revealed numbers say about the hidden cells.
+*/
+struct MinesweeperAnalysis {
+	std::vector<double> mineProbability; /*!< Each cell's chance of having a mine, 0 for revealed cells; empty if not asked for. */
+	std::vector<int> safeCells; /*!< Hidden cells that cannot have a mine. */
+	std::vector<int> mineCells; /*!< Hidden cells that must have a mine. */
+	int frontierCells = 0; /*!< Hidden cells next to a number that the simple rules could not settle. */
+	int components = 0; /*!< The number of independent groups those cells fall into. */
+	int largestComponent = 0; /*!< The number of cells in the largest group. */
+	bool exact = true; /*!< false if a group was too big to enumerate, so its cells were given the average chance. */
+	bool consistent = true; /*!< false if no layout of mines fits the numbers. */
+};
+
+/*!
+* @class MinesweeperSolver
+* @brief Works out exactly how likely each hidden cell is to have a mine, from the revealed numbers and the mine count.
+* @details Each revealed number is a constraint: its hidden neighbours hold exactly that many mines. The simple rules
+* @details (a number already satisfied clears the rest of its neighbours, a number needing all of them mines them all)
+* @details settle most cells. What is left splits into components, groups of cells linked by sharing a constraint,
+* @details and every layout of each component is enumerated by backtracking, counting the layouts by how many mines
+* @details they use. The cells next to no number share the remaining mines, so a layout using k mines is weighted by
+* @details the number of ways, C(interior, remaining - k), to place the rest; combining the components' counts with
+* @details those weights gives each cell's exact chance of a mine.
+*/
+class MinesweeperSolver {
+public:
+	static const int MAX_COMPONENT_CELLS = 256; /*!< Components bigger than this are not enumerated. */
+	static const uint64_t MAX_ENUMERATION_NODES = 1 << 22; /*!< Give up enumerating a component after this many steps. */
+
+private:
+	/*!
+	* @struct Constraint
+	* @brief A revealed number: its hidden neighbours, which are cells of the frontier, hold this many mines.
+	*/
+	struct Constraint {
+		int remaining; /*!< The number of mines among the hidden neighbours. */
+		int first; /*!< Where the neighbours start in members. */
+		int count; /*!< The number of hidden neighbours. */
+	};
+
+	std::vector<int> frontierIndex; /*!< Each cell's place in frontier, or -1. */
+	std::vector<int> frontier; /*!< The hidden cells next to a revealed number. */
+	std::vector<Constraint> constraints; /*!< The revealed numbers with hidden neighbours. */
+	std::vector<int> members; /*!< The frontier cells of every constraint, one after another. */
+	std::vector<int> cellConstraintStart; /*!< Where each frontier cell's constraints start in cellConstraints. */
+	std::vector<int> cellConstraints; /*!< The constraints of every frontier cell, one after another. */
+	std::vector<int> value; /*!< Each frontier cell's value: -1 undecided, 0 safe or 1 mine. */
+	std::vector<int> undecided; /*!< The frontier cells the last analysis could not decide. */
+	std::vector<int> undecidedComponent; /*!< The component of each of those cells. */
+
+	std::vector<int> componentCells; /*!< The frontier cells of the component being enumerated, in search order. */
+	std::vector<int> constraintRemaining; /*!< Each constraint's mines still to place in the enumeration. */
+	std::vector<int> constraintLeft; /*!< Each constraint's cells still to decide in the enumeration. */
+	std::vector<int> mined; /*!< The positions in the component given mines so far. */
+	std::vector<double> counts; /*!< The number of layouts of the component by how many mines they use. */
+	std::vector<double> cellCounts; /*!< For each cell of the component, the number of those layouts mining it. */
+	uint64_t nodes; /*!< The steps taken enumerating the component. */
+	bool aborted; /*!< Whether the component was too big to enumerate. */
+
+	/*!
+	* @brief Enumerate the layouts of the component from a position on, counting them.
+	* @param position The position in componentCells to decide next.
+	*/
+	void enumerate(int position);
+
+	/*!
+	* @brief Work out what the revealed numbers say about the hidden cells.
+	* @param board The board.
+	* @param trustFlags Whether flagged cells are known to have mines, as when the solver flagged them itself.
+	* @param numberCells The revealed cells to take constraints from; cells with no hidden neighbours are left out.
+	* @param probabilities Whether to work out every cell's probability, rather than only which cells are certain.
+	* @param analysis Set to the results.
+	*/
+	void analyse(const MinesweeperBoard& board, bool trustFlags, const std::vector<int>& numberCells, bool probabilities,
+		MinesweeperAnalysis& analysis);
+
+public:
+	/*!
+	* @brief Work out how likely each hidden cell is to have a mine, from what a player can see.
+	* @details The player's flags are not trusted, as they may be wrong.
+	* @param board The board.
+	* @return The probabilities and the cells that are certain.
+	*/
+	MinesweeperAnalysis analyse(const MinesweeperBoard& board);
+
+	/*!
+	* @brief Pick the cell to reveal next: a safe one if there is one, otherwise the one least likely to have a mine.
+	* @param board The board.
+	* @return The cell, or -1 if no hidden cells are left.
+	*/
+	int findHint(const MinesweeperBoard& board);
+
+	/*!
+	* @brief Play a board on from its revealed cells by deduction alone, flagging the mines it finds.
+	* @details With random numbers, whenever the deductions run out it moves the mines out of every cell it cannot
+	* @details decide, to hidden cells away from the revealed area, and carries on. A mine with no hidden cell left to
+	* @details take it goes into the revealed area instead, and the play stops there to be replayed.
+	* @param board The board, which is played on.
+	* @param random The random numbers for moving mines, or null to stop when the deductions run out.
+	* @return The number of times mines were moved, or -1 if the solver got stuck.
+	*/
+	int solveByDeduction(MinesweeperBoard& board, std::mt19937* random = nullptr);
+
+	/*!
+	* @brief Check if a board can be cleared from a first cell without ever guessing.
+	* @param board The board; if its mines are not laid yet they are laid around the first cell.
+	* @param firstCell The first cell revealed.
+	* @return true if deduction alone clears the board.
+	*/
+	bool isSolvableWithoutGuessing(const MinesweeperBoard& board, int firstCell);
+};
+
+/*!
+* @class MinesweeperGenerator
+* @brief Generates boards, optionally ones that can be cleared from the first cell without guessing.
+* @details A no-guess board starts as a random one. It is played by deduction, and each time the deductions run out
+* @details the mines are moved out of the cells that could not be decided. As moving mines changes numbers already
+* @details used, the new layout is played again from the start, until a game needs no mines moved.
+*/
+class MinesweeperGenerator {
+private:
+	static const int ATTEMPTS = 20; /*!< How many random layouts to try. */
+	static const int MAX_PASSES = 50; /*!< How many times to replay a layout before trying another. */
+
+	std::mt19937 random; /*!< The random numbers. */
+	MinesweeperSolver solver; /*!< The solver playing each layout. */
+
+public:
+	/*!
+	* @brief Constructor for MinesweeperGenerator.
+	* @param seed The random seed, so the same seed generates the same boards.
+	*/
+	explicit MinesweeperGenerator(uint32_t seed = std::random_device()());
+
+	/*!
+	* @brief Generate a board with its mines laid and nothing revealed.
+	* @param width The number of columns.
+	* @param height The number of rows.
+	* @param mines The number of mines.
+	* @param firstCell The cell the player will reveal first, which is kept clear along with its neighbours.
+	* @param noGuessing Whether the board must be clearable from the first cell without guessing.
+	* @return The board; if no attempt managed a no-guess layout, the last one tried.
+	* @throws runtime_error if the size or mine count is impossible.
+	*/
+	MinesweeperBoard generate(int width, int height, int mines, int firstCell, bool noGuessing);
+};
+
+#endif // MINESWEEPER_SOLVER_H
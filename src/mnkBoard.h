@@ -0,0 +1,549 @@
+#ifndef MNK_BOARD_H
+#define MNK_BOARD_H
+
+/*!
+* @file mnkBoard.h
+* @brief Contains the MnkBoard class template, the board of any m,n,k-game: Naughts and Crosses, Connect 4, Gomoku
+* @brief and their bigger variants.
+* @details Cells are numbered row by row from the top left, so cell = y * width + x. Players are 1 and 2, and 0 is an
+* @details empty cell.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+/*!
+* @class MnkBoard
+* @brief A board M cells wide and N high where the first to get K in a row wins, with stones dropping down the
+* @brief columns when Gravity is on.
+* @details Besides the cells, each player's stones are kept as bit masks along every row, column and diagonal, one bit
+* @details per cell. A win can only come from the last stone placed, so checking for one looks at the four lines
+* @details through it, and finds K bits in a row in each with a handful of shifts and ands, however long the line.
+*
+* @tparam M The number of columns, up to 32.
+* @tparam N The number of rows, up to 32.
+* @tparam K The number in a row needed to win.
+* @tparam Gravity Whether stones drop to the lowest empty cell of a column, as in Connect 4.
+*/
+template <int M, int N, int K, bool Gravity>
+class MnkBoard {
+	static_assert(M >= 1 && M <= 32 && N >= 1 && N <= 32, "Every line of an MnkBoard must fit in 32 bits");
+	static_assert(K >= 1 && (K <= M || K <= N), "K in a row must fit on the board");
+
+public:
+	static const int WIDTH = M; /*!< The number of columns. */
+	static const int HEIGHT = N; /*!< The number of rows. */
+	static const int CELLS = M * N; /*!< The number of cells. */
+	static const int WIN_LENGTH = K; /*!< The number in a row needed to win. */
+	static const bool GRAVITY = Gravity; /*!< Whether stones drop down the columns. */
+	static const int DIAGONALS = M + N - 1; /*!< The number of diagonals in each direction. */
+
+private:
+	uint8_t cells[CELLS]; /*!< Each cell's player, or 0 if empty. */
+	uint32_t rows[3][N]; /*!< Each player's stones along each row, bit x for column x. */
+	uint32_t columns[3][M]; /*!< Each player's stones down each column, bit y for row y. */
+	uint32_t diagonals[3][DIAGONALS]; /*!< Each player's stones along each down-right diagonal x - y + N - 1, bit x. */
+	uint32_t antiDiagonals[3][DIAGONALS]; /*!< Each player's stones along each down-left diagonal x + y, bit x. */
+	int history[CELLS]; /*!< The cells played by makeMove, in order. */
+	int moveCount; /*!< The number of moves in history. */
+	int stoneCount; /*!< The number of stones on the board. */
+	int turn; /*!< The player to move. */
+	int winner; /*!< The player who won with the last move, or 0. */
+	uint64_t hash; /*!< The Zobrist hash of the stones and the player to move. */
+
+	/*!
+	* @struct Tables
+	* @brief The tables shared by every board of this size.
+	*/
+	struct Tables {
+		uint64_t keys[2 * CELLS + 1]; /*!< The random keys for hashing, one per cell and player, then the player to move. */
+		int centreOrder[CELLS]; /*!< Every cell by distance from the middle, so the likelier good moves come first. */
+		int symmetries[8][CELLS]; /*!< For each symmetry of the board, the cell each cell is carried to. */
+	};
+
+	/*!
+	* @brief Get the tables, built the first time they are needed.
+	* @return The tables, the same every run.
+	*/
+	static const Tables& tables() {
+		static const Tables built = [] {
+			Tables table;
+			std::mt19937_64 random(0x6D6E6BULL + CELLS * 31 + K);
+			for (uint64_t& key : table.keys) {
+				key = random();
+			}
+
+			for (int cell = 0; cell < CELLS; cell++) {
+				table.centreOrder[cell] = cell;
+			}
+			auto distance = [](int cell) {
+				int dx = 2 * (cell % M) - (M - 1);
+				int dy = 2 * (cell / M) - (N - 1);
+				return dx * dx + dy * dy;
+			};
+			std::stable_sort(table.centreOrder, table.centreOrder + CELLS, [&](int a, int b) { return distance(a) < distance(b); });
+
+			// The mirrors and half turn, then on a square board the quarter turns and the diagonal mirrors
+			for (int cell = 0; cell < CELLS; cell++) {
+				int x = cell % M;
+				int y = cell / M;
+				table.symmetries[0][cell] = cell;
+				table.symmetries[1][cell] = y * M + (M - 1 - x);
+				table.symmetries[2][cell] = (N - 1 - y) * M + x;
+				table.symmetries[3][cell] = (N - 1 - y) * M + (M - 1 - x);
+				table.symmetries[4][cell] = (M == N) ? x * M + y : cell;
+				table.symmetries[5][cell] = (M == N) ? x * M + (N - 1 - y) : cell;
+				table.symmetries[6][cell] = (M == N) ? (M - 1 - x) * M + y : cell;
+				table.symmetries[7][cell] = (M == N) ? (M - 1 - x) * M + (N - 1 - y) : cell;
+			}
+			return table;
+		}();
+		return built;
+	}
+
+	/*!
+	* @brief Add or take away a stone in every mask and the hash.
+	* @param cell The cell.
+	* @param player The stone's player.
+	*/
+	void toggleStone(int cell, int player) {
+		int x = cell % M;
+		int y = cell / M;
+		rows[player][y] ^= 1u << x;
+		columns[player][x] ^= 1u << y;
+		diagonals[player][x - y + N - 1] ^= 1u << x;
+		antiDiagonals[player][x + y] ^= 1u << x;
+		hash ^= tables().keys[(player - 1) * CELLS + cell];
+	}
+
+	/*!
+	* @brief Check if a line mask has K bits in a row, halving the shifts needed by doubling the run each time.
+	* @param bits The line mask.
+	* @return true if it has K in a row.
+	*/
+	static bool hasRun(uint32_t bits) {
+		int run = 1;
+		while (bits && run * 2 <= K) {
+			bits &= bits >> run;
+			run *= 2;
+		}
+		if (run < K) {
+			bits &= bits >> (K - run);
+		}
+		return bits != 0;
+	}
+
+public:
+	/*!
+	* @brief Constructor for MnkBoard, creates an empty board with player 1 to move.
+	*/
+	MnkBoard() {
+		clear();
+	}
+
+	/*!
+	* @brief Empty the board and give player 1 the move.
+	*/
+	void clear() {
+		for (int cell = 0; cell < CELLS; cell++) {
+			cells[cell] = 0;
+		}
+		for (int player = 0; player < 3; player++) {
+			for (int y = 0; y < N; y++) {
+				rows[player][y] = 0;
+			}
+			for (int x = 0; x < M; x++) {
+				columns[player][x] = 0;
+			}
+			for (int d = 0; d < DIAGONALS; d++) {
+				diagonals[player][d] = 0;
+				antiDiagonals[player][d] = 0;
+			}
+		}
+		moveCount = 0;
+		stoneCount = 0;
+		turn = 1;
+		winner = 0;
+		hash = 0;
+	}
+
+	/*!
+	* @brief Get the player in a cell.
+	* @param x The column.
+	* @param y The row, 0 at the top.
+	* @return 1 or 2, or 0 if empty.
+	*/
+	int get(int x, int y) const { return cells[y * M + x]; }
+
+	/*!
+	* @brief Get the player in a cell.
+	* @param cell The cell.
+	* @return 1 or 2, or 0 if empty.
+	*/
+	int getCell(int cell) const { return cells[cell]; }
+
+	/*!
+	* @brief Get the player to move.
+	* @return 1 or 2.
+	*/
+	int getTurn() const { return turn; }
+
+	/*!
+	* @brief Give the move to a player.
+	* @param player 1 or 2.
+	*/
+	void setTurn(int player) {
+		if (player != turn) {
+			hash ^= tables().keys[2 * CELLS];
+			turn = player;
+		}
+	}
+
+	/*!
+	* @brief Get the number of stones on the board.
+	* @return The count.
+	*/
+	int getStoneCount() const { return stoneCount; }
+
+	/*!
+	* @brief Get the number of moves that can be undone.
+	* @return The count.
+	*/
+	int getMoveCount() const { return moveCount; }
+
+	/*!
+	* @brief Get the last move made.
+	* @return The cell, or -1 if there is none to undo.
+	*/
+	int getLastMove() const { return moveCount ? history[moveCount - 1] : -1; }
+
+	/*!
+	* @brief Get the player who won with the last move.
+	* @return 1 or 2, or 0 if the last move did not win.
+	*/
+	int getWinner() const { return winner; }
+
+	/*!
+	* @brief Check if every cell is taken.
+	* @return true if the board is full.
+	*/
+	bool isFull() const { return stoneCount == CELLS; }
+
+	/*!
+	* @brief Get the Zobrist hash of the position.
+	* @return The hash, which includes the player to move.
+	*/
+	uint64_t getHash() const { return hash; }
+
+	/*!
+	* @brief Get a hash that is the same for the position and every rotation and reflection of it.
+	* @details Square boards have eight symmetries and other boards four, but with gravity only the left to right mirror
+	* @details keeps the stones resting on the bottom. The smallest Zobrist hash over them is taken, so a search keyed by
+	* @details it finds a position it has seen before turned or mirrored. Each call looks at every cell once per symmetry.
+	* @param symmetry Set to the symmetry that turns this position into the one the hash is of.
+	* @return The hash, which includes the player to move.
+	*/
+	uint64_t getCanonicalHash(int& symmetry) const {
+		const int count = Gravity ? 2 : ((M == N) ? 8 : 4);
+		const Tables& table = tables();
+		uint64_t best = hash;
+		symmetry = 0;
+		for (int turning = 1; turning < count; turning++) {
+			const int* target = table.symmetries[turning];
+			uint64_t turned = (turn == 1) ? 0 : table.keys[2 * CELLS];
+			for (int cell = 0; cell < CELLS; cell++) {
+				if (cells[cell]) {
+					turned ^= table.keys[(cells[cell] - 1) * CELLS + target[cell]];
+				}
+			}
+			if (turned < best) {
+				best = turned;
+				symmetry = turning;
+			}
+		}
+		return best;
+	}
+
+	/*!
+	* @brief Get the cell a cell is carried to by a symmetry of the board.
+	* @param symmetry The symmetry, as set by getCanonicalHash.
+	* @param cell The cell.
+	* @return The cell it is carried to.
+	*/
+	static int turnCell(int symmetry, int cell) { return tables().symmetries[symmetry][cell]; }
+
+	/*!
+	* @brief Get the cell a symmetry of the board carries to a cell, undoing turnCell.
+	* @param symmetry The symmetry, as set by getCanonicalHash.
+	* @param cell The cell it is carried to.
+	* @return The cell.
+	*/
+	static int unturnCell(int symmetry, int cell) {
+		// Each symmetry undoes itself but for the two quarter turns, which undo each other
+		static const int inverse[8] = { 0, 1, 2, 3, 4, 6, 5, 7 };
+		return tables().symmetries[inverse[symmetry]][cell];
+	}
+
+	/*!
+	* @brief Get the cell a stone dropped down a column lands in.
+	* @param column The column.
+	* @return The lowest empty cell above the stones in the column, or -1 if the column is full.
+	*/
+	int dropCell(int column) const {
+		if (column < 0 || column >= M || cells[column]) {
+			return -1;
+		}
+		int y = 0;
+		while (y + 1 < N && !cells[(y + 1) * M + column]) {
+			y++;
+		}
+		return y * M + column;
+	}
+
+	/*!
+	* @brief Check if the player to move can play in a cell.
+	* @param cell The cell.
+	* @return true if the cell is on the board, empty, and with gravity on, where a stone in its column would land.
+	*/
+	bool isLegal(int cell) const {
+		if (cell < 0 || cell >= CELLS || cells[cell] || winner) {
+			return false;
+		}
+		return !Gravity || dropCell(cell % M) == cell;
+	}
+
+	/*!
+	* @brief Place a stone for the player to move and pass the move on. The move must be legal.
+	* @param cell The cell.
+	*/
+	void makeMove(int cell) {
+		cells[cell] = static_cast<uint8_t>(turn);
+		toggleStone(cell, turn);
+		stoneCount++;
+		history[moveCount++] = cell;
+		winner = isWin(cell) ? turn : 0;
+		setTurn(3 - turn);
+	}
+
+	/*!
+	* @brief Take back the last move made.
+	*/
+	void undoMove() {
+		int cell = history[--moveCount];
+		setTurn(3 - turn);
+		toggleStone(cell, turn);
+		cells[cell] = 0;
+		stoneCount--;
+		winner = 0;
+	}
+
+	/*!
+	* @brief Put a stone in a cell, or empty it, without taking a turn; for setting up positions.
+	* @details The moves made so far can no longer be undone.
+	* @param cell The cell.
+	* @param player 1 or 2, or 0 to empty the cell.
+	*/
+	void setCell(int cell, int player) {
+		if (cells[cell]) {
+			toggleStone(cell, cells[cell]);
+			stoneCount--;
+		}
+		cells[cell] = static_cast<uint8_t>(player);
+		if (player) {
+			toggleStone(cell, player);
+			stoneCount++;
+		}
+		moveCount = 0;
+		winner = (player && isWin(cell)) ? player : 0;
+	}
+
+	/*!
+	* @brief Check if the stone in a cell is part of K in a row, looking only at the four lines through it.
+	* @param cell The cell.
+	* @return true if it is.
+	*/
+	bool isWin(int cell) const {
+		int player = cells[cell];
+		if (!player) {
+			return false;
+		}
+
+		int x = cell % M;
+		int y = cell / M;
+		return hasRun(rows[player][y]) || hasRun(columns[player][x]) || hasRun(diagonals[player][x - y + N - 1]) ||
+			hasRun(antiDiagonals[player][x + y]);
+	}
+
+	/*!
+	* @brief Get the moves the player to move can make.
+	* @details With gravity, one per column that is not full, the middle columns first. Without it, every empty cell
+	* @details nearest the middle first, except that on boards of more than 49 cells only the cells within two of a
+	* @details stone are worth trying.
+	* @param moves Set to the cells.
+	* @return The number of moves, 0 if the game is over.
+	*/
+	int generateMoves(int moves[CELLS]) const {
+		int count = 0;
+		if (winner) {
+			return 0;
+		}
+
+		if (Gravity) {
+			for (int i = 0; i < M; i++) {
+				int column = M / 2 + ((i % 2) ? (i + 1) / 2 : -(i / 2));
+				if (column >= 0 && column < M && dropCell(column) >= 0) {
+					moves[count++] = dropCell(column);
+				}
+			}
+			return count;
+		}
+
+		if (CELLS > 49 && stoneCount == 0) {
+			moves[count++] = (N / 2) * M + M / 2;
+			return count;
+		}
+
+		const int* order = tables().centreOrder;
+		for (int i = 0; i < CELLS; i++) {
+			int cell = order[i];
+			if (!cells[cell] && (CELLS <= 49 || hasStoneNear(cell % M, cell / M, 2))) {
+				moves[count++] = cell;
+			}
+		}
+		return count;
+	}
+
+	/*!
+	* @brief Check if any stone is within a distance of a cell.
+	* @param x The column.
+	* @param y The row.
+	* @param distance How far to look, in rows and columns.
+	* @return true if there is a stone that near.
+	*/
+	bool hasStoneNear(int x, int y, int distance) const {
+		int low = (x - distance < 0) ? 0 : x - distance;
+		int high = (x + distance >= M) ? M - 1 : x + distance;
+		uint32_t window = ((high - low + 1 >= 32) ? ~0u : ((1u << (high - low + 1)) - 1)) << low;
+
+		for (int row = y - distance; row <= y + distance; row++) {
+			if (row >= 0 && row < N && ((rows[1][row] | rows[2][row]) & window)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	* @brief Get the stretch of a line around a cell, as bit masks of a player's stones and of the cells blocked to them.
+	* @param cell The cell, which is bit radius of both masks.
+	* @param direction 0 along the row, 1 down the column, 2 along the down-right diagonal, 3 along the down-left one.
+	* @param player The player.
+	* @param radius How far either side of the cell to look, up to 15.
+	* @param own Set to the player's stones, bit i for the cell i - radius steps along the line.
+	* @param blocked Set to the other player's stones and the cells off the board.
+	*/
+	void lineWindow(int cell, int direction, int player, int radius, uint32_t& own, uint32_t& blocked) const {
+		int x = cell % M;
+		int y = cell / M;
+		uint32_t mine, theirs;
+		int position = x, low = 0, high = M - 1;
+
+		if (direction == 0) {
+			mine = rows[player][y];
+			theirs = rows[3 - player][y];
+		}
+		else if (direction == 1) {
+			mine = columns[player][x];
+			theirs = columns[3 - player][x];
+			position = y;
+			high = N - 1;
+		}
+		else {
+			int d = (direction == 2) ? x - y + N - 1 : x + y;
+			mine = (direction == 2) ? diagonals[player][d] : antiDiagonals[player][d];
+			theirs = (direction == 2) ? diagonals[3 - player][d] : antiDiagonals[3 - player][d];
+			low = (d - N + 1 > 0) ? d - N + 1 : 0;
+			high = (d < M - 1) ? d : M - 1;
+		}
+
+		uint64_t width = (static_cast<uint64_t>(1) << (2 * radius + 1)) - 1;
+		uint64_t onBoard = ((static_cast<uint64_t>(1) << (high - low + 1)) - 1) << low;
+		own = static_cast<uint32_t>(((static_cast<uint64_t>(mine) << radius) >> position) & width);
+		blocked = static_cast<uint32_t>((((static_cast<uint64_t>(theirs) << radius) >> position) | ~((onBoard << radius) >> position)) & width);
+	}
+
+	/*!
+	* @brief Score the position for the player to move by its open lines.
+	* @details Every stretch of K cells holding stones of only one player counts for that player, four times as much
+	* @details for each stone in it, so the score favours many lines that are well on the way to K.
+	* @return The score, positive when the player to move is ahead.
+	*/
+	int evaluate() const {
+		int score = 0;
+		for (int y = 0; y < N; y++) {
+			score += scoreLine(rows[1][y], rows[2][y], 0, M - 1);
+		}
+		for (int x = 0; x < M; x++) {
+			score += scoreLine(columns[1][x], columns[2][x], 0, N - 1);
+		}
+		for (int d = 0; d < DIAGONALS; d++) {
+			// The down-right diagonal x - y = d - N + 1 runs from x = max(0, d - N + 1) to min(M - 1, d)
+			int low = (d - N + 1 > 0) ? d - N + 1 : 0;
+			int high = (d < M - 1) ? d : M - 1;
+			score += scoreLine(diagonals[1][d], diagonals[2][d], low, high);
+
+			// The down-left diagonal x + y = d runs from x = max(0, d - N + 1) to min(M - 1, d) too
+			score += scoreLine(antiDiagonals[1][d], antiDiagonals[2][d], low, high);
+		}
+		return (turn == 1) ? score : -score;
+	}
+
+private:
+	/*!
+	* @brief Score every stretch of K cells along a line for player 1.
+	* @param one Player 1's stones along the line.
+	* @param two Player 2's stones along the line.
+	* @param low The first bit of the line on the board.
+	* @param high The last bit of the line on the board.
+	* @return The score.
+	*/
+	static int scoreLine(uint32_t one, uint32_t two, int low, int high) {
+		if (!(one | two) || high - low + 1 < K) {
+			return 0;
+		}
+
+		int score = 0;
+		uint32_t window = (K >= 32) ? ~0u : ((1u << K) - 1);
+		for (int start = low; start + K - 1 <= high; start++) {
+			uint32_t mine = one & (window << start);
+			uint32_t theirs = two & (window << start);
+			if (mine && !theirs) {
+				score += 1 << (2 * (std::min(popCount(mine), 15) - 1));
+			}
+			else if (theirs && !mine) {
+				score -= 1 << (2 * (std::min(popCount(theirs), 15) - 1));
+			}
+		}
+		return score;
+	}
+
+	/*!
+	* @brief Count the bits set in a mask.
+	* @param bits The mask.
+	* @return The count.
+	*/
+	static int popCount(uint32_t bits) {
+		int count = 0;
+		for (; bits; bits &= bits - 1) {
+			count++;
+		}
+		return count;
+	}
+};
+
+typedef MnkBoard<3, 3, 3, false> NaughtsAndCrossesBoard; /*!< Naughts and Crosses. */
+typedef MnkBoard<7, 6, 4, true> Connect4Board; /*!< Connect 4. */
+typedef MnkBoard<15, 15, 5, false> GomokuBoard; /*!< Gomoku on the usual 15 by 15 board. */
+
+#endif // MNK_BOARD_H
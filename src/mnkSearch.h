@@ -0,0 +1,353 @@
+#ifndef MNK_SEARCH_H
+#define MNK_SEARCH_H
+
+/*!
+* @file mnkSearch.h
+* @brief Contains the MnkSearch class template, a negamax search with alpha-beta pruning and a transposition table
+* @brief for any MnkBoard.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*!
+* @struct MnkBoardPolicy
+* @brief The moves and evaluation MnkSearch uses by default: the board's own.
+*
+* @tparam Board An MnkBoard.
+*/
+template <class Board>
+struct MnkBoardPolicy {
+	/*!
+	* @brief Get the moves to search.
+	* @param board The board.
+	* @param moves Set to the moves, best first.
+	* @return The number of moves.
+	*/
+	static int generateMoves(const Board& board, int* moves) { return board.generateMoves(moves); }
+
+	/*!
+	* @brief Score a position at the depth limit.
+	* @param board The board.
+	* @return The score for the player to move.
+	*/
+	static int evaluate(const Board& board) { return board.evaluate(); }
+
+	/*!
+	* @brief Get the key a position is kept under in the transposition table.
+	* @param board The board.
+	* @param symmetry Set to the symmetry of the board the key is for, which for the board's own hash is none.
+	* @return The board's Zobrist hash.
+	*/
+	static uint64_t hash(const Board& board, int& symmetry) {
+		symmetry = 0;
+		return board.getHash();
+	}
+};
+
+/*!
+* @struct MnkSymmetricPolicy
+* @brief The board's own moves and evaluation, with positions kept under a key shared by all their rotations and
+* @brief reflections, so a position is searched once however it is turned.
+* @details Working out the key looks at every cell for each symmetry, which pays on the small boards where the same
+* @details shapes come up turned many times over, but not on the large ones.
+*
+* @tparam Board An MnkBoard.
+*/
+template <class Board>
+struct MnkSymmetricPolicy : MnkBoardPolicy<Board> {
+	/*!
+	* @brief Get the key a position is kept under in the transposition table.
+	* @param board The board.
+	* @param symmetry Set to the symmetry that turns the board into the position the key is for.
+	* @return The board's canonical hash.
+	*/
+	static uint64_t hash(const Board& board, int& symmetry) { return board.getCanonicalHash(symmetry); }
+};
+
+/*!
+* @class MnkSearch
+* @brief Finds the best move on an m,n,k-game board by iterative deepening negamax.
+* @details Scores are from the side to move's view. A win scores WIN_SCORE less the number of moves to reach it, so
+* @details quicker wins are preferred and slower losses; below the depth limit the board's own evaluation is used.
+* @details Positions are kept in a transposition table by the policy's hash, which both cuts off positions reached by
+* @details different orders of the same moves and puts the best move found last time first.
+*
+* @tparam Board An MnkBoard.
+* @tparam Policy Where the moves to search, the evaluation and the table key come from, so a game can prune and order
+* @tparam Policy its own.
+*/
+template <class Board, class Policy = MnkBoardPolicy<Board>>
+class MnkSearch {
+public:
+	static const int WIN_SCORE = 1000000; /*!< The score of winning at once. */
+	static const int INFINITE_SCORE = WIN_SCORE + 1; /*!< Beyond any score. */
+
+private:
+	static const uint8_t EXACT = 0; /*!< The entry's score is exact. */
+	static const uint8_t LOWER = 1; /*!< The entry's score is a lower bound, from a cutoff. */
+	static const uint8_t UPPER = 2; /*!< The entry's score is an upper bound, as no move beat alpha. */
+
+	/*!
+	* @struct Entry
+	* @brief A position in the transposition table.
+	*/
+	struct Entry {
+		uint64_t key; /*!< The position's hash. */
+		int32_t score; /*!< The score, with wins counted from this position. */
+		int16_t move; /*!< The best move found, or -1. */
+		int8_t depth; /*!< The depth searched. */
+		uint8_t bound; /*!< EXACT, LOWER or UPPER. */
+	};
+
+	std::vector<Entry> table; /*!< The transposition table. */
+	uint64_t mask; /*!< The table size less one, for indexing by hash. */
+	uint64_t nodes; /*!< The positions searched by the last findBestMove. */
+	int completedDepth; /*!< The deepest search the last findBestMove finished. */
+	int score; /*!< The score of the best move found. */
+	int rootMove; /*!< The best move found by the search under way. */
+	bool timed; /*!< Whether the search has a deadline. */
+	bool stopped; /*!< Whether the deadline has passed. */
+	std::chrono::steady_clock::time_point deadline; /*!< When to stop searching. */
+
+	/*!
+	* @brief Store a score in the table, counting a win from this position rather than the root.
+	* @param value The score.
+	* @param ply The moves from the root.
+	* @return The score to store.
+	*/
+	static int toTable(int value, int ply) {
+		return (value > WIN_SCORE - 1000) ? value + ply : ((value < -WIN_SCORE + 1000) ? value - ply : value);
+	}
+
+	/*!
+	* @brief Read a score from the table, counting a win from the root again.
+	* @param value The stored score.
+	* @param ply The moves from the root.
+	* @return The score.
+	*/
+	static int fromTable(int value, int ply) {
+		return (value > WIN_SCORE - 1000) ? value - ply : ((value < -WIN_SCORE + 1000) ? value + ply : value);
+	}
+
+	/*!
+	* @brief Search a position to a depth.
+	* @param board The board, which is played on and put back.
+	* @param depth The moves left to search.
+	* @param ply The moves from the root.
+	* @param alpha The score the side to move is sure of already.
+	* @param beta The score the opponent is sure of already.
+	* @return The score for the side to move.
+	*/
+	int negamax(Board& board, int depth, int ply, int alpha, int beta) {
+		nodes++;
+		if (timed && (nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+			stopped = true;
+		}
+		if (stopped) {
+			return 0;
+		}
+
+		// The last move won for the other side
+		if (board.getWinner()) {
+			return -(WIN_SCORE - ply);
+		}
+		if (board.isFull()) {
+			return 0;
+		}
+		if (depth == 0) {
+			return Policy::evaluate(board);
+		}
+
+		int originalAlpha = alpha;
+		// The best move is kept as it is on the position the key is for, so it is turned back to this board's
+		int symmetry;
+		uint64_t key = Policy::hash(board, symmetry);
+		Entry& entry = table[key & mask];
+		int tableMove = -1;
+		if (entry.key == key) {
+			tableMove = (symmetry == 0) ? entry.move : Board::unturnCell(symmetry, entry.move);
+			if (entry.depth >= depth && ply == 0) {
+				// A position searched through already, such as the same one turned, needs no more than its move
+				if (entry.bound == EXACT && board.isLegal(tableMove)) {
+					rootMove = tableMove;
+					return fromTable(entry.score, ply);
+				}
+			}
+			else if (entry.depth >= depth) {
+				int stored = fromTable(entry.score, ply);
+				if (entry.bound == EXACT) {
+					return stored;
+				}
+				if (entry.bound == LOWER && stored > alpha) {
+					alpha = stored;
+				}
+				else if (entry.bound == UPPER && stored < beta) {
+					beta = stored;
+				}
+				if (alpha >= beta) {
+					return stored;
+				}
+			}
+		}
+
+		int moves[Board::CELLS];
+		int count = Policy::generateMoves(board, moves);
+		for (int i = 1; i < count; i++) {
+			if (moves[i] == tableMove) {
+				std::swap(moves[0], moves[i]);
+				break;
+			}
+		}
+
+		int best = -INFINITE_SCORE;
+		int bestMove = moves[0];
+		for (int i = 0; i < count; i++) {
+			board.makeMove(moves[i]);
+			int value = -negamax(board, depth - 1, ply + 1, -beta, -alpha);
+			board.undoMove();
+			if (stopped) {
+				return 0;
+			}
+
+			if (value > best) {
+				best = value;
+				bestMove = moves[i];
+				if (ply == 0) {
+					rootMove = bestMove;
+				}
+			}
+			if (best > alpha) {
+				alpha = best;
+			}
+			if (alpha >= beta) {
+				break;
+			}
+		}
+
+		Entry& slot = table[key & mask];
+		slot.key = key;
+		slot.score = toTable(best, ply);
+		slot.move = static_cast<int16_t>((symmetry == 0) ? bestMove : Board::turnCell(symmetry, bestMove));
+		slot.depth = static_cast<int8_t>(depth);
+		slot.bound = (best <= originalAlpha) ? UPPER : ((best >= beta) ? LOWER : EXACT);
+		return best;
+	}
+
+public:
+	/*!
+	* @brief Constructor for MnkSearch.
+	* @param tableBits The transposition table holds 2 to the power of this many positions.
+	*/
+	explicit MnkSearch(int tableBits = 18)
+		: table(static_cast<size_t>(1) << tableBits), mask((static_cast<uint64_t>(1) << tableBits) - 1), nodes(0), completedDepth(0),
+		score(0), rootMove(-1), timed(false), stopped(false) {
+		clear();
+	}
+
+	/*!
+	* @brief Forget every position searched.
+	*/
+	void clear() {
+		for (Entry& entry : table) {
+			entry = Entry{ 0, 0, -1, -1, EXACT };
+		}
+	}
+
+	/*!
+	* @brief Find the best move for the player to move, searching one move deeper each time until a limit is reached.
+	* @param board The board, which is played on and put back.
+	* @param maxDepth The deepest to search.
+	* @param seconds How long to search for, or 0 for no limit; the deepest finished search gives the move.
+	* @return The cell to play, or -1 if the game is over.
+	*/
+	int findBestMove(Board& board, int maxDepth, double seconds = 0.0) {
+		return deepen(board, 1, maxDepth, seconds);
+	}
+
+	/*!
+	* @brief Find the best move for the player to move by one search to a fixed depth.
+	* @details On a small board whose tree the table mostly holds already, deepening to it would only search the
+	* @details moves at the root again at each depth.
+	* @param board The board, which is played on and put back.
+	* @param depth The depth to search.
+	* @return The cell to play, or -1 if the game is over.
+	*/
+	int searchToDepth(Board& board, int depth) {
+		return deepen(board, depth, depth, 0.0);
+	}
+
+private:
+	/*!
+	* @brief Search one move deeper each time from one depth to another, until the time runs out or a result is forced.
+	* @param board The board, which is played on and put back.
+	* @param firstDepth The first depth to search.
+	* @param maxDepth The deepest to search.
+	* @param seconds How long to search for, or 0 for no limit.
+	* @return The cell to play, or -1 if the game is over.
+	*/
+	int deepen(Board& board, int firstDepth, int maxDepth, double seconds) {
+		int moves[Board::CELLS];
+		int count = Policy::generateMoves(board, moves);
+
+		nodes = 0;
+		completedDepth = 0;
+		score = 0;
+		stopped = false;
+		timed = seconds > 0.0;
+		deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(static_cast<int64_t>(seconds * 1e6));
+		if (count == 0 || board.isFull()) {
+			return -1;
+		}
+
+		int bestMove = moves[0];
+		for (int depth = firstDepth; depth <= maxDepth; depth++) {
+			rootMove = -1;
+			int value = negamax(board, depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+			if (stopped) {
+				break;
+			}
+
+			bestMove = rootMove;
+			score = value;
+			completedDepth = depth;
+
+			// A forced result is as deep as it gets
+			if (isDecisive(value)) {
+				break;
+			}
+		}
+
+		return bestMove;
+	}
+
+public:
+	/*!
+	* @brief Get the score of the last move found.
+	* @return The score for the player who was to move.
+	*/
+	int getScore() const { return score; }
+
+	/*!
+	* @brief Get the positions searched by the last findBestMove.
+	* @return The count.
+	*/
+	uint64_t getNodes() const { return nodes; }
+
+	/*!
+	* @brief Get the deepest search the last findBestMove finished.
+	* @return The depth in moves.
+	*/
+	int getDepth() const { return completedDepth; }
+
+	/*!
+	* @brief Check if a score is a forced win or loss.
+	* @param value The score.
+	* @return true if it is.
+	*/
+	static bool isDecisive(int value) { return value > WIN_SCORE - 1000 || value < -WIN_SCORE + 1000; }
+};
+
+#endif // MNK_SEARCH_H
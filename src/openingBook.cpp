@@ -0,0 +1,337 @@
+#include "openingBook.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// File header written at the start of every book
+static const char FILE_MAGIC[4] = { 'M', 'G', 'O', 'B' };
+
+// Merge the entries once there are at least this many unmerged ones
+static const size_t MIN_MERGE_SIZE = 1 << 20;
+
+
+// Writes a number as little-endian bytes
+static void storeLittleEndian(uint8_t* bytes, uint64_t value, int length) {
+    for (int i = 0; i < length; i++) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+
+// Reads a number stored as little-endian bytes
+static uint64_t loadLittleEndian(const uint8_t* bytes, int length) {
+    uint64_t value = 0;
+    for (int i = 0; i < length; i++) {
+        value |= uint64_t(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+
+// Orders entries by key, then move
+static bool entryLess(const OpeningBookEntry& a, const OpeningBookEntry& b) {
+    return (a.key != b.key) ? (a.key < b.key) : (a.move.data < b.move.data);
+}
+
+
+// Adds two counts without wrapping
+static uint32_t saturatingAdd(uint32_t a, uint32_t b) {
+    return (a > UINT32_MAX - b) ? UINT32_MAX : a + b;
+}
+
+
+// Constructor for the OpeningTreeBuilder class
+OpeningTreeBuilder::OpeningTreeBuilder(int maxPly) : maxPly(maxPly), mergedSize(0), movesAdded(0) {
+}
+
+
+// Sorts the entries and merges the counts of equal (key, move) pairs
+void OpeningTreeBuilder::merge() {
+    std::sort(entries.begin(), entries.end(), entryLess);
+
+    size_t last = 0;
+    for (size_t i = 1; i < entries.size(); i++) {
+        if (entries[i].key == entries[last].key && entries[i].move == entries[last].move) {
+            entries[last].games = saturatingAdd(entries[last].games, entries[i].games);
+            entries[last].points = saturatingAdd(entries[last].points, entries[i].points);
+        }
+        else {
+            entries[++last] = entries[i];
+        }
+    }
+
+    if (!entries.empty()) {
+        entries.resize(last + 1);
+    }
+    mergedSize = entries.size();
+}
+
+
+// Adds the opening of one game to the tree
+bool OpeningTreeBuilder::addGame(const PgnGame& game) {
+    std::string_view fen = game.getTag("FEN");
+    if (fen.empty()) {
+        board = startBoard;
+    }
+    else {
+        try {
+            board.setFen(fen);
+        }
+        catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+
+    int whitePoints = game.getWhitePoints();
+    if (whitePoints == PgnGame::UNKNOWN) {
+        whitePoints = PgnGame::DRAW;
+    }
+
+    int plies = std::min(maxPly, static_cast<int>(game.moves.size()));
+    for (int ply = 0; ply < plies; ply++) {
+        ChessMove move = board.parseSan(game.moves[ply]);
+        if (move.isNull()) {
+            return false;
+        }
+
+        OpeningBookEntry entry;
+        entry.key = board.getHash();
+        entry.move = move;
+        entry.games = 1;
+        entry.points = static_cast<uint32_t>((board.getSideToMove() == ChessBoard::WHITE) ? whitePoints : 2 - whitePoints);
+        entries.push_back(entry);
+        movesAdded++;
+
+        board.makeMove(move);
+    }
+
+    if (entries.size() >= std::max(2 * mergedSize, MIN_MERGE_SIZE)) {
+        merge();
+    }
+    return true;
+}
+
+
+// Adds every game in some PGN text to the tree, splitting it between threads
+PgnImportStats OpeningTreeBuilder::addPgn(std::string_view text, int threads) {
+    auto start = std::chrono::steady_clock::now();
+    PgnImportStats stats;
+
+    if (threads <= 1) {
+        PgnParser parser(text);
+        PgnGame game;
+        uint64_t movesBefore = movesAdded;
+
+        while (parser.nextGame(game)) {
+            if (!addGame(game)) {
+                stats.errors++;
+            }
+            stats.games++;
+        }
+        stats.positions = movesAdded - movesBefore;
+    }
+    else {
+        std::vector<size_t> bounds(1, 0);
+        for (int i = 1; i < threads; i++) {
+            size_t split = std::max(bounds.back(), PgnParser::findGameStart(text, text.size() / threads * i));
+            bounds.push_back(split);
+        }
+        bounds.push_back(text.size());
+
+        std::vector<std::unique_ptr<OpeningTreeBuilder>> parts;
+        std::vector<PgnImportStats> partStats(threads);
+        std::vector<std::thread> workers;
+
+        for (int i = 0; i < threads; i++) {
+            parts.emplace_back(new OpeningTreeBuilder(maxPly));
+            std::string_view part = text.substr(bounds[i], bounds[i + 1] - bounds[i]);
+
+            workers.emplace_back([&parts, &partStats, i, part]() {
+                partStats[i] = parts[i]->addPgn(part);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        for (int i = 0; i < threads; i++) {
+            entries.insert(entries.end(), parts[i]->entries.begin(), parts[i]->entries.end());
+            movesAdded += parts[i]->movesAdded;
+
+            stats.games += partStats[i].games;
+            stats.positions += partStats[i].positions;
+            stats.errors += partStats[i].errors;
+        }
+        merge();
+    }
+
+    stats.bytes = text.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+
+// Adds every game in a PGN file to the tree
+PgnImportStats OpeningTreeBuilder::addPgnFile(const std::string& filename, int threads) {
+    MappedFile file(filename);
+    return addPgn(file.view(), threads);
+}
+
+
+// Gets the number of distinct (position, move) pairs
+size_t OpeningTreeBuilder::size() {
+    if (mergedSize != entries.size()) {
+        merge();
+    }
+    return entries.size();
+}
+
+
+// Writes the tree as a book file
+size_t OpeningTreeBuilder::write(const std::string& filename, uint32_t minGames) {
+    if (mergedSize != entries.size()) {
+        merge();
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not write opening book " + filename);
+    }
+
+    uint64_t written = 0;
+    for (const OpeningBookEntry& entry : entries) {
+        if (entry.games >= minGames) {
+            written++;
+        }
+    }
+
+    uint8_t header[OpeningBook::HEADER_BYTES];
+    std::copy(FILE_MAGIC, FILE_MAGIC + 4, header);
+    storeLittleEndian(header + 4, OpeningBook::VERSION, 4);
+    storeLittleEndian(header + 8, written, 8);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // Encode the entries a block at a time rather than writing each one separately
+    std::vector<uint8_t> buffer;
+    buffer.reserve(4096 * OpeningBook::ENTRY_BYTES);
+
+    for (const OpeningBookEntry& entry : entries) {
+        if (entry.games < minGames) {
+            continue;
+        }
+
+        size_t offset = buffer.size();
+        buffer.resize(offset + OpeningBook::ENTRY_BYTES);
+        storeLittleEndian(&buffer[offset], entry.key, 8);
+        storeLittleEndian(&buffer[offset + 8], entry.move.data, 2);
+        storeLittleEndian(&buffer[offset + 10], 0, 2);
+        storeLittleEndian(&buffer[offset + 12], entry.games, 4);
+        storeLittleEndian(&buffer[offset + 16], entry.points, 4);
+
+        if (buffer.size() == buffer.capacity()) {
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+            buffer.clear();
+        }
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+    if (!file) {
+        throw std::runtime_error("Could not write opening book " + filename);
+    }
+    return static_cast<size_t>(written);
+}
+
+
+// Opens a book file and checks its header
+OpeningBook::OpeningBook(const std::string& filename) : file(filename), entries(nullptr), count(0) {
+    if (file.size() < HEADER_BYTES || !std::equal(FILE_MAGIC, FILE_MAGIC + 4, file.data()) ||
+        loadLittleEndian(file.data() + 4, 4) != VERSION) {
+        throw std::runtime_error("Not an opening book: " + filename);
+    }
+
+    uint64_t entryCount = loadLittleEndian(file.data() + 8, 8);
+    if (entryCount > (file.size() - HEADER_BYTES) / ENTRY_BYTES) {
+        throw std::runtime_error("Opening book is cut short: " + filename);
+    }
+
+    entries = file.data() + HEADER_BYTES;
+    count = static_cast<size_t>(entryCount);
+}
+
+
+// Decodes an entry
+OpeningBookEntry OpeningBook::getEntry(size_t index) const {
+    const uint8_t* bytes = entries + index * ENTRY_BYTES;
+    OpeningBookEntry entry;
+
+    entry.key = loadLittleEndian(bytes, 8);
+    entry.move.data = static_cast<uint16_t>(loadLittleEndian(bytes + 8, 2));
+    entry.games = static_cast<uint32_t>(loadLittleEndian(bytes + 12, 4));
+    entry.points = static_cast<uint32_t>(loadLittleEndian(bytes + 16, 4));
+    return entry;
+}
+
+
+// Gets the number of entries
+size_t OpeningBook::size() const {
+    return count;
+}
+
+
+// Finds every move for a position by binary search for its first entry
+std::vector<OpeningBookEntry> OpeningBook::probe(uint64_t key) const {
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (loadLittleEndian(entries + middle * ENTRY_BYTES, 8) < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    std::vector<OpeningBookEntry> found;
+    for (size_t index = low; index < count; index++) {
+        OpeningBookEntry entry = getEntry(index);
+        if (entry.key != key) {
+            break;
+        }
+        found.push_back(entry);
+    }
+    return found;
+}
+
+
+// Chooses the legal book move played in the most games, checking legality in case two positions share a key
+ChessMove OpeningBook::chooseMove(const ChessBoard& board) const {
+    std::vector<OpeningBookEntry> candidates = probe(board.getHash());
+    if (candidates.empty()) {
+        return ChessMove();
+    }
+
+    ChessMoveList list;
+    board.generateLegalMoves(list);
+
+    ChessMove best;
+    uint32_t bestGames = 0, bestPoints = 0;
+    for (const OpeningBookEntry& entry : candidates) {
+        bool legal = false;
+        for (ChessMove move : list) {
+            if (move == entry.move) {
+                legal = true;
+                break;
+            }
+        }
+
+        if (legal && (entry.games > bestGames || (entry.games == bestGames && entry.points > bestPoints))) {
+            best = entry.move;
+            bestGames = entry.games;
+            bestPoints = entry.points;
+        }
+    }
+    return best;
+}
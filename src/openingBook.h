@@ -0,0 +1,174 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+/*!
+* @file openingBook.h
+* @brief Contains the declaration of the opening tree builder and the opening book read from the file it writes.
+* @details A book file is a 16 byte header ("MGOB", a little-endian 32-bit version and 64-bit entry count) followed by
+* @details the entries sorted by key and then move. Each entry is 20 bytes, all little-endian: the 64-bit Zobrist key
+* @details of the position, the 16-bit ChessMove played from it, 16 reserved bits, a 32-bit count of the games that
+* @details played it and a 32-bit count of the half points those games scored for the side that played it.
+*/
+
+#include "chessBoard.h"
+#include "mappedFile.h"
+#include "pgnParser.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+* @struct OpeningBookEntry
+* @brief How often a move was played from a position, and how well it scored.
+*/
+struct OpeningBookEntry {
+	uint64_t key = 0; /*!< The Zobrist key of the position. */
+	ChessMove move; /*!< The move played. */
+	uint32_t games = 0; /*!< The number of games that played the move. */
+	uint32_t points = 0; /*!< Half points scored by the side that played the move, unfinished games counting as draws. */
+};
+
+/*!
+* @struct PgnImportStats
+* @brief What an import of PGN into an OpeningTreeBuilder read, and how fast.
+*/
+struct PgnImportStats {
+	uint64_t bytes = 0; /*!< The size of the PGN text. */
+	uint64_t games = 0; /*!< The number of games read. */
+	uint64_t positions = 0; /*!< The number of moves added to the tree. */
+	uint64_t errors = 0; /*!< The number of games with a bad FEN or a move that is not legal, added up to the error. */
+	double seconds = 0.0; /*!< The time taken. */
+
+	/*!
+	* @brief Get the import speed.
+	* @return Megabytes of PGN read per second.
+	*/
+	double megabytesPerSecond() const { return seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0; }
+};
+
+/*!
+* @class OpeningTreeBuilder
+* @brief Counts the moves played from every position in the opening of a collection of games, and writes them as a book.
+* @details Moves are appended to a flat vector; when it has doubled since it was last merged it is sorted and equal
+* @details (key, move) entries are merged, so memory grows with the number of distinct positions rather than games.
+*/
+class OpeningTreeBuilder {
+public:
+	static const int DEFAULT_MAX_PLY = 24; /*!< By default, how many half moves of each game go into the tree. */
+
+private:
+	int maxPly; /*!< How many half moves of each game go into the tree. */
+	std::vector<OpeningBookEntry> entries; /*!< The moves counted so far. */
+	size_t mergedSize; /*!< The number of entries at the front of the vector that are sorted and merged. */
+	uint64_t movesAdded; /*!< The number of moves added, counting repeats. */
+	ChessBoard startBoard; /*!< The standard starting position, copied for each game rather than parsed again. */
+	ChessBoard board; /*!< The position games are replayed on. */
+
+	/*!
+	* @brief Sort the entries and merge the counts of equal (key, move) pairs.
+	*/
+	void merge();
+
+public:
+	/*!
+	* @brief Constructor for OpeningTreeBuilder.
+	* @param maxPly How many half moves of each game to add to the tree.
+	*/
+	explicit OpeningTreeBuilder(int maxPly = DEFAULT_MAX_PLY);
+
+	/*!
+	* @brief Add the opening of one game to the tree.
+	* @param game The game, which starts from its FEN tag if it has one.
+	* @return true if every move added was legal, false if the game had a bad FEN or move and was cut short.
+	*/
+	bool addGame(const PgnGame& game);
+
+	/*!
+	* @brief Add every game in some PGN text to the tree.
+	* @details With more than one thread the text is split at game boundaries, each thread builds its own tree from
+	* @details one part, and the trees are merged at the end.
+	* @param text The PGN text.
+	* @param threads The number of threads to read with.
+	* @return The number of games and moves read, and the time taken.
+	*/
+	PgnImportStats addPgn(std::string_view text, int threads = 1);
+
+	/*!
+	* @brief Add every game in a PGN file to the tree, reading the file in place through a memory mapping.
+	* @param filename The name of the file.
+	* @param threads The number of threads to read with.
+	* @return The number of games and moves read, and the time taken.
+	* @throws runtime_error if the file cannot be opened.
+	*/
+	PgnImportStats addPgnFile(const std::string& filename, int threads = 1);
+
+	/*!
+	* @brief Get the number of distinct (position, move) pairs in the tree.
+	* @return The number of entries.
+	*/
+	size_t size();
+
+	/*!
+	* @brief Write the tree as a book file.
+	* @param filename The name of the file.
+	* @param minGames Moves played in fewer games than this are left out.
+	* @return The number of entries written.
+	* @throws runtime_error if the file cannot be written.
+	*/
+	size_t write(const std::string& filename, uint32_t minGames = 1);
+};
+
+/*!
+* @class OpeningBook
+* @brief Looks up moves in a book file written by OpeningTreeBuilder.
+* @details The file is memory mapped and binary searched in place, so opening even a large book costs nothing up front.
+*/
+class OpeningBook {
+public:
+	static const uint32_t VERSION = 1; /*!< The version of the file format. */
+	static const int HEADER_BYTES = 16; /*!< The size of the file header. */
+	static const int ENTRY_BYTES = 20; /*!< The size of one entry. */
+
+private:
+	MappedFile file; /*!< The mapped book file. */
+	const uint8_t* entries; /*!< The first entry in the file. */
+	size_t count; /*!< The number of entries. */
+
+	/*!
+	* @brief Decode an entry.
+	* @param index The entry's position in the file.
+	* @return The entry.
+	*/
+	OpeningBookEntry getEntry(size_t index) const;
+
+public:
+	/*!
+	* @brief Open a book file.
+	* @param filename The name of the file.
+	* @throws runtime_error if the file cannot be opened or is not a book.
+	*/
+	explicit OpeningBook(const std::string& filename);
+
+	/*!
+	* @brief Get the number of entries in the book.
+	* @return The number of entries.
+	*/
+	size_t size() const;
+
+	/*!
+	* @brief Find every move the book has for a position.
+	* @param key The Zobrist key of the position.
+	* @return The entries for the position, in move order; empty if it is not in the book.
+	*/
+	std::vector<OpeningBookEntry> probe(uint64_t key) const;
+
+	/*!
+	* @brief Choose a book move, the legal move played in the most games.
+	* @param board The position.
+	* @return The move, or the null move if the position is not in the book.
+	*/
+	ChessMove chooseMove(const ChessBoard& board) const;
+};
+
+#endif // OPENING_BOOK_H
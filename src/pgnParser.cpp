@@ -0,0 +1,255 @@
+#include "pgnParser.h"
+
+
+// Empties the game, keeping the memory
+void PgnGame::clear() {
+    tags.clear();
+    moves.clear();
+    result = std::string_view();
+}
+
+
+// Finds a tag's value
+std::string_view PgnGame::getTag(std::string_view name) const {
+    for (const PgnTag& tag : tags) {
+        if (tag.name == name) {
+            return tag.value;
+        }
+    }
+    return std::string_view();
+}
+
+
+// Gets the result as white's score in half points
+int PgnGame::getWhitePoints() const {
+    std::string_view token = result.empty() ? getTag("Result") : result;
+
+    if (token == "1-0") {
+        return WHITE_WIN;
+    }
+    if (token == "0-1") {
+        return BLACK_WIN;
+    }
+    if (token == "1/2-1/2") {
+        return DRAW;
+    }
+    return UNKNOWN;
+}
+
+
+// Characters that end a movetext token
+static bool isDelimiter(char c) {
+    switch (c) {
+    case ' ': case '\t': case '\r': case '\n':
+    case '{': case '}': case '(': case ')': case '[': case ']': case ';': case '$':
+        return true;
+    default:
+        return false;
+    }
+}
+
+
+// Constructor for the PgnParser class
+PgnParser::PgnParser(std::string_view text) : text(text), position(0) {
+}
+
+
+// Skips spaces, newlines and '%' escape lines
+void PgnParser::skipSpace() {
+    while (position < text.size()) {
+        char c = text[position];
+
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            position++;
+        }
+        else if (c == '%' && (position == 0 || text[position - 1] == '\n')) {
+            size_t end = text.find('\n', position);
+            position = (end == std::string_view::npos) ? text.size() : end + 1;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+
+// Reads a tag pair such as [Event "Casual game"]
+void PgnParser::readTag(PgnGame& game) {
+    PgnTag tag;
+    position++;
+
+    size_t start = position;
+    while (position < text.size() && text[position] != ' ' && text[position] != '"' && text[position] != ']') {
+        position++;
+    }
+    tag.name = text.substr(start, position - start);
+
+    while (position < text.size() && text[position] != '"' && text[position] != ']' && text[position] != '\n') {
+        position++;
+    }
+
+    // The value runs to the next quote that is not escaped with a backslash
+    if (position < text.size() && text[position] == '"') {
+        start = ++position;
+        while (position < text.size() && text[position] != '"' && text[position] != '\n') {
+            position += (text[position] == '\\') ? 2 : 1;
+        }
+        if (position > text.size()) {
+            position = text.size();
+        }
+        tag.value = text.substr(start, position - start);
+    }
+
+    // A tag missing its closing bracket ends at the end of the line
+    while (position < text.size() && text[position] != ']' && text[position] != '\n') {
+        position++;
+    }
+    if (position < text.size()) {
+        position++;
+    }
+
+    game.tags.push_back(tag);
+}
+
+
+// Skips a variation, which can hold comments with brackets in them and variations of its own
+void PgnParser::skipVariation() {
+    int depth = 0;
+
+    while (position < text.size()) {
+        char c = text[position];
+
+        if (c == '(') {
+            depth++;
+        }
+        else if (c == ')') {
+            if (--depth == 0) {
+                position++;
+                return;
+            }
+        }
+        else if (c == '{') {
+            size_t end = text.find('}', position);
+            position = (end == std::string_view::npos) ? text.size() : end;
+        }
+        else if (c == ';') {
+            size_t end = text.find('\n', position);
+            position = (end == std::string_view::npos) ? text.size() : end;
+        }
+        position++;
+    }
+}
+
+
+// Reads the next game
+bool PgnParser::nextGame(PgnGame& game) {
+    game.clear();
+    bool inMovetext = false;
+
+    while (true) {
+        skipSpace();
+        if (position >= text.size()) {
+            return inMovetext || !game.tags.empty();
+        }
+
+        char c = text[position];
+
+        // Tags after the movetext belong to the next game, so this one had no result
+        if (c == '[') {
+            if (inMovetext) {
+                return true;
+            }
+            readTag(game);
+            continue;
+        }
+
+        inMovetext = true;
+
+        if (c == '{') {
+            size_t end = text.find('}', position);
+            position = (end == std::string_view::npos) ? text.size() : end + 1;
+            continue;
+        }
+        if (c == ';') {
+            size_t end = text.find('\n', position);
+            position = (end == std::string_view::npos) ? text.size() : end + 1;
+            continue;
+        }
+        if (c == '(') {
+            skipVariation();
+            continue;
+        }
+        if (c == '$' || c == ')' || c == '}' || c == ']') {
+            position++;
+            while (c == '$' && position < text.size() && text[position] >= '0' && text[position] <= '9') {
+                position++;
+            }
+            continue;
+        }
+
+        size_t start = position;
+        while (position < text.size() && !isDelimiter(text[position])) {
+            position++;
+        }
+        std::string_view token = text.substr(start, position - start);
+
+        if (isResult(token)) {
+            game.result = token;
+            return true;
+        }
+
+        // Strip a move number such as "12." or "12...", which may be written joined to the move
+        size_t digits = 0;
+        while (digits < token.size() && token[digits] >= '0' && token[digits] <= '9') {
+            digits++;
+        }
+        if (digits == token.size()) {
+            continue;
+        }
+        if (token[digits] == '.') {
+            token.remove_prefix(digits);
+        }
+        while (!token.empty() && token[0] == '.') {
+            token.remove_prefix(1);
+        }
+
+        if (!token.empty()) {
+            game.moves.push_back(token);
+        }
+    }
+}
+
+
+// Gets how far the parser has read
+size_t PgnParser::getPosition() const {
+    return position;
+}
+
+
+// Checks if a token is a game result
+bool PgnParser::isResult(std::string_view token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+
+// Finds the start of the next game's tags
+size_t PgnParser::findGameStart(std::string_view text, size_t from) {
+    size_t position = text.find("\n[", from);
+
+    while (position != std::string_view::npos) {
+        // Look back to the start of the line before, skipping any blank lines
+        size_t lineStart = position;
+        while (lineStart > 0 && (text[lineStart - 1] == '\n' || text[lineStart - 1] == '\r' || text[lineStart - 1] == ' ')) {
+            lineStart--;
+        }
+        size_t previousLine = text.rfind('\n', lineStart == 0 ? 0 : lineStart - 1);
+        previousLine = (previousLine == std::string_view::npos) ? 0 : previousLine + 1;
+
+        if (lineStart == 0 || text[previousLine] != '[') {
+            return position + 1;
+        }
+        position = text.find("\n[", position + 1);
+    }
+
+    return text.size();
+}
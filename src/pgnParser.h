@@ -0,0 +1,122 @@
+#ifndef PGN_PARSER_H
+#define PGN_PARSER_H
+
+/*!
+* @file pgnParser.h
+* @brief Contains the declaration of the streaming Portable Game Notation parser.
+* @details The parser never copies the text: tag values and moves are string_views into the buffer it was given,
+* @details normally a MappedFile, so they are only valid while that buffer is.
+*/
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/*!
+* @struct PgnTag
+* @brief A tag pair from a game's header, such as [White "Morphy, Paul"].
+*/
+struct PgnTag {
+	std::string_view name; /*!< The tag name, such as "White". */
+	std::string_view value; /*!< The value between the quotes, with any escapes left as they are. */
+};
+
+/*!
+* @struct PgnGame
+* @brief One game read by PgnParser.
+* @details Reusing the same PgnGame for every game keeps the vectors' memory, so parsing does not allocate.
+*/
+struct PgnGame {
+	static const int WHITE_WIN = 2; /*!< getWhitePoints for 1-0. */
+	static const int DRAW = 1; /*!< getWhitePoints for 1/2-1/2. */
+	static const int BLACK_WIN = 0; /*!< getWhitePoints for 0-1. */
+	static const int UNKNOWN = -1; /*!< getWhitePoints for * or a missing result. */
+
+	std::vector<PgnTag> tags; /*!< The tag pairs, in the order they appear. */
+	std::vector<std::string_view> moves; /*!< The main line in SAN, without move numbers, comments or variations. */
+	std::string_view result; /*!< The result token ending the movetext, such as "1-0", or empty if there was none. */
+
+	/*!
+	* @brief Empty the game, keeping the memory.
+	*/
+	void clear();
+
+	/*!
+	* @brief Find a tag's value.
+	* @param name The tag name, such as "FEN".
+	* @return The value, or an empty view if the game does not have the tag.
+	*/
+	std::string_view getTag(std::string_view name) const;
+
+	/*!
+	* @brief Get the result as white's score in half points, from the result token or failing that the Result tag.
+	* @return WHITE_WIN, DRAW, BLACK_WIN or UNKNOWN.
+	*/
+	int getWhitePoints() const;
+};
+
+/*!
+* @class PgnParser
+* @brief Reads games one at a time from PGN text.
+* @details Comments in braces or after ';', recursive variations, numeric annotation glyphs, move numbers and
+* @details '%' escape lines are skipped. A game ends at its result token, or at the next tag section if it has none.
+*/
+class PgnParser {
+private:
+	std::string_view text; /*!< The whole PGN text. */
+	size_t position; /*!< How far through the text the parser has read. */
+
+	/*!
+	* @brief Skip spaces, newlines and '%' escape lines.
+	*/
+	void skipSpace();
+
+	/*!
+	* @brief Read a tag pair, starting at its '['.
+	* @param game The game to add the tag to.
+	*/
+	void readTag(PgnGame& game);
+
+	/*!
+	* @brief Skip a recursive variation, starting at its '(', including any variations and comments inside it.
+	*/
+	void skipVariation();
+
+public:
+	/*!
+	* @brief Constructor for PgnParser.
+	* @param text The PGN text, which must outlive the parser and the games it reads.
+	*/
+	explicit PgnParser(std::string_view text);
+
+	/*!
+	* @brief Read the next game.
+	* @param game Set to the game read; its views point into the text.
+	* @return true if a game was read, false at the end of the text.
+	*/
+	bool nextGame(PgnGame& game);
+
+	/*!
+	* @brief Get how far the parser has read.
+	* @return The number of bytes read so far.
+	*/
+	size_t getPosition() const;
+
+	/*!
+	* @brief Check if a token is a game result.
+	* @param token The token.
+	* @return true for "1-0", "0-1", "1/2-1/2" and "*".
+	*/
+	static bool isResult(std::string_view token);
+
+	/*!
+	* @brief Find where the next game starts, so a large file can be split between threads.
+	* @details A game starts at a line beginning with '[' that does not follow another tag line.
+	* @param text The PGN text.
+	* @param from Where to start looking.
+	* @return The position of the next game's first '[', or the size of the text if there is none.
+	*/
+	static size_t findGameStart(std::string_view text, size_t from);
+};
+
+#endif // PGN_PARSER_H
@@ -427,3 +427,20 @@ std::string ScreenBuffer::getBlockingInput() {
 
 
 
+
+
+// Get the keys pressed since the last call without waiting for any
+std::string ScreenBuffer::getNonBlockingInput() {
+    std::string input;
+
+    while (_kbhit()) {
+        int ch = _getch();
+        if (ch == 0xE0 || ch == 0) {  // Special keys come as two codes, and neither is wanted
+            _getch();
+            continue;
+        }
+        input += static_cast<char>(ch);
+    }
+
+    return input;
+}
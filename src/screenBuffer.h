@@ -212,7 +212,8 @@ public:
 
 	/*!
 	* @brief get non-blocking input from the user
-	* @return std::wstring The input from the user
+	* @details Returns straight away with whatever keys are waiting, for games that keep running between key presses.
+	* @return std::string The keys pressed since the last call, oldest first; empty if there were none
 	*/ 
 	std::string getNonBlockingInput();
 };
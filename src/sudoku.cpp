@@ -0,0 +1,223 @@
+#include "sudoku.h"
+
+
+// Constructor for the Sudoku class
+Sudoku::Sudoku(ScreenBuffer* buffer) : ownScreenBuffer(buffer ? nullptr : new ScreenBuffer()), screenBuffer(buffer ? *buffer : *ownScreenBuffer) {
+    for (bool& cell : given) {
+        cell = false;
+    }
+}
+
+
+// Generates a new puzzle and its solution
+void Sudoku::generateBoard(int difficulty) {
+    grid = generator.generate(difficulty);
+    solution = grid;
+
+    SudokuSolver solver;
+    solver.solve(solution);
+
+    for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+        given[cell] = grid.getCell(cell) != 0;
+    }
+}
+
+
+// Gets the puzzle as the player has filled it in
+const SudokuGrid& Sudoku::getGrid() const {
+    return grid;
+}
+
+
+// Checks for valid move input
+bool Sudoku::isValidInput(const std::string& input) const {
+    // A row and a column from 1 to 9, then a digit or 0 or '.' to clear the cell
+    std::regex pattern(R"(^[1-9] ?[1-9] ?[0-9.]$)");
+
+    return std::regex_match(input, pattern);
+}
+
+
+// Prints the grid, with the givens in white and the player's digits in cyan
+void Sudoku::printBoard() {
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 1, L"      1 2 3   4 5 6   7 8 9");
+
+    for (int row = 0; row < SudokuGrid::SIZE; row++) {
+        int y = 3 + row + row / 3;
+
+        // Print a horizontal line above every third row
+        if (row % 3 == 0) {
+            screenBuffer.writeToScreen(4, y - 1, L"    +-------+-------+-------+");
+        }
+
+        std::wstring rowText = L"  " + std::to_wstring(row + 1) + L" | ";
+        for (int column = 0; column < SudokuGrid::SIZE; column++) {
+            int cell = row * SudokuGrid::SIZE + column;
+            rowText += given[cell] ? static_cast<wchar_t>(L'0' + grid.getCell(cell)) : L' ';
+            rowText += (column % 3 == 2) ? L" | " : L" ";
+        }
+        screenBuffer.writeToScreen(4, y, rowText);
+
+        // Draw over the player's cells, '.' for the empty ones
+        for (int column = 0; column < SudokuGrid::SIZE; column++) {
+            int cell = row * SudokuGrid::SIZE + column;
+            if (given[cell]) {
+                continue;
+            }
+
+            int x = 10 + column * 2 + (column / 3) * 2;
+            int digit = grid.getCell(cell);
+            if (digit) {
+                screenBuffer.writeToScreen(x, y, std::wstring(1, static_cast<wchar_t>(L'0' + digit)), ScreenBuffer::CYAN, ScreenBuffer::BACKGROUND_NORMAL);
+            }
+            else {
+                screenBuffer.writeToScreen(x, y, L".");
+            }
+        }
+    }
+
+    // Print the final horizontal line at the bottom
+    screenBuffer.writeToScreen(4, 14, L"    +-------+-------+-------+");
+}
+
+
+// Asks whether to return to the menu or exit
+int Sudoku::endGame() {
+    screenBuffer.writeToScreen(4, 22, L"Type 'return' to return to the main menu, or 'exit' to exit MiniGame-Madness.");
+
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "return") {
+            return 0;
+        }
+        else if (input == "exit") {
+            return 1;
+        }
+        else {
+            screenBuffer.writeToScreen(4, 22, L"Invalid input. Please type 'return' or 'exit':                                 ");
+        }
+    }
+}
+
+
+// The game loop, filling in cells until the grid is complete
+int Sudoku::run() {
+    screenBuffer.setActive();
+    screenBuffer.clearScreen();
+    screenBuffer.writeToScreen(4, 2, L"Choose a difficulty: 'easy', 'medium' or 'hard': ");
+
+    int difficulty = SudokuSolver::EASY;
+    while (true) {
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "easy" || input == "medium" || input == "hard") {
+            difficulty = (input == "easy") ? SudokuSolver::EASY : ((input == "medium") ? SudokuSolver::MEDIUM : SudokuSolver::HARD);
+            break;
+        }
+        screenBuffer.writeToScreen(4, 2, L"Please enter 'easy', 'medium' or 'hard':          ");
+    }
+
+    screenBuffer.writeToScreen(4, 4, L"Generating a puzzle...");
+    generateBoard(difficulty);
+    printBoard();
+
+    while (!grid.isComplete()) {
+        screenBuffer.writeToScreen(4, 18, L"Enter row, column and digit (e.g., 3 7 5, or 3 7 0 to clear), 'hint', 'solve' or 'quit': ");
+        std::string input = screenBuffer.getBlockingInput();
+
+        if (input == "quit") {
+            screenBuffer.writeToScreen(4, 20, L"Puzzle abandoned.");
+            return endGame();
+        }
+
+        if (input == "solve") {
+            grid = solution;
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"Here is the solution.");
+            return endGame();
+        }
+
+        if (input == "hint") {
+            // Put right the first wrong digit, or else fill in the empty cell with fewest candidates
+            int hintCell = -1;
+            int fewest = SudokuGrid::SIZE + 1;
+            for (int cell = 0; cell < SudokuGrid::CELLS && fewest > 0; cell++) {
+                if (grid.getCell(cell) && grid.getCell(cell) != solution.getCell(cell)) {
+                    hintCell = cell;
+                    fewest = 0;
+                }
+                else if (!grid.getCell(cell)) {
+                    int candidates = 0;
+                    for (uint16_t mask = grid.getCandidates(cell); mask; mask &= mask - 1) {
+                        candidates++;
+                    }
+                    if (candidates < fewest) {
+                        hintCell = cell;
+                        fewest = candidates;
+                    }
+                }
+            }
+
+            // The answer goes here, so the same digit anywhere in its row, column or box is wrong and is cleared
+            int digit = solution.getCell(hintCell);
+            grid.erase(hintCell);
+            for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+                bool peer = cell / 9 == hintCell / 9 || cell % 9 == hintCell % 9 || SudokuGrid::boxOf(cell) == SudokuGrid::boxOf(hintCell);
+                if (peer && grid.getCell(cell) == digit) {
+                    grid.erase(cell);
+                }
+            }
+            grid.place(hintCell, digit);
+
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"Row " + std::to_wstring(hintCell / 9 + 1) + L", column " + std::to_wstring(hintCell % 9 + 1) +
+                L" is " + std::to_wstring(digit) + L".");
+            continue;
+        }
+
+        if (!isValidInput(input)) {
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"Invalid input. Please enter a row, a column and a digit, such as '3 7 5'.");
+            continue;
+        }
+
+        // Pick the three characters out from between any spaces
+        std::string compact;
+        for (char character : input) {
+            if (character != ' ') {
+                compact += character;
+            }
+        }
+
+        int cell = (compact[0] - '1') * SudokuGrid::SIZE + (compact[1] - '1');
+        int digit = (compact[2] == '.') ? 0 : compact[2] - '0';
+
+        if (given[cell]) {
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"That cell is part of the puzzle and cannot be changed.");
+            continue;
+        }
+
+        int previous = grid.getCell(cell);
+        grid.erase(cell);
+        if (digit && !grid.canPlace(cell, digit)) {
+            if (previous) {
+                grid.place(cell, previous);
+            }
+            printBoard();
+            screenBuffer.writeToScreen(4, 20, L"That digit is already in the same row, column or box.");
+            continue;
+        }
+        if (digit) {
+            grid.place(cell, digit);
+        }
+
+        printBoard();
+    }
+
+    // A full grid never repeats a digit, and the puzzle has only one solution, so it is solved
+    screenBuffer.writeToScreen(4, 20, L"Congratulations, the puzzle is solved!", ScreenBuffer::GREEN, ScreenBuffer::BACKGROUND_NORMAL);
+    return endGame();
+}
@@ -0,0 +1,76 @@
+#ifndef SUDOKU_H
+#define SUDOKU_H
+
+/*!
+* @file sudoku.h
+* @brief Contains the declaration of the Sudoku class and its member functions for the Sudoku game.
+*/
+
+#include "ScreenBuffer.h"
+#include "sudokuGrid.h"
+#include "sudokuSolver.h"
+#include <memory>
+#include <string>
+#include <regex>
+
+/*!
+* @class Sudoku
+* @brief A class that represents the game of Sudoku.
+* @details The puzzle comes from SudokuGenerator at the difficulty the player picks; this class draws the grid and
+* @details runs the game loop.
+*/
+class Sudoku {
+ private:
+
+	SudokuGenerator generator; /*!< Makes the puzzles. */
+	SudokuGrid grid; /*!< The puzzle as the player has filled it in. */
+	SudokuGrid solution; /*!< The puzzle's one solution. */
+	bool given[SudokuGrid::CELLS]; /*!< Whether each cell was filled in by the puzzle, so cannot be changed. */
+	std::unique_ptr<ScreenBuffer> ownScreenBuffer; /*!< The game's own screen buffer, or null if it draws on one it was given. */
+	ScreenBuffer& screenBuffer; /*!< The screen buffer for displaying the game. */
+
+	/*!
+	* @brief Prints the grid, with the player's digits in colour.
+	*/
+	void printBoard();
+
+	/*!
+	* @brief Asks whether to return to the menu or exit once the game is over.
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int endGame();
+
+ public:
+	/*!
+	* @brief Constructor for the Sudoku class.
+	* @param buffer The screen buffer to draw on, such as the menu's, or null for the game to make its own.
+	*/
+	explicit Sudoku(ScreenBuffer* buffer = nullptr);
+
+	/*!
+	* @brief Generate a new puzzle.
+	* @param difficulty SudokuSolver::EASY, MEDIUM or HARD.
+	*/
+	void generateBoard(int difficulty);
+
+	/*!
+	* @brief Get the puzzle as the player has filled it in.
+	* @return The grid.
+	*/
+	const SudokuGrid& getGrid() const;
+
+	/*!
+	* @brief Check for valid move input: a row, a column and a digit, such as "3 7 5", with 0 or '.' to clear the cell.
+	* @param input The input from the user
+	* @return true if the input is valid, false otherwise.
+	*/
+	bool isValidInput(const std::string& input) const;
+
+	/*!
+	* @brief Run the game
+	* @return Whether should return to the main menu (0) or exit the program (1)
+	*/
+	int run();
+};
+
+#endif // SUDOKU_H
@@ -0,0 +1,121 @@
+#include "sudokuGrid.h"
+#include <stdexcept>
+
+// Rows, then columns, then boxes
+const int SudokuGrid::UNIT_CELLS[SudokuGrid::UNITS][SudokuGrid::SIZE] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8 },
+    {  9, 10, 11, 12, 13, 14, 15, 16, 17 },
+    { 18, 19, 20, 21, 22, 23, 24, 25, 26 },
+    { 27, 28, 29, 30, 31, 32, 33, 34, 35 },
+    { 36, 37, 38, 39, 40, 41, 42, 43, 44 },
+    { 45, 46, 47, 48, 49, 50, 51, 52, 53 },
+    { 54, 55, 56, 57, 58, 59, 60, 61, 62 },
+    { 63, 64, 65, 66, 67, 68, 69, 70, 71 },
+    { 72, 73, 74, 75, 76, 77, 78, 79, 80 },
+    {  0,  9, 18, 27, 36, 45, 54, 63, 72 },
+    {  1, 10, 19, 28, 37, 46, 55, 64, 73 },
+    {  2, 11, 20, 29, 38, 47, 56, 65, 74 },
+    {  3, 12, 21, 30, 39, 48, 57, 66, 75 },
+    {  4, 13, 22, 31, 40, 49, 58, 67, 76 },
+    {  5, 14, 23, 32, 41, 50, 59, 68, 77 },
+    {  6, 15, 24, 33, 42, 51, 60, 69, 78 },
+    {  7, 16, 25, 34, 43, 52, 61, 70, 79 },
+    {  8, 17, 26, 35, 44, 53, 62, 71, 80 },
+    {  0,  1,  2,  9, 10, 11, 18, 19, 20 },
+    {  3,  4,  5, 12, 13, 14, 21, 22, 23 },
+    {  6,  7,  8, 15, 16, 17, 24, 25, 26 },
+    { 27, 28, 29, 36, 37, 38, 45, 46, 47 },
+    { 30, 31, 32, 39, 40, 41, 48, 49, 50 },
+    { 33, 34, 35, 42, 43, 44, 51, 52, 53 },
+    { 54, 55, 56, 63, 64, 65, 72, 73, 74 },
+    { 57, 58, 59, 66, 67, 68, 75, 76, 77 },
+    { 60, 61, 62, 69, 70, 71, 78, 79, 80 }
+};
+
+
+// Constructor for the SudokuGrid class
+SudokuGrid::SudokuGrid() {
+    clear();
+}
+
+
+// Empties every cell
+void SudokuGrid::clear() {
+    for (int cell = 0; cell < CELLS; cell++) {
+        cells[cell] = 0;
+    }
+    for (int i = 0; i < SIZE; i++) {
+        rows[i] = 0;
+        columns[i] = 0;
+        boxes[i] = 0;
+    }
+    filled = 0;
+}
+
+
+// Sets up the grid from 81 characters
+void SudokuGrid::setFromString(std::string_view text) {
+    if (text.size() != CELLS) {
+        throw std::runtime_error("A Sudoku grid needs 81 cells: " + std::string(text));
+    }
+
+    clear();
+    for (int cell = 0; cell < CELLS; cell++) {
+        char c = text[cell];
+        if (c == '.' || c == '0') {
+            continue;
+        }
+        if (c < '1' || c > '9') {
+            throw std::runtime_error("Bad cell in Sudoku grid: " + std::string(text));
+        }
+        if (!canPlace(cell, c - '0')) {
+            throw std::runtime_error("Digit repeated in Sudoku grid: " + std::string(text));
+        }
+        place(cell, c - '0');
+    }
+}
+
+
+// Gets the grid as 81 characters
+std::string SudokuGrid::toString() const {
+    std::string text(CELLS, '.');
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (cells[cell]) {
+            text[cell] = static_cast<char>('0' + cells[cell]);
+        }
+    }
+    return text;
+}
+
+
+// Checks if a digit can go in a cell
+bool SudokuGrid::canPlace(int cell, int digit) const {
+    return (getCandidates(cell) >> (digit - 1) & 1) != 0;
+}
+
+
+// Puts a digit in a cell
+void SudokuGrid::place(int cell, int digit) {
+    uint16_t bit = static_cast<uint16_t>(1 << (digit - 1));
+
+    cells[cell] = static_cast<uint8_t>(digit);
+    rows[cell / 9] |= bit;
+    columns[cell % 9] |= bit;
+    boxes[boxOf(cell)] |= bit;
+    filled++;
+}
+
+
+// Empties a cell
+void SudokuGrid::erase(int cell) {
+    if (!cells[cell]) {
+        return;
+    }
+
+    uint16_t bit = static_cast<uint16_t>(1 << (cells[cell] - 1));
+    cells[cell] = 0;
+    rows[cell / 9] &= ~bit;
+    columns[cell % 9] &= ~bit;
+    boxes[boxOf(cell)] &= ~bit;
+    filled--;
+}
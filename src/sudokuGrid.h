@@ -0,0 +1,118 @@
+#ifndef SUDOKU_GRID_H
+#define SUDOKU_GRID_H
+
+/*!
+* @file sudokuGrid.h
+* @brief Contains the declaration of the SudokuGrid class, the bitmask core of the Sudoku game.
+* @details Cells are numbered 0 to 80 row by row, so cell = row * 9 + column. Digits are 1 to 9, and a set of digits
+* @details is a 9-bit mask with bit d - 1 standing for digit d.
+*/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*!
+* @class SudokuGrid
+* @brief A Sudoku grid that keeps a mask of the digits used in every row, column and box.
+* @details A cell's candidates are the digits missing from all three of its units, found with two ORs and a NOT,
+* @details so placing, erasing and finding candidates never scan the grid.
+*/
+class SudokuGrid {
+public:
+	static const int SIZE = 9; /*!< The number of rows, columns, boxes and digits. */
+	static const int CELLS = 81; /*!< The number of cells. */
+	static const int UNITS = 27; /*!< The number of rows, columns and boxes together. */
+	static const uint16_t ALL_DIGITS = 0x1FF; /*!< The mask with every digit. */
+
+	static const int UNIT_CELLS[UNITS][SIZE]; /*!< The cells of each row, then each column, then each box. */
+
+private:
+	uint8_t cells[CELLS]; /*!< Each cell's digit, or 0 if it is empty. */
+	uint16_t rows[SIZE]; /*!< The digits used in each row. */
+	uint16_t columns[SIZE]; /*!< The digits used in each column. */
+	uint16_t boxes[SIZE]; /*!< The digits used in each box. */
+	int filled; /*!< The number of cells with a digit. */
+
+public:
+	/*!
+	* @brief Constructor for SudokuGrid, creates an empty grid.
+	*/
+	SudokuGrid();
+
+	/*!
+	* @brief Empty every cell.
+	*/
+	void clear();
+
+	/*!
+	* @brief Set up the grid from 81 characters, row by row: a digit for a filled cell and '.' or '0' for an empty one.
+	* @param text The grid.
+	* @throws runtime_error if the text is not 81 such characters, or a digit appears twice in a unit.
+	*/
+	void setFromString(std::string_view text);
+
+	/*!
+	* @brief Get the grid as 81 characters, with '.' for empty cells.
+	* @return The grid.
+	*/
+	std::string toString() const;
+
+	/*!
+	* @brief Get a cell's digit.
+	* @param cell The cell, 0 to 80.
+	* @return The digit, or 0 if the cell is empty.
+	*/
+	int getCell(int cell) const { return cells[cell]; }
+
+	/*!
+	* @brief Get the digits that can go in a cell without repeating one in its row, column or box.
+	* @param cell The cell, 0 to 80.
+	* @return The candidates as a mask, or 0 if the cell is filled.
+	*/
+	uint16_t getCandidates(int cell) const {
+		return cells[cell] ? 0 : static_cast<uint16_t>(ALL_DIGITS & ~(rows[cell / 9] | columns[cell % 9] | boxes[boxOf(cell)]));
+	}
+
+	/*!
+	* @brief Check if a digit can go in an empty cell.
+	* @param cell The cell, 0 to 80.
+	* @param digit The digit, 1 to 9.
+	* @return true if the cell is empty and the digit is not already in its row, column or box.
+	*/
+	bool canPlace(int cell, int digit) const;
+
+	/*!
+	* @brief Put a digit in an empty cell, which must be allowed by canPlace.
+	* @param cell The cell, 0 to 80.
+	* @param digit The digit, 1 to 9.
+	*/
+	void place(int cell, int digit);
+
+	/*!
+	* @brief Empty a cell.
+	* @param cell The cell, 0 to 80.
+	*/
+	void erase(int cell);
+
+	/*!
+	* @brief Get the number of filled cells.
+	* @return The count.
+	*/
+	int getFilledCount() const { return filled; }
+
+	/*!
+	* @brief Check if every cell is filled; as no digit is ever repeated, the grid is then solved.
+	* @return true for a full grid.
+	*/
+	bool isComplete() const { return filled == CELLS; }
+
+	/*!
+	* @brief Get the box a cell is in.
+	* @param cell The cell, 0 to 80.
+	* @return The box, 0 to 8, numbered row by row.
+	*/
+	static int boxOf(int cell) { return (cell / 27) * 3 + (cell % 9) / 3; }
+};
+
+#endif // SUDOKU_GRID_H
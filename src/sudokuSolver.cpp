@@ -0,0 +1,396 @@
+#include "sudokuSolver.h"
+#include "mappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// The digit of a mask with one bit set
+static inline int digitOf(uint16_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index) + 1;
+#elif defined(__GNUC__)
+    return __builtin_ctz(mask) + 1;
+#else
+    int digit = 1;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        digit++;
+    }
+    return digit;
+#endif
+}
+
+
+// The number of digits in a mask
+static inline int countOf(uint16_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt16(mask));
+#elif defined(__GNUC__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+// The cells sharing a row, column or box with each cell
+static const struct Peers {
+    static const int COUNT = 20;
+    int cells[SudokuGrid::CELLS][COUNT];
+
+    Peers() {
+        for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+            int count = 0;
+            for (int other = 0; other < SudokuGrid::CELLS; other++) {
+                if (other != cell && (other / 9 == cell / 9 || other % 9 == cell % 9 ||
+                    SudokuGrid::boxOf(other) == SudokuGrid::boxOf(cell))) {
+                    cells[cell][count++] = other;
+                }
+            }
+        }
+    }
+} PEERS;
+
+
+// A grid with the candidates of each of its empty cells, kept up to date as digits are placed so the search never
+// has to read them from the masks again; 0 for a filled cell
+struct SearchNode {
+    SudokuGrid grid;
+    uint16_t candidates[SudokuGrid::CELLS];
+};
+
+
+// Reads the candidates of every empty cell, stacking up those with only one; false if a cell has none
+static bool readCandidates(SearchNode& node, int* stack, int& top) {
+    top = 0;
+    for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+        uint16_t candidates = node.grid.getCandidates(cell);
+        node.candidates[cell] = candidates;
+        if (node.grid.getCell(cell)) {
+            continue;
+        }
+        if (candidates == 0) {
+            return false;
+        }
+        if ((candidates & (candidates - 1)) == 0) {
+            stack[top++] = cell;
+        }
+    }
+    return true;
+}
+
+
+// Places the stacked cells and every single they lead to. Placing a digit takes it out of the cell's peers, and any
+// cell left with one candidate goes on the stack in turn, so a chain of naked singles never rescans the grid; false
+// if the grid turns out to have no solution
+static bool placeSingles(SearchNode& node, int* stack, int top, bool hiddenSingles) {
+    for (;;) {
+        // Naked singles: a cell with only one candidate
+        while (top > 0) {
+            int cell = stack[--top];
+            uint16_t bit = node.candidates[cell];
+            if (node.grid.getCell(cell)) {
+                continue;
+            }
+
+            node.grid.place(cell, digitOf(bit));
+            node.candidates[cell] = 0;
+
+            for (int peer : PEERS.cells[cell]) {
+                uint16_t& other = node.candidates[peer];
+                if (!(other & bit)) {
+                    continue;
+                }
+
+                other &= ~bit;
+                if (other == 0) {
+                    return false;
+                }
+                if ((other & (other - 1)) == 0) {
+                    stack[top++] = peer;
+                }
+            }
+        }
+
+        if (!hiddenSingles || node.grid.isComplete()) {
+            return true;
+        }
+
+        // Hidden singles: a digit with only one place in a unit. The cell is narrowed to that digit and placed
+        // with the naked singles, which also catches two units wanting different digits in the same cell
+        for (int unit = 0; unit < SudokuGrid::UNITS; unit++) {
+            const int* cells = SudokuGrid::UNIT_CELLS[unit];
+            uint16_t placed = 0, once = 0, twice = 0;
+
+            // A filled cell has no candidates and an empty one no digit, so neither needs a branch
+            for (int i = 0; i < SudokuGrid::SIZE; i++) {
+                placed |= static_cast<uint16_t>((1 << node.grid.getCell(cells[i])) >> 1);
+                twice |= once & node.candidates[cells[i]];
+                once |= node.candidates[cells[i]];
+            }
+
+            if ((placed | once) != SudokuGrid::ALL_DIGITS) {
+                return false;
+            }
+
+            uint16_t singles = once & ~twice;
+            for (int i = 0; i < SudokuGrid::SIZE && singles; i++) {
+                uint16_t mine = node.candidates[cells[i]] & singles;
+                if (!mine) {
+                    continue;
+                }
+
+                // Two digits that each have only this cell cannot both go in it
+                if (mine & (mine - 1)) {
+                    return false;
+                }
+                if (node.candidates[cells[i]] != mine) {
+                    node.candidates[cells[i]] = mine;
+                    stack[top++] = cells[i];
+                }
+                singles &= ~mine;
+            }
+        }
+
+        if (top == 0) {
+            return true;
+        }
+    }
+}
+
+
+// Searches a grid with no singles left for solutions, guessing in the cell with fewest candidates and filling in
+// singles after every guess, so a wrong guess usually shows up as a contradiction within a step or two
+static void search(const SearchNode& node, int maxSolutions, SudokuGrid* solved, int& found) {
+    if (node.grid.isComplete()) {
+        if (found == 0 && solved) {
+            *solved = node.grid;
+        }
+        found++;
+        return;
+    }
+
+    // Every empty cell has at least two candidates, so a cell with two is as good as any
+    int best = -1, bestCount = SudokuGrid::SIZE + 1;
+    for (int cell = 0; cell < SudokuGrid::CELLS && bestCount > 2; cell++) {
+        int count = countOf(node.candidates[cell]);
+        if (count && count < bestCount) {
+            best = cell;
+            bestCount = count;
+        }
+    }
+
+    int stack[SudokuGrid::CELLS];
+    for (uint16_t candidates = node.candidates[best]; candidates && found < maxSolutions; candidates &= candidates - 1) {
+        SearchNode next = node;
+        next.candidates[best] = static_cast<uint16_t>(candidates & ~(candidates - 1));
+        stack[0] = best;
+        if (placeSingles(next, stack, 1, true)) {
+            search(next, maxSolutions, solved, found);
+        }
+    }
+}
+
+
+// Counts a puzzle's solutions, up to a limit, setting solved to the first if it is not null
+static int searchPuzzle(const SudokuGrid& puzzle, int maxSolutions, SudokuGrid* solved) {
+    SearchNode node;
+    int stack[SudokuGrid::CELLS];
+    int top;
+    int found = 0;
+
+    node.grid = puzzle;
+    if (readCandidates(node, stack, top) && placeSingles(node, stack, top, true)) {
+        search(node, maxSolutions, solved, found);
+    }
+    return found;
+}
+
+
+// Fills in naked and, if asked, hidden singles until there are none left
+bool SudokuSolver::fillSingles(SudokuGrid& grid, bool hiddenSingles) {
+    SearchNode node;
+    int stack[SudokuGrid::CELLS];
+    int top;
+
+    node.grid = grid;
+    bool solvable = readCandidates(node, stack, top) && placeSingles(node, stack, top, hiddenSingles);
+    grid = node.grid;
+    return solvable;
+}
+
+
+// Rates a puzzle by the simplest technique that solves it
+int SudokuSolver::rate(const SudokuGrid& puzzle) {
+    SudokuGrid grid = puzzle;
+
+    if (!fillSingles(grid, false)) {
+        return UNSOLVABLE;
+    }
+    if (grid.isComplete()) {
+        return EASY;
+    }
+    if (!fillSingles(grid, true)) {
+        return UNSOLVABLE;
+    }
+    return grid.isComplete() ? MEDIUM : HARD;
+}
+
+
+// Solves a puzzle with singles, then the search for whatever is left
+bool SudokuSolver::solve(SudokuGrid& grid) {
+    if (!fillSingles(grid, true)) {
+        return false;
+    }
+    if (grid.isComplete()) {
+        return true;
+    }
+
+    SudokuGrid solved;
+    if (searchPuzzle(grid, 1, &solved) != 1) {
+        return false;
+    }
+    grid = solved;
+    return true;
+}
+
+
+// Counts a puzzle's solutions; filling in singles first does not change them
+int SudokuSolver::countSolutions(const SudokuGrid& puzzle, int maxSolutions) {
+    SudokuGrid grid = puzzle;
+
+    if (!fillSingles(grid, true)) {
+        return 0;
+    }
+    if (grid.isComplete()) {
+        return 1;
+    }
+    return searchPuzzle(grid, maxSolutions, nullptr);
+}
+
+
+// Solves every puzzle in some text, one per line
+SudokuBatchStats SudokuSolver::solveBatch(std::string_view text) {
+    SudokuBatchStats stats;
+    SudokuGrid grid;
+    auto start = std::chrono::steady_clock::now();
+
+    size_t position = 0;
+    while (position < text.size()) {
+        size_t end = text.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+
+        std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.remove_suffix(1);
+        }
+        if (line.size() != SudokuGrid::CELLS) {
+            continue;
+        }
+
+        stats.puzzles++;
+        try {
+            grid.setFromString(line);
+        }
+        catch (const std::runtime_error&) {
+            continue;
+        }
+
+        if (!fillSingles(grid, true)) {
+            continue;
+        }
+        if (grid.isComplete()) {
+            stats.bySingles++;
+            stats.solved++;
+        }
+        else if (searchPuzzle(grid, 1, nullptr) == 1) {
+            stats.solved++;
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+
+// Solves every puzzle in a file
+SudokuBatchStats SudokuSolver::solveFile(const std::string& filename) {
+    MappedFile file(filename);
+    return solveBatch(file.view());
+}
+
+
+// Constructor for the SudokuGenerator class
+SudokuGenerator::SudokuGenerator(uint32_t seed) : random(seed) {
+}
+
+
+// Generates a random solved grid from three random boxes on the diagonal
+SudokuGrid SudokuGenerator::generateSolution() {
+    SudokuGrid grid;
+    int digits[SudokuGrid::SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    for (int box = 0; box < SudokuGrid::SIZE; box += 4) {
+        std::shuffle(digits, digits + SudokuGrid::SIZE, random);
+        for (int i = 0; i < SudokuGrid::SIZE; i++) {
+            grid.place(SudokuGrid::UNIT_CELLS[2 * SudokuGrid::SIZE + box][i], digits[i]);
+        }
+    }
+
+    solver.solve(grid);
+    return grid;
+}
+
+
+// Generates a puzzle with one solution by taking clues out of a random solution
+SudokuGrid SudokuGenerator::generate(int difficulty) {
+    SudokuGrid nearest;
+    int nearestDistance = INT_MAX;
+
+    for (int attempt = 0; attempt < ATTEMPTS; attempt++) {
+        SudokuGrid puzzle = generateSolution();
+
+        int order[SudokuGrid::CELLS];
+        for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+            order[cell] = cell;
+        }
+        std::shuffle(order, order + SudokuGrid::CELLS, random);
+
+        for (int cell : order) {
+            int digit = puzzle.getCell(cell);
+            puzzle.erase(cell);
+
+            if (solver.countSolutions(puzzle, 2) != 1 ||
+                (difficulty < SudokuSolver::HARD && SudokuSolver::rate(puzzle) > difficulty)) {
+                puzzle.place(cell, digit);
+            }
+        }
+
+        int rating = SudokuSolver::rate(puzzle);
+        if (rating == difficulty) {
+            return puzzle;
+        }
+        if (std::abs(rating - difficulty) < nearestDistance) {
+            nearest = puzzle;
+            nearestDistance = std::abs(rating - difficulty);
+        }
+    }
+
+    return nearest;
+}
@@ -0,0 +1,128 @@
+#ifndef SUDOKU_SOLVER_H
+#define SUDOKU_SOLVER_H
+
+/*!
+* @file sudokuSolver.h
+* @brief Contains the declaration of the Sudoku solver, its search and the puzzle generator.
+*/
+
+#include "sudokuGrid.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+/*!
+* @struct SudokuBatchStats
+* @brief The result of solving a batch of puzzles.
+*/
+struct SudokuBatchStats {
+	uint64_t puzzles = 0; /*!< The number of puzzles read. */
+	uint64_t solved = 0; /*!< The number that had a solution. */
+	uint64_t bySingles = 0; /*!< The number solved by singles alone, without a search. */
+	double seconds = 0.0; /*!< The time taken. */
+
+	/*!
+	* @brief Get the solving speed.
+	* @return Puzzles per second.
+	*/
+	double puzzlesPerSecond() const { return seconds > 0 ? puzzles / seconds : 0.0; }
+};
+
+/*!
+* @class SudokuSolver
+* @brief Solves Sudoku by filling in singles from the candidate masks, falling back on a search when they stall.
+* @details Most published puzzles fall to naked singles (a cell with one candidate) and hidden singles (a digit with
+* @details one place in a unit), which take a few microseconds; only the hard ones need the search. The search guesses
+* @details in the cell with fewest candidates and fills in singles again after every guess, so a wrong guess usually
+* @details shows up as a contradiction within a step or two.
+*/
+class SudokuSolver {
+public:
+	static const int EASY = 0; /*!< Solved by naked singles alone. */
+	static const int MEDIUM = 1; /*!< Solved by naked and hidden singles. */
+	static const int HARD = 2; /*!< Needs a search. */
+	static const int UNSOLVABLE = -1; /*!< Has no solution. */
+
+	/*!
+	* @brief Fill in singles until there are none left.
+	* @param grid The grid to fill in.
+	* @param hiddenSingles Whether to look for hidden singles as well as naked ones.
+	* @return false if the grid turned out to have no solution: a cell with no candidates, or a digit with no place.
+	*/
+	static bool fillSingles(SudokuGrid& grid, bool hiddenSingles);
+
+	/*!
+	* @brief Rate a puzzle with one solution by the simplest technique that solves it.
+	* @param puzzle The puzzle.
+	* @return EASY, MEDIUM or HARD, or UNSOLVABLE if singles show it has no solution.
+	*/
+	static int rate(const SudokuGrid& puzzle);
+
+	/*!
+	* @brief Solve a puzzle.
+	* @param grid The puzzle, filled in with the solution if there is one.
+	* @return true if the puzzle was solved.
+	*/
+	bool solve(SudokuGrid& grid);
+
+	/*!
+	* @brief Count a puzzle's solutions, up to a limit.
+	* @param puzzle The puzzle.
+	* @param maxSolutions Stop counting at this many; 2 is enough to check a puzzle has exactly one.
+	* @return The number of solutions, at most maxSolutions.
+	*/
+	int countSolutions(const SudokuGrid& puzzle, int maxSolutions);
+
+	/*!
+	* @brief Solve every puzzle in some text, one per line; lines that are not 81 cells are skipped.
+	* @param text The puzzles.
+	* @return The number solved and the time taken.
+	*/
+	SudokuBatchStats solveBatch(std::string_view text);
+
+	/*!
+	* @brief Solve every puzzle in a file, one per line, reading the file in place through a memory mapping.
+	* @param filename The name of the file.
+	* @return The number solved and the time taken.
+	* @throws runtime_error if the file cannot be opened.
+	*/
+	SudokuBatchStats solveFile(const std::string& filename);
+};
+
+/*!
+* @class SudokuGenerator
+* @brief Generates puzzles with exactly one solution, rated by difficulty.
+* @details A random solution is made by filling the three boxes on the diagonal, which cannot clash, with random
+* @details permutations and solving the rest. Clues are then taken out in random order, each only if the puzzle still
+* @details has one solution and, below HARD, can still be solved at the difficulty asked for.
+*/
+class SudokuGenerator {
+private:
+	static const int ATTEMPTS = 20; /*!< How many solutions to try before settling for the nearest difficulty. */
+
+	std::mt19937 random; /*!< The random numbers. */
+	SudokuSolver solver; /*!< The solver checking each puzzle has one solution. */
+
+public:
+	/*!
+	* @brief Constructor for SudokuGenerator.
+	* @param seed The random seed, so the same seed generates the same puzzles.
+	*/
+	explicit SudokuGenerator(uint32_t seed = std::random_device()());
+
+	/*!
+	* @brief Generate a random solved grid.
+	* @return The grid.
+	*/
+	SudokuGrid generateSolution();
+
+	/*!
+	* @brief Generate a puzzle with one solution.
+	* @param difficulty EASY, MEDIUM or HARD.
+	* @return The puzzle, which rates at the difficulty asked for unless no attempt managed it.
+	*/
+	SudokuGrid generate(int difficulty);
+};
+
+#endif // SUDOKU_SOLVER_H
@@ -0,0 +1,29 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+/*!
+* @file benchmarks.h
+* @brief Contains the switch for the benchmarks that are too long to run with every test run.
+*/
+
+#include <cstdlib>
+
+/*!
+* @brief Check if the long benchmarks have been asked for, by setting MINIGAME_BENCHMARKS in the environment.
+* @details Those benchmarks build or write far more than the behaviour they check needs, taking minutes or filling the
+* @details disk, so they only run on request; each of them passes without doing anything otherwise.
+* @return true if they are to run.
+*/
+inline bool benchmarksRequested() {
+#ifdef _MSC_VER
+	char* value = nullptr;
+	size_t length = 0;
+	bool requested = _dupenv_s(&value, &length, "MINIGAME_BENCHMARKS") == 0 && value != nullptr;
+	free(value);
+	return requested;
+#else
+	return std::getenv("MINIGAME_BENCHMARKS") != nullptr;
+#endif
+}
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/checkersAI.h"
+#include "../src/checkersBoard.h"
+#include "../src/chckrs.h"
+#include <chrono>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CheckersTests
+{
+    TEST_CLASS(CheckersBoardTests)
+    {
+    public:
+        // Sets up a position from FEN
+        static CheckersBoard fromFen(const std::string& fen)
+        {
+            CheckersBoard board;
+            board.setFen(fen);
+            return board;
+        }
+
+        // Test perft from the starting position against the published counts
+        TEST_METHOD(PerftStartPosition)
+        {
+            const uint64_t expected[] = { 1, 7, 49, 302, 1469, 7361, 36768, 179740, 845931, 3963680 };
+            CheckersBoard board;
+
+            for (int depth = 0; depth <= 9; depth++) {
+                Assert::AreEqual(expected[depth], board.perft(depth));
+            }
+        }
+
+        // Test perft speed, logging the nodes per second
+        TEST_METHOD(PerftSpeed)
+        {
+            CheckersBoard board;
+
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = board.perft(10);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Assert::AreEqual(static_cast<uint64_t>(18391564), nodes);
+
+            std::string message = "Checkers perft(10): " + std::to_string(nodes) + " nodes in " + std::to_string(seconds) +
+                " s, " + std::to_string(static_cast<uint64_t>(nodes / seconds)) + " nodes/s";
+            Logger::WriteMessage(message.c_str());
+        }
+
+        // Test FEN is read and written back the same, including kings and the side to move
+        TEST_METHOD(FenRoundTrip)
+        {
+            CheckersBoard board;
+            Assert::AreEqual(std::string("B:W21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12"), board.getFen());
+
+            board.setFen("W:W18,K32:BK1,14");
+            Assert::AreEqual(std::string("W:W18,K32:BK1,14"), board.getFen());
+            Assert::AreEqual(CheckersBoard::WHITE, board.getSideToMove());
+            Assert::AreEqual(CheckersBoard::BLACK_KING, board.getPiece(0));
+            Assert::AreEqual(CheckersBoard::BLACK_MAN, board.getPiece(13));
+            Assert::AreEqual(CheckersBoard::WHITE_MAN, board.getPiece(17));
+            Assert::AreEqual(CheckersBoard::WHITE_KING, board.getPiece(31));
+            Assert::AreEqual(CheckersBoard::EMPTY_SQUARE, board.getPiece(5));
+
+            auto badFen = [&board]() { board.setFen("B:W33:B1"); };
+            Assert::ExpectException<std::runtime_error>(badFen);
+        }
+
+        // Test a jump must be taken when there is one
+        TEST_METHOD(CaptureIsCompulsory)
+        {
+            CheckersBoard board = fromFen("B:W18:B1,14");
+            CheckersMoveList list;
+            board.generateMoves(list);
+
+            Assert::AreEqual(1, list.size());
+            Assert::AreEqual(std::string("14x23"), CheckersBoard::moveToString(list[0]));
+
+            board.makeMove(list[0]);
+            Assert::AreEqual(std::string("W:W:B1,23"), board.getFen());
+        }
+
+        // Test a multi-jump is one move that must be followed to the end
+        TEST_METHOD(MultiJump)
+        {
+            CheckersBoard board = fromFen("W:W30:B19,26");
+            CheckersMoveList list;
+            board.generateMoves(list);
+
+            Assert::AreEqual(1, list.size());
+            Assert::AreEqual(std::string("30x23x16"), CheckersBoard::moveToString(list[0]));
+
+            board.makeMove(list[0]);
+            Assert::AreEqual(std::string("B:W16:B"), board.getFen());
+        }
+
+        // Test a man reaching the far row by a jump is crowned and stops, even if the new king could jump on
+        TEST_METHOD(CrowningEndsJump)
+        {
+            CheckersBoard board = fromFen("B:W26,27:B22");
+            CheckersMoveList list;
+            board.generateMoves(list);
+
+            Assert::AreEqual(1, list.size());
+            Assert::AreEqual(std::string("22x31"), CheckersBoard::moveToString(list[0]));
+
+            board.makeMove(list[0]);
+            Assert::AreEqual(CheckersBoard::BLACK_KING, board.getPiece(30));
+            Assert::AreEqual(CheckersBoard::WHITE_MAN, board.getPiece(26));
+        }
+
+        // Test moves are parsed from notation and written back the same
+        TEST_METHOD(ParseMove)
+        {
+            CheckersBoard board;
+
+            CheckersMove move = board.parseMove("11-15");
+            Assert::IsFalse(move.isNull());
+            Assert::AreEqual(std::string("11-15"), CheckersBoard::moveToString(move));
+
+            // Not legal: backwards, too far, off the board and a jump with nothing to jump
+            Assert::IsTrue(board.parseMove("15-11").isNull());
+            Assert::IsTrue(board.parseMove("11-19").isNull());
+            Assert::IsTrue(board.parseMove("33-29").isNull());
+            Assert::IsTrue(board.parseMove("11x18").isNull());
+
+            board = fromFen("W:W30:B19,26");
+            Assert::AreEqual(std::string("30x23x16"), CheckersBoard::moveToString(board.parseMove("30x16")));
+            Assert::AreEqual(std::string("30x23x16"), CheckersBoard::moveToString(board.parseMove("30x23x16")));
+        }
+
+        // Test the game's input check
+        TEST_METHOD(ValidInput)
+        {
+            Checkers game;
+
+            Assert::IsTrue(game.isValidInput("11-15"));
+            Assert::IsTrue(game.isValidInput("22x15x6"));
+            Assert::IsTrue(game.isValidInput("9 - 13"));
+            Assert::IsFalse(game.isValidInput("11"));
+            Assert::IsFalse(game.isValidInput("e2 e4"));
+            Assert::IsFalse(game.isValidInput("111-15"));
+        }
+    };
+
+    TEST_CLASS(CheckersAITests)
+    {
+    public:
+        // Searches a position to a fixed depth and returns the best move in checkers notation
+        static std::string bestMove(const std::string& fen, int depth, int* score = nullptr)
+        {
+            CheckersAI ai(1);
+            CheckersBoard board;
+            board.setFen(fen);
+
+            CheckersSearchResult result = ai.search(board, depth);
+            if (score) {
+                *score = result.score;
+            }
+            return CheckersBoard::moveToString(result.bestMove);
+        }
+
+        // Test the evaluation of the starting position is level
+        TEST_METHOD(EvaluateSymmetry)
+        {
+            CheckersBoard board;
+            Assert::AreEqual(0, CheckersAI::evaluate(board));
+
+            board.setSideToMove(CheckersBoard::WHITE);
+            Assert::AreEqual(0, CheckersAI::evaluate(board));
+        }
+
+        // Test the AI takes the double jump rather than the single jump that loses a piece back
+        TEST_METHOD(TakesBetterJump)
+        {
+            Assert::AreEqual(std::string("9x18x27"), bestMove("B:W8,14,23:B4,9", 6));
+        }
+
+        // Test the AI wins by leaving the last white man with no moves
+        TEST_METHOD(FindsBlockingWin)
+        {
+            int score = 0;
+            Assert::AreEqual(std::string("21-25"), bestMove("B:W29:B21,22", 6, &score));
+            Assert::IsTrue(score >= CheckersAI::WIN_BOUND);
+        }
+
+        // Test a side with no moves has lost
+        TEST_METHOD(NoMovesLoses)
+        {
+            CheckersAI ai(1);
+            CheckersBoard board;
+            board.setFen("W:W29:B22,25");
+
+            CheckersSearchResult result = ai.search(board, 4);
+            Assert::IsTrue(result.bestMove.isNull());
+
+            board.setFen("W:W:B1");
+            result = ai.search(board, 4);
+            Assert::IsTrue(result.bestMove.isNull());
+        }
+
+        // Test a timed search returns a legal move in time from the start
+        TEST_METHOD(TimedSearch)
+        {
+            CheckersAI ai;
+            CheckersBoard board;
+
+            CheckersSearchResult result = ai.search(board, CheckersAI::MAX_PLY, 200);
+            Assert::IsFalse(result.bestMove.isNull());
+            Assert::IsTrue(result.depth >= 6);
+            Assert::IsTrue(result.seconds < 1.0);
+
+            std::string message = "Checkers search: depth " + std::to_string(result.depth) + ", " +
+                std::to_string(result.nodes) + " nodes in " + std::to_string(result.seconds) + " s";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+}
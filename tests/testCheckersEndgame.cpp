@@ -0,0 +1,383 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/checkersAI.h"
+#include "../src/checkersEndgame.h"
+#include "benchmarks.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CheckersTests
+{
+    TEST_CLASS(CheckersEndgameTests)
+    {
+    public:
+        // Builds the database for up to three pieces and writes it to a file
+        static CheckersEndgameBuilder& smallDatabase(const char* filename)
+        {
+            static CheckersEndgameBuilder builder(3);
+            static bool built = false;
+
+            if (!built) {
+                builder.build();
+                built = true;
+            }
+            builder.write(filename);
+            return builder;
+        }
+
+        // A solved database and how long it took to build
+        struct TimedBuild
+        {
+            CheckersEndgameBuilder builder;
+            uint64_t positions;
+            double buildSeconds;
+        };
+
+        // Builds the database for up to a number of pieces, timing the build
+        static TimedBuild timedBuild(int maxPieces)
+        {
+            auto start = std::chrono::steady_clock::now();
+            CheckersEndgameBuilder builder(maxPieces);
+            uint64_t positions = builder.build();
+            double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return { builder, positions, buildSeconds };
+        }
+
+        // Builds the database for up to four pieces, once for all the tests that use it
+        static TimedBuild& fourPieceDatabase()
+        {
+            static TimedBuild build = timedBuild(4);
+            return build;
+        }
+
+        // Checks random positions with the most pieces of a database agree with the positions their moves lead to, and
+        // that its file gives the same values
+        static void checkSample(const CheckersEndgameBuilder& builder, CheckersEndgameDatabase& database, int pieces, int count)
+        {
+            std::vector<EndgameSlice> slices = CheckersEndgame::listSlices(pieces);
+            std::mt19937 random(1);
+            CheckersBoard board;
+            CheckersMoveList list;
+            int checked = 0;
+
+            while (checked < count) {
+                const EndgameSlice& slice = slices[random() % slices.size()];
+                if (slice.pieces() != pieces || !CheckersEndgame::setPosition(board, slice, random() % slice.size())) {
+                    continue;
+                }
+                checked++;
+
+                bool winning = false, drawing = false;
+                board.generateMoves(list);
+                for (const CheckersMove& move : list) {
+                    CheckersBoard child = board;
+                    child.makeMove(move);
+
+                    int childValue = (child.getPieces(CheckersBoard::WHITE) == 0) ? CheckersEndgame::LOSS : builder.probe(child);
+                    Assert::AreNotEqual(CheckersEndgame::UNKNOWN, childValue);
+                    winning = winning || childValue == CheckersEndgame::LOSS;
+                    drawing = drawing || childValue == CheckersEndgame::DRAW;
+                }
+
+                int expected = winning ? CheckersEndgame::WIN : (drawing ? CheckersEndgame::DRAW : CheckersEndgame::LOSS);
+                Assert::AreEqual(expected, builder.probe(board));
+                Assert::AreEqual(expected, database.probe(board));
+            }
+        }
+
+        // Sets up a position from FEN
+        static CheckersBoard fromFen(const std::string& fen)
+        {
+            CheckersBoard board;
+            board.setFen(fen);
+            return board;
+        }
+
+        // Test every index in a slice sets up a position that has that index
+        TEST_METHOD(IndexRoundTrip)
+        {
+            CheckersBoard board;
+
+            for (const EndgameSlice& slice : CheckersEndgame::listSlices(3)) {
+                uint64_t positions = 0;
+                for (uint64_t index = 0; index < slice.size(); index++) {
+                    if (!CheckersEndgame::setPosition(board, slice, index)) {
+                        continue;
+                    }
+                    positions++;
+
+                    EndgameSlice found = CheckersEndgame::getSlice(board);
+                    Assert::AreEqual(slice.blackMen, found.blackMen);
+                    Assert::AreEqual(slice.whiteKings, found.whiteKings);
+                    Assert::AreEqual(index, CheckersEndgame::getIndex(board, slice));
+                }
+                Assert::IsTrue(positions > 0);
+            }
+
+            // The kings of the largest slices are ranked over the squares the men leave free
+            EndgameSlice slice;
+            slice.blackKings = 3;
+            slice.whiteKings = 2;
+            Assert::AreEqual(static_cast<uint64_t>(4960) * 406, slice.size());
+        }
+
+        // Test the slices come fewest pieces first, each next to its colour swapped twin
+        TEST_METHOD(SliceOrder)
+        {
+            std::vector<EndgameSlice> slices = CheckersEndgame::listSlices(4);
+
+            int twoPieceSlices = 0;
+            for (size_t i = 0; i < slices.size(); i++) {
+                const EndgameSlice& slice = slices[i];
+                twoPieceSlices += (slice.pieces() == 2);
+
+                if (i > 0) {
+                    Assert::IsTrue(slices[i - 1].pieces() <= slice.pieces());
+                }
+
+                // The twin is this slice, the one before or the one after
+                bool twinNextTo = false;
+                for (size_t j = (i > 0 ? i - 1 : 0); j <= i + 1 && j < slices.size(); j++) {
+                    twinNextTo = twinNextTo || (slices[j].blackMen == slice.whiteMen && slices[j].blackKings == slice.whiteKings &&
+                        slices[j].whiteMen == slice.blackMen && slices[j].whiteKings == slice.blackKings);
+                }
+                Assert::IsTrue(twinNextTo);
+
+                // Crowning a black man leads to an earlier slice
+                if (slice.blackMen > 0) {
+                    bool found = false;
+                    for (size_t j = 0; j < i; j++) {
+                        found = found || (slices[j].blackMen == slice.blackMen - 1 && slices[j].blackKings == slice.blackKings + 1 &&
+                            slices[j].whiteMen == slice.whiteMen && slices[j].whiteKings == slice.whiteKings);
+                    }
+                    Assert::IsTrue(found);
+                }
+            }
+
+            // A man or a king each side
+            Assert::AreEqual(4, twoPieceSlices);
+        }
+
+        // Test some well known results
+        TEST_METHOD(KnownResults)
+        {
+            CheckersEndgameBuilder& builder = smallDatabase("test_known.endgame");
+
+            // Two kings beat one, whoever is to move
+            Assert::AreEqual(CheckersEndgame::LOSS, builder.probe(fromFen("W:WK14:BK1,K32")));
+            Assert::AreEqual(CheckersEndgame::WIN, builder.probe(fromFen("B:WK14:BK1,K32")));
+
+            // A king each is a draw, unless one can take the other straight away
+            Assert::AreEqual(CheckersEndgame::DRAW, builder.probe(fromFen("B:WK32:BK1")));
+            Assert::AreEqual(CheckersEndgame::WIN, builder.probe(fromFen("B:WK18:BK14")));
+
+            // A side that cannot move has lost
+            Assert::AreEqual(CheckersEndgame::LOSS, builder.probe(fromFen("W:W29:B22,25")));
+
+            // Too many pieces, or a side with none, are not in the database
+            Assert::AreEqual(CheckersEndgame::UNKNOWN, builder.probe(CheckersBoard()));
+            Assert::AreEqual(CheckersEndgame::UNKNOWN, builder.probe(fromFen("B:W:BK1")));
+
+            std::remove("test_known.endgame");
+        }
+
+        // Test every value agrees with the values of the positions its moves lead to
+        TEST_METHOD(ValuesAreConsistent)
+        {
+            CheckersEndgameBuilder& builder = smallDatabase("test_consistent.endgame");
+            CheckersBoard board;
+            CheckersMoveList list;
+
+            for (const EndgameSlice& slice : CheckersEndgame::listSlices(3)) {
+                for (uint64_t index = 0; index < slice.size(); index++) {
+                    if (!CheckersEndgame::setPosition(board, slice, index)) {
+                        continue;
+                    }
+
+                    bool winning = false, drawing = false;
+                    board.generateMoves(list);
+                    for (const CheckersMove& move : list) {
+                        CheckersBoard child = board;
+                        child.makeMove(move);
+
+                        int childValue = (child.getPieces(CheckersBoard::WHITE) == 0) ? CheckersEndgame::LOSS : builder.probe(child);
+                        Assert::AreNotEqual(CheckersEndgame::UNKNOWN, childValue);
+                        winning = winning || childValue == CheckersEndgame::LOSS;
+                        drawing = drawing || childValue == CheckersEndgame::DRAW;
+                    }
+
+                    int expected = winning ? CheckersEndgame::WIN : (drawing ? CheckersEndgame::DRAW : CheckersEndgame::LOSS);
+                    Assert::AreEqual(expected, builder.probe(board));
+                }
+            }
+
+            std::remove("test_consistent.endgame");
+        }
+
+        // Test the file gives the same values as the builder, through a cache small enough to keep evicting blocks
+        TEST_METHOD(FileMatchesBuilder)
+        {
+            CheckersEndgameBuilder& builder = smallDatabase("test_file.endgame");
+            CheckersEndgameDatabase database("test_file.endgame", 2);
+            CheckersBoard board;
+
+            Assert::AreEqual(3, database.getMaxPieces());
+
+            // Each side to move, as white to move is looked up turned round
+            for (int side = CheckersBoard::BLACK; side <= CheckersBoard::WHITE; side++) {
+                for (const EndgameSlice& slice : CheckersEndgame::listSlices(3)) {
+                    for (uint64_t index = 0; index < slice.size(); index++) {
+                        if (CheckersEndgame::setPosition(board, slice, index)) {
+                            board.setSideToMove(side);
+                            Assert::AreEqual(builder.probe(board), database.probe(board));
+                        }
+                    }
+                }
+            }
+
+            Assert::IsTrue(database.getBlockLoads() > 2);
+            Assert::IsTrue(database.getBlockLoads() < database.getProbes());
+
+            std::remove("test_file.endgame");
+        }
+
+        // Test a file that is not a database is refused
+        TEST_METHOD(BadDatabaseFile)
+        {
+            {
+                std::ofstream file("test_bad.endgame", std::ios::binary);
+                file << "MGOB not an endgame database at all";
+            }
+
+            auto openBad = []() { CheckersEndgameDatabase database("test_bad.endgame"); };
+            Assert::ExpectException<std::runtime_error>(openBad);
+
+            auto openMissing = []() { CheckersEndgameDatabase database("test_missing.endgame"); };
+            Assert::ExpectException<std::runtime_error>(openMissing);
+
+            auto buildTooMany = []() { CheckersEndgameBuilder builder(CheckersEndgame::MAX_PIECES + 1); };
+            Assert::ExpectException<std::runtime_error>(buildTooMany);
+
+            std::remove("test_bad.endgame");
+        }
+
+        // Test the search scores endings from the database and converts a won one
+        TEST_METHOD(SearchUsesDatabase)
+        {
+            smallDatabase("test_search.endgame");
+            CheckersEndgameDatabase database("test_search.endgame");
+            CheckersAI ai(1);
+            ai.setEndgameDatabase(&database);
+
+            // Two kings against one: the search knows it is won without seeing the capture
+            CheckersBoard board = fromFen("B:WK14:BK1,K32");
+            CheckersSearchResult result = ai.search(board, 4);
+            Assert::IsTrue(result.databaseHits > 0);
+            Assert::IsTrue(result.score >= CheckersAI::DATABASE_WIN_SCORE - 1000);
+
+            // Playing the ending out, black catches the lone king well inside the draw limit
+            for (int ply = 0; ply < CheckersBoard::DRAW_PLIES; ply++) {
+                CheckersMoveList list;
+                board.generateMoves(list);
+                if (list.size() == 0) {
+                    break;
+                }
+
+                board.makeMove(ai.search(board, 8).bestMove);
+            }
+            Assert::AreEqual(0u, board.getPieces(CheckersBoard::WHITE));
+
+            std::remove("test_search.endgame");
+        }
+
+        // Test a sample of the four piece database, as the largest build is too long for every test run
+        TEST_METHOD(FourPieceBuild)
+        {
+            TimedBuild& build = fourPieceDatabase();
+            build.builder.write("test_four.endgame");
+            CheckersEndgameDatabase database("test_four.endgame");
+
+            Assert::AreEqual(4, database.getMaxPieces());
+            checkSample(build.builder, database, 4, 20000);
+
+            std::remove("test_four.endgame");
+        }
+
+        // Benchmark a build with the most pieces, checking a sample of it and logging the build time and size
+        TEST_METHOD(LargestBuild)
+        {
+            if (!benchmarksRequested()) {
+                Logger::WriteMessage("Skipped; set MINIGAME_BENCHMARKS to build the largest endgame database");
+                return;
+            }
+
+            TimedBuild build = timedBuild(CheckersEndgame::MAX_PIECES);
+            uint64_t bytes = build.builder.write("test_largest.endgame");
+            CheckersEndgameDatabase database("test_largest.endgame");
+
+            // Three kings beat two, whoever is to move
+            Assert::AreEqual(CheckersEndgame::WIN, database.probe(fromFen("B:WK14,K23:BK1,K3,K32")));
+            Assert::AreEqual(CheckersEndgame::LOSS, database.probe(fromFen("W:WK14,K23:BK1,K3,K32")));
+
+            checkSample(build.builder, database, CheckersEndgame::MAX_PIECES, 20000);
+
+            std::string message = "Checkers endgame database, " + std::to_string(CheckersEndgame::MAX_PIECES) + " pieces: " +
+                std::to_string(build.positions) + " positions built in " + std::to_string(build.buildSeconds) + " s, " +
+                std::to_string(bytes) + " bytes";
+            Logger::WriteMessage(message.c_str());
+
+            std::remove("test_largest.endgame");
+        }
+
+        // Test probe speed over random positions, logging the build time and probes per second
+        TEST_METHOD(ProbeSpeed)
+        {
+            TimedBuild& build = fourPieceDatabase();
+            uint64_t bytes = build.builder.write("test_speed.endgame");
+
+            CheckersEndgameDatabase database("test_speed.endgame", 64);
+            std::vector<EndgameSlice> slices = CheckersEndgame::listSlices(4);
+            std::mt19937 random(1);
+            CheckersBoard board;
+
+            // Random positions first, which mostly miss the cache, then a walk through one slice as a search would
+            std::vector<CheckersBoard> boards;
+            while (boards.size() < 100000) {
+                const EndgameSlice& slice = slices[random() % slices.size()];
+                if (CheckersEndgame::setPosition(board, slice, random() % slice.size())) {
+                    boards.push_back(board);
+                }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            int wins = 0;
+            for (const CheckersBoard& position : boards) {
+                wins += (database.probe(position) == CheckersEndgame::WIN);
+            }
+            double randomSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            for (uint64_t index = 0; index < slices.back().size(); index++) {
+                if (CheckersEndgame::setPosition(board, slices.back(), index)) {
+                    wins += (database.probe(board) == CheckersEndgame::WIN);
+                }
+            }
+            double walkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Assert::IsTrue(wins > 0);
+
+            std::string message = "Checkers endgame database, 4 pieces: " + std::to_string(build.positions) + " positions built in " +
+                std::to_string(build.buildSeconds) + " s, " + std::to_string(bytes) + " bytes; " +
+                std::to_string(static_cast<uint64_t>(boards.size() / randomSeconds)) + " random probes/s, " +
+                std::to_string(static_cast<uint64_t>(slices.back().size() / walkSeconds)) + " sequential probes/s";
+            Logger::WriteMessage(message.c_str());
+
+            std::remove("test_speed.endgame");
+        }
+    };
+}
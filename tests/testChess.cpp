@@ -0,0 +1,225 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/chessBoard.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ChessTests
+{
+    TEST_CLASS(ChessBoardTests)
+    {
+    public:
+        // Runs perft on a position and checks the node counts for each depth
+        static void checkPerft(std::string_view fen, const uint64_t* expected, int depths)
+        {
+            ChessBoard board;
+            board.setFen(fen);
+
+            for (int depth = 1; depth <= depths; depth++) {
+                Assert::AreEqual(expected[depth - 1], board.perft(depth));
+            }
+
+            // Perft must leave the position as it found it
+            Assert::AreEqual(fen, board.getFen());
+        }
+
+        // Test the starting position
+        TEST_METHOD(PerftStartPosition)
+        {
+            const uint64_t expected[] = { 20, 400, 8902, 197281, 4865609 };
+            checkPerft(ChessBoard::START_FEN, expected, 5);
+        }
+
+        // Test "Kiwipete", which is full of castling, pins and en passant
+        TEST_METHOD(PerftKiwipete)
+        {
+            const uint64_t expected[] = { 48, 2039, 97862, 4085603 };
+            checkPerft("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", expected, 4);
+        }
+
+        // Test an endgame with discovered checks and en passant pins along the rank
+        TEST_METHOD(PerftRookEndgame)
+        {
+            const uint64_t expected[] = { 14, 191, 2812, 43238, 674624 };
+            checkPerft("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", expected, 5);
+        }
+
+        // Test a position full of promotions
+        TEST_METHOD(PerftPromotions)
+        {
+            const uint64_t expected[] = { 6, 264, 9467, 422333 };
+            checkPerft("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", expected, 4);
+        }
+
+        // Test a middlegame position with a promotion capture
+        TEST_METHOD(PerftMiddlegame)
+        {
+            const uint64_t expected[] = { 44, 1486, 62379, 2103487 };
+            checkPerft("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", expected, 4);
+        }
+
+        // Test a quiet symmetrical middlegame
+        TEST_METHOD(PerftSymmetrical)
+        {
+            const uint64_t expected[] = { 46, 2079, 89890, 3894594 };
+            checkPerft("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", expected, 4);
+        }
+
+        // Test FEN is read and written back unchanged
+        TEST_METHOD(FenRoundTrip)
+        {
+            ChessBoard board;
+            const std::string fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1P/PPPBBPpP/R3K2R b Kq e3 3 17";
+            board.setFen(fen);
+            Assert::AreEqual(fen, board.getFen());
+        }
+
+        // Test making and taking back moves, including castling, en passant and promotion
+        TEST_METHOD(MakeUnmakeMove)
+        {
+            ChessBoard board;
+            board.setFen("r3k2r/1P6/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1");
+            const std::string fen = board.getFen();
+
+            const char* moves[] = { "e1g1", "e1c1", "e5d6", "b7a8q", "b7b8n" };
+            for (const char* text : moves) {
+                ChessMove move = board.parseMove(text);
+                Assert::IsFalse(move.isNull());
+                board.makeMove(move);
+                board.unmakeMove();
+                Assert::AreEqual(fen, board.getFen());
+            }
+
+            board.makeMove(board.parseMove("e5d6"));
+            Assert::IsTrue(board.getPiece(35) < 0);
+        }
+
+        // Test moves are parsed and illegal moves rejected
+        TEST_METHOD(ParseMove)
+        {
+            ChessBoard board;
+            Assert::AreEqual(std::string("e2e4"), ChessBoard::moveToString(board.parseMove("e2e4")));
+            Assert::IsTrue(board.parseMove("e2e5").isNull());
+            Assert::IsTrue(board.parseMove("e7e5").isNull());
+        }
+
+        // Test check detection
+        TEST_METHOD(Check)
+        {
+            ChessBoard board;
+            board.setFen("rnbqkbnr/ppppp2p/5p2/6pQ/4P3/8/PPPP1PPP/RNB1KBNR b KQkq - 1 3");
+            Assert::IsTrue(board.isInCheck());
+
+            ChessMoveList moves;
+            board.generateLegalMoves(moves);
+            Assert::AreEqual(0, moves.size());
+        }
+
+        // Walks the move tree checking the incremental key against one calculated from scratch
+        static void checkHashes(ChessBoard& board, int depth)
+        {
+            Assert::AreEqual(board.computeHash(), board.getHash());
+            if (depth == 0) {
+                return;
+            }
+
+            ChessMoveList moves;
+            board.generateLegalMoves(moves);
+            for (ChessMove move : moves) {
+                uint64_t before = board.getHash();
+                board.makeMove(move);
+                checkHashes(board, depth - 1);
+                board.unmakeMove();
+                Assert::AreEqual(before, board.getHash());
+            }
+        }
+
+        // Test the Zobrist key is kept up to date through castling, en passant, promotions and null moves
+        TEST_METHOD(ZobristIncremental)
+        {
+            ChessBoard board;
+            board.setFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+            checkHashes(board, 3);
+
+            board.setFen("n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1");
+            checkHashes(board, 3);
+
+            uint64_t before = board.getHash();
+            board.makeNullMove();
+            Assert::AreNotEqual(before, board.getHash());
+            Assert::AreEqual(board.computeHash(), board.getHash());
+            board.unmakeMove();
+            Assert::AreEqual(before, board.getHash());
+
+            // The same position reached by different move orders has the same key
+            ChessBoard first, second;
+            const char* firstMoves[] = { "g1f3", "g8f6", "b1c3" };
+            const char* secondMoves[] = { "b1c3", "g8f6", "g1f3" };
+            for (int i = 0; i < 3; i++) {
+                first.makeMove(first.parseMove(firstMoves[i]));
+                second.makeMove(second.parseMove(secondMoves[i]));
+            }
+            Assert::AreEqual(first.getHash(), second.getHash());
+        }
+
+        // Test a repeated position is detected
+        TEST_METHOD(Repetition)
+        {
+            ChessBoard board;
+            const char* moves[] = { "g1f3", "g8f6", "f3g1", "f6g8" };
+
+            for (const char* move : moves) {
+                Assert::IsFalse(board.isRepetition());
+                board.makeMove(board.parseMove(move));
+            }
+            Assert::IsTrue(board.isRepetition());
+        }
+
+        // Test standard algebraic notation both ways
+        TEST_METHOD(StandardAlgebraicNotation)
+        {
+            ChessBoard board;
+            board.setFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+            ChessMoveList moves;
+            board.generateLegalMoves(moves);
+            for (ChessMove move : moves) {
+                Assert::IsTrue(move == board.parseSan(board.moveToSan(move)));
+            }
+
+            Assert::AreEqual(std::string("O-O"), board.moveToSan(board.parseMove("e1g1")));
+            Assert::AreEqual(std::string("Qxf6"), board.moveToSan(board.parseMove("f3f6")));
+            Assert::AreEqual(std::string("dxe6"), board.moveToSan(board.parseMove("d5e6")));
+            Assert::AreEqual(std::string("Rb1"), board.moveToSan(board.parseMove("a1b1")));
+            Assert::AreEqual(std::string("e1c1"), ChessBoard::moveToString(board.parseSan("0-0-0")));
+            Assert::IsTrue(board.parseSan("Nf9").isNull());
+
+            board.setFen("4k3/8/8/R7/8/8/8/RN2KN2 w - - 0 1");
+            Assert::AreEqual(std::string("Nbd2"), board.moveToSan(board.parseMove("b1d2")));
+            Assert::AreEqual(std::string("R1a3"), board.moveToSan(board.parseMove("a1a3")));
+            Assert::AreEqual(std::string("f1d2"), ChessBoard::moveToString(board.parseSan("Nfd2")));
+            Assert::IsTrue(board.parseSan("Nd2").isNull());
+
+            board.setFen("7k/1P6/8/8/8/8/8/K7 w - - 0 1");
+            Assert::AreEqual(std::string("b8=Q+"), board.moveToSan(board.parseMove("b7b8q")));
+            Assert::AreEqual(std::string("b7b8n"), ChessBoard::moveToString(board.parseSan("b8N")));
+        }
+
+        // Report perft speed from the starting position
+        TEST_METHOD(PerftSpeed)
+        {
+            ChessBoard board;
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = board.perft(5);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::string message = "perft(5) " + std::to_string(nodes) + " nodes, " +
+                std::to_string(static_cast<uint64_t>(nodes / (seconds > 0 ? seconds : 1e-9))) + " nodes/sec";
+            Logger::WriteMessage(message.c_str());
+            Assert::AreEqual(uint64_t(4865609), nodes);
+        }
+    };
+}
@@ -0,0 +1,244 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/chessAI.h"
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ChessTests
+{
+    TEST_CLASS(ChessAITests)
+    {
+    public:
+        // Searches a position to a fixed depth and returns the best move in coordinate notation
+        static std::string bestMove(const std::string& fen, int depth)
+        {
+            TranspositionTable table(1);
+            ChessAI ai(table);
+            ChessBoard board;
+            board.setFen(fen);
+
+            SearchLimits limits;
+            limits.maxDepth = depth;
+            SearchResult result = ai.search(board, limits);
+
+            // The search must leave the position as it found it
+            Assert::AreEqual(fen, board.getFen());
+            return ChessBoard::moveToString(result.bestMove);
+        }
+
+        // Test the transposition table keeps entries, including negative scores
+        TEST_METHOD(TranspositionTableStoreProbe)
+        {
+            TranspositionTable table(1);
+            TranspositionEntry entry;
+            ChessMove move(12, 28, ChessMove::DOUBLE_PUSH);
+
+            Assert::IsFalse(table.probe(0x1234, entry));
+            table.store(0x1234, move, -250, 7, TranspositionTable::BOUND_LOWER);
+
+            Assert::IsTrue(table.probe(0x1234, entry));
+            Assert::IsTrue(entry.move == move);
+            Assert::AreEqual(-250, entry.score);
+            Assert::AreEqual(7, entry.depth);
+            Assert::AreEqual(TranspositionTable::BOUND_LOWER, entry.bound);
+
+            // A different key in the same slot is a miss
+            Assert::IsFalse(table.probe(0x1234 + table.size(), entry));
+
+            table.clear();
+            Assert::IsFalse(table.probe(0x1234, entry));
+        }
+
+        // Test the evaluation is symmetrical
+        TEST_METHOD(EvaluateSymmetry)
+        {
+            ChessBoard board;
+            Assert::AreEqual(0, ChessAI::evaluate(board));
+
+            board.setFen("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+            int white = ChessAI::evaluate(board);
+            board.setFen("rnbqkb1r/pppp1ppp/5n2/4p3/4P3/2N5/PPPP1PPP/R1BQKBNR b KQkq - 2 3");
+            Assert::AreEqual(white, ChessAI::evaluate(board));
+        }
+
+        // Test mate in one is found
+        TEST_METHOD(MateInOne)
+        {
+            Assert::AreEqual(std::string("d1d8"), bestMove("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", 4));
+            Assert::AreEqual(std::string("h5f7"), bestMove("r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 0 1", 4));
+        }
+
+        // Test a mate in two needing a quiet first move, and that the score says so
+        TEST_METHOD(MateInTwo)
+        {
+            TranspositionTable table(1);
+            ChessAI ai(table);
+            ChessBoard board;
+            board.setFen("7k/8/5K2/8/8/8/8/6R1 w - - 0 1");
+
+            SearchLimits limits;
+            limits.maxDepth = 6;
+            SearchResult result = ai.search(board, limits);
+
+            Assert::AreEqual(ChessAI::MATE_SCORE - 3, result.score);
+            Assert::IsFalse(result.principalVariation.empty());
+            Assert::IsTrue(result.principalVariation[0] == result.bestMove);
+        }
+
+        // Test hanging material is taken, and the quiescence search sees a defended piece is not hanging
+        TEST_METHOD(WinsMaterial)
+        {
+            Assert::AreEqual(std::string("d2d5"), bestMove("4k3/8/8/3q4/8/8/3R4/3K4 w - - 0 1", 3));
+            Assert::AreNotEqual(std::string("d2d5"), bestMove("4k3/8/4p3/3r4/8/8/3Q4/3K4 w - - 0 1", 3));
+        }
+
+        // Test the search keeps to its time budget
+        TEST_METHOD(TimeBudget)
+        {
+            TranspositionTable table(4);
+            ChessAI ai(table);
+            ChessBoard board;
+
+            SearchLimits limits;
+            limits.moveTimeMs = 200;
+
+            auto start = std::chrono::steady_clock::now();
+            SearchResult result = ai.search(board, limits);
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            Assert::IsFalse(result.bestMove.isNull());
+            Assert::IsTrue(result.depth >= 3);
+            Assert::IsTrue(milliseconds < 250);
+        }
+
+        // Test the node limit, and that a search with no legal moves returns the null move
+        TEST_METHOD(NodeLimitAndNoMoves)
+        {
+            TranspositionTable table(1);
+            ChessAI ai(table);
+            ChessBoard board;
+
+            SearchLimits limits;
+            limits.maxNodes = 5000;
+            SearchResult result = ai.search(board, limits);
+            Assert::IsFalse(result.bestMove.isNull());
+            Assert::IsTrue(result.nodes <= 5000 + 1024);
+
+            board.setFen("rnbqkbnr/ppppp2p/5p2/6pQ/4P3/8/PPPP1PPP/RNB1KBNR b KQkq - 1 3");
+            Assert::IsTrue(ai.search(board, limits).bestMove.isNull());
+        }
+
+        // Test the EPD runner and report the solve rate and speed
+        TEST_METHOD(EpdSuite)
+        {
+            std::istringstream suite(
+                "# Short tactical suite\n"
+                "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - bm Rd8#; id \"back rank\";\n"
+                "r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - bm Qxf7#; id \"scholar\";\n"
+                "4k3/8/8/3q4/8/8/3R4/3K4 w - - bm Rxd5; id \"hanging queen\";\n"
+                "4k3/8/4p3/3r4/8/8/3Q4/3K4 w - - am Qxd5; id \"defended rook\";\n"
+                "\n"
+                "7k/8/5K2/8/8/8/8/6R1 w - - bm Kf7; id \"mate in two\";\n");
+
+            TranspositionTable table(4);
+            ChessAI ai(table);
+            SearchLimits limits;
+            limits.maxDepth = 6;
+            limits.moveTimeMs = 2000;
+
+            EpdResult result = ai.runEpdSuite(suite, limits);
+
+            std::string message = "EPD suite: " + std::to_string(result.solved) + "/" + std::to_string(result.positions) +
+                " solved, " + std::to_string(static_cast<uint64_t>(result.nodesPerSecond())) + " nodes/sec";
+            Logger::WriteMessage(message.c_str());
+
+            Assert::AreEqual(5, result.positions);
+            Assert::AreEqual(5, result.solved);
+            Assert::AreEqual(1.0, result.solveRate());
+        }
+
+        // Test one thread gives exactly the same search as ChessAI on its own, every time
+        TEST_METHOD(LazySmpSingleThreadDeterministic)
+        {
+            const std::string fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+            ChessBoard board;
+            board.setFen(fen);
+
+            SearchLimits limits;
+            limits.maxDepth = 5;
+
+            TranspositionTable plainTable(4);
+            ChessAI ai(plainTable);
+            SearchResult expected = ai.search(board, limits);
+
+            for (int run = 0; run < 2; run++) {
+                TranspositionTable table(4);
+                LazySmpSearch search(table, 1);
+                SearchResult result = search.search(board, limits);
+
+                Assert::IsTrue(expected.bestMove == result.bestMove);
+                Assert::AreEqual(expected.score, result.score);
+                Assert::AreEqual(expected.nodes, result.nodes);
+            }
+            Assert::AreEqual(fen, board.getFen());
+        }
+
+        // Test several threads still find a forced mate and keep to the time budget
+        TEST_METHOD(LazySmpMultiThread)
+        {
+            TranspositionTable table(4);
+            LazySmpSearch search(table, 4);
+            Assert::AreEqual(4, search.getThreadCount());
+
+            ChessBoard board;
+            board.setFen("7k/8/5K2/8/8/8/8/6R1 w - - 0 1");
+            SearchLimits limits;
+            limits.maxDepth = 6;
+            Assert::AreEqual(ChessAI::MATE_SCORE - 3, search.search(board, limits).score);
+
+            board.setStartPosition();
+            limits.maxDepth = 64;
+            limits.moveTimeMs = 200;
+
+            auto start = std::chrono::steady_clock::now();
+            SearchResult result = search.search(board, limits);
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            Assert::IsFalse(result.bestMove.isNull());
+            Assert::IsTrue(milliseconds < 300);
+        }
+
+        // Report node counts and time to depth at 1, 2, 4, 8 and 16 threads
+        TEST_METHOD(LazySmpScaling)
+        {
+            ChessBoard board;
+            board.setFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+            TranspositionTable table(16);
+            LazySmpSearch search(table);
+
+            const int threadCounts[] = { 1, 2, 4, 8, 16 };
+            for (int threads : threadCounts) {
+                search.setThreadCount(threads);
+                SmpTiming timing = search.timeToDepth(board, 7);
+
+                std::string message = std::to_string(timing.threads) + " threads: depth " + std::to_string(timing.depth) +
+                    " in " + std::to_string(timing.seconds) + " s, " + std::to_string(timing.nodes) + " nodes";
+                Logger::WriteMessage(message.c_str());
+
+                Assert::AreEqual(7, timing.depth);
+            }
+        }
+
+        // Test a missing EPD file is reported
+        TEST_METHOD(EpdFileMissing)
+        {
+            TranspositionTable table(1);
+            ChessAI ai(table);
+
+            Assert::ExpectException<std::runtime_error>([&]() { ai.runEpdFile("no such file.epd", SearchLimits()); });
+        }
+    };
+}
@@ -0,0 +1,174 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/fourPlayerChess.h"
+#include <chrono>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace FourPlayerChessTests
+{
+    TEST_CLASS(FourPlayerChessBoardTests)
+    {
+    public:
+        // Puts the four kings on squares well away from each other
+        static void placeKings(FourPlayerChessBoard& board)
+        {
+            board.clear();
+            board.putPiece(FourPlayerChessBoard::RED, KING, FourPlayerChessBoard::parseSquare("h1"));
+            board.putPiece(FourPlayerChessBoard::BLUE, KING, FourPlayerChessBoard::parseSquare("a7"));
+            board.putPiece(FourPlayerChessBoard::YELLOW, KING, FourPlayerChessBoard::parseSquare("g14"));
+            board.putPiece(FourPlayerChessBoard::GREEN, KING, FourPlayerChessBoard::parseSquare("n8"));
+        }
+
+        // Test the cut corners
+        TEST_METHOD(ValidSquares)
+        {
+            int count = 0;
+            for (int row = 0; row < FourPlayerChessBoard::SIZE; row++) {
+                for (int column = 0; column < FourPlayerChessBoard::SIZE; column++) {
+                    if (FourPlayerChessBoard::isValidSquare(row, column)) {
+                        count++;
+                    }
+                }
+            }
+
+            Assert::AreEqual(160, count);
+            Assert::IsFalse(FourPlayerChessBoard::isValidSquare(2, 2));
+            Assert::IsTrue(FourPlayerChessBoard::isValidSquare(2, 3));
+            Assert::AreEqual(-1, FourPlayerChessBoard::parseSquare("c3"));
+            Assert::AreEqual(std::string("n11"), FourPlayerChessBoard::squareToString(FourPlayerChessBoard::parseSquare("n11")));
+        }
+
+        // Test every player has twenty moves at the start. Red's first move can already get in Blue's way:
+        // d2d4 blocks b4d4, and f2f3 or f2f4 opens the queen's diagonal to pin the pawn on b6.
+        TEST_METHOD(PerftStartPosition)
+        {
+            FourPlayerChessBoard board;
+
+            Assert::AreEqual(uint64_t(20), board.perft(1));
+            Assert::AreEqual(uint64_t(20 * 20 - 5), board.perft(2));
+            Assert::AreEqual(uint64_t(7800), board.perft(3));
+            Assert::AreEqual(FourPlayerChessBoard::RED, board.getCurrentPlayer());
+        }
+
+        // Test each player's pawns move in their own direction
+        TEST_METHOD(PawnDirections)
+        {
+            FourPlayerChessBoard board;
+
+            Assert::IsFalse(board.parseMove("e2e4").isNull());
+            board.makeMove(board.parseMove("e2e4"));
+            Assert::AreEqual(FourPlayerChessBoard::BLUE, board.getCurrentPlayer());
+
+            Assert::IsFalse(board.parseMove("b4d4").isNull());
+            board.makeMove(board.parseMove("b4c4"));
+            Assert::AreEqual(FourPlayerChessBoard::YELLOW, board.getCurrentPlayer());
+
+            Assert::IsFalse(board.parseMove("d13d11").isNull());
+            board.makeMove(board.parseMove("d13d12"));
+
+            Assert::IsFalse(board.parseMove("m4k4").isNull());
+            Assert::IsTrue(board.parseMove("m4n4").isNull());
+        }
+
+        // Test knights cannot jump into the cut corners
+        TEST_METHOD(KnightNearCorner)
+        {
+            FourPlayerChessBoard board;
+            placeKings(board);
+            board.putPiece(FourPlayerChessBoard::RED, KNIGHT, FourPlayerChessBoard::parseSquare("d4"));
+
+            // From d4 only b5, c6, e6, f5, f3 and e2 are on the board, plus five king moves from h1
+            Assert::AreEqual(uint64_t(6 + 5), board.perft(1));
+        }
+
+        // Test a pinned piece can only move along the pin
+        TEST_METHOD(PinnedRook)
+        {
+            FourPlayerChessBoard board;
+            placeKings(board);
+            board.putPiece(FourPlayerChessBoard::RED, ROOK, FourPlayerChessBoard::parseSquare("h3"));
+            board.putPiece(FourPlayerChessBoard::YELLOW, QUEEN, FourPlayerChessBoard::parseSquare("h10"));
+
+            FourPlayerMoveList moves;
+            board.generateLegalMoves(moves);
+
+            for (const FourPlayerMove& move : moves) {
+                if (move.from == FourPlayerChessBoard::parseSquare("h3")) {
+                    Assert::AreEqual(7, move.to % FourPlayerChessBoard::SIZE);
+                }
+            }
+            Assert::IsFalse(board.parseMove("h3h10").isNull());
+        }
+
+        // Test an eliminated player's pieces no longer give check and their turn is skipped
+        TEST_METHOD(EliminatedPlayer)
+        {
+            FourPlayerChessBoard board;
+            placeKings(board);
+            board.putPiece(FourPlayerChessBoard::BLUE, ROOK, FourPlayerChessBoard::parseSquare("e1"));
+
+            Assert::IsTrue(board.isInCheck(FourPlayerChessBoard::RED));
+            board.eliminatePlayer(FourPlayerChessBoard::BLUE);
+            Assert::IsFalse(board.isInCheck(FourPlayerChessBoard::RED));
+            Assert::AreEqual(3, board.getActivePlayerCount());
+
+            board.makeMove(board.parseMove("h1h2"));
+            Assert::AreEqual(FourPlayerChessBoard::YELLOW, board.getCurrentPlayer());
+        }
+
+        // Test promotion on the middle line, and that unmaking restores the pawn and material
+        TEST_METHOD(Promotion)
+        {
+            FourPlayerChessBoard board;
+            placeKings(board);
+            board.putPiece(FourPlayerChessBoard::RED, PAWN, FourPlayerChessBoard::parseSquare("e7"));
+            int material = board.getMaterial(FourPlayerChessBoard::RED);
+
+            FourPlayerMove move = board.parseMove("e7e8");
+            Assert::IsTrue(move.isPromotion());
+
+            board.makeMove(move);
+            Assert::AreEqual(FourPlayerChessBoard::RED * 8 + QUEEN, board.getPiece(FourPlayerChessBoard::parseSquare("e8")));
+
+            board.unmakeMove();
+            Assert::AreEqual(FourPlayerChessBoard::RED * 8 + PAWN, board.getPiece(FourPlayerChessBoard::parseSquare("e7")));
+            Assert::AreEqual(material, board.getMaterial(FourPlayerChessBoard::RED));
+        }
+
+        // Test both searches take a queen left hanging
+        TEST_METHOD(SearchTakesQueen)
+        {
+            FourPlayerChessBoard board;
+            placeKings(board);
+            board.putPiece(FourPlayerChessBoard::RED, ROOK, FourPlayerChessBoard::parseSquare("f4"));
+            board.putPiece(FourPlayerChessBoard::GREEN, QUEEN, FourPlayerChessBoard::parseSquare("f11"));
+
+            FourPlayerMove paranoidMove = board.findBestMove(4, FourPlayerChessBoard::PARANOID);
+            Assert::AreEqual(std::string("f4f11"), FourPlayerChessBoard::moveToString(paranoidMove));
+
+            FourPlayerMove maxNMove = board.findBestMove(3, FourPlayerChessBoard::MAX_N);
+            Assert::AreEqual(std::string("f4f11"), FourPlayerChessBoard::moveToString(maxNMove));
+            Assert::AreEqual(FourPlayerChessBoard::RED, board.getCurrentPlayer());
+        }
+
+        // Test the speed of move generation and search from the start position
+        TEST_METHOD(MoveGenerationSpeed)
+        {
+            FourPlayerChessBoard board;
+
+            double movesPerSecond = board.benchmarkMoveGeneration(20000);
+            Assert::IsTrue(movesPerSecond > 0);
+
+            auto start = std::chrono::steady_clock::now();
+            board.findBestMove(4, FourPlayerChessBoard::PARANOID);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            std::wstring message = L"Four player move generation: " + std::to_wstring(static_cast<long long>(movesPerSecond)) +
+                L" moves/sec, paranoid depth 4: " + std::to_wstring(board.getNodeCount()) + L" nodes in " +
+                std::to_wstring(elapsed.count()) + L" s";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+}
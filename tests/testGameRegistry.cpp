@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/gameRegistry.h"
+#include <memory>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameRegistryTests
+{
+    // A stand-in game that counts how many of it are alive and how often it has been played
+    struct CountedGame
+    {
+        static int alive;
+        int plays = 0;
+
+        CountedGame() { alive++; }
+        ~CountedGame() { alive--; }
+    };
+
+    int CountedGame::alive = 0;
+
+    TEST_CLASS(GameRegistryTests)
+    {
+    public:
+        TEST_METHOD(NothingIsBuiltUntilChosen)
+        {
+            GameRegistry games;
+            games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [](CountedGame& game) { return ++game.plays; }, false);
+            games.add<CountedGame>(2, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [](CountedGame& game) { return ++game.plays; }, false);
+
+            Assert::AreEqual(0, CountedGame::alive);
+            Assert::AreEqual(0, games.getLoadedCount());
+            Assert::IsTrue(games.contains(2));
+            Assert::IsFalse(games.contains(3));
+
+            Assert::AreEqual(1, games.run(2));
+            Assert::AreEqual(1, CountedGame::alive);
+            Assert::IsTrue(games.isLoaded(2));
+            Assert::IsFalse(games.isLoaded(1));
+        }
+
+        TEST_METHOD(KeptGamesAreBuiltOnce)
+        {
+            GameRegistry games;
+            games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [](CountedGame& game) { return ++game.plays; }, false);
+
+            // The same game is played again, so it remembers the plays before
+            Assert::AreEqual(1, games.run(1));
+            Assert::AreEqual(2, games.run(1));
+            Assert::AreEqual(3, games.run(1));
+            Assert::AreEqual(1, games.getBuiltCount());
+            Assert::AreEqual(1, CountedGame::alive);
+
+            games.releaseAll();
+            Assert::AreEqual(0, CountedGame::alive);
+            Assert::AreEqual(1, games.run(1));
+            Assert::AreEqual(2, games.getBuiltCount());
+        }
+
+        TEST_METHOD(ReleasedGamesAreTornDownAfterEachPlay)
+        {
+            GameRegistry games;
+            int aliveDuringPlay = 0;
+            games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [&aliveDuringPlay](CountedGame& game) { aliveDuringPlay = CountedGame::alive; return ++game.plays; }, true);
+
+            Assert::AreEqual(1, games.run(1));
+            Assert::AreEqual(1, aliveDuringPlay);
+            Assert::AreEqual(0, CountedGame::alive);
+            Assert::IsFalse(games.isLoaded(1));
+
+            // Built anew, so it starts from nothing
+            Assert::AreEqual(1, games.run(1));
+            Assert::AreEqual(2, games.getBuiltCount());
+            Assert::AreEqual(0, games.getLoadedCount());
+        }
+
+        TEST_METHOD(FailedGamesAreTornDown)
+        {
+            GameRegistry games;
+            games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [](CountedGame&) -> int { throw std::runtime_error("The game failed"); }, false);
+
+            auto play = [&games]() { games.run(1); };
+            Assert::ExpectException<std::runtime_error>(play);
+            Assert::AreEqual(0, CountedGame::alive);
+            Assert::IsFalse(games.isLoaded(1));
+        }
+
+        TEST_METHOD(BadNumbersThrow)
+        {
+            GameRegistry games;
+            games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                [](CountedGame& game) { return ++game.plays; }, false);
+
+            auto addAgain = [&games]() {
+                games.add<CountedGame>(1, []() { return std::unique_ptr<CountedGame>(new CountedGame()); },
+                    [](CountedGame& game) { return game.plays; }, false);
+            };
+            auto runMissing = [&games]() { games.run(5); };
+            Assert::ExpectException<std::runtime_error>(addAgain);
+            Assert::ExpectException<std::runtime_error>(runMissing);
+            Assert::AreEqual(0, CountedGame::alive);
+        }
+    };
+}
@@ -0,0 +1,191 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/gomokuAI.h"
+#include "../src/gomokuPatterns.h"
+#include "../src/NaughtsxCrossess.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GomokuTests
+{
+    // Looks up the threat of a line of nine cells, 'X' for own stones, 'O' for blocked and '.' for empty
+    static int lineThreat(const std::string& line) {
+        uint32_t own = 0, blocked = 0;
+        for (int i = 0; i < 9; i++) {
+            own |= static_cast<uint32_t>(line[i] == 'X') << i;
+            blocked |= static_cast<uint32_t>(line[i] == 'O') << i;
+        }
+        return GomokuPatterns::threat(own, blocked);
+    }
+
+    // Lets a computer player think for a while from a quiet opening, and logs how fast and deep it went
+    template <class Board>
+    static std::string benchmark(const std::string& name) {
+        Board board;
+        GomokuAI<Board> ai;
+        int centre = (Board::HEIGHT / 2) * Board::WIDTH + Board::WIDTH / 2;
+        board.makeMove(centre);
+        board.makeMove(centre + 1);
+        board.makeMove(centre + Board::WIDTH);
+
+        auto start = std::chrono::steady_clock::now();
+        int move = ai.chooseMove(board, 1.0);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Assert::IsTrue(board.isLegal(move));
+        Assert::AreEqual(3, board.getStoneCount());
+        Assert::AreEqual(static_cast<int>(GomokuAI<Board>::SEARCH), ai.getReason());
+        Assert::IsTrue(ai.getSearchDepth() >= 2);
+
+        uint64_t nodes = ai.getSearchNodes() + ai.getThreatNodes();
+        return name + " depth " + std::to_string(ai.getSearchDepth()) + ", " + std::to_string(static_cast<uint64_t>(nodes / seconds)) +
+            " moves/sec";
+    }
+
+    TEST_CLASS(GomokuPatternTests)
+    {
+    public:
+        // Test lines are recognised, with the stone always in the middle
+        TEST_METHOD(Classification)
+        {
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FIVE), lineThreat("XXXXX...."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FIVE), lineThreat("..XXXXXX."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::OPEN_FOUR), lineThreat("...XXXX.."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FOUR), lineThreat("..OXXXX.."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FOUR), lineThreat("..XXX.X.."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::OPEN_FOUR), lineThreat("X.XXX.X.."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::OPEN_THREE), lineThreat("...XXX..."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::OPEN_THREE), lineThreat("...XX.X.."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::THREE), lineThreat("..OXXX..."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::THREE), lineThreat("..OXXX..O"));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::TWO), lineThreat("....XX..."));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::NONE), lineThreat("O...X...O"));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::NONE), lineThreat("OOOXX.OOO"));
+        }
+
+        // Test the edge of the board blocks a line like the other player's stone
+        TEST_METHOD(BoardEdges)
+        {
+            GomokuBoard board;
+            for (int x = 0; x < 4; x++) {
+                board.setCell(x, 1);
+            }
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FOUR), GomokuAI<GomokuBoard>::threat(board, 3, 1, 0));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::FIVE), GomokuAI<GomokuBoard>::bestThreat(board, 4, 1));
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::NONE), GomokuAI<GomokuBoard>::bestThreat(board, 4, 2));
+
+            // Down the last column
+            GomokuBoard column;
+            for (int y = 10; y < 13; y++) {
+                column.setCell(y * 15 + 14, 2);
+            }
+            column.setCell(13 * 15 + 14, 1);
+            Assert::AreEqual(static_cast<int>(GomokuPatterns::THREE), GomokuAI<GomokuBoard>::threat(column, 12 * 15 + 14, 2, 1));
+        }
+    };
+
+    TEST_CLASS(GomokuAITests)
+    {
+    public:
+        // Test a five is made, and the other player's five blocked
+        TEST_METHOD(FivesAndBlocks)
+        {
+            GomokuBoard board;
+            GomokuAI<GomokuBoard> ai;
+
+            for (int x = 5; x < 9; x++) {
+                board.setCell(7 * 15 + x, 2);
+            }
+            board.setCell(7 * 15 + 9, 1);
+            board.setCell(0, 1);
+            board.setTurn(1);
+            Assert::AreEqual(7 * 15 + 4, ai.chooseMove(board, 0.1));
+            Assert::AreEqual(static_cast<int>(GomokuAI<GomokuBoard>::BLOCK), ai.getReason());
+
+            board.setTurn(2);
+            Assert::AreEqual(7 * 15 + 4, ai.chooseMove(board, 0.1));
+            Assert::AreEqual(static_cast<int>(GomokuAI<GomokuBoard>::FIVE), ai.getReason());
+            Assert::AreEqual(6, board.getStoneCount());
+        }
+
+        // Test a four that also makes an open three is found as a win by continuous fours
+        TEST_METHOD(FourThree)
+        {
+            GomokuBoard board;
+            GomokuAI<GomokuBoard> ai;
+
+            // A three closed on the left along row 7, and two down column 7 that meet it at (7, 7)
+            board.setCell(7 * 15 + 4, 1);
+            board.setCell(7 * 15 + 5, 1);
+            board.setCell(7 * 15 + 6, 1);
+            board.setCell(7 * 15 + 3, 2);
+            board.setCell(5 * 15 + 7, 1);
+            board.setCell(6 * 15 + 7, 1);
+            board.setCell(0, 2);
+            board.setCell(14, 2);
+            board.setTurn(1);
+
+            Assert::AreEqual(7 * 15 + 7, ai.chooseMove(board, 1.0));
+            Assert::AreEqual(static_cast<int>(GomokuAI<GomokuBoard>::VCF), ai.getReason());
+            Assert::AreEqual(1, board.getTurn());
+        }
+
+        // Test two open twos that cross make a double open three, found as a win by continuous threats
+        TEST_METHOD(ThreeThree)
+        {
+            GomokuBoard board;
+            GomokuAI<GomokuBoard> ai;
+
+            board.setCell(7 * 15 + 5, 1);
+            board.setCell(7 * 15 + 6, 1);
+            board.setCell(5 * 15 + 7, 1);
+            board.setCell(6 * 15 + 7, 1);
+            board.setCell(0, 2);
+            board.setCell(14, 2);
+            board.setTurn(1);
+
+            Assert::AreEqual(7 * 15 + 7, ai.chooseMove(board, 1.0));
+            Assert::AreEqual(static_cast<int>(GomokuAI<GomokuBoard>::VCT), ai.getReason());
+        }
+
+        // Test a computer player against itself only ever plays legal moves, and someone wins
+        TEST_METHOD(SelfPlay)
+        {
+            MnkBoard<19, 19, 5, false> board;
+            GomokuAI<MnkBoard<19, 19, 5, false>> ai(16);
+
+            while (!board.getWinner() && !board.isFull()) {
+                int move = ai.chooseMove(board, 0.02);
+                Assert::IsTrue(board.isLegal(move));
+                board.makeMove(move);
+            }
+            Assert::IsTrue(board.getWinner() != 0);
+        }
+
+        // Time a second of thinking on 15x15 and 19x19, logging the speed and depth reached
+        TEST_METHOD(Benchmark)
+        {
+            std::string message = "Gomoku in 1 s: " + benchmark<GomokuBoard>("15x15") + "; " +
+                benchmark<MnkBoard<19, 19, 5, false>>("19x19");
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+
+    TEST_CLASS(GomokuGameTests)
+    {
+    public:
+        // Test the Gomoku mode of Naughts and Crosses takes moves, rejects bad ones and stops
+        TEST_METHOD(PlayAndStop)
+        {
+            NaughtsxCrossess game;
+            std::vector<std::string> inputs = { "5", "8 8", "8 8", "0 3", "banana", "stop", "n" };
+            size_t next = 0;
+
+            game.run([&]() { return next < inputs.size() ? inputs[next++] : std::string("n"); });
+            Assert::AreEqual(inputs.size(), next);
+        }
+    };
+}
@@ -175,6 +175,123 @@ namespace HnefataflTests
             Assert::IsFalse(game.isValidInput("11 22"));
             Assert::IsFalse(game.isValidInput("AA BB"));
             Assert::IsFalse(game.isValidInput("a1 B1"));
+        }
+
+		// Test that makeMove captures a sandwiched piece and unmakeMove restores it
+        TEST_METHOD(MakeMoveCaptures)
+        {
+            Hnefatafl game;
+
+            // Put a black piece next to the white piece at (5, 3)
+            game.makeMove(std::make_pair(0, 3), std::make_pair(4, 3));
+            Assert::AreEqual(WHITE, game.getPiece(5, 3));
+
+            // Close the sandwich from below
+            Assert::AreEqual(1, game.makeMove(std::make_pair(10, 3), std::make_pair(6, 3)));
+            Assert::AreEqual(EMPTY, game.getPiece(5, 3));
+
+            // Taking the move back restores the captured piece
+            Assert::IsTrue(game.unmakeMove());
+            Assert::AreEqual(WHITE, game.getPiece(5, 3));
+            Assert::AreEqual(BLACK, game.getPiece(10, 3));
+            Assert::AreEqual(EMPTY, game.getPiece(6, 3));
+        }
+
+		// Test that a sequence of moves can be fully taken back
+        TEST_METHOD(UnmakeMoveRestoresBoard)
+        {
+            Hnefatafl game;
+            Hnefatafl original;
+
+            game.makeMove(std::make_pair(5, 3), std::make_pair(9, 3));
+            game.makeMove(std::make_pair(0, 3), std::make_pair(4, 3));
+            game.makeMove(std::make_pair(5, 4), std::make_pair(5, 2));
+            game.makeMove(std::make_pair(5, 5), std::make_pair(5, 3));
+
+            while (game.unmakeMove()) {}
+
+            for (int row = 0; row < BOARD_SIZE; row++) {
+                for (int col = 0; col < BOARD_SIZE; col++) {
+                    Assert::AreEqual(original.getPiece(row, col), game.getPiece(row, col));
+                }
+            }
+
+            Assert::IsFalse(game.unmakeMove());
+        }
+
+		// Test that the king's position is tracked through moves
+        TEST_METHOD(KingPositionTracked)
+        {
+            Hnefatafl game;
+
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(5, 5));
+
+            // Clear a path and move the king with makeMove
+            game.makeMove(std::make_pair(5, 3), std::make_pair(9, 3));
+            game.makeMove(std::make_pair(5, 4), std::make_pair(5, 2));
+            game.makeMove(std::make_pair(5, 5), std::make_pair(5, 4));
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(5, 4));
+
+            // Taking the move back returns the king
+            game.unmakeMove();
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(5, 5));
+
+            // The sliding move is tracked as well
+            game.move(std::make_pair(5, 5), std::make_pair(5, 3));
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(5, 3));
+        }
+
+		// Test that a blocked king stops short of a king's square rather than jumping onto it
+        TEST_METHOD(KingBlockedFromCorner)
+        {
+            Hnefatafl game;
+
+            // Clear a path for the king
+            game.move(std::make_pair(5, 3), std::make_pair(9, 3));
+            game.move(std::make_pair(5, 4), std::make_pair(5, 2));
+            game.move(std::make_pair(5, 5), std::make_pair(5, 3));
+            game.move(std::make_pair(5, 3), std::make_pair(2, 3));
+
+            // A black piece beside the top left corner, and another off the left edge
+            game.move(std::make_pair(5, 1), std::make_pair(1, 1));
+            game.move(std::make_pair(1, 1), std::make_pair(1, 0));
+            game.move(std::make_pair(3, 0), std::make_pair(3, 2));
+
+            // Bring the king to the left edge, two squares below the blocker
+            game.move(std::make_pair(2, 3), std::make_pair(2, 1));
+            game.move(std::make_pair(2, 1), std::make_pair(3, 1));
+            game.move(std::make_pair(3, 1), std::make_pair(3, 0));
+
+            std::pair<int, int> landed = game.move(std::make_pair(3, 0), std::make_pair(0, 0));
+
+            Assert::IsTrue(landed == std::make_pair(2, 0));
+            Assert::AreEqual(KING, game.getPiece(2, 0));
+            Assert::AreEqual(BLACK, game.getPiece(1, 0));
+            Assert::AreEqual(KING_SQUARE, game.getPiece(0, 0));
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(2, 0));
+            Assert::IsFalse(game.isGameOver());
+        }
+
+		// Test that a king sliding up against a king's square steps onto it
+        TEST_METHOD(KingSlidesOntoCorner)
+        {
+            Hnefatafl game;
+
+            // Clear a path and bring the king to the left edge, below the top left corner
+            game.move(std::make_pair(5, 3), std::make_pair(9, 3));
+            game.move(std::make_pair(5, 4), std::make_pair(5, 2));
+            game.move(std::make_pair(5, 5), std::make_pair(5, 3));
+            game.move(std::make_pair(5, 3), std::make_pair(2, 3));
+            game.move(std::make_pair(2, 3), std::make_pair(2, 0));
+
+            std::pair<int, int> landed = game.move(std::make_pair(2, 0), std::make_pair(0, 0));
+
+            Assert::IsTrue(landed == std::make_pair(0, 0));
+            Assert::AreEqual(KING, game.getPiece(0, 0));
+            Assert::AreEqual(EMPTY, game.getPiece(1, 0));
+            Assert::AreEqual(EMPTY, game.getPiece(2, 0));
+            Assert::IsTrue(game.getKingPosition() == std::make_pair(0, 0));
+            Assert::IsTrue(game.isGameOver());
         }
     };
 }
\ No newline at end of file
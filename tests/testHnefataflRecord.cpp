@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/hnefataflRecord.h"
+#include <cstdio>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace HnefataflRecordTests
+{
+    TEST_CLASS(HnefataflRecordTests)
+    {
+    public:
+        // Test that a move survives packing into 14 bits
+        TEST_METHOD(PackMove)
+        {
+            uint16_t packed = HnefataflRecord::packMove(std::make_pair(10, 9), std::make_pair(0, 0));
+            Assert::IsTrue(packed < (1 << HnefataflRecord::MOVE_BITS));
+
+            std::pair<std::pair<int, int>, std::pair<int, int>> move = HnefataflRecord::unpackMove(packed);
+            Assert::IsTrue(move.first == std::make_pair(10, 9));
+            Assert::IsTrue(move.second == std::make_pair(0, 0));
+        }
+
+        // Test that a position survives encoding and decoding
+        TEST_METHOD(EncodePosition)
+        {
+            Hnefatafl game;
+            game.makeMove(std::make_pair(0, 3), std::make_pair(2, 3));
+            HnefataflPosition position = game.getPosition();
+
+            uint8_t bytes[HnefataflRecord::POSITION_BYTES];
+            HnefataflRecord::encodePosition(position, bytes);
+            HnefataflPosition decoded = HnefataflRecord::decodePosition(bytes);
+
+            Hnefatafl copy;
+            copy.setPosition(decoded);
+
+            for (int row = 0; row < 11; row++) {
+                for (int col = 0; col < 11; col++) {
+                    Assert::AreEqual(game.getPiece(row, col), copy.getPiece(row, col));
+                }
+            }
+            Assert::AreEqual(game.getCurrentPlayer(), copy.getCurrentPlayer());
+            Assert::IsTrue(game.getKingPosition() == copy.getKingPosition());
+        }
+
+        // Test that games written to a log read back and replay to the same final position
+        TEST_METHOD(WriteReadReplay)
+        {
+            const std::string filename = "hnefatafl_record_test.bin";
+            std::remove(filename.c_str());
+
+            Hnefatafl game;
+            std::vector<HnefataflGameRecord> written;
+            std::vector<HnefataflPosition> finalPositions;
+
+            {
+                HnefataflRecordWriter writer(filename);
+                for (unsigned int seed = 1; seed <= 20; seed++) {
+                    written.push_back(HnefataflRecord::playRandomGame(game, seed, 200));
+                    finalPositions.push_back(game.getPosition());
+                    writer.writeGame(written.back());
+                }
+            }
+
+            HnefataflRecordReader reader(filename);
+            HnefataflGameRecord record;
+            size_t count = 0;
+
+            while (reader.readGame(record)) {
+                Assert::IsTrue(record.moves == written[count].moves);
+                Assert::AreEqual(written[count].result, record.result);
+
+                Hnefatafl replayed;
+                HnefataflRecord::replay(record, replayed);
+                HnefataflPosition position = replayed.getPosition();
+
+                Assert::IsTrue(position.white[0] == finalPositions[count].white[0] && position.white[1] == finalPositions[count].white[1]);
+                Assert::IsTrue(position.black[0] == finalPositions[count].black[0] && position.black[1] == finalPositions[count].black[1]);
+                Assert::AreEqual(finalPositions[count].kingSquare, position.kingSquare);
+                Assert::AreEqual(finalPositions[count].sideToMove, position.sideToMove);
+                count++;
+            }
+
+            Assert::AreEqual(written.size(), count);
+            std::remove(filename.c_str());
+        }
+
+        // Test that random games start with black and record who won, including a side left with no moves
+        TEST_METHOD(RandomGameResult)
+        {
+            Hnefatafl game;
+            Hnefatafl start;
+            std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> moves;
+
+            for (unsigned int seed = 1; seed <= 20; seed++) {
+                HnefataflGameRecord record = HnefataflRecord::playRandomGame(game, seed, 500);
+
+                std::pair<std::pair<int, int>, std::pair<int, int>> first = HnefataflRecord::unpackMove(record.moves.front());
+                Assert::AreEqual(Hnefatafl::BLACK, start.getPiece(first.first.first, first.first.second));
+
+                if (game.isGameOver()) {
+                    Assert::AreEqual(game.isKingCaptured() ? HnefataflRecord::RESULT_BLACK : HnefataflRecord::RESULT_WHITE, record.result);
+                }
+                else if (record.result != 0) {
+                    // The loser is the side to move, which had nothing to play
+                    moves.clear();
+                    game.generateMoves(game.getCurrentPlayer(), moves);
+                    Assert::IsTrue(moves.empty());
+                    Assert::AreEqual(game.getCurrentPlayer() == Hnefatafl::WHITE ? HnefataflRecord::RESULT_BLACK : HnefataflRecord::RESULT_WHITE, record.result);
+                }
+                else {
+                    Assert::AreEqual(size_t(500), record.moves.size());
+                }
+            }
+        }
+
+        // Test that a game too long for the move count is refused rather than cut short
+        TEST_METHOD(WriteRejectsTooManyMoves)
+        {
+            const std::string filename = "hnefatafl_record_long.bin";
+            std::remove(filename.c_str());
+
+            HnefataflGameRecord record;
+            record.moves.assign(0x10000, HnefataflRecord::packMove(std::make_pair(0, 3), std::make_pair(1, 3)));
+
+            {
+                HnefataflRecordWriter writer(filename);
+                auto writeLong = [&writer, &record]() { writer.writeGame(record); };
+                Assert::ExpectException<std::runtime_error>(writeLong);
+
+                // One move fewer still fits
+                record.moves.pop_back();
+                writer.writeGame(record);
+            }
+
+            HnefataflRecordReader reader(filename);
+            HnefataflGameRecord read;
+            Assert::IsTrue(reader.readGame(read));
+            Assert::AreEqual(size_t(0xFFFF), read.moves.size());
+            Assert::IsFalse(reader.readGame(read));
+            std::remove(filename.c_str());
+        }
+    };
+}
@@ -1,13 +1,166 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "../src/maze.h"
+#include "../src/endlessMaze.h"
+#include "../src/mazeFile.h"
+#include "../src/mazeFog.h"
+#include "../src/mazeRace.h"
+#include "../src/mazeGenerator.h"
+#include "../src/mazeGrid.h"
+#include "../src/mazeGrid3D.h"
+#include "../src/mazeSolver.h"
+#include "../src/mazeView.h"
+#include "benchmarks.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <deque>
+#include <random>
 #include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace MazeTests
 {
+    // A binary tree maze, each cell opening north or east, which is quick enough to make at any size
+    static void makeBinaryTreeMaze(MazeGrid& grid, int width, int height, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        grid.reset(width, height);
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int cell = grid.index(x, y);
+                bool canNorth = y > 0;
+                bool canEast = x + 1 < width;
+                if (canNorth && (!canEast || (random() & 1))) {
+                    grid.openPassage(cell, MazeGrid::NORTH);
+                }
+                else if (canEast) {
+                    grid.openPassage(cell, MazeGrid::EAST);
+                }
+            }
+        }
+    }
+
+    // Checks a path starts and ends where it should and only goes through open passages
+    static bool isValidPath(const MazeGrid& grid, const std::vector<int>& path, int from, int to)
+    {
+        if (path.empty() || path.front() != from || path.back() != to) {
+            return false;
+        }
+
+        for (size_t i = 0; i + 1 < path.size(); i++) {
+            bool joined = false;
+            for (int direction = 0; direction < 4; direction++) {
+                if (grid.isOpen(path[i], direction) && grid.neighbour(path[i], direction) == path[i + 1]) {
+                    joined = true;
+                }
+            }
+            if (!joined) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Checks a maze has exactly one path between any two cells: every cell reached, and one passage fewer than cells
+    static bool isPerfect(const MazeGrid& grid)
+    {
+        MazeSolver solver;
+        const std::vector<int>& distances = solver.distanceField(grid, 0);
+        long long passages = 0;
+
+        for (int cell = 0; cell < grid.getCellCount(); cell++) {
+            if (distances[cell] == MazeSolver::UNREACHED) {
+                return false;
+            }
+            passages += grid.isOpen(cell, MazeGrid::SOUTH) + grid.isOpen(cell, MazeGrid::EAST);
+        }
+        return passages == grid.getCellCount() - 1;
+    }
+
+    // Checks a layered maze has exactly one path between any two cells, with every passage on both sides and none off the edge
+    static bool isPerfect(const MazeGrid3D& grid)
+    {
+        MazeSolver solver;
+        const std::vector<int>& distances = solver.distanceField(grid, grid.index(0, 0, 0));
+        long long passages = 0;
+
+        for (int cell = 0; cell < grid.getStorageSize(); cell++) {
+            if (!grid.isCell(cell)) {
+                if (grid.getPassages(cell) != 0 || distances[cell] != MazeSolver::UNREACHED) {
+                    return false;
+                }
+                continue;
+            }
+            if (distances[cell] == MazeSolver::UNREACHED) {
+                return false;
+            }
+            for (int direction = 0; direction < 6; direction++) {
+                if (grid.isOpen(cell, direction)) {
+                    int next = grid.neighbour(cell, direction);
+                    if (next == MazeGrid3D::NO_CELL || !grid.isOpen(next, MazeGrid3D::opposite(direction))) {
+                        return false;
+                    }
+                    passages++;
+                }
+            }
+        }
+        return passages == 2LL * (grid.getCellCount() - 1);
+    }
+
+    // Finds a way through the window of an endless maze from the player to a row, as directions to move in
+    static std::vector<int> findWayToRow(const EndlessMaze& endless, long long targetRow)
+    {
+        const int dx[4] = { 0, 0, 1, -1 };
+        const int dy[4] = { -1, 1, 0, 0 };
+        int width = endless.getWidth();
+        long long top = endless.getFirstRow();
+        std::vector<int> cameBy(static_cast<size_t>((endless.getEndRow() - top) * width), -1);
+        std::deque<int> queue;
+
+        int start = static_cast<int>((endless.getPlayerY() - top) * width + endless.getPlayerX());
+        cameBy[start] = 4;
+        queue.push_back(start);
+        while (!queue.empty()) {
+            int index = queue.front();
+            queue.pop_front();
+            int x = index % width;
+            long long y = top + index / width;
+
+            if (y == targetRow) {
+                std::vector<int> way;
+                while (index != start) {
+                    int direction = cameBy[index];
+                    way.insert(way.begin(), direction);
+                    index -= dy[direction] * width + dx[direction];
+                }
+                return way;
+            }
+
+            for (int direction = 0; direction < 4; direction++) {
+                long long nextY = y + dy[direction];
+                if ((endless.getPassages(x, y) >> direction) & 1 && endless.isLoaded(nextY)) {
+                    int next = static_cast<int>((nextY - top) * width + x + dx[direction]);
+                    if (cameBy[next] < 0) {
+                        cameBy[next] = direction;
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+        return {};
+    }
+
+    static const MazeAlgorithm ALGORITHMS[] = {
+        MazeAlgorithm::WILSON, MazeAlgorithm::BACKTRACKER, MazeAlgorithm::KRUSKAL, MazeAlgorithm::ELLER, MazeAlgorithm::PRIM,
+        MazeAlgorithm::PARALLEL
+    };
+
     TEST_CLASS(MazeTests)
     {
     public:
@@ -100,5 +253,996 @@ namespace MazeTests
             maze.generateMaze(10, 10);
             Assert::IsTrue(maze.inMaze.size() == 100);
         }
+
+        TEST_METHOD(TestGridMatchesMaze)
+        {
+            Maze maze(20, 15);
+            MazeSolver solver;
+
+            // Every cell is reached, and a maze with no loops has one passage fewer than it has cells
+            const std::vector<int>& distances = solver.distanceField(maze.grid, 0);
+            int passages = 0;
+            for (int cell = 0; cell < maze.grid.getCellCount(); cell++) {
+                Assert::AreNotEqual(MazeSolver::UNREACHED, distances[cell]);
+                passages += maze.grid.isOpen(cell, MazeGrid::SOUTH) + maze.grid.isOpen(cell, MazeGrid::EAST);
+            }
+            Assert::AreEqual(20 * 15 - 1, passages);
+        }
+
+        TEST_METHOD(TestGridPassages)
+        {
+            MazeGrid grid(3, 2);
+            grid.openPassage(grid.index(1, 0), MazeGrid::SOUTH);
+            Assert::IsTrue(grid.isOpen(grid.index(1, 0), MazeGrid::SOUTH));
+            Assert::IsTrue(grid.isOpen(grid.index(1, 1), MazeGrid::NORTH));
+            Assert::AreEqual(MazeGrid::NO_CELL, grid.neighbour(grid.index(2, 0), MazeGrid::EAST));
+            Assert::ExpectException<std::runtime_error>([&]() { grid.openPassage(grid.index(0, 1), MazeGrid::WEST); });
+
+            grid.closePassage(grid.index(1, 1), MazeGrid::NORTH);
+            Assert::IsFalse(grid.isOpen(grid.index(1, 0), MazeGrid::SOUTH));
+        }
+
+        TEST_METHOD(TestSolversAgree)
+        {
+            MazeGrid grid;
+            MazeSolver solver;
+            makeBinaryTreeMaze(grid, 40, 30, 7);
+            std::mt19937 random(11);
+
+            for (int trial = 0; trial < 50; trial++) {
+                int from = static_cast<int>(random() % grid.getCellCount());
+                int to = static_cast<int>(random() % grid.getCellCount());
+                int distance = solver.distanceField(grid, from)[to];
+
+                std::vector<int> breadthFirst = solver.breadthFirstPath(grid, from, to);
+                std::vector<int> aStar = solver.aStarPath(grid, from, to);
+                std::vector<int> bidirectional = solver.bidirectionalPath(grid, from, to);
+
+                Assert::IsTrue(isValidPath(grid, breadthFirst, from, to));
+                Assert::IsTrue(isValidPath(grid, aStar, from, to));
+                Assert::IsTrue(isValidPath(grid, bidirectional, from, to));
+                Assert::AreEqual(distance + 1, static_cast<int>(breadthFirst.size()));
+                Assert::AreEqual(distance + 1, static_cast<int>(aStar.size()));
+                Assert::AreEqual(distance + 1, static_cast<int>(bidirectional.size()));
+            }
+        }
+
+        TEST_METHOD(TestSolversWithLoops)
+        {
+            // An open room with one wall has many shortest paths around it, and A* has to skip the cells it pushed twice
+            MazeGrid grid(12, 9);
+            MazeSolver solver;
+            for (int cell = 0; cell < grid.getCellCount(); cell++) {
+                if (grid.neighbour(cell, MazeGrid::SOUTH) != MazeGrid::NO_CELL) {
+                    grid.openPassage(cell, MazeGrid::SOUTH);
+                }
+                if (grid.neighbour(cell, MazeGrid::EAST) != MazeGrid::NO_CELL) {
+                    grid.openPassage(cell, MazeGrid::EAST);
+                }
+            }
+            grid.closePassage(grid.index(5, 4), MazeGrid::EAST);
+            grid.closePassage(grid.index(5, 4), MazeGrid::NORTH);
+
+            int from = grid.index(0, 4);
+            int to = grid.index(11, 4);
+            Assert::AreEqual(14, static_cast<int>(solver.breadthFirstPath(grid, from, to).size()));
+            Assert::AreEqual(14, static_cast<int>(solver.aStarPath(grid, from, to).size()));
+            Assert::AreEqual(14, static_cast<int>(solver.bidirectionalPath(grid, from, to).size()));
+            Assert::AreEqual(1, static_cast<int>(solver.bidirectionalPath(grid, from, from).size()));
+        }
+
+        TEST_METHOD(TestUnreachable)
+        {
+            MazeGrid grid(4, 1);
+            MazeSolver solver;
+            grid.openPassage(0, MazeGrid::EAST);
+
+            Assert::AreEqual(MazeSolver::UNREACHED, solver.distanceField(grid, 0)[3]);
+            Assert::IsTrue(solver.breadthFirstPath(grid, 0, 3).empty());
+            Assert::IsTrue(solver.aStarPath(grid, 0, 3).empty());
+            Assert::IsTrue(solver.bidirectionalPath(grid, 0, 3).empty());
+        }
+
+        TEST_METHOD(TestQueueGrows)
+        {
+            // From the middle of an open room the frontier is a diamond of thousands of cells
+            MazeGrid grid(1501, 1501);
+            MazeSolver solver;
+            for (int cell = 0; cell < grid.getCellCount(); cell++) {
+                if (grid.neighbour(cell, MazeGrid::SOUTH) != MazeGrid::NO_CELL) {
+                    grid.openPassage(cell, MazeGrid::SOUTH);
+                }
+                if (grid.neighbour(cell, MazeGrid::EAST) != MazeGrid::NO_CELL) {
+                    grid.openPassage(cell, MazeGrid::EAST);
+                }
+            }
+
+            const std::vector<int>& distances = solver.distanceField(grid, grid.index(750, 750));
+            Assert::IsTrue(solver.getQueueCapacity() > 1024);
+            Assert::AreEqual(1500, distances[grid.index(0, 0)]);
+            Assert::AreEqual(1000, distances[grid.index(1250, 250)]);
+        }
+
+        TEST_METHOD(TestStartEndAndHint)
+        {
+            Maze maze(15, 15);
+            MazeSolver solver;
+
+            // Nothing is further from the end than the start
+            const std::vector<int>& distances = solver.distanceField(maze.grid, maze.toCell(maze.end));
+            int furthest = 0;
+            for (int distance : distances) {
+                furthest = std::max(furthest, distance);
+            }
+            Assert::AreEqual(furthest, maze.getPar());
+            Assert::IsTrue(maze.playerPosition == maze.start);
+            Assert::IsTrue(maze.getDifficulty() >= 0 && maze.getDifficulty() < maze.getPar());
+
+            // Following the hints reaches the end in par
+            int moves = 0;
+            while (maze.playerPosition != maze.end && moves <= maze.getPar()) {
+                int next = maze.grid.neighbour(maze.toCell(maze.playerPosition), maze.getHint());
+                maze.playerPosition = maze.toPosition(next);
+                moves++;
+            }
+            Assert::IsTrue(maze.playerPosition == maze.end);
+            Assert::AreEqual(maze.getPar(), moves);
+        }
+
+        TEST_METHOD(TestGeneratorsMakePerfectMazes)
+        {
+            const int sizes[][2] = { { 1, 1 }, { 1, 7 }, { 9, 1 }, { 2, 2 }, { 17, 13 }, { 64, 64 } };
+
+            for (MazeAlgorithm algorithm : ALGORITHMS) {
+                std::unique_ptr<MazeGenerator> generator = MazeGenerator::create(algorithm);
+                for (const auto& size : sizes) {
+                    MazeGrid grid(size[0], size[1]);
+                    generator->generate(grid, 42);
+                    Assert::IsTrue(isPerfect(grid));
+
+                    // The same seed gives the same maze, even over a grid with passages already in it
+                    MazeGrid again(size[0], size[1]);
+                    if (size[0] > 1) {
+                        again.openPassage(0, MazeGrid::EAST);
+                    }
+                    generator->generate(again, 42);
+                    Assert::IsTrue(std::equal(grid.data(), grid.data() + grid.getCellCount(), again.data()));
+                }
+            }
+        }
+
+        TEST_METHOD(TestParallelGenerator)
+        {
+            // Small tiles that do not divide the grid, so there are many borders and ragged tiles at the edges
+            for (MazeAlgorithm algorithm : { MazeAlgorithm::BACKTRACKER, MazeAlgorithm::KRUSKAL, MazeAlgorithm::ELLER, MazeAlgorithm::PRIM, MazeAlgorithm::WILSON }) {
+                MazeGrid single(50, 33);
+                ParallelGenerator(1, 7, algorithm).generate(single, 77);
+                Assert::IsTrue(isPerfect(single));
+
+                // The tiles are seeded on their own, so the threads they are made on make no difference
+                MazeGrid several(50, 33);
+                ParallelGenerator(3, 7, algorithm).generate(several, 77);
+                Assert::IsTrue(std::equal(single.data(), single.data() + single.getCellCount(), several.data()));
+            }
+
+            MazeGrid thin(1, 40);
+            ParallelGenerator(4, 3).generate(thin, 1);
+            Assert::IsTrue(isPerfect(thin));
+            Assert::ExpectException<std::runtime_error>([]() { ParallelGenerator(1, 0); });
+            Assert::ExpectException<std::runtime_error>([]() { ParallelGenerator(1, 8, MazeAlgorithm::PARALLEL); });
+        }
+
+        TEST_METHOD(TestParallelBenchmark)
+        {
+            const int size = 4096;
+            MazeGrid grid(size, size);
+
+            auto started = std::chrono::steady_clock::now();
+            BacktrackerGenerator().generate(grid, 3);
+            double wholeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            Logger::WriteMessage(("4096x4096 backtracker on one thread: " + std::to_string(wholeMs) + " ms, with " +
+                std::to_string(std::thread::hardware_concurrency()) + " processors").c_str());
+
+            double oneThreadMs = 0;
+            for (int threads : { 1, 2, 4, 8, 16, 32 }) {
+                ParallelGenerator generator(threads, 256);
+                started = std::chrono::steady_clock::now();
+                generator.generate(grid, 3);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+                oneThreadMs = (threads == 1) ? ms : oneThreadMs;
+
+                Logger::WriteMessage(("4096x4096 in 256x256 tiles on " + std::to_string(threads) + " threads: " + std::to_string(ms) +
+                    " ms, " + std::to_string(oneThreadMs / ms) + "x one thread, " + std::to_string(wholeMs / ms) + "x the whole-grid backtracker").c_str());
+            }
+            Assert::IsTrue(isPerfect(grid));
+        }
+
+        TEST_METHOD(TestEllerRows)
+        {
+            // Rows made one at a time join up into one maze, in memory that depends only on the width
+            const int width = 500;
+            const int height = 300;
+            MazeGrid grid(width, height);
+            EllerRows rows(width, 9);
+
+            for (int y = 0; y < height; y++) {
+                rows.nextRow(grid.data() + y * width, y + 1 == height);
+            }
+            Assert::IsTrue(isPerfect(grid));
+            Assert::IsTrue(rows.getMemory() < static_cast<size_t>(width) * 64);
+        }
+
+        TEST_METHOD(TestMazeStatistics)
+        {
+            // A T: a corridor of three cells with a branch of two going down from the middle
+            MazeGrid grid(3, 3);
+            grid.openPassage(grid.index(0, 0), MazeGrid::EAST);
+            grid.openPassage(grid.index(1, 0), MazeGrid::EAST);
+            grid.openPassage(grid.index(1, 0), MazeGrid::SOUTH);
+            grid.openPassage(grid.index(1, 1), MazeGrid::SOUTH);
+
+            MazeStatistics statistics = MazeGenerator::measure(grid);
+            Assert::AreEqual(3, statistics.deadEnds);
+            Assert::AreEqual(1, statistics.junctions);
+            Assert::AreEqual(4.0 / 3.0, statistics.riverFactor, 1e-9);
+        }
+
+        TEST_METHOD(TestMazeWithAlgorithm)
+        {
+            for (MazeAlgorithm algorithm : ALGORITHMS) {
+                Maze maze(12, 10, algorithm);
+                Assert::IsTrue(isPerfect(maze.grid));
+                Assert::AreEqual(static_cast<size_t>(120), maze.inMaze.size());
+
+                // The nodes hold the same passages as the grid
+                int links = 0;
+                for (const auto& entry : maze.mazeMap) {
+                    for (const auto& neighbor : entry.second->getNeighbors()) {
+                        links += (neighbor.second != nullptr) ? 1 : 0;
+                    }
+                }
+                Assert::AreEqual(2 * (120 - 1), links);
+                Assert::IsTrue(maze.getPar() > 0);
+            }
+        }
+
+        TEST_METHOD(TestEndlessMaze)
+        {
+            EndlessMaze endless(20, 13);
+            size_t memory = endless.getMemory();
+            Assert::AreEqual(0LL, endless.getFirstRow());
+            Assert::IsFalse(endless.movePlayer(MazeGrid::NORTH));
+            Assert::IsFalse(endless.movePlayer(MazeGrid::WEST));
+
+            // Go down a chunk at a time, each time into the chunk that makes the window slide
+            for (int chunk = 0; chunk < 200; chunk++) {
+                long long target = endless.getFirstRow() + (EndlessMaze::CHUNKS_BEHIND + 1) * EndlessMaze::CHUNK_ROWS;
+                std::vector<int> way = findWayToRow(endless, target);
+                Assert::IsFalse(way.empty());
+                for (int direction : way) {
+                    Assert::IsTrue(endless.movePlayer(direction));
+                }
+
+                // Every passage in the window is open from both sides, and none leads out of the top
+                long long top = endless.getFirstRow();
+                Assert::AreEqual(target / EndlessMaze::CHUNK_ROWS - EndlessMaze::CHUNKS_BEHIND, top / EndlessMaze::CHUNK_ROWS);
+                for (long long y = top; y < endless.getEndRow() - 1; y++) {
+                    for (int x = 0; x < endless.getWidth(); x++) {
+                        uint8_t passages = endless.getPassages(x, y);
+                        Assert::IsTrue(y > top || !(passages & MazeGrid::OPEN_NORTH));
+                        Assert::AreEqual(bool(passages & MazeGrid::OPEN_SOUTH), bool(endless.getPassages(x, y + 1) & MazeGrid::OPEN_NORTH));
+                        if (x + 1 < endless.getWidth()) {
+                            Assert::AreEqual(bool(passages & MazeGrid::OPEN_EAST), bool(endless.getPassages(x + 1, y) & MazeGrid::OPEN_WEST));
+                        }
+                    }
+                }
+            }
+
+            Assert::IsTrue(endless.getDeepestRow() >= 200 * EndlessMaze::CHUNK_ROWS);
+            Assert::AreEqual(memory, endless.getMemory());
+            Assert::ExpectException<std::runtime_error>([&]() { endless.getPassages(0, 0); });
+            Logger::WriteMessage(("Endless maze: " + std::to_string(endless.getDeepestRow()) + " rows down in " +
+                std::to_string(memory) + " bytes").c_str());
+        }
+
+        TEST_METHOD(TestViewDrawsWalls)
+        {
+            // A U: down the left, along the bottom and up the right
+            MazeGrid grid(3, 2);
+            grid.openPassage(grid.index(0, 0), MazeGrid::SOUTH);
+            grid.openPassage(grid.index(0, 1), MazeGrid::EAST);
+            grid.openPassage(grid.index(1, 1), MazeGrid::EAST);
+            grid.openPassage(grid.index(2, 1), MazeGrid::NORTH);
+
+            MazeView view(3, 2);
+            view.follow(grid, 0, 0);
+            view.drawAll(grid);
+            view.drawCell(grid, grid.index(1, 1), L'@');
+
+            Assert::AreEqual(std::wstring(L"+-+-+-+"), view.getLine(0));
+            Assert::AreEqual(std::wstring(L"| | | |"), view.getLine(1));
+            Assert::AreEqual(std::wstring(L"+ +-+ +"), view.getLine(2));
+            Assert::AreEqual(std::wstring(L"|  @  |"), view.getLine(3));
+            Assert::AreEqual(std::wstring(L"+-+-+-+"), view.getLine(4));
+        }
+
+        TEST_METHOD(TestViewFollows)
+        {
+            MazeGrid grid(100, 80);
+            BacktrackerGenerator().generate(grid, 1);
+            MazeView view(20, 10);
+
+            // The camera stays put while the player is well inside, and never shows past the edge of the maze
+            Assert::IsFalse(view.follow(grid, 2, 2));
+            Assert::IsFalse(view.follow(grid, 10, 5));
+            Assert::IsTrue(view.follow(grid, 17, 5));
+            Assert::AreEqual(7, view.getOriginX());
+            Assert::IsTrue(view.follow(grid, 99, 79));
+            Assert::AreEqual(80, view.getOriginX());
+            Assert::AreEqual(70, view.getOriginY());
+            Assert::IsFalse(view.contains(grid, grid.index(0, 0)));
+            Assert::IsTrue(view.contains(grid, grid.index(99, 79)));
+        }
+
+        TEST_METHOD(TestMazeUpdateRedrawsChanges)
+        {
+            Maze maze(40, 30, MazeAlgorithm::BACKTRACKER);
+            maze.printMaze();
+
+            // A step along the way to the end changes only the cell left and the cell entered
+            std::pair<int, int> previous = maze.playerPosition;
+            Assert::IsTrue(maze.movePlayer(maze.getHint()));
+            int oldX = 2 * (previous.first - maze.view.getOriginX()) + 1;
+            int oldY = 2 * (previous.second - maze.view.getOriginY()) + 1;
+            maze.updateMaze(previous);
+
+            int newX = 2 * (maze.playerPosition.first - maze.view.getOriginX()) + 1;
+            int newY = 2 * (maze.playerPosition.second - maze.view.getOriginY()) + 1;
+            Assert::AreEqual(L'@', maze.view.getLine(newY)[newX]);
+            if (maze.view.contains(maze.grid, maze.toCell(previous))) {
+                Assert::AreEqual(L'S', maze.view.getLine(oldY)[oldX]);
+            }
+            Assert::AreEqual(1, maze.moves);
+            Assert::IsFalse(maze.checkWin());
+        }
+
+        TEST_METHOD(TestGrid3DTiling)
+        {
+            // Sizes that do not fill their last tiles
+            MazeGrid3D grid(19, 13, 3);
+            std::set<int> numbers;
+            int cells = 0;
+
+            for (int level = 0; level < 3; level++) {
+                for (int y = 0; y < 13; y++) {
+                    for (int x = 0; x < 19; x++) {
+                        int cell = grid.index(x, y, level);
+                        Assert::IsTrue(cell >= 0 && cell < grid.getStorageSize());
+                        Assert::IsTrue(numbers.insert(cell).second);
+                        Assert::AreEqual(x, grid.getX(cell));
+                        Assert::AreEqual(y, grid.getY(cell));
+                        Assert::AreEqual(level, grid.getLevel(cell));
+                        Assert::IsTrue(grid.isCell(cell));
+
+                        const int dx[6] = { 0, 0, 1, -1, 0, 0 };
+                        const int dy[6] = { -1, 1, 0, 0, 0, 0 };
+                        const int dz[6] = { 0, 0, 0, 0, 1, -1 };
+                        for (int direction = 0; direction < 6; direction++) {
+                            int nx = x + dx[direction], ny = y + dy[direction], nz = level + dz[direction];
+                            bool inside = nx >= 0 && nx < 19 && ny >= 0 && ny < 13 && nz >= 0 && nz < 3;
+                            int expected = inside ? grid.index(nx, ny, nz) : MazeGrid3D::NO_CELL;
+                            Assert::AreEqual(expected, grid.neighbour(cell, direction));
+                            if (inside) {
+                                Assert::AreEqual(expected, grid.step(cell, direction));
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (int cell = 0; cell < grid.getStorageSize(); cell++) {
+                cells += grid.isCell(cell) ? 1 : 0;
+            }
+            Assert::AreEqual(grid.getCellCount(), cells);
+            Assert::AreEqual(3 * 24 * 16, grid.getStorageSize());
+
+            Assert::ExpectException<std::runtime_error>([&]() { grid.openPassage(grid.index(18, 0, 2), MazeGrid3D::UP); });
+            Assert::ExpectException<std::runtime_error>([]() { MazeGrid3D tooBig(65536, 65536, 2); });
+        }
+
+        TEST_METHOD(TestGenerator3DMakesPerfectMazes)
+        {
+            MazeGrid3D grid(37, 23, 4);
+            WilsonGenerator3D generator;
+            generator.generate(grid, 9);
+            Assert::IsTrue(isPerfect(grid));
+
+            // There are stairs, but far fewer than passages across
+            int stairs = 0;
+            for (int cell = 0; cell < grid.getStorageSize(); cell++) {
+                stairs += grid.isOpen(cell, MazeGrid3D::UP) ? 1 : 0;
+            }
+            Assert::IsTrue(stairs > 0 && stairs < grid.getCellCount() / 8);
+
+            // The same seed makes the same maze
+            MazeGrid3D again(37, 23, 4);
+            generator.generate(again, 9);
+            for (int cell = 0; cell < grid.getStorageSize(); cell++) {
+                Assert::AreEqual(grid.getPassages(cell), again.getPassages(cell));
+            }
+
+            // One level is an ordinary maze, and a single column has only stairs
+            MazeGrid3D flat(20, 20, 1);
+            generator.generate(flat, 3);
+            Assert::IsTrue(isPerfect(flat));
+            MazeGrid3D column(1, 1, 5);
+            generator.generate(column, 3);
+            Assert::IsTrue(isPerfect(column));
+
+            Assert::ExpectException<std::runtime_error>([]() { WilsonGenerator3D generator(1); });
+        }
+
+        TEST_METHOD(TestSolver3D)
+        {
+            MazeGrid3D grid(30, 30, 5);
+            WilsonGenerator3D().generate(grid, 4);
+            MazeSolver solver;
+
+            int from = solver.farthestCell(grid, grid.index(0, 0, 0));
+            int to = solver.farthestCell(grid, from);
+            int distance = solver.distanceField(grid, from)[to];
+            std::vector<int> path = solver.breadthFirstPath(grid, from, to);
+
+            Assert::AreEqual(distance + 1, static_cast<int>(path.size()));
+            Assert::AreEqual(from, path.front());
+            Assert::AreEqual(to, path.back());
+            for (size_t i = 0; i + 1 < path.size(); i++) {
+                bool joined = false;
+                for (int direction = 0; direction < 6; direction++) {
+                    if (grid.isOpen(path[i], direction) && grid.neighbour(path[i], direction) == path[i + 1]) {
+                        joined = true;
+                    }
+                }
+                Assert::IsTrue(joined);
+            }
+        }
+
+        TEST_METHOD(TestDrawLevel)
+        {
+            MazeGrid3D layered(12, 10, 3);
+            WilsonGenerator3D(4).generate(layered, 6);
+            int player = layered.index(5, 5, 1);
+            int exit = layered.index(11, 9, 1);
+
+            MazeGrid layer;
+            layered.copyLevel(1, layer);
+            for (int y = 0; y < 10; y++) {
+                for (int x = 0; x < 12; x++) {
+                    Assert::AreEqual(static_cast<uint8_t>(layered.getPassages(layered.index(x, y, 1)) & 15), layer.getPassages(layer.index(x, y)));
+                }
+            }
+
+            Maze maze(5, 5, MazeAlgorithm::BACKTRACKER);
+            maze.view.resize(12, 10);
+            maze.view.follow(layer, 5, 5);
+            maze.drawLevel(layered, layer, player, exit);
+
+            for (int y = 0; y < 10; y++) {
+                for (int x = 0; x < 12; x++) {
+                    int cell = layered.index(x, y, 1);
+                    wchar_t expected = maze.layeredSymbol(layered, cell, player, exit);
+                    Assert::AreEqual(expected, maze.view.getLine(2 * y + 1)[2 * x + 1]);
+                }
+            }
+            Assert::AreEqual(L'@', maze.view.getLine(11)[11]);
+            Assert::AreEqual(L'X', maze.view.getLine(19)[23]);
+        }
+
+        TEST_METHOD(TestFogSightLines)
+        {
+            // A corridor along the middle row, with a side passage north from its middle that turns east
+            MazeGrid grid(5, 3);
+            for (int x = 0; x < 4; x++) {
+                grid.openPassage(grid.index(x, 1), MazeGrid::EAST);
+            }
+            grid.openPassage(grid.index(2, 1), MazeGrid::NORTH);
+            grid.openPassage(grid.index(2, 0), MazeGrid::EAST);
+
+            MazeFog fog;
+            fog.reset(grid.getCellCount());
+            std::vector<int> revealed = fog.reveal(grid, grid.index(0, 1));
+            std::set<int> cells(revealed.begin(), revealed.end());
+
+            Assert::AreEqual(6, static_cast<int>(revealed.size()));
+            for (int x = 0; x < 5; x++) {
+                Assert::IsTrue(fog.isSeen(grid.index(x, 1)));
+            }
+            Assert::IsTrue(cells.count(grid.index(2, 0)) == 1);
+            Assert::IsFalse(fog.isSeen(grid.index(3, 0)));
+            Assert::IsFalse(fog.isSeen(grid.index(0, 0)));
+
+            // Nothing new from the same place, but around the corner there is
+            Assert::IsTrue(fog.reveal(grid, grid.index(0, 1)).empty());
+            Assert::AreEqual(6, fog.getVisibleCount());
+            Assert::AreEqual(1, static_cast<int>(fog.reveal(grid, grid.index(2, 0)).size()));
+            Assert::IsTrue(fog.isSeen(grid.index(3, 0)));
+            Assert::AreEqual(7, fog.getSeenCount());
+
+            // A short sight range stops partway along the corridor
+            MazeFog shortSighted(2);
+            shortSighted.reset(grid.getCellCount());
+            Assert::AreEqual(4, static_cast<int>(shortSighted.reveal(grid, grid.index(0, 1)).size()));
+            Assert::IsFalse(shortSighted.isSeen(grid.index(3, 1)));
+        }
+
+        TEST_METHOD(TestFogDrawsOnlyWhatIsSeen)
+        {
+            Maze maze(40, 30, MazeAlgorithm::BACKTRACKER);
+            maze.fogOfWar = true;
+            maze.fog.reset(maze.grid.getCellCount());
+            maze.fog.reveal(maze.grid, maze.toCell(maze.playerPosition));
+            maze.printMaze();
+
+            auto centre = [&](int cell) {
+                int x = 2 * (cell % maze.WIDTH - maze.view.getOriginX()) + 1;
+                int y = 2 * (cell / maze.WIDTH - maze.view.getOriginY()) + 1;
+                return maze.view.getLine(y)[x];
+            };
+            auto checkView = [&]() {
+                for (int cell = 0; cell < maze.grid.getCellCount(); cell++) {
+                    if (maze.view.contains(maze.grid, cell)) {
+                        Assert::AreEqual(maze.fog.isSeen(cell) ? maze.cellSymbol(cell) : MazeView::FOG, centre(cell));
+                    }
+                }
+            };
+            checkView();
+
+            // Each step towards the end draws what came into sight
+            for (int step = 0; step < 20 && !maze.checkWin(); step++) {
+                std::pair<int, int> previous = maze.playerPosition;
+                Assert::IsTrue(maze.movePlayer(maze.getHint()));
+                maze.updateMaze(previous);
+                checkView();
+            }
+            Assert::IsTrue(maze.fog.getSeenCount() < maze.grid.getCellCount());
+        }
+
+        TEST_METHOD(TestFlowField)
+        {
+            MazeGrid grid;
+            makeBinaryTreeMaze(grid, 50, 40, 11);
+            MazeSolver solver;
+            FlowField flow(10);
+
+            int source = grid.index(25, 20);
+            Assert::IsTrue(flow.update(grid, source));
+            Assert::IsFalse(flow.update(grid, source));
+
+            const std::vector<int>& distances = solver.distanceField(grid, source);
+            int inside = 0;
+            for (int cell = 0; cell < grid.getCellCount(); cell++) {
+                if (distances[cell] <= 10) {
+                    inside++;
+                    Assert::AreEqual(distances[cell], flow.getDistance(cell));
+                    int next = flow.nextStep(grid, cell);
+                    if (cell == source) {
+                        Assert::AreEqual(MazeGrid::NO_CELL, next);
+                    }
+                    else {
+                        Assert::AreEqual(distances[cell] - 1, distances[next]);
+                    }
+                }
+                else {
+                    Assert::AreEqual(FlowField::UNREACHED, flow.getDistance(cell));
+                    Assert::AreEqual(MazeGrid::NO_CELL, flow.nextStep(grid, cell));
+                }
+            }
+            Assert::AreEqual(inside, flow.getReached());
+
+            // Moving the source forgets the old field without clearing it
+            int moved = grid.neighbour(source, grid.isOpen(source, MazeGrid::NORTH) ? MazeGrid::NORTH : MazeGrid::EAST);
+            Assert::IsTrue(flow.update(grid, moved));
+            Assert::AreEqual(0, flow.getDistance(moved));
+            Assert::AreEqual(1, flow.getDistance(source));
+        }
+
+        TEST_METHOD(TestMazeRace)
+        {
+            // A straight corridor, too long for a monster at the far end to see the player at the start
+            MazeGrid corridor(40, 1);
+            for (int x = 0; x < 39; x++) {
+                corridor.openPassage(x, MazeGrid::EAST);
+            }
+
+            MazeRace race(corridor, 0, 39, 1, 5);
+            Assert::IsTrue(race.getMonsters()[0] > MazeRace::CHASE_RADIUS);
+            Assert::IsFalse(race.isOver());
+
+            // Standing still, the player is found in the end
+            long long limit = 600LL * MazeRace::TICKS_PER_SECOND;
+            while (!race.isOver() && race.getTicks() < limit) {
+                Assert::IsFalse(race.tick(MazeGrid::NORTH));
+            }
+            Assert::IsTrue(race.isCaught());
+            Assert::IsFalse(race.isEscaped());
+            Assert::AreEqual(0, race.getPlayer());
+
+            // Nothing happens once the race is over
+            long long ticks = race.getTicks();
+            Assert::IsFalse(race.tick(MazeGrid::EAST));
+            Assert::AreEqual(ticks, race.getTicks());
+
+            // With no monsters, the player walks out
+            MazeRace empty(corridor, 0, 39, 0, 5);
+            while (!empty.isOver()) {
+                Assert::IsTrue(empty.tick(MazeGrid::EAST));
+            }
+            Assert::IsTrue(empty.isEscaped());
+            Assert::AreEqual(39LL, empty.getTicks());
+        }
+
+        TEST_METHOD(TestMazeFileRoundTrip)
+        {
+            const std::string filename = "maze_file_test.maze";
+
+            // Widths that do and do not fill whole bytes with each row
+            for (int width : { 1, 7, 16, 33 }) {
+                MazeGrid grid(width, 9);
+                BacktrackerGenerator().generate(grid, static_cast<uint32_t>(width));
+                MazeFile::save(filename, grid, 1234, std::make_pair(0, 1), std::make_pair(width - 1, 8));
+
+                {
+                    MazeFile file(filename);
+                    Assert::AreEqual(width, file.getWidth());
+                    Assert::AreEqual(9, file.getHeight());
+                    Assert::AreEqual(1234u, file.getSeed());
+                    Assert::IsTrue(file.getStart() == std::make_pair(0, 1));
+                    Assert::IsTrue(file.getEnd() == std::make_pair(width - 1, 8));
+
+                    MazeGrid loaded;
+                    file.load(loaded);
+                    for (int cell = 0; cell < grid.getCellCount(); cell++) {
+                        Assert::AreEqual(grid.getPassages(cell), loaded.getPassages(cell));
+                        Assert::AreEqual(grid.getPassages(cell), file.getPassages(cell));
+                    }
+                }
+            }
+            std::remove(filename.c_str());
+        }
+
+        TEST_METHOD(TestMazeSaveAndLoad)
+        {
+            const std::string filename = "maze_save_test.maze";
+            Maze saved(30, 20, MazeAlgorithm::KRUSKAL);
+            saved.saveMaze(filename);
+
+            Maze loaded(5, 5, MazeAlgorithm::PRIM);
+            loaded.loadMaze(filename);
+            std::remove(filename.c_str());
+
+            Assert::AreEqual(30, loaded.WIDTH);
+            Assert::AreEqual(20, loaded.HEIGHT);
+            Assert::IsTrue(saved.start == loaded.start);
+            Assert::IsTrue(saved.end == loaded.end);
+            Assert::IsTrue(loaded.playerPosition == loaded.start);
+            Assert::AreEqual(saved.seed, loaded.seed);
+            Assert::AreEqual(saved.getPar(), loaded.getPar());
+            for (int cell = 0; cell < saved.grid.getCellCount(); cell++) {
+                Assert::AreEqual(saved.grid.getPassages(cell), loaded.grid.getPassages(cell));
+            }
+        }
+
+        TEST_METHOD(TestMazeFileRejectsBadFiles)
+        {
+            const std::string filename = "maze_bad_test.maze";
+            MazeGrid grid(10, 10);
+            KruskalGenerator().generate(grid, 4);
+
+            Assert::ExpectException<std::runtime_error>([&]() {
+                MazeFile::save(filename, grid, 0, std::make_pair(0, 0), std::make_pair(10, 0));
+            });
+            Assert::ExpectException<std::runtime_error>([&]() {
+                MazeFileWriter writer(filename, 10, 10, 0, std::make_pair(0, 0), std::make_pair(9, 9));
+                writer.writeRow(grid.data());
+                writer.finish();
+            });
+
+            // Cut short by a byte
+            MazeFile::save(filename, grid, 0, std::make_pair(0, 0), std::make_pair(9, 9));
+            std::string contents;
+            {
+                std::ifstream in(filename, std::ios::binary);
+                contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+            {
+                std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+                out.write(contents.data(), contents.size() - 1);
+            }
+            Assert::ExpectException<std::runtime_error>([&]() { MazeFile file(filename); });
+
+            // Not a maze file at all
+            {
+                std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+                out << "This is not a maze, it is some text long enough to be a header.";
+            }
+            Assert::ExpectException<std::runtime_error>([&]() { MazeFile file(filename); });
+            std::remove(filename.c_str());
+        }
+
+        // Streams a square maze to disk a row at a time, never holding it whole, then reopens it and reads cells back
+        static void checkMazeFile(const std::string& filename, int size)
+        {
+            std::vector<uint8_t> row(size);
+            std::vector<uint8_t> lastRow(size);
+
+            auto started = std::chrono::steady_clock::now();
+            {
+                EllerRows rows(size, 6);
+                MazeFileWriter writer(filename, size, size, 6, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+                for (int y = 0; y < size; y++) {
+                    rows.nextRow(row.data(), y == size - 1);
+                    writer.writeRow(row.data());
+                    if (y == size - 1) {
+                        lastRow = row;
+                    }
+                }
+                writer.finish();
+            }
+            double writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+            started = std::chrono::steady_clock::now();
+            {
+                MazeFile file(filename);
+                double openUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+
+                // Cells read straight from the mapping, without decoding the rest
+                std::mt19937 random(8);
+                int passages = 0;
+                started = std::chrono::steady_clock::now();
+                for (int i = 0; i < 100000; i++) {
+                    passages += file.getPassages(static_cast<int>(random() % (static_cast<uint32_t>(size) * size))) != 0 ? 1 : 0;
+                }
+                double probeNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / 100000;
+                Assert::AreEqual(100000, passages);
+
+                int lastRowStart = (size - 1) * size;
+                for (int x = 0; x < size; x++) {
+                    Assert::AreEqual(static_cast<uint8_t>(lastRow[x] & ~MazeGrid::OPEN_SOUTH), file.getPassages(lastRowStart + x));
+                }
+
+                Logger::WriteMessage((std::to_string(size) + "x" + std::to_string(size) + ": written in " + std::to_string(writeMs) +
+                    " ms, opened in " + std::to_string(openUs) + " us, " + std::to_string(probeNs) + " ns a random cell").c_str());
+            }
+            std::remove(filename.c_str());
+        }
+
+        TEST_METHOD(TestMazeFileRandomCells)
+        {
+            checkMazeFile("maze_cells.maze", 1024);
+        }
+
+        TEST_METHOD(TestMazeFileBenchmark)
+        {
+            // 16k by 16k writes 64 MB, so only on request
+            if (!benchmarksRequested()) {
+                Logger::WriteMessage("Skipped; set MINIGAME_BENCHMARKS to write a 16384x16384 maze file");
+                return;
+            }
+            checkMazeFile("maze_benchmark.maze", 16384);
+        }
+
+        TEST_METHOD(TestLayeredBenchmark)
+        {
+            // The size the 3D game is played at
+            MazeGrid3D grid(256, 256, 16);
+            MazeSolver solver;
+
+            auto started = std::chrono::steady_clock::now();
+            WilsonGenerator3D generator;
+            generator.generate(grid, 12);
+            double generateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+            started = std::chrono::steady_clock::now();
+            int from = solver.farthestCell(grid, grid.index(0, 0, 0));
+            int to = solver.farthestCell(grid, from);
+            double fieldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count() / 2;
+
+            started = std::chrono::steady_clock::now();
+            std::vector<int> path = solver.breadthFirstPath(grid, from, to);
+            double pathMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+            // Changing level copies the level out to draw it
+            MazeGrid layer;
+            started = std::chrono::steady_clock::now();
+            for (int level = 0; level < 16; level++) {
+                grid.copyLevel(level, layer);
+            }
+            double copyUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / 16;
+
+            int stairs = 0;
+            for (int cell : path) {
+                stairs += (grid.getPassages(cell) & (MazeGrid3D::OPEN_UP | MazeGrid3D::OPEN_DOWN)) ? 1 : 0;
+            }
+
+            Logger::WriteMessage(("256x256x16: generated in " + std::to_string(generateMs) + " ms with " +
+                std::to_string(generator.getWorkingMemory() / 1024) + " KB working memory, distance field " + std::to_string(fieldMs) +
+                " ms, path of " + std::to_string(path.size()) + " cells through " + std::to_string(stairs) + " stair cells in " +
+                std::to_string(pathMs) + " ms, " + std::to_string(copyUs) + " us to copy a level, " +
+                std::to_string(grid.getMemory() / 1024) + " KB maze").c_str());
+        }
+
+        TEST_METHOD(TestFogBenchmark)
+        {
+            // The cost of seeing what is in sight after a move should not depend on the size of the maze
+            MazeSolver solver;
+
+            for (int size : { 256, 4096 }) {
+                MazeGrid grid(size, size);
+                BacktrackerGenerator().generate(grid, 7);
+                int from = solver.farthestCell(grid, 0);
+                std::vector<int> path = solver.bidirectionalPath(grid, from, solver.farthestCell(grid, from));
+                size_t steps = std::min(path.size(), static_cast<size_t>(20000));
+
+                MazeFog fog;
+                fog.reset(grid.getCellCount());
+                long long visible = 0;
+                long long revealed = 0;
+                auto started = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < steps; i++) {
+                    revealed += static_cast<long long>(fog.reveal(grid, path[i]).size());
+                    visible += fog.getVisibleCount();
+                }
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / steps;
+
+                Logger::WriteMessage((std::to_string(size) + "x" + std::to_string(size) + ": " + std::to_string(ns) + " ns a move, " +
+                    std::to_string(static_cast<double>(visible) / steps) + " cells in sight and " +
+                    std::to_string(static_cast<double>(revealed) / steps) + " revealed a move, " +
+                    std::to_string(fog.getMemory() / 1024) + " KB of fog").c_str());
+            }
+        }
+
+        TEST_METHOD(TestRaceBenchmark)
+        {
+            // The player walks the longest path while the monsters chase; one field serves them all
+            MazeGrid grid(1024, 1024);
+            BacktrackerGenerator().generate(grid, 13);
+            MazeSolver solver;
+            int from = solver.farthestCell(grid, 0);
+            int to = solver.farthestCell(grid, from);
+            std::vector<int> path = solver.bidirectionalPath(grid, from, to);
+
+            for (int monsterCount : { 1, 48 }) {
+                MazeRace race(grid, from, to, monsterCount, 17);
+                size_t step = 1;
+                int searches = 0;
+
+                auto started = std::chrono::steady_clock::now();
+                while (!race.isOver() && race.getTicks() < 20000) {
+                    // A step every other tick, thirty a second
+                    int direction = -1;
+                    if (race.getTicks() % 2 == 0 && step < path.size()) {
+                        for (int d = 0; d < 4; d++) {
+                            if (grid.isOpen(race.getPlayer(), d) && grid.neighbour(race.getPlayer(), d) == path[step]) {
+                                direction = d;
+                            }
+                        }
+                    }
+                    if (race.tick(direction)) {
+                        step++;
+                        searches++;
+                    }
+                }
+                double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / race.getTicks();
+
+                // What a path search for every monster each time it steps would cost instead
+                started = std::chrono::steady_clock::now();
+                for (int monster : race.getMonsters()) {
+                    solver.aStarPath(grid, monster, race.getPlayer());
+                }
+                double aStarUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+
+                Logger::WriteMessage((std::to_string(monsterCount) + " monsters: " + std::to_string(us) + " us a tick over " +
+                    std::to_string(race.getTicks()) + " ticks, " + std::to_string(searches) + " field searches of about " +
+                    std::to_string(race.getFlowField().getReached()) + " cells, " + (race.isCaught() ? "caught" : "not caught") +
+                    "; one A* for each monster: " + std::to_string(aStarUs) + " us").c_str());
+            }
+        }
+
+        TEST_METHOD(TestViewBenchmark)
+        {
+            // The cost of a move should not depend on the size of the maze
+            ScreenBuffer screen;
+            MazeSolver solver;
+
+            for (int size : { 64, 1024, 4096 }) {
+                MazeGrid grid(size, size);
+                EllerGenerator().generate(grid, 2);
+                int from = solver.farthestCell(grid, 0);
+                std::vector<int> path = solver.bidirectionalPath(grid, from, solver.farthestCell(grid, from));
+
+                MazeView view(std::min(size, 59), std::min(size, 18));
+                view.follow(grid, path[0] % size, path[0] / size);
+                view.drawAll(grid);
+                view.flush(screen, 0, 0);
+
+                size_t steps = std::min(path.size(), static_cast<size_t>(5000));
+                long long characters = 0;
+                int redraws = 0;
+                auto started = std::chrono::steady_clock::now();
+                for (size_t i = 1; i < steps; i++) {
+                    bool scrolled = view.follow(grid, path[i] % size, path[i] / size);
+                    if (scrolled) {
+                        view.drawAll(grid);
+                        redraws++;
+                    }
+                    else {
+                        view.drawCell(grid, path[i - 1], L' ');
+                    }
+                    view.drawCell(grid, path[i], L'@');
+                    int written = view.flush(screen, 0, 0);
+                    characters += scrolled ? 0 : written;
+                }
+                double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / (steps - 1);
+
+                Logger::WriteMessage((std::to_string(size) + "x" + std::to_string(size) + ": " + std::to_string(us) + " us and " +
+                    std::to_string(static_cast<double>(characters) / (steps - 1 - redraws)) + " characters a move without scrolling, " + std::to_string(redraws) +
+                    " scrolls in " + std::to_string(steps - 1) + " moves").c_str());
+            }
+        }
+
+        TEST_METHOD(TestGeneratorBenchmark)
+        {
+            MazeGrid grid;
+
+            for (int size : { 256, 1024, 2048 }) {
+                for (MazeAlgorithm algorithm : ALGORITHMS) {
+                    std::unique_ptr<MazeGenerator> generator = MazeGenerator::create(algorithm);
+                    grid.reset(size, size);
+
+                    auto started = std::chrono::steady_clock::now();
+                    generator->generate(grid, 5);
+                    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+                    MazeStatistics statistics = MazeGenerator::measure(grid);
+
+                    std::string line = std::to_string(size) + "x" + std::to_string(size) + " " + generator->getName() + ": " +
+                        std::to_string(ms) + " ms, " + std::to_string(generator->getWorkingMemory() / 1024) + " KB working memory, " +
+                        std::to_string(statistics.deadEndRatio * 100) + "% dead ends, river factor " + std::to_string(statistics.riverFactor);
+                    Logger::WriteMessage(line.c_str());
+                }
+            }
+        }
+
+        TEST_METHOD(TestSolverBenchmark)
+        {
+            MazeGrid grid;
+            MazeSolver solver;
+
+            for (int size : { 256, 1024, 4096 }) {
+                makeBinaryTreeMaze(grid, size, size, 3);
+
+                // The two ends of a longest path, as the game places them
+                auto started = std::chrono::steady_clock::now();
+                int from = solver.farthestCell(grid, 0);
+                int to = solver.farthestCell(grid, from);
+                double fieldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count() / 2;
+                int distance = solver.distanceField(grid, from)[to];
+
+                std::string line = std::to_string(size) + "x" + std::to_string(size) + ": distance field " + std::to_string(fieldMs) +
+                    " ms, path of " + std::to_string(distance) + ", queue of " + std::to_string(solver.getQueueCapacity());
+
+                auto run = [&](const char* name, std::vector<int> (MazeSolver::*search)(const MazeGrid&, int, int)) {
+                    auto searchStarted = std::chrono::steady_clock::now();
+                    std::vector<int> path = (solver.*search)(grid, from, to);
+                    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStarted).count();
+                    Assert::AreEqual(distance + 1, static_cast<int>(path.size()));
+                    line += std::string("; ") + name + " " + std::to_string(ms) + " ms, " + std::to_string(solver.getExpanded()) + " expanded";
+                };
+                run("BFS", &MazeSolver::breadthFirstPath);
+                run("A*", &MazeSolver::aStarPath);
+                run("bidirectional", &MazeSolver::bidirectionalPath);
+
+                Logger::WriteMessage(line.c_str());
+            }
+        }
     };
 }
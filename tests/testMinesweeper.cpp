@@ -0,0 +1,416 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/minesweeper.h"
+#include "../src/minesweeperBoard.h"
+#include "../src/minesweeperSolver.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MinesweeperTests
+{
+    // Lays out a board from rows of '*' for mines and '.' for clear cells
+    static MinesweeperBoard boardFromRows(const std::vector<std::string>& rows) {
+        int width = static_cast<int>(rows[0].size());
+        int height = static_cast<int>(rows.size());
+        std::vector<int> mineCells;
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (rows[y][x] == '*') {
+                    mineCells.push_back(y * width + x);
+                }
+            }
+        }
+
+        MinesweeperBoard board(width, height, static_cast<int>(mineCells.size()), 1);
+        board.setMines(mineCells);
+        return board;
+    }
+
+    // Counts the layouts from a cell on that fit the revealed numbers, adding up how many mine each cell
+    static void countLayouts(const MinesweeperBoard& board, int cell, int minesLeft, std::vector<int>& mined,
+        double& layouts, std::vector<double>& mineLayouts) {
+        if (minesLeft == 0) {
+            std::vector<int> counts(board.getCellCount(), 0);
+            int neighbours[8];
+            for (int mine : mined) {
+                int count = board.getNeighbours(mine, neighbours);
+                for (int i = 0; i < count; i++) {
+                    counts[neighbours[i]]++;
+                }
+            }
+            for (int other = 0; other < board.getCellCount(); other++) {
+                if (board.isRevealed(other) && counts[other] != board.getAdjacentMines(other)) {
+                    return;
+                }
+            }
+
+            layouts++;
+            for (int mine : mined) {
+                mineLayouts[mine]++;
+            }
+            return;
+        }
+        if (cell == board.getCellCount()) {
+            return;
+        }
+
+        if (!board.isRevealed(cell)) {
+            mined.push_back(cell);
+            countLayouts(board, cell + 1, minesLeft - 1, mined, layouts, mineLayouts);
+            mined.pop_back();
+        }
+        countLayouts(board, cell + 1, minesLeft, mined, layouts, mineLayouts);
+    }
+
+    // Works out each cell's chance of a mine by trying every layout that fits the revealed numbers
+    static std::vector<double> bruteForceProbabilities(const MinesweeperBoard& board) {
+        std::vector<double> mineLayouts(board.getCellCount(), 0.0);
+        std::vector<int> mined;
+        double layouts = 0;
+
+        countLayouts(board, 0, board.getMineCount(), mined, layouts, mineLayouts);
+        for (double& count : mineLayouts) {
+            count /= layouts;
+        }
+        return mineLayouts;
+    }
+
+    TEST_CLASS(MinesweeperBoardTests)
+    {
+    public:
+        // Test the first reveal never hits a mine and opens up the cells around it
+        TEST_METHOD(FirstRevealIsSafe)
+        {
+            for (uint32_t seed = 0; seed < 200; seed++) {
+                MinesweeperBoard board(9, 9, 10, seed);
+                int first = board.cellAt(seed % 9, (seed / 9) % 9);
+
+                Assert::IsFalse(board.areMinesLaid());
+                Assert::IsTrue(board.reveal(first) > 0);
+                Assert::IsTrue(board.areMinesLaid());
+                Assert::IsFalse(board.isLost());
+                Assert::AreEqual(0, board.getAdjacentMines(first));
+
+                int mines = 0;
+                for (int cell = 0; cell < board.getCellCount(); cell++) {
+                    mines += board.isMine(cell) ? 1 : 0;
+                }
+                Assert::AreEqual(10, mines);
+            }
+
+            // With no room to keep the neighbours clear, only the cell itself is
+            MinesweeperBoard crowded(3, 3, 8, 5);
+            Assert::AreEqual(1, crowded.reveal(4));
+            Assert::AreEqual(8, crowded.getAdjacentMines(4));
+            Assert::IsTrue(crowded.isWon());
+        }
+
+        // Test a reveal floods the region of zeros and its border, and stops at flags
+        TEST_METHOD(FloodFill)
+        {
+            MinesweeperBoard board = boardFromRows({
+                "*....",
+                ".....",
+                ".....",
+                "....*",
+            });
+
+            Assert::AreEqual(1, board.getAdjacentMines(1));
+            Assert::AreEqual(0, board.getAdjacentMines(board.cellAt(2, 1)));
+
+            Assert::IsTrue(board.toggleFlag(board.cellAt(4, 0)));
+            Assert::AreEqual(17, board.reveal(board.cellAt(2, 2)));
+            Assert::IsFalse(board.isRevealed(board.cellAt(4, 0)));
+            Assert::IsFalse(board.isWon());
+
+            Assert::IsTrue(board.toggleFlag(board.cellAt(4, 0)));
+            Assert::AreEqual(1, board.reveal(board.cellAt(4, 0)));
+            Assert::AreEqual(0, board.reveal(board.cellAt(4, 0)));
+            Assert::IsTrue(board.isWon());
+
+            Assert::AreEqual(MinesweeperBoard::REVEALED_MINE, board.reveal(0));
+            Assert::IsTrue(board.isLost());
+            Assert::IsFalse(board.isWon());
+        }
+
+        // Test a flood fill over a million cells does not overflow the stack
+        TEST_METHOD(LargeFloodFill)
+        {
+            MinesweeperBoard board(1000, 1000, 1, 1);
+            board.setMines({ 999999 });
+
+            Assert::AreEqual(999999, board.reveal(0));
+            Assert::IsTrue(board.isWon());
+        }
+
+        // Test flags and moving mines keep the counts right
+        TEST_METHOD(FlagsAndMoves)
+        {
+            MinesweeperBoard board = boardFromRows({
+                "*..",
+                "...",
+                "...",
+            });
+
+            Assert::IsTrue(board.toggleFlag(0));
+            Assert::AreEqual(1, board.getFlagCount());
+            Assert::IsTrue(board.isFlagged(0));
+            Assert::IsTrue(board.toggleFlag(0));
+            Assert::AreEqual(0, board.getFlagCount());
+
+            Assert::IsTrue(board.moveMine(0, 8));
+            Assert::IsFalse(board.moveMine(0, 8));
+            Assert::AreEqual(0, board.getAdjacentMines(1));
+            Assert::AreEqual(1, board.getAdjacentMines(4));
+            Assert::AreEqual(1, board.getAdjacentMines(7));
+
+            Assert::AreEqual(8, board.reveal(0));
+            Assert::IsFalse(board.toggleFlag(0));
+            Assert::IsTrue(board.isWon());
+        }
+
+        // Test impossible boards and mine lists are rejected
+        TEST_METHOD(BadBoards)
+        {
+            Assert::ExpectException<std::runtime_error>([]() { MinesweeperBoard board(0, 5, 1); });
+            Assert::ExpectException<std::runtime_error>([]() { MinesweeperBoard board(3, 3, 9); });
+            Assert::ExpectException<std::runtime_error>([]() { MinesweeperBoard board(3, 3, -1); });
+
+            MinesweeperBoard board(3, 3, 2, 1);
+            Assert::ExpectException<std::runtime_error>([&board]() { board.setMines({ 1 }); });
+            Assert::ExpectException<std::runtime_error>([&board]() { board.setMines({ 1, 1 }); });
+            Assert::ExpectException<std::runtime_error>([&board]() { board.setMines({ 1, 9 }); });
+        }
+    };
+
+    TEST_CLASS(MinesweeperSolverTests)
+    {
+    public:
+        // Test the simple rules settle a one-two-one
+        TEST_METHOD(CertainCells)
+        {
+            MinesweeperBoard board = boardFromRows({
+                "*.*",
+                "...",
+                "...",
+            });
+            board.reveal(board.cellAt(1, 2));
+
+            MinesweeperSolver solver;
+            MinesweeperAnalysis analysis = solver.analyse(board);
+
+            Assert::IsTrue(analysis.consistent);
+            Assert::IsTrue(analysis.exact);
+            Assert::AreEqual(std::vector<int>({ 1 }), analysis.safeCells);
+            Assert::AreEqual(std::vector<int>({ 0, 2 }), analysis.mineCells);
+            Assert::AreEqual(1.0, analysis.mineProbability[0]);
+            Assert::AreEqual(0.0, analysis.mineProbability[1]);
+            Assert::AreEqual(1, solver.findHint(board));
+        }
+
+        // Test the probabilities match trying every layout, on many small boards part way through a game
+        TEST_METHOD(ProbabilitiesMatchBruteForce)
+        {
+            std::mt19937 random(11);
+            MinesweeperSolver solver;
+            int checked = 0;
+
+            for (uint32_t seed = 0; seed < 60; seed++) {
+                MinesweeperBoard board(6, 4, 6 + seed % 3, seed);
+                board.reveal(board.cellAt(seed % 6, seed % 4));
+
+                // Reveal a few more safe cells so the frontier has several parts
+                for (int extra = 0; extra < 2; extra++) {
+                    std::uniform_int_distribution<int> anyCell(0, board.getCellCount() - 1);
+                    int cell = anyCell(random);
+                    if (!board.isMine(cell)) {
+                        board.reveal(cell);
+                    }
+                }
+                if (board.isWon()) {
+                    continue;
+                }
+
+                std::vector<double> expected = bruteForceProbabilities(board);
+                MinesweeperAnalysis analysis = solver.analyse(board);
+                Assert::IsTrue(analysis.consistent);
+                Assert::IsTrue(analysis.exact);
+
+                for (int cell = 0; cell < board.getCellCount(); cell++) {
+                    Assert::AreEqual(expected[cell], analysis.mineProbability[cell], 1e-9);
+                }
+
+                // The hint is safe if any cell is, otherwise as safe as the safest
+                int hint = solver.findHint(board);
+                double safest = 1.0;
+                for (int cell = 0; cell < board.getCellCount(); cell++) {
+                    if (!board.isRevealed(cell)) {
+                        safest = std::min(safest, expected[cell]);
+                    }
+                }
+                Assert::AreEqual(safest, expected[hint], 1e-9);
+                checked++;
+            }
+
+            Assert::IsTrue(checked > 30);
+        }
+
+        // Test a board that needs a guess is found out, and a board that does not is cleared
+        TEST_METHOD(SolvableWithoutGuessing)
+        {
+            MinesweeperSolver solver;
+
+            // The mine could be either of the two cells at the bottom
+            MinesweeperBoard coinFlip = boardFromRows({
+                "..",
+                "..",
+                "*.",
+            });
+            Assert::IsFalse(solver.isSolvableWithoutGuessing(coinFlip, 0));
+
+            MinesweeperBoard open = boardFromRows({
+                "....",
+                "....",
+                "...*",
+            });
+            Assert::IsTrue(solver.isSolvableWithoutGuessing(open, 0));
+
+            MinesweeperBoard played = open;
+            played.reveal(0);
+            Assert::AreEqual(0, solver.solveByDeduction(played));
+            Assert::IsTrue(played.isWon());
+        }
+
+        // Test no-guess boards keep the first cell clear and can be cleared by deduction
+        TEST_METHOD(NoGuessGenerator)
+        {
+            MinesweeperGenerator generator(7);
+            MinesweeperSolver solver;
+
+            for (int i = 0; i < 20; i++) {
+                int first = (i * 37) % (30 * 16);
+                MinesweeperBoard board = generator.generate(30, 16, 99, first, true);
+
+                Assert::IsTrue(board.areMinesLaid());
+                Assert::AreEqual(0, board.getRevealedCount());
+                Assert::AreEqual(0, board.getAdjacentMines(first));
+                Assert::IsFalse(board.isMine(first));
+                Assert::IsTrue(solver.isSolvableWithoutGuessing(board, first));
+            }
+
+            // The same seed makes the same board
+            MinesweeperBoard first = MinesweeperGenerator(3).generate(16, 16, 40, 0, true);
+            MinesweeperBoard second = MinesweeperGenerator(3).generate(16, 16, 40, 0, true);
+            for (int cell = 0; cell < first.getCellCount(); cell++) {
+                Assert::AreEqual(first.isMine(cell), second.isMine(cell));
+            }
+        }
+
+        // Time hints and no-guess generation on expert boards, logging the results
+        TEST_METHOD(ExpertSpeed)
+        {
+            MinesweeperGenerator generator(21);
+            MinesweeperSolver solver;
+            int first = 16 * 8 + 15;
+
+            auto start = std::chrono::steady_clock::now();
+            int boards = 50;
+            for (int i = 0; i < boards; i++) {
+                MinesweeperBoard board = generator.generate(30, 16, 99, first, true);
+                Assert::IsTrue(board.areMinesLaid());
+            }
+            double generateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            // Play random boards by hints alone, counting the games won
+            start = std::chrono::steady_clock::now();
+            int hints = 0, won = 0;
+            for (uint32_t seed = 0; seed < 50; seed++) {
+                MinesweeperBoard board(30, 16, 99, seed);
+                while (!board.isWon() && !board.isLost()) {
+                    board.reveal(solver.findHint(board));
+                    hints++;
+                }
+                won += board.isWon() ? 1 : 0;
+            }
+            double hintSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Assert::IsTrue(won > 0);
+
+            std::string message = "Minesweeper expert: " + std::to_string(generateSeconds / boards * 1000) + " ms per no-guess board, " +
+                std::to_string(hintSeconds / hints * 1000) + " ms per hint, " + std::to_string(won) + "/50 won on hints";
+            Logger::WriteMessage(message.c_str());
+        }
+
+        // Time a hint and a no-guess board on a million cells, logging the results
+        TEST_METHOD(LargeBoardSpeed)
+        {
+            MinesweeperSolver solver;
+            int first = 500 * 1000 + 500;
+
+            MinesweeperBoard board(1000, 1000, 150000, 5);
+            board.reveal(first);
+
+            auto start = std::chrono::steady_clock::now();
+            int hint = solver.findHint(board);
+            double hintSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            Assert::IsFalse(board.isRevealed(hint));
+
+            start = std::chrono::steady_clock::now();
+            MinesweeperAnalysis analysis = solver.analyse(board);
+            double analyseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            Assert::IsTrue(analysis.consistent);
+
+            start = std::chrono::steady_clock::now();
+            MinesweeperBoard generated = MinesweeperGenerator(9).generate(1000, 1000, 150000, first, true);
+            double generateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            Assert::IsTrue(solver.isSolvableWithoutGuessing(generated, first));
+
+            std::string message = "Minesweeper 1000x1000: " + std::to_string(hintSeconds * 1000) + " ms per hint, " +
+                std::to_string(analyseSeconds * 1000) + " ms for every probability, " + std::to_string(generateSeconds) +
+                " s per no-guess board";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+
+    TEST_CLASS(MinesweeperGameTests)
+    {
+    public:
+        // Test the move input format
+        TEST_METHOD(ValidInput)
+        {
+            Minesweeper game;
+
+            Assert::IsTrue(game.isValidInput("3 12"));
+            Assert::IsTrue(game.isValidInput("f 3 12"));
+            Assert::IsTrue(game.isValidInput("16 30"));
+            Assert::IsFalse(game.isValidInput("312"));
+            Assert::IsFalse(game.isValidInput("f3 12"));
+            Assert::IsFalse(game.isValidInput("3 123"));
+            Assert::IsFalse(game.isValidInput("hint me"));
+        }
+
+        // Test the first reveal makes the board around it
+        TEST_METHOD(FirstReveal)
+        {
+            Minesweeper game;
+            game.generateBoard(30, 16, 99, true);
+            Assert::IsFalse(game.getBoard().areMinesLaid());
+
+            int first = game.getBoard().cellAt(3, 4);
+            Assert::IsTrue(game.reveal(first) > 1);
+            Assert::AreEqual(99, game.getBoard().getMineCount());
+            Assert::IsFalse(game.getBoard().isLost());
+
+            MinesweeperSolver solver;
+            MinesweeperBoard played = game.getBoard();
+            Assert::AreEqual(0, solver.solveByDeduction(played));
+            Assert::IsTrue(played.isWon());
+        }
+    };
+}
@@ -0,0 +1,244 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/mnkBoard.h"
+#include "../src/mnkSearch.h"
+#include <chrono>
+#include <random>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MnkGameTests
+{
+    // Checks every line of a board for K in a row the slow way, to check the bit masks against
+    template <class Board>
+    static int slowWinner(const Board& board) {
+        const int directions[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+
+        for (int y = 0; y < Board::HEIGHT; y++) {
+            for (int x = 0; x < Board::WIDTH; x++) {
+                int player = board.get(x, y);
+                for (int d = 0; d < 4 && player; d++) {
+                    int run = 0;
+                    int cx = x, cy = y;
+                    while (cx >= 0 && cx < Board::WIDTH && cy < Board::HEIGHT && board.get(cx, cy) == player) {
+                        run++;
+                        cx += directions[d][0];
+                        cy += directions[d][1];
+                    }
+                    if (run >= Board::WIN_LENGTH) {
+                        return player;
+                    }
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Plays random games, checking after every move that the incremental win check agrees with the slow one
+    template <class Board>
+    static void checkRandomGames(int games, uint32_t seed) {
+        std::mt19937 random(seed);
+        Board board;
+
+        for (int game = 0; game < games; game++) {
+            board.clear();
+            uint64_t emptyHash = board.getHash();
+
+            while (!board.getWinner() && !board.isFull()) {
+                int moves[Board::CELLS];
+                int count = 0;
+                for (int cell = 0; cell < Board::CELLS; cell++) {
+                    if (board.isLegal(cell)) {
+                        moves[count++] = cell;
+                    }
+                }
+                Assert::IsTrue(count > 0);
+
+                std::uniform_int_distribution<int> pick(0, count - 1);
+                int player = board.getTurn();
+                board.makeMove(moves[pick(random)]);
+
+                int winner = slowWinner(board);
+                Assert::AreEqual(winner, board.getWinner());
+                Assert::IsTrue(winner == 0 || winner == player);
+            }
+
+            // Taking every move back gives the empty board and its hash again
+            while (board.getMoveCount()) {
+                board.undoMove();
+            }
+            Assert::AreEqual(0, board.getStoneCount());
+            Assert::AreEqual(1, board.getTurn());
+            Assert::IsTrue(board.getHash() == emptyHash);
+        }
+    }
+
+    TEST_CLASS(MnkBoardTests)
+    {
+    public:
+        // Test the incremental win check against a full scan, with and without gravity
+        TEST_METHOD(WinsMatchFullScan)
+        {
+            checkRandomGames<NaughtsAndCrossesBoard>(500, 1);
+            checkRandomGames<Connect4Board>(500, 2);
+            checkRandomGames<GomokuBoard>(50, 3);
+            checkRandomGames<MnkBoard<19, 19, 5, false>>(20, 4);
+            checkRandomGames<MnkBoard<32, 8, 6, true>>(50, 5);
+        }
+
+        // Test stones drop down the columns with gravity on
+        TEST_METHOD(Gravity)
+        {
+            Connect4Board board;
+
+            Assert::AreEqual(5 * 7 + 3, board.dropCell(3));
+            Assert::IsTrue(board.isLegal(5 * 7 + 3));
+            Assert::IsFalse(board.isLegal(4 * 7 + 3));
+
+            for (int i = 0; i < 6; i++) {
+                board.makeMove(board.dropCell(3));
+            }
+            Assert::AreEqual(-1, board.dropCell(3));
+            Assert::AreEqual(1, board.get(3, 5));
+            Assert::AreEqual(2, board.get(3, 0));
+
+            int moves[Connect4Board::CELLS];
+            Assert::AreEqual(6, board.generateMoves(moves));
+            Assert::AreEqual(5 * 7 + 4, moves[0]);
+        }
+
+        // Test the same position reached by different orders hashes the same
+        TEST_METHOD(Transpositions)
+        {
+            GomokuBoard first, second;
+
+            first.makeMove(10);
+            first.makeMove(20);
+            first.makeMove(30);
+            second.makeMove(30);
+            second.makeMove(20);
+            second.makeMove(10);
+            Assert::IsTrue(first.getHash() == second.getHash());
+
+            second.setTurn(1);
+            Assert::IsFalse(first.getHash() == second.getHash());
+
+            // Setting up the same stones by hand gives the same hash too
+            GomokuBoard third;
+            third.setCell(10, 1);
+            third.setCell(30, 1);
+            third.setCell(20, 2);
+            third.setTurn(2);
+            Assert::IsTrue(first.getHash() == third.getHash());
+        }
+
+        // Test larger boards only offer moves near the stones
+        TEST_METHOD(CandidateMoves)
+        {
+            GomokuBoard board;
+            int moves[GomokuBoard::CELLS];
+
+            Assert::AreEqual(1, board.generateMoves(moves));
+            Assert::AreEqual(7 * 15 + 7, moves[0]);
+
+            board.makeMove(0);
+            Assert::AreEqual(8, board.generateMoves(moves));
+
+            NaughtsAndCrossesBoard small;
+            int smallMoves[NaughtsAndCrossesBoard::CELLS];
+            Assert::AreEqual(9, small.generateMoves(smallMoves));
+            Assert::AreEqual(4, smallMoves[0]);
+        }
+    };
+
+    TEST_CLASS(MnkSearchTests)
+    {
+    public:
+        // Test Naughts and Crosses is solved as a draw, and wins are taken and threats blocked
+        TEST_METHOD(NaughtsAndCrosses)
+        {
+            NaughtsAndCrossesBoard board;
+            MnkSearch<NaughtsAndCrossesBoard> search(12);
+
+            int move = search.findBestMove(board, 9);
+            Assert::AreEqual(0, search.getScore());
+            Assert::AreEqual(9, search.getDepth());
+            Assert::IsTrue(board.isLegal(move));
+
+            // X on 0 and 1, O on 3 and 4: X wins at 2
+            board.makeMove(0);
+            board.makeMove(3);
+            board.makeMove(1);
+            board.makeMove(4);
+            Assert::AreEqual(2, search.findBestMove(board, 9));
+            Assert::AreEqual(MnkSearch<NaughtsAndCrossesBoard>::WIN_SCORE - 1, search.getScore());
+
+            // O takes its own win at 5 rather than blocking X at 6
+            board.undoMove();
+            board.undoMove();
+            board.makeMove(8);
+            board.makeMove(4);
+            board.makeMove(7);
+            Assert::AreEqual(5, search.findBestMove(board, 9));
+        }
+
+        // Test a forced Connect 4 win is found: two in the bottom row become an open three
+        TEST_METHOD(Connect4ForcedWin)
+        {
+            Connect4Board board;
+            MnkSearch<Connect4Board> search(16);
+
+            board.makeMove(board.dropCell(3));
+            board.makeMove(board.dropCell(3));
+            board.makeMove(board.dropCell(2));
+            board.makeMove(board.dropCell(2));
+
+            int move = search.findBestMove(board, 12);
+            Assert::IsTrue(move == board.dropCell(1) || move == board.dropCell(4));
+            Assert::IsTrue(MnkSearch<Connect4Board>::isDecisive(search.getScore()));
+            Assert::IsTrue(search.getScore() > 0);
+        }
+
+        // Test Gomoku takes a five and blocks a four
+        TEST_METHOD(GomokuTactics)
+        {
+            GomokuBoard board;
+            MnkSearch<GomokuBoard> search(16);
+
+            // A four closed at one end by the other player, so it can only be finished at the open end
+            for (int x = 5; x < 9; x++) {
+                board.setCell(7 * 15 + x, 2);
+            }
+            board.setCell(7 * 15 + 9, 1);
+            board.setTurn(1);
+            Assert::AreEqual(7 * 15 + 4, search.findBestMove(board, 4));
+
+            board.setTurn(2);
+            Assert::AreEqual(7 * 15 + 4, search.findBestMove(board, 4));
+            Assert::AreEqual(MnkSearch<GomokuBoard>::WIN_SCORE - 1, search.getScore());
+        }
+
+        // Time a second of search on Connect 4 and Gomoku, logging how deep it got
+        TEST_METHOD(SearchSpeed)
+        {
+            Connect4Board connect4;
+            MnkSearch<Connect4Board> connect4Search;
+            connect4Search.findBestMove(connect4, Connect4Board::CELLS, 1.0);
+
+            GomokuBoard gomoku;
+            gomoku.makeMove(7 * 15 + 7);
+            gomoku.makeMove(7 * 15 + 8);
+            MnkSearch<GomokuBoard> gomokuSearch;
+            gomokuSearch.findBestMove(gomoku, 30, 1.0);
+
+            Assert::IsTrue(connect4Search.getDepth() >= 8);
+            Assert::IsTrue(gomokuSearch.getDepth() >= 2);
+
+            std::string message = "m,n,k search in 1 s: Connect 4 depth " + std::to_string(connect4Search.getDepth()) + ", " +
+                std::to_string(connect4Search.getNodes()) + " nodes; Gomoku depth " + std::to_string(gomokuSearch.getDepth()) + ", " +
+                std::to_string(gomokuSearch.getNodes()) + " nodes";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+}
@@ -0,0 +1,275 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/chessAI.h"
+#include "../src/openingBook.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ChessTests
+{
+    TEST_CLASS(OpeningBookTests)
+    {
+    public:
+        // Three short games: two open with e4 and one with d4
+        static const char* samplePgn()
+        {
+            return
+                "[Event \"Club \\\"blitz\\\" night\"]\n"
+                "[White \"Anderssen\"]\n"
+                "[Result \"1-0\"]\n"
+                "\n"
+                "1. e4 e5 2. Nf3 {A comment (with brackets)} Nc6 $1 3.Bb5 (3. Bc4 Bc5 (3... Nf6) 4. c3) 3... a6 1-0\n"
+                "\n"
+                "[Event \"Second\"]\n"
+                "[Result \"1/2-1/2\"]\n"
+                "\n"
+                "1. e4 c5 ; the Sicilian\n"
+                "2. Nf3 d6 1/2-1/2\n"
+                "\n"
+                "% an escaped line\n"
+                "[Event \"Third\"]\n"
+                "\n"
+                "1. d4 d5 2. c4\n"
+                "[Event \"Fourth, from a position\"]\n"
+                "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n"
+                "\n"
+                "1. e4 Kd7 0-1\n";
+        }
+
+        // Plays a random game and writes it as PGN movetext with move numbers and the odd comment
+        static std::string randomGame(std::mt19937& random)
+        {
+            ChessBoard board;
+            ChessMoveList list;
+            std::string text = "[Event \"Random\"]\n[Site \"Test\"]\n[White \"Player A\"]\n[Black \"Player B\"]\n\n";
+
+            for (int ply = 0; ply < 100; ply++) {
+                board.generateLegalMoves(list);
+                if (list.size() == 0) {
+                    break;
+                }
+
+                ChessMove move = list[static_cast<int>(random() % list.size())];
+                if (ply % 2 == 0) {
+                    text += std::to_string(ply / 2 + 1) + ". ";
+                }
+                text += board.moveToSan(move) + " ";
+                if (ply % 16 == 15) {
+                    text += "{A longer comment about the position} ";
+                }
+                board.makeMove(move);
+            }
+
+            return text + "*\n\n";
+        }
+
+        // Test tags, comments, variations, glyphs and move numbers are handled, and games without a result end
+        TEST_METHOD(ParseGames)
+        {
+            std::string text = samplePgn();
+            PgnParser parser(text);
+            PgnGame game;
+
+            Assert::IsTrue(parser.nextGame(game));
+            Assert::AreEqual(std::string("Club \\\"blitz\\\" night"), std::string(game.getTag("Event")));
+            Assert::AreEqual(std::string("Anderssen"), std::string(game.getTag("White")));
+            Assert::IsTrue(game.getTag("Black").empty());
+            Assert::AreEqual(size_t(6), game.moves.size());
+            Assert::AreEqual(std::string("Bb5"), std::string(game.moves[4]));
+            Assert::AreEqual(std::string("a6"), std::string(game.moves[5]));
+            Assert::AreEqual(PgnGame::WHITE_WIN, game.getWhitePoints());
+
+            Assert::IsTrue(parser.nextGame(game));
+            Assert::AreEqual(size_t(4), game.moves.size());
+            Assert::AreEqual(PgnGame::DRAW, game.getWhitePoints());
+
+            Assert::IsTrue(parser.nextGame(game));
+            Assert::AreEqual(std::string("Third"), std::string(game.getTag("Event")));
+            Assert::AreEqual(size_t(3), game.moves.size());
+            Assert::AreEqual(PgnGame::UNKNOWN, game.getWhitePoints());
+
+            Assert::IsTrue(parser.nextGame(game));
+            Assert::AreEqual(PgnGame::BLACK_WIN, game.getWhitePoints());
+
+            Assert::IsFalse(parser.nextGame(game));
+            Assert::AreEqual(text.size(), parser.getPosition());
+        }
+
+        // Test FEN and SAN are read straight out of a larger buffer
+        TEST_METHOD(ParseInPlace)
+        {
+            std::string text = "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"] Kd2!?";
+            std::string_view view = text;
+
+            ChessBoard board;
+            board.setFen(view.substr(6, 31));
+            Assert::AreEqual(std::string("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"), board.getFen());
+            Assert::AreEqual(std::string("e1d2"), ChessBoard::moveToString(board.parseSan(view.substr(40))));
+        }
+
+        // Test the tree counts each move once per game, and the book file reads back the same
+        TEST_METHOD(BuildAndProbe)
+        {
+            const std::string filename = "opening_book_test.book";
+            OpeningTreeBuilder builder(4);
+
+            PgnImportStats stats = builder.addPgn(samplePgn());
+            Assert::AreEqual(uint64_t(4), stats.games);
+            Assert::AreEqual(uint64_t(0), stats.errors);
+            Assert::AreEqual(uint64_t(4 + 4 + 3 + 2), stats.positions);
+
+            // Only e4 from the start is shared, and d4 then d5 is the only other first-move pair
+            Assert::AreEqual(size_t(12), builder.size());
+            Assert::AreEqual(size_t(12), builder.write(filename));
+
+            {
+                OpeningBook book(filename);
+                ChessBoard board;
+                Assert::AreEqual(size_t(12), book.size());
+
+                std::vector<OpeningBookEntry> entries = book.probe(board.getHash());
+                Assert::AreEqual(size_t(2), entries.size());
+                for (const OpeningBookEntry& entry : entries) {
+                    std::string move = ChessBoard::moveToString(entry.move);
+                    Assert::AreEqual(move == "e2e4" ? 2u : 1u, entry.games);
+                    Assert::AreEqual(move == "e2e4" ? 3u : 1u, entry.points);
+                }
+                Assert::AreEqual(std::string("e2e4"), ChessBoard::moveToString(book.chooseMove(board)));
+
+                board.makeMove(board.parseSan("e4"));
+                Assert::AreEqual(size_t(2), book.probe(board.getHash()).size());
+
+                board.setFen("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+                Assert::AreEqual(std::string("e2e4"), ChessBoard::moveToString(book.chooseMove(board)));
+
+                board.setFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+                Assert::IsTrue(book.chooseMove(board).isNull());
+            }
+
+            // Dropping moves seen in only one game leaves just 1. e4
+            Assert::AreEqual(size_t(1), builder.write(filename, 2));
+            {
+                OpeningBook book(filename);
+                Assert::AreEqual(size_t(1), book.size());
+            }
+
+            std::remove(filename.c_str());
+        }
+
+        // Test a game with an illegal move is added up to the move and counted as an error
+        TEST_METHOD(IllegalMove)
+        {
+            OpeningTreeBuilder builder;
+            PgnImportStats stats = builder.addPgn("1. e4 e5 2. Ke3 Nc6 *\n\n[FEN \"not a position\"]\n1. e4 *\n");
+
+            Assert::AreEqual(uint64_t(2), stats.games);
+            Assert::AreEqual(uint64_t(2), stats.errors);
+            Assert::AreEqual(size_t(2), builder.size());
+        }
+
+        // Test the search plays from the book, and searches once out of it
+        TEST_METHOD(SearchUsesBook)
+        {
+            const std::string filename = "opening_book_search_test.book";
+            OpeningTreeBuilder builder;
+            builder.addPgn("1. d4 Nf6 2. c4 e6 *\n\n1. d4 d5 *\n");
+            builder.write(filename);
+
+            {
+                OpeningBook book(filename);
+                TranspositionTable table(1);
+                LazySmpSearch search(table, 1);
+                search.setOpeningBook(&book);
+
+                ChessBoard board;
+                SearchLimits limits;
+                limits.maxDepth = 3;
+
+                SearchResult result = search.search(board, limits);
+                Assert::IsTrue(result.bookMove);
+                Assert::AreEqual(std::string("d2d4"), ChessBoard::moveToString(result.bestMove));
+                Assert::AreEqual(uint64_t(0), result.nodes);
+
+                board.makeMove(result.bestMove);
+                board.makeMove(board.parseSan("Nf6"));
+                Assert::AreEqual(std::string("c2c4"), ChessBoard::moveToString(search.search(board, limits).bestMove));
+
+                board.makeMove(board.parseSan("Nf3"));
+                result = search.search(board, limits);
+                Assert::IsFalse(result.bookMove);
+                Assert::AreEqual(3, result.depth);
+
+                limits.useBook = false;
+                board.setStartPosition();
+                Assert::IsFalse(search.search(board, limits).bookMove);
+            }
+
+            std::remove(filename.c_str());
+        }
+
+        // Test missing and malformed book files are reported
+        TEST_METHOD(BadBookFile)
+        {
+            const std::string filename = "opening_book_bad_test.book";
+            Assert::ExpectException<std::runtime_error>([&]() { OpeningBook book("no such file.book"); });
+
+            {
+                std::ofstream file(filename, std::ios::binary);
+                file << "1. e4 e5 *\n";
+            }
+            Assert::ExpectException<std::runtime_error>([&]() { OpeningBook book(filename); });
+
+            {
+                std::ofstream file(filename, std::ios::binary);
+            }
+            Assert::ExpectException<std::runtime_error>([&]() { OpeningBook book(filename); });
+
+            std::remove(filename.c_str());
+        }
+
+        // Test splitting between threads finds every game and builds the same tree, and report the import speed
+        TEST_METHOD(ImportSpeed)
+        {
+            const std::string filename = "opening_book_speed_test.pgn";
+            std::mt19937 random(12345);
+
+            std::string games;
+            for (int i = 0; i < 200; i++) {
+                games += randomGame(random);
+            }
+            {
+                std::ofstream file(filename, std::ios::binary);
+                for (int copy = 0; copy < 100; copy++) {
+                    file << games;
+                }
+            }
+
+            OpeningTreeBuilder single;
+            PgnImportStats stats = single.addPgnFile(filename);
+            Assert::AreEqual(uint64_t(20000), stats.games);
+            Assert::AreEqual(uint64_t(0), stats.errors);
+            Assert::IsTrue(single.size() <= 200 * OpeningTreeBuilder::DEFAULT_MAX_PLY);
+
+            const int threadCounts[] = { 1, 2, 4, 8 };
+            for (int threads : threadCounts) {
+                OpeningTreeBuilder builder;
+                stats = builder.addPgnFile(filename, threads);
+
+                std::string message = "PGN import, " + std::to_string(threads) + " threads: " +
+                    std::to_string(stats.bytes / (1024 * 1024)) + " MB, " + std::to_string(stats.games) + " games in " +
+                    std::to_string(stats.seconds) + " s, " + std::to_string(static_cast<int>(stats.megabytesPerSecond())) +
+                    " MB/s, " + std::to_string(static_cast<uint64_t>(stats.games / stats.seconds)) + " games/s";
+                Logger::WriteMessage(message.c_str());
+
+                Assert::AreEqual(uint64_t(20000), stats.games);
+                Assert::AreEqual(single.size(), builder.size());
+            }
+
+            std::remove(filename.c_str());
+        }
+    };
+}
@@ -0,0 +1,251 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../src/sudoku.h"
+#include "../src/sudokuGrid.h"
+#include "../src/sudokuSolver.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace SudokuTests
+{
+    // A puzzle that falls to naked singles
+    static const char* const EASY_PUZZLE = "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+    static const char* const EASY_SOLUTION = "534678912672195348198342567859761423426853791713924856961537284287419635345286179";
+
+    // A 17 clue puzzle that needs hidden singles
+    static const char* const SEVENTEEN_CLUES = ".......1.4.........2...........5.4.7..8...3....1.9....3..4..2...5.1........8.6...";
+
+    // A puzzle built to need a deep search
+    static const char* const HARD_PUZZLE = "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+    static const char* const HARD_SOLUTION = "812753649943682175675491283154237896369845721287169534521974368438526917796318452";
+
+    TEST_CLASS(SudokuGridTests)
+    {
+    public:
+        // Test a grid reads and writes its string form and keeps its masks
+        TEST_METHOD(ParseAndMasks)
+        {
+            SudokuGrid grid;
+            grid.setFromString(EASY_PUZZLE);
+
+            Assert::AreEqual(std::string(EASY_PUZZLE), grid.toString());
+            Assert::AreEqual(30, grid.getFilledCount());
+            Assert::AreEqual(5, grid.getCell(0));
+
+            // Row 1 has 5, 3 and 7, column 3 has 8, box 1 has 6, 8 and 9, leaving 1, 2 and 4
+            Assert::AreEqual(static_cast<uint16_t>(0x00B), grid.getCandidates(2));
+            Assert::IsTrue(grid.canPlace(2, 4));
+            Assert::IsFalse(grid.canPlace(2, 9));
+            Assert::IsFalse(grid.canPlace(0, 1));
+
+            grid.place(2, 4);
+            Assert::AreEqual(static_cast<uint16_t>(0), grid.getCandidates(2));
+            Assert::IsFalse(grid.canPlace(3, 4));
+            grid.erase(2);
+            Assert::IsTrue(grid.canPlace(2, 4));
+            Assert::AreEqual(std::string(EASY_PUZZLE), grid.toString());
+
+            // '0' is read as empty too
+            std::string zeros(EASY_PUZZLE);
+            std::replace(zeros.begin(), zeros.end(), '.', '0');
+            grid.setFromString(zeros);
+            Assert::AreEqual(std::string(EASY_PUZZLE), grid.toString());
+
+            // The units cover every cell three times
+            int count[SudokuGrid::CELLS] = {};
+            for (int unit = 0; unit < SudokuGrid::UNITS; unit++) {
+                for (int cell : SudokuGrid::UNIT_CELLS[unit]) {
+                    count[cell]++;
+                }
+            }
+            for (int cell = 0; cell < SudokuGrid::CELLS; cell++) {
+                Assert::AreEqual(3, count[cell]);
+            }
+        }
+
+        // Test malformed grids are refused
+        TEST_METHOD(BadGrids)
+        {
+            SudokuGrid grid;
+
+            auto tooShort = [&grid]() { grid.setFromString("53..7...."); };
+            Assert::ExpectException<std::runtime_error>(tooShort);
+
+            auto badCharacter = [&grid]() { grid.setFromString(std::string(80, '.') + "x"); };
+            Assert::ExpectException<std::runtime_error>(badCharacter);
+
+            auto repeated = [&grid]() { grid.setFromString("55" + std::string(79, '.')); };
+            Assert::ExpectException<std::runtime_error>(repeated);
+        }
+    };
+
+    TEST_CLASS(SudokuSolverTests)
+    {
+    public:
+        // Test singles alone solve an easy puzzle
+        TEST_METHOD(Singles)
+        {
+            SudokuGrid grid;
+            grid.setFromString(EASY_PUZZLE);
+
+            Assert::IsTrue(SudokuSolver::fillSingles(grid, false));
+            Assert::AreEqual(std::string(EASY_SOLUTION), grid.toString());
+            Assert::AreEqual(SudokuSolver::EASY, SudokuSolver::rate(grid));
+
+            // Naked singles stall on the 17 clue puzzle, and hidden singles finish it
+            grid.setFromString(SEVENTEEN_CLUES);
+            Assert::AreEqual(SudokuSolver::MEDIUM, SudokuSolver::rate(grid));
+            Assert::IsTrue(SudokuSolver::fillSingles(grid, false));
+            Assert::IsFalse(grid.isComplete());
+            Assert::IsTrue(SudokuSolver::fillSingles(grid, true));
+            Assert::IsTrue(grid.isComplete());
+
+            // A cell with no candidates is found to be impossible
+            grid.setFromString("23456789." "........." "........." "........1" "........." "........." "........." "........." ".........");
+            Assert::IsFalse(SudokuSolver::fillSingles(grid, false));
+            Assert::AreEqual(SudokuSolver::UNSOLVABLE, SudokuSolver::rate(grid));
+        }
+
+        // Test the search solves puzzles singles cannot
+        TEST_METHOD(SearchSolves)
+        {
+            SudokuSolver solver;
+            SudokuGrid grid;
+
+            grid.setFromString(HARD_PUZZLE);
+            Assert::AreEqual(SudokuSolver::HARD, SudokuSolver::rate(grid));
+            Assert::IsTrue(solver.solve(grid));
+            Assert::AreEqual(std::string(HARD_SOLUTION), grid.toString());
+
+            grid.setFromString(SEVENTEEN_CLUES);
+            Assert::IsTrue(solver.solve(grid));
+            Assert::IsTrue(grid.isComplete());
+            Assert::AreEqual(1, solver.countSolutions(grid, 2));
+
+            // The solver keeps nothing between puzzles, so the same puzzle solves the same way again
+            grid.setFromString(HARD_PUZZLE);
+            Assert::IsTrue(solver.solve(grid));
+            Assert::AreEqual(std::string(HARD_SOLUTION), grid.toString());
+        }
+
+        // Test puzzles with several solutions or none are counted
+        TEST_METHOD(CountSolutions)
+        {
+            SudokuSolver solver;
+            SudokuGrid grid;
+
+            grid.setFromString(HARD_PUZZLE);
+            Assert::AreEqual(1, solver.countSolutions(grid, 10));
+
+            // Taking out a clue from a minimal puzzle gives it more than one solution
+            grid.erase(0);
+            Assert::AreEqual(2, solver.countSolutions(grid, 2));
+            Assert::IsTrue(solver.countSolutions(grid, 1000) > 2);
+
+            // The empty grid has plenty
+            grid.clear();
+            Assert::AreEqual(100, solver.countSolutions(grid, 100));
+
+            // A cell no digit can go in has none
+            grid.setFromString("12345678." "........9" "........." "........." "........." "........." "........." "........." ".........");
+            Assert::AreEqual(0, solver.countSolutions(grid, 2));
+        }
+
+        // Test generated puzzles have one solution and rate at the difficulty asked for
+        TEST_METHOD(Generator)
+        {
+            SudokuGenerator generator(7);
+            SudokuSolver solver;
+
+            SudokuGrid solution = generator.generateSolution();
+            Assert::IsTrue(solution.isComplete());
+
+            for (int difficulty = SudokuSolver::EASY; difficulty <= SudokuSolver::HARD; difficulty++) {
+                for (int i = 0; i < 3; i++) {
+                    SudokuGrid puzzle = generator.generate(difficulty);
+                    Assert::AreEqual(1, solver.countSolutions(puzzle, 2));
+                    Assert::AreEqual(difficulty, SudokuSolver::rate(puzzle));
+                    Assert::IsTrue(puzzle.getFilledCount() < 40);
+                }
+            }
+
+            // The same seed generates the same puzzle
+            SudokuGenerator first(11), second(11);
+            Assert::AreEqual(first.generate(SudokuSolver::MEDIUM).toString(), second.generate(SudokuSolver::MEDIUM).toString());
+        }
+
+        // Test a batch file is solved, logging puzzles per second
+        TEST_METHOD(BatchSpeed)
+        {
+            // Make many different puzzles by relabelling the digits and swapping rows within bands, one in a hundred
+            // of them needing the search
+            std::mt19937 random(3);
+            std::string text;
+            int puzzles = 100000;
+
+            for (int i = 0; i < puzzles; i++) {
+                std::string source = (i % 100 == 0) ? HARD_PUZZLE : ((i % 2) ? SEVENTEEN_CLUES : EASY_PUZZLE);
+                char digits[10] = { '.', '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+                std::shuffle(digits + 1, digits + 10, random);
+
+                int rows[9] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+                for (int band = 0; band < 9; band += 3) {
+                    std::shuffle(rows + band, rows + band + 3, random);
+                }
+
+                for (int row = 0; row < 9; row++) {
+                    for (int column = 0; column < 9; column++) {
+                        char character = source[rows[row] * 9 + column];
+                        text += (character == '.') ? '.' : digits[character - '0'];
+                    }
+                }
+                text += (i % 2) ? "\r\n" : "\n";
+            }
+            text += "# not a puzzle\n";
+
+            {
+                std::ofstream file("test_batch.sudoku", std::ios::binary);
+                file << text;
+            }
+
+            SudokuSolver solver;
+            SudokuBatchStats stats = solver.solveFile("test_batch.sudoku");
+            std::remove("test_batch.sudoku");
+
+            Assert::AreEqual(static_cast<uint64_t>(puzzles), stats.puzzles);
+            Assert::AreEqual(static_cast<uint64_t>(puzzles), stats.solved);
+            Assert::AreEqual(static_cast<uint64_t>(puzzles - puzzles / 100), stats.bySingles);
+
+            auto missing = [&solver]() { solver.solveFile("test_missing.sudoku"); };
+            Assert::ExpectException<std::runtime_error>(missing);
+
+            std::string message = "Sudoku batch: " + std::to_string(stats.puzzles) + " puzzles, " + std::to_string(stats.bySingles) +
+                " by singles alone, " + std::to_string(static_cast<uint64_t>(stats.puzzlesPerSecond())) + " puzzles/s";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+
+    TEST_CLASS(SudokuGameTests)
+    {
+    public:
+        // Test the move input format
+        TEST_METHOD(ValidInput)
+        {
+            Sudoku game;
+
+            Assert::IsTrue(game.isValidInput("3 7 5"));
+            Assert::IsTrue(game.isValidInput("375"));
+            Assert::IsTrue(game.isValidInput("9 9 0"));
+            Assert::IsTrue(game.isValidInput("1 1 ."));
+            Assert::IsFalse(game.isValidInput("0 1 5"));
+            Assert::IsFalse(game.isValidInput("3 7"));
+            Assert::IsFalse(game.isValidInput("3 7 10"));
+            Assert::IsFalse(game.isValidInput("hint me"));
+        }
+    };
+}
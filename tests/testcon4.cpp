@@ -14,50 +14,58 @@ namespace con4Tests
 		{
 			Con4 game;
 
-			Assert::AreEqual(1, swapturn(2));
+			Assert::AreEqual(1, game.swapturn(2));
 		}
 
 		TEST_METHOD(testdrop)
 		{
 			Con4 game;
 
-			grid[6][7] = {0};
+			game.populategrid();
 
 			game.dropcoin(7, 1);
+			game.dropcoin(7, 2);
 
-			Assert::AreEqual(1, grid[0][7]);
+			Assert::AreEqual(1, game.getnum(6, 5));
+			Assert::AreEqual(2, game.getnum(6, 4));
+			Assert::AreEqual(0, game.getnum(6, 3));
 		}
 
 		TEST_METHOD(testwin)
 		{
 			Con4 game;
 
-			grid[6][7] = {0};
+			game.populategrid();
 
 			game.dropcoin(7, 1);
 			game.dropcoin(6, 1);
 			game.dropcoin(5, 1);
+
+			Assert::AreEqual(false, game.checkwin());
+
 			game.dropcoin(4, 1);
 
-			game.checkwin();
+			Assert::AreEqual(true, game.checkwin());
 
-			Assert::AreEqual(game.winquestionmark, true);
+			// Checking asks nothing of the player, so the game is not ended by it
+			Assert::AreEqual(false, game.isover());
 		}
 
 		TEST_METHOD(testdraw)
 		{
 			Con4 game;
 
-			grid[6][7] = {0};
+			game.populategrid();
+
+			Assert::AreEqual(false, game.checkdraw());
 
 			for(int toprow = 0; toprow < 7; toprow++)
 			{
-				game.setnum(1, toprow, 0);
+				game.setnum(1 + toprow % 2, toprow, 0);
 			}
 
-			game.checkdraw();
-
-			Assert::AreEqual(game.winquestionmark, true);
+			Assert::AreEqual(true, game.checkdraw());
+			Assert::AreEqual(false, game.isover());
 		}
-	}
-}
\ No newline at end of file
+	};
+}
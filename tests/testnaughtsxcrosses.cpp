@@ -2,7 +2,9 @@
 #include "CppUnitTest.h"
 #include "../src/NaughtsxCrossess.h"
 #include "../src/ScreenBuffer.h"
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -22,6 +24,27 @@ namespace Microsoft {
 
 namespace NaughtsCrossesTests
 {
+    // Plain minimax over every move with no cutoffs or cache, to check the fast one against
+    static int fullMinimax(NaughtsxCrossess& game, bool isMax) {
+        int score = game.evaluate();
+        if (score != 0 || !game.isMovesLeft()) {
+            return score;
+        }
+
+        int best = isMax ? -100 : 100;
+        for (int row = 0; row < NaughtsxCrossess::BOARD_SIZE; ++row) {
+            for (int col = 0; col < NaughtsxCrossess::BOARD_SIZE; ++col) {
+                if (game.getBoardValue(row, col) == ' ') {
+                    game.getBoardValue(row, col) = isMax ? 'x' : 'o';
+                    int value = fullMinimax(game, !isMax);
+                    game.getBoardValue(row, col) = ' ';
+                    best = isMax ? std::max(best, value) : std::min(best, value);
+                }
+            }
+        }
+        return best;
+    }
+
     TEST_CLASS(NaughtsCrossesTests)
     {
     public:
@@ -104,6 +127,128 @@ game.getBoardValue(0, 2) = 'x';
             Assert::AreEqual(std::make_pair(0, 2), bestMove, L"Best move evaluation failed.");
         }
 
+        TEST_METHOD(TestMinimaxMatchesFullSearch)
+        {
+            ScreenBuffer buffer;
+            NaughtsxCrossess game(&buffer);
+            std::mt19937 random(7);
+
+            // Random positions part way through a game, 'o' moving first, searched with the cache kept between them
+            for (int position = 0; position < 300; ++position) {
+                game.resetBoard();
+                int moves = std::uniform_int_distribution<int>(0, 7)(random);
+                for (int move = 0; move < moves && game.evaluate() == 0; ++move) {
+                    int row, col;
+                    do {
+                        row = std::uniform_int_distribution<int>(0, NaughtsxCrossess::BOARD_SIZE - 1)(random);
+                        col = std::uniform_int_distribution<int>(0, NaughtsxCrossess::BOARD_SIZE - 1)(random);
+                    } while (game.getBoardValue(row, col) != ' ');
+                    game.getBoardValue(row, col) = (move % 2 == 0) ? 'o' : 'x';
+                }
+
+                bool isMax = (moves % 2 == 1);
+                Assert::AreEqual(fullMinimax(game, isMax), game.minimax(0, isMax, 100), L"Minimax disagrees with a full search.");
+            }
+        }
+
+        TEST_METHOD(TestSearchSize)
+        {
+            ScreenBuffer buffer;
+            NaughtsxCrossess game(&buffer);
+
+            // The whole game from an empty board took 549945 positions with plain minimax
+            game.resetBoard();
+            game.getBoardValue(1, 1) = 'o';
+            auto bestMove = game.findBestMove(100);
+            long long firstSearch = game.getNodesSearched();
+            Assert::IsTrue(bestMove.first != 1 && bestMove.second != 1, L"Only a corner holds the draw against the centre.");
+
+            // Any corner is the same position turned, so it is already cached
+            game.getBoardValue(0, 0) = 'x';
+            game.getBoardValue(2, 2) = 'o';
+            game.findBestMove(100);
+            game.getBoardValue(0, 0) = ' ';
+            game.getBoardValue(2, 2) = ' ';
+            game.getBoardValue(0, 2) = 'x';
+            game.getBoardValue(2, 0) = 'o';
+            game.findBestMove(100);
+            long long symmetricSearch = game.getNodesSearched();
+
+            NaughtsxCrossess fresh(&buffer);
+            fresh.findBestMove(100);
+            long long emptySearch = fresh.getNodesSearched();
+
+            Assert::IsTrue(firstSearch < 1000, L"Searched too many positions.");
+            Assert::IsTrue(symmetricSearch < 20, L"A symmetric position was searched again.");
+            Assert::IsTrue(emptySearch < 5000, L"Searched too many positions.");
+
+            std::string message = "Naughts and Crosses positions searched: " + std::to_string(firstSearch) + " after a centre opening, " +
+                std::to_string(symmetricSearch) + " for a symmetric position, " + std::to_string(emptySearch) + " from empty";
+            Logger::WriteMessage(message.c_str());
+        }
+
+        TEST_METHOD(TestWinLines)
+        {
+            ScreenBuffer buffer;
+            NaughtsxCrossess5x5 game(&buffer);
+
+            // Four down the diagonal that misses the top left corner
+            for (int i = 1; i < 5; ++i) {
+                game.getBoardValue(i, i) = 'x';
+            }
+            Assert::AreEqual(10, game.evaluate(), L"Diagonal of four on 5x5 not found.");
+
+            game.getBoardValue(2, 2) = 'o';
+            Assert::AreEqual(0, game.evaluate(), L"Broken diagonal counted as a win.");
+
+            // The numpad layout grows with the board
+            NaughtsxCrossess4x4 small(&buffer);
+            Assert::AreEqual(std::make_pair(3, 0), small.moveNumberToPosition(1));
+            Assert::AreEqual(std::make_pair(0, 3), small.moveNumberToPosition(16));
+            Assert::AreEqual(std::make_pair(-1, -1), small.moveNumberToPosition(17));
+            Assert::AreEqual(std::make_pair(0, 0), game.moveNumberToPosition(21));
+        }
+
+        TEST_METHOD(TestLargerBoards)
+        {
+            ScreenBuffer buffer;
+            NaughtsxCrossess4x4 game(&buffer);
+
+            // The whole 4x4 game is searched, and is a draw
+            auto start = std::chrono::steady_clock::now();
+            Assert::AreEqual(0, game.minimax(0, false, NaughtsxCrossess4x4::hardDepth()), L"4x4 should be a draw.");
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            // 'x' to move takes three along the top rather than blocking 'o' down the left
+            game.getBoardValue(0, 0) = 'x';
+            game.getBoardValue(0, 1) = 'x';
+            game.getBoardValue(0, 2) = 'x';
+            game.getBoardValue(1, 0) = 'o';
+            game.getBoardValue(2, 0) = 'o';
+            game.getBoardValue(3, 0) = 'o';
+            game.getBoardValue(3, 3) = 'o';
+            Assert::AreEqual(std::make_pair(0, 3), game.findBestMove(NaughtsxCrossess4x4::hardDepth()));
+
+            // Without its own three, it blocks
+            game.getBoardValue(0, 2) = ' ';
+            game.getBoardValue(0, 0) = ' ';
+            game.getBoardValue(1, 1) = 'x';
+            Assert::AreEqual(std::make_pair(0, 0), game.findBestMove(NaughtsxCrossess4x4::hardDepth()));
+
+            // On 5x5 the search is cut off, and still finds the win in one
+            NaughtsxCrossess5x5 larger(&buffer);
+            for (int col = 0; col < 3; ++col) {
+                larger.getBoardValue(2, col + 1) = 'x';
+                larger.getBoardValue(4, col) = 'o';
+            }
+            larger.getBoardValue(0, 0) = 'o';
+            auto move = larger.findBestMove(NaughtsxCrossess5x5::hardDepth());
+            Assert::IsTrue(move == std::make_pair(2, 0) || move == std::make_pair(2, 4), L"5x5 win in one missed.");
+
+            std::string message = "4x4 Naughts and Crosses solved in " + std::to_string(seconds) + " s";
+            Logger::WriteMessage(message.c_str());
+        }
+
         TEST_METHOD(TestResetBoard)
         {
             ScreenBuffer buffer;
@@ -118,8 +263,8 @@ game.getBoardValue(0, 2) = 'x';
             game.resetBoard();
 
             // Ensure the board is empty
-            for (int row = 0; row < BOARD_SIZE; ++row) {
-                for (int col = 0; col < BOARD_SIZE; ++col) {
+            for (int row = 0; row < NaughtsxCrossess::BOARD_SIZE; ++row) {
+                for (int col = 0; col < NaughtsxCrossess::BOARD_SIZE; ++col) {
                     Assert::AreEqual(' ', game.getBoardValue(row, col), L"Board reset failed.");
                 }
             }